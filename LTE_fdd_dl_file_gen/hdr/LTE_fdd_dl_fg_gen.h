@@ -0,0 +1,226 @@
+/*******************************************************************************
+
+    Copyright 2026 agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: LTE_fdd_dl_fg_gen.h
+
+    Description: Contains all the definitions for the LTE FDD DL File
+                 Generator frame generator.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    agent            Created file
+    10/19/2026    agent            Added cached subframe templates.
+
+*******************************************************************************/
+
+#ifndef __LTE_FDD_DL_FG_GEN_H__
+#define __LTE_FDD_DL_FG_GEN_H__
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "liblte_phy.h"
+#include "liblte_rrc.h"
+#include "libtools_samp_conv.h"
+#include <boost/thread/mutex.hpp>
+#include <pthread.h>
+#include <map>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+#define LTE_FDD_DL_FG_GEN_N_THREADS_MAX       64
+#define LTE_FDD_DL_FG_GEN_N_SPARE_FRAME_SLOTS 2
+#define LTE_FDD_DL_FG_GEN_IDLE_SLEEP_US       1000
+
+// Configurable Parameters
+#define BANDWIDTH_PARAM          "bandwidth"
+#define FS_PARAM                 "fs"
+#define FREQ_BAND_PARAM          "freq_band"
+#define N_FRAMES_PARAM           "n_frames"
+#define N_ANT_PARAM              "n_ant"
+#define N_ID_CELL_PARAM          "n_id_cell"
+#define MCC_PARAM                "mcc"
+#define MNC_PARAM                "mnc"
+#define CELL_ID_PARAM            "cell_id"
+#define TRACKING_AREA_CODE_PARAM "tracking_area_code"
+#define Q_RX_LEV_MIN_PARAM       "q_rx_lev_min"
+#define P0_NOMINAL_PUSCH_PARAM   "p0_nominal_pusch"
+#define P0_NOMINAL_PUCCH_PARAM   "p0_nominal_pucch"
+#define SIB3_PRESENT_PARAM       "sib3_present"
+#define Q_HYST_PARAM             "q_hyst"
+#define SIB4_PRESENT_PARAM       "sib4_present"
+#define NEIGH_CELL_LIST_PARAM    "neigh_cell_list"
+#define SIB8_PRESENT_PARAM       "sib8_present"
+#define SEARCH_WIN_SIZE_PARAM    "search_win_size"
+#define PERCENT_LOAD_PARAM       "percent_load"
+
+/*******************************************************************************
+                              FORWARD DECLARATIONS
+*******************************************************************************/
+
+class LTE_fdd_dl_fg_gen;
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+typedef enum{
+    LTE_FDD_DL_FG_GEN_DATA_TYPE_INT8 = 0,
+    LTE_FDD_DL_FG_GEN_DATA_TYPE_INT16,
+    LTE_FDD_DL_FG_GEN_DATA_TYPE_GR_COMPLEX,
+    LTE_FDD_DL_FG_GEN_DATA_TYPE_N_ITEMS,
+}LTE_FDD_DL_FG_GEN_DATA_TYPE_ENUM;
+static const char LTE_fdd_dl_fg_gen_data_type_text[LTE_FDD_DL_FG_GEN_DATA_TYPE_N_ITEMS][20] = {"int8",
+                                                                                               "int16",
+                                                                                               "gr_complex"};
+static const LIBTOOLS_SAMP_CONV_FORMAT_ENUM LTE_fdd_dl_fg_gen_data_type_format[LTE_FDD_DL_FG_GEN_DATA_TYPE_N_ITEMS] = {LIBTOOLS_SAMP_CONV_FORMAT_SC8,
+                                                                                                                      LIBTOOLS_SAMP_CONV_FORMAT_SC16,
+                                                                                                                      LIBTOOLS_SAMP_CONV_FORMAT_CF32};
+// Scales int16 samples up from the int8 range
+static const float LTE_fdd_dl_fg_gen_data_type_scale[LTE_FDD_DL_FG_GEN_DATA_TYPE_N_ITEMS] = {1.0, 256.0, 1.0};
+
+typedef struct{
+    float  *i_buf;
+    float  *q_buf;
+    uint32  N_subfrs_done;
+}LTE_FDD_DL_FG_GEN_FRAME_STRUCT;
+
+// Subframe 0 is kept as a resource grid so the PBCH can be added, all
+// other subframes are kept as samples
+typedef struct{
+    LIBLTE_PHY_SUBFRAME_STRUCT *subframe;
+    float                      *i_buf;
+    float                      *q_buf;
+}LTE_FDD_DL_FG_GEN_TEMPLATE_STRUCT;
+
+typedef struct{
+    LTE_fdd_dl_fg_gen                *gen;
+    LIBLTE_PHY_STRUCT                *phy_struct;
+    LIBLTE_PHY_SUBFRAME_STRUCT       *subframe;
+    LIBLTE_PHY_PDCCH_STRUCT          *pdcch;
+    LIBLTE_RRC_BCCH_DLSCH_MSG_STRUCT *bcch_dlsch_msg;
+    LIBLTE_PHY_PCFICH_STRUCT          pcfich;
+    LIBLTE_PHY_PHICH_STRUCT           phich;
+    LIBLTE_RRC_MIB_STRUCT             mib;
+    LIBLTE_BIT_MSG_STRUCT             rrc_msg;
+    pthread_t                         thread;
+}LTE_FDD_DL_FG_GEN_WORKER_STRUCT;
+
+/*******************************************************************************
+                              CLASS DECLARATIONS
+*******************************************************************************/
+
+class LTE_fdd_dl_fg_gen
+{
+public:
+    LTE_fdd_dl_fg_gen();
+    ~LTE_fdd_dl_fg_gen();
+
+    // Configuration
+    void print_config(void);
+    bool change_config(char *line);
+    bool set_config(const char *param, char *value);
+    bool set_data_type(char *char_value);
+    bool set_N_threads(char *char_value);
+
+    // Generation
+    void start(void);
+    void stop(void);
+    bool get_frame(float **i_buf, float **q_buf);
+    void release_frame(void);
+    uint32 get_N_samps_per_frame(void);
+    uint8 get_N_ant(void);
+    bool run(char *file_name);
+
+private:
+    // LTE parameters
+    void recreate_sched_info(void);
+    LIBLTE_RRC_MIB_STRUCT                    mib;
+    LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_1_STRUCT  sib1;
+    LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_2_STRUCT  sib2;
+    LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_3_STRUCT  sib3;
+    LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_4_STRUCT  sib4;
+    LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_8_STRUCT  sib8;
+    LIBLTE_PHY_PCFICH_STRUCT                 pcfich;
+    LIBLTE_PHY_PHICH_STRUCT                  phich;
+    LIBLTE_PHY_FS_ENUM                       fs;
+    float                                    phich_res;
+    float                                    bandwidth;
+    uint32                                   N_frames;
+    uint32                                   N_id_cell;
+    uint32                                   N_id_1;
+    uint32                                   N_id_2;
+    uint32                                   N_rb_dl;
+    uint32                                   si_periodicity_T;
+    uint32                                   si_win_len;
+    uint32                                   sib_tx_mode;
+    uint32                                   percent_load;
+    uint8                                    N_ant;
+    uint8                                    sib3_present;
+    uint8                                    sib4_present;
+    uint8                                    sib8_present;
+
+    // Configuration
+    bool set_bandwidth(char *char_value);
+    bool set_fs(char *char_value);
+    bool set_n_ant(char *char_value);
+    bool set_n_id_cell(char *char_value);
+    bool set_mcc(char *char_value);
+    bool set_mnc(char *char_value);
+    bool set_q_hyst(char *char_value);
+    bool set_neigh_cell_list(char *char_value);
+    bool set_q_offset_range(LIBLTE_RRC_Q_OFFSET_RANGE_ENUM *q_offset_range, char *char_value);
+    bool set_param(uint32 *param, char *char_value, uint32 llimit, uint32 ulimit);
+    bool set_param(uint16 *param, char *char_value, uint16 llimit, uint16 ulimit);
+    bool set_param(uint8 *param, char *char_value, uint8 llimit, uint8 ulimit);
+    bool set_param(int32 *param, char *char_value, int32 llimit, int32 ulimit);
+    bool set_param(int16 *param, char *char_value, int16 llimit, int16 ulimit);
+    bool set_param(int8 *param, char *char_value, int8 llimit, int8 ulimit);
+    bool char_to_uint32(char *char_value, uint32 *uint32_value);
+    bool char_to_int32(char *char_value, int32 *int32_value);
+    LTE_FDD_DL_FG_GEN_DATA_TYPE_ENUM data_type;
+
+    // Frame generation
+    static void* worker_thread_func(void *inputs);
+    void generate_subframe(LTE_FDD_DL_FG_GEN_WORKER_STRUCT *worker, uint32 sfn, uint32 subfr_num, LTE_FDD_DL_FG_GEN_FRAME_STRUCT *frame);
+    boost::mutex                     frame_mutex;
+    boost::mutex                     rrc_mutex;
+    LTE_FDD_DL_FG_GEN_WORKER_STRUCT  workers[LTE_FDD_DL_FG_GEN_N_THREADS_MAX];
+    LTE_FDD_DL_FG_GEN_FRAME_STRUCT  *frames;
+    uint32                           N_frame_slots;
+    uint32                           next_subfr_idx;
+    uint32                           read_frame_idx;
+    uint32                           N_samps_per_frame;
+    uint32                           N_samps_per_subfr;
+    uint32                           N_threads;
+    bool                             started;
+    bool                             stopping;
+
+    // Subframe templates
+    uint32 get_template_key(uint32 sfn, uint32 subfr_num);
+    LTE_FDD_DL_FG_GEN_TEMPLATE_STRUCT* build_template(LTE_FDD_DL_FG_GEN_WORKER_STRUCT *worker, uint32 sfn, uint32 subfr_num);
+    void free_template(LTE_FDD_DL_FG_GEN_TEMPLATE_STRUCT *tmpl);
+    boost::mutex                                          template_mutex;
+    std::map<uint32, LTE_FDD_DL_FG_GEN_TEMPLATE_STRUCT*>  templates;
+};
+
+#endif /* __LTE_FDD_DL_FG_GEN_H__ */
@@ -0,0 +1,162 @@
+/*******************************************************************************
+
+    Copyright 2026 agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: LTE_fdd_dl_fg_gen_main.cc
+
+    Description: Contains all the implementations for the LTE FDD DL File
+                 Generator headless main.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    agent            Created file
+
+*******************************************************************************/
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "LTE_fdd_dl_fg_gen.h"
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              GLOBAL VARIABLES
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              CLASS IMPLEMENTATIONS
+*******************************************************************************/
+
+void print_usage(char *name)
+{
+    uint32 i;
+
+    printf("usage: %s [options] file\n", name);
+    printf("\t-n <frames>          Number of frames, default=30\n");
+    printf("\t-b <bandwidth>       Bandwidth in MHz, default=20\n");
+    printf("\t-f <fs>              Sample rate in MHz, default=30.72\n");
+    printf("\t-a <antennas>        Number of TX antennas, default=1\n");
+    printf("\t-c <N_id_cell>       Physical cell ID, default=0\n");
+    printf("\t-l <percent>         Percent load, default=0\n");
+    printf("\t-p <param>=<value>   Set any other parameter, -p help lists them\n");
+    printf("\t-d <type>            Output file data type, default=int8, options=[");
+    for(i=0; i<LTE_FDD_DL_FG_GEN_DATA_TYPE_N_ITEMS; i++)
+    {
+        if(0 != i)
+        {
+            printf(", ");
+        }
+        printf("%s", LTE_fdd_dl_fg_gen_data_type_text[i]);
+    }
+    printf("]\n");
+    printf("\t-t <threads>         Number of generator threads, default=number of cores\n");
+}
+
+int main(int argc, char *argv[])
+{
+    LTE_fdd_dl_fg_gen  gen;
+    char              *fs  = NULL;
+    char              *param;
+    char              *value;
+    int32              opt;
+    bool               err = false;
+
+    while(-1 != (opt = getopt(argc, argv, "n:b:f:a:c:l:p:d:t:h")))
+    {
+        switch(opt)
+        {
+        case 'n':
+            err |= gen.set_config(N_FRAMES_PARAM, optarg);
+            break;
+        case 'b':
+            err |= gen.set_config(BANDWIDTH_PARAM, optarg);
+            break;
+        case 'f':
+            // The allowed sample rates depend on the bandwidth
+            fs = optarg;
+            break;
+        case 'a':
+            err |= gen.set_config(N_ANT_PARAM, optarg);
+            break;
+        case 'c':
+            err |= gen.set_config(N_ID_CELL_PARAM, optarg);
+            break;
+        case 'l':
+            err |= gen.set_config(PERCENT_LOAD_PARAM, optarg);
+            break;
+        case 'p':
+            param = strtok(optarg, "=");
+            value = strtok(NULL, "=");
+            if(NULL != param &&
+               NULL != value)
+            {
+                err |= gen.set_config(param, value);
+            }else if(NULL != param &&
+                     !strcasecmp(param, "help")){
+                gen.print_config();
+                return(0);
+            }else{
+                err = true;
+            }
+            break;
+        case 'd':
+            err |= gen.set_data_type(optarg);
+            break;
+        case 't':
+            err |= gen.set_N_threads(optarg);
+            break;
+        default:
+            err = true;
+            break;
+        }
+    }
+    if(NULL != fs)
+    {
+        err |= gen.set_config(FS_PARAM, fs);
+    }
+
+    if(err ||
+       (optind + 1) != argc)
+    {
+        print_usage(argv[0]);
+        return(1);
+    }
+
+    printf("*** LTE FDD DL FILE GEN ***\n");
+    if(gen.run(argv[optind]))
+    {
+        return(1);
+    }
+
+    return(0);
+}
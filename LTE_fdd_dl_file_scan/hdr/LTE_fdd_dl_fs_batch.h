@@ -0,0 +1,236 @@
+/*******************************************************************************
+
+    Copyright 2026 agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: LTE_fdd_dl_fs_batch.h
+
+    Description: Contains all the definitions for the LTE FDD DL File
+                 Scanner batch decoder.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    agent            Created file
+    10/19/2026    agent            Acquiring the cells behind each correlation
+                                   peak and decoding all cells concurrently.
+    10/19/2026    agent            Added int16 input and using
+                                   libtools_samp_conv to convert samples.
+    10/19/2026    agent            Added resampling of files recorded at
+                                   non-LTE sample rates.
+
+*******************************************************************************/
+
+#ifndef __LTE_FDD_DL_FS_BATCH_H__
+#define __LTE_FDD_DL_FS_BATCH_H__
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "LTE_fdd_dl_fs_printer.h"
+#include "liblte_phy.h"
+#include "liblte_rrc.h"
+#include "libtools_samp_conv.h"
+#include <boost/thread/mutex.hpp>
+#include <pthread.h>
+#include <stdio.h>
+#include <vector>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+#define LTE_FDD_DL_FS_BATCH_N_CELLS_MAX          10
+#define LTE_FDD_DL_FS_BATCH_N_FRAMES_PER_CHUNK   8
+#define LTE_FDD_DL_FS_BATCH_N_CHUNKS_PER_THREAD  4
+#define LTE_FDD_DL_FS_BATCH_N_THREADS_MAX        64
+#define LTE_FDD_DL_FS_BATCH_IDLE_SLEEP_US        1000
+#define LTE_FDD_DL_FS_BATCH_LTE_SAMP_RATE_MIN    1920000  // Every LTE sample rate is a multiple of this
+#define LTE_FDD_DL_FS_BATCH_LTE_SAMP_RATE_MAX    30720000
+
+/*******************************************************************************
+                              FORWARD DECLARATIONS
+*******************************************************************************/
+
+class LTE_fdd_dl_fs_batch;
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+typedef enum{
+    LTE_FDD_DL_FS_BATCH_DATA_TYPE_INT8 = 0,
+    LTE_FDD_DL_FS_BATCH_DATA_TYPE_INT16,
+    LTE_FDD_DL_FS_BATCH_DATA_TYPE_GR_COMPLEX,
+    LTE_FDD_DL_FS_BATCH_DATA_TYPE_N_ITEMS,
+}LTE_FDD_DL_FS_BATCH_DATA_TYPE_ENUM;
+static const char LTE_fdd_dl_fs_batch_data_type_text[LTE_FDD_DL_FS_BATCH_DATA_TYPE_N_ITEMS][20] = {"int8",
+                                                                                                   "int16",
+                                                                                                   "gr_complex"};
+static const LIBTOOLS_SAMP_CONV_FORMAT_ENUM LTE_fdd_dl_fs_batch_data_type_format[LTE_FDD_DL_FS_BATCH_DATA_TYPE_N_ITEMS] = {LIBTOOLS_SAMP_CONV_FORMAT_SC8,
+                                                                                                                          LIBTOOLS_SAMP_CONV_FORMAT_SC16,
+                                                                                                                          LIBTOOLS_SAMP_CONV_FORMAT_CF32};
+// Scales int16 samples down to the int8 range
+static const float LTE_fdd_dl_fs_batch_data_type_scale[LTE_FDD_DL_FS_BATCH_DATA_TYPE_N_ITEMS] = {1.0, 1.0/256.0, 1.0};
+
+typedef struct{
+    LIBLTE_BIT_MSG_STRUCT msg;
+    uint32                sfn;
+    uint16                rnti;
+    uint8                 subfr_num;
+}LTE_FDD_DL_FS_BATCH_MSG_STRUCT;
+
+typedef struct{
+    std::vector<LTE_FDD_DL_FS_BATCH_MSG_STRUCT> msgs;
+    uint32                                      N_frames;
+    uint32                                      N_bch_decoded;
+    bool                                        done;
+}LTE_FDD_DL_FS_BATCH_CHUNK_STRUCT;
+
+// Everything needed to decode one cell, each cell is decoded concurrently
+// with the others by its own share of the worker threads
+typedef struct{
+    // Acquisition
+    LIBLTE_RRC_MIB_STRUCT              mib;
+    uint64                             frame_start_idx;
+    float                              freq_offset;
+    float                              phich_res;
+    uint32                             corr_peak_idx;
+    uint32                             N_id_cell;
+    uint32                             N_rb_dl;
+    uint32                             sfn;
+    uint8                              N_ant;
+
+    // Frame decode
+    LTE_fdd_dl_fs_batch               *batch;
+    LTE_FDD_DL_FS_BATCH_CHUNK_STRUCT  *chunks;
+    LTE_fdd_dl_fs_printer              printer;
+    FILE                              *out;
+    char                              *out_buf;
+    size_t                             out_size;
+    uint64                             first_frame_idx;
+    uint32                             first_sfn;
+    uint32                             N_frames;
+    uint32                             N_frames_decoded;
+    uint32                             N_bch_decoded;
+    uint32                             N_chunks;
+    uint32                             N_chunk_slots;
+    uint32                             next_chunk_idx;
+    uint32                             print_chunk_idx;
+    uint32                             first_worker_idx;
+    uint32                             N_workers;
+}LTE_FDD_DL_FS_BATCH_CELL_STRUCT;
+
+// Resampler and input scratch for files recorded at a non-LTE sample rate,
+// resamp is NULL when the file is already at fs
+typedef struct{
+    LIBLTE_PHY_RESAMP_STRUCT *resamp;
+    float                    *i_buf;
+    float                    *q_buf;
+}LTE_FDD_DL_FS_BATCH_RESAMP_STRUCT;
+
+typedef struct{
+    LTE_FDD_DL_FS_BATCH_CELL_STRUCT   *cell;
+    LIBLTE_PHY_STRUCT                 *phy_struct;
+    LIBLTE_PHY_SUBFRAME_STRUCT        *subframe;
+    float                             *i_buf;
+    float                             *q_buf;
+    LTE_FDD_DL_FS_BATCH_RESAMP_STRUCT  resamp;
+    pthread_t                          thread;
+}LTE_FDD_DL_FS_BATCH_WORKER_STRUCT;
+
+// Scratch for acquiring the cells behind a subset of the correlation peaks
+typedef struct{
+    LTE_fdd_dl_fs_batch               *batch;
+    LIBLTE_PHY_STRUCT                 *phy_struct;
+    LIBLTE_PHY_SUBFRAME_STRUCT        *subframe;
+    float                             *i_buf;
+    float                             *q_buf;
+    LTE_FDD_DL_FS_BATCH_RESAMP_STRUCT  resamp;
+    uint32                             first_peak_idx;
+    pthread_t                          thread;
+}LTE_FDD_DL_FS_BATCH_ACQ_STRUCT;
+
+/*******************************************************************************
+                              CLASS DECLARATIONS
+*******************************************************************************/
+
+class LTE_fdd_dl_fs_batch
+{
+public:
+    LTE_fdd_dl_fs_batch();
+    ~LTE_fdd_dl_fs_batch();
+
+    // Configuration
+    bool set_fs(char *char_value);
+    bool set_in_samp_rate(char *char_value);
+    bool set_data_type(char *char_value);
+    bool set_N_threads(char *char_value);
+
+    // Decode
+    bool run(char *file_name);
+
+private:
+    // Capture file
+    bool open_file(char *file_name);
+    void close_file(void);
+    void init_resamp(LTE_FDD_DL_FS_BATCH_RESAMP_STRUCT *resamp, uint32 N_samps);
+    void cleanup_resamp(LTE_FDD_DL_FS_BATCH_RESAMP_STRUCT *resamp);
+    void convert_samps(LTE_FDD_DL_FS_BATCH_RESAMP_STRUCT *resamp, uint64 start_idx, uint32 N_samps, float freq_offset, float *i_buf, float *q_buf);
+    LTE_FDD_DL_FS_BATCH_DATA_TYPE_ENUM  data_type;
+    LIBLTE_PHY_FS_ENUM                  fs;
+    uint8                              *file_data;
+    uint64                              file_size;
+    uint64                              N_file_in_samps;
+    uint64                              N_file_samps;
+    uint32                              in_samp_rate;
+    uint32                              samp_rate;
+    uint32                              resamp_interp;
+    uint32                              resamp_decim;
+    LIBLTE_PHY_RESAMP_STRUCT           *resamp_proto;
+    uint32                              N_samps_per_frame;
+    uint32                              N_samps_per_subfr;
+    int32                               fd;
+
+    // Acquisition
+    void acquire(void);
+    static void* acq_thread_func(void *inputs);
+    bool acquire_cell(LTE_FDD_DL_FS_BATCH_ACQ_STRUCT *acq, uint32 corr_peak_idx, LTE_FDD_DL_FS_BATCH_CELL_STRUCT *cell);
+    LTE_FDD_DL_FS_BATCH_ACQ_STRUCT   acqs[LIBLTE_PHY_N_MAX_ROUGH_CORR_SEARCH_PEAKS];
+    LIBLTE_PHY_COARSE_TIMING_STRUCT  acq_timing_struct;
+    LTE_FDD_DL_FS_BATCH_CELL_STRUCT  peak_cells[LIBLTE_PHY_N_MAX_ROUGH_CORR_SEARCH_PEAKS];
+    bool                             peak_found[LIBLTE_PHY_N_MAX_ROUGH_CORR_SEARCH_PEAKS];
+    uint64                           acq_window_idx;
+    uint32                           acq_window_len;
+    uint32                           N_acqs;
+    LTE_FDD_DL_FS_BATCH_CELL_STRUCT  cells[LTE_FDD_DL_FS_BATCH_N_CELLS_MAX];
+    uint32                           N_cells;
+
+    // Frame decode
+    void decode_cells(void);
+    void start_cell(LTE_FDD_DL_FS_BATCH_CELL_STRUCT *cell, uint32 first_worker_idx, uint32 N_workers);
+    bool print_cell(LTE_FDD_DL_FS_BATCH_CELL_STRUCT *cell);
+    void stop_cell(LTE_FDD_DL_FS_BATCH_CELL_STRUCT *cell);
+    static void* worker_thread_func(void *inputs);
+    void decode_chunk(LTE_FDD_DL_FS_BATCH_WORKER_STRUCT *worker, uint32 chunk_idx);
+    void print_chunk(LTE_FDD_DL_FS_BATCH_CELL_STRUCT *cell, LTE_FDD_DL_FS_BATCH_CHUNK_STRUCT *chunk);
+    boost::mutex                       chunk_mutex;
+    LTE_FDD_DL_FS_BATCH_WORKER_STRUCT  workers[LTE_FDD_DL_FS_BATCH_N_THREADS_MAX];
+    uint32                             N_threads;
+};
+
+#endif /* __LTE_FDD_DL_FS_BATCH_H__ */
@@ -0,0 +1,102 @@
+/*******************************************************************************
+
+    Copyright 2026 agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: LTE_fdd_dl_fs_printer.h
+
+    Description: Contains all the definitions for the LTE FDD DL File
+                 Scanner system information printer.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    agent            Created file
+    10/19/2026    agent            Added an output stream so that multiple
+                                   cells can be printed concurrently.
+
+*******************************************************************************/
+
+#ifndef __LTE_FDD_DL_FS_PRINTER_H__
+#define __LTE_FDD_DL_FS_PRINTER_H__
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "liblte_rrc.h"
+#include <stdio.h>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              FORWARD DECLARATIONS
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              CLASS DECLARATIONS
+*******************************************************************************/
+
+class LTE_fdd_dl_fs_printer
+{
+public:
+    LTE_fdd_dl_fs_printer();
+    ~LTE_fdd_dl_fs_printer();
+
+    void init(FILE *_out);
+    bool all_printed(void);
+    void print_mib(LIBLTE_RRC_MIB_STRUCT *mib, uint32 corr_peak_idx, float freq_offset, uint32 sfn, uint32 N_id_cell, uint8 N_ant);
+    void print_sib1(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_1_STRUCT *sib1);
+    void print_sib2(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_2_STRUCT *sib2);
+    void print_sib3(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_3_STRUCT *sib3);
+    void print_sib4(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_4_STRUCT *sib4);
+    void print_sib5(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_5_STRUCT *sib5);
+    void print_sib6(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_6_STRUCT *sib6);
+    void print_sib7(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_7_STRUCT *sib7);
+    void print_sib8(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_8_STRUCT *sib8);
+    void print_page(LIBLTE_RRC_PAGING_STRUCT *page);
+
+private:
+    FILE *out;
+    uint8 prev_si_value_tag;
+    bool  prev_si_value_tag_valid;
+    bool  mib_printed;
+    bool  sib1_printed;
+    bool  sib2_printed;
+    bool  sib3_printed;
+    bool  sib3_expected;
+    bool  sib4_printed;
+    bool  sib4_expected;
+    bool  sib5_printed;
+    bool  sib5_expected;
+    bool  sib6_printed;
+    bool  sib6_expected;
+    bool  sib7_printed;
+    bool  sib7_expected;
+    bool  sib8_printed;
+    bool  sib8_expected;
+};
+
+#endif /* __LTE_FDD_DL_FS_PRINTER_H__ */
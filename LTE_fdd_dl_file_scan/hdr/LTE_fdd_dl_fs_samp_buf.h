@@ -40,6 +40,10 @@
     09/28/2013    Ben Wojtowicz    Added support for setting the sample rate
                                    and input data type.
     06/15/2014    Ben Wojtowicz    Using the latest LTE library.
+    10/19/2026    agent            Using an NCO for frequency offset
+                                   correction.
+    10/19/2026    agent            Moved MIB, SIB, and paging printing to
+                                   LTE_fdd_dl_fs_printer.
 
 *******************************************************************************/
 
@@ -51,6 +55,7 @@
 *******************************************************************************/
 
 #include "LTE_fdd_dl_fs_api.h"
+#include "LTE_fdd_dl_fs_printer.h"
 #include "liblte_phy.h"
 #include "liblte_rrc.h"
 #include <gnuradio/sync_block.h>
@@ -131,6 +136,9 @@ private:
     uint32  samp_buf_r_idx;
     bool    last_samp_was_i;
 
+    // Frequency correction
+    LIBLTE_PHY_NCO_STRUCT nco;
+
     // Variables
     LTE_FDD_DL_FS_SAMP_BUF_STATE_ENUM state;
     float                             phich_res;
@@ -143,38 +151,14 @@ private:
     uint32                            decoded_chans[LTE_FDD_DL_FS_SAMP_BUF_N_DECODED_CHANS_MAX];
     uint32                            N_decoded_chans;
     uint8                             N_ant;
-    uint8                             prev_si_value_tag;
-    bool                              prev_si_value_tag_valid;
-    bool                              mib_printed;
-    bool                              sib1_printed;
-    bool                              sib2_printed;
-    bool                              sib3_printed;
-    bool                              sib3_expected;
-    bool                              sib4_printed;
-    bool                              sib4_expected;
-    bool                              sib5_printed;
-    bool                              sib5_expected;
-    bool                              sib6_printed;
-    bool                              sib6_expected;
-    bool                              sib7_printed;
-    bool                              sib7_expected;
-    bool                              sib8_printed;
-    bool                              sib8_expected;
+
+    // Printing
+    LTE_fdd_dl_fs_printer printer;
 
     // Helpers
     void init(void);
     void copy_input_to_samp_buf(gr_vector_const_void_star &input_items, int32 ninput_items);
-    void freq_shift(uint32 start_idx, uint32 num_samps, float freq_offset);
-    void print_mib(LIBLTE_RRC_MIB_STRUCT *mib);
-    void print_sib1(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_1_STRUCT *sib1);
-    void print_sib2(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_2_STRUCT *sib2);
-    void print_sib3(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_3_STRUCT *sib3);
-    void print_sib4(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_4_STRUCT *sib4);
-    void print_sib5(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_5_STRUCT *sib5);
-    void print_sib6(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_6_STRUCT *sib6);
-    void print_sib7(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_7_STRUCT *sib7);
-    void print_sib8(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_8_STRUCT *sib8);
-    void print_page(LIBLTE_RRC_PAGING_STRUCT *page);
+    void freq_shift(float freq_offset);
 
     // Configuration
     void print_config(void);
@@ -0,0 +1,982 @@
+/*******************************************************************************
+
+    Copyright 2026 agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: LTE_fdd_dl_fs_batch.cc
+
+    Description: Contains all the implementations for the LTE FDD DL File
+                 Scanner batch decoder.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    agent            Created file
+    10/19/2026    agent            Acquiring the cells behind each correlation
+                                   peak and decoding all cells concurrently.
+    10/19/2026    agent            Added int16 input and using
+                                   libtools_samp_conv to convert samples.
+    10/19/2026    agent            Added resampling of files recorded at
+                                   non-LTE sample rates.
+
+*******************************************************************************/
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "LTE_fdd_dl_fs_batch.h"
+#include "liblte_mac.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+#define COARSE_TIMING_N_SLOTS              (160)
+#define COARSE_TIMING_SEARCH_NUM_SUBFRAMES ((COARSE_TIMING_N_SLOTS/2)+2)
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              GLOBAL VARIABLES
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              CLASS IMPLEMENTATIONS
+*******************************************************************************/
+
+/********************************/
+/*    Constructor/Destructor    */
+/********************************/
+LTE_fdd_dl_fs_batch::LTE_fdd_dl_fs_batch()
+{
+    data_type       = LTE_FDD_DL_FS_BATCH_DATA_TYPE_INT8;
+    fs              = LIBLTE_PHY_FS_30_72MHZ;
+    file_data       = NULL;
+    file_size       = 0;
+    N_file_in_samps = 0;
+    N_file_samps    = 0;
+    fd              = -1;
+    in_samp_rate    = 0;
+    samp_rate       = 0;
+    resamp_interp   = 1;
+    resamp_decim    = 1;
+    resamp_proto    = NULL;
+    N_acqs          = 0;
+    N_cells         = 0;
+    N_threads       = sysconf(_SC_NPROCESSORS_ONLN);
+    if(0 == N_threads)
+    {
+        N_threads = 1;
+    }else if(LTE_FDD_DL_FS_BATCH_N_THREADS_MAX < N_threads){
+        N_threads = LTE_FDD_DL_FS_BATCH_N_THREADS_MAX;
+    }
+}
+LTE_fdd_dl_fs_batch::~LTE_fdd_dl_fs_batch()
+{
+    close_file();
+}
+
+/***********************/
+/*    Configuration    */
+/***********************/
+bool LTE_fdd_dl_fs_batch::set_fs(char *char_value)
+{
+    uint32 i;
+    bool   err = true;
+
+    for(i=0; i<LIBLTE_PHY_FS_N_ITEMS; i++)
+    {
+        if(!strcasecmp(char_value, liblte_phy_fs_text[i]))
+        {
+            fs  = (LIBLTE_PHY_FS_ENUM)i;
+            err = false;
+        }
+    }
+
+    return(err);
+}
+bool LTE_fdd_dl_fs_batch::set_in_samp_rate(char *char_value)
+{
+    double value = atof(char_value);
+    uint32 rate;
+    uint32 a;
+    uint32 b;
+    uint32 i;
+    bool   err   = false;
+
+    // Sample rate is specified in MHz, as for the LTE sample rates
+    if(0        < value &&
+       4000.0  >= value)
+    {
+        // Reducing against the lowest LTE sample rate bounds the resampling
+        // ratio for every LTE sample rate, since they are all multiples of it
+        rate = lround(value*1000000);
+        a    = rate;
+        b    = LTE_FDD_DL_FS_BATCH_LTE_SAMP_RATE_MIN;
+        while(0 != b)
+        {
+            i = a % b;
+            a = b;
+            b = i;
+        }
+        if(LIBLTE_PHY_RESAMP_MAX_FACTOR >= rate/a &&
+           LIBLTE_PHY_RESAMP_MAX_FACTOR >= LTE_FDD_DL_FS_BATCH_LTE_SAMP_RATE_MAX/a)
+        {
+            in_samp_rate = rate;
+        }else{
+            printf("Input sample rate %u Hz needs too large a resampling ratio\n", rate);
+            err = true;
+        }
+    }else{
+        err = true;
+    }
+
+    return(err);
+}
+bool LTE_fdd_dl_fs_batch::set_data_type(char *char_value)
+{
+    uint32 i;
+    bool   err = true;
+
+    for(i=0; i<LTE_FDD_DL_FS_BATCH_DATA_TYPE_N_ITEMS; i++)
+    {
+        if(!strcasecmp(char_value, LTE_fdd_dl_fs_batch_data_type_text[i]))
+        {
+            data_type = (LTE_FDD_DL_FS_BATCH_DATA_TYPE_ENUM)i;
+            err       = false;
+        }
+    }
+
+    return(err);
+}
+bool LTE_fdd_dl_fs_batch::set_N_threads(char *char_value)
+{
+    int32 value = atoi(char_value);
+    bool  err   = false;
+
+    if(0     < value &&
+       value <= LTE_FDD_DL_FS_BATCH_N_THREADS_MAX)
+    {
+        N_threads = value;
+    }else{
+        err = true;
+    }
+
+    return(err);
+}
+
+/****************/
+/*    Decode    */
+/****************/
+bool LTE_fdd_dl_fs_batch::run(char *file_name)
+{
+    struct timeval start_time;
+    struct timeval end_time;
+    double         elapsed;
+    double         capture_secs;
+    bool           err = true;
+
+    if(!open_file(file_name))
+    {
+        gettimeofday(&start_time, NULL);
+
+        // Find the cells, then decode every frame of all of them
+        acquire();
+        decode_cells();
+
+        gettimeofday(&end_time, NULL);
+        elapsed      = (end_time.tv_sec - start_time.tv_sec) + (end_time.tv_usec - start_time.tv_usec)/1000000.0;
+        capture_secs = (double)N_file_samps/(double)samp_rate;
+        if(0 == N_cells)
+        {
+            printf("No DL LTE channels found\n");
+        }
+        printf("Decoded %.2f seconds of samples from %u cells in %.2f seconds (%.1fx real time) using %u threads\n",
+               capture_secs,
+               N_cells,
+               elapsed,
+               (0 != elapsed) ? capture_secs*N_cells/elapsed : 0,
+               N_threads);
+
+        close_file();
+        err = false;
+    }
+
+    return(err);
+}
+
+/**********************/
+/*    Capture File    */
+/**********************/
+bool LTE_fdd_dl_fs_batch::open_file(char *file_name)
+{
+    struct stat file_stat;
+    bool        err = true;
+
+    fd = open(file_name, O_RDONLY);
+    if(0 > fd)
+    {
+        printf("Unable to open %s\n", file_name);
+    }else if(0 != fstat(fd, &file_stat) ||
+             0 == file_stat.st_size){
+        printf("Unable to read %s\n", file_name);
+        close(fd);
+        fd = -1;
+    }else{
+        file_size = file_stat.st_size;
+        file_data = (uint8 *)mmap(NULL, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(MAP_FAILED == file_data)
+        {
+            printf("Unable to map %s\n", file_name);
+            file_data = NULL;
+            close(fd);
+            fd = -1;
+        }else{
+            madvise(file_data, file_size, MADV_SEQUENTIAL);
+            N_file_in_samps = file_size/libtools_samp_conv_format_size[LTE_fdd_dl_fs_batch_data_type_format[data_type]];
+            N_file_samps    = N_file_in_samps;
+            err             = false;
+        }
+    }
+
+    return(err);
+}
+void LTE_fdd_dl_fs_batch::close_file(void)
+{
+    if(NULL != resamp_proto)
+    {
+        liblte_phy_resamp_cleanup(resamp_proto);
+        resamp_proto = NULL;
+    }
+    if(NULL != file_data)
+    {
+        munmap(file_data, file_size);
+        file_data = NULL;
+    }
+    if(0 <= fd)
+    {
+        close(fd);
+        fd = -1;
+    }
+}
+void LTE_fdd_dl_fs_batch::init_resamp(LTE_FDD_DL_FS_BATCH_RESAMP_STRUCT *resamp,
+                                      uint32                             N_samps)
+{
+    uint32 N_in_max;
+
+    resamp->resamp = NULL;
+    resamp->i_buf  = NULL;
+    resamp->q_buf  = NULL;
+    if(NULL != resamp_proto)
+    {
+        // Input needed for N_samps outputs plus the filter history
+        liblte_phy_resamp_init_shared(&resamp->resamp, resamp_proto);
+        N_in_max      = ((uint64)N_samps*resamp_decim)/resamp_interp + resamp->resamp->N_taps_per_phase + 1;
+        resamp->i_buf = (float *)malloc(N_in_max*sizeof(float));
+        resamp->q_buf = (float *)malloc(N_in_max*sizeof(float));
+    }
+}
+void LTE_fdd_dl_fs_batch::cleanup_resamp(LTE_FDD_DL_FS_BATCH_RESAMP_STRUCT *resamp)
+{
+    if(NULL != resamp->resamp)
+    {
+        liblte_phy_resamp_cleanup(resamp->resamp);
+        free(resamp->i_buf);
+        free(resamp->q_buf);
+        resamp->resamp = NULL;
+        resamp->i_buf  = NULL;
+        resamp->q_buf  = NULL;
+    }
+}
+void LTE_fdd_dl_fs_batch::convert_samps(LTE_FDD_DL_FS_BATCH_RESAMP_STRUCT *resamp,
+                                        uint64                             start_idx,
+                                        uint32                             N_samps,
+                                        float                              freq_offset,
+                                        float                             *i_buf,
+                                        float                             *q_buf)
+{
+    LIBLTE_PHY_NCO_STRUCT          nco;
+    LIBTOOLS_SAMP_CONV_FORMAT_ENUM format = LTE_fdd_dl_fs_batch_data_type_format[data_type];
+    uint64                         in_idx;
+    uint32                         N_in;
+    uint32                         N_out;
+
+    if(NULL == resamp->resamp)
+    {
+        libtools_samp_conv_to_split(format,
+                                    &file_data[start_idx*libtools_samp_conv_format_size[format]],
+                                    LTE_fdd_dl_fs_batch_data_type_scale[data_type],
+                                    i_buf,
+                                    q_buf,
+                                    N_samps);
+    }else{
+        // Resample from the file rate to fs, starting the filter history
+        // afresh at start_idx so that blocks can be converted in any order
+        liblte_phy_resamp_reset(resamp->resamp, start_idx, &in_idx);
+        liblte_phy_resamp_get_n_in(resamp->resamp, N_samps, &N_in);
+        libtools_samp_conv_to_split(format,
+                                    &file_data[in_idx*libtools_samp_conv_format_size[format]],
+                                    LTE_fdd_dl_fs_batch_data_type_scale[data_type],
+                                    resamp->i_buf,
+                                    resamp->q_buf,
+                                    N_in);
+        liblte_phy_resamp_run(resamp->resamp,
+                              resamp->i_buf,
+                              resamp->q_buf,
+                              N_in,
+                              i_buf,
+                              q_buf,
+                              N_samps,
+                              &N_out);
+    }
+
+    // Correct frequency error, the phase at the start of each block does
+    // not matter as it is absorbed by the channel estimate
+    liblte_phy_nco_init(&nco, samp_rate, freq_offset);
+    liblte_phy_nco_rotate(&nco, i_buf, q_buf, N_samps);
+}
+
+/*********************/
+/*    Acquisition    */
+/*********************/
+void LTE_fdd_dl_fs_batch::acquire(void)
+{
+    LIBLTE_PHY_STRUCT *phy_struct;
+    uint32             i;
+    uint32             j;
+    bool               found;
+
+    // Initialize the LTE library, one instance for the coarse timing search
+    // and one for each acquisition thread so that the cells behind each
+    // correlation peak can be acquired concurrently
+    liblte_phy_init(&phy_struct,
+                    fs,
+                    LIBLTE_PHY_INIT_N_ID_CELL_UNKNOWN,
+                    4,
+                    LIBLTE_PHY_N_RB_DL_1_4MHZ,
+                    LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP,
+                    liblte_rrc_phich_resource_num[LIBLTE_RRC_PHICH_RESOURCE_1]);
+    samp_rate         = phy_struct->fs;
+    resamp_interp     = 1;
+    resamp_decim      = 1;
+    N_file_samps      = N_file_in_samps;
+    if(0            != in_samp_rate &&
+       samp_rate    != in_samp_rate &&
+       0            != N_file_in_samps)
+    {
+        // Resample by the ratio of the two rates reduced to lowest terms,
+        // keeping only the samples whose filter input lies inside the file
+        resamp_interp = samp_rate;
+        resamp_decim  = in_samp_rate;
+        while(0 != resamp_decim)
+        {
+            i             = resamp_interp % resamp_decim;
+            resamp_interp = resamp_decim;
+            resamp_decim  = i;
+        }
+        i             = resamp_interp;
+        resamp_interp = samp_rate/i;
+        resamp_decim  = in_samp_rate/i;
+        N_file_samps  = ((N_file_in_samps - 1)*resamp_interp)/resamp_decim + 1;
+        printf("Resampling from %u Hz to %u Hz (%u/%u)\n", in_samp_rate, samp_rate, resamp_interp, resamp_decim);
+
+        // The taps only depend on the ratio, so they are designed once and
+        // every acquisition and worker keeps just its own history and phase
+        liblte_phy_resamp_init(&resamp_proto, resamp_interp, resamp_decim, NULL, 0);
+    }
+    N_samps_per_frame = phy_struct->N_samps_per_frame;
+    N_samps_per_subfr = phy_struct->N_samps_per_subfr;
+    acq_window_len    = N_samps_per_subfr*COARSE_TIMING_SEARCH_NUM_SUBFRAMES;
+    N_acqs            = N_threads;
+    if(LIBLTE_PHY_N_MAX_ROUGH_CORR_SEARCH_PEAKS < N_acqs)
+    {
+        N_acqs = LIBLTE_PHY_N_MAX_ROUGH_CORR_SEARCH_PEAKS;
+    }
+    for(i=0; i<N_acqs; i++)
+    {
+        liblte_phy_init(&acqs[i].phy_struct,
+                        fs,
+                        LIBLTE_PHY_INIT_N_ID_CELL_UNKNOWN,
+                        4,
+                        LIBLTE_PHY_N_RB_DL_1_4MHZ,
+                        LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP,
+                        liblte_rrc_phich_resource_num[LIBLTE_RRC_PHICH_RESOURCE_1]);
+        acqs[i].batch          = this;
+        acqs[i].subframe       = new LIBLTE_PHY_SUBFRAME_STRUCT;
+        acqs[i].i_buf          = (float *)malloc(acq_window_len*sizeof(float));
+        acqs[i].q_buf          = (float *)malloc(acq_window_len*sizeof(float));
+        acqs[i].first_peak_idx = i;
+        init_resamp(&acqs[i].resamp, acq_window_len);
+    }
+
+    // Search windows until at least one cell is found
+    N_cells        = 0;
+    acq_window_idx = 0;
+    while(0                                   == N_cells &&
+          (acq_window_idx + acq_window_len) <= N_file_samps)
+    {
+        convert_samps(&acqs[0].resamp, acq_window_idx, acq_window_len, 0, acqs[0].i_buf, acqs[0].q_buf);
+        if(LIBLTE_SUCCESS == liblte_phy_dl_find_coarse_timing_and_freq_offset(phy_struct,
+                                                                              acqs[0].i_buf,
+                                                                              acqs[0].q_buf,
+                                                                              COARSE_TIMING_N_SLOTS,
+                                                                              &acq_timing_struct))
+        {
+            // Acquire the cell behind each peak concurrently
+            for(i=0; i<N_acqs; i++)
+            {
+                pthread_create(&acqs[i].thread, NULL, &acq_thread_func, &acqs[i]);
+            }
+            for(i=0; i<N_acqs; i++)
+            {
+                pthread_join(acqs[i].thread, NULL);
+            }
+
+            // Keep the first peak found for each cell
+            for(i=0; i<acq_timing_struct.n_corr_peaks; i++)
+            {
+                found = peak_found[i];
+                for(j=0; j<N_cells; j++)
+                {
+                    if(cells[j].N_id_cell == peak_cells[i].N_id_cell)
+                    {
+                        found = false;
+                    }
+                }
+                if(found &&
+                   LTE_FDD_DL_FS_BATCH_N_CELLS_MAX > N_cells)
+                {
+                    cells[N_cells++] = peak_cells[i];
+                }
+            }
+        }
+        acq_window_idx += acq_window_len;
+    }
+
+    // Cleanup the LTE library
+    for(i=0; i<N_acqs; i++)
+    {
+        free(acqs[i].i_buf);
+        free(acqs[i].q_buf);
+        cleanup_resamp(&acqs[i].resamp);
+        delete acqs[i].subframe;
+        liblte_phy_cleanup(acqs[i].phy_struct);
+    }
+    liblte_phy_cleanup(phy_struct);
+}
+void* LTE_fdd_dl_fs_batch::acq_thread_func(void *inputs)
+{
+    LTE_FDD_DL_FS_BATCH_ACQ_STRUCT *acq   = (LTE_FDD_DL_FS_BATCH_ACQ_STRUCT *)inputs;
+    LTE_fdd_dl_fs_batch            *batch = acq->batch;
+    uint32                          i;
+
+    for(i=acq->first_peak_idx; i<batch->acq_timing_struct.n_corr_peaks; i+=batch->N_acqs)
+    {
+        batch->peak_found[i] = batch->acquire_cell(acq, i, &batch->peak_cells[i]);
+    }
+
+    return(NULL);
+}
+bool LTE_fdd_dl_fs_batch::acquire_cell(LTE_FDD_DL_FS_BATCH_ACQ_STRUCT  *acq,
+                                       uint32                           corr_peak_idx,
+                                       LTE_FDD_DL_FS_BATCH_CELL_STRUCT *cell)
+{
+    LIBLTE_BIT_MSG_STRUCT rrc_msg;
+    float                 pss_thresh;
+    float                 freq_offset;
+    uint32                N_id_1;
+    uint32                N_id_2;
+    uint32                pss_symb;
+    uint32                frame_start_idx;
+    uint8                 sfn_offset;
+    bool                  found = false;
+
+    // Correct frequency error
+    cell->freq_offset = acq_timing_struct.freq_offset[corr_peak_idx];
+    convert_samps(&acq->resamp, acq_window_idx, acq_window_len, cell->freq_offset, acq->i_buf, acq->q_buf);
+
+    if(LIBLTE_SUCCESS == liblte_phy_find_pss_and_fine_timing(acq->phy_struct,
+                                                             acq->i_buf,
+                                                             acq->q_buf,
+                                                             acq_timing_struct.symb_starts[corr_peak_idx],
+                                                             &N_id_2,
+                                                             &pss_symb,
+                                                             &pss_thresh,
+                                                             &freq_offset))
+    {
+        if(fabs(freq_offset) > 100)
+        {
+            cell->freq_offset += freq_offset;
+            convert_samps(&acq->resamp, acq_window_idx, acq_window_len, cell->freq_offset, acq->i_buf, acq->q_buf);
+        }
+
+        // Decode SSS and BCH
+        if(LIBLTE_SUCCESS == liblte_phy_find_sss(acq->phy_struct,
+                                                 acq->i_buf,
+                                                 acq->q_buf,
+                                                 N_id_2,
+                                                 acq_timing_struct.symb_starts[corr_peak_idx],
+                                                 pss_thresh,
+                                                 &N_id_1,
+                                                 &frame_start_idx)                      &&
+           (frame_start_idx + 2*N_samps_per_subfr) <= acq_window_len                    &&
+           LIBLTE_SUCCESS == liblte_phy_get_dl_subframe_and_ce(acq->phy_struct,
+                                                               acq->i_buf,
+                                                               acq->q_buf,
+                                                               frame_start_idx,
+                                                               0,
+                                                               3*N_id_1 + N_id_2,
+                                                               4,
+                                                               acq->subframe)           &&
+           LIBLTE_SUCCESS == liblte_phy_bch_channel_decode(acq->phy_struct,
+                                                           acq->subframe,
+                                                           3*N_id_1 + N_id_2,
+                                                           &cell->N_ant,
+                                                           rrc_msg.msg,
+                                                           &rrc_msg.N_bits,
+                                                           &sfn_offset)                 &&
+           LIBLTE_SUCCESS == liblte_rrc_unpack_bcch_bch_msg(&rrc_msg,
+                                                            &cell->mib))
+        {
+            switch(cell->mib.dl_bw)
+            {
+            case LIBLTE_RRC_DL_BANDWIDTH_6:
+                cell->N_rb_dl = LIBLTE_PHY_N_RB_DL_1_4MHZ;
+                break;
+            case LIBLTE_RRC_DL_BANDWIDTH_15:
+                cell->N_rb_dl = LIBLTE_PHY_N_RB_DL_3MHZ;
+                break;
+            case LIBLTE_RRC_DL_BANDWIDTH_25:
+                cell->N_rb_dl = LIBLTE_PHY_N_RB_DL_5MHZ;
+                break;
+            case LIBLTE_RRC_DL_BANDWIDTH_50:
+                cell->N_rb_dl = LIBLTE_PHY_N_RB_DL_10MHZ;
+                break;
+            case LIBLTE_RRC_DL_BANDWIDTH_75:
+                cell->N_rb_dl = LIBLTE_PHY_N_RB_DL_15MHZ;
+                break;
+            case LIBLTE_RRC_DL_BANDWIDTH_100:
+            default:
+                cell->N_rb_dl = LIBLTE_PHY_N_RB_DL_20MHZ;
+                break;
+            }
+            cell->N_id_cell       = 3*N_id_1 + N_id_2;
+            cell->frame_start_idx = acq_window_idx + frame_start_idx;
+            cell->sfn             = (cell->mib.sfn_div_4 << 2) + sfn_offset;
+            cell->phich_res       = liblte_rrc_phich_resource_num[cell->mib.phich_config.res];
+            cell->corr_peak_idx   = corr_peak_idx;
+            found                 = true;
+        }
+    }
+
+    return(found);
+}
+
+/**********************/
+/*    Frame Decode    */
+/**********************/
+void LTE_fdd_dl_fs_batch::decode_cells(void)
+{
+    uint32 worker_idx = 0;
+    uint32 N_workers;
+    uint32 print_cell_idx;
+    uint32 i;
+    bool   busy;
+
+    // Share the threads between the cells, every cell gets at least one
+    for(i=0; i<N_cells; i++)
+    {
+        N_workers = N_threads/N_cells;
+        if(i < (N_threads % N_cells))
+        {
+            N_workers++;
+        }
+        if(0 == N_workers)
+        {
+            N_workers = 1;
+        }
+        start_cell(&cells[i], worker_idx, N_workers);
+        worker_idx += N_workers;
+    }
+
+    // Collect results from all cells as they complete, each cell's output is
+    // buffered so that the cells are printed one after another
+    print_cell_idx = 0;
+    while(print_cell_idx < N_cells)
+    {
+        busy = false;
+        for(i=print_cell_idx; i<N_cells; i++)
+        {
+            busy |= print_cell(&cells[i]);
+        }
+        while(print_cell_idx                         < N_cells &&
+              cells[print_cell_idx].print_chunk_idx == cells[print_cell_idx].N_chunks)
+        {
+            stop_cell(&cells[print_cell_idx]);
+            print_cell_idx++;
+        }
+        if(!busy)
+        {
+            usleep(LTE_FDD_DL_FS_BATCH_IDLE_SLEEP_US);
+        }
+    }
+}
+void LTE_fdd_dl_fs_batch::start_cell(LTE_FDD_DL_FS_BATCH_CELL_STRUCT *cell,
+                                     uint32                           first_worker_idx,
+                                     uint32                           N_workers)
+{
+    LTE_FDD_DL_FS_BATCH_WORKER_STRUCT *worker;
+    uint32                             i;
+
+    // Decode every frame in the file, including those before the one the
+    // cell was acquired on
+    cell->batch            = this;
+    cell->first_frame_idx  = cell->frame_start_idx % N_samps_per_frame;
+    cell->first_sfn        = (cell->sfn + 1024 - ((cell->frame_start_idx/N_samps_per_frame) % 1024)) % 1024;
+    cell->N_frames         = 0;
+    if((cell->first_frame_idx + N_samps_per_frame + N_samps_per_subfr) <= N_file_samps)
+    {
+        cell->N_frames = (N_file_samps - cell->first_frame_idx - N_samps_per_subfr)/N_samps_per_frame;
+    }
+    cell->N_frames_decoded = 0;
+    cell->N_bch_decoded    = 0;
+    cell->N_chunks         = (cell->N_frames + LTE_FDD_DL_FS_BATCH_N_FRAMES_PER_CHUNK - 1)/LTE_FDD_DL_FS_BATCH_N_FRAMES_PER_CHUNK;
+    cell->N_chunk_slots    = N_workers*LTE_FDD_DL_FS_BATCH_N_CHUNKS_PER_THREAD;
+    cell->next_chunk_idx   = 0;
+    cell->print_chunk_idx  = 0;
+    cell->first_worker_idx = first_worker_idx;
+    cell->N_workers        = N_workers;
+    cell->chunks           = new LTE_FDD_DL_FS_BATCH_CHUNK_STRUCT[cell->N_chunk_slots];
+    for(i=0; i<cell->N_chunk_slots; i++)
+    {
+        cell->chunks[i].done = false;
+    }
+
+    cell->out_buf  = NULL;
+    cell->out_size = 0;
+    cell->out      = open_memstream(&cell->out_buf, &cell->out_size);
+    cell->printer.init(cell->out);
+    cell->printer.print_mib(&cell->mib,
+                            cell->corr_peak_idx,
+                            cell->freq_offset,
+                            cell->sfn,
+                            cell->N_id_cell,
+                            cell->N_ant);
+
+    // Initialize the LTE library for each worker, FFTW planning is not
+    // thread safe so this is done before the workers are started
+    for(i=0; i<N_workers; i++)
+    {
+        worker = &workers[first_worker_idx + i];
+        liblte_phy_init(&worker->phy_struct,
+                        fs,
+                        cell->N_id_cell,
+                        cell->N_ant,
+                        cell->N_rb_dl,
+                        LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP,
+                        cell->phich_res);
+        worker->cell     = cell;
+        worker->subframe = new LIBLTE_PHY_SUBFRAME_STRUCT;
+        worker->i_buf    = (float *)malloc((LTE_FDD_DL_FS_BATCH_N_FRAMES_PER_CHUNK*N_samps_per_frame + N_samps_per_subfr)*sizeof(float));
+        worker->q_buf    = (float *)malloc((LTE_FDD_DL_FS_BATCH_N_FRAMES_PER_CHUNK*N_samps_per_frame + N_samps_per_subfr)*sizeof(float));
+        init_resamp(&worker->resamp, LTE_FDD_DL_FS_BATCH_N_FRAMES_PER_CHUNK*N_samps_per_frame + N_samps_per_subfr);
+    }
+    for(i=0; i<N_workers; i++)
+    {
+        worker = &workers[first_worker_idx + i];
+        pthread_create(&worker->thread, NULL, &worker_thread_func, worker);
+    }
+}
+bool LTE_fdd_dl_fs_batch::print_cell(LTE_FDD_DL_FS_BATCH_CELL_STRUCT *cell)
+{
+    uint32 slot_idx;
+    bool   done    = true;
+    bool   printed = false;
+
+    // Print chunks in SFN order as they complete
+    while(done &&
+          cell->print_chunk_idx < cell->N_chunks)
+    {
+        slot_idx = cell->print_chunk_idx % cell->N_chunk_slots;
+        chunk_mutex.lock();
+        done = cell->chunks[slot_idx].done;
+        chunk_mutex.unlock();
+        if(done)
+        {
+            print_chunk(cell, &cell->chunks[slot_idx]);
+            cell->N_bch_decoded    += cell->chunks[slot_idx].N_bch_decoded;
+            cell->N_frames_decoded += cell->chunks[slot_idx].N_frames;
+            cell->chunks[slot_idx].msgs.clear();
+            chunk_mutex.lock();
+            cell->chunks[slot_idx].done = false;
+            cell->print_chunk_idx++;
+            chunk_mutex.unlock();
+            printed = true;
+        }
+    }
+
+    return(printed);
+}
+void LTE_fdd_dl_fs_batch::stop_cell(LTE_FDD_DL_FS_BATCH_CELL_STRUCT *cell)
+{
+    LTE_FDD_DL_FS_BATCH_WORKER_STRUCT *worker;
+    uint32                             i;
+
+    // Cleanup the workers
+    for(i=0; i<cell->N_workers; i++)
+    {
+        worker = &workers[cell->first_worker_idx + i];
+        pthread_join(worker->thread, NULL);
+        free(worker->i_buf);
+        free(worker->q_buf);
+        cleanup_resamp(&worker->resamp);
+        delete worker->subframe;
+        liblte_phy_cleanup(worker->phy_struct);
+    }
+    delete [] cell->chunks;
+    cell->chunks = NULL;
+
+    // Flush the buffered output
+    fprintf(cell->out, "\tDecoded %u frames, PBCH decoded in %u frames\n", cell->N_frames_decoded, cell->N_bch_decoded);
+    fclose(cell->out);
+    fwrite(cell->out_buf, 1, cell->out_size, stdout);
+    free(cell->out_buf);
+    cell->out     = NULL;
+    cell->out_buf = NULL;
+}
+void* LTE_fdd_dl_fs_batch::worker_thread_func(void *inputs)
+{
+    LTE_FDD_DL_FS_BATCH_WORKER_STRUCT *worker = (LTE_FDD_DL_FS_BATCH_WORKER_STRUCT *)inputs;
+    LTE_FDD_DL_FS_BATCH_CELL_STRUCT   *cell   = worker->cell;
+    LTE_fdd_dl_fs_batch               *batch  = cell->batch;
+    uint32                             chunk_idx;
+    bool                               got_chunk;
+    bool                               done = false;
+
+    while(!done)
+    {
+        // Claim the next chunk, as long as there is room for its results
+        got_chunk = false;
+        batch->chunk_mutex.lock();
+        chunk_idx = cell->next_chunk_idx;
+        if(chunk_idx >= cell->N_chunks)
+        {
+            done = true;
+        }else if(chunk_idx < (cell->print_chunk_idx + cell->N_chunk_slots)){
+            cell->next_chunk_idx++;
+            got_chunk = true;
+        }
+        batch->chunk_mutex.unlock();
+
+        if(got_chunk)
+        {
+            batch->decode_chunk(worker, chunk_idx);
+        }else if(!done){
+            usleep(LTE_FDD_DL_FS_BATCH_IDLE_SLEEP_US);
+        }
+    }
+
+    return(NULL);
+}
+void LTE_fdd_dl_fs_batch::decode_chunk(LTE_FDD_DL_FS_BATCH_WORKER_STRUCT *worker,
+                                       uint32                             chunk_idx)
+{
+    LTE_FDD_DL_FS_BATCH_CELL_STRUCT  *cell       = worker->cell;
+    LTE_FDD_DL_FS_BATCH_CHUNK_STRUCT *chunk      = &cell->chunks[chunk_idx % cell->N_chunk_slots];
+    LIBLTE_PHY_STRUCT                *phy_struct = worker->phy_struct;
+    LIBLTE_PHY_PCFICH_STRUCT          pcfich;
+    LIBLTE_PHY_PHICH_STRUCT           phich;
+    LIBLTE_PHY_PDCCH_STRUCT           pdcch;
+    LIBLTE_RRC_MIB_STRUCT             mib;
+    LTE_FDD_DL_FS_BATCH_MSG_STRUCT    msg;
+    uint32                            frame_idx = chunk_idx*LTE_FDD_DL_FS_BATCH_N_FRAMES_PER_CHUNK;
+    uint32                            N_frames_in_chunk;
+    uint32                            f;
+    uint32                            i;
+    uint8                             N_ant;
+    uint8                             sfn_offset;
+    uint8                             subfr_num;
+
+    N_frames_in_chunk = cell->N_frames - frame_idx;
+    if(LTE_FDD_DL_FS_BATCH_N_FRAMES_PER_CHUNK < N_frames_in_chunk)
+    {
+        N_frames_in_chunk = LTE_FDD_DL_FS_BATCH_N_FRAMES_PER_CHUNK;
+    }
+    chunk->N_frames      = N_frames_in_chunk;
+    chunk->N_bch_decoded = 0;
+
+    // Subframe decoding uses the first symbols of the following subframe
+    convert_samps(&worker->resamp,
+                  cell->first_frame_idx + (uint64)frame_idx*N_samps_per_frame,
+                  N_frames_in_chunk*N_samps_per_frame + N_samps_per_subfr,
+                  cell->freq_offset,
+                  worker->i_buf,
+                  worker->q_buf);
+
+    for(f=0; f<N_frames_in_chunk; f++)
+    {
+        msg.sfn = (cell->first_sfn + frame_idx + f) % 1024;
+        for(subfr_num=0; subfr_num<10; subfr_num++)
+        {
+            if(LIBLTE_SUCCESS == liblte_phy_get_dl_subframe_and_ce(phy_struct,
+                                                                   worker->i_buf,
+                                                                   worker->q_buf,
+                                                                   f*N_samps_per_frame,
+                                                                   subfr_num,
+                                                                   cell->N_id_cell,
+                                                                   cell->N_ant,
+                                                                   worker->subframe))
+            {
+                if(0              == subfr_num                                             &&
+                   LIBLTE_SUCCESS == liblte_phy_bch_channel_decode(phy_struct,
+                                                                   worker->subframe,
+                                                                   cell->N_id_cell,
+                                                                   &N_ant,
+                                                                   msg.msg.msg,
+                                                                   &msg.msg.N_bits,
+                                                                   &sfn_offset) &&
+                   LIBLTE_SUCCESS == liblte_rrc_unpack_bcch_bch_msg(&msg.msg,
+                                                                    &mib))
+                {
+                    chunk->N_bch_decoded++;
+                }
+
+                if(LIBLTE_SUCCESS == liblte_phy_pdcch_channel_decode(phy_struct,
+                                                                     worker->subframe,
+                                                                     cell->N_id_cell,
+                                                                     cell->N_ant,
+                                                                     cell->phich_res,
+                                                                     cell->mib.phich_config.dur,
+                                                                     &pcfich,
+                                                                     &phich,
+                                                                     &pdcch))
+                {
+                    for(i=0; i<pdcch.N_alloc; i++)
+                    {
+                        if(LIBLTE_SUCCESS == liblte_phy_pdsch_channel_decode(phy_struct,
+                                                                             worker->subframe,
+                                                                             &pdcch.alloc[i],
+                                                                             pdcch.N_symbs,
+                                                                             cell->N_id_cell,
+                                                                             cell->N_ant,
+                                                                             msg.msg.msg,
+                                                                             &msg.msg.N_bits))
+                        {
+                            msg.rnti      = pdcch.alloc[i].rnti;
+                            msg.subfr_num = subfr_num;
+                            chunk->msgs.push_back(msg);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    chunk_mutex.lock();
+    chunk->done = true;
+    chunk_mutex.unlock();
+}
+void LTE_fdd_dl_fs_batch::print_chunk(LTE_FDD_DL_FS_BATCH_CELL_STRUCT  *cell,
+                                      LTE_FDD_DL_FS_BATCH_CHUNK_STRUCT *chunk)
+{
+    LIBLTE_RRC_BCCH_DLSCH_MSG_STRUCT  bcch_dlsch_msg;
+    LIBLTE_RRC_PCCH_MSG_STRUCT        pcch_msg;
+    LIBLTE_BIT_MSG_STRUCT            *msg;
+    uint32                            i;
+    uint32                            j;
+    bool                              test_fill;
+
+    for(i=0; i<chunk->msgs.size(); i++)
+    {
+        msg = &chunk->msgs[i].msg;
+        if(LIBLTE_MAC_SI_RNTI == chunk->msgs[i].rnti)
+        {
+            if(LIBLTE_SUCCESS == liblte_rrc_unpack_bcch_dlsch_msg(msg,
+                                                                  &bcch_dlsch_msg))
+            {
+                for(j=0; j<bcch_dlsch_msg.N_sibs; j++)
+                {
+                    switch(bcch_dlsch_msg.sibs[j].sib_type)
+                    {
+                    case LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_1:
+                        cell->printer.print_sib1((LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_1_STRUCT *)&bcch_dlsch_msg.sibs[j].sib);
+                        break;
+                    case LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_2:
+                        cell->printer.print_sib2((LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_2_STRUCT *)&bcch_dlsch_msg.sibs[j].sib);
+                        break;
+                    case LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_3:
+                        cell->printer.print_sib3((LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_3_STRUCT *)&bcch_dlsch_msg.sibs[j].sib);
+                        break;
+                    case LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_4:
+                        cell->printer.print_sib4((LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_4_STRUCT *)&bcch_dlsch_msg.sibs[j].sib);
+                        break;
+                    case LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_5:
+                        cell->printer.print_sib5((LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_5_STRUCT *)&bcch_dlsch_msg.sibs[j].sib);
+                        break;
+                    case LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_6:
+                        cell->printer.print_sib6((LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_6_STRUCT *)&bcch_dlsch_msg.sibs[j].sib);
+                        break;
+                    case LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_7:
+                        cell->printer.print_sib7((LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_7_STRUCT *)&bcch_dlsch_msg.sibs[j].sib);
+                        break;
+                    case LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_8:
+                        cell->printer.print_sib8((LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_8_STRUCT *)&bcch_dlsch_msg.sibs[j].sib);
+                        break;
+                    default:
+                        fprintf(cell->out, "Not handling SIB %u\n", bcch_dlsch_msg.sibs[j].sib_type);
+                        break;
+                    }
+                }
+            }
+        }else if(LIBLTE_MAC_P_RNTI == chunk->msgs[i].rnti){
+            test_fill = (msg->N_bits >= 8);
+            for(j=0; j<8 && test_fill; j++)
+            {
+                test_fill = (msg->msg[j] == liblte_rrc_test_fill[j]);
+            }
+            if(test_fill)
+            {
+                fprintf(cell->out, "TEST FILL RECEIVED\n");
+            }else if(LIBLTE_SUCCESS == liblte_rrc_unpack_pcch_msg(msg,
+                                                                  &pcch_msg)){
+                fprintf(cell->out, "\tSFN=%u, Subframe=%u\n", chunk->msgs[i].sfn, chunk->msgs[i].subfr_num);
+                cell->printer.print_page(&pcch_msg);
+            }
+        }else{
+            fprintf(cell->out, "MESSAGE RECEIVED FOR RNTI=%04X SFN=%u Subframe=%u: ", chunk->msgs[i].rnti, chunk->msgs[i].sfn, chunk->msgs[i].subfr_num);
+            for(j=0; j<msg->N_bits; j++)
+            {
+                fprintf(cell->out, "%u", msg->msg[j]);
+            }
+            fprintf(cell->out, "\n");
+        }
+    }
+}
@@ -0,0 +1,130 @@
+/*******************************************************************************
+
+    Copyright 2026 agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: LTE_fdd_dl_fs_batch_main.cc
+
+    Description: Contains all the implementations for the LTE FDD DL File
+                 Scanner batch decoder main.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    agent            Created file
+    10/19/2026    agent            Added the input sample rate option.
+
+*******************************************************************************/
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "LTE_fdd_dl_fs_batch.h"
+#include <stdio.h>
+#include <unistd.h>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              GLOBAL VARIABLES
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              CLASS IMPLEMENTATIONS
+*******************************************************************************/
+
+void print_usage(char *name)
+{
+    uint32 i;
+
+    printf("usage: %s [options] file\n", name);
+    printf("\t-d <type>     Input file data type, default=int8, options=[");
+    for(i=0; i<LTE_FDD_DL_FS_BATCH_DATA_TYPE_N_ITEMS; i++)
+    {
+        if(0 != i)
+        {
+            printf(", ");
+        }
+        printf("%s", LTE_fdd_dl_fs_batch_data_type_text[i]);
+    }
+    printf("]\n");
+    printf("\t-f <fs>       Sample rate in MHz, default=30.72, options=[");
+    for(i=0; i<LIBLTE_PHY_FS_N_ITEMS; i++)
+    {
+        if(0 != i)
+        {
+            printf(", ");
+        }
+        printf("%s", liblte_phy_fs_text[i]);
+    }
+    printf("]\n");
+    printf("\t-r <rate>     Input file sample rate in MHz when not fs, resampled to fs\n");
+    printf("\t-t <threads>  Number of decode threads, default=number of cores\n");
+}
+
+int main(int argc, char *argv[])
+{
+    LTE_fdd_dl_fs_batch batch;
+    int32               opt;
+    bool                err = false;
+
+    while(-1 != (opt = getopt(argc, argv, "d:f:r:t:h")))
+    {
+        switch(opt)
+        {
+        case 'd':
+            err |= batch.set_data_type(optarg);
+            break;
+        case 'f':
+            err |= batch.set_fs(optarg);
+            break;
+        case 'r':
+            err |= batch.set_in_samp_rate(optarg);
+            break;
+        case 't':
+            err |= batch.set_N_threads(optarg);
+            break;
+        default:
+            err = true;
+            break;
+        }
+    }
+
+    if(err ||
+       (optind + 1) != argc)
+    {
+        print_usage(argv[0]);
+        return(1);
+    }
+
+    printf("*** LTE FDD DL FILE SCAN BATCH ***\n");
+    if(batch.run(argv[optind]))
+    {
+        return(1);
+    }
+
+    return(0);
+}
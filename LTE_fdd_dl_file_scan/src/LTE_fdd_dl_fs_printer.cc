@@ -0,0 +1,1133 @@
+/*******************************************************************************
+
+    Copyright 2012-2014, 2026 Ben Wojtowicz
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: LTE_fdd_dl_fs_printer.cc
+
+    Description: Contains all the implementations for the LTE FDD DL File
+                 Scanner system information printer.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    agent            Created file from the printing routines in
+                                   LTE_fdd_dl_fs_samp_buf.cc.
+    10/19/2026    agent            Added an output stream so that multiple
+                                   cells can be printed concurrently.
+
+*******************************************************************************/
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "LTE_fdd_dl_fs_printer.h"
+#include "liblte_mcc_mnc_list.h"
+#include <stdio.h>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              GLOBAL VARIABLES
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              CLASS IMPLEMENTATIONS
+*******************************************************************************/
+
+LTE_fdd_dl_fs_printer::LTE_fdd_dl_fs_printer()
+{
+    init(stdout);
+}
+LTE_fdd_dl_fs_printer::~LTE_fdd_dl_fs_printer()
+{
+}
+
+void LTE_fdd_dl_fs_printer::init(FILE *_out)
+{
+    out                     = _out;
+    prev_si_value_tag       = 0;
+    prev_si_value_tag_valid = false;
+    mib_printed             = false;
+    sib1_printed            = false;
+    sib2_printed            = false;
+    sib3_printed            = false;
+    sib3_expected           = false;
+    sib4_printed            = false;
+    sib4_expected           = false;
+    sib5_printed            = false;
+    sib5_expected           = false;
+    sib6_printed            = false;
+    sib6_expected           = false;
+    sib7_printed            = false;
+    sib7_expected           = false;
+    sib8_printed            = false;
+    sib8_expected           = false;
+}
+
+bool LTE_fdd_dl_fs_printer::all_printed(void)
+{
+    return(mib_printed  == true          &&
+           sib1_printed == true          &&
+           sib2_printed == true          &&
+           sib3_printed == sib3_expected &&
+           sib4_printed == sib4_expected &&
+           sib5_printed == sib5_expected &&
+           sib6_printed == sib6_expected &&
+           sib7_printed == sib7_expected &&
+           sib8_printed == sib8_expected);
+}
+
+void LTE_fdd_dl_fs_printer::print_mib(LIBLTE_RRC_MIB_STRUCT *mib,
+                                      uint32                 corr_peak_idx,
+                                      float                  freq_offset,
+                                      uint32                 sfn,
+                                      uint32                 N_id_cell,
+                                      uint8                  N_ant)
+{
+    if(false == mib_printed)
+    {
+        fprintf(out, "DL LTE Channel found [%u]:\n", corr_peak_idx);
+        fprintf(out, "\tMIB Decoded:\n");
+        fprintf(out, "\t\t%-40s=%20.2f\n", "Frequency Offset", freq_offset);
+        fprintf(out, "\t\t%-40s=%20u\n", "System Frame Number", sfn);
+        fprintf(out, "\t\t%-40s=%20u\n", "Physical Cell ID", N_id_cell);
+        fprintf(out, "\t\t%-40s=%20u\n", "Number of TX Antennas", N_ant);
+        fprintf(out, "\t\t%-40s=%17sMHz\n", "Bandwidth", liblte_rrc_dl_bandwidth_text[mib->dl_bw]);
+        fprintf(out, "\t\t%-40s=%20s\n", "PHICH Duration", liblte_rrc_phich_duration_text[mib->phich_config.dur]);
+        fprintf(out, "\t\t%-40s=%20s\n", "PHICH Resource", liblte_rrc_phich_resource_text[mib->phich_config.res]);
+
+        mib_printed = true;
+    }
+}
+
+void LTE_fdd_dl_fs_printer::print_sib1(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_1_STRUCT *sib1)
+{
+    uint32 i;
+    uint32 j;
+    uint32 si_win_len;
+    uint32 si_periodicity_T;
+    uint16 mnc;
+
+    if(true              == prev_si_value_tag_valid &&
+       prev_si_value_tag != sib1->system_info_value_tag)
+    {
+        fprintf(out, "\tSystem Info value tag changed\n");
+        sib1_printed = false;
+        sib2_printed = false;
+        sib3_printed = false;
+        sib4_printed = false;
+        sib5_printed = false;
+        sib6_printed = false;
+        sib7_printed = false;
+        sib8_printed = false;
+    }
+
+    if(false == sib1_printed)
+    {
+        fprintf(out, "\tSIB1 Decoded:\n");
+        fprintf(out, "\t\t%-40s\n", "PLMN Identity List:");
+        for(i=0; i<sib1->N_plmn_ids; i++)
+        {
+            fprintf(out, "\t\t\t%03X-", sib1->plmn_id[i].id.mcc & 0x0FFF);
+            if((sib1->plmn_id[i].id.mnc & 0xFF00) == 0xFF00)
+            {
+                mnc = sib1->plmn_id[i].id.mnc & 0x00FF;
+                fprintf(out, "%02X, ", mnc);
+            }else{
+                mnc = sib1->plmn_id[i].id.mnc & 0x0FFF;
+                fprintf(out, "%03X, ", mnc);
+            }
+            for(j=0; j<LIBLTE_MCC_MNC_LIST_N_ITEMS; j++)
+            {
+                if(liblte_mcc_mnc_list[j].mcc == (sib1->plmn_id[i].id.mcc & 0x0FFF) &&
+                   liblte_mcc_mnc_list[j].mnc == mnc)
+                {
+                    fprintf(out, "%s, ", liblte_mcc_mnc_list[j].net_name);
+                    break;
+                }
+            }
+            if(LIBLTE_RRC_RESV_FOR_OPER == sib1->plmn_id[i].resv_for_oper)
+            {
+                fprintf(out, "reserved for operator use\n");
+            }else{
+                fprintf(out, "not reserved for operator use\n");
+            }
+        }
+        fprintf(out, "\t\t%-40s=%20u\n", "Tracking Area Code", sib1->tracking_area_code);
+        fprintf(out, "\t\t%-40s=%20u\n", "Cell Identity", sib1->cell_id);
+        switch(sib1->cell_barred)
+        {
+        case LIBLTE_RRC_CELL_BARRED:
+            fprintf(out, "\t\t%-40s=%20s\n", "Cell Barred", "Barred");
+            break;
+        case LIBLTE_RRC_CELL_NOT_BARRED:
+            fprintf(out, "\t\t%-40s=%20s\n", "Cell Barred", "Not Barred");
+            break;
+        }
+        switch(sib1->intra_freq_reselection)
+        {
+        case LIBLTE_RRC_INTRA_FREQ_RESELECTION_ALLOWED:
+            fprintf(out, "\t\t%-40s=%20s\n", "Intra Frequency Reselection", "Allowed");
+            break;
+        case LIBLTE_RRC_INTRA_FREQ_RESELECTION_NOT_ALLOWED:
+            fprintf(out, "\t\t%-40s=%20s\n", "Intra Frequency Reselection", "Not Allowed");
+            break;
+        }
+        if(true == sib1->csg_indication)
+        {
+            fprintf(out, "\t\t%-40s=%20s\n", "CSG Indication", "TRUE");
+        }else{
+            fprintf(out, "\t\t%-40s=%20s\n", "CSG Indication", "FALSE");
+        }
+        if(LIBLTE_RRC_CSG_IDENTITY_NOT_PRESENT != sib1->csg_id)
+        {
+            fprintf(out, "\t\t%-40s=%20u\n", "CSG Identity", sib1->csg_id);
+        }
+        fprintf(out, "\t\t%-40s=%17ddBm\n", "Q Rx Lev Min", sib1->q_rx_lev_min);
+        fprintf(out, "\t\t%-40s=%18udB\n", "Q Rx Lev Min Offset", sib1->q_rx_lev_min_offset);
+        if(true == sib1->p_max_present)
+        {
+            fprintf(out, "\t\t%-40s=%17ddBm\n", "P Max", sib1->p_max);
+        }
+        fprintf(out, "\t\t%-40s=%20u\n", "Frequency Band", sib1->freq_band_indicator);
+        fprintf(out, "\t\t%-40s=%18sms\n", "SI Window Length", liblte_rrc_si_window_length_text[sib1->si_window_length]);
+        si_win_len = liblte_rrc_si_window_length_num[sib1->si_window_length];
+        fprintf(out, "\t\t%-40s\n", "Scheduling Info List:");
+        for(i=0; i<sib1->N_sched_info; i++)
+        {
+            fprintf(out, "\t\t\t%s = %s frames\n", "SI Periodicity", liblte_rrc_si_periodicity_text[sib1->sched_info[i].si_periodicity]);
+            si_periodicity_T = liblte_rrc_si_periodicity_num[sib1->sched_info[i].si_periodicity];
+            fprintf(out, "\t\t\tSI Window Starts at N_subframe = %u, SFN mod %u = %u\n", (i * si_win_len) % 10, si_periodicity_T, (i * si_win_len)/10);
+            if(0 == i)
+            {
+                fprintf(out, "\t\t\t\t%s = %s\n", "SIB Type", "2");
+            }
+            for(j=0; j<sib1->sched_info[i].N_sib_mapping_info; j++)
+            {
+                fprintf(out, "\t\t\t\t%s = %u\n", "SIB Type", liblte_rrc_sib_type_num[sib1->sched_info[i].sib_mapping_info[j].sib_type]);
+                switch(sib1->sched_info[i].sib_mapping_info[j].sib_type)
+                {
+                case LIBLTE_RRC_SIB_TYPE_3:
+                    sib3_expected = true;
+                    break;
+                case LIBLTE_RRC_SIB_TYPE_4:
+                    sib4_expected = true;
+                    break;
+                case LIBLTE_RRC_SIB_TYPE_5:
+                    sib5_expected = true;
+                    break;
+                case LIBLTE_RRC_SIB_TYPE_6:
+                    sib6_expected = true;
+                    break;
+                case LIBLTE_RRC_SIB_TYPE_7:
+                    sib7_expected = true;
+                    break;
+                case LIBLTE_RRC_SIB_TYPE_8:
+                    sib8_expected = true;
+                    break;
+                }
+            }
+        }
+        if(false == sib1->tdd)
+        {
+            fprintf(out, "\t\t%-40s=%20s\n", "Duplexing Mode", "FDD");
+        }else{
+            fprintf(out, "\t\t%-40s=%20s\n", "Duplexing Mode", "TDD");
+            fprintf(out, "\t\t%-40s=%20s\n", "Subframe Assignment", liblte_rrc_subframe_assignment_text[sib1->sf_assignment]);
+            fprintf(out, "\t\t%-40s=%20s\n", "Special Subframe Patterns", liblte_rrc_special_subframe_patterns_text[sib1->special_sf_patterns]);
+        }
+        fprintf(out, "\t\t%-40s=%20u\n", "SI Value Tag", sib1->system_info_value_tag);
+        prev_si_value_tag       = sib1->system_info_value_tag;
+        prev_si_value_tag_valid = true;
+
+        sib1_printed = true;
+    }
+}
+
+void LTE_fdd_dl_fs_printer::print_sib2(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_2_STRUCT *sib2)
+{
+    uint32 coeff = 0;
+    uint32 T     = 0;
+    uint32 i;
+
+    if(false == sib2_printed)
+    {
+        fprintf(out, "\tSIB2 Decoded:\n");
+        if(true == sib2->ac_barring_info_present)
+        {
+            if(true == sib2->ac_barring_for_emergency)
+            {
+                fprintf(out, "\t\t%-40s=%20s\n", "AC Barring for Emergency", "Barred");
+            }else{
+                fprintf(out, "\t\t%-40s=%20s\n", "AC Barring for Emergency", "Not Barred");
+            }
+            if(true == sib2->ac_barring_for_mo_signalling.enabled)
+            {
+                fprintf(out, "\t\t%-40s=%20s\n", "AC Barring for MO Signalling", "Barred");
+                fprintf(out, "\t\t\t%-40s=%20s\n", "Factor", liblte_rrc_ac_barring_factor_text[sib2->ac_barring_for_mo_signalling.factor]);
+                fprintf(out, "\t\t\t%-40s=%19ss\n", "Time", liblte_rrc_ac_barring_time_text[sib2->ac_barring_for_mo_signalling.time]);
+                fprintf(out, "\t\t\t%-40s=%20u\n", "Special AC", sib2->ac_barring_for_mo_signalling.for_special_ac);
+            }else{
+                fprintf(out, "\t\t%-40s=%20s\n", "AC Barring for MO Signalling", "Not Barred");
+            }
+            if(true == sib2->ac_barring_for_mo_data.enabled)
+            {
+                fprintf(out, "\t\t%-40s=%20s\n", "AC Barring for MO Data", "Barred");
+                fprintf(out, "\t\t\t%-40s=%20s\n", "Factor", liblte_rrc_ac_barring_factor_text[sib2->ac_barring_for_mo_data.factor]);
+                fprintf(out, "\t\t\t%-40s=%19ss\n", "Time", liblte_rrc_ac_barring_time_text[sib2->ac_barring_for_mo_data.time]);
+                fprintf(out, "\t\t\t%-40s=%20u\n", "Special AC", sib2->ac_barring_for_mo_data.for_special_ac);
+            }else{
+                fprintf(out, "\t\t%-40s=%20s\n", "AC Barring for MO Data", "Not Barred");
+            }
+        }
+        fprintf(out, "\t\t%-40s=%20s\n", "Number of RACH Preambles", liblte_rrc_number_of_ra_preambles_text[sib2->rr_config_common_sib.rach_cnfg.num_ra_preambles]);
+        if(true == sib2->rr_config_common_sib.rach_cnfg.preambles_group_a_cnfg.present)
+        {
+            fprintf(out, "\t\t%-40s=%20s\n", "Size of RACH Preambles Group A", liblte_rrc_size_of_ra_preambles_group_a_text[sib2->rr_config_common_sib.rach_cnfg.preambles_group_a_cnfg.size_of_ra]);
+            fprintf(out, "\t\t%-40s=%15s bits\n", "Message Size Group A", liblte_rrc_message_size_group_a_text[sib2->rr_config_common_sib.rach_cnfg.preambles_group_a_cnfg.msg_size]);
+            fprintf(out, "\t\t%-40s=%18sdB\n", "Message Power Offset Group B", liblte_rrc_message_power_offset_group_b_text[sib2->rr_config_common_sib.rach_cnfg.preambles_group_a_cnfg.msg_pwr_offset_group_b]);
+        }
+        fprintf(out, "\t\t%-40s=%18sdB\n", "Power Ramping Step", liblte_rrc_power_ramping_step_text[sib2->rr_config_common_sib.rach_cnfg.pwr_ramping_step]);
+        fprintf(out, "\t\t%-40s=%17sdBm\n", "Preamble init target RX power", liblte_rrc_preamble_initial_received_target_power_text[sib2->rr_config_common_sib.rach_cnfg.preamble_init_rx_target_pwr]);
+        fprintf(out, "\t\t%-40s=%20s\n", "Preamble TX Max", liblte_rrc_preamble_trans_max_text[sib2->rr_config_common_sib.rach_cnfg.preamble_trans_max]);
+        fprintf(out, "\t\t%-40s=%10s Subframes\n", "RA Response Window Size", liblte_rrc_ra_response_window_size_text[sib2->rr_config_common_sib.rach_cnfg.ra_resp_win_size]);
+        fprintf(out, "\t\t%-40s=%10s Subframes\n", "MAC Contention Resolution Timer", liblte_rrc_mac_contention_resolution_timer_text[sib2->rr_config_common_sib.rach_cnfg.mac_con_res_timer]);
+        fprintf(out, "\t\t%-40s=%20u\n", "Max num HARQ TX for Message 3", sib2->rr_config_common_sib.rach_cnfg.max_harq_msg3_tx);
+        fprintf(out, "\t\t%-40s=%20s\n", "Modification Period Coeff", liblte_rrc_modification_period_coeff_text[sib2->rr_config_common_sib.bcch_cnfg.modification_period_coeff]);
+        coeff = liblte_rrc_modification_period_coeff_num[sib2->rr_config_common_sib.bcch_cnfg.modification_period_coeff];
+        fprintf(out, "\t\t%-40s=%13s Frames\n", "Default Paging Cycle", liblte_rrc_default_paging_cycle_text[sib2->rr_config_common_sib.pcch_cnfg.default_paging_cycle]);
+        T = liblte_rrc_default_paging_cycle_num[sib2->rr_config_common_sib.pcch_cnfg.default_paging_cycle];
+        fprintf(out, "\t\t%-40s=%13u Frames\n", "Modification Period", coeff * T);
+        fprintf(out, "\t\t%-40s=%13u Frames\n", "nB", (uint32)(T * liblte_rrc_nb_num[sib2->rr_config_common_sib.pcch_cnfg.nB]));
+        fprintf(out, "\t\t%-40s=%20u\n", "Root Sequence Index", sib2->rr_config_common_sib.prach_cnfg.root_sequence_index);
+        fprintf(out, "\t\t%-40s=%20u\n", "PRACH Config Index", sib2->rr_config_common_sib.prach_cnfg.prach_cnfg_info.prach_config_index);
+        switch(sib2->rr_config_common_sib.prach_cnfg.prach_cnfg_info.prach_config_index)
+        {
+        case 0:
+            fprintf(out, "\t\t\tPreamble Format = 0, RACH SFN = Even, RACH Subframe Number = 1\n");
+            break;
+        case 1:
+            fprintf(out, "\t\t\tPreamble Format = 0, RACH SFN = Even, RACH Subframe Number = 4\n");
+            break;
+        case 2:
+            fprintf(out, "\t\t\tPreamble Format = 0, RACH SFN = Even, RACH Subframe Number = 7\n");
+            break;
+        case 3:
+            fprintf(out, "\t\t\tPreamble Format = 0, RACH SFN = Any, RACH Subframe Number = 1\n");
+            break;
+        case 4:
+            fprintf(out, "\t\t\tPreamble Format = 0, RACH SFN = Any, RACH Subframe Number = 4\n");
+            break;
+        case 5:
+            fprintf(out, "\t\t\tPreamble Format = 0, RACH SFN = Any, RACH Subframe Number = 7\n");
+            break;
+        case 6:
+            fprintf(out, "\t\t\tPreamble Format = 0, RACH SFN = Any, RACH Subframe Number = 1,6\n");
+            break;
+        case 7:
+            fprintf(out, "\t\t\tPreamble Format = 0, RACH SFN = Any, RACH Subframe Number = 2,7\n");
+            break;
+        case 8:
+            fprintf(out, "\t\t\tPreamble Format = 0, RACH SFN = Any, RACH Subframe Number = 3,8\n");
+            break;
+        case 9:
+            fprintf(out, "\t\t\tPreamble Format = 0, RACH SFN = Any, RACH Subframe Number = 1,4,7\n");
+            break;
+        case 10:
+            fprintf(out, "\t\t\tPreamble Format = 0, RACH SFN = Any, RACH Subframe Number = 2,5,8\n");
+            break;
+        case 11:
+            fprintf(out, "\t\t\tPreamble Format = 0, RACH SFN = Any, RACH Subframe Number = 3,6,9\n");
+            break;
+        case 12:
+            fprintf(out, "\t\t\tPreamble Format = 0, RACH SFN = Any, RACH Subframe Number = 0,2,4,6,8\n");
+            break;
+        case 13:
+            fprintf(out, "\t\t\tPreamble Format = 0, RACH SFN = Any, RACH Subframe Number = 1,3,5,7,9\n");
+            break;
+        case 14:
+            fprintf(out, "\t\t\tPreamble Format = 0, RACH SFN = Any, RACH Subframe Number = 0,1,2,3,4,5,6,7,8,9\n");
+            break;
+        case 15:
+            fprintf(out, "\t\t\tPreamble Format = 0, RACH SFN = Even, RACH Subframe Number = 9\n");
+            break;
+        case 16:
+            fprintf(out, "\t\t\tPreamble Format = 1, RACH SFN = Even, RACH Subframe Number = 1\n");
+            break;
+        case 17:
+            fprintf(out, "\t\t\tPreamble Format = 1, RACH SFN = Even, RACH Subframe Number = 4\n");
+            break;
+        case 18:
+            fprintf(out, "\t\t\tPreamble Format = 1, RACH SFN = Even, RACH Subframe Number = 7\n");
+            break;
+        case 19:
+            fprintf(out, "\t\t\tPreamble Format = 1, RACH SFN = Any, RACH Subframe Number = 1\n");
+            break;
+        case 20:
+            fprintf(out, "\t\t\tPreamble Format = 1, RACH SFN = Any, RACH Subframe Number = 4\n");
+            break;
+        case 21:
+            fprintf(out, "\t\t\tPreamble Format = 1, RACH SFN = Any, RACH Subframe Number = 7\n");
+            break;
+        case 22:
+            fprintf(out, "\t\t\tPreamble Format = 1, RACH SFN = Any, RACH Subframe Number = 1,6\n");
+            break;
+        case 23:
+            fprintf(out, "\t\t\tPreamble Format = 1, RACH SFN = Any, RACH Subframe Number = 2,7\n");
+            break;
+        case 24:
+            fprintf(out, "\t\t\tPreamble Format = 1, RACH SFN = Any, RACH Subframe Number = 3,8\n");
+            break;
+        case 25:
+            fprintf(out, "\t\t\tPreamble Format = 1, RACH SFN = Any, RACH Subframe Number = 1,4,7\n");
+            break;
+        case 26:
+            fprintf(out, "\t\t\tPreamble Format = 1, RACH SFN = Any, RACH Subframe Number = 2,5,8\n");
+            break;
+        case 27:
+            fprintf(out, "\t\t\tPreamble Format = 1, RACH SFN = Any, RACH Subframe Number = 3,6,9\n");
+            break;
+        case 28:
+            fprintf(out, "\t\t\tPreamble Format = 1, RACH SFN = Any, RACH Subframe Number = 0,2,4,6,8\n");
+            break;
+        case 29:
+            fprintf(out, "\t\t\tPreamble Format = 1, RACH SFN = Any, RACH Subframe Number = 1,3,5,7,9\n");
+            break;
+        case 30:
+            fprintf(out, "\t\t\tPreamble Format = N/A, RACH SFN = N/A, RACH Subframe Number = N/A\n");
+            break;
+        case 31:
+            fprintf(out, "\t\t\tPreamble Format = 1, RACH SFN = Even, RACH Subframe Number = 9\n");
+            break;
+        case 32:
+            fprintf(out, "\t\t\tPreamble Format = 2, RACH SFN = Even, RACH Subframe Number = 1\n");
+            break;
+        case 33:
+            fprintf(out, "\t\t\tPreamble Format = 2, RACH SFN = Even, RACH Subframe Number = 4\n");
+            break;
+        case 34:
+            fprintf(out, "\t\t\tPreamble Format = 2, RACH SFN = Even, RACH Subframe Number = 7\n");
+            break;
+        case 35:
+            fprintf(out, "\t\t\tPreamble Format = 2, RACH SFN = Any, RACH Subframe Number = 1\n");
+            break;
+        case 36:
+            fprintf(out, "\t\t\tPreamble Format = 2, RACH SFN = Any, RACH Subframe Number = 4\n");
+            break;
+        case 37:
+            fprintf(out, "\t\t\tPreamble Format = 2, RACH SFN = Any, RACH Subframe Number = 7\n");
+            break;
+        case 38:
+            fprintf(out, "\t\t\tPreamble Format = 2, RACH SFN = Any, RACH Subframe Number = 1,6\n");
+            break;
+        case 39:
+            fprintf(out, "\t\t\tPreamble Format = 2, RACH SFN = Any, RACH Subframe Number = 2,7\n");
+            break;
+        case 40:
+            fprintf(out, "\t\t\tPreamble Format = 2, RACH SFN = Any, RACH Subframe Number = 3,8\n");
+            break;
+        case 41:
+            fprintf(out, "\t\t\tPreamble Format = 2, RACH SFN = Any, RACH Subframe Number = 1,4,7\n");
+            break;
+        case 42:
+            fprintf(out, "\t\t\tPreamble Format = 2, RACH SFN = Any, RACH Subframe Number = 2,5,8\n");
+            break;
+        case 43:
+            fprintf(out, "\t\t\tPreamble Format = 2, RACH SFN = Any, RACH Subframe Number = 3,6,9\n");
+            break;
+        case 44:
+            fprintf(out, "\t\t\tPreamble Format = 2, RACH SFN = Any, RACH Subframe Number = 0,2,4,6,8\n");
+            break;
+        case 45:
+            fprintf(out, "\t\t\tPreamble Format = 2, RACH SFN = Any, RACH Subframe Number = 1,3,5,7,9\n");
+            break;
+        case 46:
+            fprintf(out, "\t\t\tPreamble Format = N/A, RACH SFN = N/A, RACH Subframe Number = N/A\n");
+            break;
+        case 47:
+            fprintf(out, "\t\t\tPreamble Format = 2, RACH SFN = Even, RACH Subframe Number = 9\n");
+            break;
+        case 48:
+            fprintf(out, "\t\t\tPreamble Format = 3, RACH SFN = Even, RACH Subframe Number = 1\n");
+            break;
+        case 49:
+            fprintf(out, "\t\t\tPreamble Format = 3, RACH SFN = Even, RACH Subframe Number = 4\n");
+            break;
+        case 50:
+            fprintf(out, "\t\t\tPreamble Format = 3, RACH SFN = Even, RACH Subframe Number = 7\n");
+            break;
+        case 51:
+            fprintf(out, "\t\t\tPreamble Format = 3, RACH SFN = Any, RACH Subframe Number = 1\n");
+            break;
+        case 52:
+            fprintf(out, "\t\t\tPreamble Format = 3, RACH SFN = Any, RACH Subframe Number = 4\n");
+            break;
+        case 53:
+            fprintf(out, "\t\t\tPreamble Format = 3, RACH SFN = Any, RACH Subframe Number = 7\n");
+            break;
+        case 54:
+            fprintf(out, "\t\t\tPreamble Format = 3, RACH SFN = Any, RACH Subframe Number = 1,6\n");
+            break;
+        case 55:
+            fprintf(out, "\t\t\tPreamble Format = 3, RACH SFN = Any, RACH Subframe Number = 2,7\n");
+            break;
+        case 56:
+            fprintf(out, "\t\t\tPreamble Format = 3, RACH SFN = Any, RACH Subframe Number = 3,8\n");
+            break;
+        case 57:
+            fprintf(out, "\t\t\tPreamble Format = 3, RACH SFN = Any, RACH Subframe Number = 1,4,7\n");
+            break;
+        case 58:
+            fprintf(out, "\t\t\tPreamble Format = 3, RACH SFN = Any, RACH Subframe Number = 2,5,8\n");
+            break;
+        case 59:
+            fprintf(out, "\t\t\tPreamble Format = 3, RACH SFN = Any, RACH Subframe Number = 3,6,9\n");
+            break;
+        case 60:
+            fprintf(out, "\t\t\tPreamble Format = N/A, RACH SFN = N/A, RACH Subframe Number = N/A\n");
+            break;
+        case 61:
+            fprintf(out, "\t\t\tPreamble Format = N/A, RACH SFN = N/A, RACH Subframe Number = N/A\n");
+            break;
+        case 62:
+            fprintf(out, "\t\t\tPreamble Format = N/A, RACH SFN = N/A, RACH Subframe Number = N/A\n");
+            break;
+        case 63:
+            fprintf(out, "\t\t\tPreamble Format = 3, RACH SFN = Even, RACH Subframe Number = 9\n");
+            break;
+        }
+        if(true == sib2->rr_config_common_sib.prach_cnfg.prach_cnfg_info.high_speed_flag)
+        {
+            fprintf(out, "\t\t%-40s=%20s\n", "High Speed Flag", "Restricted Set");
+        }else{
+            fprintf(out, "\t\t%-40s=%20s\n", "High Speed Flag", "Unrestricted Set");
+        }
+        fprintf(out, "\t\t%-40s=%20u\n", "Ncs Configuration", sib2->rr_config_common_sib.prach_cnfg.prach_cnfg_info.zero_correlation_zone_config);
+        fprintf(out, "\t\t%-40s=%20u\n", "PRACH Freq Offset", sib2->rr_config_common_sib.prach_cnfg.prach_cnfg_info.prach_freq_offset);
+        fprintf(out, "\t\t%-40s=%17ddBm\n", "Reference Signal Power", sib2->rr_config_common_sib.pdsch_cnfg.rs_power);
+        fprintf(out, "\t\t%-40s=%20u\n", "Pb", sib2->rr_config_common_sib.pdsch_cnfg.p_b);
+        fprintf(out, "\t\t%-40s=%20u\n", "Nsb", sib2->rr_config_common_sib.pusch_cnfg.n_sb);
+        switch(sib2->rr_config_common_sib.pusch_cnfg.hopping_mode)
+        {
+        case LIBLTE_RRC_HOPPING_MODE_INTER_SUBFRAME:
+            fprintf(out, "\t\t%-40s=%20s\n", "Hopping Mode", "Inter Subframe");
+            break;
+        case LIBLTE_RRC_HOPPING_MODE_INTRA_AND_INTER_SUBFRAME:
+            fprintf(out, "\t\t%-40s= %s\n", "Hopping Mode", "Intra and Inter Subframe");
+            break;
+        }
+        fprintf(out, "\t\t%-40s=%20u\n", "PUSCH Nrb Hopping Offset", sib2->rr_config_common_sib.pusch_cnfg.pusch_hopping_offset);
+        if(true == sib2->rr_config_common_sib.pusch_cnfg.enable_64_qam)
+        {
+            fprintf(out, "\t\t%-40s=%20s\n", "64QAM", "Allowed");
+        }else{
+            fprintf(out, "\t\t%-40s=%20s\n", "64QAM", "Not Allowed");
+        }
+        if(true == sib2->rr_config_common_sib.pusch_cnfg.ul_rs.group_hopping_enabled)
+        {
+            fprintf(out, "\t\t%-40s=%20s\n", "Group Hopping", "Enabled");
+        }else{
+            fprintf(out, "\t\t%-40s=%20s\n", "Group Hopping", "Disabled");
+        }
+        fprintf(out, "\t\t%-40s=%20u\n", "Group Assignment PUSCH", sib2->rr_config_common_sib.pusch_cnfg.ul_rs.group_assignment_pusch);
+        if(true == sib2->rr_config_common_sib.pusch_cnfg.ul_rs.sequence_hopping_enabled)
+        {
+            fprintf(out, "\t\t%-40s=%20s\n", "Sequence Hopping", "Enabled");
+        }else{
+            fprintf(out, "\t\t%-40s=%20s\n", "Sequence Hopping", "Disabled");
+        }
+        fprintf(out, "\t\t%-40s=%20u\n", "Cyclic Shift", sib2->rr_config_common_sib.pusch_cnfg.ul_rs.cyclic_shift);
+        fprintf(out, "\t\t%-40s=%20s\n", "Delta PUCCH Shift", liblte_rrc_delta_pucch_shift_text[sib2->rr_config_common_sib.pucch_cnfg.delta_pucch_shift]);
+        fprintf(out, "\t\t%-40s=%20u\n", "N_rb_cqi", sib2->rr_config_common_sib.pucch_cnfg.n_rb_cqi);
+        fprintf(out, "\t\t%-40s=%20u\n", "N_cs_an", sib2->rr_config_common_sib.pucch_cnfg.n_cs_an);
+        fprintf(out, "\t\t%-40s=%20u\n", "N1 PUCCH AN", sib2->rr_config_common_sib.pucch_cnfg.n1_pucch_an);
+        if(true == sib2->rr_config_common_sib.srs_ul_cnfg.present)
+        {
+            fprintf(out, "\t\t%-40s=%20s\n", "SRS Bandwidth Config", liblte_rrc_srs_bw_config_text[sib2->rr_config_common_sib.srs_ul_cnfg.bw_cnfg]);
+            fprintf(out, "\t\t%-40s=%20s\n", "SRS Subframe Config", liblte_rrc_srs_subfr_config_text[sib2->rr_config_common_sib.srs_ul_cnfg.subfr_cnfg]);
+            if(true == sib2->rr_config_common_sib.srs_ul_cnfg.ack_nack_simul_tx)
+            {
+                fprintf(out, "\t\t%-40s=%20s\n", "Simultaneous AN and SRS", "True");
+            }else{
+                fprintf(out, "\t\t%-40s=%20s\n", "Simultaneous AN and SRS", "False");
+            }
+            if(true == sib2->rr_config_common_sib.srs_ul_cnfg.max_up_pts_present)
+            {
+                fprintf(out, "\t\t%-40s=%20s\n", "SRS Max Up PTS", "True");
+            }else{
+                fprintf(out, "\t\t%-40s=%20s\n", "SRS Max Up PTS", "False");
+            }
+        }
+        fprintf(out, "\t\t%-40s=%17ddBm\n", "P0 Nominal PUSCH", sib2->rr_config_common_sib.ul_pwr_ctrl.p0_nominal_pusch);
+        fprintf(out, "\t\t%-40s=%20s\n", "Alpha", liblte_rrc_ul_power_control_alpha_text[sib2->rr_config_common_sib.ul_pwr_ctrl.alpha]);
+        fprintf(out, "\t\t%-40s=%17ddBm\n", "P0 Nominal PUCCH", sib2->rr_config_common_sib.ul_pwr_ctrl.p0_nominal_pucch);
+        fprintf(out, "\t\t%-40s=%18sdB\n", "Delta F PUCCH Format 1", liblte_rrc_delta_f_pucch_format_1_text[sib2->rr_config_common_sib.ul_pwr_ctrl.delta_flist_pucch.format_1]);
+        fprintf(out, "\t\t%-40s=%18sdB\n", "Delta F PUCCH Format 1B", liblte_rrc_delta_f_pucch_format_1b_text[sib2->rr_config_common_sib.ul_pwr_ctrl.delta_flist_pucch.format_1b]);
+        fprintf(out, "\t\t%-40s=%18sdB\n", "Delta F PUCCH Format 2", liblte_rrc_delta_f_pucch_format_2_text[sib2->rr_config_common_sib.ul_pwr_ctrl.delta_flist_pucch.format_2]);
+        fprintf(out, "\t\t%-40s=%18sdB\n", "Delta F PUCCH Format 2A", liblte_rrc_delta_f_pucch_format_2a_text[sib2->rr_config_common_sib.ul_pwr_ctrl.delta_flist_pucch.format_2a]);
+        fprintf(out, "\t\t%-40s=%18sdB\n", "Delta F PUCCH Format 2B", liblte_rrc_delta_f_pucch_format_2b_text[sib2->rr_config_common_sib.ul_pwr_ctrl.delta_flist_pucch.format_2b]);
+        fprintf(out, "\t\t%-40s=%18ddB\n", "Delta Preamble Message 3", sib2->rr_config_common_sib.ul_pwr_ctrl.delta_preamble_msg3);
+        switch(sib2->rr_config_common_sib.ul_cp_length)
+        {
+        case LIBLTE_RRC_UL_CP_LENGTH_1:
+            fprintf(out, "\t\t%-40s=%20s\n", "UL CP Length", "Normal");
+            break;
+        case LIBLTE_RRC_UL_CP_LENGTH_2:
+            fprintf(out, "\t\t%-40s=%20s\n", "UL CP Length", "Extended");
+            break;
+        }
+        fprintf(out, "\t\t%-40s=%18sms\n", "T300", liblte_rrc_t300_text[sib2->ue_timers_and_constants.t300]);
+        fprintf(out, "\t\t%-40s=%18sms\n", "T301", liblte_rrc_t301_text[sib2->ue_timers_and_constants.t301]);
+        fprintf(out, "\t\t%-40s=%18sms\n", "T310", liblte_rrc_t310_text[sib2->ue_timers_and_constants.t310]);
+        fprintf(out, "\t\t%-40s=%20s\n", "N310", liblte_rrc_n310_text[sib2->ue_timers_and_constants.n310]);
+        fprintf(out, "\t\t%-40s=%18sms\n", "T311", liblte_rrc_t311_text[sib2->ue_timers_and_constants.t311]);
+        fprintf(out, "\t\t%-40s=%20s\n", "N311", liblte_rrc_n311_text[sib2->ue_timers_and_constants.n311]);
+        if(true == sib2->arfcn_value_eutra.present)
+        {
+            fprintf(out, "\t\t%-40s=%20u\n", "UL ARFCN", sib2->arfcn_value_eutra.value);
+        }
+        if(true == sib2->ul_bw.present)
+        {
+            fprintf(out, "\t\t%-40s=%17sMHz\n", "UL Bandwidth", liblte_rrc_ul_bw_text[sib2->ul_bw.bw]);
+        }
+        fprintf(out, "\t\t%-40s=%20u\n", "Additional Spectrum Emission", sib2->additional_spectrum_emission);
+        if(0 != sib2->mbsfn_subfr_cnfg_list_size)
+        {
+            fprintf(out, "\t\t%s:\n", "MBSFN Subframe Config List");
+        }
+        for(i=0; i<sib2->mbsfn_subfr_cnfg_list_size; i++)
+        {
+            fprintf(out, "\t\t\t%-40s=%20s\n", "Radio Frame Alloc Period", liblte_rrc_radio_frame_allocation_period_text[sib2->mbsfn_subfr_cnfg[i].radio_fr_alloc_period]);
+            fprintf(out, "\t\t\t%-40s=%20u\n", "Radio Frame Alloc Offset", sib2->mbsfn_subfr_cnfg[i].subfr_alloc);
+            fprintf(out, "\t\t\tSubframe Alloc%-26s=%20u\n", liblte_rrc_subframe_allocation_num_frames_text[sib2->mbsfn_subfr_cnfg[i].subfr_alloc_num_frames], sib2->mbsfn_subfr_cnfg[i].subfr_alloc);
+        }
+        fprintf(out, "\t\t%-40s=%10s Subframes\n", "Time Alignment Timer", liblte_rrc_time_alignment_timer_text[sib2->time_alignment_timer]);
+
+        sib2_printed = true;
+    }
+}
+
+void LTE_fdd_dl_fs_printer::print_sib3(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_3_STRUCT *sib3)
+{
+    if(false == sib3_printed)
+    {
+        fprintf(out, "\tSIB3 Decoded:\n");
+        fprintf(out, "\t\t%-40s=%18sdB\n", "Q-Hyst", liblte_rrc_q_hyst_text[sib3->q_hyst]);
+        if(true == sib3->speed_state_resel_params.present)
+        {
+            fprintf(out, "\t\t%-40s=%19ss\n", "T-Evaluation", liblte_rrc_t_evaluation_text[sib3->speed_state_resel_params.mobility_state_params.t_eval]);
+            fprintf(out, "\t\t%-40s=%19ss\n", "T-Hyst Normal", liblte_rrc_t_hyst_normal_text[sib3->speed_state_resel_params.mobility_state_params.t_hyst_normal]);
+            fprintf(out, "\t\t%-40s=%20u\n", "N-Cell Change Medium", sib3->speed_state_resel_params.mobility_state_params.n_cell_change_medium);
+            fprintf(out, "\t\t%-40s=%20u\n", "N-Cell Change High", sib3->speed_state_resel_params.mobility_state_params.n_cell_change_high);
+            fprintf(out, "\t\t%-40s=%18sdB\n", "Q-Hyst SF Medium", liblte_rrc_sf_medium_text[sib3->speed_state_resel_params.q_hyst_sf.medium]);
+            fprintf(out, "\t\t%-40s=%18sdB\n", "Q-Hyst SF High", liblte_rrc_sf_high_text[sib3->speed_state_resel_params.q_hyst_sf.high]);
+        }
+        if(true == sib3->s_non_intra_search_present)
+        {
+            fprintf(out, "\t\t%-40s=%18udB\n", "S-Non Intra Search", sib3->s_non_intra_search);
+        }
+        fprintf(out, "\t\t%-40s=%18udB\n", "Threshold Serving Low", sib3->thresh_serving_low);
+        fprintf(out, "\t\t%-40s=%20u\n", "Cell Reselection Priority", sib3->cell_resel_prio);
+        fprintf(out, "\t\t%-40s=%17ddBm\n", "Q Rx Lev Min", sib3->q_rx_lev_min);
+        if(true == sib3->p_max_present)
+        {
+            fprintf(out, "\t\t%-40s=%17ddBm\n", "P Max", sib3->p_max);
+        }
+        if(true == sib3->s_intra_search_present)
+        {
+            fprintf(out, "\t\t%-40s=%18udB\n", "S-Intra Search", sib3->s_intra_search);
+        }
+        if(true == sib3->allowed_meas_bw_present)
+        {
+            fprintf(out, "\t\t%-40s=%17sMHz\n", "Allowed Meas Bandwidth", liblte_rrc_allowed_meas_bandwidth_text[sib3->allowed_meas_bw]);
+        }
+        if(true == sib3->presence_ant_port_1)
+        {
+            fprintf(out, "\t\t%-40s=%20s\n", "Presence Antenna Port 1", "True");
+        }else{
+            fprintf(out, "\t\t%-40s=%20s\n", "Presence Antenna Port 1", "False");
+        }
+        switch(sib3->neigh_cell_cnfg)
+        {
+        case 0:
+            fprintf(out, "\t\t%-40s= %s\n", "Neighbor Cell Config", "Not all neighbor cells have the same MBSFN alloc");
+            break;
+        case 1:
+            fprintf(out, "\t\t%-40s= %s\n", "Neighbor Cell Config", "MBSFN allocs are identical for all neighbor cells");
+            break;
+        case 2:
+            fprintf(out, "\t\t%-40s= %s\n", "Neighbor Cell Config", "No MBSFN allocs are present in neighbor cells");
+            break;
+        case 3:
+            fprintf(out, "\t\t%-40s= %s\n", "Neighbor Cell Config", "Different UL/DL allocs in neighbor cells for TDD");
+            break;
+        }
+        fprintf(out, "\t\t%-40s=%19us\n", "T-Reselection EUTRA", sib3->t_resel_eutra);
+        if(true == sib3->t_resel_eutra_sf_present)
+        {
+            fprintf(out, "\t\t%-40s=%20s\n", "T-Reselection EUTRA SF Medium", liblte_rrc_sssf_medium_text[sib3->t_resel_eutra_sf.sf_medium]);
+            fprintf(out, "\t\t%-40s=%20s\n", "T-Reselection EUTRA SF High", liblte_rrc_sssf_high_text[sib3->t_resel_eutra_sf.sf_high]);
+        }
+
+        sib3_printed = true;
+    }
+}
+
+void LTE_fdd_dl_fs_printer::print_sib4(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_4_STRUCT *sib4)
+{
+    uint32 i;
+    uint32 stop;
+
+    if(false == sib4_printed)
+    {
+        fprintf(out, "\tSIB4 Decoded:\n");
+        if(0 != sib4->intra_freq_neigh_cell_list_size)
+        {
+            fprintf(out, "\t\tList of intra-frequency neighboring cells:\n");
+        }
+        for(i=0; i<sib4->intra_freq_neigh_cell_list_size; i++)
+        {
+            fprintf(out, "\t\t\t%s = %u\n", "Physical Cell ID", sib4->intra_freq_neigh_cell_list[i].phys_cell_id);
+            fprintf(out, "\t\t\t\t%s = %sdB\n", "Q Offset Range", liblte_rrc_q_offset_range_text[sib4->intra_freq_neigh_cell_list[i].q_offset_range]);
+        }
+        if(0 != sib4->intra_freq_black_cell_list_size)
+        {
+            fprintf(out, "\t\tList of blacklisted intra-frequency neighboring cells:\n");
+        }
+        for(i=0; i<sib4->intra_freq_black_cell_list_size; i++)
+        {
+            fprintf(out, "\t\t\t%u - %u\n", sib4->intra_freq_black_cell_list[i].start, sib4->intra_freq_black_cell_list[i].start + liblte_rrc_phys_cell_id_range_num[sib4->intra_freq_black_cell_list[i].range]);
+        }
+        if(true == sib4->csg_phys_cell_id_range_present)
+        {
+            fprintf(out, "\t\t%-40s= %u - %u\n", "CSG Phys Cell ID Range", sib4->csg_phys_cell_id_range.start, sib4->csg_phys_cell_id_range.start + liblte_rrc_phys_cell_id_range_num[sib4->csg_phys_cell_id_range.range]);
+        }
+
+        sib4_printed = true;
+    }
+}
+
+void LTE_fdd_dl_fs_printer::print_sib5(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_5_STRUCT *sib5)
+{
+    uint32 i;
+    uint32 j;
+    uint16 stop;
+
+    if(false == sib5_printed)
+    {
+        fprintf(out, "\tSIB5 Decoded:\n");
+        fprintf(out, "\t\tList of inter-frequency neighboring cells:\n");
+        for(i=0; i<sib5->inter_freq_carrier_freq_list_size; i++)
+        {
+            fprintf(out, "\t\t\t%-40s=%20u\n", "ARFCN", sib5->inter_freq_carrier_freq_list[i].dl_carrier_freq);
+            fprintf(out, "\t\t\t%-40s=%17ddBm\n", "Q Rx Lev Min", sib5->inter_freq_carrier_freq_list[i].q_rx_lev_min);
+            if(true == sib5->inter_freq_carrier_freq_list[i].p_max_present)
+            {
+                fprintf(out, "\t\t\t%-40s=%17ddBm\n", "P Max", sib5->inter_freq_carrier_freq_list[i].p_max);
+            }
+            fprintf(out, "\t\t\t%-40s=%19us\n", "T-Reselection EUTRA", sib5->inter_freq_carrier_freq_list[i].t_resel_eutra);
+            if(true == sib5->inter_freq_carrier_freq_list[i].t_resel_eutra_sf_present)
+            {
+                fprintf(out, "\t\t\t%-40s=%20s\n", "T-Reselection EUTRA SF Medium", liblte_rrc_sssf_medium_text[sib5->inter_freq_carrier_freq_list[i].t_resel_eutra_sf.sf_medium]);
+                fprintf(out, "\t\t\t%-40s=%20s\n", "T-Reselection EUTRA SF High", liblte_rrc_sssf_high_text[sib5->inter_freq_carrier_freq_list[i].t_resel_eutra_sf.sf_high]);
+            }
+            fprintf(out, "\t\t\t%-40s=%20u\n", "Threshold X High", sib5->inter_freq_carrier_freq_list[i].threshx_high);
+            fprintf(out, "\t\t\t%-40s=%20u\n", "Threshold X Low", sib5->inter_freq_carrier_freq_list[i].threshx_low);
+            fprintf(out, "\t\t\t%-40s=%17sMHz\n", "Allowed Meas Bandwidth", liblte_rrc_allowed_meas_bandwidth_text[sib5->inter_freq_carrier_freq_list[i].allowed_meas_bw]);
+            if(true == sib5->inter_freq_carrier_freq_list[i].presence_ant_port_1)
+            {
+                fprintf(out, "\t\t\t%-40s=%20s\n", "Presence Antenna Port 1", "True");
+            }else{
+                fprintf(out, "\t\t\t%-40s=%20s\n", "Presence Antenna Port 1", "False");
+            }
+            if(true == sib5->inter_freq_carrier_freq_list[i].cell_resel_prio_present)
+            {
+                fprintf(out, "\t\t\t%-40s=%20u\n", "Cell Reselection Priority", sib5->inter_freq_carrier_freq_list[i].cell_resel_prio);
+            }
+            switch(sib5->inter_freq_carrier_freq_list[i].neigh_cell_cnfg)
+            {
+            case 0:
+                fprintf(out, "\t\t\t%-40s= %s\n", "Neighbor Cell Config", "Not all neighbor cells have the same MBSFN alloc");
+                break;
+            case 1:
+                fprintf(out, "\t\t\t%-40s= %s\n", "Neighbor Cell Config", "MBSFN allocs are identical for all neighbor cells");
+                break;
+            case 2:
+                fprintf(out, "\t\t\t%-40s= %s\n", "Neighbor Cell Config", "No MBSFN allocs are present in neighbor cells");
+                break;
+            case 3:
+                fprintf(out, "\t\t\t%-40s= %s\n", "Neighbor Cell Config", "Different UL/DL allocs in neighbor cells for TDD");
+                break;
+            }
+            fprintf(out, "\t\t\t%-40s=%18sdB\n", "Q Offset Freq", liblte_rrc_q_offset_range_text[sib5->inter_freq_carrier_freq_list[i].q_offset_freq]);
+            if(0 != sib5->inter_freq_carrier_freq_list[i].inter_freq_neigh_cell_list_size)
+            {
+                fprintf(out, "\t\t\tList of inter-frequency neighboring cells with specific cell reselection parameters:\n");
+                for(j=0; j<sib5->inter_freq_carrier_freq_list[i].inter_freq_neigh_cell_list_size; j++)
+                {
+                    fprintf(out, "\t\t\t\t%-40s=%20u\n", "Physical Cell ID", sib5->inter_freq_carrier_freq_list[i].inter_freq_neigh_cell_list[j].phys_cell_id);
+                    fprintf(out, "\t\t\t\t%-40s=%18sdB\n", "Q Offset Cell", liblte_rrc_q_offset_range_text[sib5->inter_freq_carrier_freq_list[i].inter_freq_neigh_cell_list[j].q_offset_cell]);
+                }
+            }
+            if(0 != sib5->inter_freq_carrier_freq_list[i].inter_freq_black_cell_list_size)
+            {
+                fprintf(out, "\t\t\tList of blacklisted inter-frequency neighboring cells\n");
+                for(j=0; j<sib5->inter_freq_carrier_freq_list[i].inter_freq_black_cell_list_size; j++)
+                {
+                    fprintf(out, "\t\t\t\t%u - %u\n", sib5->inter_freq_carrier_freq_list[i].inter_freq_black_cell_list[j].start, sib5->inter_freq_carrier_freq_list[i].inter_freq_black_cell_list[j].start + liblte_rrc_phys_cell_id_range_num[sib5->inter_freq_carrier_freq_list[i].inter_freq_black_cell_list[j].range]);
+                }
+            }
+        }
+
+        sib5_printed = true;
+    }
+}
+
+void LTE_fdd_dl_fs_printer::print_sib6(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_6_STRUCT *sib6)
+{
+    uint32 i;
+
+    if(false == sib6_printed)
+    {
+        fprintf(out, "\tSIB6 Decoded:\n");
+        if(0 != sib6->carrier_freq_list_utra_fdd_size)
+        {
+            fprintf(out, "\t\t%s:\n", "Carrier Freq List UTRA FDD");
+        }
+        for(i=0; i<sib6->carrier_freq_list_utra_fdd_size; i++)
+        {
+            fprintf(out, "\t\t\t%-40s=%20u\n", "ARFCN", sib6->carrier_freq_list_utra_fdd[i].carrier_freq);
+            if(true == sib6->carrier_freq_list_utra_fdd[i].cell_resel_prio_present)
+            {
+                fprintf(out, "\t\t\t%-40s=%20u\n", "Cell Reselection Priority", sib6->carrier_freq_list_utra_fdd[i].cell_resel_prio);
+            }
+            fprintf(out, "\t\t\t%-40s=%20u\n", "Threshold X High", sib6->carrier_freq_list_utra_fdd[i].threshx_high);
+            fprintf(out, "\t\t\t%-40s=%20u\n", "Threshold X Low", sib6->carrier_freq_list_utra_fdd[i].threshx_low);
+            fprintf(out, "\t\t\t%-40s=%17ddBm\n", "Q Rx Lev Min", sib6->carrier_freq_list_utra_fdd[i].q_rx_lev_min);
+            fprintf(out, "\t\t\t%-40s=%17ddBm\n", "P Max UTRA", sib6->carrier_freq_list_utra_fdd[i].p_max_utra);
+            fprintf(out, "\t\t\t%-40s=%18dB\n", "Q Qual Min", sib6->carrier_freq_list_utra_fdd[i].q_qual_min);
+        }
+        if(0 != sib6->carrier_freq_list_utra_tdd_size)
+        {
+            fprintf(out, "\t\t%s:\n", "Carrier Freq List UTRA TDD");
+        }
+        for(i=0; i<sib6->carrier_freq_list_utra_tdd_size; i++)
+        {
+            fprintf(out, "\t\t\t%-40s=%20u\n", "ARFCN", sib6->carrier_freq_list_utra_tdd[i].carrier_freq);
+            if(true == sib6->carrier_freq_list_utra_tdd[i].cell_resel_prio_present)
+            {
+                fprintf(out, "\t\t\t%-40s=%20u\n", "Cell Reselection Priority", sib6->carrier_freq_list_utra_tdd[i].cell_resel_prio);
+            }
+            fprintf(out, "\t\t\t%-40s=%20u\n", "Threshold X High", sib6->carrier_freq_list_utra_tdd[i].threshx_high);
+            fprintf(out, "\t\t\t%-40s=%20u\n", "Threshold X Low", sib6->carrier_freq_list_utra_tdd[i].threshx_low);
+            fprintf(out, "\t\t\t%-40s=%17ddBm\n", "Q Rx Lev Min", sib6->carrier_freq_list_utra_tdd[i].q_rx_lev_min);
+            fprintf(out, "\t\t\t%-40s=%17ddBm\n", "P Max UTRA", sib6->carrier_freq_list_utra_tdd[i].p_max_utra);
+        }
+        fprintf(out, "\t\t%-40s=%19us\n", "T-Reselection UTRA", sib6->t_resel_utra);
+        if(true == sib6->t_resel_utra_sf_present)
+        {
+            fprintf(out, "\t\t%-40s=%20s\n", "T-Reselection UTRA SF Medium", liblte_rrc_sssf_medium_text[sib6->t_resel_utra_sf.sf_medium]);
+            fprintf(out, "\t\t%-40s=%20s\n", "T-Reselection UTRA SF High", liblte_rrc_sssf_high_text[sib6->t_resel_utra_sf.sf_high]);
+        }
+
+        sib6_printed = true;
+    }
+}
+
+void LTE_fdd_dl_fs_printer::print_sib7(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_7_STRUCT *sib7)
+{
+    uint32 i;
+    uint32 j;
+
+    if(false == sib7_printed)
+    {
+        fprintf(out, "\tSIB7 Decoded:\n");
+        fprintf(out, "\t\t%-40s=%19us\n", "T-Reselection GERAN", sib7->t_resel_geran);
+        if(true == sib7->t_resel_geran_sf_present)
+        {
+            fprintf(out, "\t\t%-40s=%20s\n", "T-Reselection GERAN SF Medium", liblte_rrc_sssf_medium_text[sib7->t_resel_geran_sf.sf_medium]);
+            fprintf(out, "\t\t%-40s=%20s\n", "T-Reselection GERAN SF High", liblte_rrc_sssf_high_text[sib7->t_resel_geran_sf.sf_high]);
+        }
+        if(0 != sib7->carrier_freqs_info_list_size)
+        {
+            fprintf(out, "\t\tList of neighboring GERAN carrier frequencies\n");
+        }
+        for(i=0; i<sib7->carrier_freqs_info_list_size; i++)
+        {
+            fprintf(out, "\t\t\t%-40s=%20u\n", "Starting ARFCN", sib7->carrier_freqs_info_list[i].carrier_freqs.starting_arfcn);
+            fprintf(out, "\t\t\t%-40s=%20s\n", "Band Indicator", liblte_rrc_band_indicator_geran_text[sib7->carrier_freqs_info_list[i].carrier_freqs.band_indicator]);
+            if(LIBLTE_RRC_FOLLOWING_ARFCNS_EXPLICIT_LIST == sib7->carrier_freqs_info_list[i].carrier_freqs.following_arfcns)
+            {
+                fprintf(out, "\t\t\tFollowing ARFCNs Explicit List\n");
+                for(j=0; j<sib7->carrier_freqs_info_list[i].carrier_freqs.explicit_list_of_arfcns_size; j++)
+                {
+                    fprintf(out, "\t\t\t\t%u\n", sib7->carrier_freqs_info_list[i].carrier_freqs.explicit_list_of_arfcns[j]);
+                }
+            }else if(LIBLTE_RRC_FOLLOWING_ARFCNS_EQUALLY_SPACED == sib7->carrier_freqs_info_list[i].carrier_freqs.following_arfcns){
+                fprintf(out, "\t\t\tFollowing ARFCNs Equally Spaced\n");
+                fprintf(out, "\t\t\t\t%u, %u\n", sib7->carrier_freqs_info_list[i].carrier_freqs.equally_spaced_arfcns.arfcn_spacing, sib7->carrier_freqs_info_list[i].carrier_freqs.equally_spaced_arfcns.number_of_arfcns);
+            }else{
+                fprintf(out, "\t\t\tFollowing ARFCNs Variable Bit Map\n");
+                fprintf(out, "\t\t\t\t%02X\n", sib7->carrier_freqs_info_list[i].carrier_freqs.variable_bit_map_of_arfcns);
+            }
+            if(true == sib7->carrier_freqs_info_list[i].cell_resel_prio_present)
+            {
+                fprintf(out, "\t\t\t%-40s=%20u\n", "Cell Reselection Priority", sib7->carrier_freqs_info_list[i].cell_resel_prio);
+            }
+            fprintf(out, "\t\t\t%-40s=%20u\n", "NCC Permitted", sib7->carrier_freqs_info_list[i].ncc_permitted);
+            fprintf(out, "\t\t\t%-40s=%17ddBm\n", "Q Rx Lev Min", sib7->carrier_freqs_info_list[i].q_rx_lev_min);
+            if(true == sib7->carrier_freqs_info_list[i].p_max_geran_present)
+            {
+                fprintf(out, "\t\t\t%-40s=%17udBm\n", "P Max GERAN", sib7->carrier_freqs_info_list[i].p_max_geran);
+            }
+            fprintf(out, "\t\t\t%-40s=%20u\n", "Threshold X High", sib7->carrier_freqs_info_list[i].threshx_high);
+            fprintf(out, "\t\t\t%-40s=%20u\n", "Threshold X Low", sib7->carrier_freqs_info_list[i].threshx_low);
+        }
+
+        sib7_printed = true;
+    }
+}
+
+void LTE_fdd_dl_fs_printer::print_sib8(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_8_STRUCT *sib8)
+{
+    uint32 i;
+    uint32 j;
+    uint32 k;
+
+    if(false == sib8_printed)
+    {
+        fprintf(out, "\tSIB8 Decoded:\n");
+        if(true == sib8->sys_time_info_present)
+        {
+            if(true == sib8->sys_time_info_cdma2000.cdma_eutra_sync)
+            {
+                fprintf(out, "\t\t%-40s=%20s\n", "CDMA EUTRA sync", "True");
+            }else{
+                fprintf(out, "\t\t%-40s=%20s\n", "CDMA EUTRA sync", "False");
+            }
+            if(true == sib8->sys_time_info_cdma2000.system_time_async)
+            {
+                fprintf(out, "\t\t%-40s=%14llu chips\n", "System Time", sib8->sys_time_info_cdma2000.system_time * 8);
+            }else{
+                fprintf(out, "\t\t%-40s=%17llu ms\n", "System Time", sib8->sys_time_info_cdma2000.system_time * 10);
+            }
+        }
+        if(true == sib8->search_win_size_present)
+        {
+            fprintf(out, "\t\t%-40s=%20u\n", "Search Window Size", sib8->search_win_size);
+        }
+        if(true == sib8->params_hrpd_present)
+        {
+            if(true == sib8->pre_reg_info_hrpd.pre_reg_allowed)
+            {
+                fprintf(out, "\t\t%-40s=%20s\n", "Pre Registration", "Allowed");
+            }else{
+                fprintf(out, "\t\t%-40s=%20s\n", "Pre Registration", "Not Allowed");
+            }
+            if(true == sib8->pre_reg_info_hrpd.pre_reg_zone_id_present)
+            {
+                fprintf(out, "\t\t%-40s=%20u\n", "Pre Registration Zone ID", sib8->pre_reg_info_hrpd.pre_reg_zone_id);
+            }
+            if(0 != sib8->pre_reg_info_hrpd.secondary_pre_reg_zone_id_list_size)
+            {
+                fprintf(out, "\t\tSecondary Pre Registration Zone IDs:\n");
+            }
+            for(i=0; i<sib8->pre_reg_info_hrpd.secondary_pre_reg_zone_id_list_size; i++)
+            {
+                fprintf(out, "\t\t\t%u\n", sib8->pre_reg_info_hrpd.secondary_pre_reg_zone_id_list[i]);
+            }
+            if(true == sib8->cell_resel_params_hrpd_present)
+            {
+                fprintf(out, "\t\tBand Class List:\n");
+                for(i=0; i<sib8->cell_resel_params_hrpd.band_class_list_size; i++)
+                {
+                    fprintf(out, "\t\t\t%-40s=%20s\n", "Band Class", liblte_rrc_band_class_cdma2000_text[sib8->cell_resel_params_hrpd.band_class_list[i].band_class]);
+                    if(true == sib8->cell_resel_params_hrpd.band_class_list[i].cell_resel_prio_present)
+                    {
+                        fprintf(out, "\t\t\t%-40s=%20u\n", "Cell Reselection Priority", sib8->cell_resel_params_hrpd.band_class_list[i].cell_resel_prio);
+                    }
+                    fprintf(out, "\t\t\t%-40s=%20u\n", "Threshold X High", sib8->cell_resel_params_hrpd.band_class_list[i].thresh_x_high);
+                    fprintf(out, "\t\t\t%-40s=%20u\n", "Threshold X Low", sib8->cell_resel_params_hrpd.band_class_list[i].thresh_x_low);
+                }
+                fprintf(out, "\t\tNeighbor Cell List:\n");
+                for(i=0; i<sib8->cell_resel_params_hrpd.neigh_cell_list_size; i++)
+                {
+                    fprintf(out, "\t\t\t%-40s=%20s\n", "Band Class", liblte_rrc_band_class_cdma2000_text[sib8->cell_resel_params_hrpd.neigh_cell_list[i].band_class]);
+                    fprintf(out, "\t\t\tNeighbor Cells Per Frequency List\n");
+                    for(j=0; j<sib8->cell_resel_params_hrpd.neigh_cell_list[i].neigh_cells_per_freq_list_size; j++)
+                    {
+                        fprintf(out, "\t\t\t\t%-40s=%20u\n", "ARFCN", sib8->cell_resel_params_hrpd.neigh_cell_list[i].neigh_cells_per_freq_list[j].arfcn);
+                        fprintf(out, "\t\t\t\tPhys Cell ID List\n");
+                        for(k=0; k<sib8->cell_resel_params_hrpd.neigh_cell_list[i].neigh_cells_per_freq_list[j].phys_cell_id_list_size; k++)
+                        {
+                            fprintf(out, "\t\t\t\t\t%u\n", sib8->cell_resel_params_hrpd.neigh_cell_list[i].neigh_cells_per_freq_list[j].phys_cell_id_list[k]);
+                        }
+                    }
+                }
+                fprintf(out, "\t\t%-40s=%19us\n", "T Reselection", sib8->cell_resel_params_hrpd.t_resel_cdma2000);
+                if(true == sib8->cell_resel_params_hrpd.t_resel_cdma2000_sf_present)
+                {
+                    fprintf(out, "\t\t%-40s=%20s\n", "T-Reselection Scale Factor Medium", liblte_rrc_sssf_medium_text[sib8->cell_resel_params_hrpd.t_resel_cdma2000_sf.sf_medium]);
+                    fprintf(out, "\t\t%-40s=%20s\n", "T-Reselection Scale Factor High", liblte_rrc_sssf_high_text[sib8->cell_resel_params_hrpd.t_resel_cdma2000_sf.sf_high]);
+                }
+            }
+        }
+        if(true == sib8->params_1xrtt_present)
+        {
+            fprintf(out, "\t\tCSFB Registration Parameters\n");
+            if(true == sib8->csfb_reg_param_1xrtt_present)
+            {
+                fprintf(out, "\t\t\t%-40s=%20u\n", "SID", sib8->csfb_reg_param_1xrtt.sid);
+                fprintf(out, "\t\t\t%-40s=%20u\n", "NID", sib8->csfb_reg_param_1xrtt.nid);
+                if(true == sib8->csfb_reg_param_1xrtt.multiple_sid)
+                {
+                    fprintf(out, "\t\t\t%-40s=%20s\n", "Multiple SIDs", "True");
+                }else{
+                    fprintf(out, "\t\t\t%-40s=%20s\n", "Multiple SIDs", "False");
+                }
+                if(true == sib8->csfb_reg_param_1xrtt.multiple_nid)
+                {
+                    fprintf(out, "\t\t\t%-40s=%20s\n", "Multiple NIDs", "True");
+                }else{
+                    fprintf(out, "\t\t\t%-40s=%20s\n", "Multiple NIDs", "False");
+                }
+                if(true == sib8->csfb_reg_param_1xrtt.home_reg)
+                {
+                    fprintf(out, "\t\t\t%-40s=%20s\n", "Home Reg", "True");
+                }else{
+                    fprintf(out, "\t\t\t%-40s=%20s\n", "Home Reg", "False");
+                }
+                if(true == sib8->csfb_reg_param_1xrtt.foreign_sid_reg)
+                {
+                    fprintf(out, "\t\t\t%-40s=%20s\n", "Foreign SID Reg", "True");
+                }else{
+                    fprintf(out, "\t\t\t%-40s=%20s\n", "Foreign SID Reg", "False");
+                }
+                if(true == sib8->csfb_reg_param_1xrtt.foreign_nid_reg)
+                {
+                    fprintf(out, "\t\t\t%-40s=%20s\n", "Foreign NID Reg", "True");
+                }else{
+                    fprintf(out, "\t\t\t%-40s=%20s\n", "Foreign NID Reg", "False");
+                }
+                if(true == sib8->csfb_reg_param_1xrtt.param_reg)
+                {
+                    fprintf(out, "\t\t\t%-40s=%20s\n", "Parameter Reg", "True");
+                }else{
+                    fprintf(out, "\t\t\t%-40s=%20s\n", "Parameter Reg", "False");
+                }
+                if(true == sib8->csfb_reg_param_1xrtt.power_up_reg)
+                {
+                    fprintf(out, "\t\t\t%-40s=%20s\n", "Power Up Reg", "True");
+                }else{
+                    fprintf(out, "\t\t\t%-40s=%20s\n", "Power Up Reg", "False");
+                }
+                fprintf(out, "\t\t\t%-40s=%20u\n", "Registration Period", sib8->csfb_reg_param_1xrtt.reg_period);
+                fprintf(out, "\t\t\t%-40s=%20u\n", "Registration Zone", sib8->csfb_reg_param_1xrtt.reg_zone);
+                fprintf(out, "\t\t\t%-40s=%20u\n", "Total Zones", sib8->csfb_reg_param_1xrtt.total_zone);
+                fprintf(out, "\t\t\t%-40s=%20u\n", "Zone Timer", sib8->csfb_reg_param_1xrtt.zone_timer);
+            }
+            if(true == sib8->long_code_state_1xrtt_present)
+            {
+                fprintf(out, "\t\t%-40s=%20llu\n", "Long Code State", sib8->long_code_state_1xrtt);
+            }
+            if(true == sib8->cell_resel_params_1xrtt_present)
+            {
+                fprintf(out, "\t\tBand Class List:\n");
+                for(i=0; i<sib8->cell_resel_params_1xrtt.band_class_list_size; i++)
+                {
+                    fprintf(out, "\t\t\t%-40s=%20s\n", "Band Class", liblte_rrc_band_class_cdma2000_text[sib8->cell_resel_params_1xrtt.band_class_list[i].band_class]);
+                    if(true == sib8->cell_resel_params_1xrtt.band_class_list[i].cell_resel_prio_present)
+                    {
+                        fprintf(out, "\t\t\t%-40s=%20u\n", "Cell Reselection Priority", sib8->cell_resel_params_1xrtt.band_class_list[i].cell_resel_prio);
+                    }
+                    fprintf(out, "\t\t\t%-40s=%20u\n", "Threshold X High", sib8->cell_resel_params_1xrtt.band_class_list[i].thresh_x_high);
+                    fprintf(out, "\t\t\t%-40s=%20u\n", "Threshold X Low", sib8->cell_resel_params_1xrtt.band_class_list[i].thresh_x_low);
+                }
+                fprintf(out, "\t\tNeighbor Cell List:\n");
+                for(i=0; i<sib8->cell_resel_params_1xrtt.neigh_cell_list_size; i++)
+                {
+                    fprintf(out, "\t\t\t%-40s=%20s\n", "Band Class", liblte_rrc_band_class_cdma2000_text[sib8->cell_resel_params_1xrtt.neigh_cell_list[i].band_class]);
+                    fprintf(out, "\t\t\tNeighbor Cells Per Frequency List\n");
+                    for(j=0; j<sib8->cell_resel_params_1xrtt.neigh_cell_list[i].neigh_cells_per_freq_list_size; j++)
+                    {
+                        fprintf(out, "\t\t\t\t%-40s=%20u\n", "ARFCN", sib8->cell_resel_params_1xrtt.neigh_cell_list[i].neigh_cells_per_freq_list[j].arfcn);
+                        fprintf(out, "\t\t\t\tPhys Cell ID List\n");
+                        for(k=0; k<sib8->cell_resel_params_1xrtt.neigh_cell_list[i].neigh_cells_per_freq_list[j].phys_cell_id_list_size; k++)
+                        {
+                            fprintf(out, "\t\t\t\t\t%u\n", sib8->cell_resel_params_1xrtt.neigh_cell_list[i].neigh_cells_per_freq_list[j].phys_cell_id_list[k]);
+                        }
+                    }
+                }
+                fprintf(out, "\t\t%-40s=%19us\n", "T Reselection", sib8->cell_resel_params_1xrtt.t_resel_cdma2000);
+                if(true == sib8->cell_resel_params_1xrtt.t_resel_cdma2000_sf_present)
+                {
+                    fprintf(out, "\t\t%-40s=%20s\n", "T-Reselection Scale Factor Medium", liblte_rrc_sssf_medium_text[sib8->cell_resel_params_1xrtt.t_resel_cdma2000_sf.sf_medium]);
+                    fprintf(out, "\t\t%-40s=%20s\n", "T-Reselection Scale Factor High", liblte_rrc_sssf_high_text[sib8->cell_resel_params_1xrtt.t_resel_cdma2000_sf.sf_high]);
+                }
+            }
+        }
+
+        sib8_printed = true;
+    }
+}
+
+void LTE_fdd_dl_fs_printer::print_page(LIBLTE_RRC_PAGING_STRUCT *page)
+{
+    uint32 i;
+    uint32 j;
+
+    fprintf(out, "\tPAGE Decoded:\n");
+    if(0 != page->paging_record_list_size)
+    {
+        fprintf(out, "\t\tNumber of paging records: %u\n", page->paging_record_list_size);
+        for(i=0; i<page->paging_record_list_size; i++)
+        {
+            if(LIBLTE_RRC_PAGING_UE_IDENTITY_TYPE_S_TMSI == page->paging_record_list[i].ue_identity.ue_identity_type)
+            {
+                fprintf(out, "\t\t\t%s\n", "S-TMSI");
+                fprintf(out, "\t\t\t\t%-40s= %08X\n", "M-TMSI", page->paging_record_list[i].ue_identity.s_tmsi.m_tmsi);
+                fprintf(out, "\t\t\t\t%-40s= %u\n", "MMEC", page->paging_record_list[i].ue_identity.s_tmsi.mmec);
+            }else{
+                fprintf(out, "\t\t\t%-40s=", "IMSI");
+                for(j=0; j<page->paging_record_list[i].ue_identity.imsi_size; j++)
+                {
+                    fprintf(out, "%u", page->paging_record_list[i].ue_identity.imsi[j]);
+                }
+                fprintf(out, "\n");
+            }
+            fprintf(out, "\t\t\t%-40s=%20s\n", "CN Domain", liblte_rrc_cn_domain_text[page->paging_record_list[i].cn_domain]);
+        }
+    }
+    if(true == page->system_info_modification_present)
+    {
+        fprintf(out, "\t\t%-40s=%20s\n", "System Info Modification", liblte_rrc_system_info_modification_text[page->system_info_modification]);
+    }
+    if(true == page->etws_indication_present)
+    {
+        fprintf(out, "\t\t%-40s=%20s\n", "ETWS Indication", liblte_rrc_etws_indication_text[page->etws_indication]);
+    }
+}
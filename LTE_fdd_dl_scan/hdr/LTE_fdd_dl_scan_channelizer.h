@@ -0,0 +1,123 @@
+/*******************************************************************************
+
+    Copyright 2026 agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: LTE_fdd_dl_scan_channelizer.h
+
+    Description: Contains all the definitions for the LTE FDD DL Scanner
+                 channelizer block.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    agent            Created file
+
+*******************************************************************************/
+
+#ifndef __LTE_FDD_DL_SCAN_CHANNELIZER_H__
+#define __LTE_FDD_DL_SCAN_CHANNELIZER_H__
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "LTE_fdd_dl_scan_channelizer_api.h"
+#include "liblte_phy.h"
+#include <gnuradio/sync_decimator.h>
+#include <boost/thread/mutex.hpp>
+#include <fftw3.h>
+#include <vector>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+// Each channel uses a full state machine and phy_struct, so the number of
+// channels is limited by memory rather than by the channelizer
+#define LTE_FDD_DL_SCAN_CHANNELIZER_N_CHANS_MAX 16
+
+// The polyphase filter bank splits 15.36MHz into 8 bins with 1.92MHz spacing,
+// each bin is output at 3.84MHz and every channel is fine tuned within its
+// bin and decimated to 1.92MHz
+#define LTE_FDD_DL_SCAN_CHANNELIZER_IN_SAMP_RATE  15360000
+#define LTE_FDD_DL_SCAN_CHANNELIZER_OUT_SAMP_RATE 1920000
+#define LTE_FDD_DL_SCAN_CHANNELIZER_N_BINS        8
+#define LTE_FDD_DL_SCAN_CHANNELIZER_BIN_DECIM     4
+#define LTE_FDD_DL_SCAN_CHANNELIZER_CHAN_DECIM    2
+#define LTE_FDD_DL_SCAN_CHANNELIZER_DECIM         (LTE_FDD_DL_SCAN_CHANNELIZER_BIN_DECIM*LTE_FDD_DL_SCAN_CHANNELIZER_CHAN_DECIM)
+#define LTE_FDD_DL_SCAN_CHANNELIZER_BIN_SPACING   (LTE_FDD_DL_SCAN_CHANNELIZER_IN_SAMP_RATE/LTE_FDD_DL_SCAN_CHANNELIZER_N_BINS)
+#define LTE_FDD_DL_SCAN_CHANNELIZER_BIN_SAMP_RATE (LTE_FDD_DL_SCAN_CHANNELIZER_IN_SAMP_RATE/LTE_FDD_DL_SCAN_CHANNELIZER_BIN_DECIM)
+
+// The outer bins are left to the analog filter roll off, so channel centers
+// must be within +/- 5.76MHz of the center frequency
+#define LTE_FDD_DL_SCAN_CHANNELIZER_SPAN ((LTE_FDD_DL_SCAN_CHANNELIZER_N_BINS-2)*LTE_FDD_DL_SCAN_CHANNELIZER_BIN_SPACING)
+
+// Number of bin samples generated by each FFT batch
+#define LTE_FDD_DL_SCAN_CHANNELIZER_BATCH_N_SAMPS 256
+
+/*******************************************************************************
+                              FORWARD DECLARATIONS
+*******************************************************************************/
+
+class LTE_fdd_dl_scan_channelizer;
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+typedef boost::shared_ptr<LTE_fdd_dl_scan_channelizer> LTE_fdd_dl_scan_channelizer_sptr;
+
+/*******************************************************************************
+                              CLASS DECLARATIONS
+*******************************************************************************/
+
+LTE_FDD_DL_SCAN_CHANNELIZER_API LTE_fdd_dl_scan_channelizer_sptr LTE_fdd_dl_scan_make_channelizer(uint32 N_chans, const std::vector<float> &bin_taps, const std::vector<float> &chan_taps);
+class LTE_FDD_DL_SCAN_CHANNELIZER_API LTE_fdd_dl_scan_channelizer : public gr::sync_decimator
+{
+public:
+    ~LTE_fdd_dl_scan_channelizer();
+
+    void set_chan_freq_offset(uint32 chan_idx, float freq_offset);
+
+    int32 work(int32                      noutput_items,
+               gr_vector_const_void_star &input_items,
+               gr_vector_void_star       &output_items);
+
+private:
+    friend LTE_FDD_DL_SCAN_CHANNELIZER_API LTE_fdd_dl_scan_channelizer_sptr LTE_fdd_dl_scan_make_channelizer(uint32 N_chans, const std::vector<float> &bin_taps, const std::vector<float> &chan_taps);
+
+    LTE_fdd_dl_scan_channelizer(uint32 N_chans, const std::vector<float> &bin_taps, const std::vector<float> &chan_taps);
+
+    // Polyphase filter bank
+    fftwf_complex *bin_fft_in;
+    fftwf_complex *bin_fft_out;
+    fftwf_plan     bin_fft_plan;
+    float         *bin_taps;
+    uint32         N_bin_taps;
+
+    // Channels
+    boost::mutex           chan_mutex;
+    LIBLTE_PHY_NCO_STRUCT  chan_nco[LTE_FDD_DL_SCAN_CHANNELIZER_N_CHANS_MAX];
+    float                 *chan_i_buf[LTE_FDD_DL_SCAN_CHANNELIZER_N_CHANS_MAX];
+    float                 *chan_q_buf[LTE_FDD_DL_SCAN_CHANNELIZER_N_CHANS_MAX];
+    float                 *chan_taps;
+    uint32                 chan_bin[LTE_FDD_DL_SCAN_CHANNELIZER_N_CHANS_MAX];
+    uint32                 N_chan_taps;
+    uint32                 N_chans;
+};
+
+#endif /* __LTE_FDD_DL_SCAN_CHANNELIZER_H__ */
@@ -0,0 +1,51 @@
+/*******************************************************************************
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************/
+
+#ifndef __LTE_FDD_DL_SCAN_CHANNELIZER_API_H__
+#define __LTE_FDD_DL_SCAN_CHANNELIZER_API_H__
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include <gnuradio/attributes.h>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+#ifdef LTE_fdd_dl_scan_channelizer_EXPORTS
+#define LTE_FDD_DL_SCAN_CHANNELIZER_API __GR_ATTR_EXPORT
+#else
+#define LTE_FDD_DL_SCAN_CHANNELIZER_API __GR_ATTR_IMPORT
+#endif
+
+/*******************************************************************************
+                              FORWARD DECLARATIONS
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              CLASS DECLARATIONS
+*******************************************************************************/
+
+#endif /* __LTE_FDD_DL_SCAN_CHANNELIZER_API_H__ */
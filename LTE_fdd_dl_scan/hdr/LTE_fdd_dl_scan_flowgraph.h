@@ -31,6 +31,9 @@
     11/30/2013    Ben Wojtowicz    Added support for bladeRF.
     04/12/2014    Ben Wojtowicz    Pulled in a patch from Jevgenij for
                                    supporting non-B2X0 USRPs.
+    10/19/2026    agent            Added a wideband mode that scans groups of
+                                   dl_earfcns through a channelizer.
+    10/19/2026    agent            Using the liblte polyphase resampler.
 
 *******************************************************************************/
 
@@ -43,9 +46,10 @@
 
 #include "LTE_fdd_dl_scan_interface.h"
 #include "LTE_fdd_dl_scan_state_machine.h"
+#include "LTE_fdd_dl_scan_channelizer.h"
+#include "LTE_fdd_dl_scan_resampler.h"
 #include <boost/thread/mutex.hpp>
 #include <gnuradio/top_block.h>
-#include <gnuradio/filter/rational_resampler_base_ccf.h>
 #include <gnuradio/filter/firdes.h>
 #include <osmosdr/source.h>
 
@@ -85,10 +89,14 @@ public:
 
     // Flowgraph
     bool is_started(void);
-    LTE_FDD_DL_SCAN_STATUS_ENUM start(uint16 dl_earfcn);
+    LTE_FDD_DL_SCAN_STATUS_ENUM start(uint16 dl_earfcn, uint32 N_chans);
     LTE_FDD_DL_SCAN_STATUS_ENUM stop(void);
     void update_center_freq(uint16 dl_earfcn);
 
+    // Wideband
+    LTE_FDD_DL_SCAN_STATUS_ENUM get_chan_dl_earfcn(uint32 chan_idx, uint32 *group_idx, uint16 *dl_earfcn);
+    void chan_done(uint32 chan_idx);
+
 private:
     // Singleton
     static LTE_fdd_dl_scan_flowgraph *instance;
@@ -98,12 +106,26 @@ private:
     // Run
     static void* run_thread(void *inputs);
 
+    // Wideband
+    void start_next_chan_group(void);
+    LTE_fdd_dl_scan_channelizer_sptr   channelizer;
+    LTE_fdd_dl_scan_state_machine_sptr chan_state_machine[LTE_FDD_DL_SCAN_CHANNELIZER_N_CHANS_MAX];
+    std::vector<float>                 channelizer_bin_taps;
+    std::vector<float>                 channelizer_chan_taps;
+    boost::mutex                       chan_mutex;
+    uint32                             N_chans;
+    uint32                             N_chans_busy;
+    uint32                             chan_group_idx;
+    uint16                             chan_dl_earfcn[LTE_FDD_DL_SCAN_CHANNELIZER_N_CHANS_MAX];
+    bool                               chan_busy[LTE_FDD_DL_SCAN_CHANNELIZER_N_CHANS_MAX];
+    bool                               chan_scan_done;
+
     // Variables
-    std::vector<float>                            resample_taps;
-    gr::top_block_sptr                            top_block;
-    gr::filter::rational_resampler_base_ccf::sptr resampler_filter;
-    osmosdr::source::sptr                         samp_src;
-    LTE_fdd_dl_scan_state_machine_sptr            state_machine;
+    std::vector<float>                 resample_taps;
+    gr::top_block_sptr                 top_block;
+    LTE_fdd_dl_scan_resampler_sptr     resampler_filter;
+    osmosdr::source::sptr              samp_src;
+    LTE_fdd_dl_scan_state_machine_sptr state_machine;
 
     pthread_t    start_thread;
     boost::mutex start_mutex;
@@ -27,6 +27,8 @@
     02/26/2013    Ben Wojtowicz    Created file
     07/21/2013    Ben Wojtowicz    Added support for decoding SIBs.
     06/15/2014    Ben Wojtowicz    Added PCAP support.
+    10/19/2026    agent            Added wideband scanning of groups of
+                                   dl_earfcns.
 
 *******************************************************************************/
 
@@ -66,6 +68,7 @@ typedef enum{
 typedef struct{
     float  freq_offset;
     uint32 N_id_cell;
+    uint16 dl_earfcn;
 }LTE_FDD_DL_SCAN_CHAN_DATA_STRUCT;
 
 /*******************************************************************************
@@ -95,7 +98,7 @@ public:
     void send_ctrl_sib7_decoded_msg(LTE_FDD_DL_SCAN_CHAN_DATA_STRUCT *chan_data, LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_7_STRUCT *sib7, uint32 sfn);
     void send_ctrl_sib8_decoded_msg(LTE_FDD_DL_SCAN_CHAN_DATA_STRUCT *chan_data, LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_8_STRUCT *sib8, uint32 sfn);
     void send_ctrl_channel_found_end_msg(LTE_FDD_DL_SCAN_CHAN_DATA_STRUCT *chan_data);
-    void send_ctrl_channel_not_found_msg(void);
+    void send_ctrl_channel_not_found_msg(LTE_FDD_DL_SCAN_CHAN_DATA_STRUCT *chan_data);
     void send_ctrl_status_msg(LTE_FDD_DL_SCAN_STATUS_ENUM status, std::string msg);
     void open_pcap_fd(void);
     void send_pcap_msg(uint32 rnti, uint32 current_tti, LIBLTE_BIT_MSG_STRUCT *msg);
@@ -104,6 +107,7 @@ public:
     static void handle_ctrl_disconnect(void);
     static void handle_ctrl_error(LIBTOOLS_SOCKET_WRAP_ERROR_ENUM err);
     boost::mutex          ctrl_mutex;
+    boost::mutex          pcap_mutex;
     FILE                 *pcap_fd;
     libtools_socket_wrap *ctrl_socket;
     int16                 ctrl_port;
@@ -111,9 +115,11 @@ public:
 
     // Get/Set
     bool get_shutdown(void);
+    uint16 get_current_dl_earfcn(void);
 
     // Helpers
     LTE_FDD_DL_SCAN_STATUS_ENUM switch_to_next_freq(void);
+    LTE_FDD_DL_SCAN_STATUS_ENUM switch_to_next_chan_group(uint32 span, uint32 max_N_dl_earfcns, uint16 *dl_earfcns, uint32 *N_dl_earfcns);
 
 private:
     // Singleton
@@ -137,6 +143,8 @@ private:
     void write_repeat(std::string repeat_str);
     void read_enable_pcap(void);
     void write_enable_pcap(std::string enable_pcap_str);
+    void read_wideband_chans(void);
+    void write_wideband_chans(std::string wideband_chans_str);
 
     // Variables
     boost::mutex               dl_earfcn_list_mutex;
@@ -145,6 +153,7 @@ private:
     uint16                     dl_earfcn_list[65535];
     uint16                     dl_earfcn_list_size;
     uint16                     dl_earfcn_list_idx;
+    uint32                     wideband_chans;
     bool                       repeat;
     bool                       enable_pcap;
     bool                       shutdown;
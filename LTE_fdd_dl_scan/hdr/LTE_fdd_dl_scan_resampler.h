@@ -0,0 +1,91 @@
+/*******************************************************************************
+
+    Copyright 2026 agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: LTE_fdd_dl_scan_resampler.h
+
+    Description: Contains all the definitions for the LTE FDD DL Scanner
+                 rational resampler block.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    agent            Created file
+
+*******************************************************************************/
+
+#ifndef __LTE_FDD_DL_SCAN_RESAMPLER_H__
+#define __LTE_FDD_DL_SCAN_RESAMPLER_H__
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "LTE_fdd_dl_scan_resampler_api.h"
+#include "liblte_phy.h"
+#include <gnuradio/block.h>
+#include <vector>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+// Number of input and output samples resampled at a time
+#define LTE_FDD_DL_SCAN_RESAMPLER_BATCH_N_SAMPS 4096
+
+/*******************************************************************************
+                              FORWARD DECLARATIONS
+*******************************************************************************/
+
+class LTE_fdd_dl_scan_resampler;
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+typedef boost::shared_ptr<LTE_fdd_dl_scan_resampler> LTE_fdd_dl_scan_resampler_sptr;
+
+/*******************************************************************************
+                              CLASS DECLARATIONS
+*******************************************************************************/
+
+LTE_FDD_DL_SCAN_RESAMPLER_API LTE_fdd_dl_scan_resampler_sptr LTE_fdd_dl_scan_make_resampler(uint32 interp, uint32 decim, const std::vector<float> &taps);
+class LTE_FDD_DL_SCAN_RESAMPLER_API LTE_fdd_dl_scan_resampler : public gr::block
+{
+public:
+    ~LTE_fdd_dl_scan_resampler();
+
+    void forecast(int32 noutput_items, gr_vector_int &ninput_items_required);
+    int32 general_work(int32                      noutput_items,
+                       gr_vector_int             &ninput_items,
+                       gr_vector_const_void_star &input_items,
+                       gr_vector_void_star       &output_items);
+
+private:
+    friend LTE_FDD_DL_SCAN_RESAMPLER_API LTE_fdd_dl_scan_resampler_sptr LTE_fdd_dl_scan_make_resampler(uint32 interp, uint32 decim, const std::vector<float> &taps);
+
+    LTE_fdd_dl_scan_resampler(uint32 interp, uint32 decim, const std::vector<float> &taps);
+
+    // Resampler
+    LIBLTE_PHY_RESAMP_STRUCT *resamp;
+    float                    *i_in_buf;
+    float                    *q_in_buf;
+    float                    *i_out_buf;
+    float                    *q_out_buf;
+};
+
+#endif /* __LTE_FDD_DL_SCAN_RESAMPLER_H__ */
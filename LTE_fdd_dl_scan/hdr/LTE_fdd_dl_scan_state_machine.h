@@ -28,6 +28,10 @@
     07/21/2013    Ben Wojtowicz    Added support for multiple sample rates
     08/26/2013    Ben Wojtowicz    Updates to support GnuRadio 3.7.
     06/15/2014    Ben Wojtowicz    Using the latest LTE library.
+    10/19/2026    agent            Using an NCO for frequency offset
+                                   correction.
+    10/19/2026    agent            Added support for running as one channel of
+                                   a wideband scan.
 
 *******************************************************************************/
 
@@ -50,6 +54,9 @@
 
 #define LTE_FDD_DL_SCAN_STATE_MACHINE_N_DECODED_CHANS_MAX 10
 
+// Channel index used when the radio is tuned to each dl_earfcn in turn
+#define LTE_FDD_DL_SCAN_STATE_MACHINE_NARROWBAND 0xFFFFFFFF
+
 /*******************************************************************************
                               FORWARD DECLARATIONS
 *******************************************************************************/
@@ -75,7 +82,7 @@ typedef enum{
                               CLASS DECLARATIONS
 *******************************************************************************/
 
-LTE_FDD_DL_SCAN_STATE_MACHINE_API LTE_fdd_dl_scan_state_machine_sptr LTE_fdd_dl_scan_make_state_machine (uint32 samp_rate);
+LTE_FDD_DL_SCAN_STATE_MACHINE_API LTE_fdd_dl_scan_state_machine_sptr LTE_fdd_dl_scan_make_state_machine (uint32 samp_rate, uint32 chan_idx);
 class LTE_FDD_DL_SCAN_STATE_MACHINE_API LTE_fdd_dl_scan_state_machine : public gr::sync_block
 {
 public:
@@ -86,9 +93,9 @@ public:
                gr_vector_void_star       &output_items);
 
 private:
-    friend LTE_FDD_DL_SCAN_STATE_MACHINE_API LTE_fdd_dl_scan_state_machine_sptr LTE_fdd_dl_scan_make_state_machine(uint32 samp_rate);
+    friend LTE_FDD_DL_SCAN_STATE_MACHINE_API LTE_fdd_dl_scan_state_machine_sptr LTE_fdd_dl_scan_make_state_machine(uint32 samp_rate, uint32 chan_idx);
 
-    LTE_fdd_dl_scan_state_machine(uint32 samp_rate);
+    LTE_fdd_dl_scan_state_machine(uint32 samp_rate, uint32 chan_idx);
 
     // LTE library
     LIBLTE_PHY_STRUCT                *phy_struct;
@@ -102,6 +109,7 @@ private:
     float  *q_buf;
     uint32  samp_buf_w_idx;
     uint32  samp_buf_r_idx;
+    uint32  samp_buf_size;
     uint32  one_subframe_num_samps;
     uint32  one_frame_num_samps;
     uint32  freq_change_wait_num_samps;
@@ -112,6 +120,14 @@ private:
     uint32  pdsch_decode_sib1_num_samps;
     uint32  pdsch_decode_si_generic_num_samps;
 
+    // Frequency correction
+    LIBLTE_PHY_NCO_STRUCT nco;
+
+    // Wideband channel
+    uint32 chan_idx;
+    uint32 chan_group_idx;
+    bool   chan_idle;
+
     // Variables
     LTE_FDD_DL_SCAN_CHAN_DATA_STRUCT         chan_data;
     LTE_FDD_DL_SCAN_STATE_MACHINE_STATE_ENUM state;
@@ -143,9 +159,10 @@ private:
     // Helpers
     void init(void);
     void copy_input_to_samp_buf(const gr_complex *in, int32 ninput_items);
-    void freq_shift(uint32 start_idx, uint32 num_samps, float freq_offset);
+    void freq_shift(float freq_offset);
     void channel_found(bool &switch_freq, int32 &done_flag);
     void channel_not_found(bool &switch_freq, int32 &done_flag);
+    void next_freq(bool &switch_freq, int32 &done_flag);
 };
 
 #endif /* __LTE_FDD_DL_SCAN_STATE_MACHINE_H__ */
@@ -0,0 +1,260 @@
+/*******************************************************************************
+
+    Copyright 2026 agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: LTE_fdd_dl_scan_channelizer.cc
+
+    Description: Contains all the implementations for the LTE FDD DL Scanner
+                 channelizer block.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    agent            Created file
+
+*******************************************************************************/
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "LTE_fdd_dl_scan_channelizer.h"
+#include <gnuradio/io_signature.h>
+#include <string.h>
+#include <math.h>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              GLOBAL VARIABLES
+*******************************************************************************/
+
+// minimum and maximum number of input and output streams
+static const int32 MIN_IN  = 1;
+static const int32 MAX_IN  = 1;
+static const int32 MIN_OUT = 1;
+static const int32 MAX_OUT = LTE_FDD_DL_SCAN_CHANNELIZER_N_CHANS_MAX;
+
+/*******************************************************************************
+                              CLASS IMPLEMENTATIONS
+*******************************************************************************/
+
+LTE_fdd_dl_scan_channelizer_sptr LTE_fdd_dl_scan_make_channelizer(uint32                    N_chans,
+                                                                  const std::vector<float> &bin_taps,
+                                                                  const std::vector<float> &chan_taps)
+{
+    return LTE_fdd_dl_scan_channelizer_sptr(new LTE_fdd_dl_scan_channelizer(N_chans, bin_taps, chan_taps));
+}
+
+LTE_fdd_dl_scan_channelizer::LTE_fdd_dl_scan_channelizer(uint32                    _N_chans,
+                                                         const std::vector<float> &_bin_taps,
+                                                         const std::vector<float> &_chan_taps)
+    : gr::sync_decimator ("LTE_fdd_dl_scan_channelizer",
+                          gr::io_signature::make(MIN_IN,  MAX_IN,  sizeof(gr_complex)),
+                          gr::io_signature::make(MIN_OUT, MAX_OUT, sizeof(gr_complex)),
+                          LTE_FDD_DL_SCAN_CHANNELIZER_DECIM)
+{
+    int32  N_bins = LTE_FDD_DL_SCAN_CHANNELIZER_N_BINS;
+    uint32 i;
+
+    N_chans = _N_chans;
+    if(N_chans > LTE_FDD_DL_SCAN_CHANNELIZER_N_CHANS_MAX)
+    {
+        N_chans = LTE_FDD_DL_SCAN_CHANNELIZER_N_CHANS_MAX;
+    }
+
+    // Pad the prototype filter to a whole number of polyphase branches
+    N_bin_taps = ((_bin_taps.size() + N_bins - 1) / N_bins) * N_bins;
+    bin_taps   = (float *)malloc(N_bin_taps*sizeof(float));
+    for(i=0; i<N_bin_taps; i++)
+    {
+        if(i < _bin_taps.size())
+        {
+            bin_taps[i] = _bin_taps[i];
+        }else{
+            bin_taps[i] = 0;
+        }
+    }
+    set_history(N_bin_taps);
+
+    // One inverse FFT per bin sample, all of a batch in a single plan
+    bin_fft_in   = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex)*N_bins*LTE_FDD_DL_SCAN_CHANNELIZER_BATCH_N_SAMPS);
+    bin_fft_out  = (fftwf_complex *)fftwf_malloc(sizeof(fftwf_complex)*N_bins*LTE_FDD_DL_SCAN_CHANNELIZER_BATCH_N_SAMPS);
+    bin_fft_plan = fftwf_plan_many_dft(1,
+                                       &N_bins,
+                                       LTE_FDD_DL_SCAN_CHANNELIZER_BATCH_N_SAMPS,
+                                       bin_fft_in,
+                                       NULL,
+                                       1,
+                                       N_bins,
+                                       bin_fft_out,
+                                       NULL,
+                                       1,
+                                       N_bins,
+                                       FFTW_BACKWARD,
+                                       FFTW_MEASURE);
+
+    // Channel filter, each channel keeps its own history
+    N_chan_taps = _chan_taps.size();
+    chan_taps   = (float *)malloc(N_chan_taps*sizeof(float));
+    for(i=0; i<N_chan_taps; i++)
+    {
+        chan_taps[i] = _chan_taps[i];
+    }
+    for(i=0; i<LTE_FDD_DL_SCAN_CHANNELIZER_N_CHANS_MAX; i++)
+    {
+        chan_i_buf[i] = (float *)calloc(N_chan_taps + LTE_FDD_DL_SCAN_CHANNELIZER_BATCH_N_SAMPS, sizeof(float));
+        chan_q_buf[i] = (float *)calloc(N_chan_taps + LTE_FDD_DL_SCAN_CHANNELIZER_BATCH_N_SAMPS, sizeof(float));
+        chan_bin[i]   = 0;
+        liblte_phy_nco_init(&chan_nco[i], LTE_FDD_DL_SCAN_CHANNELIZER_BIN_SAMP_RATE, 0);
+    }
+}
+LTE_fdd_dl_scan_channelizer::~LTE_fdd_dl_scan_channelizer()
+{
+    uint32 i;
+
+    fftwf_destroy_plan(bin_fft_plan);
+    fftwf_free(bin_fft_in);
+    fftwf_free(bin_fft_out);
+    free(bin_taps);
+    free(chan_taps);
+    for(i=0; i<LTE_FDD_DL_SCAN_CHANNELIZER_N_CHANS_MAX; i++)
+    {
+        free(chan_i_buf[i]);
+        free(chan_q_buf[i]);
+    }
+}
+
+void LTE_fdd_dl_scan_channelizer::set_chan_freq_offset(uint32 chan_idx,
+                                                       float  freq_offset)
+{
+    boost::mutex::scoped_lock lock(chan_mutex);
+    int32                     bin;
+
+    if(chan_idx < N_chans)
+    {
+        // Pick the closest bin and remove the remainder with the NCO
+        bin = (int32)lroundf(freq_offset / LTE_FDD_DL_SCAN_CHANNELIZER_BIN_SPACING);
+        liblte_phy_nco_set_freq_offset(&chan_nco[chan_idx], freq_offset - bin*LTE_FDD_DL_SCAN_CHANNELIZER_BIN_SPACING);
+        chan_bin[chan_idx] = (bin + LTE_FDD_DL_SCAN_CHANNELIZER_N_BINS) % LTE_FDD_DL_SCAN_CHANNELIZER_N_BINS;
+    }
+}
+
+int32 LTE_fdd_dl_scan_channelizer::work(int32                      noutput_items,
+                                        gr_vector_const_void_star &input_items,
+                                        gr_vector_void_star       &output_items)
+{
+    boost::mutex::scoped_lock  lock(chan_mutex);
+    const gr_complex          *in = (const gr_complex *)input_items[0];
+    gr_complex                *out;
+    float                      i_acc;
+    float                      q_acc;
+    uint32                     N_bin_samps = noutput_items*LTE_FDD_DL_SCAN_CHANNELIZER_CHAN_DECIM;
+    uint32                     N_batch_samps;
+    uint32                     batch_idx;
+    uint32                     in_idx;
+    uint32                     buf_idx;
+    uint32                     bin;
+    uint32                     i;
+    uint32                     j;
+    uint32                     p;
+    uint32                     r;
+
+    for(batch_idx=0; batch_idx<N_bin_samps; batch_idx+=N_batch_samps)
+    {
+        N_batch_samps = N_bin_samps - batch_idx;
+        if(N_batch_samps > LTE_FDD_DL_SCAN_CHANNELIZER_BATCH_N_SAMPS)
+        {
+            N_batch_samps = LTE_FDD_DL_SCAN_CHANNELIZER_BATCH_N_SAMPS;
+        }
+
+        // Fold the input through the polyphase branches, the newest input
+        // sample used by each bin sample is the last of its decimation block
+        for(i=0; i<N_batch_samps; i++)
+        {
+            in_idx = N_bin_taps - 1 + (batch_idx + i + 1)*LTE_FDD_DL_SCAN_CHANNELIZER_BIN_DECIM - 1;
+            for(r=0; r<LTE_FDD_DL_SCAN_CHANNELIZER_N_BINS; r++)
+            {
+                i_acc = 0;
+                q_acc = 0;
+                for(p=r; p<N_bin_taps; p+=LTE_FDD_DL_SCAN_CHANNELIZER_N_BINS)
+                {
+                    i_acc += bin_taps[p]*in[in_idx-p].real();
+                    q_acc += bin_taps[p]*in[in_idx-p].imag();
+                }
+                bin_fft_in[i*LTE_FDD_DL_SCAN_CHANNELIZER_N_BINS + r][0] = i_acc;
+                bin_fft_in[i*LTE_FDD_DL_SCAN_CHANNELIZER_N_BINS + r][1] = q_acc;
+            }
+        }
+        fftwf_execute(bin_fft_plan);
+
+        for(j=0; j<N_chans; j++)
+        {
+            // Decimating by half the number of bins leaves odd bins with a
+            // sign flip on every other sample, the number of bin samples per
+            // call is always even so the parity restarts with each call
+            bin = chan_bin[j];
+            for(i=0; i<N_batch_samps; i++)
+            {
+                if(1 == (bin & (batch_idx + i) & 1))
+                {
+                    chan_i_buf[j][N_chan_taps-1+i] = -bin_fft_out[i*LTE_FDD_DL_SCAN_CHANNELIZER_N_BINS + bin][0];
+                    chan_q_buf[j][N_chan_taps-1+i] = -bin_fft_out[i*LTE_FDD_DL_SCAN_CHANNELIZER_N_BINS + bin][1];
+                }else{
+                    chan_i_buf[j][N_chan_taps-1+i] = bin_fft_out[i*LTE_FDD_DL_SCAN_CHANNELIZER_N_BINS + bin][0];
+                    chan_q_buf[j][N_chan_taps-1+i] = bin_fft_out[i*LTE_FDD_DL_SCAN_CHANNELIZER_N_BINS + bin][1];
+                }
+            }
+
+            // Fine tune within the bin
+            liblte_phy_nco_rotate(&chan_nco[j],
+                                  &chan_i_buf[j][N_chan_taps-1],
+                                  &chan_q_buf[j][N_chan_taps-1],
+                                  N_batch_samps);
+
+            // Filter and decimate to 1.92MHz
+            out = (gr_complex *)output_items[j];
+            for(i=0; i<N_batch_samps/LTE_FDD_DL_SCAN_CHANNELIZER_CHAN_DECIM; i++)
+            {
+                buf_idx = N_chan_taps - 1 + (i + 1)*LTE_FDD_DL_SCAN_CHANNELIZER_CHAN_DECIM - 1;
+                i_acc   = 0;
+                q_acc   = 0;
+                for(p=0; p<N_chan_taps; p++)
+                {
+                    i_acc += chan_taps[p]*chan_i_buf[j][buf_idx-p];
+                    q_acc += chan_taps[p]*chan_q_buf[j][buf_idx-p];
+                }
+                out[batch_idx/LTE_FDD_DL_SCAN_CHANNELIZER_CHAN_DECIM + i] = gr_complex(i_acc, q_acc);
+            }
+
+            // Keep the history for the next batch
+            memmove(chan_i_buf[j], &chan_i_buf[j][N_batch_samps], (N_chan_taps-1)*sizeof(float));
+            memmove(chan_q_buf[j], &chan_q_buf[j][N_batch_samps], (N_chan_taps-1)*sizeof(float));
+        }
+    }
+
+    // Tell runtime system how many output items we produced.
+    return(noutput_items);
+}
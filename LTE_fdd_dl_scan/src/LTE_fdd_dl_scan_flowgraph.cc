@@ -32,6 +32,9 @@
     11/30/2013    Ben Wojtowicz    Added support for bladeRF.
     04/12/2014    Ben Wojtowicz    Pulled in a patch from Jevgenij for
                                    supporting non-B2X0 USRPs.
+    10/19/2026    agent            Added a wideband mode that scans groups of
+                                   dl_earfcns through a channelizer.
+    10/19/2026    agent            Using the liblte polyphase resampler.
 
 *******************************************************************************/
 
@@ -89,7 +92,11 @@ void LTE_fdd_dl_scan_flowgraph::cleanup(void)
 // Constructor/Destructor
 LTE_fdd_dl_scan_flowgraph::LTE_fdd_dl_scan_flowgraph()
 {
-    started = false;
+    started        = false;
+    N_chans        = 0;
+    N_chans_busy   = 0;
+    chan_group_idx = 0;
+    chan_scan_done = false;
 }
 LTE_fdd_dl_scan_flowgraph::~LTE_fdd_dl_scan_flowgraph()
 {
@@ -109,14 +116,19 @@ bool LTE_fdd_dl_scan_flowgraph::is_started(void)
 
     return(started);
 }
-LTE_FDD_DL_SCAN_STATUS_ENUM LTE_fdd_dl_scan_flowgraph::start(uint16 dl_earfcn)
+LTE_FDD_DL_SCAN_STATUS_ENUM LTE_fdd_dl_scan_flowgraph::start(uint16 dl_earfcn,
+                                                             uint32 _N_chans)
 {
     boost::mutex::scoped_lock     lock(start_mutex);
     LTE_fdd_dl_scan_interface    *interface = LTE_fdd_dl_scan_interface::get_instance();
     uhd::device_addr_t            hint;
+    gr::basic_block_sptr          chan_src;
     LTE_FDD_DL_SCAN_STATUS_ENUM   err           = LTE_FDD_DL_SCAN_STATUS_FAIL;
     LTE_FDD_DL_SCAN_HW_TYPE_ENUM  hardware_type = LTE_FDD_DL_SCAN_HW_TYPE_UNKNOWN;
     double                        mcr;
+    uint32                        samp_rate;
+    uint32                        analog_bw;
+    uint32                        i;
 
     if(!started)
     {
@@ -174,35 +186,74 @@ LTE_FDD_DL_SCAN_STATUS_ENUM LTE_fdd_dl_scan_flowgraph::start(uint16 dl_earfcn)
                 }
             }
         }
-        if(NULL == state_machine.get())
+        if(NULL == state_machine.get() &&
+           NULL == channelizer.get())
         {
             switch(hardware_type)
             {
             case LTE_FDD_DL_SCAN_HW_TYPE_USRP_B:
-                state_machine = LTE_fdd_dl_scan_make_state_machine(15360000);
+                samp_rate = 15360000;
                 break;
             case LTE_FDD_DL_SCAN_HW_TYPE_USRP_N:
-                state_machine = LTE_fdd_dl_scan_make_state_machine(15360000);
+                samp_rate = 15360000;
                 break;
             case LTE_FDD_DL_SCAN_HW_TYPE_HACKRF:
-                state_machine = LTE_fdd_dl_scan_make_state_machine(15360000);
+                samp_rate = 15360000;
                 break;
             case LTE_FDD_DL_SCAN_HW_TYPE_BLADERF:
-                state_machine = LTE_fdd_dl_scan_make_state_machine(15360000);
+                samp_rate = 15360000;
                 break;
             case LTE_FDD_DL_SCAN_HW_TYPE_UNKNOWN:
             default:
                 printf("Unknown hardware, treating like RTL-SDR\n");
             case LTE_FDD_DL_SCAN_HW_TYPE_RTL_SDR:
-                state_machine = LTE_fdd_dl_scan_make_state_machine(1920000);
+                samp_rate = 1920000;
                 break;
             }
+
+            // Wideband scanning needs the full 15.36MHz
+            N_chans = 0;
+            if(LTE_FDD_DL_SCAN_CHANNELIZER_IN_SAMP_RATE == samp_rate)
+            {
+                N_chans = _N_chans;
+            }else if(0 != _N_chans){
+                printf("Wideband scanning is not supported at %u Hz, scanning one dl_earfcn at a time\n", samp_rate);
+            }
+
+            if(0 != N_chans)
+            {
+                channelizer_bin_taps  = gr::filter::firdes::low_pass(1,
+                                                                     LTE_FDD_DL_SCAN_CHANNELIZER_IN_SAMP_RATE,
+                                                                     LTE_FDD_DL_SCAN_CHANNELIZER_BIN_SPACING,
+                                                                     840000,
+                                                                     gr::filter::firdes::WIN_BLACKMAN);
+                channelizer_chan_taps = gr::filter::firdes::low_pass(1,
+                                                                     LTE_FDD_DL_SCAN_CHANNELIZER_BIN_SAMP_RATE,
+                                                                     LTE_FDD_DL_SCAN_CHANNELIZER_OUT_SAMP_RATE/2,
+                                                                     720000,
+                                                                     gr::filter::firdes::WIN_BLACKMAN);
+                channelizer           = LTE_fdd_dl_scan_make_channelizer(N_chans, channelizer_bin_taps, channelizer_chan_taps);
+                for(i=0; i<N_chans; i++)
+                {
+                    chan_state_machine[i] = LTE_fdd_dl_scan_make_state_machine(LTE_FDD_DL_SCAN_CHANNELIZER_OUT_SAMP_RATE, i);
+                }
+            }else{
+                state_machine = LTE_fdd_dl_scan_make_state_machine(samp_rate, LTE_FDD_DL_SCAN_STATE_MACHINE_NARROWBAND);
+            }
         }
 
         if(NULL != top_block.get() &&
            NULL != samp_src.get()  &&
-           NULL != state_machine.get())
+           (NULL != state_machine.get() ||
+            NULL != channelizer.get()))
         {
+            // Leave room for the channelizer's outer bins in wideband mode
+            if(0 != N_chans)
+            {
+                analog_bw = 14000000;
+            }else{
+                analog_bw = 10000000;
+            }
             if(0 != samp_src->get_num_channels())
             {
                 switch(hardware_type)
@@ -211,13 +262,13 @@ LTE_FDD_DL_SCAN_STATUS_ENUM LTE_fdd_dl_scan_flowgraph::start(uint16 dl_earfcn)
                     samp_src->set_sample_rate(15360000);
                     samp_src->set_gain_mode(false);
                     samp_src->set_gain(35);
-                    samp_src->set_bandwidth(10000000);
+                    samp_src->set_bandwidth(analog_bw);
                     break;
                 case LTE_FDD_DL_SCAN_HW_TYPE_USRP_N:
                     samp_src->set_sample_rate(25000000);
                     samp_src->set_gain_mode(false);
                     samp_src->set_gain(35);
-                    samp_src->set_bandwidth(10000000);
+                    samp_src->set_bandwidth(analog_bw);
                     break;
                 case LTE_FDD_DL_SCAN_HW_TYPE_HACKRF:
                     samp_src->set_sample_rate(15360000);
@@ -231,7 +282,7 @@ LTE_FDD_DL_SCAN_STATUS_ENUM LTE_fdd_dl_scan_flowgraph::start(uint16 dl_earfcn)
                     samp_src->set_gain(6, "LNA");
                     samp_src->set_gain(33, "VGA1");
                     samp_src->set_gain(3, "VGA2");
-                    samp_src->set_bandwidth(10000000);
+                    samp_src->set_bandwidth(analog_bw);
                     break;
                 case LTE_FDD_DL_SCAN_HW_TYPE_UNKNOWN:
                 default:
@@ -246,11 +297,32 @@ LTE_FDD_DL_SCAN_STATUS_ENUM LTE_fdd_dl_scan_flowgraph::start(uint16 dl_earfcn)
                 if(LTE_FDD_DL_SCAN_HW_TYPE_USRP_N == hardware_type)
                 {
                     resample_taps    = gr::filter::firdes::low_pass(384, 1, 0.00065, 0.0013, gr::filter::firdes::WIN_KAISER, 5);
-                    resampler_filter = gr::filter::rational_resampler_base_ccf::make(384, 625, resample_taps);
+                    resampler_filter = LTE_fdd_dl_scan_make_resampler(384, 625, resample_taps);
                     top_block->connect(samp_src, 0, resampler_filter, 0);
-                    top_block->connect(resampler_filter, 0, state_machine, 0);
+                    chan_src = resampler_filter;
+                }else{
+                    chan_src = samp_src;
+                }
+
+                if(0 != N_chans)
+                {
+                    // The first group is picked up by the channels once the
+                    // flowgraph is running, so nothing else is using these yet
+                    N_chans_busy   = 0;
+                    chan_group_idx = 0;
+                    chan_scan_done = false;
+                    for(i=0; i<N_chans; i++)
+                    {
+                        chan_dl_earfcn[i] = LIBLTE_INTERFACE_DL_EARFCN_INVALID;
+                        chan_busy[i]      = false;
+                    }
+                    top_block->connect(chan_src, 0, channelizer, 0);
+                    for(i=0; i<N_chans; i++)
+                    {
+                        top_block->connect(channelizer, i, chan_state_machine[i], 0);
+                    }
                 }else{
-                    top_block->connect(samp_src, 0, state_machine, 0);
+                    top_block->connect(chan_src, 0, state_machine, 0);
                 }
 
                 if(0 == pthread_create(&start_thread, NULL, &run_thread, this))
@@ -297,11 +369,51 @@ void LTE_fdd_dl_scan_flowgraph::update_center_freq(uint16 dl_earfcn)
     }
 }
 
+// Wideband
+LTE_FDD_DL_SCAN_STATUS_ENUM LTE_fdd_dl_scan_flowgraph::get_chan_dl_earfcn(uint32  chan_idx,
+                                                                          uint32 *group_idx,
+                                                                          uint16 *dl_earfcn)
+{
+    boost::mutex::scoped_lock   lock(chan_mutex);
+    LTE_FDD_DL_SCAN_STATUS_ENUM err = LTE_FDD_DL_SCAN_STATUS_FAIL;
+
+    // Retune once every channel is done with the current group
+    if(0 == N_chans_busy &&
+       !chan_scan_done)
+    {
+        start_next_chan_group();
+    }
+
+    *dl_earfcn = LIBLTE_INTERFACE_DL_EARFCN_INVALID;
+    if(!chan_scan_done)
+    {
+        if(*group_idx != chan_group_idx)
+        {
+            *group_idx = chan_group_idx;
+            *dl_earfcn = chan_dl_earfcn[chan_idx];
+        }
+        err = LTE_FDD_DL_SCAN_STATUS_OK;
+    }
+
+    return(err);
+}
+void LTE_fdd_dl_scan_flowgraph::chan_done(uint32 chan_idx)
+{
+    boost::mutex::scoped_lock lock(chan_mutex);
+
+    if(chan_busy[chan_idx])
+    {
+        chan_busy[chan_idx] = false;
+        N_chans_busy--;
+    }
+}
+
 // Run
 void* LTE_fdd_dl_scan_flowgraph::run_thread(void *inputs)
 {
     LTE_fdd_dl_scan_interface *interface = LTE_fdd_dl_scan_interface::get_instance();
     LTE_fdd_dl_scan_flowgraph *flowgraph = (LTE_fdd_dl_scan_flowgraph *)inputs;
+    uint32                     i;
 
     // Disable cancellation while running, state machine block will respond to the stop
     if(0 == pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, NULL))
@@ -320,7 +432,13 @@ void* LTE_fdd_dl_scan_flowgraph::run_thread(void *inputs)
     flowgraph->top_block->stop();
     flowgraph->top_block->disconnect_all();
     flowgraph->samp_src.reset();
+    flowgraph->resampler_filter.reset();
     flowgraph->state_machine.reset();
+    flowgraph->channelizer.reset();
+    for(i=0; i<LTE_FDD_DL_SCAN_CHANNELIZER_N_CHANS_MAX; i++)
+    {
+        flowgraph->chan_state_machine[i].reset();
+    }
 
     // Wait for flowgraph to be stopped
     if(flowgraph->is_started())
@@ -335,3 +453,64 @@ void* LTE_fdd_dl_scan_flowgraph::run_thread(void *inputs)
 
     return(NULL);
 }
+
+// Wideband
+void LTE_fdd_dl_scan_flowgraph::start_next_chan_group(void)
+{
+    LTE_fdd_dl_scan_interface *interface = LTE_fdd_dl_scan_interface::get_instance();
+    uint32                     i;
+    uint32                     N_dl_earfcns;
+    uint32                     freq;
+    uint32                     min_freq;
+    uint32                     max_freq;
+    uint16                     dl_earfcns[LTE_FDD_DL_SCAN_CHANNELIZER_N_CHANS_MAX];
+    double                     center_freq;
+
+    if(LTE_FDD_DL_SCAN_STATUS_OK == interface->switch_to_next_chan_group(LTE_FDD_DL_SCAN_CHANNELIZER_SPAN,
+                                                                         N_chans,
+                                                                         dl_earfcns,
+                                                                         &N_dl_earfcns))
+    {
+        // Center the radio on the group
+        min_freq = liblte_interface_dl_earfcn_to_frequency(dl_earfcns[0]);
+        max_freq = min_freq;
+        for(i=1; i<N_dl_earfcns; i++)
+        {
+            freq = liblte_interface_dl_earfcn_to_frequency(dl_earfcns[i]);
+            if(freq < min_freq)
+            {
+                min_freq = freq;
+            }
+            if(freq > max_freq)
+            {
+                max_freq = freq;
+            }
+        }
+        center_freq = ((double)min_freq + (double)max_freq)/2;
+        start_mutex.lock();
+        if(started &&
+           NULL != samp_src.get())
+        {
+            samp_src->set_center_freq(center_freq);
+        }
+        start_mutex.unlock();
+
+        // Hand out the dl_earfcns
+        for(i=0; i<N_chans; i++)
+        {
+            if(i < N_dl_earfcns)
+            {
+                chan_dl_earfcn[i] = dl_earfcns[i];
+                chan_busy[i]      = true;
+                channelizer->set_chan_freq_offset(i, (float)(liblte_interface_dl_earfcn_to_frequency(dl_earfcns[i]) - center_freq));
+            }else{
+                chan_dl_earfcn[i] = LIBLTE_INTERFACE_DL_EARFCN_INVALID;
+                chan_busy[i]      = false;
+            }
+        }
+        N_chans_busy = N_dl_earfcns;
+        chan_group_idx++;
+    }else{
+        chan_scan_done = true;
+    }
+}
@@ -27,6 +27,8 @@
     02/26/2013    Ben Wojtowicz    Created file
     07/21/2013    Ben Wojtowicz    Added support for decoding SIBs.
     06/15/2014    Ben Wojtowicz    Added PCAP support.
+    10/19/2026    agent            Added wideband scanning of groups of
+                                   dl_earfcns.
 
 *******************************************************************************/
 
@@ -52,6 +54,7 @@
 #define DL_EARFCN_LIST_PARAM "dl_earfcn_list"
 #define REPEAT_PARAM         "repeat"
 #define ENABLE_PCAP_PARAM    "enable_pcap"
+#define WIDEBAND_CHANS_PARAM "wideband_chans"
 
 /*******************************************************************************
                               TYPEDEFS
@@ -113,6 +116,7 @@ LTE_fdd_dl_scan_interface::LTE_fdd_dl_scan_interface()
         dl_earfcn_list[i] = liblte_interface_first_dl_earfcn[band] + i;
     }
     current_dl_earfcn = dl_earfcn_list[dl_earfcn_list_idx];
+    wideband_chans    = 0;
     repeat            = true;
     enable_pcap       = false;
     shutdown          = false;
@@ -206,8 +210,8 @@ void LTE_fdd_dl_scan_interface::send_ctrl_channel_found_begin_msg(LTE_FDD_DL_SCA
         tmp_msg = "info channel_found_begin ";
         try
         {
-            tmp_msg += "freq=" + boost::lexical_cast<std::string>(liblte_interface_dl_earfcn_to_frequency(current_dl_earfcn)) + " ";
-            tmp_msg += "dl_earfcn=" + boost::lexical_cast<std::string>(current_dl_earfcn) + " ";
+            tmp_msg += "freq=" + boost::lexical_cast<std::string>(liblte_interface_dl_earfcn_to_frequency(chan_data->dl_earfcn)) + " ";
+            tmp_msg += "dl_earfcn=" + boost::lexical_cast<std::string>(chan_data->dl_earfcn) + " ";
             tmp_msg += "freq_offset=" + boost::lexical_cast<std::string>(chan_data->freq_offset) + " ";
             tmp_msg += "phys_cell_id=" + boost::lexical_cast<std::string>(chan_data->N_id_cell) + " ";
             tmp_msg += "sfn=" + boost::lexical_cast<std::string>(sfn) + " ";
@@ -238,8 +242,8 @@ void LTE_fdd_dl_scan_interface::send_ctrl_sib1_decoded_msg(LTE_FDD_DL_SCAN_CHAN_
         tmp_msg = "info sib1_decoded ";
         try
         {
-            tmp_msg += "freq=" + boost::lexical_cast<std::string>(liblte_interface_dl_earfcn_to_frequency(current_dl_earfcn)) + " ";
-            tmp_msg += "dl_earfcn=" + boost::lexical_cast<std::string>(current_dl_earfcn) + " ";
+            tmp_msg += "freq=" + boost::lexical_cast<std::string>(liblte_interface_dl_earfcn_to_frequency(chan_data->dl_earfcn)) + " ";
+            tmp_msg += "dl_earfcn=" + boost::lexical_cast<std::string>(chan_data->dl_earfcn) + " ";
             tmp_msg += "freq_offset=" + boost::lexical_cast<std::string>(chan_data->freq_offset) + " ";
             tmp_msg += "phys_cell_id=" + boost::lexical_cast<std::string>(chan_data->N_id_cell) + " ";
             tmp_msg += "sfn=" + boost::lexical_cast<std::string>(sfn) + " ";
@@ -356,8 +360,8 @@ void LTE_fdd_dl_scan_interface::send_ctrl_sib2_decoded_msg(LTE_FDD_DL_SCAN_CHAN_
         tmp_msg = "info sib2_decoded ";
         try
         {
-            tmp_msg += "freq=" + boost::lexical_cast<std::string>(liblte_interface_dl_earfcn_to_frequency(current_dl_earfcn)) + " ";
-            tmp_msg += "dl_earfcn=" + boost::lexical_cast<std::string>(current_dl_earfcn) + " ";
+            tmp_msg += "freq=" + boost::lexical_cast<std::string>(liblte_interface_dl_earfcn_to_frequency(chan_data->dl_earfcn)) + " ";
+            tmp_msg += "dl_earfcn=" + boost::lexical_cast<std::string>(chan_data->dl_earfcn) + " ";
             tmp_msg += "freq_offset=" + boost::lexical_cast<std::string>(chan_data->freq_offset) + " ";
             tmp_msg += "phys_cell_id=" + boost::lexical_cast<std::string>(chan_data->N_id_cell) + " ";
             tmp_msg += "sfn=" + boost::lexical_cast<std::string>(sfn) + " ";
@@ -729,8 +733,8 @@ void LTE_fdd_dl_scan_interface::send_ctrl_sib3_decoded_msg(LTE_FDD_DL_SCAN_CHAN_
         tmp_msg = "info sib3_decoded ";
         try
         {
-            tmp_msg += "freq=" + boost::lexical_cast<std::string>(liblte_interface_dl_earfcn_to_frequency(current_dl_earfcn)) + " ";
-            tmp_msg += "dl_earfcn=" + boost::lexical_cast<std::string>(current_dl_earfcn) + " ";
+            tmp_msg += "freq=" + boost::lexical_cast<std::string>(liblte_interface_dl_earfcn_to_frequency(chan_data->dl_earfcn)) + " ";
+            tmp_msg += "dl_earfcn=" + boost::lexical_cast<std::string>(chan_data->dl_earfcn) + " ";
             tmp_msg += "freq_offset=" + boost::lexical_cast<std::string>(chan_data->freq_offset) + " ";
             tmp_msg += "phys_cell_id=" + boost::lexical_cast<std::string>(chan_data->N_id_cell) + " ";
             tmp_msg += "sfn=" + boost::lexical_cast<std::string>(sfn) + " ";
@@ -798,8 +802,8 @@ void LTE_fdd_dl_scan_interface::send_ctrl_sib4_decoded_msg(LTE_FDD_DL_SCAN_CHAN_
         tmp_msg = "info sib4_decoded ";
         try
         {
-            tmp_msg += "freq=" + boost::lexical_cast<std::string>(liblte_interface_dl_earfcn_to_frequency(current_dl_earfcn)) + " ";
-            tmp_msg += "dl_earfcn=" + boost::lexical_cast<std::string>(current_dl_earfcn) + " ";
+            tmp_msg += "freq=" + boost::lexical_cast<std::string>(liblte_interface_dl_earfcn_to_frequency(chan_data->dl_earfcn)) + " ";
+            tmp_msg += "dl_earfcn=" + boost::lexical_cast<std::string>(chan_data->dl_earfcn) + " ";
             tmp_msg += "freq_offset=" + boost::lexical_cast<std::string>(chan_data->freq_offset) + " ";
             tmp_msg += "phys_cell_id=" + boost::lexical_cast<std::string>(chan_data->N_id_cell) + " ";
             tmp_msg += "sfn=" + boost::lexical_cast<std::string>(sfn) + " ";
@@ -845,8 +849,8 @@ void LTE_fdd_dl_scan_interface::send_ctrl_sib5_decoded_msg(LTE_FDD_DL_SCAN_CHAN_
         tmp_msg = "info sib5_decoded ";
         try
         {
-            tmp_msg += "freq=" + boost::lexical_cast<std::string>(liblte_interface_dl_earfcn_to_frequency(current_dl_earfcn)) + " ";
-            tmp_msg += "dl_earfcn=" + boost::lexical_cast<std::string>(current_dl_earfcn) + " ";
+            tmp_msg += "freq=" + boost::lexical_cast<std::string>(liblte_interface_dl_earfcn_to_frequency(chan_data->dl_earfcn)) + " ";
+            tmp_msg += "dl_earfcn=" + boost::lexical_cast<std::string>(chan_data->dl_earfcn) + " ";
             tmp_msg += "freq_offset=" + boost::lexical_cast<std::string>(chan_data->freq_offset) + " ";
             tmp_msg += "phys_cell_id=" + boost::lexical_cast<std::string>(chan_data->N_id_cell) + " ";
             tmp_msg += "sfn=" + boost::lexical_cast<std::string>(sfn) + " ";
@@ -934,8 +938,8 @@ void LTE_fdd_dl_scan_interface::send_ctrl_sib6_decoded_msg(LTE_FDD_DL_SCAN_CHAN_
         tmp_msg = "info sib6_decoded ";
         try
         {
-            tmp_msg += "freq=" + boost::lexical_cast<std::string>(liblte_interface_dl_earfcn_to_frequency(current_dl_earfcn)) + " ";
-            tmp_msg += "dl_earfcn=" + boost::lexical_cast<std::string>(current_dl_earfcn) + " ";
+            tmp_msg += "freq=" + boost::lexical_cast<std::string>(liblte_interface_dl_earfcn_to_frequency(chan_data->dl_earfcn)) + " ";
+            tmp_msg += "dl_earfcn=" + boost::lexical_cast<std::string>(chan_data->dl_earfcn) + " ";
             tmp_msg += "freq_offset=" + boost::lexical_cast<std::string>(chan_data->freq_offset) + " ";
             tmp_msg += "phys_cell_id=" + boost::lexical_cast<std::string>(chan_data->N_id_cell) + " ";
             tmp_msg += "sfn=" + boost::lexical_cast<std::string>(sfn) + " ";
@@ -1006,8 +1010,8 @@ void LTE_fdd_dl_scan_interface::send_ctrl_sib7_decoded_msg(LTE_FDD_DL_SCAN_CHAN_
         tmp_msg = "info sib7_decoded ";
         try
         {
-            tmp_msg += "freq=" + boost::lexical_cast<std::string>(liblte_interface_dl_earfcn_to_frequency(current_dl_earfcn)) + " ";
-            tmp_msg += "dl_earfcn=" + boost::lexical_cast<std::string>(current_dl_earfcn) + " ";
+            tmp_msg += "freq=" + boost::lexical_cast<std::string>(liblte_interface_dl_earfcn_to_frequency(chan_data->dl_earfcn)) + " ";
+            tmp_msg += "dl_earfcn=" + boost::lexical_cast<std::string>(chan_data->dl_earfcn) + " ";
             tmp_msg += "freq_offset=" + boost::lexical_cast<std::string>(chan_data->freq_offset) + " ";
             tmp_msg += "phys_cell_id=" + boost::lexical_cast<std::string>(chan_data->N_id_cell) + " ";
             tmp_msg += "sfn=" + boost::lexical_cast<std::string>(sfn) + " ";
@@ -1082,8 +1086,8 @@ void LTE_fdd_dl_scan_interface::send_ctrl_sib8_decoded_msg(LTE_FDD_DL_SCAN_CHAN_
         tmp_msg = "info sib8_decoded ";
         try
         {
-            tmp_msg += "freq=" + boost::lexical_cast<std::string>(liblte_interface_dl_earfcn_to_frequency(current_dl_earfcn)) + " ";
-            tmp_msg += "dl_earfcn=" + boost::lexical_cast<std::string>(current_dl_earfcn) + " ";
+            tmp_msg += "freq=" + boost::lexical_cast<std::string>(liblte_interface_dl_earfcn_to_frequency(chan_data->dl_earfcn)) + " ";
+            tmp_msg += "dl_earfcn=" + boost::lexical_cast<std::string>(chan_data->dl_earfcn) + " ";
             tmp_msg += "freq_offset=" + boost::lexical_cast<std::string>(chan_data->freq_offset) + " ";
             tmp_msg += "phys_cell_id=" + boost::lexical_cast<std::string>(chan_data->N_id_cell) + " ";
             tmp_msg += "sfn=" + boost::lexical_cast<std::string>(sfn) + " ";
@@ -1277,8 +1281,8 @@ void LTE_fdd_dl_scan_interface::send_ctrl_channel_found_end_msg(LTE_FDD_DL_SCAN_
         tmp_msg = "info channel_found_end ";
         try
         {
-            tmp_msg += "freq=" + boost::lexical_cast<std::string>(liblte_interface_dl_earfcn_to_frequency(current_dl_earfcn)) + " ";
-            tmp_msg += "dl_earfcn=" + boost::lexical_cast<std::string>(current_dl_earfcn) + " ";
+            tmp_msg += "freq=" + boost::lexical_cast<std::string>(liblte_interface_dl_earfcn_to_frequency(chan_data->dl_earfcn)) + " ";
+            tmp_msg += "dl_earfcn=" + boost::lexical_cast<std::string>(chan_data->dl_earfcn) + " ";
             tmp_msg += "freq_offset=" + boost::lexical_cast<std::string>(chan_data->freq_offset) + " ";
             tmp_msg += "phys_cell_id=" + boost::lexical_cast<std::string>(chan_data->N_id_cell) + " ";
             tmp_msg += "\n";
@@ -1288,7 +1292,7 @@ void LTE_fdd_dl_scan_interface::send_ctrl_channel_found_end_msg(LTE_FDD_DL_SCAN_
         ctrl_socket->send(tmp_msg);
     }
 }
-void LTE_fdd_dl_scan_interface::send_ctrl_channel_not_found_msg(void)
+void LTE_fdd_dl_scan_interface::send_ctrl_channel_not_found_msg(LTE_FDD_DL_SCAN_CHAN_DATA_STRUCT *chan_data)
 {
     boost::mutex::scoped_lock lock(connect_mutex);
     std::string               tmp_msg;
@@ -1298,8 +1302,8 @@ void LTE_fdd_dl_scan_interface::send_ctrl_channel_not_found_msg(void)
         tmp_msg = "info channel_not_found ";
         try
         {
-            tmp_msg += "freq=" + boost::lexical_cast<std::string>(liblte_interface_dl_earfcn_to_frequency(current_dl_earfcn)) + " ";
-            tmp_msg += "dl_earfcn=" + boost::lexical_cast<std::string>(current_dl_earfcn) + " ";
+            tmp_msg += "freq=" + boost::lexical_cast<std::string>(liblte_interface_dl_earfcn_to_frequency(chan_data->dl_earfcn)) + " ";
+            tmp_msg += "dl_earfcn=" + boost::lexical_cast<std::string>(chan_data->dl_earfcn) + " ";
             tmp_msg += "\n";
         }catch(boost::bad_lexical_cast &){
             tmp_msg += "\n";
@@ -1351,14 +1355,15 @@ void LTE_fdd_dl_scan_interface::send_pcap_msg(uint32                 rnti,
                                               uint32                 current_tti,
                                               LIBLTE_BIT_MSG_STRUCT *msg)
 {
-    struct timeval  time;
-    struct timezone time_zone;
-    uint32          i;
-    uint32          idx;
-    uint32          length;
-    uint16          tmp;
-    uint8           pcap_c_hdr[15];
-    uint8           pcap_msg[LIBLTE_MAX_MSG_SIZE/8];
+    boost::mutex::scoped_lock lock(pcap_mutex);
+    struct timeval            time;
+    struct timezone           time_zone;
+    uint32                    i;
+    uint32                    idx;
+    uint32                    length;
+    uint16                    tmp;
+    uint8                     pcap_c_hdr[15];
+    uint8                     pcap_msg[LIBLTE_MAX_MSG_SIZE/8];
 
     if(enable_pcap)
     {
@@ -1475,8 +1480,11 @@ void LTE_fdd_dl_scan_interface::handle_ctrl_error(LIBTOOLS_SOCKET_WRAP_ERROR_ENU
 // Handlers
 void LTE_fdd_dl_scan_interface::handle_read(std::string msg)
 {
-    if(std::string::npos != msg.find(BAND_PARAM))
+    // WIDEBAND_CHANS_PARAM contains BAND_PARAM, so it is checked first
+    if(std::string::npos != msg.find(WIDEBAND_CHANS_PARAM))
     {
+        read_wideband_chans();
+    }else if(std::string::npos != msg.find(BAND_PARAM)){
         read_band();
     }else if(std::string::npos != msg.find(DL_EARFCN_LIST_PARAM)){
         read_dl_earfcn_list();
@@ -1490,8 +1498,11 @@ void LTE_fdd_dl_scan_interface::handle_read(std::string msg)
 }
 void LTE_fdd_dl_scan_interface::handle_write(std::string msg)
 {
-    if(std::string::npos != msg.find(BAND_PARAM))
+    // WIDEBAND_CHANS_PARAM contains BAND_PARAM, so it is checked first
+    if(std::string::npos != msg.find(WIDEBAND_CHANS_PARAM))
     {
+        write_wideband_chans(msg.substr(msg.find(WIDEBAND_CHANS_PARAM)+sizeof(WIDEBAND_CHANS_PARAM), std::string::npos).c_str());
+    }else if(std::string::npos != msg.find(BAND_PARAM)){
         write_band(msg.substr(msg.find(BAND_PARAM)+sizeof(BAND_PARAM), std::string::npos).c_str());
     }else if(std::string::npos != msg.find(DL_EARFCN_LIST_PARAM)){
         write_dl_earfcn_list(msg.substr(msg.find(DL_EARFCN_LIST_PARAM)+sizeof(DL_EARFCN_LIST_PARAM), std::string::npos).c_str());
@@ -1512,7 +1523,7 @@ void LTE_fdd_dl_scan_interface::handle_start(void)
     {
         dl_earfcn_list_idx = 0;
         current_dl_earfcn  = dl_earfcn_list[dl_earfcn_list_idx];
-        if(LTE_FDD_DL_SCAN_STATUS_OK == flowgraph->start(current_dl_earfcn))
+        if(LTE_FDD_DL_SCAN_STATUS_OK == flowgraph->start(current_dl_earfcn, wideband_chans))
         {
             send_ctrl_status_msg(LTE_FDD_DL_SCAN_STATUS_OK, "");
         }else{
@@ -1591,6 +1602,18 @@ void LTE_fdd_dl_scan_interface::handle_help(void)
         tmp_str += "off";
     }
     send_ctrl_msg(tmp_str);
+
+    // Wideband channels
+    tmp_str  = "\t\t";
+    tmp_str += WIDEBAND_CHANS_PARAM;
+    tmp_str += " = ";
+    try
+    {
+        tmp_str += boost::lexical_cast<std::string>(wideband_chans);
+    }catch(boost::bad_lexical_cast &){
+        // Intentionally do nothing
+    }
+    send_ctrl_msg(tmp_str);
 }
 
 // Gets/Sets
@@ -1598,6 +1621,12 @@ bool LTE_fdd_dl_scan_interface::get_shutdown(void)
 {
     return(shutdown);
 }
+uint16 LTE_fdd_dl_scan_interface::get_current_dl_earfcn(void)
+{
+    boost::mutex::scoped_lock lock(dl_earfcn_list_mutex);
+
+    return(current_dl_earfcn);
+}
 
 // Reads/Writes
 void LTE_fdd_dl_scan_interface::read_band(void)
@@ -1748,6 +1777,36 @@ void LTE_fdd_dl_scan_interface::write_enable_pcap(std::string enable_pcap_str)
         send_ctrl_status_msg(LTE_FDD_DL_SCAN_STATUS_FAIL, "Invalid enable_pcap");
     }
 }
+void LTE_fdd_dl_scan_interface::read_wideband_chans(void)
+{
+    try
+    {
+        send_ctrl_status_msg(LTE_FDD_DL_SCAN_STATUS_OK, boost::lexical_cast<std::string>(wideband_chans));
+    }catch(boost::bad_lexical_cast &){
+        send_ctrl_status_msg(LTE_FDD_DL_SCAN_STATUS_FAIL, "bad wideband_chans");
+    }
+}
+void LTE_fdd_dl_scan_interface::write_wideband_chans(std::string wideband_chans_str)
+{
+    LTE_fdd_dl_scan_flowgraph *flowgraph = LTE_fdd_dl_scan_flowgraph::get_instance();
+    uint32                     tmp_chans;
+
+    try
+    {
+        tmp_chans = boost::lexical_cast<uint32>(wideband_chans_str);
+        if(flowgraph->is_started())
+        {
+            send_ctrl_status_msg(LTE_FDD_DL_SCAN_STATUS_FAIL, "Stop the scan before changing wideband_chans");
+        }else if(LTE_FDD_DL_SCAN_CHANNELIZER_N_CHANS_MAX < tmp_chans){
+            send_ctrl_status_msg(LTE_FDD_DL_SCAN_STATUS_FAIL, "Invalid wideband_chans");
+        }else{
+            wideband_chans = tmp_chans;
+            send_ctrl_status_msg(LTE_FDD_DL_SCAN_STATUS_OK, "");
+        }
+    }catch(boost::bad_lexical_cast &){
+        send_ctrl_status_msg(LTE_FDD_DL_SCAN_STATUS_FAIL, "Invalid wideband_chans");
+    }
+}
 
 // Helpers
 LTE_FDD_DL_SCAN_STATUS_ENUM LTE_fdd_dl_scan_interface::switch_to_next_freq(void)
@@ -1778,3 +1837,57 @@ LTE_FDD_DL_SCAN_STATUS_ENUM LTE_fdd_dl_scan_interface::switch_to_next_freq(void)
 
     return(stat);
 }
+LTE_FDD_DL_SCAN_STATUS_ENUM LTE_fdd_dl_scan_interface::switch_to_next_chan_group(uint32  span,
+                                                                                 uint32  max_N_dl_earfcns,
+                                                                                 uint16 *dl_earfcns,
+                                                                                 uint32 *N_dl_earfcns)
+{
+    boost::mutex::scoped_lock   lock(dl_earfcn_list_mutex);
+    LTE_FDD_DL_SCAN_STATUS_ENUM stat = LTE_FDD_DL_SCAN_STATUS_FAIL;
+    uint32                      freq;
+    uint32                      min_freq;
+    uint32                      max_freq;
+
+    // dl_earfcn_list_idx is the first dl_earfcn that has not been scanned
+    if(repeat &&
+       dl_earfcn_list_idx >= dl_earfcn_list_size)
+    {
+        dl_earfcn_list_idx = 0;
+    }
+
+    // Group consecutive dl_earfcns that fit within the span
+    *N_dl_earfcns = 0;
+    min_freq      = 0;
+    max_freq      = 0;
+    while(dl_earfcn_list_idx < dl_earfcn_list_size &&
+          *N_dl_earfcns      < max_N_dl_earfcns)
+    {
+        freq = liblte_interface_dl_earfcn_to_frequency(dl_earfcn_list[dl_earfcn_list_idx]);
+        if(0 == *N_dl_earfcns)
+        {
+            min_freq = freq;
+            max_freq = freq;
+        }else if(freq < min_freq){
+            if((max_freq - freq) > span)
+            {
+                break;
+            }
+            min_freq = freq;
+        }else if(freq > max_freq){
+            if((freq - min_freq) > span)
+            {
+                break;
+            }
+            max_freq = freq;
+        }
+        dl_earfcns[(*N_dl_earfcns)++] = dl_earfcn_list[dl_earfcn_list_idx++];
+    }
+
+    if(0 != *N_dl_earfcns)
+    {
+        current_dl_earfcn = dl_earfcns[0];
+        stat              = LTE_FDD_DL_SCAN_STATUS_OK;
+    }
+
+    return(stat);
+}
@@ -0,0 +1,178 @@
+/*******************************************************************************
+
+    Copyright 2026 agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: LTE_fdd_dl_scan_resampler.cc
+
+    Description: Contains all the implementations for the LTE FDD DL Scanner
+                 rational resampler block.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    agent            Created file
+
+*******************************************************************************/
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "LTE_fdd_dl_scan_resampler.h"
+#include "libtools_samp_conv.h"
+#include <gnuradio/io_signature.h>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              GLOBAL VARIABLES
+*******************************************************************************/
+
+// minimum and maximum number of input and output streams
+static const int32 MIN_IN  = 1;
+static const int32 MAX_IN  = 1;
+static const int32 MIN_OUT = 1;
+static const int32 MAX_OUT = 1;
+
+/*******************************************************************************
+                              CLASS IMPLEMENTATIONS
+*******************************************************************************/
+
+LTE_fdd_dl_scan_resampler_sptr LTE_fdd_dl_scan_make_resampler(uint32                    interp,
+                                                              uint32                    decim,
+                                                              const std::vector<float> &taps)
+{
+    return LTE_fdd_dl_scan_resampler_sptr(new LTE_fdd_dl_scan_resampler(interp, decim, taps));
+}
+
+LTE_fdd_dl_scan_resampler::LTE_fdd_dl_scan_resampler(uint32                    interp,
+                                                     uint32                    decim,
+                                                     const std::vector<float> &taps)
+    : gr::block ("LTE_fdd_dl_scan_resampler",
+                 gr::io_signature::make(MIN_IN,  MAX_IN,  sizeof(gr_complex)),
+                 gr::io_signature::make(MIN_OUT, MAX_OUT, sizeof(gr_complex)))
+{
+    std::vector<float> tmp_taps = taps;
+
+    set_relative_rate((double)interp/(double)decim);
+
+    // The history is kept by the resampler, so input samples are only
+    // needed for the outputs being produced
+    liblte_phy_resamp_init(&resamp, interp, decim, &tmp_taps[0], tmp_taps.size());
+    i_in_buf  = (float *)malloc(LTE_FDD_DL_SCAN_RESAMPLER_BATCH_N_SAMPS*sizeof(float));
+    q_in_buf  = (float *)malloc(LTE_FDD_DL_SCAN_RESAMPLER_BATCH_N_SAMPS*sizeof(float));
+    i_out_buf = (float *)malloc(LTE_FDD_DL_SCAN_RESAMPLER_BATCH_N_SAMPS*sizeof(float));
+    q_out_buf = (float *)malloc(LTE_FDD_DL_SCAN_RESAMPLER_BATCH_N_SAMPS*sizeof(float));
+}
+LTE_fdd_dl_scan_resampler::~LTE_fdd_dl_scan_resampler()
+{
+    liblte_phy_resamp_cleanup(resamp);
+    free(i_in_buf);
+    free(q_in_buf);
+    free(i_out_buf);
+    free(q_out_buf);
+}
+
+void LTE_fdd_dl_scan_resampler::forecast(int32          noutput_items,
+                                         gr_vector_int &ninput_items_required)
+{
+    uint32 N_in;
+
+    liblte_phy_resamp_get_n_in(resamp, noutput_items, &N_in);
+    if(0 == N_in)
+    {
+        N_in = 1;
+    }
+    ninput_items_required[0] = N_in;
+}
+
+int32 LTE_fdd_dl_scan_resampler::general_work(int32                      noutput_items,
+                                              gr_vector_int             &ninput_items,
+                                              gr_vector_const_void_star &input_items,
+                                              gr_vector_void_star       &output_items)
+{
+    const gr_complex  *in  = (const gr_complex *)input_items[0];
+    gr_complex        *out = (gr_complex *)output_items[0];
+    const float       *i_out_bufs[1];
+    const float       *q_out_bufs[1];
+    uint32             N_in_done  = 0;
+    uint32             N_out_done = 0;
+    uint32             N_in;
+    uint32             N_out;
+    uint32             N_out_max;
+
+    i_out_bufs[0] = i_out_buf;
+    q_out_bufs[0] = q_out_buf;
+    do
+    {
+        // Only take the input needed for the space left in the output
+        N_out_max = noutput_items - N_out_done;
+        if(N_out_max > LTE_FDD_DL_SCAN_RESAMPLER_BATCH_N_SAMPS)
+        {
+            N_out_max = LTE_FDD_DL_SCAN_RESAMPLER_BATCH_N_SAMPS;
+        }
+        liblte_phy_resamp_get_n_in(resamp, N_out_max, &N_in);
+        if(N_in > (ninput_items[0] - N_in_done))
+        {
+            N_in = ninput_items[0] - N_in_done;
+        }
+        if(N_in > LTE_FDD_DL_SCAN_RESAMPLER_BATCH_N_SAMPS)
+        {
+            N_in = LTE_FDD_DL_SCAN_RESAMPLER_BATCH_N_SAMPS;
+        }
+
+        libtools_samp_conv_to_split(LIBTOOLS_SAMP_CONV_FORMAT_CF32,
+                                    &in[N_in_done],
+                                    1.0,
+                                    i_in_buf,
+                                    q_in_buf,
+                                    N_in);
+        liblte_phy_resamp_run(resamp,
+                              i_in_buf,
+                              q_in_buf,
+                              N_in,
+                              i_out_buf,
+                              q_out_buf,
+                              N_out_max,
+                              &N_out);
+        libtools_samp_conv_from_split(i_out_bufs,
+                                      q_out_bufs,
+                                      1,
+                                      1.0,
+                                      LIBTOOLS_SAMP_CONV_FORMAT_CF32,
+                                      &out[N_out_done],
+                                      N_out);
+        N_in_done  += N_in;
+        N_out_done += N_out;
+    }while((0 != N_in || 0 != N_out)           &&
+           N_in_done  < (uint32)ninput_items[0] &&
+           N_out_done < (uint32)noutput_items);
+
+    // Tell runtime system how many input items we consumed.
+    consume_each(N_in_done);
+
+    // Tell runtime system how many output items we produced.
+    return(N_out_done);
+}
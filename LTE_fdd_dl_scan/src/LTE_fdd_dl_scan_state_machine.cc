@@ -31,6 +31,11 @@
                                    latest LTE library.
     03/26/2014    Ben Wojtowicz    Using the latest LTE library.
     06/15/2014    Ben Wojtowicz    Added PCAP support.
+    10/19/2026    agent            Correcting the frequency offset with an NCO
+                                   as samples are copied in instead of
+                                   shifting the whole buffer with cosf/sinf.
+    10/19/2026    agent            Added support for running as one channel of
+                                   a wideband scan.
 
 *******************************************************************************/
 
@@ -50,10 +55,10 @@
 // Generic defines
 #define COARSE_TIMING_N_SLOTS (160)
 #define MAX_ATTEMPTS          (5)
-#define SAMP_BUF_SIZE         (307200*20)
 #define MAX_PDSCH_ATTEMPTS    (20*10)
 
 // Sample rate 1.92MHZ defines
+#define SAMP_BUF_SIZE_1_92MHZ                        (38400*20)
 #define ONE_SUBFRAME_NUM_SAMPS_1_92MHZ               (LIBLTE_PHY_N_SAMPS_PER_SUBFR_1_92MHZ)
 #define ONE_FRAME_NUM_SAMPS_1_92MHZ                  (10 * ONE_SUBFRAME_NUM_SAMPS_1_92MHZ)
 #define FREQ_CHANGE_WAIT_NUM_SAMPS_1_92MHZ           (100 * ONE_FRAME_NUM_SAMPS_1_92MHZ)
@@ -65,6 +70,7 @@
 #define PDSCH_DECODE_SI_GENERIC_NUM_SAMPS_1_92MHZ    (ONE_FRAME_NUM_SAMPS_1_92MHZ)
 
 // Sample rate 15.36MHZ defines
+#define SAMP_BUF_SIZE_15_36MHZ                        (307200*20)
 #define ONE_SUBFRAME_NUM_SAMPS_15_36MHZ               (LIBLTE_PHY_N_SAMPS_PER_SUBFR_15_36MHZ)
 #define ONE_FRAME_NUM_SAMPS_15_36MHZ                  (10 * ONE_SUBFRAME_NUM_SAMPS_15_36MHZ)
 #define FREQ_CHANGE_WAIT_NUM_SAMPS_15_36MHZ           (100 * ONE_FRAME_NUM_SAMPS_15_36MHZ)
@@ -94,12 +100,14 @@ static const int32 MAX_OUT = 0;
                               CLASS IMPLEMENTATIONS
 *******************************************************************************/
 
-LTE_fdd_dl_scan_state_machine_sptr LTE_fdd_dl_scan_make_state_machine(uint32 samp_rate)
+LTE_fdd_dl_scan_state_machine_sptr LTE_fdd_dl_scan_make_state_machine(uint32 samp_rate,
+                                                                      uint32 chan_idx)
 {
-    return LTE_fdd_dl_scan_state_machine_sptr(new LTE_fdd_dl_scan_state_machine(samp_rate));
+    return LTE_fdd_dl_scan_state_machine_sptr(new LTE_fdd_dl_scan_state_machine(samp_rate, chan_idx));
 }
 
-LTE_fdd_dl_scan_state_machine::LTE_fdd_dl_scan_state_machine(uint32 samp_rate)
+LTE_fdd_dl_scan_state_machine::LTE_fdd_dl_scan_state_machine(uint32 samp_rate,
+                                                             uint32 _chan_idx)
     : gr::sync_block ("LTE_fdd_dl_scan_state_machine",
                       gr::io_signature::make(MIN_IN,  MAX_IN,  sizeof(gr_complex)),
                       gr::io_signature::make(MIN_OUT, MAX_OUT, sizeof(gr_complex)))
@@ -116,6 +124,7 @@ LTE_fdd_dl_scan_state_machine::LTE_fdd_dl_scan_state_machine(uint32 samp_rate)
                         LIBLTE_PHY_N_RB_DL_1_4MHZ,
                         LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP,
                         liblte_rrc_phich_resource_num[LIBLTE_RRC_PHICH_RESOURCE_1]);
+        samp_buf_size                        = SAMP_BUF_SIZE_1_92MHZ;
         one_subframe_num_samps               = ONE_SUBFRAME_NUM_SAMPS_1_92MHZ;
         one_frame_num_samps                  = ONE_FRAME_NUM_SAMPS_1_92MHZ;
         freq_change_wait_num_samps           = FREQ_CHANGE_WAIT_NUM_SAMPS_1_92MHZ;
@@ -133,6 +142,7 @@ LTE_fdd_dl_scan_state_machine::LTE_fdd_dl_scan_state_machine(uint32 samp_rate)
                         LIBLTE_PHY_N_RB_DL_10MHZ,
                         LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP,
                         liblte_rrc_phich_resource_num[LIBLTE_RRC_PHICH_RESOURCE_1]);
+        samp_buf_size                        = SAMP_BUF_SIZE_15_36MHZ;
         one_subframe_num_samps               = ONE_SUBFRAME_NUM_SAMPS_15_36MHZ;
         one_frame_num_samps                  = ONE_FRAME_NUM_SAMPS_15_36MHZ;
         freq_change_wait_num_samps           = FREQ_CHANGE_WAIT_NUM_SAMPS_15_36MHZ;
@@ -144,12 +154,20 @@ LTE_fdd_dl_scan_state_machine::LTE_fdd_dl_scan_state_machine(uint32 samp_rate)
         pdsch_decode_si_generic_num_samps    = PDSCH_DECODE_SI_GENERIC_NUM_SAMPS_15_36MHZ;
     }
 
+    liblte_phy_nco_init(&nco, phy_struct->fs, 0);
+
     // Initialize the sample buffer
-    i_buf          = (float *)malloc(SAMP_BUF_SIZE*sizeof(float));
-    q_buf          = (float *)malloc(SAMP_BUF_SIZE*sizeof(float));
+    i_buf          = (float *)malloc(samp_buf_size*sizeof(float));
+    q_buf          = (float *)malloc(samp_buf_size*sizeof(float));
     samp_buf_w_idx = 0;
     samp_buf_r_idx = 0;
 
+    // Wideband channels wait for a dl_earfcn from the flowgraph
+    chan_idx            = _chan_idx;
+    chan_group_idx      = 0;
+    chan_idle           = (LTE_FDD_DL_SCAN_STATE_MACHINE_NARROWBAND != chan_idx);
+    chan_data.dl_earfcn = LIBLTE_INTERFACE_DL_EARFCN_INVALID;
+
     // Variables
     init();
     send_cnf        = true;
@@ -194,14 +212,28 @@ int32 LTE_fdd_dl_scan_state_machine::work(int32                      ninput_item
     bool                        copy_input      = false;
     bool                        switch_freq     = false;
 
-    if(freq_change_wait_done)
+    if(chan_idle)
     {
-        if(samp_buf_w_idx < (SAMP_BUF_SIZE-(ninput_items+1)))
+        if(LTE_FDD_DL_SCAN_STATUS_OK == flowgraph->get_chan_dl_earfcn(chan_idx, &chan_group_idx, &chan_data.dl_earfcn))
+        {
+            if(LIBLTE_INTERFACE_DL_EARFCN_INVALID != chan_data.dl_earfcn)
+            {
+                // Start on the new dl_earfcn once the radio has retuned
+                samp_buf_w_idx = 0;
+                samp_buf_r_idx = 0;
+                init();
+                chan_idle = false;
+            }
+        }else{
+            done_flag = -1;
+        }
+    }else if(freq_change_wait_done){
+        if(samp_buf_w_idx < (samp_buf_size-(ninput_items+1)))
         {
             copy_input_to_samp_buf(in, ninput_items);
 
             // Check if buffer is full enough
-            if(samp_buf_w_idx >= (SAMP_BUF_SIZE-(ninput_items+1)))
+            if(samp_buf_w_idx >= (samp_buf_size-(ninput_items+1)))
             {
                 process_samples = true;
                 copy_input      = false;
@@ -216,17 +248,15 @@ int32 LTE_fdd_dl_scan_state_machine::work(int32                      ninput_item
         if(freq_change_wait_cnt >= freq_change_wait_num_samps)
         {
             freq_change_wait_done = true;
+            if(LTE_FDD_DL_SCAN_STATE_MACHINE_NARROWBAND == chan_idx)
+            {
+                chan_data.dl_earfcn = interface->get_current_dl_earfcn();
+            }
         }
     }
 
     if(process_samples)
     {
-        if(LTE_FDD_DL_SCAN_STATE_MACHINE_STATE_COARSE_TIMING_SEARCH != state)
-        {
-            // Correct frequency error
-            freq_shift(0, SAMP_BUF_SIZE, timing_struct.freq_offset[corr_peak_idx]);
-        }
-
         while(samp_buf_r_idx < (samp_buf_w_idx - N_samps_needed) &&
               samp_buf_w_idx != 0)
         {
@@ -241,8 +271,10 @@ int32 LTE_fdd_dl_scan_state_machine::work(int32                      ninput_item
                 {
                     if(corr_peak_idx < timing_struct.n_corr_peaks)
                     {
-                        // Correct frequency error
-                        freq_shift(0, SAMP_BUF_SIZE, timing_struct.freq_offset[corr_peak_idx]);
+                        // Correct frequency error, the offset was measured on
+                        // samples that the NCO had already corrected
+                        freq_shift(timing_struct.freq_offset[corr_peak_idx]);
+                        timing_struct.freq_offset[corr_peak_idx] = nco.freq_offset;
 
                         // Search for PSS and fine timing
                         state          = LTE_FDD_DL_SCAN_STATE_MACHINE_STATE_PSS_AND_FINE_TIMING_SEARCH;
@@ -274,7 +306,7 @@ int32 LTE_fdd_dl_scan_state_machine::work(int32                      ninput_item
                 {
                     if(fabs(freq_offset) > 100)
                     {
-                        freq_shift(0, SAMP_BUF_SIZE, freq_offset);
+                        freq_shift(freq_offset);
                         timing_struct.freq_offset[corr_peak_idx] += freq_offset;
                     }
 
@@ -627,6 +659,7 @@ int32 LTE_fdd_dl_scan_state_machine::work(int32                      ninput_item
                 {
                     timing_struct.freq_offset[i] = 0;
                 }
+                liblte_phy_nco_init(&nco, phy_struct->fs, 0);
                 break;
             }
 
@@ -642,7 +675,6 @@ int32 LTE_fdd_dl_scan_state_machine::work(int32                      ninput_item
             samp_buf_r_idx -= 100;
             samps_to_copy   = samp_buf_w_idx - samp_buf_r_idx;
             samp_buf_w_idx  = 0;
-            freq_shift(samp_buf_r_idx, samps_to_copy, -timing_struct.freq_offset[corr_peak_idx]);
             for(i=0; i<samps_to_copy; i++)
             {
                 i_buf[samp_buf_w_idx]   = i_buf[samp_buf_r_idx];
@@ -698,31 +730,33 @@ void LTE_fdd_dl_scan_state_machine::init(void)
 void LTE_fdd_dl_scan_state_machine::copy_input_to_samp_buf(const gr_complex *in, int32 ninput_items)
 {
     uint32 i;
+    uint32 start_idx = samp_buf_w_idx;
 
     for(i=0; i<ninput_items; i++)
     {
         i_buf[samp_buf_w_idx]   = in[i].real();
         q_buf[samp_buf_w_idx++] = in[i].imag();
     }
+
+    // Correct frequency error
+    liblte_phy_nco_rotate(&nco,
+                          &i_buf[start_idx],
+                          &q_buf[start_idx],
+                          samp_buf_w_idx - start_idx);
 }
 
-void LTE_fdd_dl_scan_state_machine::freq_shift(uint32 start_idx, uint32 num_samps, float freq_offset)
+void LTE_fdd_dl_scan_state_machine::freq_shift(float freq_offset)
 {
-    float  f_samp_re;
-    float  f_samp_im;
-    float  tmp_i;
-    float  tmp_q;
-    uint32 i;
+    LIBLTE_PHY_NCO_STRUCT shift_nco;
 
-    for(i=start_idx; i<(start_idx+num_samps); i++)
-    {
-        f_samp_re = cosf((i+1)*(freq_offset)*2*M_PI/phy_struct->fs);
-        f_samp_im = sinf((i+1)*(freq_offset)*2*M_PI/phy_struct->fs);
-        tmp_i     = i_buf[i];
-        tmp_q     = q_buf[i];
-        i_buf[i]  = tmp_i*f_samp_re + tmp_q*f_samp_im;
-        q_buf[i]  = tmp_q*f_samp_re - tmp_i*f_samp_im;
-    }
+    // Remove the additional offset from the samples already in the buffer,
+    // lining its phase up with the NCO at the write index
+    liblte_phy_nco_init(&shift_nco, phy_struct->fs, freq_offset);
+    liblte_phy_nco_seek(&shift_nco, -(int32)samp_buf_w_idx);
+    liblte_phy_nco_rotate(&shift_nco, i_buf, q_buf, samp_buf_w_idx);
+
+    // Remove the total offset from new samples
+    liblte_phy_nco_set_freq_offset(&nco, nco.freq_offset + freq_offset);
 }
 
 void LTE_fdd_dl_scan_state_machine::channel_found(bool  &switch_freq,
@@ -742,13 +776,7 @@ void LTE_fdd_dl_scan_state_machine::channel_found(bool  &switch_freq,
     {
         // Change frequency
         corr_peak_idx = 0;
-        if(LTE_FDD_DL_SCAN_STATUS_OK == interface->switch_to_next_freq())
-        {
-            switch_freq = true;
-            send_cnf    = true;
-        }else{
-            done_flag = -1;
-        }
+        next_freq(switch_freq, done_flag);
     }else{
         send_cnf = false;
     }
@@ -762,7 +790,7 @@ void LTE_fdd_dl_scan_state_machine::channel_not_found(bool  &switch_freq,
     if(send_cnf)
     {
         // Send the channel information
-        interface->send_ctrl_channel_not_found_msg();
+        interface->send_ctrl_channel_not_found_msg(&chan_data);
     }
 
     // Initialize for the next channel
@@ -770,11 +798,29 @@ void LTE_fdd_dl_scan_state_machine::channel_not_found(bool  &switch_freq,
 
     // Change frequency
     corr_peak_idx = 0;
-    if(LTE_FDD_DL_SCAN_STATUS_OK == interface->switch_to_next_freq())
+    next_freq(switch_freq, done_flag);
+}
+
+void LTE_fdd_dl_scan_state_machine::next_freq(bool  &switch_freq,
+                                              int32 &done_flag)
+{
+    LTE_fdd_dl_scan_interface *interface = LTE_fdd_dl_scan_interface::get_instance();
+    LTE_fdd_dl_scan_flowgraph *flowgraph = LTE_fdd_dl_scan_flowgraph::get_instance();
+
+    if(LTE_FDD_DL_SCAN_STATE_MACHINE_NARROWBAND == chan_idx)
     {
+        if(LTE_FDD_DL_SCAN_STATUS_OK == interface->switch_to_next_freq())
+        {
+            switch_freq = true;
+            send_cnf    = true;
+        }else{
+            done_flag = -1;
+        }
+    }else{
+        // Wait for the rest of the channels before the radio is retuned
+        flowgraph->chan_done(chan_idx);
+        chan_idle   = true;
         switch_freq = true;
         send_cnf    = true;
-    }else{
-        done_flag = -1;
     }
 }
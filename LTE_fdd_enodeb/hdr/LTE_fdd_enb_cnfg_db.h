@@ -27,6 +27,9 @@
     11/09/2013    Ben Wojtowicz    Created file
     01/18/2014    Ben Wojtowicz    Added set/get routines for uint32 values.
     03/26/2014    Ben Wojtowicz    Using the latest LTE library.
+    10/19/2026    agent            Added the DL scheduling policy.
+    10/19/2026    agent            Publishing parameters and system information
+                                   as immutable, versioned snapshots.
 
 *******************************************************************************/
 
@@ -38,15 +41,18 @@
 *******************************************************************************/
 
 #include "LTE_fdd_enb_interface.h"
+#include "LTE_fdd_enb_epoch_mgr.h"
 #include "liblte_rrc.h"
 #include "liblte_phy.h"
+#include <boost/thread/mutex.hpp>
 #include <string>
-#include <map>
 
 /*******************************************************************************
                               DEFINES
 *******************************************************************************/
 
+// SIB1 and one allocation per scheduling info list entry
+#define LTE_FDD_ENB_CNFG_DB_MAX_SI_ALLOCS 5
 
 /*******************************************************************************
                               FORWARD DECLARATIONS
@@ -57,6 +63,37 @@
                               TYPEDEFS
 *******************************************************************************/
 
+typedef enum{
+    LTE_FDD_ENB_DL_SCHED_POLICY_ROUND_ROBIN = 0,
+    LTE_FDD_ENB_DL_SCHED_POLICY_MAX_CI,
+    LTE_FDD_ENB_DL_SCHED_POLICY_PROPORTIONAL_FAIR,
+    LTE_FDD_ENB_DL_SCHED_POLICY_N_ITEMS,
+}LTE_FDD_ENB_DL_SCHED_POLICY_ENUM;
+static const char LTE_fdd_enb_dl_sched_policy_text[LTE_FDD_ENB_DL_SCHED_POLICY_N_ITEMS][20] = {"round_robin",
+                                                                                               "max_ci",
+                                                                                               "proportional_fair"};
+
+typedef enum{
+    LTE_FDD_ENB_CNFG_TYPE_NONE = 0,
+    LTE_FDD_ENB_CNFG_TYPE_DOUBLE,
+    LTE_FDD_ENB_CNFG_TYPE_INT64,
+    LTE_FDD_ENB_CNFG_TYPE_UINT32,
+    LTE_FDD_ENB_CNFG_TYPE_N_ITEMS,
+}LTE_FDD_ENB_CNFG_TYPE_ENUM;
+static const char LTE_fdd_enb_cnfg_type_text[LTE_FDD_ENB_CNFG_TYPE_N_ITEMS][20] = {"none",
+                                                                                   "double",
+                                                                                   "int64",
+                                                                                   "uint32"};
+
+// Never modified once published, readers index it by LTE_FDD_ENB_PARAM_ENUM
+typedef struct{
+    double                     double_value[LTE_FDD_ENB_PARAM_N_ITEMS];
+    int64                      int64_value[LTE_FDD_ENB_PARAM_N_ITEMS];
+    uint32                     uint32_value[LTE_FDD_ENB_PARAM_N_ITEMS];
+    LTE_FDD_ENB_CNFG_TYPE_ENUM type[LTE_FDD_ENB_PARAM_N_ITEMS];
+    uint32                     version;
+}LTE_FDD_ENB_CNFG_PARAMS_STRUCT;
+
 typedef struct{
     LIBLTE_RRC_MIB_STRUCT                   mib;
     LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_1_STRUCT sib1;
@@ -79,14 +116,26 @@ typedef struct{
     uint32                                  N_sc_rb_ul;
     uint32                                  si_periodicity_T;
     uint32                                  si_win_len;
+    LTE_FDD_ENB_DL_SCHED_POLICY_ENUM        dl_sched_policy;
     bool                                    sib3_present;
     bool                                    sib4_present;
     bool                                    sib5_present;
     bool                                    sib6_present;
     bool                                    sib7_present;
     bool                                    sib8_present;
+    uint32                                  version;
 }LTE_FDD_ENB_SYS_INFO_STRUCT;
 
+// Placement of one system information allocation within a subframe
+typedef struct{
+    LIBLTE_PHY_ALLOCATION_STRUCT *alloc;
+    uint32                        rv_idx;
+    uint32                        first_prb;
+    uint32                        tbs;
+    uint32                        N_prb;
+    uint8                         mcs;
+}LTE_FDD_ENB_SI_ALLOC_STRUCT;
+
 /*******************************************************************************
                               CLASS DECLARATIONS
 *******************************************************************************/
@@ -110,7 +159,9 @@ public:
 
     // MIB/SIB Construction
     void construct_sys_info(void);
-    void get_sys_info(LTE_FDD_ENB_SYS_INFO_STRUCT &_sys_info);
+    uint32 get_sys_info(LTE_FDD_ENB_SYS_INFO_STRUCT &_sys_info);
+    uint32 get_sys_info_version(void);
+    static uint32 get_sys_info_allocs(LTE_FDD_ENB_SYS_INFO_STRUCT *sys_info, uint32 sfn, uint32 subfn, LTE_FDD_ENB_SI_ALLOC_STRUCT *si_alloc);
 
 private:
     // Singleton
@@ -119,12 +170,17 @@ private:
     ~LTE_fdd_enb_cnfg_db();
 
     // Parameters
-    std::map<LTE_FDD_ENB_PARAM_ENUM, double> var_map_double;
-    std::map<LTE_FDD_ENB_PARAM_ENUM, int64>  var_map_int64;
-    std::map<LTE_FDD_ENB_PARAM_ENUM, uint32> var_map_uint32;
+    LTE_FDD_ENB_CNFG_PARAMS_STRUCT* copy_params(void);
+    void publish_params(LTE_FDD_ENB_CNFG_PARAMS_STRUCT *new_params);
+    boost::mutex                              params_mutex;
+    LTE_FDD_ENB_CNFG_PARAMS_STRUCT * volatile cur_params;
 
     // System information
-    LTE_FDD_ENB_SYS_INFO_STRUCT sys_info;
+    boost::mutex                              sys_info_mutex;
+    LTE_FDD_ENB_SYS_INFO_STRUCT * volatile    cur_sys_info;
+
+    // Snapshot reclamation
+    LTE_fdd_enb_epoch_mgr *epoch_mgr;
 };
 
 #endif /* __LTE_FDD_ENB_CNFG_DB_H__ */
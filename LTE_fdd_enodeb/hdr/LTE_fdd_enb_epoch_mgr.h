@@ -0,0 +1,122 @@
+/*******************************************************************************
+
+    Copyright 2026 agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: LTE_fdd_enb_epoch_mgr.h
+
+    Description: Contains all the definitions for the LTE FDD eNodeB
+                 epoch manager.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    agent            Created file
+
+*******************************************************************************/
+
+#ifndef __LTE_FDD_ENB_EPOCH_MGR_H__
+#define __LTE_FDD_ENB_EPOCH_MGR_H__
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "typedefs.h"
+#include <boost/thread/mutex.hpp>
+#include <pthread.h>
+#include <list>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+// Readers are counted per epoch, only the current and the previous epoch
+// can have readers so three counters are enough
+#define LTE_FDD_ENB_EPOCH_MGR_N_EPOCHS 3
+
+// How often the collect thread checks retired objects for reclamation
+#define LTE_FDD_ENB_EPOCH_MGR_COLLECT_PERIOD_MS 10
+
+/*******************************************************************************
+                              FORWARD DECLARATIONS
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+typedef void (*LTE_fdd_enb_epoch_free_func)(void *obj);
+template<class class_type>
+    void LTE_fdd_enb_epoch_delete(void *obj)
+{
+    delete static_cast<class_type*>(obj);
+}
+
+typedef struct{
+    LTE_fdd_enb_epoch_free_func  free_func;
+    void                        *obj;
+    uint64                       epoch;
+}LTE_FDD_ENB_EPOCH_RETIRED_STRUCT;
+
+/*******************************************************************************
+                              CLASS DECLARATIONS
+*******************************************************************************/
+
+// Epoch based reclamation.  Readers pin the current epoch while they hold
+// pointers to shared objects, objects that are unpublished are retired and
+// only freed once every reader that could have seen them has unpinned.  The
+// epoch only advances when the previous epoch has no readers, so an object
+// retired in epoch N is freed once the epoch reaches N+2.
+class LTE_fdd_enb_epoch_mgr
+{
+public:
+    // Singleton
+    static LTE_fdd_enb_epoch_mgr* get_instance(void);
+    static void cleanup(void);
+
+    // Readers
+    uint64 pin(void);
+    void unpin(uint64 pinned_epoch);
+    void set_thread_pin(uint64 pinned_epoch);
+    void clear_thread_pin(void);
+
+    // Reclamation
+    void retire(LTE_fdd_enb_epoch_free_func free_func, void *obj);
+
+private:
+    // Singleton
+    static LTE_fdd_enb_epoch_mgr *instance;
+    LTE_fdd_enb_epoch_mgr();
+    ~LTE_fdd_enb_epoch_mgr();
+
+    // Readers
+    static __thread uint64 thread_epoch;
+    static __thread bool   thread_pinned;
+    volatile uint64        epoch;
+    volatile uint32        N_readers[LTE_FDD_ENB_EPOCH_MGR_N_EPOCHS];
+
+    // Reclamation
+    static void* collect_thread_func(void *inputs);
+    void collect(void);
+    boost::mutex                                retire_mutex;
+    std::list<LTE_FDD_ENB_EPOCH_RETIRED_STRUCT> retired_list;
+    pthread_t                                   collect_thread;
+    volatile bool                               collect_thread_stop;
+};
+
+#endif /* __LTE_FDD_ENB_EPOCH_MGR_H__ */
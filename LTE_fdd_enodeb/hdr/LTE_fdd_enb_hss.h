@@ -25,6 +25,9 @@
     Revision History
     ----------    -------------    --------------------------------------------
     06/15/2014    Ben Wojtowicz    Created file
+    10/19/2026    agent            Replaced the user list with an open
+                                   addressed subscriber table, added bulk
+                                   import, snapshots, and a user iterator.
 
 *******************************************************************************/
 
@@ -36,13 +39,19 @@
 *******************************************************************************/
 
 #include "LTE_fdd_enb_interface.h"
-#include "LTE_fdd_enb_user.h"
-#include <list>
+#include "typedefs.h"
+#include <boost/thread/mutex.hpp>
+#include <string>
 
 /*******************************************************************************
                               DEFINES
 *******************************************************************************/
 
+#define LTE_FDD_ENB_HSS_MAX_IMSI_DIGITS  15
+#define LTE_FDD_ENB_HSS_MIN_N_SLOTS      1024 // Must be a power of 2
+#define LTE_FDD_ENB_HSS_SNAPSHOT_MAGIC   0x31535348 // "HSS1"
+#define LTE_FDD_ENB_HSS_SNAPSHOT_VERSION 1
+#define LTE_FDD_ENB_HSS_PRINT_CHUNK_SIZE 100 // IMSIs per control message
 
 /*******************************************************************************
                               FORWARD DECLARATIONS
@@ -53,6 +62,19 @@
                               TYPEDEFS
 *******************************************************************************/
 
+// IMSI digits in the low 56 bits and number of digits in the top 8 bits,
+// a key of 0 marks an empty slot
+typedef struct{
+    uint64 key;
+}LTE_FDD_ENB_HSS_SUB_STRUCT;
+
+// Snapshot files are this header followed by the subscriber table as is
+typedef struct{
+    uint32 magic;
+    uint32 version;
+    uint32 N_slots;
+    uint32 N_users;
+}LTE_FDD_ENB_HSS_SNAPSHOT_HDR_STRUCT;
 
 /*******************************************************************************
                               CLASS DECLARATIONS
@@ -67,9 +89,13 @@ public:
 
     // External interface
     LTE_FDD_ENB_ERROR_ENUM add_user(std::string imsi);
-    LTE_FDD_ENB_ERROR_ENUM find_user(std::string imsi, LTE_fdd_enb_user **user);
+    LTE_FDD_ENB_ERROR_ENUM find_user(std::string imsi);
     LTE_FDD_ENB_ERROR_ENUM del_user(std::string imsi);
-    std::string print_all_users(void);
+    LTE_FDD_ENB_ERROR_ENUM import_users(std::string file_name, uint32 *N_imported);
+    LTE_FDD_ENB_ERROR_ENUM save_snapshot(std::string file_name);
+    LTE_FDD_ENB_ERROR_ENUM load_snapshot(std::string file_name);
+    uint32 get_n_users(void);
+    LTE_FDD_ENB_ERROR_ENUM get_next_user(uint32 *cursor, std::string *imsi);
 
 private:
     // Singleton
@@ -77,9 +103,22 @@ private:
     LTE_fdd_enb_hss();
     ~LTE_fdd_enb_hss();
 
-    // Allowed users
-    boost::mutex                  user_mutex;
-    std::list<LTE_fdd_enb_user *> user_list;
+    // Subscriber table
+    LTE_FDD_ENB_ERROR_ENUM alloc_table(uint32 _N_slots);
+    void free_table(void);
+    LTE_FDD_ENB_ERROR_ENUM reserve(uint32 _N_users);
+    uint32 find_slot(uint64 key);
+    uint32 find_slot(LTE_FDD_ENB_HSS_SUB_STRUCT *_table, uint32 _N_slots, uint64 key);
+    void insert_key(uint64 key);
+    void remove_slot(uint32 slot);
+    bool imsi_to_key(std::string imsi, uint64 *key);
+    std::string key_to_imsi(uint64 key);
+    boost::mutex                user_mutex;
+    LTE_FDD_ENB_HSS_SUB_STRUCT *table;
+    void                       *table_mem;
+    size_t                      table_mem_size;
+    uint32                      N_slots;
+    uint32                      N_users;
 };
 
 #endif /* __LTE_FDD_ENB_HSS_H__ */
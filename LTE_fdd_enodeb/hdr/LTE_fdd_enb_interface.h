@@ -32,6 +32,18 @@
     05/04/2014    Ben Wojtowicz    Added PCAP support and more error types.
     06/15/2014    Ben Wojtowicz    Added new error causes, ... support for info
                                    messages, and using the latest LTE library.
+    10/19/2026    agent            Added no_rf loopback radio parameters and
+                                   processing time statistics.
+    10/19/2026    agent            Added the DL scheduling policy parameter.
+    10/19/2026    agent            Added the duplicate RLC PDU error.
+    10/19/2026    agent            Added the duplicate PDCP PDU error.
+    10/19/2026    agent            Added the cant open file and invalid
+                                   snapshot errors and the HSS commands.
+    10/19/2026    agent            Moved debug messages to per thread rings
+                                   drained by a formatter thread and added the
+                                   debug file and stats parameters.
+    10/19/2026    agent            Moved PCAP capture to LTE_fdd_enb_pcap and
+                                   added the PCAP parameters.
 
 *******************************************************************************/
 
@@ -46,6 +58,11 @@
 #include "libtools_socket_wrap.h"
 #include <boost/thread/mutex.hpp>
 #include <string>
+#include <time.h>
+#include <sys/time.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdarg.h>
 
 /*******************************************************************************
                               DEFINES
@@ -54,10 +71,23 @@
 #define LTE_FDD_ENB_DEFAULT_CTRL_PORT 30000
 #define LTE_FDD_ENB_DEBUG_PORT_OFFSET 1
 
+// Debug message rings, ring size must be a power of 2
+#define LTE_FDD_ENB_DEBUG_RING_SIZE     512
+#define LTE_FDD_ENB_DEBUG_MAX_RINGS     64
+#define LTE_FDD_ENB_DEBUG_MAX_MSG_SIZE  256
+#define LTE_FDD_ENB_DEBUG_MAX_ARGS      16
+#define LTE_FDD_ENB_DEBUG_MAX_STR_SIZE  256
+#define LTE_FDD_ENB_DEBUG_MAX_SPEC_SIZE 32
+#define LTE_FDD_ENB_DEBUG_MAX_HEX_SIZE  (LIBLTE_MAX_MSG_SIZE/8)
+#define LTE_FDD_ENB_DEBUG_BATCH_SIZE    65536
+#define LTE_FDD_ENB_DEBUG_IDLE_SLEEP_US 1000
+#define LTE_FDD_ENB_DEBUG_TSC_CAL_US    10000
+
 /*******************************************************************************
                               FORWARD DECLARATIONS
 *******************************************************************************/
 
+class LTE_fdd_enb_pcap;
 
 /*******************************************************************************
                               TYPEDEFS
@@ -85,6 +115,10 @@ typedef enum{
     LTE_FDD_ENB_ERROR_RB_ALREADY_SETUP,
     LTE_FDD_ENB_ERROR_TIMER_NOT_FOUND,
     LTE_FDD_ENB_ERROR_CANT_REASSEMBLE_SDU,
+    LTE_FDD_ENB_ERROR_DUPLICATE_RLC_PDU,
+    LTE_FDD_ENB_ERROR_DUPLICATE_PDCP_PDU,
+    LTE_FDD_ENB_ERROR_CANT_OPEN_FILE,
+    LTE_FDD_ENB_ERROR_INVALID_SNAPSHOT,
     LTE_FDD_ENB_ERROR_N_ITEMS,
 }LTE_FDD_ENB_ERROR_ENUM;
 static const char LTE_fdd_enb_error_text[LTE_FDD_ENB_ERROR_N_ITEMS][100] = {"none",
@@ -107,7 +141,11 @@ static const char LTE_fdd_enb_error_text[LTE_FDD_ENB_ERROR_N_ITEMS][100] = {"non
                                                                             "RB not setup",
                                                                             "RB already setup",
                                                                             "timer not found",
-                                                                            "cant reassemble SDU"};
+                                                                            "cant reassemble SDU",
+                                                                            "duplicate RLC PDU",
+                                                                            "duplicate PDCP PDU",
+                                                                            "cant open file",
+                                                                            "invalid snapshot"};
 
 typedef enum{
     LTE_FDD_ENB_DEBUG_TYPE_ERROR = 0,
@@ -200,6 +238,20 @@ typedef enum{
     LTE_FDD_ENB_PARAM_DEBUG_TYPE,
     LTE_FDD_ENB_PARAM_DEBUG_LEVEL,
     LTE_FDD_ENB_PARAM_ENABLE_PCAP,
+    LTE_FDD_ENB_PARAM_DL_SCHED_POLICY,
+
+    // Debug parameters managed by LTE_fdd_enb_interface
+    LTE_FDD_ENB_PARAM_DEBUG_FILE,
+    LTE_FDD_ENB_PARAM_DEBUG_STATS,
+
+    // PCAP parameters managed by LTE_fdd_enb_pcap
+    LTE_FDD_ENB_PARAM_PCAP_FILE,
+    LTE_FDD_ENB_PARAM_PCAP_FORMAT,
+    LTE_FDD_ENB_PARAM_PCAP_MAX_FILE_SIZE,
+    LTE_FDD_ENB_PARAM_PCAP_MAX_FILE_SECS,
+    LTE_FDD_ENB_PARAM_PCAP_MAX_FILES,
+    LTE_FDD_ENB_PARAM_PCAP_RING_SECS,
+    LTE_FDD_ENB_PARAM_PCAP_STATS,
 
     // Radio parameters managed by LTE_fdd_enb_radio
     LTE_FDD_ENB_PARAM_AVAILABLE_RADIOS,
@@ -207,6 +259,10 @@ typedef enum{
     LTE_FDD_ENB_PARAM_SELECTED_RADIO_IDX,
     LTE_FDD_ENB_PARAM_TX_GAIN,
     LTE_FDD_ENB_PARAM_RX_GAIN,
+    LTE_FDD_ENB_PARAM_NO_RF_SPEEDUP,
+    LTE_FDD_ENB_PARAM_NO_RF_UL_FILE,
+    LTE_FDD_ENB_PARAM_NO_RF_PRACH_PERIOD,
+    LTE_FDD_ENB_PARAM_NO_RF_STATS,
 
     LTE_FDD_ENB_PARAM_N_ITEMS,
 }LTE_FDD_ENB_PARAM_ENUM;
@@ -246,11 +302,25 @@ static const char lte_fdd_enb_param_text[LTE_FDD_ENB_PARAM_N_ITEMS][100] = {"ban
                                                                             "debug_type",
                                                                             "debug_level",
                                                                             "enable_pcap",
+                                                                            "dl_sched_policy",
+                                                                            "debug_file",
+                                                                            "debug_stats",
+                                                                            "pcap_file",
+                                                                            "pcap_format",
+                                                                            "pcap_max_file_size",
+                                                                            "pcap_max_file_secs",
+                                                                            "pcap_max_files",
+                                                                            "pcap_ring_secs",
+                                                                            "pcap_stats",
                                                                             "available_radios",
                                                                             "selected_radio_name",
                                                                             "selected_radio_idx",
                                                                             "tx_gain",
-                                                                            "rx_gain"};
+                                                                            "rx_gain",
+                                                                            "no_rf_speedup",
+                                                                            "no_rf_ul_file",
+                                                                            "no_rf_prach_period",
+                                                                            "no_rf_stats"};
 
 typedef struct{
     LTE_FDD_ENB_VAR_TYPE_ENUM var_type;
@@ -263,6 +333,48 @@ typedef struct{
     bool                      dynamic;
 }LTE_FDD_ENB_VAR_STRUCT;
 
+typedef struct{
+    uint64 N_runs;
+    uint64 total_ns;
+    uint64 max_ns;
+}LTE_FDD_ENB_PROC_TIME_STRUCT;
+
+// Debug message argument, strings are copied into the record and stored
+// as an offset
+typedef union{
+    uint64 int_val;
+    double double_val;
+}LTE_FDD_ENB_DEBUG_ARG_UNION;
+
+// Debug message record, the format string and arguments are stored raw and
+// only formatted by the formatter thread
+typedef struct{
+    uint64                       tsc;
+    const char                  *file_name;
+    const char                  *fmt;
+    int32                        line;
+    LTE_FDD_ENB_DEBUG_TYPE_ENUM  type;
+    LTE_FDD_ENB_DEBUG_LEVEL_ENUM level;
+    uint32                       N_args;
+    uint32                       N_str;
+    uint32                       N_hex;
+    uint32                       N_hex_bytes;
+    bool                         hex_present;
+    bool                         hex_truncated;
+    LTE_FDD_ENB_DEBUG_ARG_UNION  arg[LTE_FDD_ENB_DEBUG_MAX_ARGS];
+    char                         str[LTE_FDD_ENB_DEBUG_MAX_STR_SIZE];
+    uint8                        hex[LTE_FDD_ENB_DEBUG_MAX_HEX_SIZE];
+}LTE_FDD_ENB_DEBUG_RECORD_STRUCT;
+
+typedef struct{
+    LTE_FDD_ENB_DEBUG_RECORD_STRUCT record[LTE_FDD_ENB_DEBUG_RING_SIZE];
+    volatile uint32                 write_idx;
+    volatile uint32                 read_idx;
+    volatile uint32                 N_dropped;
+    volatile uint32                 released;
+    uint32                          N_dropped_reported;
+}LTE_FDD_ENB_DEBUG_RING_STRUCT;
+
 /*******************************************************************************
                               CLASS DECLARATIONS
 *******************************************************************************/
@@ -281,10 +393,10 @@ public:
     void send_ctrl_msg(std::string msg);
     void send_ctrl_info_msg(std::string msg, ...);
     void send_ctrl_error_msg(LTE_FDD_ENB_ERROR_ENUM error, std::string msg);
-    void send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ENUM type, LTE_FDD_ENB_DEBUG_LEVEL_ENUM level, std::string file_name, int32 line, std::string msg, ...);
-    void send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ENUM type, LTE_FDD_ENB_DEBUG_LEVEL_ENUM level, std::string file_name, int32 line, LIBLTE_BIT_MSG_STRUCT *lte_msg, std::string msg, ...);
-    void send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ENUM type, LTE_FDD_ENB_DEBUG_LEVEL_ENUM level, std::string file_name, int32 line, LIBLTE_BYTE_MSG_STRUCT *lte_msg, std::string msg, ...);
-    void open_pcap_fd(void);
+    // NOTE: file_name and msg are stored by pointer and must be string literals
+    void send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ENUM type, LTE_FDD_ENB_DEBUG_LEVEL_ENUM level, const char *file_name, int32 line, const char *msg, ...);
+    void send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ENUM type, LTE_FDD_ENB_DEBUG_LEVEL_ENUM level, const char *file_name, int32 line, LIBLTE_BIT_MSG_STRUCT *lte_msg, const char *msg, ...);
+    void send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ENUM type, LTE_FDD_ENB_DEBUG_LEVEL_ENUM level, const char *file_name, int32 line, LIBLTE_BYTE_MSG_STRUCT *lte_msg, const char *msg, ...);
     void send_pcap_msg(LTE_FDD_ENB_PCAP_DIRECTION_ENUM dir, uint32 rnti, uint32 current_tti, uint8 *msg, uint32 N_bits);
     static void handle_ctrl_msg(std::string msg);
     static void handle_ctrl_connect(void);
@@ -296,7 +408,6 @@ public:
     static void handle_debug_error(LIBTOOLS_SOCKET_WRAP_ERROR_ENUM err);
     boost::mutex          ctrl_mutex;
     boost::mutex          debug_mutex;
-    FILE                 *pcap_fd;
     libtools_socket_wrap *ctrl_socket;
     libtools_socket_wrap *debug_socket;
     int16                 ctrl_port;
@@ -307,6 +418,13 @@ public:
     // Get/Set
     bool get_shutdown(void);
     bool app_is_started(void);
+    std::string get_debug_file(void);
+    LTE_FDD_ENB_ERROR_ENUM set_debug_file(std::string file_name);
+    std::string get_debug_stats(void);
+
+    // Processing time
+    static void reset_proc_time(LTE_FDD_ENB_PROC_TIME_STRUCT *proc_time);
+    static void update_proc_time(LTE_FDD_ENB_PROC_TIME_STRUCT *proc_time, struct timespec *start_time);
 
 private:
     // Singleton
@@ -319,10 +437,44 @@ private:
     void handle_write(std::string msg);
     void handle_start(void);
     void handle_stop(void);
+    void handle_hss_cmd(std::string msg);
+    void handle_pcap_dump(void);
     void handle_help(void);
 
+    // Debug rings
+    static void* debug_thread_func(void *inputs);
+    static void debug_ring_release(void *ring);
+    static uint64 debug_get_tsc(void);
+    static void debug_store_args(LTE_FDD_ENB_DEBUG_RECORD_STRUCT *record, const char *fmt, va_list args);
+    bool debug_is_enabled(LTE_FDD_ENB_DEBUG_TYPE_ENUM type, LTE_FDD_ENB_DEBUG_LEVEL_ENUM level);
+    LTE_FDD_ENB_DEBUG_RECORD_STRUCT* debug_start_record(LTE_FDD_ENB_DEBUG_TYPE_ENUM type, LTE_FDD_ENB_DEBUG_LEVEL_ENUM level, const char *file_name, int32 line, const char *msg, va_list args);
+    void debug_commit_record(LTE_FDD_ENB_DEBUG_RECORD_STRUCT *record);
+    LTE_FDD_ENB_DEBUG_RING_STRUCT* debug_get_ring(void);
+    bool debug_drain_rings(void);
+    void debug_calibrate_tsc(void);
+    void debug_format_record(LTE_FDD_ENB_DEBUG_RECORD_STRUCT *record);
+    void debug_format_msg(LTE_FDD_ENB_DEBUG_RECORD_STRUCT *record);
+    void debug_flush_batch(void);
+    static __thread LTE_FDD_ENB_DEBUG_RING_STRUCT *debug_ring;
+    LTE_FDD_ENB_DEBUG_RING_STRUCT                 *debug_rings[LTE_FDD_ENB_DEBUG_MAX_RINGS];
+    volatile uint32                                N_debug_rings;
+    volatile uint32                                N_debug_unregistered_dropped;
+    uint64                                         N_debug_records;
+    struct timeval                                 debug_time_base;
+    uint64                                         debug_tsc_base;
+    double                                         debug_tsc_per_us;
+    boost::mutex                                   debug_ring_mutex;
+    pthread_key_t                                  debug_ring_key;
+    pthread_t                                      debug_thread;
+    volatile bool                                  debug_thread_stop;
+    boost::mutex                                   debug_file_mutex;
+    std::string                                    debug_file_name;
+    FILE                                          *debug_file;
+    std::string                                    debug_batch;
+
     // Variables
     std::map<std::string, LTE_FDD_ENB_VAR_STRUCT> var_map;
+    LTE_fdd_enb_pcap                             *pcap;
     boost::mutex                                  start_mutex;
     uint32                                        debug_type_mask;
     uint32                                        debug_level_mask;
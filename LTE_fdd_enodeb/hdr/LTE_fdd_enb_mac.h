@@ -29,6 +29,16 @@
     05/04/2014    Ben Wojtowicz    Added ULSCH handling.
     06/15/2014    Ben Wojtowicz    Added uplink scheduling and changed fn_combo
                                    to current_tti.
+    10/19/2026    agent            Added scheduler processing time statistics.
+    10/19/2026    agent            Replaced the scheduling queues with TTI
+                                   indexed calendars of preallocated entries.
+    10/19/2026    agent            Added round robin, max C/I, and
+                                   proportional fair DL scheduling with PRB
+                                   bitmaps and a PDCCH CCE budget.
+    10/19/2026    agent            Added BSR driven UL scheduling with grants
+                                   packed across users.
+    10/19/2026    agent            Only copying the system information when
+                                   its version changes.
 
 *******************************************************************************/
 
@@ -43,15 +53,45 @@
 #include "LTE_fdd_enb_cnfg_db.h"
 #include "LTE_fdd_enb_msgq.h"
 #include "LTE_fdd_enb_user.h"
+#include "LTE_fdd_enb_sched_policy.h"
 #include "liblte_mac.h"
 #include <boost/thread/mutex.hpp>
 #include <boost/interprocess/ipc/message_queue.hpp>
-#include <list>
+#include <set>
 
 /*******************************************************************************
                               DEFINES
 *******************************************************************************/
 
+// Scheduling calendar, N_TTIS must be a power of 2 that divides
+// LTE_FDD_ENB_CURRENT_TTI_MAX+1 and covers the RAR response window
+#define LTE_FDD_ENB_MAC_SCHED_N_TTIS         32
+#define LTE_FDD_ENB_MAC_SCHED_BUCKET_SIZE    LIBLTE_PHY_PDCCH_MAX_ALLOC
+#define LTE_FDD_ENB_MAC_SCHED_MAX_DEFER_TTIS 8
+#define LTE_FDD_ENB_MAC_SCHED_N_RAR_ENTRIES  32
+#define LTE_FDD_ENB_MAC_SCHED_N_DL_ENTRIES   64
+#define LTE_FDD_ENB_MAC_SCHED_N_UL_ENTRIES   64
+#define LTE_FDD_ENB_MAC_SCHED_MAX_N_ENTRIES  64
+
+// PDCCH budget, all DCIs are sent at aggregation level 4 in the common
+// search space
+#define LTE_FDD_ENB_MAC_DCI_N_CCES 4
+#define LTE_FDD_ENB_MAC_CSS_N_CCES 16
+
+// PRB bitmap, enough 32 bit words for 100 PRBs
+#define LTE_FDD_ENB_MAC_PRB_MAP_N_WORDS 4
+
+// Approximate number of PDSCH resource elements per PRB per subframe
+#define LTE_FDD_ENB_MAC_N_RE_PER_PRB 120
+
+// Metric for allocations that don't belong to a user yet
+#define LTE_FDD_ENB_MAC_MAX_SCHED_METRIC 1e9
+
+// UL grants, PUSCH is always decoded as QPSK so the MCS is capped at the
+// highest QPSK MCS (36.213 table 8.6.1-1)
+#define LTE_FDD_ENB_MAC_UL_MAX_MCS         10
+#define LTE_FDD_ENB_MAC_UL_MIN_GRANT_BITS  56
+#define LTE_FDD_ENB_MAC_UL_HEADER_OVERHEAD 3 // Bytes of MAC header per grant
 
 /*******************************************************************************
                               FORWARD DECLARATIONS
@@ -67,19 +107,58 @@ typedef struct{
     LIBLTE_PHY_ALLOCATION_STRUCT ul_alloc;
     LIBLTE_MAC_RAR_STRUCT        rar;
     uint32                       current_tti;
+    uint32                       expiry_tti;
 }LTE_FDD_ENB_RAR_SCHED_QUEUE_STRUCT;
 
+// The MAC PDU is built in place in a pool entry that shares the index of its
+// calendar entry, so queueing it never copies the PDU
 typedef struct{
-    LIBLTE_PHY_ALLOCATION_STRUCT alloc;
-    LIBLTE_MAC_PDU_STRUCT        mac_pdu;
-    uint32                       current_tti;
+    LIBLTE_PHY_ALLOCATION_STRUCT  alloc;
+    LIBLTE_MAC_PDU_STRUCT        *mac_pdu;
+    uint32                        current_tti;
+    uint32                        expiry_tti;
 }LTE_FDD_ENB_DL_SCHED_QUEUE_STRUCT;
 
 typedef struct{
     LIBLTE_PHY_ALLOCATION_STRUCT alloc;
     uint32                       current_tti;
+    uint32                       expiry_tti;
 }LTE_FDD_ENB_UL_SCHED_QUEUE_STRUCT;
 
+typedef struct{
+    uint32 entry[LTE_FDD_ENB_MAC_SCHED_BUCKET_SIZE];
+    uint32 N_entries;
+}LTE_FDD_ENB_SCHED_BUCKET_STRUCT;
+
+typedef struct{
+    float  metric;
+    uint32 entry;
+}LTE_FDD_ENB_SCHED_CANDIDATE_STRUCT;
+
+// Lowest SINR in dB at which each CQI index is reported, used to estimate
+// the DL CQI from the PUSCH SINR until CQI reports are decoded
+static const float LTE_fdd_enb_mac_cqi_sinr_db[16] = {-100.0,  -6.7,  -4.7,  -2.3,
+                                                         0.2,   2.4,   4.3,   5.9,
+                                                         8.1,  10.3,  11.7,  14.1,
+                                                        16.3,  18.7,  21.0,  22.7};
+
+// Upper bound of each BSR buffer size index in bytes (36.321 table 6.1.3.1-1)
+static const uint32 LTE_fdd_enb_mac_bsr_buffer_size[64] = {     0,     10,     12,     14,     17,     19,     22,     26,
+                                                              31,     36,     42,     49,     57,     67,     78,     91,
+                                                             107,    125,    146,    171,    200,    234,    274,    321,
+                                                             376,    440,    515,    603,    706,    826,    967,   1132,
+                                                            1326,   1552,   1817,   2127,   2490,   2915,   3413,   3995,
+                                                            4677,   5476,   6411,   7505,   8787,  10287,  12043,  14099,
+                                                           16507,  19325,  22624,  26487,  31009,  36304,  42502,  49759,
+                                                           58255,  68201,  79864,  93479, 109439, 128125, 150000, 150000};
+
+typedef struct{
+    LTE_FDD_ENB_SCHED_BUCKET_STRUCT bucket[LTE_FDD_ENB_MAC_SCHED_N_TTIS];
+    uint32                          free_entry[LTE_FDD_ENB_MAC_SCHED_MAX_N_ENTRIES];
+    uint32                          N_free;
+    uint32                          N_entries;
+}LTE_FDD_ENB_SCHED_CALENDAR_STRUCT;
+
 /*******************************************************************************
                               CLASS DECLARATIONS
 *******************************************************************************/
@@ -98,6 +177,8 @@ public:
     // External interface
     void update_sys_info(void);
     void sched_ul(LTE_fdd_enb_user *user, uint32 requested_tbs);
+    void add_ul_sched_user(uint16 rnti);
+    LTE_FDD_ENB_PROC_TIME_STRUCT get_sched_proc_time(void);
 
 private:
     // Singleton
@@ -143,25 +224,62 @@ private:
     // Scheduler
     void scheduler(void);
     LTE_FDD_ENB_ERROR_ENUM add_to_rar_sched_queue(uint32 current_tti, LIBLTE_PHY_ALLOCATION_STRUCT *dl_alloc, LIBLTE_PHY_ALLOCATION_STRUCT *ul_alloc, LIBLTE_MAC_RAR_STRUCT *rar);
-    LTE_FDD_ENB_ERROR_ENUM add_to_dl_sched_queue(uint32 current_tti, LIBLTE_MAC_PDU_STRUCT *mac_pdu, LIBLTE_PHY_ALLOCATION_STRUCT *alloc);
+    LIBLTE_MAC_PDU_STRUCT* get_dl_sched_mac_pdu(uint32 *idx);
+    LTE_FDD_ENB_ERROR_ENUM add_to_dl_sched_queue(uint32 current_tti, uint32 idx, LIBLTE_PHY_ALLOCATION_STRUCT *alloc);
     LTE_FDD_ENB_ERROR_ENUM add_to_ul_sched_queue(uint32 current_tti, LIBLTE_PHY_ALLOCATION_STRUCT *alloc);
-    boost::mutex                                   rar_sched_queue_mutex;
-    boost::mutex                                   dl_sched_queue_mutex;
-    boost::mutex                                   ul_sched_queue_mutex;
-    std::list<LTE_FDD_ENB_RAR_SCHED_QUEUE_STRUCT*> rar_sched_queue;
-    std::list<LTE_FDD_ENB_DL_SCHED_QUEUE_STRUCT*>  dl_sched_queue;
-    std::list<LTE_FDD_ENB_UL_SCHED_QUEUE_STRUCT*>  ul_sched_queue;
-    LTE_FDD_ENB_DL_SCHEDULE_MSG_STRUCT             sched_dl_subfr[10];
-    LTE_FDD_ENB_UL_SCHEDULE_MSG_STRUCT             sched_ul_subfr[10];
-    uint8                                          sched_cur_dl_subfn;
-    uint8                                          sched_cur_ul_subfn;
+    void expire_sched_queues(uint32 current_tti);
+    boost::mutex                       rar_sched_queue_mutex;
+    boost::mutex                       dl_sched_queue_mutex;
+    boost::mutex                       ul_sched_queue_mutex;
+    LTE_FDD_ENB_SCHED_CALENDAR_STRUCT  rar_sched_queue;
+    LTE_FDD_ENB_SCHED_CALENDAR_STRUCT  dl_sched_queue;
+    LTE_FDD_ENB_SCHED_CALENDAR_STRUCT  ul_sched_queue;
+    LTE_FDD_ENB_RAR_SCHED_QUEUE_STRUCT rar_sched_entry[LTE_FDD_ENB_MAC_SCHED_N_RAR_ENTRIES];
+    LTE_FDD_ENB_DL_SCHED_QUEUE_STRUCT  dl_sched_entry[LTE_FDD_ENB_MAC_SCHED_N_DL_ENTRIES];
+    LIBLTE_MAC_PDU_STRUCT              dl_sched_mac_pdu[LTE_FDD_ENB_MAC_SCHED_N_DL_ENTRIES];
+    LTE_FDD_ENB_UL_SCHED_QUEUE_STRUCT  ul_sched_entry[LTE_FDD_ENB_MAC_SCHED_N_UL_ENTRIES];
+    LTE_FDD_ENB_DL_SCHEDULE_MSG_STRUCT sched_dl_subfr[10];
+    LTE_FDD_ENB_UL_SCHEDULE_MSG_STRUCT sched_ul_subfr[10];
+    uint8                              sched_cur_dl_subfn;
+    uint8                              sched_cur_ul_subfn;
+    volatile uint32                    sched_dl_current_tti;
+    volatile uint32                    sched_ul_current_tti;
+    LTE_FDD_ENB_PROC_TIME_STRUCT       sched_proc_time;
+    boost::mutex                       ul_sched_users_mutex;
+    std::set<uint16>                   ul_sched_users;
+
+    // Scheduling calendar
+    void sched_cal_init(LTE_FDD_ENB_SCHED_CALENDAR_STRUCT *cal, uint32 N_entries);
+    void sched_cal_publish_tti(void);
+    uint32 sched_cal_get_dl_tti(void);
+    uint32 sched_cal_get_ul_tti(void);
+    int32 sched_cal_tti_diff(uint32 cal_tti, uint32 current_tti);
+    uint32 sched_cal_tti(uint32 cal_tti, int32 diff);
+    bool sched_cal_alloc(LTE_FDD_ENB_SCHED_CALENDAR_STRUCT *cal, uint32 *idx);
+    void sched_cal_free(LTE_FDD_ENB_SCHED_CALENDAR_STRUCT *cal, uint32 idx);
+    uint32 sched_cal_take(LTE_FDD_ENB_SCHED_CALENDAR_STRUCT *cal, uint32 current_tti, uint32 *entries);
+    uint32 sched_cal_defer(LTE_FDD_ENB_SCHED_CALENDAR_STRUCT *cal, uint32 current_tti, uint32 *entries, uint32 N_entries);
 
     // Parameters
     boost::mutex                sys_info_mutex;
     LTE_FDD_ENB_SYS_INFO_STRUCT sys_info;
+    uint32                      sys_info_version;
+
+    // Scheduling policy
+    LTE_fdd_enb_dl_sched_policy *dl_sched_policy[LTE_FDD_ENB_DL_SCHED_POLICY_N_ITEMS];
+    LTE_fdd_enb_dl_sched_policy* get_dl_sched_policy(void);
+    float get_dl_sched_metric(uint16 rnti, uint32 current_tti);
+    uint8 get_dl_cqi_estimate(float sinr_db);
+    void sort_sched_candidates(LTE_FDD_ENB_SCHED_CANDIDATE_STRUCT *candidates, uint32 N_candidates);
+    bool get_ul_grant_size(uint32 N_bits, uint32 N_avail_prbs, uint32 *tbs, uint8 *mcs, uint32 *N_prb);
+
+    // PRB bitmap
+    void prb_map_set(uint32 *prb_map, uint32 start, uint32 N_prb);
+    bool prb_map_find(uint32 *prb_map, uint32 N_rb, uint32 N_prb, uint32 *start);
 
     // Helpers
     uint32 get_n_reserved_prbs(uint32 current_tti);
+    void get_sys_info_resources(uint32 current_tti, uint32 *N_prbs, uint32 *N_dcis);
 };
 
 #endif /* __LTE_FDD_ENB_MAC_H__ */
@@ -27,6 +27,8 @@
     11/09/2013    Ben Wojtowicz    Created file
     01/18/2014    Ben Wojtowicz    Added an explicit include for boost mutexes.
     06/15/2014    Ben Wojtowicz    Added RRC NAS message handler.
+    10/19/2026    agent            Only copying the system information when
+                                   its version changes.
 
 *******************************************************************************/
 
@@ -96,6 +98,7 @@ private:
     // Parameters
     boost::mutex                sys_info_mutex;
     LTE_FDD_ENB_SYS_INFO_STRUCT sys_info;
+    uint32                      sys_info_version;
 };
 
 #endif /* __LTE_FDD_ENB_MME_H__ */
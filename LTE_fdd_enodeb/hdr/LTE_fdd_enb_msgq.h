@@ -93,6 +93,9 @@ typedef enum{
     // PDCP -> RRC Messages
     LTE_FDD_ENB_MESSAGE_TYPE_RRC_PDU_READY,
 
+    // RLC -> RRC Messages
+    LTE_FDD_ENB_MESSAGE_TYPE_RRC_RADIO_LINK_FAILURE,
+
     // MME -> RRC Messages
     LTE_FDD_ENB_MESSAGE_TYPE_RRC_NAS_MSG_READY,
 
@@ -114,6 +117,7 @@ static const char LTE_fdd_enb_message_type_text[LTE_FDD_ENB_MESSAGE_TYPE_N_ITEMS
                                                                                           "PDCP pdu ready",
                                                                                           "PDCP sdu ready",
                                                                                           "RRC pdu ready",
+                                                                                          "RRC radio link failure",
                                                                                           "RRC NAS message ready",
                                                                                           "MME NAS message ready"};
 
@@ -170,6 +174,7 @@ typedef struct{
 typedef struct{
     LIBLTE_BIT_MSG_STRUCT msg;
     uint32                current_tti;
+    float                 sinr_db;
     uint16                rnti;
 }LTE_FDD_ENB_PUSCH_DECODE_MSG_STRUCT;
 
@@ -209,6 +214,12 @@ typedef struct{
     LTE_fdd_enb_rb   *rb;
 }LTE_FDD_ENB_RRC_PDU_READY_MSG_STRUCT;
 
+// RLC -> RRC Messages
+typedef struct{
+    LTE_fdd_enb_user *user;
+    LTE_fdd_enb_rb   *rb;
+}LTE_FDD_ENB_RRC_RADIO_LINK_FAILURE_MSG_STRUCT;
+
 // MME -> RRC Messages
 typedef struct{
     LTE_fdd_enb_user *user;
@@ -252,6 +263,9 @@ typedef union{
     // PDCP -> RRC Messages
     LTE_FDD_ENB_RRC_PDU_READY_MSG_STRUCT rrc_pdu_ready;
 
+    // RLC -> RRC Messages
+    LTE_FDD_ENB_RRC_RADIO_LINK_FAILURE_MSG_STRUCT rrc_radio_link_failure;
+
     // MME -> RRC Messages
     LTE_FDD_ENB_RRC_NAS_MSG_READY_MSG_STRUCT rrc_nas_msg_ready;
 
@@ -259,10 +273,13 @@ typedef union{
     LTE_FDD_ENB_MME_NAS_MSG_READY_MSG_STRUCT mme_nas_msg_ready;
 }LTE_FDD_ENB_MESSAGE_UNION;
 
+// Each message pins an epoch until it is handled so that the objects it
+// points to are not freed while it is queued
 typedef struct{
     LTE_FDD_ENB_MESSAGE_TYPE_ENUM type;
     LTE_FDD_ENB_DEST_LAYER_ENUM   dest_layer;
     LTE_FDD_ENB_MESSAGE_UNION     msg;
+    uint64                        epoch;
 }LTE_FDD_ENB_MESSAGE_STRUCT;
 
 /*******************************************************************************
@@ -308,6 +325,8 @@ public:
                      LTE_FDD_ENB_DEST_LAYER_ENUM         dest_layer,
                      LTE_FDD_ENB_MESSAGE_UNION          *msg_content,
                      uint32                              msg_content_size);
+    static void forward(boost::interprocess::message_queue *mq,
+                        LTE_FDD_ENB_MESSAGE_STRUCT         *msg);
 private:
     // Send/Receive
     static void* receive_thread(void *inputs);
@@ -0,0 +1,191 @@
+/*******************************************************************************
+
+    Copyright 2026 agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: LTE_fdd_enb_pcap.h
+
+    Description: Contains all the definitions for the LTE FDD eNodeB PCAP
+                 capture.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    agent            Created file
+
+*******************************************************************************/
+
+#ifndef __LTE_FDD_ENB_PCAP_H__
+#define __LTE_FDD_ENB_PCAP_H__
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "LTE_fdd_enb_interface.h"
+#include "typedefs.h"
+#include <boost/thread/mutex.hpp>
+#include <pthread.h>
+#include <string>
+#include <deque>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+#define LTE_FDD_ENB_PCAP_QUEUE_SIZE       1024 // Must be a power of 2
+#define LTE_FDD_ENB_PCAP_MAX_PAYLOAD_SIZE (LIBLTE_MAX_MSG_SIZE/8)
+#define LTE_FDD_ENB_PCAP_CONTEXT_SIZE     15
+#define LTE_FDD_ENB_PCAP_BATCH_SIZE       262144
+#define LTE_FDD_ENB_PCAP_FLUSH_PERIOD_NS  100000000
+#define LTE_FDD_ENB_PCAP_IDLE_SLEEP_US    1000
+#define LTE_FDD_ENB_PCAP_REANCHOR_TTIS    1000
+#define LTE_FDD_ENB_PCAP_DLT_MAC_LTE      147
+#define LTE_FDD_ENB_PCAP_DEFAULT_FILE     "/tmp/LTE_fdd_enodeb.pcap"
+
+/*******************************************************************************
+                              FORWARD DECLARATIONS
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+typedef enum{
+    LTE_FDD_ENB_PCAP_FORMAT_PCAP = 0,
+    LTE_FDD_ENB_PCAP_FORMAT_PCAPNG,
+    LTE_FDD_ENB_PCAP_FORMAT_N_ITEMS,
+}LTE_FDD_ENB_PCAP_FORMAT_ENUM;
+static const char LTE_fdd_enb_pcap_format_text[LTE_FDD_ENB_PCAP_FORMAT_N_ITEMS][20] = {"pcap",
+                                                                                       "pcapng"};
+
+typedef struct{
+    uint64                          time_ns;
+    uint32                          rnti;
+    uint32                          current_tti;
+    uint32                          N_bytes;
+    LTE_FDD_ENB_PCAP_DIRECTION_ENUM dir;
+    uint8                           payload[LTE_FDD_ENB_PCAP_MAX_PAYLOAD_SIZE];
+}LTE_FDD_ENB_PCAP_RECORD_STRUCT;
+
+typedef struct{
+    volatile uint64                seq;
+    LTE_FDD_ENB_PCAP_RECORD_STRUCT record;
+}LTE_FDD_ENB_PCAP_SLOT_STRUCT;
+
+typedef struct{
+    std::string packet;
+    uint64      time_ns;
+}LTE_FDD_ENB_PCAP_RING_ENTRY_STRUCT;
+
+typedef struct{
+    uint64 N_records;
+    uint64 N_bytes;
+    uint32 N_dropped;
+    uint32 N_files;
+    uint32 N_write_errors;
+}LTE_FDD_ENB_PCAP_STATS_STRUCT;
+
+/*******************************************************************************
+                              CLASS DECLARATIONS
+*******************************************************************************/
+
+class LTE_fdd_enb_pcap
+{
+public:
+    // Singleton
+    static LTE_fdd_enb_pcap* get_instance(void);
+    static void cleanup(void);
+
+    // Capture
+    void send(LTE_FDD_ENB_PCAP_DIRECTION_ENUM dir, uint32 rnti, uint32 current_tti, uint8 *msg, uint32 N_bits);
+    LTE_FDD_ENB_ERROR_ENUM dump_ring(std::string *file_name);
+
+    // External interface
+    void set_enable(bool enable);
+    std::string get_file(void);
+    LTE_FDD_ENB_ERROR_ENUM set_file(std::string file_name);
+    LTE_FDD_ENB_PCAP_FORMAT_ENUM get_format(void);
+    LTE_FDD_ENB_ERROR_ENUM set_format(std::string format);
+    uint32 get_max_file_size(void);
+    void set_max_file_size(uint32 size);
+    uint32 get_max_file_secs(void);
+    void set_max_file_secs(uint32 secs);
+    uint32 get_max_files(void);
+    void set_max_files(uint32 N_files);
+    uint32 get_ring_secs(void);
+    void set_ring_secs(uint32 secs);
+    std::string get_stats(void);
+
+private:
+    // Singleton
+    static LTE_fdd_enb_pcap *instance;
+    LTE_fdd_enb_pcap();
+    ~LTE_fdd_enb_pcap();
+
+    // Producer queue
+    LTE_FDD_ENB_PCAP_SLOT_STRUCT *queue;
+    volatile uint64               enqueue_pos;
+    uint64                        dequeue_pos;
+    volatile bool                 enabled;
+
+    // Writer thread
+    static void* writer_thread_func(void *inputs);
+    bool drain_queue(void);
+    uint64 get_tti_time(LTE_FDD_ENB_PCAP_RECORD_STRUCT *record);
+    uint32 build_packet(LTE_FDD_ENB_PCAP_RECORD_STRUCT *record, uint8 *packet);
+    void encode_file_header(std::string *buf, LTE_FDD_ENB_PCAP_FORMAT_ENUM fmt);
+    void encode_packet(std::string *buf, LTE_FDD_ENB_PCAP_FORMAT_ENUM fmt, uint64 time_ns, uint8 *packet, uint32 N_bytes);
+    void open_file(void);
+    void close_file(void);
+    void flush_batch(void);
+    void check_rotation(void);
+    void trim_ring(uint64 now_ns, uint32 window_secs);
+    LTE_fdd_enb_interface       *interface;
+    pthread_t                    writer_thread;
+    volatile bool                writer_thread_stop;
+    std::string                  batch;
+    int32                        fd;
+    uint64                       file_bytes;
+    uint64                       file_open_ns;
+    uint64                       last_flush_ns;
+    uint32                       file_idx;
+    LTE_FDD_ENB_PCAP_FORMAT_ENUM file_format;
+    uint64                       anchor_ns;
+    uint32                       anchor_tti;
+    bool                         anchor_valid;
+
+    // Configuration
+    boost::mutex                 cnfg_mutex;
+    std::string                  file_name;
+    LTE_FDD_ENB_PCAP_FORMAT_ENUM format;
+    uint32                       max_file_size;
+    uint32                       max_file_secs;
+    uint32                       max_files;
+    uint32                       ring_secs;
+    bool                         reopen;
+
+    // Ring capture
+    boost::mutex                                   ring_mutex;
+    std::deque<LTE_FDD_ENB_PCAP_RING_ENTRY_STRUCT> ring;
+    uint32                                         N_dumps;
+
+    // Statistics
+    LTE_FDD_ENB_PCAP_STATS_STRUCT stats;
+};
+
+#endif /* __LTE_FDD_ENB_PCAP_H__ */
@@ -26,6 +26,10 @@
     ----------    -------------    --------------------------------------------
     11/09/2013    Ben Wojtowicz    Created file
     05/04/2014    Ben Wojtowicz    Added communication to RLC and RRC.
+    10/19/2026    agent            Added SRB/DRB data plane procedures and a
+                                   batched security callback.
+    10/19/2026    agent            Only copying the system information when
+                                   its version changes.
 
 *******************************************************************************/
 
@@ -38,6 +42,7 @@
 
 #include "LTE_fdd_enb_cnfg_db.h"
 #include "LTE_fdd_enb_msgq.h"
+#include "liblte_pdcp.h"
 #include <boost/thread/mutex.hpp>
 #include <boost/interprocess/ipc/message_queue.hpp>
 
@@ -45,6 +50,8 @@
                               DEFINES
 *******************************************************************************/
 
+// Maximum number of PDUs or SDUs handed to the security callback at once
+#define LTE_FDD_ENB_PDCP_MAX_BATCH_SIZE 16
 
 /*******************************************************************************
                               FORWARD DECLARATIONS
@@ -55,11 +62,55 @@
                               TYPEDEFS
 *******************************************************************************/
 
+typedef enum{
+    LTE_FDD_ENB_PDCP_SEC_OP_PROTECT = 0,
+    LTE_FDD_ENB_PDCP_SEC_OP_UNPROTECT,
+    LTE_FDD_ENB_PDCP_SEC_OP_N_ITEMS,
+}LTE_FDD_ENB_PDCP_SEC_OP_ENUM;
+static const char LTE_fdd_enb_pdcp_sec_op_text[LTE_FDD_ENB_PDCP_SEC_OP_N_ITEMS][20] = {"Protect",
+                                                                                       "Unprotect"};
+
+typedef struct{
+    LIBLTE_BIT_MSG_STRUCT data;
+    uint32                mac_i;
+    uint32                count;
+    uint16                sn;
+    bool                  valid;
+}LTE_FDD_ENB_PDCP_SEC_PDU_STRUCT;
+
+// PROTECT:   compute MAC-I (if integrity) then cipher data (DL)
+// UNPROTECT: decipher data then verify MAC-I (if integrity) and set valid (UL)
+typedef struct{
+    LTE_FDD_ENB_PDCP_SEC_PDU_STRUCT  pdu[LTE_FDD_ENB_PDCP_MAX_BATCH_SIZE];
+    LTE_fdd_enb_user                *user;
+    LTE_fdd_enb_rb                  *rb;
+    LTE_FDD_ENB_PDCP_SEC_OP_ENUM     op;
+    uint32                           N_pdus;
+    bool                             integrity;
+}LTE_FDD_ENB_PDCP_SEC_BATCH_STRUCT;
 
 /*******************************************************************************
                               CLASS DECLARATIONS
 *******************************************************************************/
 
+// Security callback
+class LTE_fdd_enb_pdcp_sec_cb
+{
+public:
+    typedef void (*FuncType)(void*, LTE_FDD_ENB_PDCP_SEC_BATCH_STRUCT*);
+    LTE_fdd_enb_pdcp_sec_cb();
+    LTE_fdd_enb_pdcp_sec_cb(FuncType f, void* o);
+    void operator()(LTE_FDD_ENB_PDCP_SEC_BATCH_STRUCT *batch);
+private:
+    FuncType  func;
+    void     *obj;
+};
+template<class class_type, void (class_type::*Func)(LTE_FDD_ENB_PDCP_SEC_BATCH_STRUCT*)>
+    void LTE_fdd_enb_pdcp_sec_cb_wrapper(void *o, LTE_FDD_ENB_PDCP_SEC_BATCH_STRUCT *batch)
+{
+    return (static_cast<class_type*>(o)->*Func)(batch);
+}
+
 class LTE_fdd_enb_pdcp
 {
 public:
@@ -73,6 +124,8 @@ public:
 
     // External interface
     void update_sys_info(void);
+    void set_security_cb(LTE_fdd_enb_pdcp_sec_cb cb);
+    void handle_t_reordering_expiry(LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb, uint32 timer_id);
 
 private:
     // Singleton
@@ -94,13 +147,44 @@ private:
 
     // RLC Message Handlers
     void handle_pdu_ready(LTE_FDD_ENB_PDCP_PDU_READY_MSG_STRUCT *pdu_ready);
+    void handle_pdu_batch(LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb);
+    LTE_FDD_ENB_PDCP_SEC_BATCH_STRUCT rx_batch;
+    LIBLTE_PDCP_CONTROL_PDU_STRUCT    rx_control_pdu;
+    LIBLTE_PDCP_USER_PLANE_PDU_STRUCT rx_user_plane_pdu;
 
     // RRC Message Handlers
     void handle_sdu_ready(LTE_FDD_ENB_PDCP_SDU_READY_MSG_STRUCT *sdu_ready);
+    void handle_sdu_batch(LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb);
+    LTE_FDD_ENB_PDCP_SEC_BATCH_STRUCT tx_batch;
+    LIBLTE_PDCP_CONTROL_PDU_STRUCT    tx_control_pdu;
+    LIBLTE_PDCP_USER_PLANE_PDU_STRUCT tx_user_plane_pdu;
+    LIBLTE_BIT_MSG_STRUCT             tx_pdu;
+
+    // RX Procedures
+    uint32 rx_count(LTE_fdd_enb_rb *rb, uint16 sn);
+    uint32 rx_am_count(LTE_fdd_enb_rb *rb, uint16 sn);
+    bool rx_am_outside_window(LTE_fdd_enb_rb *rb, uint16 sn);
+    void rx_am_reorder(LIBLTE_BIT_MSG_STRUCT *sdu, uint16 sn, LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb);
+    void rx_deliver(LIBLTE_BIT_MSG_STRUCT *sdu, LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb);
+    void rx_deliver_consecutive(uint16 sn, LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb);
+    boost::mutex          rx_mutex;
+    LIBLTE_BIT_MSG_STRUCT rx_sdu;
+
+    // Security
+    void handle_null_security(LTE_FDD_ENB_PDCP_SEC_BATCH_STRUCT *batch);
+    void run_security(LTE_FDD_ENB_PDCP_SEC_BATCH_STRUCT *batch);
+    boost::mutex            sec_mutex;
+    LTE_fdd_enb_pdcp_sec_cb sec_cb;
+
+    // Helpers
+    void byte_align(LIBLTE_BIT_MSG_STRUCT *msg);
+    void send_rrc_pdu(LIBLTE_BIT_MSG_STRUCT *pdu, LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb);
+    void send_rlc_sdu(LIBLTE_BIT_MSG_STRUCT *sdu, LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb);
 
     // Parameters
     boost::mutex                sys_info_mutex;
     LTE_FDD_ENB_SYS_INFO_STRUCT sys_info;
+    uint32                      sys_info_version;
 };
 
 #endif /* __LTE_FDD_ENB_PDCP_H__ */
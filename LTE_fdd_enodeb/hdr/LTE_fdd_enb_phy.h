@@ -29,6 +29,12 @@
                                    added the ability to handle late subframes.
     05/04/2014    Ben Wojtowicz    Added PHICH support.
     06/15/2014    Ben Wojtowicz    Changed fn_combo to current_tti.
+    10/19/2026    agent            Added processing time statistics and
+                                   helpers for the no_rf loopback radio.
+    10/19/2026    agent            Only copying the system information when
+                                   its version changes.
+    10/19/2026    agent            Added a cache of pre-encoded PBCH and
+                                   system information resource elements.
 
 *******************************************************************************/
 
@@ -52,6 +58,14 @@
 
 #define LTE_FDD_ENB_CURRENT_TTI_MAX (LIBLTE_PHY_SFN_MAX*10 + 9)
 
+#define LTE_FDD_ENB_PHY_BCAST_N_PBCH        (LIBLTE_PHY_SFN_MAX + 1)
+#define LTE_FDD_ENB_PHY_BCAST_N_PBCH_RE     240
+#define LTE_FDD_ENB_PHY_BCAST_N_MIB         (LTE_FDD_ENB_PHY_BCAST_N_PBCH/4)
+#define LTE_FDD_ENB_PHY_BCAST_MIB_MAX_BITS  32
+#define LTE_FDD_ENB_PHY_BCAST_MIN_N_FRAMES  8 // SIB1 redundancy versions repeat every 8 frames
+#define LTE_FDD_ENB_PHY_BCAST_UNUSED_RE     1000000.0
+#define LTE_FDD_ENB_PHY_BCAST_SYMB_STRIDE   (LIBLTE_PHY_N_RB_DL_20MHZ*LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP)
+
 /*******************************************************************************
                               FORWARD DECLARATIONS
 *******************************************************************************/
@@ -61,6 +75,40 @@
                               TYPEDEFS
 *******************************************************************************/
 
+// Modulated resource elements for one system information PDSCH
+// allocation, idx is symbol*LTE_FDD_ENB_PHY_BCAST_SYMB_STRIDE + subcarrier
+// and re/im hold N_re values per antenna
+typedef struct{
+    LIBLTE_PHY_ALLOCATION_STRUCT *alloc;
+    uint16                       *idx;
+    float                        *re;
+    float                        *im;
+    uint32                        subfn;
+    uint32                        first_prb;
+    uint32                        rv_idx;
+    uint32                        tbs;
+    uint32                        N_prb;
+    uint32                        N_re;
+    uint8                         mcs;
+    bool                          encoded;
+}LTE_FDD_ENB_PHY_BCAST_PDSCH_STRUCT;
+
+// Pre-encoded broadcast channels for one version of the system
+// information, pdsch holds one entry per allocation in a scheduling period
+// and the allocations point into sys_info
+typedef struct{
+    LTE_FDD_ENB_SYS_INFO_STRUCT         sys_info;
+    LTE_FDD_ENB_PHY_BCAST_PDSCH_STRUCT *pdsch;
+    float                              *pbch_re;
+    float                              *pbch_im;
+    uint16                              pbch_idx[LTE_FDD_ENB_PHY_BCAST_N_PBCH_RE];
+    uint8                               mib[LTE_FDD_ENB_PHY_BCAST_N_MIB][LTE_FDD_ENB_PHY_BCAST_MIB_MAX_BITS];
+    uint32                              mib_N_bits;
+    uint32                              N_pdsch;
+    uint32                              max_pdsch;
+    uint32                              N_symbs;
+    uint32                              sys_info_version;
+}LTE_FDD_ENB_PHY_BCAST_CACHE_STRUCT;
 
 /*******************************************************************************
                               CLASS DECLARATIONS
@@ -76,15 +124,23 @@ public:
     // Start/Stop
     void start(LTE_fdd_enb_interface *iface);
     void stop(void);
+    bool is_started(void);
 
     // External interface
     void update_sys_info(void);
     uint32 get_n_cce(void);
+    LTE_FDD_ENB_PROC_TIME_STRUCT get_ul_proc_time(void);
+    LTE_FDD_ENB_PROC_TIME_STRUCT get_dl_proc_time(void);
 
     // Radio interface
     void radio_interface(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *tx_buf, LTE_FDD_ENB_RADIO_RX_BUF_STRUCT *rx_buf);
     void radio_interface(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *tx_buf);
 
+    // Loopback interface
+    bool is_prach_subframe(uint32 current_tti);
+    bool is_dl_schedule_ready(void);
+    LTE_FDD_ENB_ERROR_ENUM generate_prach(uint32 preamble_idx, float *i_buf, float *q_buf);
+
 private:
     // Singleton
     static LTE_fdd_enb_phy *instance;
@@ -101,7 +157,9 @@ private:
     boost::interprocess::message_queue *phy_mac_mq;
 
     // Generic parameters
-    LIBLTE_PHY_STRUCT *phy_struct;
+    LIBLTE_PHY_STRUCT            *phy_struct;
+    LTE_FDD_ENB_PROC_TIME_STRUCT  ul_proc_time;
+    LTE_FDD_ENB_PROC_TIME_STRUCT  dl_proc_time;
 
     // Downlink
     void handle_dl_schedule(LTE_FDD_ENB_DL_SCHEDULE_MSG_STRUCT *dl_sched);
@@ -111,6 +169,7 @@ private:
     boost::mutex                       dl_sched_mutex;
     boost::mutex                       ul_sched_mutex;
     LTE_FDD_ENB_SYS_INFO_STRUCT        sys_info;
+    uint32                             sys_info_version;
     LTE_FDD_ENB_DL_SCHEDULE_MSG_STRUCT dl_schedule[10];
     LTE_FDD_ENB_UL_SCHEDULE_MSG_STRUCT ul_schedule[10];
     LIBLTE_PHY_PCFICH_STRUCT           pcfich;
@@ -122,6 +181,26 @@ private:
     uint32                             last_rts_current_tti;
     bool                               late_subfr;
 
+    // Broadcast cache
+    void build_bcast_cache(LTE_FDD_ENB_PHY_BCAST_CACHE_STRUCT *cache);
+    void free_bcast_cache(LTE_FDD_ENB_PHY_BCAST_CACHE_STRUCT *cache);
+    void add_bcast_pdsch(LTE_FDD_ENB_PHY_BCAST_CACHE_STRUCT *cache, LTE_FDD_ENB_SI_ALLOC_STRUCT *si_alloc, uint32 subfn);
+    LTE_FDD_ENB_PHY_BCAST_PDSCH_STRUCT* find_bcast_pdsch(LTE_FDD_ENB_PHY_BCAST_CACHE_STRUCT *cache, LTE_FDD_ENB_SI_ALLOC_STRUCT *si_alloc, uint32 subfn);
+    uint32 select_bcast_pdsch(uint32 sfn, uint32 subfn, LTE_FDD_ENB_PHY_BCAST_PDSCH_STRUCT **pdsch);
+    void clear_bcast_res(LTE_FDD_ENB_PHY_BCAST_CACHE_STRUCT *cache, uint32 first_symb, uint32 last_symb);
+    uint32 find_bcast_res(LTE_FDD_ENB_PHY_BCAST_CACHE_STRUCT *cache, uint32 first_symb, uint32 last_symb, uint16 *idx);
+    void copy_bcast_res(LTE_FDD_ENB_PHY_BCAST_CACHE_STRUCT *cache, uint16 *idx, uint32 N_re, float *re, float *im);
+    void map_bcast_res(uint16 *idx, uint32 N_re, float *re, float *im);
+    boost::mutex                        bcast_mutex;
+    LIBLTE_PHY_STRUCT                  *bcast_phy_struct;
+    LIBLTE_PHY_SUBFRAME_STRUCT         *bcast_subframe;
+    LIBLTE_PHY_ALLOCATION_STRUCT        bcast_alloc;
+    LTE_FDD_ENB_PHY_BCAST_CACHE_STRUCT *bcast;
+    LTE_FDD_ENB_PHY_BCAST_CACHE_STRUCT *bcast_pending;
+    LTE_FDD_ENB_PHY_BCAST_CACHE_STRUCT *bcast_retired;
+    LTE_FDD_ENB_PHY_BCAST_PDSCH_STRUCT  bcast_miss[LTE_FDD_ENB_CNFG_DB_MAX_SI_ALLOCS];
+    LTE_FDD_ENB_PHY_BCAST_PDSCH_STRUCT *dl_bcast[LIBLTE_PHY_PDCCH_MAX_ALLOC];
+
     // Uplink
     void process_ul(LTE_FDD_ENB_RADIO_RX_BUF_STRUCT *rx_buf);
     LTE_FDD_ENB_PRACH_DECODE_MSG_STRUCT prach_decode;
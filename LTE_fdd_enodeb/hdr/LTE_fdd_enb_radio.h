@@ -28,6 +28,12 @@
     01/18/2014    Ben Wojtowicz    Handling EARFCN updates and multiple
                                    antennas.
     06/15/2014    Ben Wojtowicz    Changed fn_combo to current_tti.
+    10/19/2026    agent            Added a preallocated RX/TX buffer pair and
+                                   overrun/underrun counters.
+    10/19/2026    agent            Added a no_rf loopback mode that can run
+                                   unpaced or sped up, inject UL samples from
+                                   a file or generated PRACHs, and report
+                                   processing statistics.
 
 *******************************************************************************/
 
@@ -43,6 +49,7 @@
 #include <gnuradio/gr_complex.h>
 #include <uhd/usrp/multi_usrp.hpp>
 #include <boost/thread/mutex.hpp>
+#include <stdio.h>
 
 /*******************************************************************************
                               DEFINES
@@ -79,6 +86,16 @@ typedef struct{
     uint16 current_tti;
 }LTE_FDD_ENB_RADIO_RX_BUF_STRUCT;
 
+typedef struct{
+    LTE_FDD_ENB_RADIO_TX_BUF_STRUCT tx_buf;
+    LTE_FDD_ENB_RADIO_RX_BUF_STRUCT rx_buf;
+}LTE_FDD_ENB_RADIO_BUF_STRUCT;
+
+typedef struct{
+    uint32 N_rx_overruns;
+    uint32 N_tx_underruns;
+}LTE_FDD_ENB_RADIO_BUF_STATS_STRUCT;
+
 /*******************************************************************************
                               CLASS DECLARATIONS
 *******************************************************************************/
@@ -107,6 +124,14 @@ public:
     uint32 get_sample_rate(void);
     void set_earfcns(int64 dl_earfcn, int64 ul_earfcn);
     void send(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *buf);
+    LTE_FDD_ENB_RADIO_BUF_STATS_STRUCT get_buf_stats(void);
+    uint32 get_no_rf_speedup(void);
+    LTE_FDD_ENB_ERROR_ENUM set_no_rf_speedup(uint32 speedup);
+    std::string get_no_rf_ul_file(void);
+    LTE_FDD_ENB_ERROR_ENUM set_no_rf_ul_file(std::string file_name);
+    uint32 get_no_rf_prach_period(void);
+    LTE_FDD_ENB_ERROR_ENUM set_no_rf_prach_period(uint32 period);
+    std::string get_no_rf_stats(void);
 
 private:
     // Singleton
@@ -139,6 +164,31 @@ private:
     uint32           tx_gain;
     uint32           rx_gain;
     uint16           next_tx_current_tti;
+
+    // Subframe buffers
+    LTE_FDD_ENB_ERROR_ENUM alloc_subfr_buf(void);
+    void free_subfr_buf(void);
+    void convert_rx_samps(const gr_complex *in, float *i_buf, float *q_buf, uint32 N_samps);
+    void convert_tx_samps(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *buf, uint32 idx, uint32 N_samps);
+    LTE_FDD_ENB_RADIO_BUF_STRUCT       *subfr_buf;
+    size_t                              subfr_buf_size;
+    bool                                subfr_buf_hugepages;
+    LTE_FDD_ENB_RADIO_BUF_STATS_STRUCT  buf_stats;
+
+    // No RF loopback
+    void no_rf_setup(void);
+    void no_rf_fill_rx_buf(LTE_FDD_ENB_RADIO_BUF_STRUCT *buf);
+    void no_rf_wait(void);
+    std::string                   no_rf_ul_file_name;
+    FILE                         *no_rf_ul_file;
+    LTE_FDD_ENB_PROC_TIME_STRUCT  no_rf_subfr_proc_time;
+    struct timespec               no_rf_start_time;
+    struct timespec               no_rf_next_subfr_time;
+    uint64                        no_rf_N_subfrs;
+    uint32                        no_rf_speedup;
+    uint32                        no_rf_prach_period;
+    uint64                        no_rf_next_prach_subfr;
+    uint32                        no_rf_N_prachs;
 };
 
 #endif /* __LTE_FDD_ENB_RADIO_H__ */
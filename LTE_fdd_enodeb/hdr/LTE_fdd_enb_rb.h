@@ -27,6 +27,17 @@
     05/04/2014    Ben Wojtowicz    Created file
     06/15/2014    Ben Wojtowicz    Added more states and procedures, QoS, MME,
                                    RLC, and uplink scheduling functionality.
+    10/19/2026    agent            Removed the UL scheduling timer, QoS now
+                                   sets up UL polling in the MAC.
+    10/19/2026    agent            Replaced the RLC reception buffer map with
+                                   array based AM transmit/receive windows
+                                   and added the RLC AM state variables and
+                                   timers.
+    10/19/2026    agent            Added the RLC UM state variables, reordering
+                                   window, segmentation/concatenation, and
+                                   per bearer UM counters.
+    10/19/2026    agent            Added PDCP configurations, state variables,
+                                   reordering buffer, and throughput counters.
 
 *******************************************************************************/
 
@@ -38,14 +49,42 @@
 *******************************************************************************/
 
 #include "LTE_fdd_enb_interface.h"
+#include "LTE_fdd_enb_timer_mgr.h"
 #include "liblte_rlc.h"
+#include "liblte_pdcp.h"
 #include "liblte_rrc.h"
 #include <list>
+#include <vector>
 
 /*******************************************************************************
                               DEFINES
 *******************************************************************************/
 
+// Largest PDCP reordering window, used with 12 bit SNs
+#define LTE_FDD_ENB_PDCP_MAX_REORDERING_WINDOW ((LIBLTE_PDCP_SN_12_BITS_MAX_SN + 1) / 2)
+
+// PDCP t-Reordering in milliseconds, 36.331 v12.0.0 Section 6.3.2
+#define LTE_FDD_ENB_PDCP_T_REORDERING 100
+
+// RLC AM configuration, defaults from 36.331 v10.0.0 Section 9.2.1.1
+#define LTE_FDD_ENB_RLC_AM_T_POLL_RETRANSMIT  45
+#define LTE_FDD_ENB_RLC_AM_POLL_PDU           0xFFFFFFFF
+#define LTE_FDD_ENB_RLC_AM_POLL_BYTE          0xFFFFFFFF
+#define LTE_FDD_ENB_RLC_AM_MAX_RETX_THRESHOLD 4
+#define LTE_FDD_ENB_RLC_AM_T_REORDERING       35
+#define LTE_FDD_ENB_RLC_AM_T_STATUS_PROHIBIT  0
+
+// Maximum number of disjoint byte ranges tracked for a partially received
+// AMD PDU
+#define LTE_FDD_ENB_RLC_AM_N_SEGS 16
+
+// Maximum number of SDU boundaries tracked for an AMD PDU
+#define LTE_FDD_ENB_RLC_AM_N_SDU_ENDS 16
+
+// Largest UMD PDU built by concatenating/segmenting SDUs
+#define LTE_FDD_ENB_RLC_UM_MAX_PDU_BYTES 256
+
+#define LTE_FDD_ENB_RLC_INVALID_TIMER_ID LTE_FDD_ENB_TIMER_MGR_INVALID_TIMER_ID
 
 /*******************************************************************************
                               FORWARD DECLARATIONS
@@ -91,9 +130,23 @@ static const char LTE_fdd_enb_rrc_state_text[LTE_FDD_ENB_RRC_STATE_N_ITEMS][100]
 
 typedef enum{
     LTE_FDD_ENB_PDCP_CONFIG_N_A = 0,
+    LTE_FDD_ENB_PDCP_CONFIG_SRB,
+    LTE_FDD_ENB_PDCP_CONFIG_DRB_LONG_SN,
+    LTE_FDD_ENB_PDCP_CONFIG_DRB_SHORT_SN,
     LTE_FDD_ENB_PDCP_CONFIG_N_ITEMS,
 }LTE_FDD_ENB_PDCP_CONFIG_ENUM;
-static const char LTE_fdd_enb_pdcp_config_text[LTE_FDD_ENB_PDCP_CONFIG_N_ITEMS][20] = {"N/A"};
+static const char LTE_fdd_enb_pdcp_config_text[LTE_FDD_ENB_PDCP_CONFIG_N_ITEMS][20] = {"N/A",
+                                                                                       "SRB",
+                                                                                       "DRB Long SN",
+                                                                                       "DRB Short SN"};
+
+typedef struct{
+    uint64 N_ul_bytes;
+    uint64 N_dl_bytes;
+    uint32 N_ul_sdus;
+    uint32 N_dl_sdus;
+    uint32 N_discarded_pdus;
+}LTE_FDD_ENB_PDCP_STATS_STRUCT;
 
 typedef enum{
     LTE_FDD_ENB_RLC_CONFIG_TM = 0,
@@ -124,6 +177,51 @@ typedef struct{
     uint32 bits_per_subfn;
 }LTE_FDD_ENB_QOS_STRUCT;
 
+typedef enum{
+    LTE_FDD_ENB_RLC_TIMER_T_POLL_RETRANSMIT = 0,
+    LTE_FDD_ENB_RLC_TIMER_T_REORDERING,
+    LTE_FDD_ENB_RLC_TIMER_T_STATUS_PROHIBIT,
+    LTE_FDD_ENB_RLC_TIMER_N_ITEMS,
+}LTE_FDD_ENB_RLC_TIMER_ENUM;
+static const char LTE_fdd_enb_rlc_timer_text[LTE_FDD_ENB_RLC_TIMER_N_ITEMS][20] = {"t-PollRetransmit",
+                                                                                  "t-Reordering",
+                                                                                  "t-StatusProhibit"};
+
+typedef struct{
+    LIBLTE_BIT_MSG_STRUCT    *data;
+    LIBLTE_RLC_FI_FIELD_ENUM  fi;
+    uint32                    N_bytes;
+    uint32                    N_segs;
+    uint16                    seg_start[LTE_FDD_ENB_RLC_AM_N_SEGS];
+    uint16                    seg_end[LTE_FDD_ENB_RLC_AM_N_SEGS];
+    uint16                    sdu_end[LTE_FDD_ENB_RLC_AM_N_SDU_ENDS];
+    uint32                    N_sdu_ends;
+    uint32                    next_sdu;
+    bool                      last_rcvd;
+}LTE_FDD_ENB_RLC_AM_RX_PDU_STRUCT;
+
+typedef struct{
+    LIBLTE_BIT_MSG_STRUCT    *data;
+    LIBLTE_RLC_FI_FIELD_ENUM  fi;
+    uint32                    retx_count;
+}LTE_FDD_ENB_RLC_AM_TX_PDU_STRUCT;
+
+typedef struct{
+    LIBLTE_BIT_MSG_STRUCT    *pdu;
+    uint8                    *slice[LIBLTE_RLC_UMD_PDU_MAX_N_SLICES];
+    uint32                    slice_bits[LIBLTE_RLC_UMD_PDU_MAX_N_SLICES];
+    uint32                    N_slices;
+    uint32                    next_slice;
+    LIBLTE_RLC_FI_FIELD_ENUM  fi;
+}LTE_FDD_ENB_RLC_UM_RX_PDU_STRUCT;
+
+typedef struct{
+    uint32 N_pdus_dropped;
+    uint32 N_pdus_lost;
+    uint32 reordering_depth;
+    uint32 max_reordering_depth;
+}LTE_FDD_ENB_RLC_UM_STATS_STRUCT;
+
 /*******************************************************************************
                               CLASS DECLARATIONS
 *******************************************************************************/
@@ -163,6 +261,35 @@ public:
     LTE_FDD_ENB_ERROR_ENUM get_next_pdcp_sdu(LIBLTE_BIT_MSG_STRUCT **sdu);
     LTE_FDD_ENB_ERROR_ENUM delete_next_pdcp_sdu(void);
     LTE_FDD_ENB_PDCP_CONFIG_ENUM get_pdcp_config(void);
+    void set_pdcp_config(LTE_FDD_ENB_PDCP_CONFIG_ENUM config);
+    LIBLTE_PDCP_SN_SIZE_ENUM get_pdcp_sn_size(void);
+    uint32 get_pdcp_sn_n_bits(void);
+    uint16 get_pdcp_max_sn(void);
+    uint16 get_pdcp_reordering_window(void);
+    uint16 get_pdcp_next_tx_sn(void);
+    void set_pdcp_next_tx_sn(uint16 next_tx_sn);
+    uint32 get_pdcp_tx_hfn(void);
+    void set_pdcp_tx_hfn(uint32 tx_hfn);
+    uint16 get_pdcp_next_rx_sn(void);
+    void set_pdcp_next_rx_sn(uint16 next_rx_sn);
+    uint32 get_pdcp_rx_hfn(void);
+    void set_pdcp_rx_hfn(uint32 rx_hfn);
+    uint16 get_pdcp_last_submitted_rx_sn(void);
+    void set_pdcp_last_submitted_rx_sn(uint16 last_submitted_rx_sn);
+    LTE_FDD_ENB_ERROR_ENUM pdcp_add_to_reordering_buffer(uint16 sn, LIBLTE_BIT_MSG_STRUCT *sdu);
+    LTE_FDD_ENB_ERROR_ENUM pdcp_get_from_reordering_buffer(uint16 sn, LIBLTE_BIT_MSG_STRUCT *sdu);
+    uint32 get_pdcp_n_reordering_sdus(void);
+    uint16 get_pdcp_reordering_rx_sn(void);
+    void set_pdcp_reordering_rx_sn(uint16 reordering_rx_sn);
+    void pdcp_start_t_reordering(void);
+    void pdcp_stop_t_reordering(void);
+    bool pdcp_is_t_reordering_running(void);
+    bool pdcp_t_reordering_expired(uint32 timer_id);
+    void handle_pdcp_t_reordering_expiry(uint32 timer_id);
+    LTE_FDD_ENB_PDCP_STATS_STRUCT get_pdcp_stats(void);
+    void pdcp_count_ul_sdu(uint32 N_bytes);
+    void pdcp_count_dl_sdu(uint32 N_bytes);
+    void pdcp_count_discarded_pdu(void);
 
     // RLC
     void queue_rlc_pdu(LIBLTE_BIT_MSG_STRUCT *pdu);
@@ -175,18 +302,75 @@ public:
     uint16 get_rlc_vrr(void);
     void set_rlc_vrr(uint16 vrr);
     uint16 get_rlc_vrmr(void);
+    uint16 get_rlc_vrx(void);
+    void set_rlc_vrx(uint16 vrx);
+    uint16 get_rlc_vrms(void);
+    void set_rlc_vrms(uint16 vrms);
     uint16 get_rlc_vrh(void);
     void set_rlc_vrh(uint16 vrh);
-    void rlc_add_to_reception_buffer(LIBLTE_RLC_AMD_PDU_STRUCT *amd_pdu);
-    LTE_FDD_ENB_ERROR_ENUM rlc_reassemble(LIBLTE_BIT_MSG_STRUCT *sdu);
+    uint16 get_rlc_vta(void);
+    void set_rlc_vta(uint16 vta);
+    uint16 get_rlc_vtms(void);
+    uint16 get_rlc_vts(void);
+    void set_rlc_vts(uint16 vts);
+    uint16 get_rlc_poll_sn(void);
+    void set_rlc_poll_sn(uint16 poll_sn);
+    uint32 get_rlc_pdu_without_poll(void);
+    void set_rlc_pdu_without_poll(uint32 pdu_without_poll);
+    uint32 get_rlc_byte_without_poll(void);
+    void set_rlc_byte_without_poll(uint32 byte_without_poll);
+    uint32 get_rlc_poll_pdu(void);
+    uint32 get_rlc_poll_byte(void);
+    uint32 get_rlc_max_retx_threshold(void);
+    bool get_rlc_status_pending(void);
+    void set_rlc_status_pending(bool status_pending);
+    bool get_rlc_poll_delayed(void);
+    uint16 get_rlc_poll_delayed_sn(void);
+    void set_rlc_poll_delayed(bool poll_delayed, uint16 poll_delayed_sn);
+    void rlc_start_timer(LTE_FDD_ENB_RLC_TIMER_ENUM timer);
+    void rlc_stop_timer(LTE_FDD_ENB_RLC_TIMER_ENUM timer);
+    bool rlc_is_timer_running(LTE_FDD_ENB_RLC_TIMER_ENUM timer);
+    bool rlc_timer_expired(LTE_FDD_ENB_RLC_TIMER_ENUM timer, uint32 timer_id);
+    void handle_rlc_t_poll_retransmit_expiry(uint32 timer_id);
+    void handle_rlc_t_reordering_expiry(uint32 timer_id);
+    void handle_rlc_t_status_prohibit_expiry(uint32 timer_id);
+    LTE_FDD_ENB_ERROR_ENUM rlc_add_to_reception_buffer(LIBLTE_RLC_AMD_PDU_STRUCT *amd_pdu);
+    bool rlc_is_pdu_received(uint16 sn);
+    LTE_FDD_ENB_ERROR_ENUM rlc_add_nacks(uint16 sn, LIBLTE_RLC_STATUS_PDU_STRUCT *status);
+    LTE_FDD_ENB_ERROR_ENUM rlc_reassemble(uint16 sn, LIBLTE_BIT_MSG_STRUCT *sdu);
+    void rlc_add_to_transmission_buffer(uint16 sn, LIBLTE_BIT_MSG_STRUCT *sdu);
+    LTE_FDD_ENB_ERROR_ENUM rlc_get_transmission_buffer_pdu(uint16 sn, LIBLTE_BIT_MSG_STRUCT **data, LIBLTE_RLC_FI_FIELD_ENUM *fi);
+    uint32 rlc_increment_retx_count(uint16 sn);
+    void rlc_remove_from_transmission_buffer(uint16 sn);
+    void rlc_queue_tx_sdu(LIBLTE_BIT_MSG_STRUCT *sdu);
+    LTE_FDD_ENB_ERROR_ENUM rlc_get_next_tx_sdu(LIBLTE_BIT_MSG_STRUCT **sdu);
+    LTE_FDD_ENB_ERROR_ENUM rlc_pop_next_tx_sdu(LIBLTE_BIT_MSG_STRUCT **sdu);
+    uint32 get_n_rlc_sdus(void);
+    LIBLTE_RLC_UMD_SN_SIZE_ENUM get_rlc_um_sn_size(void);
+    void set_rlc_um_sn_size(LIBLTE_RLC_UMD_SN_SIZE_ENUM sn_size);
+    uint16 get_rlc_um_modulus(void);
+    uint16 get_rlc_um_window_size(void);
+    uint16 get_rlc_vtus(void);
+    void set_rlc_vtus(uint16 vtus);
+    uint16 get_rlc_vrur(void);
+    void set_rlc_vrur(uint16 vrur);
+    uint16 get_rlc_vrux(void);
+    void set_rlc_vrux(uint16 vrux);
+    uint16 get_rlc_vruh(void);
+    void set_rlc_vruh(uint16 vruh);
+    LTE_FDD_ENB_RLC_UM_STATS_STRUCT get_rlc_um_stats(void);
+    void rlc_um_count_dropped_pdu(void);
+    LTE_FDD_ENB_ERROR_ENUM rlc_um_add_to_reception_buffer(LIBLTE_BIT_MSG_STRUCT *pdu, LIBLTE_RLC_UMD_PDU_STRUCT *umd);
+    bool rlc_um_is_pdu_received(uint16 sn);
+    LTE_FDD_ENB_ERROR_ENUM rlc_um_reassemble(uint16 sn, LIBLTE_BIT_MSG_STRUCT *sdu);
+    LTE_FDD_ENB_ERROR_ENUM rlc_um_queue_tx_sdu(LIBLTE_BIT_MSG_STRUCT *sdu);
+    LTE_FDD_ENB_ERROR_ENUM rlc_um_build_pdu(LIBLTE_RLC_UMD_PDU_STRUCT *umd, uint32 max_N_bytes, LIBLTE_BIT_MSG_STRUCT *pdu);
 
     // MAC
     void queue_mac_sdu(LIBLTE_BIT_MSG_STRUCT *sdu);
     LTE_FDD_ENB_ERROR_ENUM get_next_mac_sdu(LIBLTE_BIT_MSG_STRUCT **sdu);
     LTE_FDD_ENB_ERROR_ENUM delete_next_mac_sdu(void);
     LTE_FDD_ENB_MAC_CONFIG_ENUM get_mac_config(void);
-    void start_ul_sched_timer(uint32 m_seconds);
-    void handle_ul_sched_timer_expiry(uint32 timer_id);
 
     // Generic
     void set_qos(LTE_FDD_ENB_QOS_ENUM _qos);
@@ -213,26 +397,69 @@ private:
     std::list<LIBLTE_BIT_MSG_STRUCT *> pdcp_pdu_queue;
     std::list<LIBLTE_BIT_MSG_STRUCT *> pdcp_sdu_queue;
     LTE_FDD_ENB_PDCP_CONFIG_ENUM       pdcp_config;
+    LTE_FDD_ENB_PDCP_STATS_STRUCT      pdcp_stats;
+    LIBLTE_BIT_MSG_STRUCT             *pdcp_reordering_buffer[LTE_FDD_ENB_PDCP_MAX_REORDERING_WINDOW];
+    uint32                             pdcp_N_reordering_sdus;
+    uint32                             pdcp_t_reordering_id;
+    uint32                             pdcp_tx_hfn;
+    uint32                             pdcp_rx_hfn;
+    uint16                             pdcp_next_tx_sn;
+    uint16                             pdcp_next_rx_sn;
+    uint16                             pdcp_last_submitted_rx_sn;
+    uint16                             pdcp_reordering_rx_sn;
 
     // RLC
-    boost::mutex                              rlc_pdu_queue_mutex;
-    boost::mutex                              rlc_sdu_queue_mutex;
-    std::list<LIBLTE_BIT_MSG_STRUCT *>        rlc_pdu_queue;
-    std::list<LIBLTE_BIT_MSG_STRUCT *>        rlc_sdu_queue;
-    std::map<uint16, LIBLTE_BIT_MSG_STRUCT *> rlc_reception_buffer;
-    LTE_FDD_ENB_RLC_CONFIG_ENUM               rlc_config;
-    uint16                                    rlc_vrr;
-    uint16                                    rlc_vrmr;
-    uint16                                    rlc_vrh;
-    uint16                                    rlc_first_segment_sn;
-    uint16                                    rlc_last_segment_sn;
+    LIBLTE_BIT_MSG_STRUCT* rlc_alloc_buf(void);
+    void rlc_free_buf(LIBLTE_BIT_MSG_STRUCT *buf);
+    LTE_FDD_ENB_RLC_AM_RX_PDU_STRUCT* rlc_get_rx_pdu(uint16 sn);
+    LTE_FDD_ENB_RLC_AM_TX_PDU_STRUCT* rlc_get_tx_pdu(uint16 sn);
+    LTE_FDD_ENB_RLC_UM_RX_PDU_STRUCT* rlc_um_get_rx_pdu(uint16 sn);
+    void rlc_um_update_reordering_depth(void);
+    boost::mutex                         rlc_pdu_queue_mutex;
+    boost::mutex                         rlc_sdu_queue_mutex;
+    std::list<LIBLTE_BIT_MSG_STRUCT *>   rlc_pdu_queue;
+    std::list<LIBLTE_BIT_MSG_STRUCT *>   rlc_sdu_queue;
+    std::list<LIBLTE_BIT_MSG_STRUCT *>   rlc_tx_sdu_queue;
+    std::vector<LIBLTE_BIT_MSG_STRUCT *> rlc_buf_pool;
+    LTE_FDD_ENB_RLC_AM_RX_PDU_STRUCT     rlc_reception_buffer[LIBLTE_RLC_AM_WINDOW_SIZE];
+    LTE_FDD_ENB_RLC_AM_TX_PDU_STRUCT     rlc_transmission_buffer[LIBLTE_RLC_AM_WINDOW_SIZE];
+    LTE_FDD_ENB_RLC_UM_RX_PDU_STRUCT     rlc_um_reception_buffer[LIBLTE_RLC_UM_WINDOW_SIZE_SN_10_BITS];
+    LIBLTE_BIT_MSG_STRUCT                rlc_reassembly_sdu;
+    LTE_FDD_ENB_RLC_CONFIG_ENUM          rlc_config;
+    uint32                               rlc_timer_id[LTE_FDD_ENB_RLC_TIMER_N_ITEMS];
+    uint32                               rlc_timer_m_seconds[LTE_FDD_ENB_RLC_TIMER_N_ITEMS];
+    uint32                               rlc_poll_pdu;
+    uint32                               rlc_poll_byte;
+    uint32                               rlc_max_retx_threshold;
+    uint32                               rlc_pdu_without_poll;
+    uint32                               rlc_byte_without_poll;
+    uint16                               rlc_vrr;
+    uint16                               rlc_vrmr;
+    uint16                               rlc_vrx;
+    uint16                               rlc_vrms;
+    uint16                               rlc_vrh;
+    uint16                               rlc_vta;
+    uint16                               rlc_vtms;
+    uint16                               rlc_vts;
+    uint16                               rlc_poll_sn;
+    uint16                               rlc_poll_delayed_sn;
+    bool                                 rlc_poll_delayed;
+    bool                                 rlc_status_pending;
+    LIBLTE_RLC_UMD_SN_SIZE_ENUM          rlc_um_sn_size;
+    LTE_FDD_ENB_RLC_UM_STATS_STRUCT      rlc_um_stats;
+    uint32                               rlc_um_tx_sdu_offset;
+    uint16                               rlc_um_modulus;
+    uint16                               rlc_um_window_size;
+    uint16                               rlc_um_last_reassembled_sn;
+    uint16                               rlc_vtus;
+    uint16                               rlc_vrur;
+    uint16                               rlc_vrux;
+    uint16                               rlc_vruh;
 
     // MAC
     boost::mutex                       mac_sdu_queue_mutex;
     std::list<LIBLTE_BIT_MSG_STRUCT *> mac_sdu_queue;
     LTE_FDD_ENB_MAC_CONFIG_ENUM        mac_config;
-    uint32                             ul_sched_timer_id;
-    uint32                             ul_sched_timer_m_seconds;
 
     // Generic
     void queue_msg(LIBLTE_BIT_MSG_STRUCT *msg, boost::mutex *mutex, std::list<LIBLTE_BIT_MSG_STRUCT *> *queue);
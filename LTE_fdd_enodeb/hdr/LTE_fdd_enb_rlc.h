@@ -27,6 +27,12 @@
     11/09/2013    Ben Wojtowicz    Created file
     05/04/2014    Ben Wojtowicz    Added communication to MAC and PDCP.
     06/15/2014    Ben Wojtowicz    Using the latest LTE library.
+    10/19/2026    agent            Added the RLC AM transmit and receive
+                                   procedures.
+    10/19/2026    agent            Added the RLC UM transmit and receive
+                                   procedures.
+    10/19/2026    agent            Only copying the system information when
+                                   its version changes.
 
 *******************************************************************************/
 
@@ -74,6 +80,7 @@ public:
 
     // External interface
     void update_sys_info(void);
+    void handle_timer_expiry(LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb, LTE_FDD_ENB_RLC_TIMER_ENUM timer, uint32 timer_id);
 
 private:
     // Singleton
@@ -98,6 +105,8 @@ private:
     void handle_tm_pdu(LIBLTE_BIT_MSG_STRUCT *pdu, LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb);
     void handle_um_pdu(LIBLTE_BIT_MSG_STRUCT *pdu, LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb);
     void handle_am_pdu(LIBLTE_BIT_MSG_STRUCT *pdu, LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb);
+    void handle_amd_pdu(LIBLTE_BIT_MSG_STRUCT *pdu, LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb);
+    void handle_status_pdu(LIBLTE_BIT_MSG_STRUCT *pdu, LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb);
 
     // PDCP Message Handlers
     void handle_sdu_ready(LTE_FDD_ENB_RLC_SDU_READY_MSG_STRUCT *sdu_ready);
@@ -105,9 +114,31 @@ private:
     void handle_um_sdu(LIBLTE_BIT_MSG_STRUCT *sdu, LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb);
     void handle_am_sdu(LIBLTE_BIT_MSG_STRUCT *sdu, LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb);
 
+    // AM Procedures
+    void am_send_tx_sdus(LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb);
+    void am_send_amd_pdu(LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb, uint16 sn, uint16 so_start, uint16 so_end, bool poll);
+    void am_check_retx_count(LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb, uint16 sn);
+    void am_check_delayed_poll(LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb);
+    void am_check_status(LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb);
+    void am_send_status(LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb);
+    uint16 am_rx_offset(LTE_fdd_enb_rb *rb, uint16 sn);
+    uint16 am_tx_offset(LTE_fdd_enb_rb *rb, uint16 sn);
+
+    // UM Procedures
+    void um_send_tx_sdus(LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb);
+    void um_reassemble(LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb, uint16 sn);
+    uint16 um_rx_offset(LTE_fdd_enb_rb *rb, uint16 sn);
+    boost::mutex entity_mutex;
+
+    // Helpers
+    void send_pdcp_pdu(LIBLTE_BIT_MSG_STRUCT *pdu, LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb);
+    void send_mac_sdu(LIBLTE_BIT_MSG_STRUCT *sdu, LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb);
+    void send_radio_link_failure(LTE_fdd_enb_user *user, LTE_fdd_enb_rb *rb);
+
     // Parameters
     boost::mutex                sys_info_mutex;
     LTE_FDD_ENB_SYS_INFO_STRUCT sys_info;
+    uint32                      sys_info_version;
 };
 
 #endif /* __LTE_FDD_ENB_RLC_H__ */
@@ -29,6 +29,8 @@
                                    machine.
     06/15/2014    Ben Wojtowicz    Added UL DCCH message handling and MME NAS
                                    message handling.
+    10/19/2026    agent            Only copying the system information when
+                                   its version changes.
 
 *******************************************************************************/
 
@@ -98,6 +100,7 @@ private:
 
     // PDCP Message Handlers
     void handle_pdu_ready(LTE_FDD_ENB_RRC_PDU_READY_MSG_STRUCT *pdu_ready);
+    void handle_radio_link_failure(LTE_FDD_ENB_RRC_RADIO_LINK_FAILURE_MSG_STRUCT *rlf);
 
     // MME Message Handlers
     void handle_nas_msg(LTE_FDD_ENB_RRC_NAS_MSG_READY_MSG_STRUCT *nas_msg);
@@ -116,6 +119,7 @@ private:
     // Parameters
     boost::mutex                sys_info_mutex;
     LTE_FDD_ENB_SYS_INFO_STRUCT sys_info;
+    uint32                      sys_info_version;
 };
 
 #endif /* __LTE_FDD_ENB_RRC_H__ */
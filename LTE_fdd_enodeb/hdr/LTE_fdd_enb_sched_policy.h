@@ -0,0 +1,111 @@
+/*******************************************************************************
+
+    Copyright 2026 agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: LTE_fdd_enb_sched_policy.h
+
+    Description: Contains all the definitions for the LTE FDD eNodeB
+                 DL scheduling policies.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    agent            Created file
+
+*******************************************************************************/
+
+#ifndef __LTE_FDD_ENB_SCHED_POLICY_H__
+#define __LTE_FDD_ENB_SCHED_POLICY_H__
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "LTE_fdd_enb_cnfg_db.h"
+#include "LTE_fdd_enb_user.h"
+#include "typedefs.h"
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+#define LTE_FDD_ENB_SCHED_POLICY_DL_THRU_WINDOW 100 // Averaging window in TTIs
+
+/*******************************************************************************
+                              FORWARD DECLARATIONS
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+// Spectral efficiency per CQI index from 36.213 v10.3.0 table 7.2.3-1
+static const float LTE_fdd_enb_sched_policy_cqi_efficiency[16] = {0.0000, 0.1523, 0.2344, 0.3770,
+                                                                  0.6016, 0.8770, 1.1758, 1.4766,
+                                                                  1.9141, 2.4063, 2.7305, 3.3223,
+                                                                  3.9023, 4.5234, 5.1152, 5.5547};
+
+/*******************************************************************************
+                              CLASS DECLARATIONS
+*******************************************************************************/
+
+// Base DL scheduling policy, a policy turns a user into a metric and the
+// scheduler serves the highest metric first.  The bookkeeping done when a
+// user is scheduled is shared so policies can be switched at run time.
+class LTE_fdd_enb_dl_sched_policy
+{
+public:
+    // Factory
+    static LTE_fdd_enb_dl_sched_policy* create(LTE_FDD_ENB_DL_SCHED_POLICY_ENUM type);
+    virtual ~LTE_fdd_enb_dl_sched_policy();
+
+    // Policy
+    virtual float get_metric(LTE_fdd_enb_user *user, uint32 current_tti, uint32 N_re) = 0;
+    virtual void scheduled(LTE_fdd_enb_user *user, uint32 current_tti, uint32 N_bits);
+
+protected:
+    LTE_fdd_enb_dl_sched_policy();
+
+    // Helpers
+    uint32 get_n_ttis_since(uint32 tti, uint32 current_tti);
+    float get_cqi_efficiency(LTE_fdd_enb_user *user);
+    float get_avg_thru(LTE_fdd_enb_user *user, uint32 current_tti);
+};
+
+// Longest since last scheduled goes first
+class LTE_fdd_enb_dl_sched_policy_round_robin : public LTE_fdd_enb_dl_sched_policy
+{
+public:
+    float get_metric(LTE_fdd_enb_user *user, uint32 current_tti, uint32 N_re);
+};
+
+// Best channel goes first
+class LTE_fdd_enb_dl_sched_policy_max_ci : public LTE_fdd_enb_dl_sched_policy
+{
+public:
+    float get_metric(LTE_fdd_enb_user *user, uint32 current_tti, uint32 N_re);
+};
+
+// Achievable rate over average rate
+class LTE_fdd_enb_dl_sched_policy_proportional_fair : public LTE_fdd_enb_dl_sched_policy
+{
+public:
+    float get_metric(LTE_fdd_enb_user *user, uint32 current_tti, uint32 N_re);
+};
+
+#endif /* __LTE_FDD_ENB_SCHED_POLICY_H__ */
@@ -27,6 +27,8 @@
     05/04/2014    Ben Wojtowicz    Created file
     06/15/2014    Ben Wojtowicz    Added millisecond resolution and seperated
                                    the callback calling functionality.
+    10/19/2026    agent            Removed the timer class, timers are now
+                                   pooled nodes in the timer manager.
 
 *******************************************************************************/
 
@@ -76,24 +78,4 @@ template<class class_type, void (class_type::*Func)(uint32)>
     return (static_cast<class_type*>(o)->*Func)(id);
 }
 
-class LTE_fdd_enb_timer
-{
-public:
-    // Constructor/Destructor
-    LTE_fdd_enb_timer(uint32 m_seconds, uint32 _id, LTE_fdd_enb_timer_cb _cb);
-    ~LTE_fdd_enb_timer();
-
-    // External interface
-    void increment(void);
-    bool expired(void);
-    void call_callback(void);
-
-private:
-    // Identity
-    LTE_fdd_enb_timer_cb cb;
-    uint32               id;
-    uint32               expiry_m_seconds;
-    uint32               current_m_seconds;
-};
-
 #endif /* __LTE_FDD_ENB_TIMER_H__ */
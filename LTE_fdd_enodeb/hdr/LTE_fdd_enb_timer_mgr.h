@@ -26,6 +26,10 @@
     ----------    -------------    --------------------------------------------
     05/04/2014    Ben Wojtowicz    Created file
     06/15/2014    Ben Wojtowicz    Added millisecond resolution.
+    10/19/2026    agent            Replaced the timer map with a hierarchical
+                                   timing wheel of pooled timer nodes with
+                                   generation tagged IDs and added a
+                                   benchmark.
 
 *******************************************************************************/
 
@@ -39,11 +43,32 @@
 #include "LTE_fdd_enb_interface.h"
 #include "LTE_fdd_enb_timer.h"
 #include <boost/thread/mutex.hpp>
+#include <vector>
 
 /*******************************************************************************
                               DEFINES
 *******************************************************************************/
 
+// Timing wheel, each level has 2^LEVEL_BITS slots and each slot of a level
+// spans all of the slots of the level below it.  A tick that wraps a level
+// re-inserts every timer in the next slot of the level above it, so the
+// cost of a tick grows with the number of running timers.
+#define LTE_FDD_ENB_TIMER_MGR_N_LEVELS   4
+#define LTE_FDD_ENB_TIMER_MGR_LEVEL_BITS 6
+#define LTE_FDD_ENB_TIMER_MGR_N_SLOTS    (1 << LTE_FDD_ENB_TIMER_MGR_LEVEL_BITS)
+#define LTE_FDD_ENB_TIMER_MGR_SLOT_MASK  (LTE_FDD_ENB_TIMER_MGR_N_SLOTS - 1)
+#define LTE_FDD_ENB_TIMER_MGR_MAX_TICKS  ((1 << (LTE_FDD_ENB_TIMER_MGR_N_LEVELS*LTE_FDD_ENB_TIMER_MGR_LEVEL_BITS)) - 1)
+
+// Timer nodes are allocated in chunks and never returned to the heap, timer
+// IDs carry the node index in the low bits and a generation in the high bits
+#define LTE_FDD_ENB_TIMER_MGR_CHUNK_BITS 10
+#define LTE_FDD_ENB_TIMER_MGR_CHUNK_SIZE (1 << LTE_FDD_ENB_TIMER_MGR_CHUNK_BITS)
+#define LTE_FDD_ENB_TIMER_MGR_IDX_BITS   20
+#define LTE_FDD_ENB_TIMER_MGR_IDX_MASK   ((1 << LTE_FDD_ENB_TIMER_MGR_IDX_BITS) - 1)
+#define LTE_FDD_ENB_TIMER_MGR_MAX_TIMERS (1 << LTE_FDD_ENB_TIMER_MGR_IDX_BITS)
+
+// Never handed out as a timer ID
+#define LTE_FDD_ENB_TIMER_MGR_INVALID_TIMER_ID 0xFFFFFFFF
 
 /*******************************************************************************
                               FORWARD DECLARATIONS
@@ -54,6 +79,28 @@
                               TYPEDEFS
 *******************************************************************************/
 
+typedef enum{
+    LTE_FDD_ENB_TIMER_STATE_FREE = 0,
+    LTE_FDD_ENB_TIMER_STATE_ACTIVE,
+    LTE_FDD_ENB_TIMER_STATE_FIRING,
+    LTE_FDD_ENB_TIMER_STATE_STOPPED,
+    LTE_FDD_ENB_TIMER_STATE_N_ITEMS,
+}LTE_FDD_ENB_TIMER_STATE_ENUM;
+static const char LTE_fdd_enb_timer_state_text[LTE_FDD_ENB_TIMER_STATE_N_ITEMS][20] = {"free",
+                                                                                       "active",
+                                                                                       "firing",
+                                                                                       "stopped"};
+
+typedef struct LTE_FDD_ENB_TIMER_NODE_STRUCT{
+    struct LTE_FDD_ENB_TIMER_NODE_STRUCT  *prev;
+    struct LTE_FDD_ENB_TIMER_NODE_STRUCT  *next;
+    struct LTE_FDD_ENB_TIMER_NODE_STRUCT **slot;
+    LTE_fdd_enb_timer_cb                   cb;
+    uint64                                 expiry_tick;
+    uint32                                 id;
+    LTE_FDD_ENB_TIMER_STATE_ENUM           state;
+}LTE_FDD_ENB_TIMER_NODE_STRUCT;
+
 
 /*******************************************************************************
                               CLASS DECLARATIONS
@@ -70,6 +117,9 @@ public:
     LTE_FDD_ENB_ERROR_ENUM start_timer(uint32 m_seconds, LTE_fdd_enb_timer_cb cb, uint32 *timer_id);
     LTE_FDD_ENB_ERROR_ENUM stop_timer(uint32 timer_id);
     void handle_tick(void);
+    uint32 get_n_timers(void);
+    void lock_callbacks(void);
+    void unlock_callbacks(void);
 
 private:
     // Singleton
@@ -78,9 +128,22 @@ private:
     ~LTE_fdd_enb_timer_mgr();
 
     // Timer Storage
-    boost::mutex                         timer_mutex;
-    std::map<uint32, LTE_fdd_enb_timer*> timer_map;
-    uint32                               next_timer_id;
+    LTE_FDD_ENB_TIMER_NODE_STRUCT* find_node(uint32 timer_id);
+    LTE_FDD_ENB_TIMER_NODE_STRUCT* alloc_node(void);
+    void free_node(LTE_FDD_ENB_TIMER_NODE_STRUCT *node);
+    boost::mutex                                 timer_mutex;
+    boost::mutex                                 callback_mutex;
+    std::vector<LTE_FDD_ENB_TIMER_NODE_STRUCT *> node_chunks;
+    LTE_FDD_ENB_TIMER_NODE_STRUCT               *free_list;
+    uint32                                       N_nodes;
+    uint32                                       N_timers;
+
+    // Timing Wheel
+    void insert_node(LTE_FDD_ENB_TIMER_NODE_STRUCT *node);
+    void remove_node(LTE_FDD_ENB_TIMER_NODE_STRUCT *node);
+    void cascade(uint32 level, uint32 slot);
+    LTE_FDD_ENB_TIMER_NODE_STRUCT *wheel[LTE_FDD_ENB_TIMER_MGR_N_LEVELS][LTE_FDD_ENB_TIMER_MGR_N_SLOTS];
+    uint64                         current_tick;
 };
 
 #endif /* __LTE_FDD_ENB_TIMER_MGR_H__ */
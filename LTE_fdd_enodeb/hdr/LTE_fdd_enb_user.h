@@ -27,6 +27,10 @@
     11/09/2013    Ben Wojtowicz    Created file
     05/04/2014    Ben Wojtowicz    Added radio bearer support.
     06/15/2014    Ben Wojtowicz    Added initialize routine.
+    10/19/2026    agent            Added DL channel quality and average
+                                   throughput tracking for the MAC scheduler.
+    10/19/2026    agent            Added per LCG UL buffer status and UL
+                                   polling for the MAC scheduler.
 
 *******************************************************************************/
 
@@ -47,6 +51,11 @@
                               DEFINES
 *******************************************************************************/
 
+// DL scheduling metrics
+#define LTE_FDD_ENB_USER_DEFAULT_DL_CQI 7
+
+// UL buffer status
+#define LTE_FDD_ENB_USER_N_LCGS 4
 
 /*******************************************************************************
                               FORWARD DECLARATIONS
@@ -88,6 +97,20 @@ public:
 
     // MAC
     LIBLTE_MAC_PDU_STRUCT pusch_mac_pdu;
+    void set_dl_cqi(uint8 cqi);
+    uint8 get_dl_cqi(void);
+    void set_dl_avg_thru(float avg_thru, uint32 current_tti);
+    float get_dl_avg_thru(void);
+    uint32 get_dl_avg_thru_tti(void);
+    void set_dl_last_sched_tti(uint32 current_tti);
+    uint32 get_dl_last_sched_tti(void);
+    void set_ul_buffer_size(uint8 lcg_id, uint32 N_bytes);
+    uint32 get_ul_buffer_size(void);
+    void update_ul_buffer_size(uint32 current_tti, uint32 N_granted_bytes);
+    uint32 get_ul_last_sched_tti(void);
+    void set_ul_poll(uint32 period, uint32 N_bits);
+    uint32 get_ul_poll_period(void);
+    uint32 get_ul_poll_bits(void);
 
 private:
     // Identity
@@ -99,6 +122,16 @@ private:
     LTE_fdd_enb_rb *srb1;
     LTE_fdd_enb_rb *srb2;
     LTE_fdd_enb_rb *drb[8];
+
+    // MAC
+    float  dl_avg_thru;
+    uint32 dl_avg_thru_tti;
+    uint32 dl_last_sched_tti;
+    uint32 ul_buffer_size[LTE_FDD_ENB_USER_N_LCGS];
+    uint32 ul_last_sched_tti;
+    uint32 ul_poll_period;
+    uint32 ul_poll_bits;
+    uint8  dl_cqi;
 };
 
 #endif /* __LTE_FDD_ENB_USER_H__ */
@@ -26,6 +26,8 @@
     ----------    -------------    --------------------------------------------
     11/09/2013    Ben Wojtowicz    Created file
     05/04/2014    Ben Wojtowicz    Added C-RNTI timeout timers.
+    10/19/2026    agent            Added a lock free C-RNTI table, a C-RNTI
+                                   allocation bitmap, and an IMSI hash index.
 
 *******************************************************************************/
 
@@ -39,12 +41,15 @@
 #include "LTE_fdd_enb_interface.h"
 #include "LTE_fdd_enb_user.h"
 #include <boost/thread/mutex.hpp>
+#include <boost/unordered_map.hpp>
 #include <string>
 
 /*******************************************************************************
                               DEFINES
 *******************************************************************************/
 
+#define LTE_FDD_ENB_USER_MGR_N_C_RNTIS        65536
+#define LTE_FDD_ENB_USER_MGR_N_C_RNTI_WORDS   (LTE_FDD_ENB_USER_MGR_N_C_RNTIS / 64)
 
 /*******************************************************************************
                               FORWARD DECLARATIONS
@@ -87,14 +92,18 @@ private:
     // C-RNTI Timer
     void handle_c_rnti_timer_expiry(uint32 timer_id);
 
+    // User retirement
+    void retire_user(LTE_fdd_enb_user *user);
+
     // User storage
-    std::map<std::string, LTE_fdd_enb_user*> user_map;
-    std::map<uint16, LTE_fdd_enb_user*>      c_rnti_map;
-    std::map<uint32, uint16>                 timer_id_map;
-    boost::mutex                             user_mutex;
-    boost::mutex                             c_rnti_mutex;
-    boost::mutex                             timer_id_mutex;
-    uint16                                   next_c_rnti;
+    boost::unordered_map<std::string, LTE_fdd_enb_user*>  user_map;
+    std::map<uint32, uint16>                              timer_id_map;
+    LTE_fdd_enb_user                            *volatile c_rnti_table[LTE_FDD_ENB_USER_MGR_N_C_RNTIS];
+    uint64                                                c_rnti_bitmap[LTE_FDD_ENB_USER_MGR_N_C_RNTI_WORDS];
+    boost::mutex                                          user_mutex;
+    boost::mutex                                          c_rnti_mutex;
+    boost::mutex                                          timer_id_mutex;
+    uint16                                                next_c_rnti;
 };
 
 #endif /* __LTE_FDD_ENB_USER_MGR_H__ */
@@ -32,6 +32,10 @@
     03/26/2014    Ben Wojtowicz    Using the latest LTE library.
     05/04/2014    Ben Wojtowicz    Added PCAP support.
     06/15/2014    Ben Wojtowicz    Omitting path from __FILE__.
+    10/19/2026    agent            Added the DL scheduling policy.
+    10/19/2026    agent            Passing PCAP enable to LTE_fdd_enb_pcap.
+    10/19/2026    agent            Publishing parameters and system information
+                                   as immutable, versioned snapshots.
 
 *******************************************************************************/
 
@@ -47,10 +51,12 @@
 #include "LTE_fdd_enb_pdcp.h"
 #include "LTE_fdd_enb_rrc.h"
 #include "LTE_fdd_enb_mme.h"
+#include "LTE_fdd_enb_pcap.h"
 #include "liblte_mac.h"
 #include "liblte_interface.h"
 #include <boost/thread/mutex.hpp>
 #include <boost/lexical_cast.hpp>
+#include <math.h>
 
 /*******************************************************************************
                               DEFINES
@@ -103,46 +109,98 @@ void LTE_fdd_enb_cnfg_db::cleanup(void)
 /********************************/
 LTE_fdd_enb_cnfg_db::LTE_fdd_enb_cnfg_db()
 {
+    LTE_FDD_ENB_CNFG_PARAMS_STRUCT *params = new LTE_FDD_ENB_CNFG_PARAMS_STRUCT;
+
     // Parameter initialization
-    var_map_double[LTE_FDD_ENB_PARAM_BANDWIDTH]                = 10.0;
-    var_map_int64[LTE_FDD_ENB_PARAM_FREQ_BAND]                 = 0;
-    var_map_int64[LTE_FDD_ENB_PARAM_DL_EARFCN]                 = liblte_interface_first_dl_earfcn[0];
-    var_map_int64[LTE_FDD_ENB_PARAM_UL_EARFCN]                 = liblte_interface_get_corresponding_ul_earfcn(liblte_interface_first_dl_earfcn[0]);
-    var_map_int64[LTE_FDD_ENB_PARAM_N_RB_DL]                   = LIBLTE_PHY_N_RB_DL_10MHZ;
-    var_map_int64[LTE_FDD_ENB_PARAM_N_RB_UL]                   = LIBLTE_PHY_N_RB_UL_10MHZ;
-    var_map_int64[LTE_FDD_ENB_PARAM_DL_BW]                     = LIBLTE_RRC_DL_BANDWIDTH_50;
-    var_map_int64[LTE_FDD_ENB_PARAM_N_SC_RB_DL]                = LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP;
-    var_map_int64[LTE_FDD_ENB_PARAM_N_SC_RB_UL]                = LIBLTE_PHY_N_SC_RB_UL;
-    var_map_int64[LTE_FDD_ENB_PARAM_N_ANT]                     = 1;
-    var_map_int64[LTE_FDD_ENB_PARAM_N_ID_CELL]                 = 0;
-    var_map_int64[LTE_FDD_ENB_PARAM_N_ID_2]                    = 0;
-    var_map_int64[LTE_FDD_ENB_PARAM_N_ID_1]                    = 0;
-    var_map_uint32[LTE_FDD_ENB_PARAM_MCC]                      = 0xFFFFF001;
-    var_map_uint32[LTE_FDD_ENB_PARAM_MNC]                      = 0xFFFFFF01;
-    var_map_int64[LTE_FDD_ENB_PARAM_CELL_ID]                   = 1;
-    var_map_int64[LTE_FDD_ENB_PARAM_TRACKING_AREA_CODE]        = 1;
-    var_map_int64[LTE_FDD_ENB_PARAM_Q_RX_LEV_MIN]              = -140;
-    var_map_int64[LTE_FDD_ENB_PARAM_P0_NOMINAL_PUSCH]          = -70;
-    var_map_int64[LTE_FDD_ENB_PARAM_P0_NOMINAL_PUCCH]          = -96;
-    var_map_int64[LTE_FDD_ENB_PARAM_SIB3_PRESENT]              = 0;
-    var_map_int64[LTE_FDD_ENB_PARAM_Q_HYST]                    = LIBLTE_RRC_Q_HYST_DB_0;
-    var_map_int64[LTE_FDD_ENB_PARAM_SIB4_PRESENT]              = 0;
-    var_map_int64[LTE_FDD_ENB_PARAM_SIB5_PRESENT]              = 0;
-    var_map_int64[LTE_FDD_ENB_PARAM_SIB6_PRESENT]              = 0;
-    var_map_int64[LTE_FDD_ENB_PARAM_SIB7_PRESENT]              = 0;
-    var_map_int64[LTE_FDD_ENB_PARAM_SIB8_PRESENT]              = 0;
-    var_map_int64[LTE_FDD_ENB_PARAM_SEARCH_WIN_SIZE]           = 0;
-    var_map_uint32[LTE_FDD_ENB_PARAM_SYSTEM_INFO_VALUE_TAG]    = 1;
-    var_map_int64[LTE_FDD_ENB_PARAM_SYSTEM_INFO_WINDOW_LENGTH] = LIBLTE_RRC_SI_WINDOW_LENGTH_MS1;
-    var_map_int64[LTE_FDD_ENB_PARAM_PHICH_RESOURCE]            = LIBLTE_RRC_PHICH_RESOURCE_1;
-    var_map_int64[LTE_FDD_ENB_PARAM_N_SCHED_INFO]              = 1;
-    var_map_int64[LTE_FDD_ENB_PARAM_SYSTEM_INFO_PERIODICITY]   = LIBLTE_RRC_SI_PERIODICITY_RF8;
-    var_map_uint32[LTE_FDD_ENB_PARAM_DEBUG_TYPE]               = 0xFFFFFFFF;
-    var_map_uint32[LTE_FDD_ENB_PARAM_DEBUG_LEVEL]              = 0xFFFFFFFF;
-    var_map_int64[LTE_FDD_ENB_PARAM_ENABLE_PCAP]               = 0;
+    memset(params, 0, sizeof(LTE_FDD_ENB_CNFG_PARAMS_STRUCT));
+    params->double_value[LTE_FDD_ENB_PARAM_BANDWIDTH]                = 10.0;
+    params->int64_value[LTE_FDD_ENB_PARAM_FREQ_BAND]                 = 0;
+    params->int64_value[LTE_FDD_ENB_PARAM_DL_EARFCN]                 = liblte_interface_first_dl_earfcn[0];
+    params->int64_value[LTE_FDD_ENB_PARAM_UL_EARFCN]                 = liblte_interface_get_corresponding_ul_earfcn(liblte_interface_first_dl_earfcn[0]);
+    params->int64_value[LTE_FDD_ENB_PARAM_N_RB_DL]                   = LIBLTE_PHY_N_RB_DL_10MHZ;
+    params->int64_value[LTE_FDD_ENB_PARAM_N_RB_UL]                   = LIBLTE_PHY_N_RB_UL_10MHZ;
+    params->int64_value[LTE_FDD_ENB_PARAM_DL_BW]                     = LIBLTE_RRC_DL_BANDWIDTH_50;
+    params->int64_value[LTE_FDD_ENB_PARAM_N_SC_RB_DL]                = LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP;
+    params->int64_value[LTE_FDD_ENB_PARAM_N_SC_RB_UL]                = LIBLTE_PHY_N_SC_RB_UL;
+    params->int64_value[LTE_FDD_ENB_PARAM_N_ANT]                     = 1;
+    params->int64_value[LTE_FDD_ENB_PARAM_N_ID_CELL]                 = 0;
+    params->int64_value[LTE_FDD_ENB_PARAM_N_ID_2]                    = 0;
+    params->int64_value[LTE_FDD_ENB_PARAM_N_ID_1]                    = 0;
+    params->uint32_value[LTE_FDD_ENB_PARAM_MCC]                      = 0xFFFFF001;
+    params->uint32_value[LTE_FDD_ENB_PARAM_MNC]                      = 0xFFFFFF01;
+    params->int64_value[LTE_FDD_ENB_PARAM_CELL_ID]                   = 1;
+    params->int64_value[LTE_FDD_ENB_PARAM_TRACKING_AREA_CODE]        = 1;
+    params->int64_value[LTE_FDD_ENB_PARAM_Q_RX_LEV_MIN]              = -140;
+    params->int64_value[LTE_FDD_ENB_PARAM_P0_NOMINAL_PUSCH]          = -70;
+    params->int64_value[LTE_FDD_ENB_PARAM_P0_NOMINAL_PUCCH]          = -96;
+    params->int64_value[LTE_FDD_ENB_PARAM_SIB3_PRESENT]              = 0;
+    params->int64_value[LTE_FDD_ENB_PARAM_Q_HYST]                    = LIBLTE_RRC_Q_HYST_DB_0;
+    params->int64_value[LTE_FDD_ENB_PARAM_SIB4_PRESENT]              = 0;
+    params->int64_value[LTE_FDD_ENB_PARAM_SIB5_PRESENT]              = 0;
+    params->int64_value[LTE_FDD_ENB_PARAM_SIB6_PRESENT]              = 0;
+    params->int64_value[LTE_FDD_ENB_PARAM_SIB7_PRESENT]              = 0;
+    params->int64_value[LTE_FDD_ENB_PARAM_SIB8_PRESENT]              = 0;
+    params->int64_value[LTE_FDD_ENB_PARAM_SEARCH_WIN_SIZE]           = 0;
+    params->uint32_value[LTE_FDD_ENB_PARAM_SYSTEM_INFO_VALUE_TAG]    = 1;
+    params->int64_value[LTE_FDD_ENB_PARAM_SYSTEM_INFO_WINDOW_LENGTH] = LIBLTE_RRC_SI_WINDOW_LENGTH_MS1;
+    params->int64_value[LTE_FDD_ENB_PARAM_PHICH_RESOURCE]            = LIBLTE_RRC_PHICH_RESOURCE_1;
+    params->int64_value[LTE_FDD_ENB_PARAM_N_SCHED_INFO]              = 1;
+    params->int64_value[LTE_FDD_ENB_PARAM_SYSTEM_INFO_PERIODICITY]   = LIBLTE_RRC_SI_PERIODICITY_RF8;
+    params->uint32_value[LTE_FDD_ENB_PARAM_DEBUG_TYPE]               = 0xFFFFFFFF;
+    params->uint32_value[LTE_FDD_ENB_PARAM_DEBUG_LEVEL]              = 0xFFFFFFFF;
+    params->int64_value[LTE_FDD_ENB_PARAM_ENABLE_PCAP]               = 0;
+    params->int64_value[LTE_FDD_ENB_PARAM_DL_SCHED_POLICY]           = LTE_FDD_ENB_DL_SCHED_POLICY_PROPORTIONAL_FAIR;
+    params->type[LTE_FDD_ENB_PARAM_BANDWIDTH]                        = LTE_FDD_ENB_CNFG_TYPE_DOUBLE;
+    params->type[LTE_FDD_ENB_PARAM_FREQ_BAND]                        = LTE_FDD_ENB_CNFG_TYPE_INT64;
+    params->type[LTE_FDD_ENB_PARAM_DL_EARFCN]                        = LTE_FDD_ENB_CNFG_TYPE_INT64;
+    params->type[LTE_FDD_ENB_PARAM_UL_EARFCN]                        = LTE_FDD_ENB_CNFG_TYPE_INT64;
+    params->type[LTE_FDD_ENB_PARAM_N_RB_DL]                          = LTE_FDD_ENB_CNFG_TYPE_INT64;
+    params->type[LTE_FDD_ENB_PARAM_N_RB_UL]                          = LTE_FDD_ENB_CNFG_TYPE_INT64;
+    params->type[LTE_FDD_ENB_PARAM_DL_BW]                            = LTE_FDD_ENB_CNFG_TYPE_INT64;
+    params->type[LTE_FDD_ENB_PARAM_N_SC_RB_DL]                       = LTE_FDD_ENB_CNFG_TYPE_INT64;
+    params->type[LTE_FDD_ENB_PARAM_N_SC_RB_UL]                       = LTE_FDD_ENB_CNFG_TYPE_INT64;
+    params->type[LTE_FDD_ENB_PARAM_N_ANT]                            = LTE_FDD_ENB_CNFG_TYPE_INT64;
+    params->type[LTE_FDD_ENB_PARAM_N_ID_CELL]                        = LTE_FDD_ENB_CNFG_TYPE_INT64;
+    params->type[LTE_FDD_ENB_PARAM_N_ID_2]                           = LTE_FDD_ENB_CNFG_TYPE_INT64;
+    params->type[LTE_FDD_ENB_PARAM_N_ID_1]                           = LTE_FDD_ENB_CNFG_TYPE_INT64;
+    params->type[LTE_FDD_ENB_PARAM_MCC]                              = LTE_FDD_ENB_CNFG_TYPE_UINT32;
+    params->type[LTE_FDD_ENB_PARAM_MNC]                              = LTE_FDD_ENB_CNFG_TYPE_UINT32;
+    params->type[LTE_FDD_ENB_PARAM_CELL_ID]                          = LTE_FDD_ENB_CNFG_TYPE_INT64;
+    params->type[LTE_FDD_ENB_PARAM_TRACKING_AREA_CODE]               = LTE_FDD_ENB_CNFG_TYPE_INT64;
+    params->type[LTE_FDD_ENB_PARAM_Q_RX_LEV_MIN]                     = LTE_FDD_ENB_CNFG_TYPE_INT64;
+    params->type[LTE_FDD_ENB_PARAM_P0_NOMINAL_PUSCH]                 = LTE_FDD_ENB_CNFG_TYPE_INT64;
+    params->type[LTE_FDD_ENB_PARAM_P0_NOMINAL_PUCCH]                 = LTE_FDD_ENB_CNFG_TYPE_INT64;
+    params->type[LTE_FDD_ENB_PARAM_SIB3_PRESENT]                     = LTE_FDD_ENB_CNFG_TYPE_INT64;
+    params->type[LTE_FDD_ENB_PARAM_Q_HYST]                           = LTE_FDD_ENB_CNFG_TYPE_INT64;
+    params->type[LTE_FDD_ENB_PARAM_SIB4_PRESENT]                     = LTE_FDD_ENB_CNFG_TYPE_INT64;
+    params->type[LTE_FDD_ENB_PARAM_SIB5_PRESENT]                     = LTE_FDD_ENB_CNFG_TYPE_INT64;
+    params->type[LTE_FDD_ENB_PARAM_SIB6_PRESENT]                     = LTE_FDD_ENB_CNFG_TYPE_INT64;
+    params->type[LTE_FDD_ENB_PARAM_SIB7_PRESENT]                     = LTE_FDD_ENB_CNFG_TYPE_INT64;
+    params->type[LTE_FDD_ENB_PARAM_SIB8_PRESENT]                     = LTE_FDD_ENB_CNFG_TYPE_INT64;
+    params->type[LTE_FDD_ENB_PARAM_SEARCH_WIN_SIZE]                  = LTE_FDD_ENB_CNFG_TYPE_INT64;
+    params->type[LTE_FDD_ENB_PARAM_SYSTEM_INFO_VALUE_TAG]            = LTE_FDD_ENB_CNFG_TYPE_UINT32;
+    params->type[LTE_FDD_ENB_PARAM_SYSTEM_INFO_WINDOW_LENGTH]        = LTE_FDD_ENB_CNFG_TYPE_INT64;
+    params->type[LTE_FDD_ENB_PARAM_PHICH_RESOURCE]                   = LTE_FDD_ENB_CNFG_TYPE_INT64;
+    params->type[LTE_FDD_ENB_PARAM_N_SCHED_INFO]                     = LTE_FDD_ENB_CNFG_TYPE_INT64;
+    params->type[LTE_FDD_ENB_PARAM_SYSTEM_INFO_PERIODICITY]          = LTE_FDD_ENB_CNFG_TYPE_INT64;
+    params->type[LTE_FDD_ENB_PARAM_DEBUG_TYPE]                       = LTE_FDD_ENB_CNFG_TYPE_UINT32;
+    params->type[LTE_FDD_ENB_PARAM_DEBUG_LEVEL]                      = LTE_FDD_ENB_CNFG_TYPE_UINT32;
+    params->type[LTE_FDD_ENB_PARAM_ENABLE_PCAP]                      = LTE_FDD_ENB_CNFG_TYPE_INT64;
+    params->type[LTE_FDD_ENB_PARAM_DL_SCHED_POLICY]                  = LTE_FDD_ENB_CNFG_TYPE_INT64;
+    params->version                                                  = 1;
+    cur_params                                                       = params;
+
+    // System information initialization
+    cur_sys_info = new LTE_FDD_ENB_SYS_INFO_STRUCT;
+    memset(cur_sys_info, 0, sizeof(LTE_FDD_ENB_SYS_INFO_STRUCT));
+
+    // Snapshot reclamation
+    epoch_mgr = LTE_fdd_enb_epoch_mgr::get_instance();
 }
 LTE_fdd_enb_cnfg_db::~LTE_fdd_enb_cnfg_db()
 {
+    delete cur_params;
+    delete cur_sys_info;
 }
 
 /*****************************/
@@ -151,24 +209,32 @@ LTE_fdd_enb_cnfg_db::~LTE_fdd_enb_cnfg_db()
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_cnfg_db::set_param(LTE_FDD_ENB_PARAM_ENUM param,
                                                       int64                  value)
 {
-    LTE_fdd_enb_radio                                 *radio = LTE_fdd_enb_radio::get_instance();
-    std::map<LTE_FDD_ENB_PARAM_ENUM, int64>::iterator  iter  = var_map_int64.find(param);
-    LTE_FDD_ENB_ERROR_ENUM                             err   = LTE_FDD_ENB_ERROR_INVALID_PARAM;
+    boost::mutex::scoped_lock       lock(params_mutex);
+    LTE_fdd_enb_radio              *radio = LTE_fdd_enb_radio::get_instance();
+    LTE_fdd_enb_pcap               *pcap  = LTE_fdd_enb_pcap::get_instance();
+    LTE_FDD_ENB_CNFG_PARAMS_STRUCT *new_params;
+    LTE_FDD_ENB_ERROR_ENUM          err   = LTE_FDD_ENB_ERROR_INVALID_PARAM;
 
-    if(var_map_int64.end() != iter)
+    if(LTE_FDD_ENB_PARAM_N_ITEMS     > param &&
+       LTE_FDD_ENB_CNFG_TYPE_INT64 == cur_params->type[param])
     {
-        (*iter).second = value;
-        err            = LTE_FDD_ENB_ERROR_NONE;
+        new_params                     = copy_params();
+        new_params->int64_value[param] = value;
+        err                            = LTE_FDD_ENB_ERROR_NONE;
 
         // Set any related parameters
         if(LTE_FDD_ENB_PARAM_N_ID_CELL == param)
         {
-            set_param(LTE_FDD_ENB_PARAM_N_ID_2, value % 3);
-            set_param(LTE_FDD_ENB_PARAM_N_ID_1, (value - (value % 3))/3);
+            new_params->int64_value[LTE_FDD_ENB_PARAM_N_ID_2] = value % 3;
+            new_params->int64_value[LTE_FDD_ENB_PARAM_N_ID_1] = (value - (value % 3))/3;
         }else if(LTE_FDD_ENB_PARAM_DL_EARFCN == param){
-            set_param(LTE_FDD_ENB_PARAM_UL_EARFCN, (int64)liblte_interface_get_corresponding_ul_earfcn(value));
+            new_params->int64_value[LTE_FDD_ENB_PARAM_UL_EARFCN] = liblte_interface_get_corresponding_ul_earfcn(value);
             radio->set_earfcns(value, (int64)liblte_interface_get_corresponding_ul_earfcn(value));
+        }else if(LTE_FDD_ENB_PARAM_ENABLE_PCAP == param){
+            pcap->set_enable(0 != value);
         }
+
+        publish_params(new_params);
     }
 
     return(err);
@@ -176,44 +242,49 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_cnfg_db::set_param(LTE_FDD_ENB_PARAM_ENUM par
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_cnfg_db::set_param(LTE_FDD_ENB_PARAM_ENUM param,
                                                       double                 value)
 {
-    std::map<LTE_FDD_ENB_PARAM_ENUM, double>::iterator iter = var_map_double.find(param);
-    LTE_FDD_ENB_ERROR_ENUM                             err  = LTE_FDD_ENB_ERROR_INVALID_PARAM;
+    boost::mutex::scoped_lock       lock(params_mutex);
+    LTE_FDD_ENB_CNFG_PARAMS_STRUCT *new_params;
+    LTE_FDD_ENB_ERROR_ENUM          err = LTE_FDD_ENB_ERROR_INVALID_PARAM;
 
-    if(var_map_double.end() != iter)
+    if(LTE_FDD_ENB_PARAM_N_ITEMS      > param &&
+       LTE_FDD_ENB_CNFG_TYPE_DOUBLE == cur_params->type[param])
     {
-        (*iter).second = value;
-        err            = LTE_FDD_ENB_ERROR_NONE;
+        new_params                      = copy_params();
+        new_params->double_value[param] = value;
+        err                             = LTE_FDD_ENB_ERROR_NONE;
 
         // Set any related parameters
         if(LTE_FDD_ENB_PARAM_BANDWIDTH == param)
         {
             if(value == 20)
             {
-                set_param(LTE_FDD_ENB_PARAM_N_RB_DL, (int64)LIBLTE_PHY_N_RB_DL_20MHZ);
-                set_param(LTE_FDD_ENB_PARAM_N_RB_UL, (int64)LIBLTE_PHY_N_RB_UL_20MHZ);
-                set_param(LTE_FDD_ENB_PARAM_DL_BW,   (int64)LIBLTE_RRC_DL_BANDWIDTH_100);
+                new_params->int64_value[LTE_FDD_ENB_PARAM_N_RB_DL] = LIBLTE_PHY_N_RB_DL_20MHZ;
+                new_params->int64_value[LTE_FDD_ENB_PARAM_N_RB_UL] = LIBLTE_PHY_N_RB_UL_20MHZ;
+                new_params->int64_value[LTE_FDD_ENB_PARAM_DL_BW]   = LIBLTE_RRC_DL_BANDWIDTH_100;
             }else if(value == 15){
-                set_param(LTE_FDD_ENB_PARAM_N_RB_DL, (int64)LIBLTE_PHY_N_RB_DL_15MHZ);
-                set_param(LTE_FDD_ENB_PARAM_N_RB_UL, (int64)LIBLTE_PHY_N_RB_UL_15MHZ);
-                set_param(LTE_FDD_ENB_PARAM_DL_BW,   (int64)LIBLTE_RRC_DL_BANDWIDTH_75);
+                new_params->int64_value[LTE_FDD_ENB_PARAM_N_RB_DL] = LIBLTE_PHY_N_RB_DL_15MHZ;
+                new_params->int64_value[LTE_FDD_ENB_PARAM_N_RB_UL] = LIBLTE_PHY_N_RB_UL_15MHZ;
+                new_params->int64_value[LTE_FDD_ENB_PARAM_DL_BW]   = LIBLTE_RRC_DL_BANDWIDTH_75;
             }else if(value == 10){
-                set_param(LTE_FDD_ENB_PARAM_N_RB_DL, (int64)LIBLTE_PHY_N_RB_DL_10MHZ);
-                set_param(LTE_FDD_ENB_PARAM_N_RB_UL, (int64)LIBLTE_PHY_N_RB_UL_10MHZ);
-                set_param(LTE_FDD_ENB_PARAM_DL_BW,   (int64)LIBLTE_RRC_DL_BANDWIDTH_50);
+                new_params->int64_value[LTE_FDD_ENB_PARAM_N_RB_DL] = LIBLTE_PHY_N_RB_DL_10MHZ;
+                new_params->int64_value[LTE_FDD_ENB_PARAM_N_RB_UL] = LIBLTE_PHY_N_RB_UL_10MHZ;
+                new_params->int64_value[LTE_FDD_ENB_PARAM_DL_BW]   = LIBLTE_RRC_DL_BANDWIDTH_50;
             }else if(value == 5){
-                set_param(LTE_FDD_ENB_PARAM_N_RB_DL, (int64)LIBLTE_PHY_N_RB_DL_5MHZ);
-                set_param(LTE_FDD_ENB_PARAM_N_RB_UL, (int64)LIBLTE_PHY_N_RB_UL_5MHZ);
-                set_param(LTE_FDD_ENB_PARAM_DL_BW,   (int64)LIBLTE_RRC_DL_BANDWIDTH_25);
+                new_params->int64_value[LTE_FDD_ENB_PARAM_N_RB_DL] = LIBLTE_PHY_N_RB_DL_5MHZ;
+                new_params->int64_value[LTE_FDD_ENB_PARAM_N_RB_UL] = LIBLTE_PHY_N_RB_UL_5MHZ;
+                new_params->int64_value[LTE_FDD_ENB_PARAM_DL_BW]   = LIBLTE_RRC_DL_BANDWIDTH_25;
             }else if(value == 3){
-                set_param(LTE_FDD_ENB_PARAM_N_RB_DL, (int64)LIBLTE_PHY_N_RB_DL_3MHZ);
-                set_param(LTE_FDD_ENB_PARAM_N_RB_UL, (int64)LIBLTE_PHY_N_RB_UL_3MHZ);
-                set_param(LTE_FDD_ENB_PARAM_DL_BW,   (int64)LIBLTE_RRC_DL_BANDWIDTH_15);
+                new_params->int64_value[LTE_FDD_ENB_PARAM_N_RB_DL] = LIBLTE_PHY_N_RB_DL_3MHZ;
+                new_params->int64_value[LTE_FDD_ENB_PARAM_N_RB_UL] = LIBLTE_PHY_N_RB_UL_3MHZ;
+                new_params->int64_value[LTE_FDD_ENB_PARAM_DL_BW]   = LIBLTE_RRC_DL_BANDWIDTH_15;
             }else{
-                set_param(LTE_FDD_ENB_PARAM_N_RB_DL, (int64)LIBLTE_PHY_N_RB_DL_1_4MHZ);
-                set_param(LTE_FDD_ENB_PARAM_N_RB_UL, (int64)LIBLTE_PHY_N_RB_UL_1_4MHZ);
-                set_param(LTE_FDD_ENB_PARAM_DL_BW,   (int64)LIBLTE_RRC_DL_BANDWIDTH_6);
+                new_params->int64_value[LTE_FDD_ENB_PARAM_N_RB_DL] = LIBLTE_PHY_N_RB_DL_1_4MHZ;
+                new_params->int64_value[LTE_FDD_ENB_PARAM_N_RB_UL] = LIBLTE_PHY_N_RB_UL_1_4MHZ;
+                new_params->int64_value[LTE_FDD_ENB_PARAM_DL_BW]   = LIBLTE_RRC_DL_BANDWIDTH_6;
             }
         }
+
+        publish_params(new_params);
     }
 
     return(err);
@@ -221,19 +292,24 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_cnfg_db::set_param(LTE_FDD_ENB_PARAM_ENUM par
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_cnfg_db::set_param(LTE_FDD_ENB_PARAM_ENUM param,
                                                       std::string            value)
 {
-    std::map<LTE_FDD_ENB_PARAM_ENUM, uint32>::iterator iter = var_map_uint32.find(param);
-    LTE_FDD_ENB_ERROR_ENUM                             err  = LTE_FDD_ENB_ERROR_INVALID_PARAM;
-    uint32                                             i;
+    boost::mutex::scoped_lock       lock(params_mutex);
+    LTE_FDD_ENB_CNFG_PARAMS_STRUCT *new_params;
+    LTE_FDD_ENB_ERROR_ENUM          err = LTE_FDD_ENB_ERROR_INVALID_PARAM;
+    uint32                          i;
 
-    if(var_map_uint32.end() != iter)
+    if(LTE_FDD_ENB_PARAM_N_ITEMS      > param &&
+       LTE_FDD_ENB_CNFG_TYPE_UINT32 == cur_params->type[param])
     {
-        (*iter).second = 0xFFFFFFFF;
+        new_params                      = copy_params();
+        new_params->uint32_value[param] = 0xFFFFFFFF;
         for(i=0; i<value.length(); i++)
         {
-            (*iter).second <<= 4;
-            (*iter).second  |= (value[i] & 0x0F);
+            new_params->uint32_value[param] <<= 4;
+            new_params->uint32_value[param]  |= (value[i] & 0x0F);
         }
         err = LTE_FDD_ENB_ERROR_NONE;
+
+        publish_params(new_params);
     }
 
     return(err);
@@ -241,13 +317,18 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_cnfg_db::set_param(LTE_FDD_ENB_PARAM_ENUM par
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_cnfg_db::set_param(LTE_FDD_ENB_PARAM_ENUM param,
                                                       uint32                 value)
 {
-    std::map<LTE_FDD_ENB_PARAM_ENUM, uint32>::iterator iter = var_map_uint32.find(param);
-    LTE_FDD_ENB_ERROR_ENUM                             err  = LTE_FDD_ENB_ERROR_INVALID_PARAM;
+    boost::mutex::scoped_lock       lock(params_mutex);
+    LTE_FDD_ENB_CNFG_PARAMS_STRUCT *new_params;
+    LTE_FDD_ENB_ERROR_ENUM          err = LTE_FDD_ENB_ERROR_INVALID_PARAM;
 
-    if(var_map_uint32.end() != iter)
+    if(LTE_FDD_ENB_PARAM_N_ITEMS      > param &&
+       LTE_FDD_ENB_CNFG_TYPE_UINT32 == cur_params->type[param])
     {
-        (*iter).second = value;
-        err            = LTE_FDD_ENB_ERROR_NONE;
+        new_params                      = copy_params();
+        new_params->uint32_value[param] = value;
+        err                             = LTE_FDD_ENB_ERROR_NONE;
+
+        publish_params(new_params);
     }
 
     return(err);
@@ -255,47 +336,57 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_cnfg_db::set_param(LTE_FDD_ENB_PARAM_ENUM par
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_cnfg_db::get_param(LTE_FDD_ENB_PARAM_ENUM  param,
                                                       int64                  &value)
 {
-    std::map<LTE_FDD_ENB_PARAM_ENUM, int64>::iterator iter = var_map_int64.find(param);
-    LTE_FDD_ENB_ERROR_ENUM                            err  = LTE_FDD_ENB_ERROR_INVALID_PARAM;
+    uint64                          epoch  = epoch_mgr->pin();
+    LTE_FDD_ENB_CNFG_PARAMS_STRUCT *params = cur_params;
+    LTE_FDD_ENB_ERROR_ENUM          err    = LTE_FDD_ENB_ERROR_INVALID_PARAM;
 
-    if(var_map_int64.end() != iter)
+    if(LTE_FDD_ENB_PARAM_N_ITEMS     > param &&
+       LTE_FDD_ENB_CNFG_TYPE_INT64 == params->type[param])
     {
-        value = (*iter).second;
+        value = params->int64_value[param];
         err   = LTE_FDD_ENB_ERROR_NONE;
     }
 
+    epoch_mgr->unpin(epoch);
+
     return(err);
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_cnfg_db::get_param(LTE_FDD_ENB_PARAM_ENUM  param,
                                                       double                 &value)
 {
-    std::map<LTE_FDD_ENB_PARAM_ENUM, double>::iterator iter = var_map_double.find(param);
-    LTE_FDD_ENB_ERROR_ENUM                             err  = LTE_FDD_ENB_ERROR_INVALID_PARAM;
+    uint64                          epoch  = epoch_mgr->pin();
+    LTE_FDD_ENB_CNFG_PARAMS_STRUCT *params = cur_params;
+    LTE_FDD_ENB_ERROR_ENUM          err    = LTE_FDD_ENB_ERROR_INVALID_PARAM;
 
-    if(var_map_double.end() != iter)
+    if(LTE_FDD_ENB_PARAM_N_ITEMS      > param &&
+       LTE_FDD_ENB_CNFG_TYPE_DOUBLE == params->type[param])
     {
-        value = (*iter).second;
+        value = params->double_value[param];
         err   = LTE_FDD_ENB_ERROR_NONE;
     }
 
+    epoch_mgr->unpin(epoch);
+
     return(err);
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_cnfg_db::get_param(LTE_FDD_ENB_PARAM_ENUM  param,
                                                       std::string            &value)
 {
-    std::map<LTE_FDD_ENB_PARAM_ENUM, uint32>::iterator iter = var_map_uint32.find(param);
-    LTE_FDD_ENB_ERROR_ENUM                             err  = LTE_FDD_ENB_ERROR_INVALID_PARAM;
-    uint32                                             i;
+    uint64                          epoch  = epoch_mgr->pin();
+    LTE_FDD_ENB_CNFG_PARAMS_STRUCT *params = cur_params;
+    LTE_FDD_ENB_ERROR_ENUM          err    = LTE_FDD_ENB_ERROR_INVALID_PARAM;
+    uint32                          i;
 
-    if(var_map_uint32.end() != iter)
+    if(LTE_FDD_ENB_PARAM_N_ITEMS      > param &&
+       LTE_FDD_ENB_CNFG_TYPE_UINT32 == params->type[param])
     {
         try
         {
             for(i=0; i<8; i++)
             {
-                if((((*iter).second >> (7-i)*4) & 0x0F) != 0xF)
+                if(((params->uint32_value[param] >> (7-i)*4) & 0x0F) != 0xF)
                 {
-                    value += boost::lexical_cast<std::string>(((*iter).second >> (7-i)*4) & 0x0F);
+                    value += boost::lexical_cast<std::string>((params->uint32_value[param] >> (7-i)*4) & 0x0F);
                 }
             }
             err = LTE_FDD_ENB_ERROR_NONE;
@@ -304,136 +395,161 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_cnfg_db::get_param(LTE_FDD_ENB_PARAM_ENUM  pa
         }
     }
 
+    epoch_mgr->unpin(epoch);
+
     return(err);
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_cnfg_db::get_param(LTE_FDD_ENB_PARAM_ENUM  param,
                                                       uint32                 &value)
 {
-    std::map<LTE_FDD_ENB_PARAM_ENUM, uint32>::iterator iter = var_map_uint32.find(param);
-    LTE_FDD_ENB_ERROR_ENUM                             err  = LTE_FDD_ENB_ERROR_INVALID_PARAM;
+    uint64                          epoch  = epoch_mgr->pin();
+    LTE_FDD_ENB_CNFG_PARAMS_STRUCT *params = cur_params;
+    LTE_FDD_ENB_ERROR_ENUM          err    = LTE_FDD_ENB_ERROR_INVALID_PARAM;
 
-    if(var_map_uint32.end() != iter)
+    if(LTE_FDD_ENB_PARAM_N_ITEMS      > param &&
+       LTE_FDD_ENB_CNFG_TYPE_UINT32 == params->type[param])
     {
-        value = (*iter).second;
+        value = params->uint32_value[param];
         err   = LTE_FDD_ENB_ERROR_NONE;
     }
 
+    epoch_mgr->unpin(epoch);
+
     return(err);
 }
+LTE_FDD_ENB_CNFG_PARAMS_STRUCT* LTE_fdd_enb_cnfg_db::copy_params(void)
+{
+    LTE_FDD_ENB_CNFG_PARAMS_STRUCT *new_params = new LTE_FDD_ENB_CNFG_PARAMS_STRUCT;
+
+    memcpy(new_params, cur_params, sizeof(LTE_FDD_ENB_CNFG_PARAMS_STRUCT));
+    new_params->version++;
+
+    return(new_params);
+}
+void LTE_fdd_enb_cnfg_db::publish_params(LTE_FDD_ENB_CNFG_PARAMS_STRUCT *new_params)
+{
+    LTE_FDD_ENB_CNFG_PARAMS_STRUCT *old_params = cur_params;
+
+    // Readers may still hold the old snapshot, so it is only freed once they
+    // have all unpinned
+    __sync_synchronize();
+    cur_params = new_params;
+    epoch_mgr->retire(&LTE_fdd_enb_epoch_delete<LTE_FDD_ENB_CNFG_PARAMS_STRUCT>, old_params);
+}
 
 /******************************/
 /*    MIB/SIB Construction    */
 /******************************/
 void LTE_fdd_enb_cnfg_db::construct_sys_info(void)
 {
-    LTE_fdd_enb_phy                                    *phy  = LTE_fdd_enb_phy::get_instance();
-    LTE_fdd_enb_mac                                    *mac  = LTE_fdd_enb_mac::get_instance();
-    LTE_fdd_enb_rlc                                    *rlc  = LTE_fdd_enb_rlc::get_instance();
-    LTE_fdd_enb_pdcp                                   *pdcp = LTE_fdd_enb_pdcp::get_instance();
-    LTE_fdd_enb_rrc                                    *rrc  = LTE_fdd_enb_rrc::get_instance();
-    LTE_fdd_enb_mme                                    *mme  = LTE_fdd_enb_mme::get_instance();
-    std::map<LTE_FDD_ENB_PARAM_ENUM, double>::iterator  double_iter;
-    std::map<LTE_FDD_ENB_PARAM_ENUM, int64>::iterator   int64_iter;
-    std::map<LTE_FDD_ENB_PARAM_ENUM, uint32>::iterator  uint32_iter;
-    LIBLTE_RRC_SIB_TYPE_ENUM                            sib_array[6];
-    LIBLTE_RRC_BCCH_DLSCH_MSG_STRUCT                    bcch_dlsch_msg;
-    uint32                                              num_sibs      = 0;
-    uint32                                              sib_idx       = 0;
-    uint32                                              N_sibs_to_map = 0;
-    uint32                                              i;
-    uint32                                              j;
+    boost::mutex::scoped_lock         lock(sys_info_mutex);
+    LTE_fdd_enb_phy                  *phy  = LTE_fdd_enb_phy::get_instance();
+    LTE_fdd_enb_mac                  *mac  = LTE_fdd_enb_mac::get_instance();
+    LTE_fdd_enb_rlc                  *rlc  = LTE_fdd_enb_rlc::get_instance();
+    LTE_fdd_enb_pdcp                 *pdcp = LTE_fdd_enb_pdcp::get_instance();
+    LTE_fdd_enb_rrc                  *rrc  = LTE_fdd_enb_rrc::get_instance();
+    LTE_fdd_enb_mme                  *mme  = LTE_fdd_enb_mme::get_instance();
+    LTE_FDD_ENB_CNFG_PARAMS_STRUCT   *params;
+    LTE_FDD_ENB_SYS_INFO_STRUCT      *sys_info;
+    LTE_FDD_ENB_SYS_INFO_STRUCT      *old_sys_info;
+    LIBLTE_RRC_SIB_TYPE_ENUM          sib_array[6];
+    LIBLTE_RRC_BCCH_DLSCH_MSG_STRUCT  bcch_dlsch_msg;
+    uint32                            num_sibs      = 0;
+    uint32                            sib_idx       = 0;
+    uint32                            N_sibs_to_map = 0;
+    uint64                            epoch;
+    uint32                            value_tag;
+    uint32                            i;
+    uint32                            j;
+
+    // Take a consistent set of parameters and bump the value tag, pinned so
+    // the snapshot stays valid after params_mutex is released
+    epoch = epoch_mgr->pin();
+    params_mutex.lock();
+    params    = copy_params();
+    value_tag = params->uint32_value[LTE_FDD_ENB_PARAM_SYSTEM_INFO_VALUE_TAG]++;
+    publish_params(params);
+    params_mutex.unlock();
+
+    // Build the new system information from a copy of the current one
+    sys_info = new LTE_FDD_ENB_SYS_INFO_STRUCT;
+    memcpy(sys_info, cur_sys_info, sizeof(LTE_FDD_ENB_SYS_INFO_STRUCT));
 
     // MIB
-    double_iter = var_map_double.find(LTE_FDD_ENB_PARAM_BANDWIDTH);
-    if(var_map_double.end() != double_iter)
+    for(i=0; i<LIBLTE_RRC_DL_BANDWIDTH_N_ITEMS; i++)
     {
-        for(i=0; i<LIBLTE_RRC_DL_BANDWIDTH_N_ITEMS; i++)
+        if(params->double_value[LTE_FDD_ENB_PARAM_BANDWIDTH] == liblte_rrc_dl_bandwidth_num[i])
         {
-            if((*double_iter).second == liblte_rrc_dl_bandwidth_num[i])
-            {
-                sys_info.mib.dl_bw = (LIBLTE_RRC_DL_BANDWIDTH_ENUM)i;
-                break;
-            }
+            sys_info->mib.dl_bw = (LIBLTE_RRC_DL_BANDWIDTH_ENUM)i;
+            break;
         }
     }
-    sys_info.mib.phich_config.dur = LIBLTE_RRC_PHICH_DURATION_NORMAL;
-    sys_info.mib.phich_config.res = LIBLTE_RRC_PHICH_RESOURCE_1;
+    sys_info->mib.phich_config.dur = LIBLTE_RRC_PHICH_DURATION_NORMAL;
+    sys_info->mib.phich_config.res = LIBLTE_RRC_PHICH_RESOURCE_1;
 
     // Determine which SIBs need to be mapped
-    int64_iter = var_map_int64.find(LTE_FDD_ENB_PARAM_SIB3_PRESENT);
-    if(var_map_int64.end() != int64_iter &&
-       1                   == (*int64_iter).second)
+    if(1 == params->int64_value[LTE_FDD_ENB_PARAM_SIB3_PRESENT])
     {
         sib_array[num_sibs++] = LIBLTE_RRC_SIB_TYPE_3;
     }
-    int64_iter = var_map_int64.find(LTE_FDD_ENB_PARAM_SIB4_PRESENT);
-    if(var_map_int64.end() != int64_iter &&
-       1                   == (*int64_iter).second)
+    if(1 == params->int64_value[LTE_FDD_ENB_PARAM_SIB4_PRESENT])
     {
         sib_array[num_sibs++] = LIBLTE_RRC_SIB_TYPE_4;
     }
-    int64_iter = var_map_int64.find(LTE_FDD_ENB_PARAM_SIB5_PRESENT);
-    if(var_map_int64.end() != int64_iter &&
-       1                   == (*int64_iter).second)
+    if(1 == params->int64_value[LTE_FDD_ENB_PARAM_SIB5_PRESENT])
     {
         sib_array[num_sibs++] = LIBLTE_RRC_SIB_TYPE_5;
     }
-    int64_iter = var_map_int64.find(LTE_FDD_ENB_PARAM_SIB6_PRESENT);
-    if(var_map_int64.end() != int64_iter &&
-       1                   == (*int64_iter).second)
+    if(1 == params->int64_value[LTE_FDD_ENB_PARAM_SIB6_PRESENT])
     {
         sib_array[num_sibs++] = LIBLTE_RRC_SIB_TYPE_6;
     }
-    int64_iter = var_map_int64.find(LTE_FDD_ENB_PARAM_SIB7_PRESENT);
-    if(var_map_int64.end() != int64_iter &&
-       1                   == (*int64_iter).second)
+    if(1 == params->int64_value[LTE_FDD_ENB_PARAM_SIB7_PRESENT])
     {
         sib_array[num_sibs++] = LIBLTE_RRC_SIB_TYPE_7;
     }
-    int64_iter = var_map_int64.find(LTE_FDD_ENB_PARAM_SIB8_PRESENT);
-    if(var_map_int64.end() != int64_iter &&
-       1                   == (*int64_iter).second)
+    if(1 == params->int64_value[LTE_FDD_ENB_PARAM_SIB8_PRESENT])
     {
         sib_array[num_sibs++] = LIBLTE_RRC_SIB_TYPE_8;
     }
 
     // Initialize the scheduling info
-    sys_info.sib1.N_sched_info                     = 1;
-    sys_info.sib1.sched_info[0].N_sib_mapping_info = 0;
+    sys_info->sib1.N_sched_info                     = 1;
+    sys_info->sib1.sched_info[0].N_sib_mapping_info = 0;
 
     // Map the SIBs
     while(num_sibs > 0)
     {
         // Determine how many SIBs can be mapped to this scheduling info
-        if(1 == sys_info.sib1.N_sched_info)
+        if(1 == sys_info->sib1.N_sched_info)
         {
-            if(0                         == sys_info.sib1.sched_info[0].N_sib_mapping_info &&
-               LIBLTE_RRC_DL_BANDWIDTH_6 != sys_info.mib.dl_bw)
+            if(0                         == sys_info->sib1.sched_info[0].N_sib_mapping_info &&
+               LIBLTE_RRC_DL_BANDWIDTH_6 != sys_info->mib.dl_bw)
             {
                 N_sibs_to_map = 1;
             }else{
                 N_sibs_to_map                                                           = 2;
-                sys_info.sib1.sched_info[sys_info.sib1.N_sched_info].N_sib_mapping_info = 0;
-                sys_info.sib1.sched_info[sys_info.sib1.N_sched_info].si_periodicity     = LIBLTE_RRC_SI_PERIODICITY_RF8;
-                sys_info.sib1.N_sched_info++;
+                sys_info->sib1.sched_info[sys_info->sib1.N_sched_info].N_sib_mapping_info = 0;
+                sys_info->sib1.sched_info[sys_info->sib1.N_sched_info].si_periodicity     = LIBLTE_RRC_SI_PERIODICITY_RF8;
+                sys_info->sib1.N_sched_info++;
             }
         }else{
-            if(2 > sys_info.sib1.sched_info[sys_info.sib1.N_sched_info-1].N_sib_mapping_info)
+            if(2 > sys_info->sib1.sched_info[sys_info->sib1.N_sched_info-1].N_sib_mapping_info)
             {
-                N_sibs_to_map = 2 - sys_info.sib1.sched_info[sys_info.sib1.N_sched_info-1].N_sib_mapping_info;
+                N_sibs_to_map = 2 - sys_info->sib1.sched_info[sys_info->sib1.N_sched_info-1].N_sib_mapping_info;
             }else{
                 N_sibs_to_map                                                           = 2;
-                sys_info.sib1.sched_info[sys_info.sib1.N_sched_info].N_sib_mapping_info = 0;
-                sys_info.sib1.sched_info[sys_info.sib1.N_sched_info].si_periodicity     = LIBLTE_RRC_SI_PERIODICITY_RF8;
-                sys_info.sib1.N_sched_info++;
+                sys_info->sib1.sched_info[sys_info->sib1.N_sched_info].N_sib_mapping_info = 0;
+                sys_info->sib1.sched_info[sys_info->sib1.N_sched_info].si_periodicity     = LIBLTE_RRC_SI_PERIODICITY_RF8;
+                sys_info->sib1.N_sched_info++;
             }
         }
 
         // Map the SIBs for this scheduling info
         for(i=0; i<N_sibs_to_map; i++)
         {
-            sys_info.sib1.sched_info[sys_info.sib1.N_sched_info-1].sib_mapping_info[sys_info.sib1.sched_info[sys_info.sib1.N_sched_info-1].N_sib_mapping_info].sib_type = sib_array[sib_idx++];
-            sys_info.sib1.sched_info[sys_info.sib1.N_sched_info-1].N_sib_mapping_info++;
+            sys_info->sib1.sched_info[sys_info->sib1.N_sched_info-1].sib_mapping_info[sys_info->sib1.sched_info[sys_info->sib1.N_sched_info-1].N_sib_mapping_info].sib_type = sib_array[sib_idx++];
+            sys_info->sib1.sched_info[sys_info->sib1.N_sched_info-1].N_sib_mapping_info++;
             num_sibs--;
 
             if(0 == num_sibs)
@@ -444,361 +560,283 @@ void LTE_fdd_enb_cnfg_db::construct_sys_info(void)
     }
 
     // SIB1
-    sys_info.sib1.N_plmn_ids = 1;
-    uint32_iter = var_map_uint32.find(LTE_FDD_ENB_PARAM_MCC);
-    if(var_map_uint32.end() != uint32_iter)
-    {
-        sys_info.sib1.plmn_id[0].id.mcc = ((*uint32_iter).second) & 0xFFFF;
-    }
-    uint32_iter = var_map_uint32.find(LTE_FDD_ENB_PARAM_MNC);
-    if(var_map_uint32.end() != uint32_iter)
-    {
-        sys_info.sib1.plmn_id[0].id.mnc = ((*uint32_iter).second) & 0xFFFF;
-    }
-    sys_info.sib1.plmn_id[0].resv_for_oper         = LIBLTE_RRC_NOT_RESV_FOR_OPER;
-    sys_info.sib1.cell_barred                      = LIBLTE_RRC_CELL_NOT_BARRED;
-    sys_info.sib1.intra_freq_reselection           = LIBLTE_RRC_INTRA_FREQ_RESELECTION_ALLOWED;
-    sys_info.sib1.si_window_length                 = LIBLTE_RRC_SI_WINDOW_LENGTH_MS2;
-    sys_info.sib1.sf_assignment                    = LIBLTE_RRC_SUBFRAME_ASSIGNMENT_0;
-    sys_info.sib1.special_sf_patterns              = LIBLTE_RRC_SPECIAL_SUBFRAME_PATTERNS_0;
-    int64_iter                                     = var_map_int64.find(LTE_FDD_ENB_PARAM_CELL_ID);
-    if(var_map_int64.end() != int64_iter)
-    {
-        sys_info.sib1.cell_id = (*int64_iter).second;
-    }
-    sys_info.sib1.csg_id = 0;
-    int64_iter           = var_map_int64.find(LTE_FDD_ENB_PARAM_TRACKING_AREA_CODE);
-    if(var_map_int64.end() != int64_iter)
-    {
-        sys_info.sib1.tracking_area_code = (*int64_iter).second;
-    }
-    int64_iter = var_map_int64.find(LTE_FDD_ENB_PARAM_Q_RX_LEV_MIN);
-    if(var_map_int64.end() != int64_iter)
-    {
-        sys_info.sib1.q_rx_lev_min = (*int64_iter).second;
-    }
-    sys_info.sib1.csg_indication      = 0;
-    sys_info.sib1.q_rx_lev_min_offset = 1;
-    int64_iter                        = var_map_int64.find(LTE_FDD_ENB_PARAM_FREQ_BAND);
-    if(var_map_int64.end() != int64_iter)
-    {
-        sys_info.sib1.freq_band_indicator = liblte_interface_band_num[(*int64_iter).second];
-    }
-    uint32_iter = var_map_uint32.find(LTE_FDD_ENB_PARAM_SYSTEM_INFO_VALUE_TAG);
-    if(var_map_uint32.end() != uint32_iter)
-    {
-        sys_info.sib1.system_info_value_tag = (*uint32_iter).second++;
-    }
-    sys_info.sib1.p_max_present = true;
-    sys_info.sib1.p_max         = 23;
-    sys_info.sib1.tdd           = false;
+    sys_info->sib1.N_plmn_ids               = 1;
+    sys_info->sib1.plmn_id[0].id.mcc        = (params->uint32_value[LTE_FDD_ENB_PARAM_MCC]) & 0xFFFF;
+    sys_info->sib1.plmn_id[0].id.mnc        = (params->uint32_value[LTE_FDD_ENB_PARAM_MNC]) & 0xFFFF;
+    sys_info->sib1.plmn_id[0].resv_for_oper = LIBLTE_RRC_NOT_RESV_FOR_OPER;
+    sys_info->sib1.cell_barred              = LIBLTE_RRC_CELL_NOT_BARRED;
+    sys_info->sib1.intra_freq_reselection   = LIBLTE_RRC_INTRA_FREQ_RESELECTION_ALLOWED;
+    sys_info->sib1.si_window_length         = LIBLTE_RRC_SI_WINDOW_LENGTH_MS2;
+    sys_info->sib1.sf_assignment            = LIBLTE_RRC_SUBFRAME_ASSIGNMENT_0;
+    sys_info->sib1.special_sf_patterns      = LIBLTE_RRC_SPECIAL_SUBFRAME_PATTERNS_0;
+    sys_info->sib1.cell_id                  = params->int64_value[LTE_FDD_ENB_PARAM_CELL_ID];
+    sys_info->sib1.csg_id                   = 0;
+    sys_info->sib1.tracking_area_code       = params->int64_value[LTE_FDD_ENB_PARAM_TRACKING_AREA_CODE];
+    sys_info->sib1.q_rx_lev_min             = params->int64_value[LTE_FDD_ENB_PARAM_Q_RX_LEV_MIN];
+    sys_info->sib1.csg_indication           = 0;
+    sys_info->sib1.q_rx_lev_min_offset      = 1;
+    sys_info->sib1.freq_band_indicator      = liblte_interface_band_num[params->int64_value[LTE_FDD_ENB_PARAM_FREQ_BAND]];
+    sys_info->sib1.system_info_value_tag    = value_tag;
+    sys_info->sib1.p_max_present            = true;
+    sys_info->sib1.p_max                    = 23;
+    sys_info->sib1.tdd                      = false;
 
     // SIB2
-    sys_info.sib2.ac_barring_info_present                                                      = false;
-    sys_info.sib2.rr_config_common_sib.rach_cnfg.num_ra_preambles                              = LIBLTE_RRC_NUMBER_OF_RA_PREAMBLES_N4;
-    sys_info.sib2.rr_config_common_sib.rach_cnfg.preambles_group_a_cnfg.present                = false;
-    sys_info.sib2.rr_config_common_sib.rach_cnfg.pwr_ramping_step                              = LIBLTE_RRC_POWER_RAMPING_STEP_DB6;
-    sys_info.sib2.rr_config_common_sib.rach_cnfg.preamble_init_rx_target_pwr                   = LIBLTE_RRC_PREAMBLE_INITIAL_RECEIVED_TARGET_POWER_DBM_N90;
-    sys_info.sib2.rr_config_common_sib.rach_cnfg.preamble_trans_max                            = LIBLTE_RRC_PREAMBLE_TRANS_MAX_N200;
-    sys_info.sib2.rr_config_common_sib.rach_cnfg.ra_resp_win_size                              = LIBLTE_RRC_RA_RESPONSE_WINDOW_SIZE_SF7;
-    sys_info.sib2.rr_config_common_sib.rach_cnfg.mac_con_res_timer                             = LIBLTE_RRC_MAC_CONTENTION_RESOLUTION_TIMER_SF64;
-    sys_info.sib2.rr_config_common_sib.rach_cnfg.max_harq_msg3_tx                              = 1;
-    sys_info.sib2.rr_config_common_sib.bcch_cnfg.modification_period_coeff                     = LIBLTE_RRC_MODIFICATION_PERIOD_COEFF_N2;
-    sys_info.sib2.rr_config_common_sib.pcch_cnfg.default_paging_cycle                          = LIBLTE_RRC_DEFAULT_PAGING_CYCLE_RF256;
-    sys_info.sib2.rr_config_common_sib.pcch_cnfg.nB                                            = LIBLTE_RRC_NB_ONE_T;
-    sys_info.sib2.rr_config_common_sib.prach_cnfg.root_sequence_index                          = 0;
-    sys_info.sib2.rr_config_common_sib.prach_cnfg.prach_cnfg_info.prach_config_index           = 0;
-    sys_info.sib2.rr_config_common_sib.prach_cnfg.prach_cnfg_info.high_speed_flag              = false;
-    sys_info.sib2.rr_config_common_sib.prach_cnfg.prach_cnfg_info.zero_correlation_zone_config = 1;
-    sys_info.sib2.rr_config_common_sib.prach_cnfg.prach_cnfg_info.prach_freq_offset            = 0;
-    sys_info.sib2.rr_config_common_sib.pdsch_cnfg.rs_power                                     = 0;
-    sys_info.sib2.rr_config_common_sib.pdsch_cnfg.p_b                                          = 0;
-    sys_info.sib2.rr_config_common_sib.pusch_cnfg.n_sb                                         = 1;
-    sys_info.sib2.rr_config_common_sib.pusch_cnfg.hopping_mode                                 = LIBLTE_RRC_HOPPING_MODE_INTER_SUBFRAME;
-    sys_info.sib2.rr_config_common_sib.pusch_cnfg.pusch_hopping_offset                         = 0;
-    sys_info.sib2.rr_config_common_sib.pusch_cnfg.enable_64_qam                                = true;
-    sys_info.sib2.rr_config_common_sib.pusch_cnfg.ul_rs.group_hopping_enabled                  = false;
-    sys_info.sib2.rr_config_common_sib.pusch_cnfg.ul_rs.group_assignment_pusch                 = 0;
-    sys_info.sib2.rr_config_common_sib.pusch_cnfg.ul_rs.sequence_hopping_enabled               = false;
-    sys_info.sib2.rr_config_common_sib.pusch_cnfg.ul_rs.cyclic_shift                           = 0;
-    sys_info.sib2.rr_config_common_sib.pucch_cnfg.delta_pucch_shift                            = LIBLTE_RRC_DELTA_PUCCH_SHIFT_DS1;
-    sys_info.sib2.rr_config_common_sib.pucch_cnfg.n_rb_cqi                                     = 0;
-    sys_info.sib2.rr_config_common_sib.pucch_cnfg.n_cs_an                                      = 0;
-    sys_info.sib2.rr_config_common_sib.pucch_cnfg.n1_pucch_an                                  = 0;
-    sys_info.sib2.rr_config_common_sib.srs_ul_cnfg.present                                     = false;
-    int64_iter                                                                                 = var_map_int64.find(LTE_FDD_ENB_PARAM_P0_NOMINAL_PUSCH);
-    if(var_map_int64.end() != int64_iter)
-    {
-        sys_info.sib2.rr_config_common_sib.ul_pwr_ctrl.p0_nominal_pusch = (*int64_iter).second;
-    }
-    sys_info.sib2.rr_config_common_sib.ul_pwr_ctrl.alpha = LIBLTE_RRC_UL_POWER_CONTROL_ALPHA_1;
-    int64_iter                                           = var_map_int64.find(LTE_FDD_ENB_PARAM_P0_NOMINAL_PUCCH);
-    if(var_map_int64.end() != int64_iter)
-    {
-        sys_info.sib2.rr_config_common_sib.ul_pwr_ctrl.p0_nominal_pucch = (*int64_iter).second;
-    }
-    sys_info.sib2.rr_config_common_sib.ul_pwr_ctrl.delta_flist_pucch.format_1  = LIBLTE_RRC_DELTA_F_PUCCH_FORMAT_1_0;
-    sys_info.sib2.rr_config_common_sib.ul_pwr_ctrl.delta_flist_pucch.format_1b = LIBLTE_RRC_DELTA_F_PUCCH_FORMAT_1B_1;
-    sys_info.sib2.rr_config_common_sib.ul_pwr_ctrl.delta_flist_pucch.format_2  = LIBLTE_RRC_DELTA_F_PUCCH_FORMAT_2_0;
-    sys_info.sib2.rr_config_common_sib.ul_pwr_ctrl.delta_flist_pucch.format_2a = LIBLTE_RRC_DELTA_F_PUCCH_FORMAT_2A_0;
-    sys_info.sib2.rr_config_common_sib.ul_pwr_ctrl.delta_flist_pucch.format_2b = LIBLTE_RRC_DELTA_F_PUCCH_FORMAT_2B_0;
-    sys_info.sib2.rr_config_common_sib.ul_pwr_ctrl.delta_preamble_msg3         = -2;
-    sys_info.sib2.rr_config_common_sib.ul_cp_length                            = LIBLTE_RRC_UL_CP_LENGTH_1;
-    sys_info.sib2.ue_timers_and_constants.t300                                 = LIBLTE_RRC_T300_MS1000;
-    sys_info.sib2.ue_timers_and_constants.t301                                 = LIBLTE_RRC_T301_MS1000;
-    sys_info.sib2.ue_timers_and_constants.t310                                 = LIBLTE_RRC_T310_MS1000;
-    sys_info.sib2.ue_timers_and_constants.n310                                 = LIBLTE_RRC_N310_N20;
-    sys_info.sib2.ue_timers_and_constants.t311                                 = LIBLTE_RRC_T311_MS1000;
-    sys_info.sib2.ue_timers_and_constants.n311                                 = LIBLTE_RRC_N311_N10;
-    sys_info.sib2.arfcn_value_eutra.present                                    = false;
-    sys_info.sib2.ul_bw.present                                                = false;
-    sys_info.sib2.additional_spectrum_emission                                 = 1;
-    sys_info.sib2.mbsfn_subfr_cnfg_list_size                                   = 0;
-    sys_info.sib2.time_alignment_timer                                         = LIBLTE_RRC_TIME_ALIGNMENT_TIMER_SF500;
+    sys_info->sib2.ac_barring_info_present                                                      = false;
+    sys_info->sib2.rr_config_common_sib.rach_cnfg.num_ra_preambles                              = LIBLTE_RRC_NUMBER_OF_RA_PREAMBLES_N4;
+    sys_info->sib2.rr_config_common_sib.rach_cnfg.preambles_group_a_cnfg.present                = false;
+    sys_info->sib2.rr_config_common_sib.rach_cnfg.pwr_ramping_step                              = LIBLTE_RRC_POWER_RAMPING_STEP_DB6;
+    sys_info->sib2.rr_config_common_sib.rach_cnfg.preamble_init_rx_target_pwr                   = LIBLTE_RRC_PREAMBLE_INITIAL_RECEIVED_TARGET_POWER_DBM_N90;
+    sys_info->sib2.rr_config_common_sib.rach_cnfg.preamble_trans_max                            = LIBLTE_RRC_PREAMBLE_TRANS_MAX_N200;
+    sys_info->sib2.rr_config_common_sib.rach_cnfg.ra_resp_win_size                              = LIBLTE_RRC_RA_RESPONSE_WINDOW_SIZE_SF7;
+    sys_info->sib2.rr_config_common_sib.rach_cnfg.mac_con_res_timer                             = LIBLTE_RRC_MAC_CONTENTION_RESOLUTION_TIMER_SF64;
+    sys_info->sib2.rr_config_common_sib.rach_cnfg.max_harq_msg3_tx                              = 1;
+    sys_info->sib2.rr_config_common_sib.bcch_cnfg.modification_period_coeff                     = LIBLTE_RRC_MODIFICATION_PERIOD_COEFF_N2;
+    sys_info->sib2.rr_config_common_sib.pcch_cnfg.default_paging_cycle                          = LIBLTE_RRC_DEFAULT_PAGING_CYCLE_RF256;
+    sys_info->sib2.rr_config_common_sib.pcch_cnfg.nB                                            = LIBLTE_RRC_NB_ONE_T;
+    sys_info->sib2.rr_config_common_sib.prach_cnfg.root_sequence_index                          = 0;
+    sys_info->sib2.rr_config_common_sib.prach_cnfg.prach_cnfg_info.prach_config_index           = 0;
+    sys_info->sib2.rr_config_common_sib.prach_cnfg.prach_cnfg_info.high_speed_flag              = false;
+    sys_info->sib2.rr_config_common_sib.prach_cnfg.prach_cnfg_info.zero_correlation_zone_config = 1;
+    sys_info->sib2.rr_config_common_sib.prach_cnfg.prach_cnfg_info.prach_freq_offset            = 0;
+    sys_info->sib2.rr_config_common_sib.pdsch_cnfg.rs_power                                     = 0;
+    sys_info->sib2.rr_config_common_sib.pdsch_cnfg.p_b                                          = 0;
+    sys_info->sib2.rr_config_common_sib.pusch_cnfg.n_sb                                         = 1;
+    sys_info->sib2.rr_config_common_sib.pusch_cnfg.hopping_mode                                 = LIBLTE_RRC_HOPPING_MODE_INTER_SUBFRAME;
+    sys_info->sib2.rr_config_common_sib.pusch_cnfg.pusch_hopping_offset                         = 0;
+    sys_info->sib2.rr_config_common_sib.pusch_cnfg.enable_64_qam                                = true;
+    sys_info->sib2.rr_config_common_sib.pusch_cnfg.ul_rs.group_hopping_enabled                  = false;
+    sys_info->sib2.rr_config_common_sib.pusch_cnfg.ul_rs.group_assignment_pusch                 = 0;
+    sys_info->sib2.rr_config_common_sib.pusch_cnfg.ul_rs.sequence_hopping_enabled               = false;
+    sys_info->sib2.rr_config_common_sib.pusch_cnfg.ul_rs.cyclic_shift                           = 0;
+    sys_info->sib2.rr_config_common_sib.pucch_cnfg.delta_pucch_shift                            = LIBLTE_RRC_DELTA_PUCCH_SHIFT_DS1;
+    sys_info->sib2.rr_config_common_sib.pucch_cnfg.n_rb_cqi                                     = 0;
+    sys_info->sib2.rr_config_common_sib.pucch_cnfg.n_cs_an                                      = 0;
+    sys_info->sib2.rr_config_common_sib.pucch_cnfg.n1_pucch_an                                  = 0;
+    sys_info->sib2.rr_config_common_sib.srs_ul_cnfg.present                                     = false;
+    sys_info->sib2.rr_config_common_sib.ul_pwr_ctrl.p0_nominal_pusch                            = params->int64_value[LTE_FDD_ENB_PARAM_P0_NOMINAL_PUSCH];
+    sys_info->sib2.rr_config_common_sib.ul_pwr_ctrl.alpha                                       = LIBLTE_RRC_UL_POWER_CONTROL_ALPHA_1;
+    sys_info->sib2.rr_config_common_sib.ul_pwr_ctrl.p0_nominal_pucch                            = params->int64_value[LTE_FDD_ENB_PARAM_P0_NOMINAL_PUCCH];
+    sys_info->sib2.rr_config_common_sib.ul_pwr_ctrl.delta_flist_pucch.format_1                  = LIBLTE_RRC_DELTA_F_PUCCH_FORMAT_1_0;
+    sys_info->sib2.rr_config_common_sib.ul_pwr_ctrl.delta_flist_pucch.format_1b                 = LIBLTE_RRC_DELTA_F_PUCCH_FORMAT_1B_1;
+    sys_info->sib2.rr_config_common_sib.ul_pwr_ctrl.delta_flist_pucch.format_2                  = LIBLTE_RRC_DELTA_F_PUCCH_FORMAT_2_0;
+    sys_info->sib2.rr_config_common_sib.ul_pwr_ctrl.delta_flist_pucch.format_2a                 = LIBLTE_RRC_DELTA_F_PUCCH_FORMAT_2A_0;
+    sys_info->sib2.rr_config_common_sib.ul_pwr_ctrl.delta_flist_pucch.format_2b                 = LIBLTE_RRC_DELTA_F_PUCCH_FORMAT_2B_0;
+    sys_info->sib2.rr_config_common_sib.ul_pwr_ctrl.delta_preamble_msg3                         = -2;
+    sys_info->sib2.rr_config_common_sib.ul_cp_length                                            = LIBLTE_RRC_UL_CP_LENGTH_1;
+    sys_info->sib2.ue_timers_and_constants.t300                                                 = LIBLTE_RRC_T300_MS1000;
+    sys_info->sib2.ue_timers_and_constants.t301                                                 = LIBLTE_RRC_T301_MS1000;
+    sys_info->sib2.ue_timers_and_constants.t310                                                 = LIBLTE_RRC_T310_MS1000;
+    sys_info->sib2.ue_timers_and_constants.n310                                                 = LIBLTE_RRC_N310_N20;
+    sys_info->sib2.ue_timers_and_constants.t311                                                 = LIBLTE_RRC_T311_MS1000;
+    sys_info->sib2.ue_timers_and_constants.n311                                                 = LIBLTE_RRC_N311_N10;
+    sys_info->sib2.arfcn_value_eutra.present                                                    = false;
+    sys_info->sib2.ul_bw.present                                                                = false;
+    sys_info->sib2.additional_spectrum_emission                                                 = 1;
+    sys_info->sib2.mbsfn_subfr_cnfg_list_size                                                   = 0;
+    sys_info->sib2.time_alignment_timer                                                         = LIBLTE_RRC_TIME_ALIGNMENT_TIMER_SF500;
 
     // SIB3
-    sys_info.sib3_present = false;
-    int64_iter            = var_map_int64.find(LTE_FDD_ENB_PARAM_SIB3_PRESENT);
-    if(var_map_int64.end() != int64_iter &&
-       1                   == (*int64_iter).second)
-    {
-        sys_info.sib3_present = true;
-        int64_iter            = var_map_int64.find(LTE_FDD_ENB_PARAM_Q_HYST);
-        if(var_map_int64.end() != int64_iter)
-        {
-            sys_info.sib3.q_hyst = (LIBLTE_RRC_Q_HYST_ENUM)(*int64_iter).second;
-        }
-        sys_info.sib3.speed_state_resel_params.present = false;
-        sys_info.sib3.s_non_intra_search_present       = false;
-        sys_info.sib3.thresh_serving_low               = 0;
-        sys_info.sib3.cell_resel_prio                  = 0;
-        sys_info.sib3.q_rx_lev_min                     = sys_info.sib1.q_rx_lev_min;
-        sys_info.sib3.p_max_present                    = true;
-        sys_info.sib3.p_max                            = sys_info.sib1.p_max;
-        sys_info.sib3.s_intra_search_present           = false;
-        sys_info.sib3.allowed_meas_bw_present          = false;
-        sys_info.sib3.presence_ant_port_1              = false;
-        sys_info.sib3.neigh_cell_cnfg                  = 0;
-        sys_info.sib3.t_resel_eutra                    = 0;
-        sys_info.sib3.t_resel_eutra_sf_present         = false;
+    sys_info->sib3_present = false;
+    if(1 == params->int64_value[LTE_FDD_ENB_PARAM_SIB3_PRESENT])
+    {
+        sys_info->sib3_present                          = true;
+        sys_info->sib3.q_hyst                           = (LIBLTE_RRC_Q_HYST_ENUM)params->int64_value[LTE_FDD_ENB_PARAM_Q_HYST];
+        sys_info->sib3.speed_state_resel_params.present = false;
+        sys_info->sib3.s_non_intra_search_present       = false;
+        sys_info->sib3.thresh_serving_low               = 0;
+        sys_info->sib3.cell_resel_prio                  = 0;
+        sys_info->sib3.q_rx_lev_min                     = sys_info->sib1.q_rx_lev_min;
+        sys_info->sib3.p_max_present                    = true;
+        sys_info->sib3.p_max                            = sys_info->sib1.p_max;
+        sys_info->sib3.s_intra_search_present           = false;
+        sys_info->sib3.allowed_meas_bw_present          = false;
+        sys_info->sib3.presence_ant_port_1              = false;
+        sys_info->sib3.neigh_cell_cnfg                  = 0;
+        sys_info->sib3.t_resel_eutra                    = 0;
+        sys_info->sib3.t_resel_eutra_sf_present         = false;
     }
 
     // SIB4
-    sys_info.sib4_present = false;
-    int64_iter            = var_map_int64.find(LTE_FDD_ENB_PARAM_SIB4_PRESENT);
-    if(var_map_int64.end() != int64_iter &&
-       1                   == (*int64_iter).second)
+    sys_info->sib4_present = false;
+    if(1 == params->int64_value[LTE_FDD_ENB_PARAM_SIB4_PRESENT])
     {
-        sys_info.sib4_present                         = true;
-        sys_info.sib4.intra_freq_neigh_cell_list_size = 0;
-        sys_info.sib4.intra_freq_black_cell_list_size = 0;
-        sys_info.sib4.csg_phys_cell_id_range_present  = false;
+        sys_info->sib4_present                         = true;
+        sys_info->sib4.intra_freq_neigh_cell_list_size = 0;
+        sys_info->sib4.intra_freq_black_cell_list_size = 0;
+        sys_info->sib4.csg_phys_cell_id_range_present  = false;
     }
 
     // SIB5
-    sys_info.sib5_present = false;
-    int64_iter            = var_map_int64.find(LTE_FDD_ENB_PARAM_SIB5_PRESENT);
-    if(var_map_int64.end() != int64_iter &&
-       1                   == (*int64_iter).second)
+    sys_info->sib5_present = false;
+    if(1 == params->int64_value[LTE_FDD_ENB_PARAM_SIB5_PRESENT])
     {
-        sys_info.sib5_present                           = true;
-        sys_info.sib5.inter_freq_carrier_freq_list_size = 0;
+        sys_info->sib5_present                           = true;
+        sys_info->sib5.inter_freq_carrier_freq_list_size = 0;
     }
 
     // SIB6
-    sys_info.sib6_present = false;
-    int64_iter            = var_map_int64.find(LTE_FDD_ENB_PARAM_SIB6_PRESENT);
-    if(var_map_int64.end() != int64_iter &&
-       1                   == (*int64_iter).second)
+    sys_info->sib6_present = false;
+    if(1 == params->int64_value[LTE_FDD_ENB_PARAM_SIB6_PRESENT])
     {
-        sys_info.sib6_present                         = true;
-        sys_info.sib6.carrier_freq_list_utra_fdd_size = 0;
-        sys_info.sib6.carrier_freq_list_utra_tdd_size = 0;
-        sys_info.sib6.t_resel_utra                    = 1;
-        sys_info.sib6.t_resel_utra_sf_present         = false;
+        sys_info->sib6_present                         = true;
+        sys_info->sib6.carrier_freq_list_utra_fdd_size = 0;
+        sys_info->sib6.carrier_freq_list_utra_tdd_size = 0;
+        sys_info->sib6.t_resel_utra                    = 1;
+        sys_info->sib6.t_resel_utra_sf_present         = false;
     }
 
     // SIB7
-    sys_info.sib7_present = false;
-    int64_iter            = var_map_int64.find(LTE_FDD_ENB_PARAM_SIB7_PRESENT);
-    if(var_map_int64.end() != int64_iter &&
-       1                   == (*int64_iter).second)
+    sys_info->sib7_present = false;
+    if(1 == params->int64_value[LTE_FDD_ENB_PARAM_SIB7_PRESENT])
     {
-        sys_info.sib7_present                      = true;
-        sys_info.sib7.t_resel_geran                = 1;
-        sys_info.sib7.t_resel_geran_sf_present     = false;
-        sys_info.sib7.carrier_freqs_info_list_size = 0;
+        sys_info->sib7_present                      = true;
+        sys_info->sib7.t_resel_geran                = 1;
+        sys_info->sib7.t_resel_geran_sf_present     = false;
+        sys_info->sib7.carrier_freqs_info_list_size = 0;
     }
 
     // SIB8
-    sys_info.sib8_present = false;
-    int64_iter            = var_map_int64.find(LTE_FDD_ENB_PARAM_SIB8_PRESENT);
-    if(var_map_int64.end() != int64_iter &&
-       1                   == (*int64_iter).second)
+    sys_info->sib8_present = false;
+    if(1 == params->int64_value[LTE_FDD_ENB_PARAM_SIB8_PRESENT])
     {
-        sys_info.sib8_present                 = true;
-        sys_info.sib8.sys_time_info_present   = false;
-        sys_info.sib8.search_win_size_present = true;
-        int64_iter                            = var_map_int64.find(LTE_FDD_ENB_PARAM_SEARCH_WIN_SIZE);
-        if(var_map_int64.end() != int64_iter)
-        {
-            sys_info.sib8.search_win_size = (*int64_iter).second;
-        }
-        sys_info.sib8.params_hrpd_present  = false;
-        sys_info.sib8.params_1xrtt_present = false;
+        sys_info->sib8_present                 = true;
+        sys_info->sib8.sys_time_info_present   = false;
+        sys_info->sib8.search_win_size_present = true;
+        sys_info->sib8.search_win_size         = params->int64_value[LTE_FDD_ENB_PARAM_SEARCH_WIN_SIZE];
+        sys_info->sib8.params_hrpd_present     = false;
+        sys_info->sib8.params_1xrtt_present    = false;
     }
 
     // Pack SIB1
     bcch_dlsch_msg.N_sibs           = 0;
     bcch_dlsch_msg.sibs[0].sib_type = LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_1;
-    memcpy(&bcch_dlsch_msg.sibs[0].sib, &sys_info.sib1, sizeof(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_1_STRUCT));
+    memcpy(&bcch_dlsch_msg.sibs[0].sib, &sys_info->sib1, sizeof(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_1_STRUCT));
     liblte_rrc_pack_bcch_dlsch_msg(&bcch_dlsch_msg,
-                                   &sys_info.sib1_alloc.msg);
-    sys_info.sib1_alloc.pre_coder_type = LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY;
-    sys_info.sib1_alloc.mod_type       = LIBLTE_PHY_MODULATION_TYPE_QPSK;
-    sys_info.sib1_alloc.rv_idx         = 0; // 36.321 section 5.3.1
-    sys_info.sib1_alloc.N_codewords    = 1;
-    sys_info.sib1_alloc.rnti           = LIBLTE_MAC_SI_RNTI;
-    sys_info.sib1_alloc.tx_mode        = 1;
+                                   &sys_info->sib1_alloc.msg);
+    sys_info->sib1_alloc.pre_coder_type = LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY;
+    sys_info->sib1_alloc.mod_type       = LIBLTE_PHY_MODULATION_TYPE_QPSK;
+    sys_info->sib1_alloc.rv_idx         = 0; // 36.321 section 5.3.1
+    sys_info->sib1_alloc.N_codewords    = 1;
+    sys_info->sib1_alloc.rnti           = LIBLTE_MAC_SI_RNTI;
+    sys_info->sib1_alloc.tx_mode        = 1;
 
     // Pack additional SIBs
     bcch_dlsch_msg.N_sibs           = 1;
     bcch_dlsch_msg.sibs[0].sib_type = LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_2;
-    memcpy(&bcch_dlsch_msg.sibs[0].sib, &sys_info.sib2, sizeof(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_2_STRUCT));
-    if(0 != sys_info.sib1.sched_info[0].N_sib_mapping_info)
+    memcpy(&bcch_dlsch_msg.sibs[0].sib, &sys_info->sib2, sizeof(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_2_STRUCT));
+    if(0 != sys_info->sib1.sched_info[0].N_sib_mapping_info)
     {
-        switch(sys_info.sib1.sched_info[0].sib_mapping_info[0].sib_type)
+        switch(sys_info->sib1.sched_info[0].sib_mapping_info[0].sib_type)
         {
         case LIBLTE_RRC_SIB_TYPE_3:
             bcch_dlsch_msg.N_sibs++;
             bcch_dlsch_msg.sibs[1].sib_type = LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_3;
-            memcpy(&bcch_dlsch_msg.sibs[1].sib, &sys_info.sib3, sizeof(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_3_STRUCT));
+            memcpy(&bcch_dlsch_msg.sibs[1].sib, &sys_info->sib3, sizeof(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_3_STRUCT));
             break;
         case LIBLTE_RRC_SIB_TYPE_4:
             bcch_dlsch_msg.N_sibs++;
             bcch_dlsch_msg.sibs[1].sib_type = LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_4;
-            memcpy(&bcch_dlsch_msg.sibs[1].sib, &sys_info.sib4, sizeof(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_4_STRUCT));
+            memcpy(&bcch_dlsch_msg.sibs[1].sib, &sys_info->sib4, sizeof(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_4_STRUCT));
             break;
         case LIBLTE_RRC_SIB_TYPE_5:
             bcch_dlsch_msg.N_sibs++;
             bcch_dlsch_msg.sibs[1].sib_type = LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_5;
-            memcpy(&bcch_dlsch_msg.sibs[1].sib, &sys_info.sib5, sizeof(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_5_STRUCT));
+            memcpy(&bcch_dlsch_msg.sibs[1].sib, &sys_info->sib5, sizeof(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_5_STRUCT));
             break;
         case LIBLTE_RRC_SIB_TYPE_6:
             bcch_dlsch_msg.N_sibs++;
             bcch_dlsch_msg.sibs[1].sib_type = LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_6;
-            memcpy(&bcch_dlsch_msg.sibs[1].sib, &sys_info.sib6, sizeof(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_6_STRUCT));
+            memcpy(&bcch_dlsch_msg.sibs[1].sib, &sys_info->sib6, sizeof(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_6_STRUCT));
             break;
         case LIBLTE_RRC_SIB_TYPE_7:
             bcch_dlsch_msg.N_sibs++;
             bcch_dlsch_msg.sibs[1].sib_type = LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_7;
-            memcpy(&bcch_dlsch_msg.sibs[1].sib, &sys_info.sib7, sizeof(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_7_STRUCT));
+            memcpy(&bcch_dlsch_msg.sibs[1].sib, &sys_info->sib7, sizeof(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_7_STRUCT));
             break;
         case LIBLTE_RRC_SIB_TYPE_8:
             bcch_dlsch_msg.N_sibs++;
             bcch_dlsch_msg.sibs[1].sib_type = LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_8;
-            memcpy(&bcch_dlsch_msg.sibs[1].sib, &sys_info.sib8, sizeof(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_8_STRUCT));
+            memcpy(&bcch_dlsch_msg.sibs[1].sib, &sys_info->sib8, sizeof(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_8_STRUCT));
             break;
         default:
             break;
         }
     }
     liblte_rrc_pack_bcch_dlsch_msg(&bcch_dlsch_msg,
-                                   &sys_info.sib_alloc[0].msg);
-    sys_info.sib_alloc[0].pre_coder_type = LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY;
-    sys_info.sib_alloc[0].mod_type       = LIBLTE_PHY_MODULATION_TYPE_QPSK;
-    sys_info.sib_alloc[0].rv_idx         = 0; // 36.321 section 5.3.1
-    sys_info.sib_alloc[0].N_codewords    = 1;
-    sys_info.sib_alloc[0].rnti           = LIBLTE_MAC_SI_RNTI;
-    sys_info.sib_alloc[0].tx_mode        = 1;
-    for(i=1; i<sys_info.sib1.N_sched_info; i++)
-    {
-        bcch_dlsch_msg.N_sibs = sys_info.sib1.sched_info[i].N_sib_mapping_info;
+                                   &sys_info->sib_alloc[0].msg);
+    sys_info->sib_alloc[0].pre_coder_type = LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY;
+    sys_info->sib_alloc[0].mod_type       = LIBLTE_PHY_MODULATION_TYPE_QPSK;
+    sys_info->sib_alloc[0].rv_idx         = 0; // 36.321 section 5.3.1
+    sys_info->sib_alloc[0].N_codewords    = 1;
+    sys_info->sib_alloc[0].rnti           = LIBLTE_MAC_SI_RNTI;
+    sys_info->sib_alloc[0].tx_mode        = 1;
+    for(i=1; i<sys_info->sib1.N_sched_info; i++)
+    {
+        bcch_dlsch_msg.N_sibs = sys_info->sib1.sched_info[i].N_sib_mapping_info;
         for(j=0; j<bcch_dlsch_msg.N_sibs; j++)
         {
-            switch(sys_info.sib1.sched_info[i].sib_mapping_info[j].sib_type)
+            switch(sys_info->sib1.sched_info[i].sib_mapping_info[j].sib_type)
             {
             case LIBLTE_RRC_SIB_TYPE_3:
                 bcch_dlsch_msg.sibs[j].sib_type = LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_3;
-                memcpy(&bcch_dlsch_msg.sibs[j].sib, &sys_info.sib3, sizeof(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_3_STRUCT));
+                memcpy(&bcch_dlsch_msg.sibs[j].sib, &sys_info->sib3, sizeof(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_3_STRUCT));
                 break;
             case LIBLTE_RRC_SIB_TYPE_4:
                 bcch_dlsch_msg.sibs[j].sib_type = LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_4;
-                memcpy(&bcch_dlsch_msg.sibs[j].sib, &sys_info.sib4, sizeof(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_4_STRUCT));
+                memcpy(&bcch_dlsch_msg.sibs[j].sib, &sys_info->sib4, sizeof(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_4_STRUCT));
                 break;
             case LIBLTE_RRC_SIB_TYPE_5:
                 bcch_dlsch_msg.sibs[j].sib_type = LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_5;
-                memcpy(&bcch_dlsch_msg.sibs[j].sib, &sys_info.sib5, sizeof(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_5_STRUCT));
+                memcpy(&bcch_dlsch_msg.sibs[j].sib, &sys_info->sib5, sizeof(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_5_STRUCT));
                 break;
             case LIBLTE_RRC_SIB_TYPE_6:
                 bcch_dlsch_msg.sibs[j].sib_type = LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_6;
-                memcpy(&bcch_dlsch_msg.sibs[j].sib, &sys_info.sib6, sizeof(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_6_STRUCT));
+                memcpy(&bcch_dlsch_msg.sibs[j].sib, &sys_info->sib6, sizeof(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_6_STRUCT));
                 break;
             case LIBLTE_RRC_SIB_TYPE_7:
                 bcch_dlsch_msg.sibs[j].sib_type = LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_7;
-                memcpy(&bcch_dlsch_msg.sibs[j].sib, &sys_info.sib7, sizeof(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_7_STRUCT));
+                memcpy(&bcch_dlsch_msg.sibs[j].sib, &sys_info->sib7, sizeof(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_7_STRUCT));
                 break;
             case LIBLTE_RRC_SIB_TYPE_8:
                 bcch_dlsch_msg.sibs[j].sib_type = LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_8;
-                memcpy(&bcch_dlsch_msg.sibs[j].sib, &sys_info.sib8, sizeof(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_8_STRUCT));
+                memcpy(&bcch_dlsch_msg.sibs[j].sib, &sys_info->sib8, sizeof(LIBLTE_RRC_SYS_INFO_BLOCK_TYPE_8_STRUCT));
                 break;
             default:
                 break;
             }
         }
         liblte_rrc_pack_bcch_dlsch_msg(&bcch_dlsch_msg,
-                                       &sys_info.sib_alloc[i].msg);
-        sys_info.sib_alloc[i].pre_coder_type = LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY;
-        sys_info.sib_alloc[i].mod_type       = LIBLTE_PHY_MODULATION_TYPE_QPSK;
-        sys_info.sib_alloc[i].rv_idx         = 0; // 36.321 section 5.3.1
-        sys_info.sib_alloc[i].N_codewords    = 1;
-        sys_info.sib_alloc[i].rnti           = LIBLTE_MAC_SI_RNTI;
-        sys_info.sib_alloc[i].tx_mode        = 1;
+                                       &sys_info->sib_alloc[i].msg);
+        sys_info->sib_alloc[i].pre_coder_type = LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY;
+        sys_info->sib_alloc[i].mod_type       = LIBLTE_PHY_MODULATION_TYPE_QPSK;
+        sys_info->sib_alloc[i].rv_idx         = 0; // 36.321 section 5.3.1
+        sys_info->sib_alloc[i].N_codewords    = 1;
+        sys_info->sib_alloc[i].rnti           = LIBLTE_MAC_SI_RNTI;
+        sys_info->sib_alloc[i].tx_mode        = 1;
     }
 
     // Generic parameters
-    int64_iter = var_map_int64.find(LTE_FDD_ENB_PARAM_N_ANT);
-    if(var_map_int64.end() != int64_iter)
-    {
-        sys_info.N_ant = (*int64_iter).second;
-    }
-    int64_iter = var_map_int64.find(LTE_FDD_ENB_PARAM_N_ID_CELL);
-    if(var_map_int64.end() != int64_iter)
-    {
-        sys_info.N_id_cell = (*int64_iter).second;
-    }
-    int64_iter = var_map_int64.find(LTE_FDD_ENB_PARAM_N_ID_1);
-    if(var_map_int64.end() != int64_iter)
-    {
-        sys_info.N_id_1 = (*int64_iter).second;
-    }
-    int64_iter = var_map_int64.find(LTE_FDD_ENB_PARAM_N_ID_2);
-    if(var_map_int64.end() != int64_iter)
-    {
-        sys_info.N_id_2 = (*int64_iter).second;
-    }
-    int64_iter = var_map_int64.find(LTE_FDD_ENB_PARAM_N_RB_DL);
-    if(var_map_int64.end() != int64_iter)
-    {
-        sys_info.N_rb_dl = (*int64_iter).second;
-    }
-    int64_iter = var_map_int64.find(LTE_FDD_ENB_PARAM_N_RB_UL);
-    if(var_map_int64.end() != int64_iter)
-    {
-        sys_info.N_rb_ul = (*int64_iter).second;
-    }
-    int64_iter = var_map_int64.find(LTE_FDD_ENB_PARAM_N_SC_RB_DL);
-    if(var_map_int64.end() != int64_iter)
-    {
-        sys_info.N_sc_rb_dl = (*int64_iter).second;
-    }
-    int64_iter = var_map_int64.find(LTE_FDD_ENB_PARAM_N_SC_RB_UL);
-    if(var_map_int64.end() != int64_iter)
-    {
-        sys_info.N_sc_rb_ul = (*int64_iter).second;
-    }
-    sys_info.si_periodicity_T = liblte_rrc_si_periodicity_num[sys_info.sib1.sched_info[0].si_periodicity];
-    sys_info.si_win_len       = liblte_rrc_si_window_length_num[sys_info.sib1.si_window_length];
+    sys_info->N_ant            = params->int64_value[LTE_FDD_ENB_PARAM_N_ANT];
+    sys_info->N_id_cell        = params->int64_value[LTE_FDD_ENB_PARAM_N_ID_CELL];
+    sys_info->N_id_1           = params->int64_value[LTE_FDD_ENB_PARAM_N_ID_1];
+    sys_info->N_id_2           = params->int64_value[LTE_FDD_ENB_PARAM_N_ID_2];
+    sys_info->N_rb_dl          = params->int64_value[LTE_FDD_ENB_PARAM_N_RB_DL];
+    sys_info->N_rb_ul          = params->int64_value[LTE_FDD_ENB_PARAM_N_RB_UL];
+    sys_info->N_sc_rb_dl       = params->int64_value[LTE_FDD_ENB_PARAM_N_SC_RB_DL];
+    sys_info->N_sc_rb_ul       = params->int64_value[LTE_FDD_ENB_PARAM_N_SC_RB_UL];
+    sys_info->si_periodicity_T = liblte_rrc_si_periodicity_num[sys_info->sib1.sched_info[0].si_periodicity];
+    sys_info->si_win_len       = liblte_rrc_si_window_length_num[sys_info->sib1.si_window_length];
+    sys_info->dl_sched_policy  = (LTE_FDD_ENB_DL_SCHED_POLICY_ENUM)params->int64_value[LTE_FDD_ENB_PARAM_DL_SCHED_POLICY];
+    sys_info->version++;
+
+    // Publish the new system information, the old one is freed once every
+    // reader has unpinned
+    old_sys_info = cur_sys_info;
+    __sync_synchronize();
+    cur_sys_info = sys_info;
+    epoch_mgr->retire(&LTE_fdd_enb_epoch_delete<LTE_FDD_ENB_SYS_INFO_STRUCT>, old_sys_info);
+    epoch_mgr->unpin(epoch);
 
     // Update all layers
     phy->update_sys_info();
@@ -808,7 +846,89 @@ void LTE_fdd_enb_cnfg_db::construct_sys_info(void)
     rrc->update_sys_info();
     mme->update_sys_info();
 }
-void LTE_fdd_enb_cnfg_db::get_sys_info(LTE_FDD_ENB_SYS_INFO_STRUCT &_sys_info)
+uint32 LTE_fdd_enb_cnfg_db::get_sys_info(LTE_FDD_ENB_SYS_INFO_STRUCT &_sys_info)
 {
-    memcpy(&_sys_info, &sys_info, sizeof(sys_info));
+    uint64                       epoch    = epoch_mgr->pin();
+    LTE_FDD_ENB_SYS_INFO_STRUCT *sys_info = cur_sys_info;
+
+    memcpy(&_sys_info, sys_info, sizeof(LTE_FDD_ENB_SYS_INFO_STRUCT));
+    epoch_mgr->unpin(epoch);
+
+    return(_sys_info.version);
+}
+uint32 LTE_fdd_enb_cnfg_db::get_sys_info_version(void)
+{
+    uint64 epoch   = epoch_mgr->pin();
+    uint32 version = cur_sys_info->version;
+
+    epoch_mgr->unpin(epoch);
+
+    return(version);
+}
+uint32 LTE_fdd_enb_cnfg_db::get_sys_info_allocs(LTE_FDD_ENB_SYS_INFO_STRUCT *sys_info,
+                                                uint32                       sfn,
+                                                uint32                       subfn,
+                                                LTE_FDD_ENB_SI_ALLOC_STRUCT *si_alloc)
+{
+    LIBLTE_PHY_ALLOCATION_STRUCT *alloc[LTE_FDD_ENB_CNFG_DB_MAX_SI_ALLOCS];
+    uint32                        rv_idx[LTE_FDD_ENB_CNFG_DB_MAX_SI_ALLOCS];
+    uint32                        N_cand   = 0;
+    uint32                        N_alloc  = 0;
+    uint32                        last_prb = 0;
+    uint32                        i;
+
+    // SIB1
+    if(5 == subfn &&
+       0 == (sfn % 2))
+    {
+        alloc[N_cand]  = &sys_info->sib1_alloc;
+        rv_idx[N_cand] = (uint32)ceilf(1.5 * ((sfn / 2) % 4)) % 4; //36.321 section 5.3.1
+        N_cand++;
+    }
+
+    // SIs in 1st scheduling info list entry
+    if((0 * sys_info->si_win_len)%10   <= subfn &&
+       (1 * sys_info->si_win_len)%10   >  subfn &&
+       ((0 * sys_info->si_win_len)/10) == (sfn % sys_info->si_periodicity_T))
+    {
+        alloc[N_cand]  = &sys_info->sib_alloc[0];
+        rv_idx[N_cand] = sys_info->sib_alloc[0].rv_idx;
+        N_cand++;
+    }
+
+    // SIs in all other scheduling info list entries
+    for(i=1; i<sys_info->sib1.N_sched_info; i++)
+    {
+        if(0                               != sys_info->sib_alloc[i].msg.N_bits &&
+           (i * sys_info->si_win_len)%10   == subfn                             &&
+           ((i * sys_info->si_win_len)/10) == (sfn % sys_info->si_periodicity_T))
+        {
+            alloc[N_cand]  = &sys_info->sib_alloc[i];
+            rv_idx[N_cand] = sys_info->sib_alloc[i].rv_idx;
+            N_cand++;
+        }
+    }
+
+    // Place the allocations back to back from the first PRB, skipping any
+    // that don't fit (i.e. SIB2 with 1.4MHz bandwidth due to overlap with
+    // the MIB)
+    for(i=0; i<N_cand; i++)
+    {
+        if(LIBLTE_SUCCESS == liblte_phy_get_tbs_mcs_and_n_prb_for_dl(alloc[i]->msg.N_bits,
+                                                                     subfn,
+                                                                     sys_info->N_rb_dl,
+                                                                     alloc[i]->rnti,
+                                                                     &si_alloc[N_alloc].tbs,
+                                                                     &si_alloc[N_alloc].mcs,
+                                                                     &si_alloc[N_alloc].N_prb))
+        {
+            si_alloc[N_alloc].alloc      = alloc[i];
+            si_alloc[N_alloc].rv_idx     = rv_idx[i];
+            si_alloc[N_alloc].first_prb  = last_prb;
+            last_prb                    += si_alloc[N_alloc].N_prb;
+            N_alloc++;
+        }
+    }
+
+    return(N_alloc);
 }
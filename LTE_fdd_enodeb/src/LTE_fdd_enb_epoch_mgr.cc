@@ -0,0 +1,239 @@
+#line 2 "LTE_fdd_enb_epoch_mgr.cc" // Make __FILE__ omit the path
+/*******************************************************************************
+
+    Copyright 2026 agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: LTE_fdd_enb_epoch_mgr.cc
+
+    Description: Contains all the implementations for the LTE FDD eNodeB
+                 epoch manager.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    agent            Created file
+
+*******************************************************************************/
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "LTE_fdd_enb_epoch_mgr.h"
+#include "LTE_fdd_enb_timer_mgr.h"
+#include <unistd.h>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              GLOBAL VARIABLES
+*******************************************************************************/
+
+LTE_fdd_enb_epoch_mgr* LTE_fdd_enb_epoch_mgr::instance      = NULL;
+__thread uint64        LTE_fdd_enb_epoch_mgr::thread_epoch  = 0;
+__thread bool          LTE_fdd_enb_epoch_mgr::thread_pinned = false;
+boost::mutex           epoch_mgr_instance_mutex;
+
+/*******************************************************************************
+                              CLASS IMPLEMENTATIONS
+*******************************************************************************/
+
+/*******************/
+/*    Singleton    */
+/*******************/
+LTE_fdd_enb_epoch_mgr* LTE_fdd_enb_epoch_mgr::get_instance(void)
+{
+    boost::mutex::scoped_lock lock(epoch_mgr_instance_mutex);
+
+    if(NULL == instance)
+    {
+        instance = new LTE_fdd_enb_epoch_mgr();
+    }
+
+    return(instance);
+}
+void LTE_fdd_enb_epoch_mgr::cleanup(void)
+{
+    boost::mutex::scoped_lock lock(epoch_mgr_instance_mutex);
+
+    if(NULL != instance)
+    {
+        delete instance;
+        instance = NULL;
+    }
+}
+
+/********************************/
+/*    Constructor/Destructor    */
+/********************************/
+LTE_fdd_enb_epoch_mgr::LTE_fdd_enb_epoch_mgr()
+{
+    uint32 i;
+
+    // Readers
+    epoch = 0;
+    for(i=0; i<LTE_FDD_ENB_EPOCH_MGR_N_EPOCHS; i++)
+    {
+        N_readers[i] = 0;
+    }
+
+    // Reclamation
+    collect_thread_stop = false;
+    pthread_create(&collect_thread, NULL, &collect_thread_func, this);
+}
+LTE_fdd_enb_epoch_mgr::~LTE_fdd_enb_epoch_mgr()
+{
+    std::list<LTE_FDD_ENB_EPOCH_RETIRED_STRUCT>::iterator iter;
+
+    collect_thread_stop = true;
+    pthread_join(collect_thread, NULL);
+
+    // Nothing runs anymore, free everything that is left
+    for(iter=retired_list.begin(); iter!=retired_list.end(); iter++)
+    {
+        (*iter).free_func((*iter).obj);
+    }
+}
+
+/*****************/
+/*    Readers    */
+/*****************/
+uint64 LTE_fdd_enb_epoch_mgr::pin(void)
+{
+    uint64 pinned_epoch;
+    bool   pinned = false;
+
+    if(thread_pinned)
+    {
+        // Inherit the pin of the calling thread, whatever it holds may be
+        // handed on with the new pin
+        pinned_epoch = thread_epoch;
+        __sync_fetch_and_add(&N_readers[pinned_epoch % LTE_FDD_ENB_EPOCH_MGR_N_EPOCHS], 1);
+    }else{
+        // Retry if the epoch advanced before the reader was counted
+        while(!pinned)
+        {
+            pinned_epoch = epoch;
+            __sync_fetch_and_add(&N_readers[pinned_epoch % LTE_FDD_ENB_EPOCH_MGR_N_EPOCHS], 1);
+            if(pinned_epoch == epoch)
+            {
+                pinned = true;
+            }else{
+                __sync_fetch_and_sub(&N_readers[pinned_epoch % LTE_FDD_ENB_EPOCH_MGR_N_EPOCHS], 1);
+            }
+        }
+    }
+
+    return(pinned_epoch);
+}
+void LTE_fdd_enb_epoch_mgr::unpin(uint64 pinned_epoch)
+{
+    __sync_fetch_and_sub(&N_readers[pinned_epoch % LTE_FDD_ENB_EPOCH_MGR_N_EPOCHS], 1);
+}
+void LTE_fdd_enb_epoch_mgr::set_thread_pin(uint64 pinned_epoch)
+{
+    thread_epoch  = pinned_epoch;
+    thread_pinned = true;
+}
+void LTE_fdd_enb_epoch_mgr::clear_thread_pin(void)
+{
+    thread_pinned = false;
+}
+
+/*********************/
+/*    Reclamation    */
+/*********************/
+void LTE_fdd_enb_epoch_mgr::retire(LTE_fdd_enb_epoch_free_func  free_func,
+                                   void                        *obj)
+{
+    boost::mutex::scoped_lock        lock(retire_mutex);
+    LTE_FDD_ENB_EPOCH_RETIRED_STRUCT retired;
+
+    // The object must already be unpublished, so only readers pinned in
+    // this epoch or earlier can still hold it
+    __sync_synchronize();
+    retired.free_func = free_func;
+    retired.obj       = obj;
+    retired.epoch     = epoch;
+    retired_list.push_back(retired);
+}
+void* LTE_fdd_enb_epoch_mgr::collect_thread_func(void *inputs)
+{
+    LTE_fdd_enb_epoch_mgr *epoch_mgr = (LTE_fdd_enb_epoch_mgr *)inputs;
+
+    // Runs whether or not the MAC is ticking the timers, so objects retired
+    // while the eNB is stopped are still freed
+    while(!epoch_mgr->collect_thread_stop)
+    {
+        usleep(LTE_FDD_ENB_EPOCH_MGR_COLLECT_PERIOD_MS*1000);
+        epoch_mgr->collect();
+    }
+
+    return(NULL);
+}
+void LTE_fdd_enb_epoch_mgr::collect(void)
+{
+    LTE_fdd_enb_timer_mgr                                *timer_mgr = LTE_fdd_enb_timer_mgr::get_instance();
+    std::list<LTE_FDD_ENB_EPOCH_RETIRED_STRUCT>           free_list;
+    std::list<LTE_FDD_ENB_EPOCH_RETIRED_STRUCT>::iterator iter;
+    uint64                                                cur_epoch;
+
+    retire_mutex.lock();
+
+    // Advance the epoch once the previous epoch has no readers left, only
+    // this function writes the epoch
+    cur_epoch = epoch;
+    __sync_synchronize();
+    if(0 == N_readers[(cur_epoch + LTE_FDD_ENB_EPOCH_MGR_N_EPOCHS - 1) % LTE_FDD_ENB_EPOCH_MGR_N_EPOCHS])
+    {
+        cur_epoch++;
+        epoch = cur_epoch;
+        __sync_synchronize();
+    }
+
+    // Objects retired two or more epochs ago can't be held by anyone
+    iter = retired_list.begin();
+    while(iter != retired_list.end() &&
+          ((*iter).epoch + 2) <= cur_epoch)
+    {
+        free_list.push_back(*iter);
+        iter = retired_list.erase(iter);
+    }
+
+    retire_mutex.unlock();
+
+    // Free without the lock, freeing may retire more objects.  Freed objects
+    // stop their timers, so keep timer callbacks from running until they
+    // are gone.
+    if(0 != free_list.size())
+    {
+        timer_mgr->lock_callbacks();
+        for(iter=free_list.begin(); iter!=free_list.end(); iter++)
+        {
+            (*iter).free_func((*iter).obj);
+        }
+        timer_mgr->unlock_callbacks();
+    }
+}
@@ -26,6 +26,9 @@
     Revision History
     ----------    -------------    --------------------------------------------
     06/15/2014    Ben Wojtowicz    Created file
+    10/19/2026    agent            Replaced the user list with an open
+                                   addressed subscriber table, added bulk
+                                   import, snapshots, and a user iterator.
 
 *******************************************************************************/
 
@@ -34,7 +37,12 @@
 *******************************************************************************/
 
 #include "LTE_fdd_enb_hss.h"
-#include <boost/lexical_cast.hpp>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <string.h>
 
 /*******************************************************************************
                               DEFINES
@@ -87,10 +95,15 @@ void LTE_fdd_enb_hss::cleanup(void)
 /********************************/
 LTE_fdd_enb_hss::LTE_fdd_enb_hss()
 {
-    user_list.clear();
+    table     = NULL;
+    table_mem = NULL;
+    N_slots   = 0;
+    N_users   = 0;
+    alloc_table(LTE_FDD_ENB_HSS_MIN_N_SLOTS);
 }
 LTE_fdd_enb_hss::~LTE_fdd_enb_hss()
 {
+    free_table();
 }
 
 /****************************/
@@ -98,74 +111,432 @@ LTE_fdd_enb_hss::~LTE_fdd_enb_hss()
 /****************************/
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_hss::add_user(std::string imsi)
 {
-    LTE_fdd_enb_user       *new_user = NULL;
-    LTE_FDD_ENB_ERROR_ENUM  err      = LTE_FDD_ENB_ERROR_BAD_ALLOC;
+    boost::mutex::scoped_lock lock(user_mutex);
+    LTE_FDD_ENB_ERROR_ENUM    err = LTE_FDD_ENB_ERROR_INVALID_PARAM;
+    uint64                    key;
 
-    new_user = new LTE_fdd_enb_user(imsi);
+    if(imsi_to_key(imsi, &key))
+    {
+        err = reserve(N_users + 1);
+        if(LTE_FDD_ENB_ERROR_NONE == err)
+        {
+            insert_key(key);
+        }
+    }
+
+    return(err);
+}
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_hss::find_user(std::string imsi)
+{
+    boost::mutex::scoped_lock lock(user_mutex);
+    LTE_FDD_ENB_ERROR_ENUM    err = LTE_FDD_ENB_ERROR_USER_NOT_FOUND;
+    uint64                    key;
+
+    if(NULL != table               &&
+       imsi_to_key(imsi, &key)     &&
+       key  == table[find_slot(key)].key)
+    {
+        err = LTE_FDD_ENB_ERROR_NONE;
+    }
 
-    if(NULL != new_user)
+    return(err);
+}
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_hss::del_user(std::string imsi)
+{
+    boost::mutex::scoped_lock lock(user_mutex);
+    LTE_FDD_ENB_ERROR_ENUM    err = LTE_FDD_ENB_ERROR_USER_NOT_FOUND;
+    uint64                    key;
+    uint32                    slot;
+
+    if(NULL != table &&
+       imsi_to_key(imsi, &key))
     {
-        user_mutex.lock();
-        user_list.push_back(new_user);
-        user_mutex.unlock();
+        slot = find_slot(key);
+        if(key == table[slot].key)
+        {
+            remove_slot(slot);
+            err = LTE_FDD_ENB_ERROR_NONE;
+        }
+    }
 
+    return(err);
+}
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_hss::import_users(std::string  file_name,
+                                                     uint32      *N_imported)
+{
+    boost::mutex::scoped_lock  lock(user_mutex);
+    LTE_FDD_ENB_ERROR_ENUM     err = LTE_FDD_ENB_ERROR_CANT_OPEN_FILE;
+    FILE                      *file;
+    struct stat                file_stat;
+    char                       line[64];
+    uint64                     key;
+    uint32                     len;
+
+    *N_imported = 0;
+    file        = fopen(file_name.c_str(), "r");
+    if(NULL != file)
+    {
+        // Size the table for the whole file up front, assuming a line per
+        // 15 digit IMSI, instead of growing it repeatedly
         err = LTE_FDD_ENB_ERROR_NONE;
+        if(0 == fstat(fileno(file), &file_stat))
+        {
+            err = reserve(N_users + (file_stat.st_size / (LTE_FDD_ENB_HSS_MAX_IMSI_DIGITS + 1)));
+        }
+
+        // One IMSI per line, blank lines and lines starting with # are skipped
+        while(LTE_FDD_ENB_ERROR_NONE == err &&
+              NULL                   != fgets(line, sizeof(line), file))
+        {
+            len = strcspn(line, "\r\n");
+            if(0   != len &&
+               '#' != line[0])
+            {
+                if(imsi_to_key(std::string(line, len), &key))
+                {
+                    err = reserve(N_users + 1);
+                    if(LTE_FDD_ENB_ERROR_NONE == err)
+                    {
+                        insert_key(key);
+                        (*N_imported)++;
+                    }
+                }else{
+                    err = LTE_FDD_ENB_ERROR_INVALID_PARAM;
+                }
+            }
+        }
+        fclose(file);
+    }
+
+    return(err);
+}
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_hss::save_snapshot(std::string file_name)
+{
+    boost::mutex::scoped_lock            lock(user_mutex);
+    LTE_FDD_ENB_HSS_SNAPSHOT_HDR_STRUCT  hdr;
+    LTE_FDD_ENB_ERROR_ENUM               err      = LTE_FDD_ENB_ERROR_CANT_OPEN_FILE;
+    FILE                                *file;
+    std::string                          tmp_name = file_name + ".tmp";
+    bool                                 written;
+
+    // Write to a temporary file and rename it so that an existing
+    // snapshot is never left half written
+    file = fopen(tmp_name.c_str(), "w");
+    if(NULL != file)
+    {
+        hdr.magic   = LTE_FDD_ENB_HSS_SNAPSHOT_MAGIC;
+        hdr.version = LTE_FDD_ENB_HSS_SNAPSHOT_VERSION;
+        hdr.N_slots = N_slots;
+        hdr.N_users = N_users;
+        written = (1       == fwrite(&hdr, sizeof(hdr), 1, file) &&
+                   N_slots == fwrite(table, sizeof(LTE_FDD_ENB_HSS_SUB_STRUCT), N_slots, file));
+        if(0 == fclose(file) &&
+           written           &&
+           0 == rename(tmp_name.c_str(), file_name.c_str()))
+        {
+            err = LTE_FDD_ENB_ERROR_NONE;
+        }else{
+            unlink(tmp_name.c_str());
+        }
+    }
+
+    return(err);
+}
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_hss::load_snapshot(std::string file_name)
+{
+    boost::mutex::scoped_lock            lock(user_mutex);
+    LTE_FDD_ENB_HSS_SNAPSHOT_HDR_STRUCT *hdr;
+    LTE_FDD_ENB_HSS_SUB_STRUCT          *snap_table;
+    LTE_FDD_ENB_ERROR_ENUM               err = LTE_FDD_ENB_ERROR_CANT_OPEN_FILE;
+    struct stat                          file_stat;
+    void                                *mem = MAP_FAILED;
+    uint32                               N_used;
+    uint32                               i;
+    int                                  fd;
+    bool                                 valid;
+
+    fd = open(file_name.c_str(), O_RDONLY);
+    if(-1 != fd)
+    {
+        err = LTE_FDD_ENB_ERROR_INVALID_SNAPSHOT;
+        if(0            == fstat(fd, &file_stat) &&
+           sizeof(*hdr) <= (size_t)file_stat.st_size)
+        {
+            // Map the snapshot copy on write and use it as the table directly
+            mem = mmap(NULL,
+                       file_stat.st_size,
+                       PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_POPULATE,
+                       fd,
+                       0);
+        }
+        close(fd);
+
+        if(MAP_FAILED != mem)
+        {
+            hdr        = (LTE_FDD_ENB_HSS_SNAPSHOT_HDR_STRUCT *)mem;
+            snap_table = (LTE_FDD_ENB_HSS_SUB_STRUCT *)((uint8 *)mem + sizeof(*hdr));
+            N_used     = 0;
+            valid      = false;
+            if(LTE_FDD_ENB_HSS_SNAPSHOT_MAGIC   == hdr->magic                            &&
+               LTE_FDD_ENB_HSS_SNAPSHOT_VERSION == hdr->version                          &&
+               LTE_FDD_ENB_HSS_MIN_N_SLOTS      <= hdr->N_slots                          &&
+               0                                == (hdr->N_slots & (hdr->N_slots - 1)) &&
+               (size_t)file_stat.st_size        == sizeof(*hdr) + ((size_t)hdr->N_slots * sizeof(LTE_FDD_ENB_HSS_SUB_STRUCT)))
+            {
+                for(i=0; i<hdr->N_slots; i++)
+                {
+                    if(0 != snap_table[i].key)
+                    {
+                        N_used++;
+                    }
+                }
+                valid = (hdr->N_users == N_used &&
+                         N_used       <= hdr->N_slots / 2);
+
+                // Every key must be where a lookup probes for it, which also
+                // rejects duplicate keys
+                for(i=0; i<hdr->N_slots && valid; i++)
+                {
+                    if(0 != snap_table[i].key &&
+                       i != find_slot(snap_table, hdr->N_slots, snap_table[i].key))
+                    {
+                        valid = false;
+                    }
+                }
+            }
+
+            if(valid)
+            {
+                free_table();
+                table          = snap_table;
+                table_mem      = mem;
+                table_mem_size = file_stat.st_size;
+                N_slots        = hdr->N_slots;
+                N_users        = hdr->N_users;
+                err            = LTE_FDD_ENB_ERROR_NONE;
+            }else{
+                munmap(mem, file_stat.st_size);
+            }
+        }
     }
 
     return(err);
 }
-LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_hss::find_user(std::string        imsi,
-                                                  LTE_fdd_enb_user **user)
+uint32 LTE_fdd_enb_hss::get_n_users(void)
+{
+    boost::mutex::scoped_lock lock(user_mutex);
+
+    return(N_users);
+}
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_hss::get_next_user(uint32      *cursor,
+                                                      std::string *imsi)
 {
-    boost::mutex::scoped_lock               lock(user_mutex);
-    std::list<LTE_fdd_enb_user *>::iterator iter;
-    LTE_FDD_ENB_ERROR_ENUM                  err = LTE_FDD_ENB_ERROR_USER_NOT_FOUND;
+    boost::mutex::scoped_lock lock(user_mutex);
+    LTE_FDD_ENB_ERROR_ENUM    err = LTE_FDD_ENB_ERROR_USER_NOT_FOUND;
 
-    for(iter=user_list.begin(); iter!=user_list.end(); iter++)
+    // Cursor is a slot index, start at 0, users added or deleted while
+    // iterating may be skipped or repeated
+    while(*cursor                < N_slots &&
+          LTE_FDD_ENB_ERROR_NONE != err)
     {
-        if((*iter)->get_imsi() == imsi)
+        if(0 != table[*cursor].key)
         {
-            *user = (*iter);
+            *imsi = key_to_imsi(table[*cursor].key);
             err   = LTE_FDD_ENB_ERROR_NONE;
-            break;
         }
+        (*cursor)++;
     }
 
     return(err);
 }
-LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_hss::del_user(std::string imsi)
+
+/**************************/
+/*    Subscriber Table    */
+/**************************/
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_hss::alloc_table(uint32 _N_slots)
+{
+    LTE_FDD_ENB_ERROR_ENUM  err = LTE_FDD_ENB_ERROR_BAD_ALLOC;
+    void                   *mem;
+    size_t                  mem_size;
+
+    // Anonymous mappings come back zeroed, which marks every slot empty
+    mem_size = (size_t)_N_slots * sizeof(LTE_FDD_ENB_HSS_SUB_STRUCT);
+    mem      = mmap(NULL,
+                    mem_size,
+                    PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS,
+                    -1,
+                    0);
+
+    if(MAP_FAILED != mem)
+    {
+        table          = (LTE_FDD_ENB_HSS_SUB_STRUCT *)mem;
+        table_mem      = mem;
+        table_mem_size = mem_size;
+        N_slots        = _N_slots;
+        N_users        = 0;
+        err          = LTE_FDD_ENB_ERROR_NONE;
+    }
+
+    return(err);
+}
+void LTE_fdd_enb_hss::free_table(void)
+{
+    if(NULL != table_mem)
+    {
+        munmap(table_mem, table_mem_size);
+        table     = NULL;
+        table_mem = NULL;
+        N_slots   = 0;
+        N_users   = 0;
+    }
+}
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_hss::reserve(uint32 _N_users)
 {
-    boost::mutex::scoped_lock                lock(user_mutex);
-    std::list<LTE_fdd_enb_user *>::iterator  iter;
-    LTE_fdd_enb_user                        *user = NULL;
-    LTE_FDD_ENB_ERROR_ENUM                   err  = LTE_FDD_ENB_ERROR_USER_NOT_FOUND;
+    LTE_FDD_ENB_HSS_SUB_STRUCT *old_table    = table;
+    LTE_FDD_ENB_ERROR_ENUM      err          = LTE_FDD_ENB_ERROR_NONE;
+    void                       *old_mem      = table_mem;
+    size_t                      old_mem_size = table_mem_size;
+    uint32                      old_N_slots  = N_slots;
+    uint32                      old_N_users  = N_users;
+    uint32                      new_N_slots  = N_slots;
+    uint32                      i;
+
+    // Keep the load factor at or below 1/2
+    if(0 == new_N_slots)
+    {
+        new_N_slots = LTE_FDD_ENB_HSS_MIN_N_SLOTS;
+    }
+    while(_N_users > new_N_slots / 2)
+    {
+        new_N_slots *= 2;
+    }
 
-    for(iter=user_list.begin(); iter!=user_list.end(); iter++)
+    if(new_N_slots != N_slots)
     {
-        if((*iter)->get_imsi() == imsi)
+        err = alloc_table(new_N_slots);
+        if(LTE_FDD_ENB_ERROR_NONE == err)
         {
-            user = (*iter);
-            user_list.erase(iter);
-            delete user;
-            err = LTE_FDD_ENB_ERROR_NONE;
-            break;
+            for(i=0; i<old_N_slots; i++)
+            {
+                if(0 != old_table[i].key)
+                {
+                    insert_key(old_table[i].key);
+                }
+            }
+            if(NULL != old_mem)
+            {
+                munmap(old_mem, old_mem_size);
+            }
+        }else{
+            table          = old_table;
+            table_mem      = old_mem;
+            table_mem_size = old_mem_size;
+            N_slots        = old_N_slots;
+            N_users        = old_N_users;
         }
     }
 
     return(err);
 }
-std::string LTE_fdd_enb_hss::print_all_users(void)
+uint32 LTE_fdd_enb_hss::find_slot(uint64 key)
+{
+    return(find_slot(table, N_slots, key));
+}
+uint32 LTE_fdd_enb_hss::find_slot(LTE_FDD_ENB_HSS_SUB_STRUCT *_table,
+                                  uint32                      _N_slots,
+                                  uint64                      key)
+{
+    uint64 hash = key;
+    uint32 slot;
+
+    // 64 bit finalizer from MurmurHash3
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDULL;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ULL;
+    hash ^= hash >> 33;
+
+    // Linear probe to either the key or the first empty slot
+    slot = hash & (_N_slots - 1);
+    while(0   != _table[slot].key &&
+          key != _table[slot].key)
+    {
+        slot = (slot + 1) & (_N_slots - 1);
+    }
+
+    return(slot);
+}
+void LTE_fdd_enb_hss::insert_key(uint64 key)
+{
+    uint32 slot = find_slot(key);
+
+    if(0 == table[slot].key)
+    {
+        table[slot].key = key;
+        N_users++;
+    }
+}
+void LTE_fdd_enb_hss::remove_slot(uint32 slot)
+{
+    uint32 next_slot = (slot + 1) & (N_slots - 1);
+    uint32 home_slot;
+
+    // Backward shift deletion, move following entries of the probe
+    // sequence into the hole so that no tombstones are needed
+    table[slot].key = 0;
+    N_users--;
+    while(0 != table[next_slot].key)
+    {
+        home_slot = find_slot(table[next_slot].key);
+        if(home_slot != next_slot)
+        {
+            table[slot].key      = table[next_slot].key;
+            table[next_slot].key = 0;
+            slot                 = next_slot;
+        }
+        next_slot = (next_slot + 1) & (N_slots - 1);
+    }
+}
+bool LTE_fdd_enb_hss::imsi_to_key(std::string  imsi,
+                                  uint64      *key)
+{
+    uint32 i;
+    bool   valid = false;
+
+    if(0                               != imsi.size() &&
+       LTE_FDD_ENB_HSS_MAX_IMSI_DIGITS >= imsi.size())
+    {
+        valid = true;
+        *key  = 0;
+        for(i=0; i<imsi.size(); i++)
+        {
+            if('0' <= imsi[i] &&
+               '9' >= imsi[i])
+            {
+                *key = (*key * 10) + (imsi[i] - '0');
+            }else{
+                valid = false;
+            }
+        }
+        *key |= (uint64)imsi.size() << 56;
+    }
+
+    return(valid);
+}
+std::string LTE_fdd_enb_hss::key_to_imsi(uint64 key)
 {
-    boost::mutex::scoped_lock               lock(user_mutex);
-    std::list<LTE_fdd_enb_user *>::iterator iter;
-    std::string                             output;
+    char   digits[LTE_FDD_ENB_HSS_MAX_IMSI_DIGITS];
+    uint64 value    = key & 0x00FFFFFFFFFFFFFFULL;
+    uint32 N_digits = key >> 56;
+    uint32 i;
 
-    output = boost::lexical_cast<std::string>(user_list.size());
-    for(iter=user_list.begin(); iter!=user_list.end(); iter++)
+    for(i=0; i<N_digits; i++)
     {
-        output += "\n";
-        output += (*iter)->get_imsi();
+        digits[N_digits-i-1] = '0' + (value % 10);
+        value               /= 10;
     }
 
-    return(output);
+    return(std::string(digits, N_digits));
 }
@@ -33,6 +33,17 @@
     05/04/2014    Ben Wojtowicz    Added PCAP support.
     06/15/2014    Ben Wojtowicz    Added  ... support for info messages and
                                    using the latest LTE library.
+    10/19/2026    agent            Added no_rf loopback radio parameters and
+                                   processing time statistics.
+    10/19/2026    agent            Added the DL scheduling policy parameter.
+    10/19/2026    agent            Added the timer_bench command.
+    10/19/2026    agent            Added the HSS user commands.
+    10/19/2026    agent            Moved debug messages to per thread rings
+                                   drained by a formatter thread and added the
+                                   debug file and stats parameters.
+    10/19/2026    agent            Moved PCAP capture to LTE_fdd_enb_pcap and
+                                   added the PCAP parameters and pcap_dump
+                                   command.
 
 *******************************************************************************/
 
@@ -43,6 +54,7 @@
 #include "LTE_fdd_enb_interface.h"
 #include "LTE_fdd_enb_cnfg_db.h"
 #include "LTE_fdd_enb_hss.h"
+#include "LTE_fdd_enb_pcap.h"
 #include "LTE_fdd_enb_mme.h"
 #include "LTE_fdd_enb_rrc.h"
 #include "LTE_fdd_enb_pdcp.h"
@@ -53,8 +65,11 @@
 #include "liblte_interface.h"
 #include <boost/lexical_cast.hpp>
 #include <boost/interprocess/ipc/message_queue.hpp>
-#include <iomanip>
+#include <unistd.h>
 #include <arpa/inet.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
 
 /*******************************************************************************
                               DEFINES
@@ -70,12 +85,13 @@
                               GLOBAL VARIABLES
 *******************************************************************************/
 
-LTE_fdd_enb_interface* LTE_fdd_enb_interface::instance = NULL;
-boost::mutex           interface_instance_mutex;
-boost::mutex           ctrl_connect_mutex;
-boost::mutex           debug_connect_mutex;
-bool                   LTE_fdd_enb_interface::ctrl_connected  = false;
-bool                   LTE_fdd_enb_interface::debug_connected = false;
+LTE_fdd_enb_interface*                  LTE_fdd_enb_interface::instance = NULL;
+boost::mutex                            interface_instance_mutex;
+boost::mutex                            ctrl_connect_mutex;
+boost::mutex                            debug_connect_mutex;
+bool                                    LTE_fdd_enb_interface::ctrl_connected  = false;
+bool                                    LTE_fdd_enb_interface::debug_connected = false;
+__thread LTE_FDD_ENB_DEBUG_RING_STRUCT* LTE_fdd_enb_interface::debug_ring      = NULL;
 
 /*******************************************************************************
                               CLASS IMPLEMENTATIONS
@@ -145,6 +161,7 @@ LTE_fdd_enb_interface::LTE_fdd_enb_interface()
     var_map[lte_fdd_enb_param_text[LTE_FDD_ENB_PARAM_DEBUG_TYPE]]         = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_UINT32, LTE_FDD_ENB_PARAM_DEBUG_TYPE, 0, 0, 0, 0, true, true};
     var_map[lte_fdd_enb_param_text[LTE_FDD_ENB_PARAM_DEBUG_LEVEL]]        = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_UINT32, LTE_FDD_ENB_PARAM_DEBUG_LEVEL, 0, 0, 0, 0, true, true};
     var_map[lte_fdd_enb_param_text[LTE_FDD_ENB_PARAM_ENABLE_PCAP]]        = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_ENABLE_PCAP, 0, 0, 0, 1, false, true};
+    var_map[lte_fdd_enb_param_text[LTE_FDD_ENB_PARAM_DL_SCHED_POLICY]]    = (LTE_FDD_ENB_VAR_STRUCT){LTE_FDD_ENB_VAR_TYPE_INT64, LTE_FDD_ENB_PARAM_DL_SCHED_POLICY, 0, 0, 0, LTE_FDD_ENB_DL_SCHED_POLICY_N_ITEMS-1, false, true};
 
     debug_type_mask = 0;
     for(i=0; i<LTE_FDD_ENB_DEBUG_TYPE_N_ITEMS; i++)
@@ -156,15 +173,46 @@ LTE_fdd_enb_interface::LTE_fdd_enb_interface()
     {
         debug_level_mask |= 1 << i;
     }
-    open_pcap_fd();
+    pcap     = LTE_fdd_enb_pcap::get_instance();
     shutdown = false;
     started  = false;
+
+    // Debug rings
+    N_debug_rings                = 0;
+    N_debug_unregistered_dropped = 0;
+    N_debug_records              = 0;
+    debug_file_name              = "none";
+    debug_file                   = NULL;
+    debug_thread_stop            = false;
+    debug_batch.reserve(LTE_FDD_ENB_DEBUG_BATCH_SIZE*2);
+    gettimeofday(&debug_time_base, NULL);
+    debug_tsc_base   = debug_get_tsc();
+    debug_tsc_per_us = 1;
+    pthread_key_create(&debug_ring_key, &debug_ring_release);
+    pthread_create(&debug_thread, NULL, &debug_thread_func, this);
 }
 LTE_fdd_enb_interface::~LTE_fdd_enb_interface()
 {
+    uint32 i;
+
+    // Stop the formatter before the debug socket goes away
+    debug_thread_stop = true;
+    pthread_join(debug_thread, NULL);
+
     stop_ports();
 
-    fclose(pcap_fd);
+    pthread_key_delete(debug_ring_key);
+    for(i=0; i<N_debug_rings; i++)
+    {
+        delete debug_rings[i];
+    }
+    debug_ring = NULL;
+    if(NULL != debug_file)
+    {
+        fclose(debug_file);
+    }
+
+    LTE_fdd_enb_pcap::cleanup();
 }
 
 /***********************/
@@ -304,307 +352,106 @@ void LTE_fdd_enb_interface::send_ctrl_error_msg(LTE_FDD_ENB_ERROR_ENUM error,
 }
 void LTE_fdd_enb_interface::send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ENUM  type,
                                            LTE_FDD_ENB_DEBUG_LEVEL_ENUM level,
-                                           std::string                  file_name,
+                                           const char                  *file_name,
                                            int32                        line,
-                                           std::string                  msg,
+                                           const char                  *msg,
                                            ...)
 {
-    boost::mutex::scoped_lock  lock(debug_connect_mutex);
-    std::string                tmp_msg;
-    std::stringstream          tmp_ss;
-    va_list                    args;
-    struct timeval             time;
-    struct timezone            time_zone;
-    char                      *args_msg;
+    LTE_FDD_ENB_DEBUG_RECORD_STRUCT *record;
+    va_list                          args;
 
-    if(debug_connected                 &&
-       (debug_type_mask & (1 << type)) &&
-       (debug_level_mask & (1 << level)))
+    if(debug_is_enabled(type, level))
     {
-        // Format the output string
-        gettimeofday(&time, &time_zone);
-        tmp_msg  = boost::lexical_cast<std::string>(time.tv_sec) + ".";
-        tmp_ss  << std::setw(6) << std::setfill('0') << time.tv_usec;
-        tmp_msg += tmp_ss.str() + " ";
-        tmp_msg += LTE_fdd_enb_debug_type_text[type];
-        tmp_msg += " ";
-        tmp_msg += LTE_fdd_enb_debug_level_text[level];
-        tmp_msg += " ";
-        tmp_msg += file_name.c_str();
-        tmp_msg += " ";
-        tmp_msg += boost::lexical_cast<std::string>(line);
-        tmp_msg += " ";
         va_start(args, msg);
-        if(-1 != vasprintf(&args_msg, msg.c_str(), args))
-        {
-            tmp_msg += args_msg;
-        }
-        tmp_msg += "\n";
+        record = debug_start_record(type, level, file_name, line, msg, args);
+        va_end(args);
 
-        // Cleanup the variable argument string
-        free(args_msg);
-
-        debug_socket->send(tmp_msg);
+        debug_commit_record(record);
     }
 }
 void LTE_fdd_enb_interface::send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ENUM   type,
                                            LTE_FDD_ENB_DEBUG_LEVEL_ENUM  level,
-                                           std::string                   file_name,
+                                           const char                   *file_name,
                                            int32                         line,
                                            LIBLTE_BIT_MSG_STRUCT        *lte_msg,
-                                           std::string                   msg,
+                                           const char                   *msg,
                                            ...)
 {
-    boost::mutex::scoped_lock  lock(debug_connect_mutex);
-    std::string                tmp_msg;
-    std::stringstream          tmp_ss;
-    va_list                    args;
-    struct timeval             time;
-    struct timezone            time_zone;
-    uint32                     i;
-    uint32                     hex_val;
-    char                      *args_msg;
+    LTE_FDD_ENB_DEBUG_RECORD_STRUCT *record;
+    va_list                          args;
+    uint32                           N_bits;
+    uint32                           i;
 
-    if(debug_connected                 &&
-       (debug_type_mask & (1 << type)) &&
-       (debug_level_mask & (1 << level)))
+    if(debug_is_enabled(type, level))
     {
-        // Format the output string
-        gettimeofday(&time, &time_zone);
-        tmp_msg  = boost::lexical_cast<std::string>(time.tv_sec) + ".";
-        tmp_ss  << std::setw(6) << std::setfill('0') << time.tv_usec;
-        tmp_msg += tmp_ss.str() + " ";
-        tmp_msg += LTE_fdd_enb_debug_type_text[type];
-        tmp_msg += " ";
-        tmp_msg += LTE_fdd_enb_debug_level_text[level];
-        tmp_msg += " ";
-        tmp_msg += file_name.c_str();
-        tmp_msg += " ";
-        tmp_msg += boost::lexical_cast<std::string>(line);
-        tmp_msg += " ";
         va_start(args, msg);
-        if(-1 != vasprintf(&args_msg, msg.c_str(), args))
-        {
-            tmp_msg += args_msg;
-        }
-        tmp_msg += " ";
-        hex_val  = 0;
-        for(i=0; i<lte_msg->N_bits; i++)
-        {
-            hex_val <<= 1;
-            hex_val  |= lte_msg->msg[i];
-            if((i % 4) == 3)
-            {
-                if(hex_val < 0xA)
-                {
-                    tmp_msg += (char)(hex_val + '0');
-                }else{
-                    tmp_msg += (char)((hex_val-0xA) + 'A');
-                }
-                hex_val = 0;
-            }
-        }
-        if((lte_msg->N_bits % 4) != 0)
+        record = debug_start_record(type, level, file_name, line, msg, args);
+        va_end(args);
+
+        if(NULL != record)
         {
-            for(i=0; i<4-(lte_msg->N_bits % 4); i++)
+            // Pack the bits MSB first, the formatter prints one nibble per 4 bits
+            N_bits              = lte_msg->N_bits;
+            record->N_hex_bytes = (N_bits + 7)/8;
+            if(N_bits > LTE_FDD_ENB_DEBUG_MAX_HEX_SIZE*8)
             {
-                hex_val <<= 1;
+                N_bits                = LTE_FDD_ENB_DEBUG_MAX_HEX_SIZE*8;
+                record->hex_truncated = true;
             }
-            if(hex_val < 0xA)
+            memset(record->hex, 0, (N_bits + 7)/8);
+            for(i=0; i<N_bits; i++)
             {
-                tmp_msg += (char)(hex_val + '0');
-            }else{
-                tmp_msg += (char)((hex_val-0xA) + 'A');
+                record->hex[i/8] |= (lte_msg->msg[i] & 1) << (7 - (i % 8));
             }
+            record->N_hex       = (N_bits + 3)/4;
+            record->hex_present = true;
         }
-        tmp_msg += "\n";
 
-        // Cleanup the variable argument string
-        free(args_msg);
-
-        debug_socket->send(tmp_msg);
+        debug_commit_record(record);
     }
 }
 void LTE_fdd_enb_interface::send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ENUM   type,
                                            LTE_FDD_ENB_DEBUG_LEVEL_ENUM  level,
-                                           std::string                   file_name,
+                                           const char                   *file_name,
                                            int32                         line,
                                            LIBLTE_BYTE_MSG_STRUCT       *lte_msg,
-                                           std::string                   msg,
+                                           const char                   *msg,
                                            ...)
 {
-    boost::mutex::scoped_lock  lock(debug_connect_mutex);
-    std::string                tmp_msg;
-    std::stringstream          tmp_ss;
-    va_list                    args;
-    struct timeval             time;
-    struct timezone            time_zone;
-    uint32                     i;
-    uint32                     hex_val;
-    char                      *args_msg;
+    LTE_FDD_ENB_DEBUG_RECORD_STRUCT *record;
+    va_list                          args;
+    uint32                           N_bytes;
 
-    if(debug_connected                 &&
-       (debug_type_mask & (1 << type)) &&
-       (debug_level_mask & (1 << level)))
+    if(debug_is_enabled(type, level))
     {
-        // Format the output string
-        gettimeofday(&time, &time_zone);
-        tmp_msg  = boost::lexical_cast<std::string>(time.tv_sec) + ".";
-        tmp_ss  << std::setw(6) << std::setfill('0') << time.tv_usec;
-        tmp_msg += tmp_ss.str() + " ";
-        tmp_msg += LTE_fdd_enb_debug_type_text[type];
-        tmp_msg += " ";
-        tmp_msg += LTE_fdd_enb_debug_level_text[level];
-        tmp_msg += " ";
-        tmp_msg += file_name.c_str();
-        tmp_msg += " ";
-        tmp_msg += boost::lexical_cast<std::string>(line);
-        tmp_msg += " ";
         va_start(args, msg);
-        if(-1 != vasprintf(&args_msg, msg.c_str(), args))
-        {
-            tmp_msg += args_msg;
-        }
-        tmp_msg += " ";
-        for(i=0; i<lte_msg->N_bytes; i++)
+        record = debug_start_record(type, level, file_name, line, msg, args);
+        va_end(args);
+
+        if(NULL != record)
         {
-            hex_val = (lte_msg->msg[i] >> 4) & 0xF;
-            if(hex_val < 0xA)
+            N_bytes             = lte_msg->N_bytes;
+            record->N_hex_bytes = N_bytes;
+            if(N_bytes > LTE_FDD_ENB_DEBUG_MAX_HEX_SIZE)
             {
-                tmp_msg += (char)(hex_val + '0');
-            }else{
-                tmp_msg += (char)((hex_val-0xA) + 'A');
-            }
-            hex_val = lte_msg->msg[i] & 0xF;
-            if(hex_val < 0xA)
-            {
-                tmp_msg += (char)(hex_val + '0');
-            }else{
-                tmp_msg += (char)((hex_val-0xA) + 'A');
+                N_bytes               = LTE_FDD_ENB_DEBUG_MAX_HEX_SIZE;
+                record->hex_truncated = true;
             }
+            memcpy(record->hex, lte_msg->msg, N_bytes);
+            record->N_hex       = N_bytes*2;
+            record->hex_present = true;
         }
-        tmp_msg += "\n";
 
-        // Cleanup the variable argument string
-        free(args_msg);
-
-        debug_socket->send(tmp_msg);
+        debug_commit_record(record);
     }
 }
-void LTE_fdd_enb_interface::open_pcap_fd(void)
-{
-    uint32 magic_number  = 0xa1b2c3d4;
-    uint32 timezone      = 0;
-    uint32 sigfigs       = 0;
-    uint32 snap_len      = (LIBLTE_MAX_MSG_SIZE/4);
-    uint32 dlt           = 147;
-    uint16 major_version = 2;
-    uint16 minor_version = 4;
-
-    pcap_fd = fopen("/tmp/LTE_fdd_enodeb.pcap", "w");
-
-    fwrite(&magic_number,  sizeof(magic_number),  1, pcap_fd);
-    fwrite(&major_version, sizeof(major_version), 1, pcap_fd);
-    fwrite(&minor_version, sizeof(minor_version), 1, pcap_fd);
-    fwrite(&timezone,      sizeof(timezone),      1, pcap_fd);
-    fwrite(&sigfigs,       sizeof(sigfigs),       1, pcap_fd);
-    fwrite(&snap_len,      sizeof(snap_len),      1, pcap_fd);
-    fwrite(&dlt,           sizeof(dlt),           1, pcap_fd);
-}
 void LTE_fdd_enb_interface::send_pcap_msg(LTE_FDD_ENB_PCAP_DIRECTION_ENUM  dir,
                                           uint32                           rnti,
                                           uint32                           current_tti,
                                           uint8                           *msg,
                                           uint32                           N_bits)
 {
-    LTE_fdd_enb_cnfg_db *cnfg_db = LTE_fdd_enb_cnfg_db::get_instance();
-    struct timeval       time;
-    struct timezone      time_zone;
-    int64                enable_pcap;
-    uint32               i;
-    uint32               idx;
-    uint32               length;
-    uint16               tmp;
-    uint8                pcap_c_hdr[15];
-    uint8                pcap_msg[LIBLTE_MAX_MSG_SIZE/8];
-
-    cnfg_db->get_param(LTE_FDD_ENB_PARAM_ENABLE_PCAP, enable_pcap);
-
-    if(enable_pcap)
-    {
-        // Get approximate time stamp
-        gettimeofday(&time, &time_zone);
-
-        // Radio Type
-        pcap_c_hdr[0] = 1;
-
-        // Direction
-        pcap_c_hdr[1] = dir;
-
-        // RNTI Type
-        if(0xFFFFFFFF == rnti)
-        {
-            pcap_c_hdr[2] = 0;
-        }else if(LIBLTE_MAC_P_RNTI == rnti){
-            pcap_c_hdr[2] = 1;
-        }else if(LIBLTE_MAC_RA_RNTI_START <= rnti &&
-                 LIBLTE_MAC_RA_RNTI_END   >= rnti){
-            pcap_c_hdr[2] = 2;
-        }else if(LIBLTE_MAC_SI_RNTI == rnti){
-            pcap_c_hdr[2] = 4;
-        }else if(LIBLTE_MAC_M_RNTI == rnti){
-            pcap_c_hdr[2] = 6;
-        }else{
-            pcap_c_hdr[2] = 3;
-        }
-
-        // RNTI Tag and RNTI
-        pcap_c_hdr[3] = 2;
-        tmp           = htons((uint16)rnti);
-        memcpy(&pcap_c_hdr[4], &tmp, sizeof(uint16));
-
-        // UEID Tag and UEID
-        pcap_c_hdr[6] = 3;
-        pcap_c_hdr[7] = 0;
-        pcap_c_hdr[8] = 0;
-
-        // SUBFN Tag and SUBFN
-        pcap_c_hdr[9] = 4;
-        tmp           = htons((uint16)(current_tti%10));
-        memcpy(&pcap_c_hdr[10], &tmp, sizeof(uint16));
-
-        // CRC Status Tag and CRC Status
-        pcap_c_hdr[12] = 7;
-        pcap_c_hdr[13] = 1;
-
-        // Payload Tag
-        pcap_c_hdr[14] = 1;
-
-        // Payload
-        idx           = 0;
-        pcap_msg[idx] = 0;
-        for(i=0; i<N_bits; i++)
-        {
-            pcap_msg[idx] <<= 1;
-            pcap_msg[idx]  |= msg[i];
-            if((i % 8) == 7)
-            {
-                idx++;
-                pcap_msg[idx] = 0;
-            }
-        }
-
-        // Total Length
-        length = 15 + idx;
-
-        // Write Data
-        fwrite(&time.tv_sec,  sizeof(uint32), 1,   pcap_fd);
-        fwrite(&time.tv_usec, sizeof(uint32), 1,   pcap_fd);
-        fwrite(&length,       sizeof(uint32), 1,   pcap_fd);
-        fwrite(&length,       sizeof(uint32), 1,   pcap_fd);
-        fwrite(pcap_c_hdr,    sizeof(uint8),  15,  pcap_fd);
-        fwrite(pcap_msg,      sizeof(uint8),  idx, pcap_fd);
-    }
+    pcap->send(dir, rnti, current_tti, msg, N_bits);
 }
 void LTE_fdd_enb_interface::handle_ctrl_msg(std::string msg)
 {
@@ -612,8 +459,16 @@ void LTE_fdd_enb_interface::handle_ctrl_msg(std::string msg)
     LTE_fdd_enb_cnfg_db   *cnfg_db   = LTE_fdd_enb_cnfg_db::get_instance();
     LTE_fdd_enb_radio     *radio     = LTE_fdd_enb_radio::get_instance();
 
-    if(std::string::npos != msg.find("read"))
+    // HSS commands take IMSIs and file names, so check them first
+    if(std::string::npos != msg.find("add_user")       ||
+       std::string::npos != msg.find("del_user")       ||
+       std::string::npos != msg.find("print_users")    ||
+       std::string::npos != msg.find("import_users")   ||
+       std::string::npos != msg.find("save_users")     ||
+       std::string::npos != msg.find("load_users"))
     {
+        interface->handle_hss_cmd(msg);
+    }else if(std::string::npos != msg.find("read")){
         interface->handle_read(msg.substr(msg.find("read")+sizeof("read"), std::string::npos));
     }else if(std::string::npos != msg.find("write")){
         interface->handle_write(msg.substr(msg.find("write")+sizeof("write"), std::string::npos));
@@ -632,6 +487,8 @@ void LTE_fdd_enb_interface::handle_ctrl_msg(std::string msg)
     }else if(std::string::npos != msg.find("construct_si")){
         cnfg_db->construct_sys_info();
         interface->send_ctrl_error_msg(LTE_FDD_ENB_ERROR_NONE, "");
+    }else if(std::string::npos != msg.find("pcap_dump")){
+        interface->handle_pcap_dump();
     }else if(std::string::npos != msg.find("help")){
         interface->handle_help();
     }else{
@@ -769,6 +626,24 @@ void LTE_fdd_enb_interface::handle_read(std::string msg)
                 send_ctrl_error_msg(LTE_FDD_ENB_ERROR_INVALID_PARAM, "");
                 break;
             }
+        }else if(std::string::npos != msg.find(lte_fdd_enb_param_text[LTE_FDD_ENB_PARAM_DEBUG_FILE])){
+            send_ctrl_error_msg(LTE_FDD_ENB_ERROR_NONE, get_debug_file());
+        }else if(std::string::npos != msg.find(lte_fdd_enb_param_text[LTE_FDD_ENB_PARAM_DEBUG_STATS])){
+            send_ctrl_error_msg(LTE_FDD_ENB_ERROR_NONE, get_debug_stats());
+        }else if(std::string::npos != msg.find(lte_fdd_enb_param_text[LTE_FDD_ENB_PARAM_PCAP_FILE])){
+            send_ctrl_error_msg(LTE_FDD_ENB_ERROR_NONE, pcap->get_file());
+        }else if(std::string::npos != msg.find(lte_fdd_enb_param_text[LTE_FDD_ENB_PARAM_PCAP_FORMAT])){
+            send_ctrl_error_msg(LTE_FDD_ENB_ERROR_NONE, LTE_fdd_enb_pcap_format_text[pcap->get_format()]);
+        }else if(std::string::npos != msg.find(lte_fdd_enb_param_text[LTE_FDD_ENB_PARAM_PCAP_MAX_FILE_SIZE])){
+            send_ctrl_error_msg(LTE_FDD_ENB_ERROR_NONE, boost::lexical_cast<std::string>(pcap->get_max_file_size()));
+        }else if(std::string::npos != msg.find(lte_fdd_enb_param_text[LTE_FDD_ENB_PARAM_PCAP_MAX_FILE_SECS])){
+            send_ctrl_error_msg(LTE_FDD_ENB_ERROR_NONE, boost::lexical_cast<std::string>(pcap->get_max_file_secs()));
+        }else if(std::string::npos != msg.find(lte_fdd_enb_param_text[LTE_FDD_ENB_PARAM_PCAP_MAX_FILES])){
+            send_ctrl_error_msg(LTE_FDD_ENB_ERROR_NONE, boost::lexical_cast<std::string>(pcap->get_max_files()));
+        }else if(std::string::npos != msg.find(lte_fdd_enb_param_text[LTE_FDD_ENB_PARAM_PCAP_RING_SECS])){
+            send_ctrl_error_msg(LTE_FDD_ENB_ERROR_NONE, boost::lexical_cast<std::string>(pcap->get_ring_secs()));
+        }else if(std::string::npos != msg.find(lte_fdd_enb_param_text[LTE_FDD_ENB_PARAM_PCAP_STATS])){
+            send_ctrl_error_msg(LTE_FDD_ENB_ERROR_NONE, pcap->get_stats());
         }else{
             // Handle all radio parameters
             if(std::string::npos != msg.find(lte_fdd_enb_param_text[LTE_FDD_ENB_PARAM_AVAILABLE_RADIOS]))
@@ -789,6 +664,14 @@ void LTE_fdd_enb_interface::handle_read(std::string msg)
                 send_ctrl_error_msg(LTE_FDD_ENB_ERROR_NONE, boost::lexical_cast<std::string>(radio->get_tx_gain()));
             }else if(std::string::npos != msg.find(lte_fdd_enb_param_text[LTE_FDD_ENB_PARAM_RX_GAIN])){
                 send_ctrl_error_msg(LTE_FDD_ENB_ERROR_NONE, boost::lexical_cast<std::string>(radio->get_rx_gain()));
+            }else if(std::string::npos != msg.find(lte_fdd_enb_param_text[LTE_FDD_ENB_PARAM_NO_RF_SPEEDUP])){
+                send_ctrl_error_msg(LTE_FDD_ENB_ERROR_NONE, boost::lexical_cast<std::string>(radio->get_no_rf_speedup()));
+            }else if(std::string::npos != msg.find(lte_fdd_enb_param_text[LTE_FDD_ENB_PARAM_NO_RF_UL_FILE])){
+                send_ctrl_error_msg(LTE_FDD_ENB_ERROR_NONE, radio->get_no_rf_ul_file());
+            }else if(std::string::npos != msg.find(lte_fdd_enb_param_text[LTE_FDD_ENB_PARAM_NO_RF_PRACH_PERIOD])){
+                send_ctrl_error_msg(LTE_FDD_ENB_ERROR_NONE, boost::lexical_cast<std::string>(radio->get_no_rf_prach_period()));
+            }else if(std::string::npos != msg.find(lte_fdd_enb_param_text[LTE_FDD_ENB_PARAM_NO_RF_STATS])){
+                send_ctrl_error_msg(LTE_FDD_ENB_ERROR_NONE, radio->get_no_rf_stats());
             }else{
                 send_ctrl_error_msg(LTE_FDD_ENB_ERROR_INVALID_PARAM, "");
             }
@@ -865,6 +748,28 @@ void LTE_fdd_enb_interface::handle_write(std::string msg)
             }else{
                 send_ctrl_error_msg(err, "");
             }
+        }else if(std::string::npos != msg.find(lte_fdd_enb_param_text[LTE_FDD_ENB_PARAM_DEBUG_FILE])){
+            send_ctrl_error_msg(set_debug_file(msg.substr(msg.find(" ")+1, std::string::npos)), "");
+        }else if(std::string::npos != msg.find(lte_fdd_enb_param_text[LTE_FDD_ENB_PARAM_PCAP_FILE])){
+            send_ctrl_error_msg(pcap->set_file(msg.substr(msg.find(" ")+1, std::string::npos)), "");
+        }else if(std::string::npos != msg.find(lte_fdd_enb_param_text[LTE_FDD_ENB_PARAM_PCAP_FORMAT])){
+            send_ctrl_error_msg(pcap->set_format(msg.substr(msg.find(" ")+1, std::string::npos)), "");
+        }else if(std::string::npos != msg.find(lte_fdd_enb_param_text[LTE_FDD_ENB_PARAM_PCAP_MAX_FILE_SIZE])){
+            u_value = boost::lexical_cast<uint32>(msg.substr(msg.find(" ")+1, std::string::npos));
+            pcap->set_max_file_size(u_value);
+            send_ctrl_error_msg(LTE_FDD_ENB_ERROR_NONE, "");
+        }else if(std::string::npos != msg.find(lte_fdd_enb_param_text[LTE_FDD_ENB_PARAM_PCAP_MAX_FILE_SECS])){
+            u_value = boost::lexical_cast<uint32>(msg.substr(msg.find(" ")+1, std::string::npos));
+            pcap->set_max_file_secs(u_value);
+            send_ctrl_error_msg(LTE_FDD_ENB_ERROR_NONE, "");
+        }else if(std::string::npos != msg.find(lte_fdd_enb_param_text[LTE_FDD_ENB_PARAM_PCAP_MAX_FILES])){
+            u_value = boost::lexical_cast<uint32>(msg.substr(msg.find(" ")+1, std::string::npos));
+            pcap->set_max_files(u_value);
+            send_ctrl_error_msg(LTE_FDD_ENB_ERROR_NONE, "");
+        }else if(std::string::npos != msg.find(lte_fdd_enb_param_text[LTE_FDD_ENB_PARAM_PCAP_RING_SECS])){
+            u_value = boost::lexical_cast<uint32>(msg.substr(msg.find(" ")+1, std::string::npos));
+            pcap->set_ring_secs(u_value);
+            send_ctrl_error_msg(LTE_FDD_ENB_ERROR_NONE, "");
         }else{
             // Handle all radio parameters
             if(std::string::npos != msg.find(lte_fdd_enb_param_text[LTE_FDD_ENB_PARAM_SELECTED_RADIO_IDX]))
@@ -877,6 +782,14 @@ void LTE_fdd_enb_interface::handle_write(std::string msg)
             }else if(std::string::npos != msg.find(lte_fdd_enb_param_text[LTE_FDD_ENB_PARAM_RX_GAIN])){
                 u_value = boost::lexical_cast<uint32>(msg.substr(msg.find(" ")+1, std::string::npos));
                 send_ctrl_error_msg(radio->set_rx_gain(u_value), "");
+            }else if(std::string::npos != msg.find(lte_fdd_enb_param_text[LTE_FDD_ENB_PARAM_NO_RF_SPEEDUP])){
+                u_value = boost::lexical_cast<uint32>(msg.substr(msg.find(" ")+1, std::string::npos));
+                send_ctrl_error_msg(radio->set_no_rf_speedup(u_value), "");
+            }else if(std::string::npos != msg.find(lte_fdd_enb_param_text[LTE_FDD_ENB_PARAM_NO_RF_UL_FILE])){
+                send_ctrl_error_msg(radio->set_no_rf_ul_file(msg.substr(msg.find(" ")+1, std::string::npos)), "");
+            }else if(std::string::npos != msg.find(lte_fdd_enb_param_text[LTE_FDD_ENB_PARAM_NO_RF_PRACH_PERIOD])){
+                u_value = boost::lexical_cast<uint32>(msg.substr(msg.find(" ")+1, std::string::npos));
+                send_ctrl_error_msg(radio->set_no_rf_prach_period(u_value), "");
             }else{
                 send_ctrl_error_msg(LTE_FDD_ENB_ERROR_INVALID_PARAM, "");
             }
@@ -1096,6 +1009,71 @@ void LTE_fdd_enb_interface::handle_stop(void)
         send_ctrl_error_msg(LTE_FDD_ENB_ERROR_ALREADY_STOPPED, "");
     }
 }
+void LTE_fdd_enb_interface::handle_hss_cmd(std::string msg)
+{
+    LTE_fdd_enb_hss        *hss = LTE_fdd_enb_hss::get_instance();
+    std::string             arg;
+    std::string             imsi;
+    std::string             chunk;
+    LTE_FDD_ENB_ERROR_ENUM  err;
+    uint32                  cursor;
+    uint32                  N_users;
+
+    if(std::string::npos != msg.find(" "))
+    {
+        arg = msg.substr(msg.find(" ")+1, std::string::npos);
+        arg = arg.substr(0, arg.find_last_not_of(" \r\n")+1);
+    }
+
+    if(std::string::npos != msg.find("add_user"))
+    {
+        send_ctrl_error_msg(hss->add_user(arg), "");
+    }else if(std::string::npos != msg.find("del_user")){
+        send_ctrl_error_msg(hss->del_user(arg), "");
+    }else if(std::string::npos != msg.find("print_users")){
+        // Stream the users in chunks instead of building one huge string
+        send_ctrl_msg(boost::lexical_cast<std::string>(hss->get_n_users()));
+        cursor  = 0;
+        N_users = 0;
+        while(LTE_FDD_ENB_ERROR_NONE == hss->get_next_user(&cursor, &imsi))
+        {
+            chunk += imsi;
+            N_users++;
+            if(0 == (N_users % LTE_FDD_ENB_HSS_PRINT_CHUNK_SIZE))
+            {
+                send_ctrl_msg(chunk);
+                chunk.clear();
+            }else{
+                chunk += "\n";
+            }
+        }
+        if(0 != chunk.size())
+        {
+            send_ctrl_msg(chunk.substr(0, chunk.size()-1));
+        }
+        send_ctrl_error_msg(LTE_FDD_ENB_ERROR_NONE, "");
+    }else if(std::string::npos != msg.find("import_users")){
+        err = hss->import_users(arg, &N_users);
+        send_ctrl_error_msg(err, " " + boost::lexical_cast<std::string>(N_users));
+    }else if(std::string::npos != msg.find("save_users")){
+        send_ctrl_error_msg(hss->save_snapshot(arg), "");
+    }else{
+        send_ctrl_error_msg(hss->load_snapshot(arg), "");
+    }
+}
+void LTE_fdd_enb_interface::handle_pcap_dump(void)
+{
+    LTE_FDD_ENB_ERROR_ENUM err;
+    std::string            file_name;
+
+    err = pcap->dump_ring(&file_name);
+    if(LTE_FDD_ENB_ERROR_NONE == err)
+    {
+        send_ctrl_error_msg(err, file_name);
+    }else{
+        send_ctrl_error_msg(err, "");
+    }
+}
 void LTE_fdd_enb_interface::handle_help(void)
 {
     LTE_fdd_enb_cnfg_db                                     *cnfg_db = LTE_fdd_enb_cnfg_db::get_instance();
@@ -1119,8 +1097,84 @@ void LTE_fdd_enb_interface::handle_help(void)
     send_ctrl_msg("\t\tstop         - Stops the eNB");
     send_ctrl_msg("\t\tshutdown     - Stops the eNB and exits");
     send_ctrl_msg("\t\tconstruct_si - Constructs the new system information");
+    send_ctrl_msg("\t\tpcap_dump    - Writes the pcap_ring_secs capture window to a file");
+    send_ctrl_msg("\t\tadd_user <imsi>     - Adds a subscriber to the HSS");
+    send_ctrl_msg("\t\tdel_user <imsi>     - Deletes a subscriber from the HSS");
+    send_ctrl_msg("\t\tprint_users         - Prints all HSS subscribers");
+    send_ctrl_msg("\t\timport_users <file> - Adds every IMSI, one per line, from a file to the HSS");
+    send_ctrl_msg("\t\tsave_users <file>   - Saves an HSS snapshot to a file");
+    send_ctrl_msg("\t\tload_users <file>   - Replaces all HSS subscribers with a snapshot");
     send_ctrl_msg("\t\thelp         - Prints this screen");
 
+    // Debug Parameters
+    send_ctrl_msg("\tDebug Parameters:");
+    tmp_str  = "\t\t";
+    tmp_str += lte_fdd_enb_param_text[LTE_FDD_ENB_PARAM_DEBUG_FILE];
+    tmp_str += " (none disables) = ";
+    tmp_str += get_debug_file();
+    send_ctrl_msg(tmp_str);
+    tmp_str  = "\t\t";
+    tmp_str += lte_fdd_enb_param_text[LTE_FDD_ENB_PARAM_DEBUG_STATS];
+    tmp_str += ": (read-only)";
+    send_ctrl_msg(tmp_str);
+
+    // PCAP Parameters
+    send_ctrl_msg("\tPCAP Parameters (enabled with enable_pcap):");
+    tmp_str  = "\t\t";
+    tmp_str += lte_fdd_enb_param_text[LTE_FDD_ENB_PARAM_PCAP_FILE];
+    tmp_str += " = ";
+    tmp_str += pcap->get_file();
+    send_ctrl_msg(tmp_str);
+    tmp_str  = "\t\t";
+    tmp_str += lte_fdd_enb_param_text[LTE_FDD_ENB_PARAM_PCAP_FORMAT];
+    tmp_str += " (pcap or pcapng) = ";
+    tmp_str += LTE_fdd_enb_pcap_format_text[pcap->get_format()];
+    send_ctrl_msg(tmp_str);
+    tmp_str  = "\t\t";
+    tmp_str += lte_fdd_enb_param_text[LTE_FDD_ENB_PARAM_PCAP_MAX_FILE_SIZE];
+    tmp_str += " (MB, 0 disables) = ";
+    try
+    {
+        tmp_str += boost::lexical_cast<std::string>(pcap->get_max_file_size());
+    }catch(...){
+        // Intentionally do nothing
+    }
+    send_ctrl_msg(tmp_str);
+    tmp_str  = "\t\t";
+    tmp_str += lte_fdd_enb_param_text[LTE_FDD_ENB_PARAM_PCAP_MAX_FILE_SECS];
+    tmp_str += " (0 disables) = ";
+    try
+    {
+        tmp_str += boost::lexical_cast<std::string>(pcap->get_max_file_secs());
+    }catch(...){
+        // Intentionally do nothing
+    }
+    send_ctrl_msg(tmp_str);
+    tmp_str  = "\t\t";
+    tmp_str += lte_fdd_enb_param_text[LTE_FDD_ENB_PARAM_PCAP_MAX_FILES];
+    tmp_str += " (0 keeps all) = ";
+    try
+    {
+        tmp_str += boost::lexical_cast<std::string>(pcap->get_max_files());
+    }catch(...){
+        // Intentionally do nothing
+    }
+    send_ctrl_msg(tmp_str);
+    tmp_str  = "\t\t";
+    tmp_str += lte_fdd_enb_param_text[LTE_FDD_ENB_PARAM_PCAP_RING_SECS];
+    tmp_str += " (0 writes files) = ";
+    try
+    {
+        tmp_str += boost::lexical_cast<std::string>(pcap->get_ring_secs());
+    }catch(...){
+        // Intentionally do nothing
+    }
+    send_ctrl_msg(tmp_str);
+    tmp_str  = "\t\t";
+    tmp_str += lte_fdd_enb_param_text[LTE_FDD_ENB_PARAM_PCAP_STATS];
+    tmp_str += ": (read-only)";
+    send_ctrl_msg(tmp_str);
+
     // Radio Parameters
     send_ctrl_msg("\tRadio Parameters:");
     tmp_str  = "\t\t";
@@ -1175,6 +1229,35 @@ void LTE_fdd_enb_interface::handle_help(void)
         // Intentionally do nothing
     }
     send_ctrl_msg(tmp_str);
+    tmp_str  = "\t\t";
+    tmp_str += lte_fdd_enb_param_text[LTE_FDD_ENB_PARAM_NO_RF_SPEEDUP];
+    tmp_str += " (0 runs unpaced) = ";
+    try
+    {
+        tmp_str += boost::lexical_cast<std::string>(radio->get_no_rf_speedup());
+    }catch(...){
+        // Intentionally do nothing
+    }
+    send_ctrl_msg(tmp_str);
+    tmp_str  = "\t\t";
+    tmp_str += lte_fdd_enb_param_text[LTE_FDD_ENB_PARAM_NO_RF_UL_FILE];
+    tmp_str += " = ";
+    tmp_str += radio->get_no_rf_ul_file();
+    send_ctrl_msg(tmp_str);
+    tmp_str  = "\t\t";
+    tmp_str += lte_fdd_enb_param_text[LTE_FDD_ENB_PARAM_NO_RF_PRACH_PERIOD];
+    tmp_str += " (0 disables) = ";
+    try
+    {
+        tmp_str += boost::lexical_cast<std::string>(radio->get_no_rf_prach_period());
+    }catch(...){
+        // Intentionally do nothing
+    }
+    send_ctrl_msg(tmp_str);
+    tmp_str  = "\t\t";
+    tmp_str += lte_fdd_enb_param_text[LTE_FDD_ENB_PARAM_NO_RF_STATS];
+    tmp_str += ": (read-only)";
+    send_ctrl_msg(tmp_str);
 
     // System Parameters
     send_ctrl_msg("\tSystem Parameters:");
@@ -1250,6 +1333,600 @@ bool LTE_fdd_enb_interface::app_is_started(void)
     boost::mutex::scoped_lock lock(start_mutex);
     return(started);
 }
+std::string LTE_fdd_enb_interface::get_debug_file(void)
+{
+    boost::mutex::scoped_lock lock(debug_file_mutex);
+    return(debug_file_name);
+}
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_interface::set_debug_file(std::string file_name)
+{
+    boost::mutex::scoped_lock  lock(debug_file_mutex);
+    LTE_FDD_ENB_ERROR_ENUM     err      = LTE_FDD_ENB_ERROR_NONE;
+    FILE                      *new_file = NULL;
+
+    if(file_name != "none")
+    {
+        new_file = fopen(file_name.c_str(), "a");
+        if(NULL == new_file)
+        {
+            err = LTE_FDD_ENB_ERROR_CANT_OPEN_FILE;
+        }
+    }
+
+    if(LTE_FDD_ENB_ERROR_NONE == err)
+    {
+        if(NULL != debug_file)
+        {
+            fclose(debug_file);
+        }
+        debug_file      = new_file;
+        debug_file_name = file_name;
+    }
+
+    return(err);
+}
+std::string LTE_fdd_enb_interface::get_debug_stats(void)
+{
+    boost::mutex::scoped_lock lock(debug_ring_mutex);
+    char                      stats[256];
+    uint32                    N_dropped = N_debug_unregistered_dropped;
+    uint32                    i;
+
+    for(i=0; i<N_debug_rings; i++)
+    {
+        N_dropped += debug_rings[i]->N_dropped;
+    }
+
+    snprintf(stats,
+             sizeof(stats),
+             "rings=%u records=%llu dropped=%u",
+             N_debug_rings,
+             N_debug_records,
+             N_dropped);
+
+    return(stats);
+}
+
+/*************************/
+/*    Processing time    */
+/*************************/
+void LTE_fdd_enb_interface::reset_proc_time(LTE_FDD_ENB_PROC_TIME_STRUCT *proc_time)
+{
+    proc_time->N_runs   = 0;
+    proc_time->total_ns = 0;
+    proc_time->max_ns   = 0;
+}
+void LTE_fdd_enb_interface::update_proc_time(LTE_FDD_ENB_PROC_TIME_STRUCT *proc_time,
+                                             struct timespec              *start_time)
+{
+    struct timespec end_time;
+    uint64          ns;
+
+    clock_gettime(CLOCK_MONOTONIC, &end_time);
+    ns  = (uint64)(end_time.tv_sec - start_time->tv_sec)*1000000000;
+    ns += end_time.tv_nsec;
+    ns -= start_time->tv_nsec;
+
+    proc_time->N_runs++;
+    proc_time->total_ns += ns;
+    if(ns > proc_time->max_ns)
+    {
+        proc_time->max_ns = ns;
+    }
+}
+
+/*********************/
+/*    Debug rings    */
+/*********************/
+void* LTE_fdd_enb_interface::debug_thread_func(void *inputs)
+{
+    LTE_fdd_enb_interface *interface = (LTE_fdd_enb_interface *)inputs;
+
+    // Let the counter run before the first records are formatted so the
+    // first calibration is usable, records queue in the rings meanwhile
+    usleep(LTE_FDD_ENB_DEBUG_TSC_CAL_US);
+
+    while(!interface->debug_thread_stop)
+    {
+        if(!interface->debug_drain_rings())
+        {
+            usleep(LTE_FDD_ENB_DEBUG_IDLE_SLEEP_US);
+        }
+    }
+
+    // Flush anything queued while stopping
+    interface->debug_drain_rings();
+
+    return(NULL);
+}
+void LTE_fdd_enb_interface::debug_ring_release(void *ring)
+{
+    LTE_FDD_ENB_DEBUG_RING_STRUCT *act_ring = (LTE_FDD_ENB_DEBUG_RING_STRUCT *)ring;
+
+    // The formatter keeps draining the ring, a new thread can reuse it once empty
+    __sync_synchronize();
+    act_ring->released = 1;
+}
+uint64 LTE_fdd_enb_interface::debug_get_tsc(void)
+{
+    uint64 tsc;
+
+    // Raw cycle counter where there is one, converted to wall time by the
+    // formatter
+#if defined(__x86_64__) || defined(__i386__)
+    tsc = __rdtsc();
+#else
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    tsc = (uint64)ts.tv_sec*1000000000 + ts.tv_nsec;
+#endif
+
+    return(tsc);
+}
+void LTE_fdd_enb_interface::debug_store_args(LTE_FDD_ENB_DEBUG_RECORD_STRUCT *record,
+                                             const char                      *fmt,
+                                             va_list                          args)
+{
+    const char *str;
+    uint32      N_long  = 0;
+    bool        in_spec = false;
+
+    // Only walk the conversions to pull the arguments, no formatting is done
+    // here
+    record->N_args = 0;
+    record->N_str  = 0;
+    while('\0'                       != *fmt &&
+          LTE_FDD_ENB_DEBUG_MAX_ARGS >  record->N_args)
+    {
+        if(!in_spec)
+        {
+            if('%' == *fmt)
+            {
+                in_spec = true;
+                N_long  = 0;
+            }
+        }else{
+            switch(*fmt)
+            {
+            case '%':
+                in_spec = false;
+                break;
+            case '*':
+                record->arg[record->N_args++].int_val = (int64)va_arg(args, int);
+                break;
+            case 'l':
+                N_long++;
+                break;
+            case 'z':
+            case 'j':
+            case 't':
+                N_long = 1;
+                break;
+            case 'd':
+            case 'i':
+            case 'c':
+                if(2 <= N_long)
+                {
+                    record->arg[record->N_args++].int_val = (int64)va_arg(args, long long);
+                }else if(1 == N_long){
+                    record->arg[record->N_args++].int_val = (int64)va_arg(args, long);
+                }else{
+                    record->arg[record->N_args++].int_val = (int64)va_arg(args, int);
+                }
+                in_spec = false;
+                break;
+            case 'u':
+            case 'x':
+            case 'X':
+            case 'o':
+                if(2 <= N_long)
+                {
+                    record->arg[record->N_args++].int_val = (uint64)va_arg(args, unsigned long long);
+                }else if(1 == N_long){
+                    record->arg[record->N_args++].int_val = (uint64)va_arg(args, unsigned long);
+                }else{
+                    record->arg[record->N_args++].int_val = (uint64)va_arg(args, unsigned int);
+                }
+                in_spec = false;
+                break;
+            case 'f':
+            case 'F':
+            case 'e':
+            case 'E':
+            case 'g':
+            case 'G':
+                record->arg[record->N_args++].double_val = va_arg(args, double);
+                in_spec                                  = false;
+                break;
+            case 'p':
+                record->arg[record->N_args++].int_val = (uint64)(size_t)va_arg(args, void *);
+                in_spec                               = false;
+                break;
+            case 's':
+                str = va_arg(args, const char *);
+                if(NULL == str)
+                {
+                    str = "(null)";
+                }
+                if(LTE_FDD_ENB_DEBUG_MAX_STR_SIZE > record->N_str)
+                {
+                    record->arg[record->N_args++].int_val = record->N_str;
+                    while('\0'                             != *str &&
+                          (LTE_FDD_ENB_DEBUG_MAX_STR_SIZE-1) >  record->N_str)
+                    {
+                        record->str[record->N_str++] = *str++;
+                    }
+                    record->str[record->N_str++] = '\0';
+                }else{
+                    // Out of room, point at the last terminator
+                    record->arg[record->N_args++].int_val = LTE_FDD_ENB_DEBUG_MAX_STR_SIZE-1;
+                }
+                in_spec = false;
+                break;
+            default:
+                break;
+            }
+        }
+        fmt++;
+    }
+}
+bool LTE_fdd_enb_interface::debug_is_enabled(LTE_FDD_ENB_DEBUG_TYPE_ENUM  type,
+                                             LTE_FDD_ENB_DEBUG_LEVEL_ENUM level)
+{
+    bool enabled = false;
+
+    if((debug_connected || NULL != debug_file) &&
+       (debug_type_mask & (1 << type))         &&
+       (debug_level_mask & (1 << level)))
+    {
+        enabled = true;
+    }
+
+    return(enabled);
+}
+LTE_FDD_ENB_DEBUG_RECORD_STRUCT* LTE_fdd_enb_interface::debug_start_record(LTE_FDD_ENB_DEBUG_TYPE_ENUM   type,
+                                                                           LTE_FDD_ENB_DEBUG_LEVEL_ENUM  level,
+                                                                           const char                   *file_name,
+                                                                           int32                         line,
+                                                                           const char                   *msg,
+                                                                           va_list                       args)
+{
+    LTE_FDD_ENB_DEBUG_RING_STRUCT   *ring   = debug_get_ring();
+    LTE_FDD_ENB_DEBUG_RECORD_STRUCT *record = NULL;
+
+    if(NULL != ring)
+    {
+        // Drop instead of blocking when the formatter falls behind
+        if(LTE_FDD_ENB_DEBUG_RING_SIZE > (ring->write_idx - ring->read_idx))
+        {
+            record = &ring->record[ring->write_idx & (LTE_FDD_ENB_DEBUG_RING_SIZE-1)];
+            record->tsc           = debug_get_tsc();
+            record->file_name     = file_name;
+            record->fmt           = msg;
+            record->line          = line;
+            record->type          = type;
+            record->level         = level;
+            record->N_hex         = 0;
+            record->N_hex_bytes   = 0;
+            record->hex_present   = false;
+            record->hex_truncated = false;
+            debug_store_args(record, msg, args);
+        }else{
+            ring->N_dropped++;
+        }
+    }else{
+        __sync_fetch_and_add(&N_debug_unregistered_dropped, 1);
+    }
+
+    return(record);
+}
+void LTE_fdd_enb_interface::debug_commit_record(LTE_FDD_ENB_DEBUG_RECORD_STRUCT *record)
+{
+    if(NULL != record)
+    {
+        // Publish the record before the write index
+        __sync_synchronize();
+        debug_ring->write_idx++;
+    }
+}
+LTE_FDD_ENB_DEBUG_RING_STRUCT* LTE_fdd_enb_interface::debug_get_ring(void)
+{
+    uint32 i;
+
+    if(NULL == debug_ring)
+    {
+        boost::mutex::scoped_lock lock(debug_ring_mutex);
+
+        // Reuse a drained ring from an exited thread before allocating a new one
+        for(i=0; i<N_debug_rings && NULL == debug_ring; i++)
+        {
+            if(debug_rings[i]->released &&
+               debug_rings[i]->read_idx == debug_rings[i]->write_idx)
+            {
+                debug_rings[i]->released = 0;
+                debug_ring               = debug_rings[i];
+            }
+        }
+        if(NULL == debug_ring &&
+           LTE_FDD_ENB_DEBUG_MAX_RINGS > N_debug_rings)
+        {
+            debug_ring                     = new LTE_FDD_ENB_DEBUG_RING_STRUCT;
+            debug_ring->write_idx          = 0;
+            debug_ring->read_idx           = 0;
+            debug_ring->N_dropped          = 0;
+            debug_ring->released           = 0;
+            debug_ring->N_dropped_reported = 0;
+            debug_rings[N_debug_rings]     = debug_ring;
+            __sync_synchronize();
+            N_debug_rings++;
+        }
+        if(NULL != debug_ring)
+        {
+            pthread_setspecific(debug_ring_key, debug_ring);
+        }
+    }
+
+    return(debug_ring);
+}
+bool LTE_fdd_enb_interface::debug_drain_rings(void)
+{
+    LTE_FDD_ENB_DEBUG_RING_STRUCT   *ring;
+    LTE_FDD_ENB_DEBUG_RECORD_STRUCT  drop_record;
+    uint32                           N_rings = N_debug_rings;
+    uint32                           write_idx;
+    uint32                           N_dropped;
+    uint32                           i;
+    bool                             drained = false;
+
+    debug_calibrate_tsc();
+    __sync_synchronize();
+    for(i=0; i<N_rings; i++)
+    {
+        ring      = debug_rings[i];
+        write_idx = ring->write_idx;
+        __sync_synchronize();
+        while(ring->read_idx != write_idx)
+        {
+            debug_format_record(&ring->record[ring->read_idx & (LTE_FDD_ENB_DEBUG_RING_SIZE-1)]);
+            __sync_synchronize();
+            ring->read_idx++;
+            drained = true;
+        }
+
+        // Report drops in line so gaps in the log are visible
+        N_dropped = ring->N_dropped;
+        if(N_dropped != ring->N_dropped_reported)
+        {
+            drop_record.tsc            = debug_get_tsc();
+            drop_record.file_name      = __FILE__;
+            drop_record.fmt            = "Dropped %u debug messages";
+            drop_record.line           = __LINE__;
+            drop_record.type           = LTE_FDD_ENB_DEBUG_TYPE_WARNING;
+            drop_record.level          = LTE_FDD_ENB_DEBUG_LEVEL_IFACE;
+            drop_record.N_args         = 1;
+            drop_record.N_str          = 0;
+            drop_record.hex_present    = false;
+            drop_record.arg[0].int_val = N_dropped - ring->N_dropped_reported;
+            debug_format_record(&drop_record);
+            ring->N_dropped_reported = N_dropped;
+            drained                  = true;
+        }
+    }
+    debug_flush_batch();
+
+    return(drained);
+}
+void LTE_fdd_enb_interface::debug_calibrate_tsc(void)
+{
+    struct timeval now;
+    uint64         tsc = debug_get_tsc();
+    int64          elapsed_us;
+
+    // Refine the counter rate over the whole run so far
+    gettimeofday(&now, NULL);
+    elapsed_us  = (int64)(now.tv_sec - debug_time_base.tv_sec)*1000000;
+    elapsed_us += now.tv_usec - debug_time_base.tv_usec;
+    if(0 < elapsed_us)
+    {
+        debug_tsc_per_us = (double)(tsc - debug_tsc_base) / elapsed_us;
+    }
+}
+void LTE_fdd_enb_interface::debug_format_record(LTE_FDD_ENB_DEBUG_RECORD_STRUCT *record)
+{
+    struct timeval time;
+    char           prefix[256];
+    uint64         us;
+    uint32         i;
+    uint32         hex_val;
+
+    us  = (uint64)debug_time_base.tv_sec*1000000 + debug_time_base.tv_usec;
+    us += (uint64)((record->tsc - debug_tsc_base) / debug_tsc_per_us);
+    time.tv_sec  = us / 1000000;
+    time.tv_usec = us % 1000000;
+
+    snprintf(prefix,
+             sizeof(prefix),
+             "%ld.%06ld %s %s %s %d ",
+             (long)time.tv_sec,
+             (long)time.tv_usec,
+             LTE_fdd_enb_debug_type_text[record->type],
+             LTE_fdd_enb_debug_level_text[record->level],
+             record->file_name,
+             record->line);
+    debug_batch += prefix;
+    debug_format_msg(record);
+    if(record->hex_present)
+    {
+        debug_batch += " ";
+        for(i=0; i<record->N_hex; i++)
+        {
+            hex_val = (record->hex[i/2] >> (((i % 2) == 0) ? 4 : 0)) & 0xF;
+            if(hex_val < 0xA)
+            {
+                debug_batch += (char)(hex_val + '0');
+            }else{
+                debug_batch += (char)((hex_val-0xA) + 'A');
+            }
+        }
+        if(record->hex_truncated)
+        {
+            snprintf(prefix,
+                     sizeof(prefix),
+                     "... (truncated, %u bytes total)",
+                     record->N_hex_bytes);
+            debug_batch += prefix;
+        }
+    }
+    debug_batch += "\n";
+    N_debug_records++;
+
+    if(LTE_FDD_ENB_DEBUG_BATCH_SIZE <= debug_batch.size())
+    {
+        debug_flush_batch();
+    }
+}
+void LTE_fdd_enb_interface::debug_format_msg(LTE_FDD_ENB_DEBUG_RECORD_STRUCT *record)
+{
+    LTE_FDD_ENB_DEBUG_ARG_UNION *arg;
+    const char                  *fmt     = record->fmt;
+    char                         spec[LTE_FDD_ENB_DEBUG_MAX_SPEC_SIZE];
+    char                         out[LTE_FDD_ENB_DEBUG_MAX_MSG_SIZE];
+    uint32                       N_spec  = 0;
+    uint32                       N_long  = 0;
+    uint32                       arg_idx = 0;
+    bool                         in_spec = false;
+
+    // Walk the format the same way debug_store_args did, formatting one
+    // conversion at a time with its stored argument
+    out[0] = '\0';
+    while('\0' != *fmt)
+    {
+        if(!in_spec)
+        {
+            if('%' == *fmt)
+            {
+                spec[0] = '%';
+                N_spec  = 1;
+                N_long  = 0;
+                in_spec = true;
+            }else{
+                debug_batch += *fmt;
+            }
+        }else if(arg_idx >= record->N_args && '%' != *fmt){
+            // More conversions than stored arguments, print the rest raw
+            spec[N_spec] = '\0';
+            debug_batch += spec;
+            debug_batch += fmt;
+            break;
+        }else{
+            arg = &record->arg[arg_idx];
+            switch(*fmt)
+            {
+            case '%':
+                debug_batch += '%';
+                in_spec      = false;
+                break;
+            case '*':
+                // Leave room for the widest int and the conversion
+                if((LTE_FDD_ENB_DEBUG_MAX_SPEC_SIZE - 16) > N_spec)
+                {
+                    N_spec += snprintf(&spec[N_spec], 16, "%d", (int)arg->int_val);
+                }
+                arg_idx++;
+                break;
+            case 'd':
+            case 'i':
+            case 'c':
+            case 'u':
+            case 'x':
+            case 'X':
+            case 'o':
+                spec[N_spec++] = *fmt;
+                spec[N_spec]   = '\0';
+                if(2 <= N_long)
+                {
+                    snprintf(out, sizeof(out), spec, (long long)arg->int_val);
+                }else if(1 == N_long){
+                    snprintf(out, sizeof(out), spec, (long)arg->int_val);
+                }else{
+                    snprintf(out, sizeof(out), spec, (int)arg->int_val);
+                }
+                arg_idx++;
+                in_spec = false;
+                break;
+            case 'f':
+            case 'F':
+            case 'e':
+            case 'E':
+            case 'g':
+            case 'G':
+                spec[N_spec++] = *fmt;
+                spec[N_spec]   = '\0';
+                snprintf(out, sizeof(out), spec, arg->double_val);
+                arg_idx++;
+                in_spec = false;
+                break;
+            case 'p':
+                spec[N_spec++] = *fmt;
+                spec[N_spec]   = '\0';
+                snprintf(out, sizeof(out), spec, (void *)(size_t)arg->int_val);
+                arg_idx++;
+                in_spec = false;
+                break;
+            case 's':
+                spec[N_spec++] = *fmt;
+                spec[N_spec]   = '\0';
+                snprintf(out, sizeof(out), spec, &record->str[arg->int_val]);
+                arg_idx++;
+                in_spec = false;
+                break;
+            default:
+                if('l' == *fmt)
+                {
+                    N_long++;
+                }else if('z' == *fmt || 'j' == *fmt || 't' == *fmt){
+                    N_long = 1;
+                }
+                if((LTE_FDD_ENB_DEBUG_MAX_SPEC_SIZE - 16) > N_spec)
+                {
+                    spec[N_spec++] = *fmt;
+                }
+                break;
+            }
+            if(!in_spec)
+            {
+                debug_batch += out;
+                out[0]       = '\0';
+            }
+        }
+        fmt++;
+    }
+}
+void LTE_fdd_enb_interface::debug_flush_batch(void)
+{
+    boost::mutex::scoped_lock d_lock(debug_mutex);
+    boost::mutex::scoped_lock f_lock(debug_file_mutex);
+
+    if(0 != debug_batch.size())
+    {
+        debug_connect_mutex.lock();
+        if(debug_connected &&
+           NULL != debug_socket)
+        {
+            debug_socket->send(debug_batch);
+        }
+        debug_connect_mutex.unlock();
+
+        if(NULL != debug_file)
+        {
+            fwrite(debug_batch.c_str(), sizeof(char), debug_batch.size(), debug_file);
+            fflush(debug_file);
+        }
+
+        debug_batch.clear();
+    }
+}
 
 /*****************/
 /*    Helpers    */
@@ -36,6 +36,19 @@
                                    DL CCCH message processing.
     06/15/2014    Ben Wojtowicz    Added uplink scheduling and changed fn_combo
                                    to current_tti.
+    10/19/2026    agent            Added scheduler processing time statistics.
+    10/19/2026    agent            Replaced the scheduling queues with TTI
+                                   indexed calendars of preallocated entries,
+                                   deferring or expiring entries that miss
+                                   their subframe.
+    10/19/2026    agent            Added round robin, max C/I, and proportional
+                                   fair DL scheduling policies with PRB bitmap
+                                   allocation and a PDCCH DCI budget.
+    10/19/2026    agent            Added BSR handling and BSR driven UL grants
+                                   packed across users, replacing the per RB
+                                   UL scheduling timers.
+    10/19/2026    agent            Only copying the system information when
+                                   its version changes.
 
 *******************************************************************************/
 
@@ -99,12 +112,30 @@ void LTE_fdd_enb_mac::cleanup(void)
 /********************************/
 LTE_fdd_enb_mac::LTE_fdd_enb_mac()
 {
-    interface = NULL;
-    started   = false;
+    uint32 i;
+
+    interface        = NULL;
+    started          = false;
+    sys_info_version = 0;
+    LTE_fdd_enb_interface::reset_proc_time(&sched_proc_time);
+
+    // One instance of every policy, the scheduler picks one per TTI so the
+    // policy can change without freeing one that is in use
+    for(i=0; i<LTE_FDD_ENB_DL_SCHED_POLICY_N_ITEMS; i++)
+    {
+        dl_sched_policy[i] = LTE_fdd_enb_dl_sched_policy::create((LTE_FDD_ENB_DL_SCHED_POLICY_ENUM)i);
+    }
 }
 LTE_fdd_enb_mac::~LTE_fdd_enb_mac()
 {
+    uint32 i;
+
     stop();
+
+    for(i=0; i<LTE_FDD_ENB_DL_SCHED_POLICY_N_ITEMS; i++)
+    {
+        delete dl_sched_policy[i];
+    }
 }
 
 /********************/
@@ -133,7 +164,7 @@ void LTE_fdd_enb_mac::start(LTE_fdd_enb_interface *iface)
                                                                "mac_rlc_mq");
 
         // Scheduler
-        cnfg_db->get_sys_info(sys_info);
+        sys_info_version = cnfg_db->get_sys_info(sys_info);
         for(i=0; i<10; i++)
         {
             sched_dl_subfr[i].dl_allocations.N_alloc = 0;
@@ -153,6 +184,13 @@ void LTE_fdd_enb_mac::start(LTE_fdd_enb_interface *iface)
         sched_dl_subfr[2].current_tti = 12;
         sched_cur_dl_subfn            = 3;
         sched_cur_ul_subfn            = 0;
+        sched_cal_publish_tti();
+        LTE_fdd_enb_interface::reset_proc_time(&sched_proc_time);
+
+        // Scheduling calendars
+        sched_cal_init(&rar_sched_queue, LTE_FDD_ENB_MAC_SCHED_N_RAR_ENTRIES);
+        sched_cal_init(&dl_sched_queue, LTE_FDD_ENB_MAC_SCHED_N_DL_ENTRIES);
+        sched_cal_init(&ul_sched_queue, LTE_FDD_ENB_MAC_SCHED_N_UL_ENTRIES);
     }
 }
 void LTE_fdd_enb_mac::stop(void)
@@ -205,7 +243,7 @@ void LTE_fdd_enb_mac::handle_phy_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg)
         }
     }else{
         // Forward message to RLC
-        mac_rlc_mq->send(&msg, sizeof(msg), 0);
+        LTE_fdd_enb_msgq::forward(mac_rlc_mq, msg);
     }
 }
 void LTE_fdd_enb_mac::handle_rlc_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg)
@@ -231,7 +269,7 @@ void LTE_fdd_enb_mac::handle_rlc_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg)
         }
     }else{
         // Forward message to PHY
-        mac_phy_mq->send(&msg, sizeof(msg), 0);
+        LTE_fdd_enb_msgq::forward(mac_phy_mq, msg);
     }
 }
 
@@ -242,9 +280,16 @@ void LTE_fdd_enb_mac::update_sys_info(void)
 {
     LTE_fdd_enb_cnfg_db *cnfg_db = LTE_fdd_enb_cnfg_db::get_instance();
 
-    sys_info_mutex.lock();
-    cnfg_db->get_sys_info(sys_info);
-    sys_info_mutex.unlock();
+    if(sys_info_version != cnfg_db->get_sys_info_version())
+    {
+        sys_info_mutex.lock();
+        sys_info_version = cnfg_db->get_sys_info(sys_info);
+        sys_info_mutex.unlock();
+    }
+}
+LTE_FDD_ENB_PROC_TIME_STRUCT LTE_fdd_enb_mac::get_sched_proc_time(void)
+{
+    return(sched_proc_time);
 }
 void LTE_fdd_enb_mac::sched_ul(LTE_fdd_enb_user *user,
                                uint32            requested_tbs)
@@ -270,7 +315,7 @@ void LTE_fdd_enb_mac::sched_ul(LTE_fdd_enb_user *user,
     sys_info_mutex.unlock();
 
     // Add the allocation to the scheduling queue
-    if(LTE_FDD_ENB_ERROR_NONE != add_to_ul_sched_queue((sched_ul_subfr[sched_cur_ul_subfn].current_tti + 4) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1),
+    if(LTE_FDD_ENB_ERROR_NONE != add_to_ul_sched_queue((sched_cal_get_ul_tti() + 4) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1),
                                                        &alloc))
     {
         interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
@@ -285,9 +330,15 @@ void LTE_fdd_enb_mac::sched_ul(LTE_fdd_enb_user *user,
                                   __LINE__,
                                   "UL scheduled for RNTI=%u, UL_QUEUE_SIZE=%u",
                                   alloc.rnti,
-                                  ul_sched_queue.size());
+                                  ul_sched_queue.N_entries - ul_sched_queue.N_free);
     }
 }
+void LTE_fdd_enb_mac::add_ul_sched_user(uint16 rnti)
+{
+    boost::mutex::scoped_lock lock(ul_sched_users_mutex);
+
+    ul_sched_users.insert(rnti);
+}
 
 /**********************/
 /*    PHY Handlers    */
@@ -295,6 +346,9 @@ void LTE_fdd_enb_mac::sched_ul(LTE_fdd_enb_user *user,
 void LTE_fdd_enb_mac::handle_ready_to_send(LTE_FDD_ENB_READY_TO_SEND_MSG_STRUCT *rts)
 {
     LTE_fdd_enb_timer_mgr *timer_mgr = LTE_fdd_enb_timer_mgr::get_instance();
+    struct timespec        start_time;
+
+    clock_gettime(CLOCK_MONOTONIC, &start_time);
 
     // Send tick to timer manager
     // FIXME: Send this through msgq
@@ -321,6 +375,9 @@ void LTE_fdd_enb_mac::handle_ready_to_send(LTE_FDD_ENB_READY_TO_SEND_MSG_STRUCT
                                   sched_dl_subfr[sched_cur_dl_subfn].current_tti);
         while(rts->dl_current_tti != sched_dl_subfr[sched_cur_dl_subfn].current_tti)
         {
+            // Drop anything queued for the skipped subframe
+            expire_sched_queues(sched_dl_subfr[sched_cur_dl_subfn].current_tti);
+
             // Advance the frame number combination
             sched_dl_subfr[sched_cur_dl_subfn].current_tti = (sched_dl_subfr[sched_cur_dl_subfn].current_tti + 10) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1);
 
@@ -334,6 +391,7 @@ void LTE_fdd_enb_mac::handle_ready_to_send(LTE_FDD_ENB_READY_TO_SEND_MSG_STRUCT
 
             // Advance the subframe number
             sched_cur_dl_subfn = (sched_cur_dl_subfn + 1) % 10;
+            sched_cal_publish_tti();
         }
     }
     if(rts->ul_current_tti != sched_ul_subfr[sched_cur_ul_subfn].current_tti)
@@ -357,6 +415,7 @@ void LTE_fdd_enb_mac::handle_ready_to_send(LTE_FDD_ENB_READY_TO_SEND_MSG_STRUCT
 
             // Advance the subframe number
             sched_cur_ul_subfn = (sched_cur_ul_subfn + 1) % 10;
+            sched_cal_publish_tti();
         }
     }
 
@@ -389,8 +448,11 @@ void LTE_fdd_enb_mac::handle_ready_to_send(LTE_FDD_ENB_READY_TO_SEND_MSG_STRUCT
     // Advance the subframe numbers
     sched_cur_dl_subfn = (sched_cur_dl_subfn + 1) % 10;
     sched_cur_ul_subfn = (sched_cur_ul_subfn + 1) % 10;
+    sched_cal_publish_tti();
 
     scheduler();
+
+    LTE_fdd_enb_interface::update_proc_time(&sched_proc_time, &start_time);
 }
 void LTE_fdd_enb_mac::handle_prach_decode(LTE_FDD_ENB_PRACH_DECODE_MSG_STRUCT *prach_decode)
 {
@@ -435,6 +497,10 @@ void LTE_fdd_enb_mac::handle_pusch_decode(LTE_FDD_ENB_PUSCH_DECODE_MSG_STRUCT *p
                                  pusch_decode->msg.msg,
                                  pusch_decode->msg.N_bits);
 
+        // No CQI reports are decoded yet, so estimate the DL channel quality
+        // from the PUSCH SINR
+        user->set_dl_cqi(get_dl_cqi_estimate(pusch_decode->sinr_db));
+
         // Set the correct channel type
         user->pusch_mac_pdu.chan_type = LIBLTE_MAC_CHAN_TYPE_ULSCH;
 
@@ -481,10 +547,11 @@ void LTE_fdd_enb_mac::handle_pusch_decode(LTE_FDD_ENB_PUSCH_DECODE_MSG_STRUCT *p
 void LTE_fdd_enb_mac::handle_sdu_ready(LTE_FDD_ENB_MAC_SDU_READY_MSG_STRUCT *sdu_ready)
 {
     LTE_fdd_enb_user             *user;
-    LIBLTE_MAC_PDU_STRUCT         mac_pdu;
+    LIBLTE_MAC_PDU_STRUCT        *mac_pdu;
     LIBLTE_PHY_ALLOCATION_STRUCT  alloc;
     LIBLTE_BIT_MSG_STRUCT        *sdu;
     uint32                        current_tti;
+    uint32                        idx;
 
     if(LTE_FDD_ENB_ERROR_NONE == sdu_ready->rb->get_next_mac_sdu(&sdu))
     {
@@ -518,18 +585,23 @@ void LTE_fdd_enb_mac::handle_sdu_ready(LTE_FDD_ENB_MAC_SDU_READY_MSG_STRUCT *sdu
         alloc.tpc  = LIBLTE_PHY_TPC_COMMAND_DCI_1_1A_1B_1D_2_3_DB_ZERO;
         alloc.ndi  = false;
 
-        // Pack the SDU
-        mac_pdu.chan_type         = LIBLTE_MAC_CHAN_TYPE_DLSCH;
-        mac_pdu.N_subheaders      = 1;
-        mac_pdu.subheader[0].lcid = sdu_ready->rb->get_rb_id();
-        memcpy(&mac_pdu.subheader[0].payload.sdu, sdu, sizeof(LIBLTE_BIT_MSG_STRUCT));
+        // Pack the SDU straight into the scheduling queue
+        mac_pdu = get_dl_sched_mac_pdu(&idx);
+        if(NULL != mac_pdu)
+        {
+            mac_pdu->chan_type         = LIBLTE_MAC_CHAN_TYPE_DLSCH;
+            mac_pdu->N_subheaders      = 1;
+            mac_pdu->subheader[0].lcid = sdu_ready->rb->get_rb_id();
+            memcpy(&mac_pdu->subheader[0].payload.sdu, sdu, sizeof(LIBLTE_BIT_MSG_STRUCT));
+        }
 
         // Determine the current_tti
-        current_tti = (sched_dl_subfr[sched_cur_dl_subfn].current_tti + 4) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1);
+        current_tti = (sched_cal_get_dl_tti() + 4) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1);
 
         // Add the SDU to the scheduling queue
-        if(LTE_FDD_ENB_ERROR_NONE != add_to_dl_sched_queue(current_tti,
-                                                           &mac_pdu,
+        if(NULL                   == mac_pdu ||
+           LTE_FDD_ENB_ERROR_NONE != add_to_dl_sched_queue(current_tti,
+                                                           idx,
                                                            &alloc))
         {
             interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
@@ -545,7 +617,7 @@ void LTE_fdd_enb_mac::handle_sdu_ready(LTE_FDD_ENB_MAC_SDU_READY_MSG_STRUCT *sdu
                                       &alloc.msg,
                                       "SDU scheduled for RNTI=%u, DL_QUEUE_SIZE=%u",
                                       alloc.rnti,
-                                      dl_sched_queue.size());
+                                      dl_sched_queue.N_entries - dl_sched_queue.N_free);
         }
 
         // Delete the SDU
@@ -568,9 +640,10 @@ void LTE_fdd_enb_mac::handle_ulsch_ccch_sdu(LTE_fdd_enb_user      *user,
 {
     LTE_fdd_enb_rb                       *rb = NULL;
     LTE_FDD_ENB_RLC_PDU_READY_MSG_STRUCT  rlc_pdu_ready;
-    LIBLTE_MAC_PDU_STRUCT                 mac_pdu;
+    LIBLTE_MAC_PDU_STRUCT                *mac_pdu;
     LIBLTE_PHY_ALLOCATION_STRUCT          alloc;
     uint32                                current_tti;
+    uint32                                idx;
     uint32                                i;
 
     if(LIBLTE_MAC_ULSCH_CCCH_LCID == lcid)
@@ -606,23 +679,28 @@ void LTE_fdd_enb_mac::handle_ulsch_ccch_sdu(LTE_fdd_enb_user      *user,
         alloc.tpc  = LIBLTE_PHY_TPC_COMMAND_DCI_1_1A_1B_1D_2_3_DB_ZERO;
         alloc.ndi  = false;
 
-        // Pack the contention resolution PDU
-        mac_pdu.chan_type                             = LIBLTE_MAC_CHAN_TYPE_DLSCH;
-        mac_pdu.N_subheaders                          = 1;
-        mac_pdu.subheader[0].lcid                     = LIBLTE_MAC_DLSCH_UE_CONTENTION_RESOLUTION_ID_LCID;
-        mac_pdu.subheader[0].payload.ue_con_res_id.id = 0;
-        for(i=0; i<sdu->N_bits; i++)
+        // Pack the contention resolution PDU straight into the scheduling queue
+        mac_pdu = get_dl_sched_mac_pdu(&idx);
+        if(NULL != mac_pdu)
         {
-            mac_pdu.subheader[0].payload.ue_con_res_id.id <<= 1;
-            mac_pdu.subheader[0].payload.ue_con_res_id.id  |= sdu->msg[i];
+            mac_pdu->chan_type                             = LIBLTE_MAC_CHAN_TYPE_DLSCH;
+            mac_pdu->N_subheaders                          = 1;
+            mac_pdu->subheader[0].lcid                     = LIBLTE_MAC_DLSCH_UE_CONTENTION_RESOLUTION_ID_LCID;
+            mac_pdu->subheader[0].payload.ue_con_res_id.id = 0;
+            for(i=0; i<sdu->N_bits; i++)
+            {
+                mac_pdu->subheader[0].payload.ue_con_res_id.id <<= 1;
+                mac_pdu->subheader[0].payload.ue_con_res_id.id  |= sdu->msg[i];
+            }
         }
 
         // Determine the contention resolution current_tti
-        current_tti = (sched_dl_subfr[sched_cur_dl_subfn].current_tti + 4) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1);
+        current_tti = (sched_cal_get_dl_tti() + 4) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1);
 
         // Add the contention resolution PDU to the scheduling queue
-        if(LTE_FDD_ENB_ERROR_NONE != add_to_dl_sched_queue(current_tti,
-                                                           &mac_pdu,
+        if(NULL                   == mac_pdu ||
+           LTE_FDD_ENB_ERROR_NONE != add_to_dl_sched_queue(current_tti,
+                                                           idx,
                                                            &alloc))
         {
             interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
@@ -638,7 +716,7 @@ void LTE_fdd_enb_mac::handle_ulsch_ccch_sdu(LTE_fdd_enb_user      *user,
                                       &alloc.msg,
                                       "PDU scheduled for RNTI=%u, DL_QUEUE_SIZE=%u",
                                       alloc.rnti,
-                                      dl_sched_queue.size());
+                                      dl_sched_queue.N_entries - dl_sched_queue.N_free);
         }
 
         // Queue the SDU for RLC
@@ -764,33 +842,60 @@ void LTE_fdd_enb_mac::handle_ulsch_c_rnti(LTE_fdd_enb_user            **user,
 void LTE_fdd_enb_mac::handle_ulsch_truncated_bsr(LTE_fdd_enb_user                   *user,
                                                  LIBLTE_MAC_TRUNCATED_BSR_CE_STRUCT *truncated_bsr)
 {
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
                               LTE_FDD_ENB_DEBUG_LEVEL_MAC,
                               __FILE__,
                               __LINE__,
-                              "Not handling ULSCH TRUNCATED_BSR");
+                              "Received TRUNCATED_BSR for RNTI=%u LCG=%u BUFFER_SIZE=%u",
+                              user->get_c_rnti(),
+                              truncated_bsr->lcg_id,
+                              truncated_bsr->max_buffer_size);
+
+    // Only the highest priority LCG with data is reported
+    user->set_ul_buffer_size(truncated_bsr->lcg_id, truncated_bsr->max_buffer_size);
+    add_ul_sched_user(user->get_c_rnti());
 }
 void LTE_fdd_enb_mac::handle_ulsch_short_bsr(LTE_fdd_enb_user               *user,
                                              LIBLTE_MAC_SHORT_BSR_CE_STRUCT *short_bsr)
 {
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+    uint32 i;
+
+    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
                               LTE_FDD_ENB_DEBUG_LEVEL_MAC,
                               __FILE__,
                               __LINE__,
-                              "Not handling ULSCH SHORT_BSR");
+                              "Received SHORT_BSR for RNTI=%u LCG=%u BUFFER_SIZE=%u",
+                              user->get_c_rnti(),
+                              short_bsr->lcg_id,
+                              short_bsr->max_buffer_size);
+
+    // Only one LCG has data
+    for(i=0; i<LTE_FDD_ENB_USER_N_LCGS; i++)
+    {
+        user->set_ul_buffer_size(i, 0);
+    }
+    user->set_ul_buffer_size(short_bsr->lcg_id, short_bsr->max_buffer_size);
+    add_ul_sched_user(user->get_c_rnti());
 }
 void LTE_fdd_enb_mac::handle_ulsch_long_bsr(LTE_fdd_enb_user              *user,
                                             LIBLTE_MAC_LONG_BSR_CE_STRUCT *long_bsr)
 {
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
                               LTE_FDD_ENB_DEBUG_LEVEL_MAC,
                               __FILE__,
                               __LINE__,
-                              "Not handling ULSCH LONG_BSR %u %u %u %u",
-                              long_bsr->buffer_size_0,
-                              long_bsr->buffer_size_1,
-                              long_bsr->buffer_size_2,
-                              long_bsr->buffer_size_3);
+                              "Received LONG_BSR for RNTI=%u BUFFER_SIZES=%u %u %u %u",
+                              user->get_c_rnti(),
+                              LTE_fdd_enb_mac_bsr_buffer_size[long_bsr->buffer_size_0 & 0x3F],
+                              LTE_fdd_enb_mac_bsr_buffer_size[long_bsr->buffer_size_1 & 0x3F],
+                              LTE_fdd_enb_mac_bsr_buffer_size[long_bsr->buffer_size_2 & 0x3F],
+                              LTE_fdd_enb_mac_bsr_buffer_size[long_bsr->buffer_size_3 & 0x3F]);
+
+    user->set_ul_buffer_size(0, LTE_fdd_enb_mac_bsr_buffer_size[long_bsr->buffer_size_0 & 0x3F]);
+    user->set_ul_buffer_size(1, LTE_fdd_enb_mac_bsr_buffer_size[long_bsr->buffer_size_1 & 0x3F]);
+    user->set_ul_buffer_size(2, LTE_fdd_enb_mac_bsr_buffer_size[long_bsr->buffer_size_2 & 0x3F]);
+    user->set_ul_buffer_size(3, LTE_fdd_enb_mac_bsr_buffer_size[long_bsr->buffer_size_3 & 0x3F]);
+    add_ul_sched_user(user->get_c_rnti());
 }
 
 /***************************/
@@ -866,7 +971,7 @@ void LTE_fdd_enb_mac::construct_random_access_response(uint8  preamble,
                                       __FILE__,
                                       __LINE__,
                                       "RAR scheduled %u",
-                                      rar_sched_queue.size());
+                                      rar_sched_queue.N_entries - rar_sched_queue.N_free);
         }
     }else{
         interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
@@ -887,58 +992,91 @@ void LTE_fdd_enb_mac::scheduler(void)
     LTE_FDD_ENB_RAR_SCHED_QUEUE_STRUCT *rar_sched;
     LTE_FDD_ENB_DL_SCHED_QUEUE_STRUCT  *dl_sched;
     LTE_FDD_ENB_UL_SCHED_QUEUE_STRUCT  *ul_sched;
+    LTE_FDD_ENB_SCHED_CANDIDATE_STRUCT  candidates[LTE_FDD_ENB_MAC_SCHED_BUCKET_SIZE];
+    LTE_fdd_enb_user_mgr               *user_mgr = LTE_fdd_enb_user_mgr::get_instance();
+    LTE_fdd_enb_user                   *user;
+    std::set<uint16>::iterator          iter;
+    LIBLTE_PHY_ALLOCATION_STRUCT        ul_alloc;
+    uint32                              entries[LTE_FDD_ENB_MAC_SCHED_BUCKET_SIZE];
+    uint32                              deferred[LTE_FDD_ENB_MAC_SCHED_BUCKET_SIZE];
+    uint32                              prb_map[LTE_FDD_ENB_MAC_PRB_MAP_N_WORDS];
+    uint32                              N_entries;
+    uint32                              N_candidates;
+    uint32                              N_deferred;
+    uint32                              N_dropped;
+    uint32                              current_tti;
+    uint32                              next_tti;
     uint32                              N_cce;
+    uint32                              N_dcis;
+    uint32                              N_sys_prbs;
+    uint32                              N_sys_dcis;
     uint32                              N_pad;
-    uint32                              resp_win_start;
-    uint32                              resp_win_stop;
     uint32                              i;
+    uint32                              j;
     uint32                              rb_start;
     uint32                              riv;
-    int32                               N_avail_dl_prbs;
+    uint32                              ul_subfn;
+    uint32                              ul_tti;
+    uint32                              N_ttis;
+    uint32                              N_bits;
     int32                               N_avail_ul_prbs;
     int32                               N_avail_dcis;
-    bool                                sched_out_of_headroom;
+    bool                                rnti_busy;
+
+    // Only the calendar bucket for the next subframe is visited, entries
+    // that can't fit are carried into the following subframe
+    current_tti = sched_dl_subfr[sched_cur_dl_subfn].current_tti;
+    next_tti    = (current_tti + 1) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1);
 
-    // Get the number of CCEs for the next subframe
+    // Determine the DCI budget, taking out the DCIs the PHY needs for system
+    // information
+    get_sys_info_resources(current_tti, &N_sys_prbs, &N_sys_dcis);
     N_cce = phy->get_n_cce();
+    if(LTE_FDD_ENB_MAC_CSS_N_CCES < N_cce)
+    {
+        N_cce = LTE_FDD_ENB_MAC_CSS_N_CCES;
+    }
+    N_dcis = N_cce / LTE_FDD_ENB_MAC_DCI_N_CCES;
+    if(LIBLTE_PHY_PDCCH_MAX_ALLOC < N_dcis)
+    {
+        N_dcis = LIBLTE_PHY_PDCCH_MAX_ALLOC;
+    }
+    if(N_sys_dcis < N_dcis)
+    {
+        N_dcis -= N_sys_dcis;
+    }else{
+        N_dcis = 0;
+    }
+
+    // Build the PRB bitmap, the PHY places system information from PRB 0
+    // and the MIB occupies the center 6 PRBs
+    memset(prb_map, 0, sizeof(prb_map));
+    prb_map_set(prb_map, 0, N_sys_prbs);
+    if(0 == (current_tti % 10))
+    {
+        prb_map_set(prb_map, (sys_info.N_rb_dl / 2) - 3, 6);
+    }
 
     // Schedule RAR for the next subframe
     rar_sched_queue_mutex.lock();
-    sched_out_of_headroom = false;
-    while(0     != rar_sched_queue.size() &&
-          false == sched_out_of_headroom)
+    N_entries  = sched_cal_take(&rar_sched_queue, current_tti, entries);
+    N_deferred = 0;
+    for(i=0; i<N_entries; i++)
     {
-        rar_sched = rar_sched_queue.front();
-
-        // Determine when the response window starts
-        resp_win_start = (rar_sched->current_tti + 3) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1);
-
-        // Determine when the response window stops
-        resp_win_stop = (resp_win_start + liblte_rrc_ra_response_window_size_num[sys_info.sib2.rr_config_common_sib.rach_cnfg.ra_resp_win_size]) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1);
+        rar_sched = &rar_sched_entry[entries[i]];
 
-        // Take into account the SFN wrap
-        // FIXME: Test this
-        if(resp_win_start                                 <  LIBLTE_PHY_SFN_MAX*10 &&
-           sched_dl_subfr[sched_cur_dl_subfn].current_tti >= LIBLTE_PHY_SFN_MAX*10)
-        {
-            resp_win_start += LIBLTE_PHY_SFN_MAX*10;
-        }
-        if(resp_win_stop                                  <  LIBLTE_PHY_SFN_MAX*10 &&
-           sched_dl_subfr[sched_cur_dl_subfn].current_tti >= LIBLTE_PHY_SFN_MAX*10)
-        {
-            resp_win_stop += LIBLTE_PHY_SFN_MAX*10;
-        }
-
-        // Check to see if this current_tti falls in the response window
-        if(resp_win_start <= sched_dl_subfr[sched_cur_dl_subfn].current_tti &&
-           resp_win_stop  >= sched_dl_subfr[sched_cur_dl_subfn].current_tti)
+        if(rar_sched->current_tti != current_tti)
         {
+            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                                      LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                                      __FILE__,
+                                      __LINE__,
+                                      "RAR for CURRENT_TTI=%u missed, currently on %u",
+                                      rar_sched->current_tti,
+                                      current_tti);
+            sched_cal_free(&rar_sched_queue, entries[i]);
+        }else{
             // Determine how many PRBs are needed for the DL allocation, if using this subframe
-            interface->send_pcap_msg(LTE_FDD_ENB_PCAP_DIRECTION_DL,
-                                     rar_sched->dl_alloc.rnti,
-                                     sched_dl_subfr[sched_cur_dl_subfn].current_tti,
-                                     rar_sched->dl_alloc.msg.msg,
-                                     rar_sched->dl_alloc.msg.N_bits);
             liblte_phy_get_tbs_mcs_and_n_prb_for_dl(rar_sched->dl_alloc.msg.N_bits,
                                                     sched_cur_dl_subfn,
                                                     sys_info.N_rb_dl,
@@ -947,24 +1085,33 @@ void LTE_fdd_enb_mac::scheduler(void)
                                                     &rar_sched->dl_alloc.mcs,
                                                     &rar_sched->dl_alloc.N_prb);
 
-            // Determine how many PRBs and DCIs are available in this subframe
-            N_avail_dl_prbs = sched_dl_subfr[sched_cur_dl_subfn].N_avail_prbs - sched_dl_subfr[sched_cur_dl_subfn].N_sched_prbs;
-            N_avail_ul_prbs = sched_ul_subfr[(sched_cur_ul_subfn+6)%10].N_avail_prbs - sched_ul_subfr[(sched_cur_ul_subfn+6)%10].N_sched_prbs;
-            N_avail_dcis    = N_cce - (sched_dl_subfr[sched_cur_dl_subfn].dl_allocations.N_alloc + sched_dl_subfr[sched_cur_dl_subfn].ul_allocations.N_alloc);
+            // Determine how many UL PRBs and DCIs are available in this subframe,
+            // the UL PRBs are checked in the subframe the Msg3 is decoded in
+            N_avail_ul_prbs = sched_ul_subfr[(sched_cur_dl_subfn+6)%10].N_avail_prbs - sched_ul_subfr[(sched_cur_dl_subfn+6)%10].N_sched_prbs;
+            N_avail_dcis    = N_dcis - (sched_dl_subfr[sched_cur_dl_subfn].dl_allocations.N_alloc + sched_dl_subfr[sched_cur_dl_subfn].ul_allocations.N_alloc);
 
-            if(rar_sched->dl_alloc.N_prb <= N_avail_dl_prbs &&
-               rar_sched->ul_alloc.N_prb <= N_avail_ul_prbs &&
-               1                         <= N_avail_dcis)
+            if(rar_sched->ul_alloc.N_prb <= N_avail_ul_prbs &&
+               1                         <= N_avail_dcis    &&
+               prb_map_find(prb_map, sys_info.N_rb_dl, rar_sched->dl_alloc.N_prb, &rb_start))
             {
+                // Fill in the PRBs for the DL allocation
+                prb_map_set(prb_map, rb_start, rar_sched->dl_alloc.N_prb);
+                for(j=0; j<rar_sched->dl_alloc.N_prb; j++)
+                {
+                    rar_sched->dl_alloc.prb[0][j] = rb_start+j;
+                    rar_sched->dl_alloc.prb[1][j] = rb_start+j;
+                }
+
                 // Determine the RB start for the UL allocation
-                rb_start                                            = sched_ul_subfr[(sched_cur_ul_subfn+6)%10].next_prb;
-                sched_ul_subfr[(sched_cur_ul_subfn+6)%10].next_prb += rar_sched->ul_alloc.N_prb;
+                rb_start                                                = sched_ul_subfr[(sched_cur_dl_subfn+6)%10].next_prb;
+                sched_ul_subfr[(sched_cur_dl_subfn+6)%10].next_prb     += rar_sched->ul_alloc.N_prb;
+                sched_ul_subfr[(sched_cur_dl_subfn+6)%10].N_sched_prbs += rar_sched->ul_alloc.N_prb;
 
                 // Fill in the PRBs for the UL allocation
-                for(i=0; i<rar_sched->ul_alloc.N_prb; i++)
+                for(j=0; j<rar_sched->ul_alloc.N_prb; j++)
                 {
-                    rar_sched->ul_alloc.prb[0][i] = rb_start+i;
-                    rar_sched->ul_alloc.prb[1][i] = rb_start+i;
+                    rar_sched->ul_alloc.prb[0][j] = rb_start+j;
+                    rar_sched->ul_alloc.prb[1][j] = rb_start+j;
                 }
 
                 // Determine the RIV for the UL and re-pack the RAR
@@ -983,15 +1130,21 @@ void LTE_fdd_enb_mac::scheduler(void)
                 liblte_mac_pack_random_access_response_pdu(&rar_sched->rar,
                                                            &rar_sched->dl_alloc.msg);
 
+                // Send a PCAP message
+                interface->send_pcap_msg(LTE_FDD_ENB_PCAP_DIRECTION_DL,
+                                         rar_sched->dl_alloc.rnti,
+                                         current_tti,
+                                         rar_sched->dl_alloc.msg.msg,
+                                         rar_sched->dl_alloc.msg.N_bits);
+
                 interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
                                           LTE_FDD_ENB_DEBUG_LEVEL_MAC,
                                           __FILE__,
                                           __LINE__,
                                           &rar_sched->dl_alloc.msg,
-                                          "RAR sent %u %u %u %u",
-                                          resp_win_start,
-                                          resp_win_stop,
-                                          sched_dl_subfr[sched_cur_dl_subfn].current_tti,
+                                          "RAR sent %u %u %u",
+                                          rar_sched->expiry_tti,
+                                          current_tti,
                                           sched_ul_subfr[(sched_cur_dl_subfn+6)%10].current_tti);
 
                 // Schedule DL
@@ -999,6 +1152,7 @@ void LTE_fdd_enb_mac::scheduler(void)
                        &rar_sched->dl_alloc,
                        sizeof(LIBLTE_PHY_ALLOCATION_STRUCT));
                 sched_dl_subfr[sched_cur_dl_subfn].dl_allocations.N_alloc++;
+                sched_dl_subfr[sched_cur_dl_subfn].N_sched_prbs += rar_sched->dl_alloc.N_prb;
                 // Schedule UL decode 6 subframes from now
                 memcpy(&sched_ul_subfr[(sched_cur_dl_subfn+6)%10].decodes.alloc[sched_ul_subfr[(sched_cur_dl_subfn+6)%10].decodes.N_alloc],
                        &rar_sched->ul_alloc,
@@ -1006,46 +1160,112 @@ void LTE_fdd_enb_mac::scheduler(void)
                 sched_ul_subfr[(sched_cur_dl_subfn+6)%10].decodes.N_alloc++;
 
                 // Remove RAR from queue
-                rar_sched_queue.pop_front();
-                delete rar_sched;
+                sched_cal_free(&rar_sched_queue, entries[i]);
+            }else if(0 < sched_cal_tti_diff(current_tti, rar_sched->expiry_tti)){
+                // Still inside the response window, try the next subframe
+                rar_sched->current_tti  = next_tti;
+                deferred[N_deferred++]  = entries[i];
             }else{
-                sched_out_of_headroom = true;
+                // Response window has passed, remove from queue
+                interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                                          LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                                          __FILE__,
+                                          __LINE__,
+                                          "RAR outside of resp win %u %u",
+                                          rar_sched->expiry_tti,
+                                          current_tti);
+                sched_cal_free(&rar_sched_queue, entries[i]);
             }
-        }else if(resp_win_stop < sched_dl_subfr[sched_cur_dl_subfn].current_tti){ // Check to see if the response window has passed
-            // Response window has passed, remove from queue
+        }
+    }
+    N_dropped = sched_cal_defer(&rar_sched_queue, next_tti, deferred, N_deferred);
+    rar_sched_queue_mutex.unlock();
+    if(0 != N_dropped)
+    {
+        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_WARNING,
+                                  LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                                  __FILE__,
+                                  __LINE__,
+                                  "Dropped %u RARs, calendar bucket full",
+                                  N_dropped);
+    }
+
+    // Schedule DL for the next subframe
+    dl_sched_queue_mutex.lock();
+    N_entries    = sched_cal_take(&dl_sched_queue, current_tti, entries);
+    N_candidates = 0;
+    N_deferred   = 0;
+    for(i=0; i<N_entries; i++)
+    {
+        dl_sched = &dl_sched_entry[entries[i]];
+
+        if(dl_sched->current_tti != current_tti)
+        {
             interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
                                       LTE_FDD_ENB_DEBUG_LEVEL_MAC,
                                       __FILE__,
                                       __LINE__,
-                                      "RAR outside of resp win %u %u",
-                                      resp_win_stop,
-                                      sched_dl_subfr[sched_cur_dl_subfn].current_tti);
-            rar_sched_queue.pop_front();
-            delete rar_sched;
+                                      "DL allocation for RNTI=%u CURRENT_TTI=%u missed, currently on %u",
+                                      dl_sched->alloc.rnti,
+                                      dl_sched->current_tti,
+                                      current_tti);
+            sched_cal_free(&dl_sched_queue, entries[i]);
         }else{
-            break;
+            candidates[N_candidates].entry  = entries[i];
+            candidates[N_candidates].metric = get_dl_sched_metric(dl_sched->alloc.rnti, current_tti);
+            N_candidates++;
         }
     }
-    rar_sched_queue_mutex.unlock();
 
-    // Schedule DL for the next subframe
-    dl_sched_queue_mutex.lock();
-    sched_out_of_headroom = false;
-    while(0     != dl_sched_queue.size() &&
-          false == sched_out_of_headroom)
+    // Serve the candidates in the order chosen by the scheduling policy
+    sort_sched_candidates(candidates, N_candidates);
+    for(i=0; i<N_candidates; i++)
     {
-        dl_sched = dl_sched_queue.front();
+        dl_sched = &dl_sched_entry[candidates[i].entry];
 
-        if(dl_sched->current_tti == sched_dl_subfr[sched_cur_dl_subfn].current_tti)
+        // Keep the PDUs for each RNTI in order and only send one per subframe
+        rnti_busy = false;
+        for(j=0; j<N_deferred; j++)
+        {
+            if(dl_sched_entry[deferred[j]].alloc.rnti == dl_sched->alloc.rnti)
+            {
+                rnti_busy = true;
+            }
+        }
+        for(j=0; j<sched_dl_subfr[sched_cur_dl_subfn].dl_allocations.N_alloc; j++)
+        {
+            if(sched_dl_subfr[sched_cur_dl_subfn].dl_allocations.alloc[j].rnti == dl_sched->alloc.rnti)
+            {
+                rnti_busy = true;
+            }
+        }
+
+        if(!rnti_busy)
         {
             // Pack the message and determine TBS
-            liblte_mac_pack_mac_pdu(&dl_sched->mac_pdu,
+            liblte_mac_pack_mac_pdu(dl_sched->mac_pdu,
                                     &dl_sched->alloc.msg);
             liblte_phy_get_tbs_and_n_prb_for_dl(dl_sched->alloc.msg.N_bits,
                                                 sys_info.N_rb_dl,
                                                 dl_sched->alloc.mcs,
                                                 &dl_sched->alloc.tbs,
                                                 &dl_sched->alloc.N_prb);
+        }
+
+        // Determine how many DCIs are available in this subframe
+        N_avail_dcis = N_dcis - (sched_dl_subfr[sched_cur_dl_subfn].dl_allocations.N_alloc + sched_dl_subfr[sched_cur_dl_subfn].ul_allocations.N_alloc);
+
+        if(!rnti_busy         &&
+           1 <= N_avail_dcis &&
+           prb_map_find(prb_map, sys_info.N_rb_dl, dl_sched->alloc.N_prb, &rb_start))
+        {
+            // Fill in the PRBs
+            prb_map_set(prb_map, rb_start, dl_sched->alloc.N_prb);
+            for(j=0; j<dl_sched->alloc.N_prb; j++)
+            {
+                dl_sched->alloc.prb[0][j] = rb_start+j;
+                dl_sched->alloc.prb[1][j] = rb_start+j;
+            }
 
             // Pad and repack if needed
             if(dl_sched->alloc.tbs > dl_sched->alloc.msg.N_bits)
@@ -1054,92 +1274,142 @@ void LTE_fdd_enb_mac::scheduler(void)
 
                 if(1 == N_pad)
                 {
-                    for(i=0; i<dl_sched->mac_pdu.N_subheaders; i++)
+                    for(j=0; j<dl_sched->mac_pdu->N_subheaders; j++)
                     {
-                        memcpy(&dl_sched->mac_pdu.subheader[dl_sched->mac_pdu.N_subheaders-i], &dl_sched->mac_pdu.subheader[dl_sched->mac_pdu.N_subheaders-i-1], sizeof(LIBLTE_MAC_PDU_SUBHEADER_STRUCT));
+                        memcpy(&dl_sched->mac_pdu->subheader[dl_sched->mac_pdu->N_subheaders-j], &dl_sched->mac_pdu->subheader[dl_sched->mac_pdu->N_subheaders-j-1], sizeof(LIBLTE_MAC_PDU_SUBHEADER_STRUCT));
                     }
-                    dl_sched->mac_pdu.subheader[0].lcid = LIBLTE_MAC_DLSCH_PADDING_LCID;
-                    dl_sched->mac_pdu.N_subheaders++;
+                    dl_sched->mac_pdu->subheader[0].lcid = LIBLTE_MAC_DLSCH_PADDING_LCID;
+                    dl_sched->mac_pdu->N_subheaders++;
                 }else if(2 == N_pad){
-                    for(i=0; i<dl_sched->mac_pdu.N_subheaders; i++)
+                    for(j=0; j<dl_sched->mac_pdu->N_subheaders; j++)
                     {
-                        memcpy(&dl_sched->mac_pdu.subheader[dl_sched->mac_pdu.N_subheaders-i+1], &dl_sched->mac_pdu.subheader[dl_sched->mac_pdu.N_subheaders-i-1], sizeof(LIBLTE_MAC_PDU_SUBHEADER_STRUCT));
+                        memcpy(&dl_sched->mac_pdu->subheader[dl_sched->mac_pdu->N_subheaders-j+1], &dl_sched->mac_pdu->subheader[dl_sched->mac_pdu->N_subheaders-j-1], sizeof(LIBLTE_MAC_PDU_SUBHEADER_STRUCT));
                     }
-                    dl_sched->mac_pdu.subheader[0].lcid  = LIBLTE_MAC_DLSCH_PADDING_LCID;
-                    dl_sched->mac_pdu.subheader[1].lcid  = LIBLTE_MAC_DLSCH_PADDING_LCID;
-                    dl_sched->mac_pdu.N_subheaders      += 2;
+                    dl_sched->mac_pdu->subheader[0].lcid  = LIBLTE_MAC_DLSCH_PADDING_LCID;
+                    dl_sched->mac_pdu->subheader[1].lcid  = LIBLTE_MAC_DLSCH_PADDING_LCID;
+                    dl_sched->mac_pdu->N_subheaders      += 2;
                 }else{
-                    dl_sched->mac_pdu.subheader[dl_sched->mac_pdu.N_subheaders].lcid = LIBLTE_MAC_DLSCH_PADDING_LCID;
-                    dl_sched->mac_pdu.N_subheaders++;
+                    dl_sched->mac_pdu->subheader[dl_sched->mac_pdu->N_subheaders].lcid = LIBLTE_MAC_DLSCH_PADDING_LCID;
+                    dl_sched->mac_pdu->N_subheaders++;
                 }
 
-                liblte_mac_pack_mac_pdu(&dl_sched->mac_pdu,
+                liblte_mac_pack_mac_pdu(dl_sched->mac_pdu,
                                         &dl_sched->alloc.msg);
             }
 
             // Send a PCAP message
             interface->send_pcap_msg(LTE_FDD_ENB_PCAP_DIRECTION_DL,
                                      dl_sched->alloc.rnti,
-                                     sched_dl_subfr[sched_cur_dl_subfn].current_tti,
+                                     current_tti,
                                      dl_sched->alloc.msg.msg,
                                      dl_sched->alloc.tbs);
 
-            // Determine how many PRBs and DCIs are available in this subframe
-            N_avail_dl_prbs = sched_dl_subfr[sched_cur_dl_subfn].N_avail_prbs - sched_dl_subfr[sched_cur_dl_subfn].N_sched_prbs;
-            N_avail_dcis    = N_cce - (sched_dl_subfr[sched_cur_dl_subfn].dl_allocations.N_alloc + sched_dl_subfr[sched_cur_dl_subfn].ul_allocations.N_alloc);
+            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                                      LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                                      __FILE__,
+                                      __LINE__,
+                                      &dl_sched->alloc.msg,
+                                      "DL allocation sent for RNTI=%u CURRENT_TTI=%u PRB_START=%u N_PRB=%u METRIC=%f",
+                                      dl_sched->alloc.rnti,
+                                      current_tti,
+                                      rb_start,
+                                      dl_sched->alloc.N_prb,
+                                      candidates[i].metric);
+
+            // Schedule DL
+            memcpy(&sched_dl_subfr[sched_cur_dl_subfn].dl_allocations.alloc[sched_dl_subfr[sched_cur_dl_subfn].dl_allocations.N_alloc],
+                   &dl_sched->alloc,
+                   sizeof(LIBLTE_PHY_ALLOCATION_STRUCT));
+            sched_dl_subfr[sched_cur_dl_subfn].dl_allocations.N_alloc++;
+            sched_dl_subfr[sched_cur_dl_subfn].N_sched_prbs += dl_sched->alloc.N_prb;
 
-            if(dl_sched->alloc.N_prb <= N_avail_dl_prbs &&
-               1                     <= N_avail_dcis)
+            // Let the scheduling policy account for the allocation
+            if(LTE_FDD_ENB_ERROR_NONE == user_mgr->find_user(dl_sched->alloc.rnti, &user))
             {
-                interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
-                                          LTE_FDD_ENB_DEBUG_LEVEL_MAC,
-                                          __FILE__,
-                                          __LINE__,
-                                          &dl_sched->alloc.msg,
-                                          "DL allocation sent for RNTI=%u CURRENT_TTI=%u",
-                                          dl_sched->alloc.rnti,
-                                          sched_dl_subfr[sched_cur_dl_subfn].current_tti);
-
-                // Schedule DL
-                memcpy(&sched_dl_subfr[sched_cur_dl_subfn].dl_allocations.alloc[sched_dl_subfr[sched_cur_dl_subfn].dl_allocations.N_alloc],
-                       &dl_sched->alloc,
-                       sizeof(LIBLTE_PHY_ALLOCATION_STRUCT));
-                sched_dl_subfr[sched_cur_dl_subfn].dl_allocations.N_alloc++;
-
-                // Remove DL schedule from queue
-                dl_sched_queue.pop_front();
-                delete dl_sched;
+                get_dl_sched_policy()->scheduled(user, current_tti, dl_sched->alloc.tbs);
             }
+
+            // Remove DL schedule from queue
+            sched_cal_free(&dl_sched_queue, candidates[i].entry);
+        }else if(0 < sched_cal_tti_diff(current_tti, dl_sched->expiry_tti)){
+            dl_sched->current_tti  = next_tti;
+            deferred[N_deferred++] = candidates[i].entry;
         }else{
-            sched_out_of_headroom = true;
+            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_WARNING,
+                                      LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                                      __FILE__,
+                                      __LINE__,
+                                      "DL allocation for RNTI=%u expired at CURRENT_TTI=%u",
+                                      dl_sched->alloc.rnti,
+                                      current_tti);
+            sched_cal_free(&dl_sched_queue, candidates[i].entry);
         }
     }
+    N_dropped = sched_cal_defer(&dl_sched_queue, next_tti, deferred, N_deferred);
     dl_sched_queue_mutex.unlock();
+    if(0 != N_dropped)
+    {
+        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_WARNING,
+                                  LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                                  __FILE__,
+                                  __LINE__,
+                                  "Dropped %u DL allocations, calendar bucket full",
+                                  N_dropped);
+    }
 
     // Schedule UL for the next subframe
     ul_sched_queue_mutex.lock();
-    sched_out_of_headroom = false;
-    while(0     != ul_sched_queue.size() &&
-          false == sched_out_of_headroom)
+    N_entries  = sched_cal_take(&ul_sched_queue, current_tti, entries);
+    N_deferred = 0;
+    for(i=0; i<N_entries; i++)
     {
-        ul_sched = ul_sched_queue.front();
+        ul_sched = &ul_sched_entry[entries[i]];
+
+        // Only send one UL allocation per RNTI per subframe
+        rnti_busy = false;
+        for(j=0; j<N_deferred; j++)
+        {
+            if(ul_sched_entry[deferred[j]].alloc.rnti == ul_sched->alloc.rnti)
+            {
+                rnti_busy = true;
+            }
+        }
+        for(j=0; j<sched_dl_subfr[sched_cur_dl_subfn].ul_allocations.N_alloc; j++)
+        {
+            if(sched_dl_subfr[sched_cur_dl_subfn].ul_allocations.alloc[j].rnti == ul_sched->alloc.rnti)
+            {
+                rnti_busy = true;
+            }
+        }
 
         // Determine how many PRBs and DCIs are available in this subframe
         N_avail_ul_prbs = sched_ul_subfr[(sched_cur_dl_subfn+4)%10].N_avail_prbs - sched_ul_subfr[(sched_cur_dl_subfn+4)%10].N_sched_prbs;
-        N_avail_dcis    = N_cce - (sched_dl_subfr[sched_cur_dl_subfn].dl_allocations.N_alloc + sched_dl_subfr[sched_cur_dl_subfn].ul_allocations.N_alloc);
+        N_avail_dcis    = N_dcis - (sched_dl_subfr[sched_cur_dl_subfn].dl_allocations.N_alloc + sched_dl_subfr[sched_cur_dl_subfn].ul_allocations.N_alloc);
 
-        if(ul_sched->alloc.N_prb <= N_avail_ul_prbs &&
-           1                     <= N_avail_dcis)
+        if(ul_sched->current_tti != current_tti)
         {
+            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                                      LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                                      __FILE__,
+                                      __LINE__,
+                                      "UL allocation for RNTI=%u CURRENT_TTI=%u missed, currently on %u",
+                                      ul_sched->alloc.rnti,
+                                      ul_sched->current_tti,
+                                      current_tti);
+            sched_cal_free(&ul_sched_queue, entries[i]);
+        }else if(!rnti_busy                                &&
+                 ul_sched->alloc.N_prb <= N_avail_ul_prbs &&
+                 1                     <= N_avail_dcis){
             // Determine the RB start
-            rb_start                                            = sched_ul_subfr[(sched_cur_dl_subfn+4)%10].next_prb;
-            sched_ul_subfr[(sched_cur_dl_subfn+4)%10].next_prb += ul_sched->alloc.N_prb;
+            rb_start                                                = sched_ul_subfr[(sched_cur_dl_subfn+4)%10].next_prb;
+            sched_ul_subfr[(sched_cur_dl_subfn+4)%10].next_prb     += ul_sched->alloc.N_prb;
+            sched_ul_subfr[(sched_cur_dl_subfn+4)%10].N_sched_prbs += ul_sched->alloc.N_prb;
 
             // Fill in the PRBs
-            for(i=0; i<ul_sched->alloc.N_prb; i++)
+            for(j=0; j<ul_sched->alloc.N_prb; j++)
             {
-                ul_sched->alloc.prb[0][i] = rb_start+i;
-                ul_sched->alloc.prb[1][i] = rb_start+i;
+                ul_sched->alloc.prb[0][j] = rb_start+j;
+                ul_sched->alloc.prb[1][j] = rb_start+j;
             }
 
             interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
@@ -1162,13 +1432,157 @@ void LTE_fdd_enb_mac::scheduler(void)
             sched_dl_subfr[sched_cur_dl_subfn].ul_allocations.N_alloc++;
 
             // Remove UL schedule from queue
-            ul_sched_queue.pop_front();
-            delete ul_sched;
+            sched_cal_free(&ul_sched_queue, entries[i]);
+        }else if(0 < sched_cal_tti_diff(current_tti, ul_sched->expiry_tti)){
+            ul_sched->current_tti  = next_tti;
+            deferred[N_deferred++] = entries[i];
         }else{
-            sched_out_of_headroom = true;
+            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_WARNING,
+                                      LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                                      __FILE__,
+                                      __LINE__,
+                                      "UL allocation for RNTI=%u expired at CURRENT_TTI=%u",
+                                      ul_sched->alloc.rnti,
+                                      current_tti);
+            sched_cal_free(&ul_sched_queue, entries[i]);
         }
     }
+    N_dropped = sched_cal_defer(&ul_sched_queue, next_tti, deferred, N_deferred);
     ul_sched_queue_mutex.unlock();
+    if(0 != N_dropped)
+    {
+        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_WARNING,
+                                  LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                                  __FILE__,
+                                  __LINE__,
+                                  "Dropped %u UL allocations, calendar bucket full",
+                                  N_dropped);
+    }
+
+    // Pack UL grants for users with buffered data, or due a poll, into the
+    // PRBs left 4 subframes from now
+    ul_subfn     = (sched_cur_dl_subfn+4)%10;
+    ul_tti       = sched_ul_subfr[ul_subfn].current_tti;
+    N_candidates = 0;
+    ul_sched_users_mutex.lock();
+    iter = ul_sched_users.begin();
+    while(iter != ul_sched_users.end() &&
+          N_candidates < LTE_FDD_ENB_MAC_SCHED_BUCKET_SIZE)
+    {
+        if(LTE_FDD_ENB_ERROR_NONE == user_mgr->find_user(*iter, &user))
+        {
+            // Explicitly scheduled grants take precedence
+            rnti_busy = false;
+            for(j=0; j<sched_dl_subfr[sched_cur_dl_subfn].ul_allocations.N_alloc; j++)
+            {
+                if(sched_dl_subfr[sched_cur_dl_subfn].ul_allocations.alloc[j].rnti == *iter)
+                {
+                    rnti_busy = true;
+                }
+            }
+
+            N_ttis = (ul_tti + LTE_FDD_ENB_CURRENT_TTI_MAX + 1 - user->get_ul_last_sched_tti()) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1);
+            if(!rnti_busy &&
+               (0 != user->get_ul_buffer_size() ||
+                (0                           != user->get_ul_poll_period() &&
+                 user->get_ul_poll_period()  <= N_ttis)))
+            {
+                // Longest since last granted goes first
+                candidates[N_candidates].entry  = *iter;
+                candidates[N_candidates].metric = (float)N_ttis;
+                N_candidates++;
+            }
+            iter++;
+        }else{
+            // User is gone
+            ul_sched_users.erase(iter++);
+        }
+    }
+    ul_sched_users_mutex.unlock();
+
+    sort_sched_candidates(candidates, N_candidates);
+    for(i=0; i<N_candidates; i++)
+    {
+        // Determine how many PRBs and DCIs are available in this subframe
+        N_avail_ul_prbs = sched_ul_subfr[ul_subfn].N_avail_prbs - sched_ul_subfr[ul_subfn].N_sched_prbs;
+        N_avail_dcis    = N_dcis - (sched_dl_subfr[sched_cur_dl_subfn].dl_allocations.N_alloc + sched_dl_subfr[sched_cur_dl_subfn].ul_allocations.N_alloc);
+        if(1 > N_avail_ul_prbs ||
+           1 > N_avail_dcis)
+        {
+            break;
+        }
+
+        if(LTE_FDD_ENB_ERROR_NONE == user_mgr->find_user(candidates[i].entry, &user))
+        {
+            // Ask for the reported buffer plus MAC header, or the poll size
+            if(0 != user->get_ul_buffer_size())
+            {
+                N_bits = (user->get_ul_buffer_size() + LTE_FDD_ENB_MAC_UL_HEADER_OVERHEAD) * 8;
+            }else{
+                N_bits = user->get_ul_poll_bits();
+            }
+
+            if(get_ul_grant_size(N_bits,
+                                 N_avail_ul_prbs,
+                                 &ul_alloc.tbs,
+                                 &ul_alloc.mcs,
+                                 &ul_alloc.N_prb))
+            {
+                ul_alloc.pre_coder_type = LIBLTE_PHY_PRE_CODER_TYPE_TX_DIVERSITY;
+                ul_alloc.mod_type       = LIBLTE_PHY_MODULATION_TYPE_QPSK;
+                ul_alloc.chan_type      = LIBLTE_PHY_CHAN_TYPE_ULSCH;
+                ul_alloc.rv_idx         = 0;
+                ul_alloc.N_codewords    = 1;
+                ul_alloc.N_layers       = 1;
+                ul_alloc.tx_mode        = 1;
+                ul_alloc.rnti           = user->get_c_rnti();
+                ul_alloc.tpc            = LIBLTE_PHY_TPC_COMMAND_DCI_0_3_4_DB_NEG_1;
+                ul_alloc.ndi            = false; // FIXME
+
+                // Determine the RB start
+                rb_start                                = sched_ul_subfr[ul_subfn].next_prb;
+                sched_ul_subfr[ul_subfn].next_prb     += ul_alloc.N_prb;
+                sched_ul_subfr[ul_subfn].N_sched_prbs += ul_alloc.N_prb;
+
+                // Fill in the PRBs
+                for(j=0; j<ul_alloc.N_prb; j++)
+                {
+                    ul_alloc.prb[0][j] = rb_start+j;
+                    ul_alloc.prb[1][j] = rb_start+j;
+                }
+
+                interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                                          LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                                          __FILE__,
+                                          __LINE__,
+                                          "UL grant sent for RNTI=%u CURRENT_TTI=%u BUFFER_SIZE=%u TBS=%u N_PRB=%u",
+                                          ul_alloc.rnti,
+                                          ul_tti,
+                                          user->get_ul_buffer_size(),
+                                          ul_alloc.tbs,
+                                          ul_alloc.N_prb);
+
+                // Schedule UL decode 4 subframes from now
+                memcpy(&sched_ul_subfr[ul_subfn].decodes.alloc[sched_ul_subfr[ul_subfn].decodes.N_alloc],
+                       &ul_alloc,
+                       sizeof(LIBLTE_PHY_ALLOCATION_STRUCT));
+                sched_ul_subfr[ul_subfn].decodes.N_alloc++;
+                // Schedule UL allocation
+                memcpy(&sched_dl_subfr[sched_cur_dl_subfn].ul_allocations.alloc[sched_dl_subfr[sched_cur_dl_subfn].ul_allocations.N_alloc],
+                       &ul_alloc,
+                       sizeof(LIBLTE_PHY_ALLOCATION_STRUCT));
+                sched_dl_subfr[sched_cur_dl_subfn].ul_allocations.N_alloc++;
+
+                // Account for the grant until the next BSR
+                if(ul_alloc.tbs/8 > LTE_FDD_ENB_MAC_UL_HEADER_OVERHEAD)
+                {
+                    user->update_ul_buffer_size(ul_tti, ul_alloc.tbs/8 - LTE_FDD_ENB_MAC_UL_HEADER_OVERHEAD);
+                }else{
+                    user->update_ul_buffer_size(ul_tti, 0);
+                }
+            }
+        }
+    }
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_mac::add_to_rar_sched_queue(uint32                        current_tti,
                                                                LIBLTE_PHY_ALLOCATION_STRUCT *dl_alloc,
@@ -1176,90 +1590,507 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_mac::add_to_rar_sched_queue(uint32
                                                                LIBLTE_MAC_RAR_STRUCT        *rar)
 {
     LTE_FDD_ENB_RAR_SCHED_QUEUE_STRUCT *rar_sched = NULL;
+    LTE_FDD_ENB_SCHED_BUCKET_STRUCT    *bucket    = NULL;
     LTE_FDD_ENB_ERROR_ENUM              err       = LTE_FDD_ENB_ERROR_CANT_SCHEDULE;
+    uint32                              resp_win_start;
+    uint32                              resp_win_stop;
+    uint32                              cal_tti;
+    uint32                              idx;
+    int32                               start_diff;
+    int32                               stop_diff;
 
-    rar_sched = new LTE_FDD_ENB_RAR_SCHED_QUEUE_STRUCT;
+    // Determine the response window
+    sys_info_mutex.lock();
+    resp_win_start = (current_tti + 3) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1);
+    resp_win_stop  = (resp_win_start + liblte_rrc_ra_response_window_size_num[sys_info.sib2.rr_config_common_sib.rach_cnfg.ra_resp_win_size]) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1);
+    sys_info_mutex.unlock();
 
-    if(NULL != rar_sched)
+    rar_sched_queue_mutex.lock();
+
+    // Find the first subframe in the response window with room, relative to
+    // a snapshot of the calendar TTI taken under the queue lock
+    cal_tti    = sched_cal_get_dl_tti();
+    start_diff = sched_cal_tti_diff(cal_tti, resp_win_start);
+    stop_diff  = sched_cal_tti_diff(cal_tti, resp_win_stop);
+    if(1 > start_diff)
+    {
+        start_diff = 1;
+    }
+    if(LTE_FDD_ENB_MAC_SCHED_N_TTIS <= stop_diff)
     {
-        rar_sched->current_tti = current_tti;
+        stop_diff = LTE_FDD_ENB_MAC_SCHED_N_TTIS - 1;
+    }
+    while(start_diff <= stop_diff &&
+          NULL       == bucket)
+    {
+        bucket = &rar_sched_queue.bucket[sched_cal_tti(cal_tti, start_diff) % LTE_FDD_ENB_MAC_SCHED_N_TTIS];
+        if(LTE_FDD_ENB_MAC_SCHED_BUCKET_SIZE == bucket->N_entries)
+        {
+            bucket = NULL;
+            start_diff++;
+        }
+    }
+
+    if(NULL != bucket &&
+       sched_cal_alloc(&rar_sched_queue, &idx))
+    {
+        rar_sched              = &rar_sched_entry[idx];
+        rar_sched->current_tti = sched_cal_tti(cal_tti, start_diff);
+        rar_sched->expiry_tti  = resp_win_stop;
         memcpy(&rar_sched->dl_alloc, dl_alloc, sizeof(LIBLTE_PHY_ALLOCATION_STRUCT));
         memcpy(&rar_sched->ul_alloc, ul_alloc, sizeof(LIBLTE_PHY_ALLOCATION_STRUCT));
         memcpy(&rar_sched->rar, rar, sizeof(LIBLTE_MAC_RAR_STRUCT));
 
-        rar_sched_queue_mutex.lock();
-        rar_sched_queue.push_back(rar_sched);
-        rar_sched_queue_mutex.unlock();
+        bucket->entry[bucket->N_entries++] = idx;
 
         err = LTE_FDD_ENB_ERROR_NONE;
     }
 
+    rar_sched_queue_mutex.unlock();
+
     return(err);
 }
+LIBLTE_MAC_PDU_STRUCT* LTE_fdd_enb_mac::get_dl_sched_mac_pdu(uint32 *idx)
+{
+    LIBLTE_MAC_PDU_STRUCT *mac_pdu = NULL;
+
+    // Reserve a DL calendar entry, the caller builds the MAC PDU in place
+    // and then either queues it with add_to_dl_sched_queue or has it
+    // released there on failure
+    dl_sched_queue_mutex.lock();
+    if(sched_cal_alloc(&dl_sched_queue, idx))
+    {
+        mac_pdu                      = &dl_sched_mac_pdu[*idx];
+        dl_sched_entry[*idx].mac_pdu = mac_pdu;
+    }
+    dl_sched_queue_mutex.unlock();
+
+    return(mac_pdu);
+}
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_mac::add_to_dl_sched_queue(uint32                        current_tti,
-                                                              LIBLTE_MAC_PDU_STRUCT        *mac_pdu,
+                                                              uint32                        idx,
                                                               LIBLTE_PHY_ALLOCATION_STRUCT *alloc)
 {
-    std::list<LTE_FDD_ENB_DL_SCHED_QUEUE_STRUCT *>::iterator  iter;
-    LTE_FDD_ENB_DL_SCHED_QUEUE_STRUCT                        *dl_sched = NULL;
-    LTE_FDD_ENB_ERROR_ENUM                                    err      = LTE_FDD_ENB_ERROR_CANT_SCHEDULE;
+    LTE_FDD_ENB_DL_SCHED_QUEUE_STRUCT *dl_sched  = NULL;
+    LTE_FDD_ENB_SCHED_BUCKET_STRUCT   *bucket    = NULL;
+    LTE_FDD_ENB_ERROR_ENUM             err       = LTE_FDD_ENB_ERROR_CANT_SCHEDULE;
+    uint32                             cal_tti;
+    uint32                             i;
+    int32                              diff;
+    bool                               collision = true;
 
-    dl_sched = new LTE_FDD_ENB_DL_SCHED_QUEUE_STRUCT;
+    dl_sched_queue_mutex.lock();
 
-    if(NULL != dl_sched)
+    // Never add to a subframe that has already been scheduled, relative to a
+    // snapshot of the calendar TTI taken under the queue lock
+    cal_tti = sched_cal_get_dl_tti();
+    diff    = sched_cal_tti_diff(cal_tti, current_tti);
+    if(1 > diff)
     {
-        dl_sched->current_tti = current_tti;
-        memcpy(&dl_sched->mac_pdu, mac_pdu, sizeof(LIBLTE_MAC_PDU_STRUCT));
-        memcpy(&dl_sched->alloc, alloc, sizeof(LIBLTE_PHY_ALLOCATION_STRUCT));
+        diff = 1;
+    }
 
-        dl_sched_queue_mutex.lock();
-        for(iter=dl_sched_queue.begin(); iter!=dl_sched_queue.end(); iter++)
+    // Only queue one allocation per RNTI per subframe
+    while(collision &&
+          LTE_FDD_ENB_MAC_SCHED_N_TTIS > diff)
+    {
+        bucket    = &dl_sched_queue.bucket[sched_cal_tti(cal_tti, diff) % LTE_FDD_ENB_MAC_SCHED_N_TTIS];
+        collision = (LTE_FDD_ENB_MAC_SCHED_BUCKET_SIZE == bucket->N_entries);
+        for(i=0; i<bucket->N_entries; i++)
         {
-            if((*iter)->alloc.rnti  == alloc->rnti &&
-               (*iter)->current_tti == dl_sched->current_tti)
+            if(dl_sched_entry[bucket->entry[i]].alloc.rnti == alloc->rnti)
             {
-                dl_sched->current_tti = (dl_sched->current_tti + 1) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1);
+                collision = true;
             }
         }
-        dl_sched_queue.push_back(dl_sched);
-        dl_sched_queue_mutex.unlock();
+        if(collision)
+        {
+            diff++;
+        }
+    }
+
+    if(!collision)
+    {
+        dl_sched              = &dl_sched_entry[idx];
+        dl_sched->current_tti = sched_cal_tti(cal_tti, diff);
+        dl_sched->expiry_tti  = (dl_sched->current_tti + LTE_FDD_ENB_MAC_SCHED_MAX_DEFER_TTIS) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1);
+        memcpy(&dl_sched->alloc, alloc, sizeof(LIBLTE_PHY_ALLOCATION_STRUCT));
+
+        bucket->entry[bucket->N_entries++] = idx;
 
         err = LTE_FDD_ENB_ERROR_NONE;
+    }else{
+        // Release the entry reserved by get_dl_sched_mac_pdu
+        sched_cal_free(&dl_sched_queue, idx);
     }
 
+    dl_sched_queue_mutex.unlock();
+
     return(err);
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_mac::add_to_ul_sched_queue(uint32                        current_tti,
                                                               LIBLTE_PHY_ALLOCATION_STRUCT *alloc)
 {
-    std::list<LTE_FDD_ENB_UL_SCHED_QUEUE_STRUCT *>::iterator  iter;
-    LTE_FDD_ENB_UL_SCHED_QUEUE_STRUCT                        *ul_sched = NULL;
-    LTE_FDD_ENB_ERROR_ENUM                                    err      = LTE_FDD_ENB_ERROR_CANT_SCHEDULE;
+    LTE_FDD_ENB_UL_SCHED_QUEUE_STRUCT *ul_sched  = NULL;
+    LTE_FDD_ENB_SCHED_BUCKET_STRUCT   *bucket    = NULL;
+    LTE_FDD_ENB_ERROR_ENUM             err       = LTE_FDD_ENB_ERROR_CANT_SCHEDULE;
+    uint32                             cal_tti;
+    uint32                             idx;
+    uint32                             i;
+    int32                              diff;
+    bool                               collision = true;
 
-    ul_sched = new LTE_FDD_ENB_UL_SCHED_QUEUE_STRUCT;
+    ul_sched_queue_mutex.lock();
 
-    if(NULL != ul_sched)
+    // Never add to a subframe that has already been scheduled, relative to a
+    // snapshot of the calendar TTI taken under the queue lock
+    cal_tti = sched_cal_get_dl_tti();
+    diff    = sched_cal_tti_diff(cal_tti, current_tti);
+    if(1 > diff)
     {
-        ul_sched->current_tti = current_tti;
-        memcpy(&ul_sched->alloc, alloc, sizeof(LIBLTE_PHY_ALLOCATION_STRUCT));
+        diff = 1;
+    }
 
-        ul_sched_queue_mutex.lock();
-        for(iter=ul_sched_queue.begin(); iter!=ul_sched_queue.end(); iter++)
+    // Only queue one allocation per RNTI per subframe
+    while(collision &&
+          LTE_FDD_ENB_MAC_SCHED_N_TTIS > diff)
+    {
+        bucket    = &ul_sched_queue.bucket[sched_cal_tti(cal_tti, diff) % LTE_FDD_ENB_MAC_SCHED_N_TTIS];
+        collision = (LTE_FDD_ENB_MAC_SCHED_BUCKET_SIZE == bucket->N_entries);
+        for(i=0; i<bucket->N_entries; i++)
         {
-            if((*iter)->alloc.rnti  == alloc->rnti &&
-               (*iter)->current_tti == ul_sched->current_tti)
+            if(ul_sched_entry[bucket->entry[i]].alloc.rnti == alloc->rnti)
             {
-                ul_sched->current_tti = (ul_sched->current_tti + 1) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1);
+                collision = true;
             }
         }
-        ul_sched_queue.push_back(ul_sched);
-        ul_sched_queue_mutex.unlock();
+        if(collision)
+        {
+            diff++;
+        }
+    }
+
+    if(!collision &&
+       sched_cal_alloc(&ul_sched_queue, &idx))
+    {
+        ul_sched              = &ul_sched_entry[idx];
+        ul_sched->current_tti = sched_cal_tti(cal_tti, diff);
+        ul_sched->expiry_tti  = (ul_sched->current_tti + LTE_FDD_ENB_MAC_SCHED_MAX_DEFER_TTIS) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1);
+        memcpy(&ul_sched->alloc, alloc, sizeof(LIBLTE_PHY_ALLOCATION_STRUCT));
+
+        bucket->entry[bucket->N_entries++] = idx;
 
         err = LTE_FDD_ENB_ERROR_NONE;
     }
 
+    ul_sched_queue_mutex.unlock();
+
     return(err);
 }
+void LTE_fdd_enb_mac::expire_sched_queues(uint32 current_tti)
+{
+    uint32 entries[LTE_FDD_ENB_MAC_SCHED_BUCKET_SIZE];
+    uint32 N_entries;
+    uint32 N_expired = 0;
+    uint32 i;
+
+    rar_sched_queue_mutex.lock();
+    N_entries = sched_cal_take(&rar_sched_queue, current_tti, entries);
+    for(i=0; i<N_entries; i++)
+    {
+        sched_cal_free(&rar_sched_queue, entries[i]);
+    }
+    N_expired += N_entries;
+    rar_sched_queue_mutex.unlock();
+
+    dl_sched_queue_mutex.lock();
+    N_entries = sched_cal_take(&dl_sched_queue, current_tti, entries);
+    for(i=0; i<N_entries; i++)
+    {
+        sched_cal_free(&dl_sched_queue, entries[i]);
+    }
+    N_expired += N_entries;
+    dl_sched_queue_mutex.unlock();
+
+    ul_sched_queue_mutex.lock();
+    N_entries = sched_cal_take(&ul_sched_queue, current_tti, entries);
+    for(i=0; i<N_entries; i++)
+    {
+        sched_cal_free(&ul_sched_queue, entries[i]);
+    }
+    N_expired += N_entries;
+    ul_sched_queue_mutex.unlock();
+
+    if(0 != N_expired)
+    {
+        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_WARNING,
+                                  LTE_FDD_ENB_DEBUG_LEVEL_MAC,
+                                  __FILE__,
+                                  __LINE__,
+                                  "Dropped %u allocations for skipped CURRENT_TTI=%u",
+                                  N_expired,
+                                  current_tti);
+    }
+}
+
+/*****************************/
+/*    Scheduling Calendar    */
+/*****************************/
+void LTE_fdd_enb_mac::sched_cal_init(LTE_FDD_ENB_SCHED_CALENDAR_STRUCT *cal,
+                                     uint32                             N_entries)
+{
+    uint32 i;
+
+    for(i=0; i<LTE_FDD_ENB_MAC_SCHED_N_TTIS; i++)
+    {
+        cal->bucket[i].N_entries = 0;
+    }
+    for(i=0; i<N_entries; i++)
+    {
+        cal->free_entry[i] = i;
+    }
+    cal->N_free    = N_entries;
+    cal->N_entries = N_entries;
+}
+void LTE_fdd_enb_mac::sched_cal_publish_tti(void)
+{
+    // The calendar TTI is read by the RLC and RRC threads, so it is published
+    // as a single word once the subframe numbers have been advanced and before
+    // the scheduler takes that TTI's buckets
+    __sync_lock_test_and_set(&sched_dl_current_tti, sched_dl_subfr[sched_cur_dl_subfn].current_tti);
+    __sync_lock_test_and_set(&sched_ul_current_tti, sched_ul_subfr[sched_cur_ul_subfn].current_tti);
+}
+uint32 LTE_fdd_enb_mac::sched_cal_get_dl_tti(void)
+{
+    return(__sync_fetch_and_add(&sched_dl_current_tti, 0));
+}
+uint32 LTE_fdd_enb_mac::sched_cal_get_ul_tti(void)
+{
+    return(__sync_fetch_and_add(&sched_ul_current_tti, 0));
+}
+int32 LTE_fdd_enb_mac::sched_cal_tti_diff(uint32 cal_tti,
+                                          uint32 current_tti)
+{
+    int32 diff = (int32)current_tti - (int32)cal_tti;
+
+    // Take into account the TTI wrap
+    if(diff >= (LTE_FDD_ENB_CURRENT_TTI_MAX + 1)/2)
+    {
+        diff -= LTE_FDD_ENB_CURRENT_TTI_MAX + 1;
+    }else if(diff < -(LTE_FDD_ENB_CURRENT_TTI_MAX + 1)/2){
+        diff += LTE_FDD_ENB_CURRENT_TTI_MAX + 1;
+    }
+
+    return(diff);
+}
+uint32 LTE_fdd_enb_mac::sched_cal_tti(uint32 cal_tti,
+                                      int32  diff)
+{
+    return((cal_tti + (LTE_FDD_ENB_CURRENT_TTI_MAX + 1) + diff) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1));
+}
+bool LTE_fdd_enb_mac::sched_cal_alloc(LTE_FDD_ENB_SCHED_CALENDAR_STRUCT *cal,
+                                      uint32                            *idx)
+{
+    bool ret = false;
+
+    if(0 != cal->N_free)
+    {
+        cal->N_free--;
+        *idx = cal->free_entry[cal->N_free];
+        ret  = true;
+    }
+
+    return(ret);
+}
+void LTE_fdd_enb_mac::sched_cal_free(LTE_FDD_ENB_SCHED_CALENDAR_STRUCT *cal,
+                                     uint32                             idx)
+{
+    cal->free_entry[cal->N_free] = idx;
+    cal->N_free++;
+}
+uint32 LTE_fdd_enb_mac::sched_cal_take(LTE_FDD_ENB_SCHED_CALENDAR_STRUCT *cal,
+                                       uint32                             current_tti,
+                                       uint32                            *entries)
+{
+    LTE_FDD_ENB_SCHED_BUCKET_STRUCT *bucket    = &cal->bucket[current_tti % LTE_FDD_ENB_MAC_SCHED_N_TTIS];
+    uint32                           N_entries = bucket->N_entries;
+
+    memcpy(entries, bucket->entry, sizeof(uint32)*N_entries);
+    bucket->N_entries = 0;
+
+    return(N_entries);
+}
+uint32 LTE_fdd_enb_mac::sched_cal_defer(LTE_FDD_ENB_SCHED_CALENDAR_STRUCT *cal,
+                                        uint32                             current_tti,
+                                        uint32                            *entries,
+                                        uint32                             N_entries)
+{
+    LTE_FDD_ENB_SCHED_BUCKET_STRUCT *bucket    = &cal->bucket[current_tti % LTE_FDD_ENB_MAC_SCHED_N_TTIS];
+    uint32                           N_dropped = 0;
+
+    // Deferred entries are older, so they go ahead of the bucket's own
+    // entries and the newest entries are dropped if the bucket overflows
+    while(LTE_FDD_ENB_MAC_SCHED_BUCKET_SIZE < (bucket->N_entries + N_entries))
+    {
+        bucket->N_entries--;
+        sched_cal_free(cal, bucket->entry[bucket->N_entries]);
+        N_dropped++;
+    }
+    memmove(&bucket->entry[N_entries], &bucket->entry[0], sizeof(uint32)*bucket->N_entries);
+    memcpy(&bucket->entry[0], entries, sizeof(uint32)*N_entries);
+    bucket->N_entries += N_entries;
+
+    return(N_dropped);
+}
+
+/***************************/
+/*    Scheduling Policy    */
+/***************************/
+float LTE_fdd_enb_mac::get_dl_sched_metric(uint16 rnti,
+                                           uint32 current_tti)
+{
+    LTE_fdd_enb_user_mgr *user_mgr = LTE_fdd_enb_user_mgr::get_instance();
+    LTE_fdd_enb_user     *user;
+    float                 metric   = LTE_FDD_ENB_MAC_MAX_SCHED_METRIC;
+
+    // Allocations without a user (i.e. contention resolution on a temporary
+    // C-RNTI) keep the highest priority
+    if(LTE_FDD_ENB_ERROR_NONE == user_mgr->find_user(rnti, &user))
+    {
+        metric = get_dl_sched_policy()->get_metric(user, current_tti, sys_info.N_rb_dl * LTE_FDD_ENB_MAC_N_RE_PER_PRB);
+    }
+
+    return(metric);
+}
+LTE_fdd_enb_dl_sched_policy* LTE_fdd_enb_mac::get_dl_sched_policy(void)
+{
+    LTE_fdd_enb_dl_sched_policy *policy = dl_sched_policy[LTE_FDD_ENB_DL_SCHED_POLICY_PROPORTIONAL_FAIR];
+
+    if(LTE_FDD_ENB_DL_SCHED_POLICY_N_ITEMS > sys_info.dl_sched_policy)
+    {
+        policy = dl_sched_policy[sys_info.dl_sched_policy];
+    }
+
+    return(policy);
+}
+uint8 LTE_fdd_enb_mac::get_dl_cqi_estimate(float sinr_db)
+{
+    uint8 cqi = 15;
+
+    while(0 < cqi &&
+          LTE_fdd_enb_mac_cqi_sinr_db[cqi] > sinr_db)
+    {
+        cqi--;
+    }
+
+    return(cqi);
+}
+void LTE_fdd_enb_mac::sort_sched_candidates(LTE_FDD_ENB_SCHED_CANDIDATE_STRUCT *candidates,
+                                            uint32                              N_candidates)
+{
+    LTE_FDD_ENB_SCHED_CANDIDATE_STRUCT tmp;
+    uint32                             i;
+    uint32                             j;
+
+    // Stable insertion sort, highest metric first, so entries with equal
+    // metrics (i.e. the same RNTI) keep their queue order
+    for(i=1; i<N_candidates; i++)
+    {
+        tmp = candidates[i];
+        for(j=i; j>0 && candidates[j-1].metric < tmp.metric; j--)
+        {
+            candidates[j] = candidates[j-1];
+        }
+        candidates[j] = tmp;
+    }
+}
+
+bool LTE_fdd_enb_mac::get_ul_grant_size(uint32  N_bits,
+                                        uint32  N_avail_prbs,
+                                        uint32 *tbs,
+                                        uint8  *mcs,
+                                        uint32 *N_prb)
+{
+    uint32 N_rb  = N_avail_prbs;
+    bool   found = false;
+    bool   done  = false;
+
+    if(sys_info.N_rb_ul < N_rb)
+    {
+        N_rb = sys_info.N_rb_ul;
+    }
+    if(LTE_FDD_ENB_MAC_UL_MIN_GRANT_BITS > N_bits)
+    {
+        N_bits = LTE_FDD_ENB_MAC_UL_MIN_GRANT_BITS;
+    }
+
+    // Shrink the request until it fits in the available PRBs at a QPSK MCS,
+    // the UE sends the rest once it gets the next grant
+    while(!found && !done)
+    {
+        if(LIBLTE_SUCCESS             == liblte_phy_get_tbs_mcs_and_n_prb_for_ul(N_bits, N_rb, tbs, mcs, N_prb) &&
+           LTE_FDD_ENB_MAC_UL_MAX_MCS >= *mcs)
+        {
+            found = true;
+        }else if(LTE_FDD_ENB_MAC_UL_MIN_GRANT_BITS == N_bits){
+            done = true;
+        }else{
+            N_bits /= 2;
+            if(LTE_FDD_ENB_MAC_UL_MIN_GRANT_BITS > N_bits)
+            {
+                N_bits = LTE_FDD_ENB_MAC_UL_MIN_GRANT_BITS;
+            }
+        }
+    }
+
+    return(found);
+}
+
+/********************/
+/*    PRB Bitmap    */
+/********************/
+void LTE_fdd_enb_mac::prb_map_set(uint32 *prb_map,
+                                  uint32  start,
+                                  uint32  N_prb)
+{
+    uint32 i;
+
+    for(i=start; i<(start + N_prb) && i<(LTE_FDD_ENB_MAC_PRB_MAP_N_WORDS*32); i++)
+    {
+        prb_map[i/32] |= 1 << (i%32);
+    }
+}
+bool LTE_fdd_enb_mac::prb_map_find(uint32 *prb_map,
+                                   uint32  N_rb,
+                                   uint32  N_prb,
+                                   uint32 *start)
+{
+    uint32 i;
+    uint32 run = 0;
+    bool   found = false;
+
+    // First fit search for a contiguous run of free PRBs, DCI 1A only
+    // supports localized type 2 allocations
+    if(0 != N_prb)
+    {
+        for(i=0; i<N_rb && !found; i++)
+        {
+            if(0 == (prb_map[i/32] & (1 << (i%32))))
+            {
+                run++;
+                if(run == N_prb)
+                {
+                    *start = i + 1 - N_prb;
+                    found  = true;
+                }
+            }else{
+                run = 0;
+            }
+        }
+    }
+
+    return(found);
+}
 
 /*****************/
 /*    Helpers    */
@@ -1267,7 +2098,8 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_mac::add_to_ul_sched_queue(uint32
 uint32 LTE_fdd_enb_mac::get_n_reserved_prbs(uint32 current_tti)
 {
     uint32 N_reserved_prbs = 0;
-    uint32 i;
+    uint32 N_sys_prbs;
+    uint32 N_sys_dcis;
 
     // Reserve PRBs for the MIB
     if(0 == (current_tti % 10))
@@ -1275,23 +2107,27 @@ uint32 LTE_fdd_enb_mac::get_n_reserved_prbs(uint32 current_tti)
         N_reserved_prbs += 6;
     }
 
-    // Reserve PRBs for SIB1
-    if(5 == (current_tti % 10) &&
-       0 == ((current_tti / 10) % 2))
-    {
-        N_reserved_prbs += sys_info.sib1_alloc.N_prb;
-    }
+    // Reserve PRBs for SIB1 and all other SIBs
+    get_sys_info_resources(current_tti, &N_sys_prbs, &N_sys_dcis);
+    N_reserved_prbs += N_sys_prbs;
 
-    // Reserve PRBs for all other SIBs
-    for(i=0; i<sys_info.sib1.N_sched_info; i++)
+    return(N_reserved_prbs);
+}
+void LTE_fdd_enb_mac::get_sys_info_resources(uint32  current_tti,
+                                             uint32 *N_prbs,
+                                             uint32 *N_dcis)
+{
+    LTE_FDD_ENB_SI_ALLOC_STRUCT si_alloc[LTE_FDD_ENB_CNFG_DB_MAX_SI_ALLOCS];
+    uint32                      i;
+
+    // Same placement as the PHY uses to send the system information
+    *N_prbs = 0;
+    *N_dcis = LTE_fdd_enb_cnfg_db::get_sys_info_allocs(&sys_info,
+                                                       current_tti/10,
+                                                       current_tti%10,
+                                                       si_alloc);
+    for(i=0; i<*N_dcis; i++)
     {
-        if(0                             != sys_info.sib_alloc[i].msg.N_bits &&
-           (i * sys_info.si_win_len)%10  == (current_tti % 10)               &&
-           ((i * sys_info.si_win_len)/10 == ((current_tti / 10) % sys_info.si_periodicity_T)))
-        {
-            N_reserved_prbs += sys_info.sib_alloc[i].N_prb;
-        }
+        *N_prbs += si_alloc[i].N_prb;
     }
-
-    return(N_reserved_prbs);
 }
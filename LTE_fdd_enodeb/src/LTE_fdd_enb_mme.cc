@@ -28,6 +28,8 @@
     11/10/2013    Ben Wojtowicz    Created file
     01/18/2014    Ben Wojtowicz    Added level to debug prints.
     06/15/2014    Ben Wojtowicz    Added RRC NAS message handler.
+    10/19/2026    agent            Only copying the system information when
+                                   its version changes.
 
 *******************************************************************************/
 
@@ -90,7 +92,8 @@ void LTE_fdd_enb_mme::cleanup(void)
 /********************************/
 LTE_fdd_enb_mme::LTE_fdd_enb_mme()
 {
-    started = false;
+    started          = false;
+    sys_info_version = 0;
 }
 LTE_fdd_enb_mme::~LTE_fdd_enb_mme()
 {
@@ -157,9 +160,12 @@ void LTE_fdd_enb_mme::update_sys_info(void)
 {
     LTE_fdd_enb_cnfg_db *cnfg_db = LTE_fdd_enb_cnfg_db::get_instance();
 
-    sys_info_mutex.lock();
-    cnfg_db->get_sys_info(sys_info);
-    sys_info_mutex.unlock();
+    if(sys_info_version != cnfg_db->get_sys_info_version())
+    {
+        sys_info_mutex.lock();
+        sys_info_version = cnfg_db->get_sys_info(sys_info);
+        sys_info_mutex.unlock();
+    }
 }
 
 /******************************/
@@ -38,6 +38,7 @@
 
 #include "LTE_fdd_enb_interface.h"
 #include "LTE_fdd_enb_msgq.h"
+#include "LTE_fdd_enb_epoch_mgr.h"
 
 /*******************************************************************************
                               DEFINES
@@ -132,7 +133,8 @@ void LTE_fdd_enb_msgq::send(boost::interprocess::message_queue *mq,
                             LTE_FDD_ENB_MESSAGE_UNION          *msg_content,
                             uint32                              msg_content_size)
 {
-    LTE_FDD_ENB_MESSAGE_STRUCT *msg = NULL;
+    LTE_fdd_enb_epoch_mgr      *epoch_mgr = LTE_fdd_enb_epoch_mgr::get_instance();
+    LTE_FDD_ENB_MESSAGE_STRUCT *msg       = NULL;
 
     msg = new LTE_FDD_ENB_MESSAGE_STRUCT;
 
@@ -142,15 +144,29 @@ void LTE_fdd_enb_msgq::send(boost::interprocess::message_queue *mq,
     {
         memcpy(&msg->msg, msg_content, msg_content_size);
     }
+    msg->epoch = epoch_mgr->pin();
+
+    mq->send(&msg, sizeof(msg), 0);
+}
+void LTE_fdd_enb_msgq::forward(boost::interprocess::message_queue *mq,
+                               LTE_FDD_ENB_MESSAGE_STRUCT         *msg)
+{
+    LTE_fdd_enb_epoch_mgr *epoch_mgr = LTE_fdd_enb_epoch_mgr::get_instance();
+
+    // Only called while handling the message, the new pin inherits the
+    // current one which is released once the handler returns
+    msg->epoch = epoch_mgr->pin();
 
     mq->send(&msg, sizeof(msg), 0);
 }
 void* LTE_fdd_enb_msgq::receive_thread(void *inputs)
 {
-    LTE_fdd_enb_msgq           *msgq = (LTE_fdd_enb_msgq *)inputs;
-    LTE_FDD_ENB_MESSAGE_STRUCT *msg  = NULL;
+    LTE_fdd_enb_epoch_mgr      *epoch_mgr = LTE_fdd_enb_epoch_mgr::get_instance();
+    LTE_fdd_enb_msgq           *msgq      = (LTE_fdd_enb_msgq *)inputs;
+    LTE_FDD_ENB_MESSAGE_STRUCT *msg       = NULL;
     struct sched_param          priority;
     std::size_t                 rx_size;
+    uint64                      epoch;
     uint32                      prio;
     bool                        not_done = true;
 
@@ -174,6 +190,9 @@ void* LTE_fdd_enb_msgq::receive_thread(void *inputs)
         // Process message
         if(sizeof(msg) == rx_size)
         {
+            // The callback deletes or forwards the message, so its pin is
+            // saved first and released once the callback returns
+            epoch = msg->epoch;
             switch(msg->type)
             {
             case LTE_FDD_ENB_MESSAGE_TYPE_KILL:
@@ -181,9 +200,12 @@ void* LTE_fdd_enb_msgq::receive_thread(void *inputs)
                 delete msg;
                 break;
             default:
+                epoch_mgr->set_thread_pin(epoch);
                 msgq->callback(msg);
+                epoch_mgr->clear_thread_pin();
                 break;
             }
+            epoch_mgr->unpin(epoch);
         }else{
             // FIXME: Use print_debug_msg
             printf("ERROR %s Invalid message size received: %u\n",
@@ -0,0 +1,779 @@
+#line 2 "LTE_fdd_enb_pcap.cc" // Make __FILE__ omit the path
+/*******************************************************************************
+
+    Copyright 2026 agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: LTE_fdd_enb_pcap.cc
+
+    Description: Contains all the implementations for the LTE FDD eNodeB
+                 PCAP capture.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    agent            Created file
+
+*******************************************************************************/
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "LTE_fdd_enb_pcap.h"
+#include "LTE_fdd_enb_cnfg_db.h"
+#include "LTE_fdd_enb_phy.h"
+#include "liblte_mac.h"
+#include <boost/lexical_cast.hpp>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include <stdio.h>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+#define LTE_FDD_ENB_PCAP_N_TTIS (LTE_FDD_ENB_CURRENT_TTI_MAX + 1)
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              GLOBAL VARIABLES
+*******************************************************************************/
+
+LTE_fdd_enb_pcap* LTE_fdd_enb_pcap::instance = NULL;
+boost::mutex      pcap_instance_mutex;
+
+/*******************************************************************************
+                              CLASS IMPLEMENTATIONS
+*******************************************************************************/
+
+/*******************/
+/*    Singleton    */
+/*******************/
+LTE_fdd_enb_pcap* LTE_fdd_enb_pcap::get_instance(void)
+{
+    boost::mutex::scoped_lock lock(pcap_instance_mutex);
+
+    if(NULL == instance)
+    {
+        instance = new LTE_fdd_enb_pcap();
+    }
+
+    return(instance);
+}
+void LTE_fdd_enb_pcap::cleanup(void)
+{
+    boost::mutex::scoped_lock lock(pcap_instance_mutex);
+
+    if(NULL != instance)
+    {
+        delete instance;
+        instance = NULL;
+    }
+}
+
+/********************************/
+/*    Constructor/Destructor    */
+/********************************/
+LTE_fdd_enb_pcap::LTE_fdd_enb_pcap()
+{
+    uint32 i;
+
+    // Producer queue
+    queue = new LTE_FDD_ENB_PCAP_SLOT_STRUCT[LTE_FDD_ENB_PCAP_QUEUE_SIZE];
+    for(i=0; i<LTE_FDD_ENB_PCAP_QUEUE_SIZE; i++)
+    {
+        queue[i].seq = i;
+    }
+    enqueue_pos = 0;
+    dequeue_pos = 0;
+    enabled     = false;
+
+    // Configuration
+    file_name     = LTE_FDD_ENB_PCAP_DEFAULT_FILE;
+    format        = LTE_FDD_ENB_PCAP_FORMAT_PCAP;
+    max_file_size = 0;
+    max_file_secs = 0;
+    max_files     = 0;
+    ring_secs     = 0;
+    reopen        = false;
+
+    // Ring capture
+    N_dumps = 0;
+
+    // Statistics
+    memset(&stats, 0, sizeof(stats));
+
+    // Writer thread
+    interface     = NULL;
+    fd            = -1;
+    file_bytes    = 0;
+    file_open_ns  = 0;
+    last_flush_ns = 0;
+    file_idx      = 0;
+    file_format   = format;
+    anchor_ns     = 0;
+    anchor_tti    = 0;
+    anchor_valid  = false;
+    batch.reserve(LTE_FDD_ENB_PCAP_BATCH_SIZE*2);
+    writer_thread_stop = false;
+    pthread_create(&writer_thread, NULL, &writer_thread_func, this);
+}
+LTE_fdd_enb_pcap::~LTE_fdd_enb_pcap()
+{
+    writer_thread_stop = true;
+    pthread_join(writer_thread, NULL);
+
+    delete [] queue;
+}
+
+/*****************/
+/*    Capture    */
+/*****************/
+void LTE_fdd_enb_pcap::send(LTE_FDD_ENB_PCAP_DIRECTION_ENUM  dir,
+                            uint32                           rnti,
+                            uint32                           current_tti,
+                            uint8                           *msg,
+                            uint32                           N_bits)
+{
+    LTE_FDD_ENB_PCAP_SLOT_STRUCT *slot = NULL;
+    struct timespec               now;
+    uint64                        pos;
+    int64                         dif;
+    uint32                        N_bytes;
+    uint32                        i;
+    bool                          done = false;
+
+    if(enabled)
+    {
+        // Claim a slot, dropping the message if the writer is a full queue behind
+        pos = enqueue_pos;
+        while(!done)
+        {
+            slot = &queue[pos & (LTE_FDD_ENB_PCAP_QUEUE_SIZE-1)];
+            dif  = (int64)slot->seq - (int64)pos;
+            if(0 == dif)
+            {
+                if(__sync_bool_compare_and_swap(&enqueue_pos, pos, pos+1))
+                {
+                    done = true;
+                }else{
+                    pos = enqueue_pos;
+                }
+            }else if(0 > dif){
+                slot = NULL;
+                done = true;
+            }else{
+                pos = enqueue_pos;
+            }
+        }
+
+        if(NULL != slot)
+        {
+            clock_gettime(CLOCK_REALTIME, &now);
+            N_bytes = (N_bits + 7)/8;
+            if(N_bytes > LTE_FDD_ENB_PCAP_MAX_PAYLOAD_SIZE)
+            {
+                N_bytes = LTE_FDD_ENB_PCAP_MAX_PAYLOAD_SIZE;
+                N_bits  = N_bytes*8;
+            }
+            slot->record.time_ns     = (uint64)now.tv_sec*1000000000 + now.tv_nsec;
+            slot->record.rnti        = rnti;
+            slot->record.current_tti = current_tti;
+            slot->record.N_bytes     = N_bytes;
+            slot->record.dir         = dir;
+            memset(slot->record.payload, 0, N_bytes);
+            for(i=0; i<N_bits; i++)
+            {
+                slot->record.payload[i/8] |= (msg[i] & 1) << (7 - (i % 8));
+            }
+
+            // Publish the record to the writer
+            __sync_synchronize();
+            slot->seq = pos + 1;
+        }else{
+            __sync_fetch_and_add(&stats.N_dropped, 1);
+        }
+    }
+}
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_pcap::dump_ring(std::string *dump_file_name)
+{
+    boost::mutex::scoped_lock                                c_lock(cnfg_mutex);
+    std::deque<LTE_FDD_ENB_PCAP_RING_ENTRY_STRUCT>::iterator iter;
+    LTE_FDD_ENB_ERROR_ENUM                                   err = LTE_FDD_ENB_ERROR_NONE;
+    std::string                                              buf;
+    int32                                                    dump_fd;
+
+    *dump_file_name  = file_name;
+    *dump_file_name += ".dump.";
+    *dump_file_name += boost::lexical_cast<std::string>(N_dumps++);
+
+    // Copy the window out so the writer is only held off for the copy
+    encode_file_header(&buf, format);
+    ring_mutex.lock();
+    for(iter=ring.begin(); iter!=ring.end(); iter++)
+    {
+        encode_packet(&buf, format, (*iter).time_ns, (uint8 *)(*iter).packet.c_str(), (*iter).packet.size());
+    }
+    ring_mutex.unlock();
+    c_lock.unlock();
+
+    dump_fd = open(dump_file_name->c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if(0 <= dump_fd)
+    {
+        if((ssize_t)buf.size() != write(dump_fd, buf.c_str(), buf.size()))
+        {
+            err = LTE_FDD_ENB_ERROR_CANT_OPEN_FILE;
+        }
+        close(dump_fd);
+    }else{
+        err = LTE_FDD_ENB_ERROR_CANT_OPEN_FILE;
+    }
+
+    return(err);
+}
+
+/****************************/
+/*    External Interface    */
+/****************************/
+void LTE_fdd_enb_pcap::set_enable(bool enable)
+{
+    enabled = enable;
+}
+std::string LTE_fdd_enb_pcap::get_file(void)
+{
+    boost::mutex::scoped_lock lock(cnfg_mutex);
+    return(file_name);
+}
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_pcap::set_file(std::string new_file_name)
+{
+    boost::mutex::scoped_lock lock(cnfg_mutex);
+
+    file_name = new_file_name;
+    file_idx  = 0;
+    reopen    = true;
+
+    return(LTE_FDD_ENB_ERROR_NONE);
+}
+LTE_FDD_ENB_PCAP_FORMAT_ENUM LTE_fdd_enb_pcap::get_format(void)
+{
+    boost::mutex::scoped_lock lock(cnfg_mutex);
+    return(format);
+}
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_pcap::set_format(std::string new_format)
+{
+    boost::mutex::scoped_lock lock(cnfg_mutex);
+    LTE_FDD_ENB_ERROR_ENUM    err = LTE_FDD_ENB_ERROR_INVALID_PARAM;
+    uint32                    i;
+
+    for(i=0; i<LTE_FDD_ENB_PCAP_FORMAT_N_ITEMS; i++)
+    {
+        if(new_format == LTE_fdd_enb_pcap_format_text[i])
+        {
+            format = (LTE_FDD_ENB_PCAP_FORMAT_ENUM)i;
+            reopen = true;
+            err    = LTE_FDD_ENB_ERROR_NONE;
+        }
+    }
+
+    return(err);
+}
+uint32 LTE_fdd_enb_pcap::get_max_file_size(void)
+{
+    boost::mutex::scoped_lock lock(cnfg_mutex);
+    return(max_file_size);
+}
+void LTE_fdd_enb_pcap::set_max_file_size(uint32 size)
+{
+    boost::mutex::scoped_lock lock(cnfg_mutex);
+    max_file_size = size;
+}
+uint32 LTE_fdd_enb_pcap::get_max_file_secs(void)
+{
+    boost::mutex::scoped_lock lock(cnfg_mutex);
+    return(max_file_secs);
+}
+void LTE_fdd_enb_pcap::set_max_file_secs(uint32 secs)
+{
+    boost::mutex::scoped_lock lock(cnfg_mutex);
+    max_file_secs = secs;
+}
+uint32 LTE_fdd_enb_pcap::get_max_files(void)
+{
+    boost::mutex::scoped_lock lock(cnfg_mutex);
+    return(max_files);
+}
+void LTE_fdd_enb_pcap::set_max_files(uint32 N_files)
+{
+    boost::mutex::scoped_lock lock(cnfg_mutex);
+    max_files = N_files;
+}
+uint32 LTE_fdd_enb_pcap::get_ring_secs(void)
+{
+    boost::mutex::scoped_lock lock(cnfg_mutex);
+    return(ring_secs);
+}
+void LTE_fdd_enb_pcap::set_ring_secs(uint32 secs)
+{
+    boost::mutex::scoped_lock lock(cnfg_mutex);
+
+    // Switching between file and ring capture closes the current file
+    ring_secs = secs;
+    reopen    = true;
+}
+std::string LTE_fdd_enb_pcap::get_stats(void)
+{
+    boost::mutex::scoped_lock lock(ring_mutex);
+    char                      stats_str[256];
+
+    snprintf(stats_str,
+             sizeof(stats_str),
+             "enabled=%u records=%llu bytes=%llu dropped=%u files=%u write_errors=%u ring_records=%u",
+             enabled,
+             stats.N_records,
+             stats.N_bytes,
+             stats.N_dropped,
+             stats.N_files,
+             stats.N_write_errors,
+             (uint32)ring.size());
+
+    return(stats_str);
+}
+
+/***********************/
+/*    Writer Thread    */
+/***********************/
+void* LTE_fdd_enb_pcap::writer_thread_func(void *inputs)
+{
+    LTE_fdd_enb_pcap *pcap = (LTE_fdd_enb_pcap *)inputs;
+
+    // Only safe to get the interface here, it constructs this class
+    pcap->interface = LTE_fdd_enb_interface::get_instance();
+
+    while(!pcap->writer_thread_stop)
+    {
+        if(!pcap->drain_queue())
+        {
+            usleep(LTE_FDD_ENB_PCAP_IDLE_SLEEP_US);
+        }
+        pcap->check_rotation();
+    }
+
+    // Write out anything queued while stopping
+    pcap->drain_queue();
+    pcap->close_file();
+
+    return(NULL);
+}
+bool LTE_fdd_enb_pcap::drain_queue(void)
+{
+    LTE_FDD_ENB_PCAP_SLOT_STRUCT       *slot;
+    LTE_FDD_ENB_PCAP_RING_ENTRY_STRUCT  entry;
+    uint64                              time_ns;
+    uint32                              N_bytes;
+    uint32                              cur_ring_secs;
+    uint8                               packet[LTE_FDD_ENB_PCAP_CONTEXT_SIZE + LTE_FDD_ENB_PCAP_MAX_PAYLOAD_SIZE];
+    bool                                drained = false;
+    bool                                done    = false;
+
+    // The file state is only touched by this thread, only the configuration
+    // needs the lock and it isn't held across file I/O
+    cnfg_mutex.lock();
+    cur_ring_secs = ring_secs;
+    cnfg_mutex.unlock();
+
+    while(!done)
+    {
+        slot = &queue[dequeue_pos & (LTE_FDD_ENB_PCAP_QUEUE_SIZE-1)];
+        if((dequeue_pos + 1) == slot->seq)
+        {
+            __sync_synchronize();
+            time_ns = get_tti_time(&slot->record);
+            N_bytes = build_packet(&slot->record, packet);
+            __sync_synchronize();
+            slot->seq = dequeue_pos + LTE_FDD_ENB_PCAP_QUEUE_SIZE;
+            dequeue_pos++;
+
+            if(0 != cur_ring_secs)
+            {
+                entry.packet.assign((char *)packet, N_bytes);
+                entry.time_ns = time_ns;
+                ring_mutex.lock();
+                ring.push_back(entry);
+                stats.N_records++;
+                ring_mutex.unlock();
+            }else{
+                if(0 > fd)
+                {
+                    open_file();
+                }
+                if(0 <= fd)
+                {
+                    encode_packet(&batch, file_format, time_ns, packet, N_bytes);
+                    stats.N_records++;
+                    if(LTE_FDD_ENB_PCAP_BATCH_SIZE <= batch.size())
+                    {
+                        flush_batch();
+                    }
+                }
+            }
+            drained = true;
+        }else{
+            done = true;
+        }
+    }
+
+    return(drained);
+}
+uint64 LTE_fdd_enb_pcap::get_tti_time(LTE_FDD_ENB_PCAP_RECORD_STRUCT *record)
+{
+    int32 tti_diff = 0;
+
+    // Time stamps advance in whole TTIs from a wall clock anchor, UL
+    // messages arrive a few TTIs late so the difference is signed
+    if(anchor_valid)
+    {
+        tti_diff = (int32)record->current_tti - (int32)anchor_tti;
+        if(tti_diff > LTE_FDD_ENB_PCAP_N_TTIS/2)
+        {
+            tti_diff -= LTE_FDD_ENB_PCAP_N_TTIS;
+        }else if(tti_diff <= -LTE_FDD_ENB_PCAP_N_TTIS/2){
+            tti_diff += LTE_FDD_ENB_PCAP_N_TTIS;
+        }
+    }
+
+    // Re-anchor periodically so the TTI and wall clocks do not drift apart
+    if(!anchor_valid                                   ||
+       LTE_FDD_ENB_PCAP_REANCHOR_TTIS <= tti_diff      ||
+       -LTE_FDD_ENB_PCAP_REANCHOR_TTIS >= tti_diff)
+    {
+        anchor_ns    = record->time_ns;
+        anchor_tti   = record->current_tti;
+        anchor_valid = true;
+        tti_diff     = 0;
+    }
+
+    return(anchor_ns + (int64)tti_diff*1000000);
+}
+uint32 LTE_fdd_enb_pcap::build_packet(LTE_FDD_ENB_PCAP_RECORD_STRUCT *record,
+                                      uint8                          *packet)
+{
+    uint16 tmp;
+
+    // Radio Type
+    packet[0] = 1;
+
+    // Direction
+    packet[1] = record->dir;
+
+    // RNTI Type
+    if(0xFFFFFFFF == record->rnti)
+    {
+        packet[2] = 0;
+    }else if(LIBLTE_MAC_P_RNTI == record->rnti){
+        packet[2] = 1;
+    }else if(LIBLTE_MAC_RA_RNTI_START <= record->rnti &&
+             LIBLTE_MAC_RA_RNTI_END   >= record->rnti){
+        packet[2] = 2;
+    }else if(LIBLTE_MAC_SI_RNTI == record->rnti){
+        packet[2] = 4;
+    }else if(LIBLTE_MAC_M_RNTI == record->rnti){
+        packet[2] = 6;
+    }else{
+        packet[2] = 3;
+    }
+
+    // RNTI Tag and RNTI
+    packet[3] = 2;
+    tmp       = htons((uint16)record->rnti);
+    memcpy(&packet[4], &tmp, sizeof(uint16));
+
+    // UEID Tag and UEID
+    packet[6] = 3;
+    packet[7] = 0;
+    packet[8] = 0;
+
+    // SUBFN Tag and SUBFN
+    packet[9] = 4;
+    tmp       = htons((uint16)(record->current_tti%10));
+    memcpy(&packet[10], &tmp, sizeof(uint16));
+
+    // CRC Status Tag and CRC Status
+    packet[12] = 7;
+    packet[13] = 1;
+
+    // Payload Tag and Payload
+    packet[14] = 1;
+    memcpy(&packet[LTE_FDD_ENB_PCAP_CONTEXT_SIZE], record->payload, record->N_bytes);
+
+    return(LTE_FDD_ENB_PCAP_CONTEXT_SIZE + record->N_bytes);
+}
+void LTE_fdd_enb_pcap::encode_file_header(std::string                  *buf,
+                                          LTE_FDD_ENB_PCAP_FORMAT_ENUM  fmt)
+{
+    uint32 magic_number  = 0xa1b2c3d4;
+    uint32 timezone      = 0;
+    uint32 sigfigs       = 0;
+    uint32 snap_len      = (LIBLTE_MAX_MSG_SIZE/4);
+    uint32 dlt           = LTE_FDD_ENB_PCAP_DLT_MAC_LTE;
+    uint32 block_type;
+    uint32 block_len;
+    uint32 bom           = 0x1a2b3c4d;
+    int64  section_len   = -1;
+    uint16 major_version = 2;
+    uint16 minor_version = 4;
+    uint16 link_type     = LTE_FDD_ENB_PCAP_DLT_MAC_LTE;
+    uint16 reserved      = 0;
+    uint16 opt_code;
+    uint16 opt_len;
+    uint8  tsresol[4]    = {9, 0, 0, 0};
+
+    if(LTE_FDD_ENB_PCAP_FORMAT_PCAPNG == fmt)
+    {
+        // Section header block
+        block_type    = 0x0a0d0d0a;
+        block_len     = 28;
+        major_version = 1;
+        minor_version = 0;
+        buf->append((char *)&block_type,    sizeof(block_type));
+        buf->append((char *)&block_len,     sizeof(block_len));
+        buf->append((char *)&bom,           sizeof(bom));
+        buf->append((char *)&major_version, sizeof(major_version));
+        buf->append((char *)&minor_version, sizeof(minor_version));
+        buf->append((char *)&section_len,   sizeof(section_len));
+        buf->append((char *)&block_len,     sizeof(block_len));
+
+        // Interface description block with nanosecond time stamps
+        block_type = 1;
+        block_len  = 32;
+        buf->append((char *)&block_type, sizeof(block_type));
+        buf->append((char *)&block_len,  sizeof(block_len));
+        buf->append((char *)&link_type,  sizeof(link_type));
+        buf->append((char *)&reserved,   sizeof(reserved));
+        buf->append((char *)&snap_len,   sizeof(snap_len));
+        opt_code = 9; // if_tsresol
+        opt_len  = 1;
+        buf->append((char *)&opt_code, sizeof(opt_code));
+        buf->append((char *)&opt_len,  sizeof(opt_len));
+        buf->append((char *)tsresol,   sizeof(tsresol));
+        opt_code = 0; // opt_endofopt
+        opt_len  = 0;
+        buf->append((char *)&opt_code,  sizeof(opt_code));
+        buf->append((char *)&opt_len,   sizeof(opt_len));
+        buf->append((char *)&block_len, sizeof(block_len));
+    }else{
+        buf->append((char *)&magic_number,  sizeof(magic_number));
+        buf->append((char *)&major_version, sizeof(major_version));
+        buf->append((char *)&minor_version, sizeof(minor_version));
+        buf->append((char *)&timezone,      sizeof(timezone));
+        buf->append((char *)&sigfigs,       sizeof(sigfigs));
+        buf->append((char *)&snap_len,      sizeof(snap_len));
+        buf->append((char *)&dlt,           sizeof(dlt));
+    }
+}
+void LTE_fdd_enb_pcap::encode_packet(std::string                  *buf,
+                                     LTE_FDD_ENB_PCAP_FORMAT_ENUM  fmt,
+                                     uint64                        time_ns,
+                                     uint8                        *packet,
+                                     uint32                        N_bytes)
+{
+    uint32 block_type = 6;
+    uint32 block_len;
+    uint32 if_id      = 0;
+    uint32 ts_high    = (uint32)(time_ns >> 32);
+    uint32 ts_low     = (uint32)(time_ns & 0xFFFFFFFF);
+    uint32 ts_sec     = (uint32)(time_ns / 1000000000);
+    uint32 ts_usec    = (uint32)((time_ns % 1000000000) / 1000);
+    uint32 pad        = (4 - (N_bytes % 4)) % 4;
+    uint32 zero       = 0;
+
+    if(LTE_FDD_ENB_PCAP_FORMAT_PCAPNG == fmt)
+    {
+        // Enhanced packet block
+        block_len = 32 + N_bytes + pad;
+        buf->append((char *)&block_type, sizeof(block_type));
+        buf->append((char *)&block_len,  sizeof(block_len));
+        buf->append((char *)&if_id,      sizeof(if_id));
+        buf->append((char *)&ts_high,    sizeof(ts_high));
+        buf->append((char *)&ts_low,     sizeof(ts_low));
+        buf->append((char *)&N_bytes,    sizeof(N_bytes));
+        buf->append((char *)&N_bytes,    sizeof(N_bytes));
+        buf->append((char *)packet,      N_bytes);
+        buf->append((char *)&zero,       pad);
+        buf->append((char *)&block_len,  sizeof(block_len));
+    }else{
+        buf->append((char *)&ts_sec,  sizeof(ts_sec));
+        buf->append((char *)&ts_usec, sizeof(ts_usec));
+        buf->append((char *)&N_bytes, sizeof(N_bytes));
+        buf->append((char *)&N_bytes, sizeof(N_bytes));
+        buf->append((char *)packet,   N_bytes);
+    }
+}
+void LTE_fdd_enb_pcap::open_file(void)
+{
+    LTE_fdd_enb_cnfg_db          *cnfg_db = LTE_fdd_enb_cnfg_db::get_instance();
+    struct timespec               now;
+    std::string                   name;
+    std::string                   old_name;
+    LTE_FDD_ENB_PCAP_FORMAT_ENUM  cur_format;
+    bool                          rotate;
+    uint32                        cur_max_files;
+    uint32                        cur_file_idx;
+
+    cnfg_mutex.lock();
+    name          = file_name;
+    cur_format    = format;
+    rotate        = (0 != max_file_size || 0 != max_file_secs);
+    cur_max_files = max_files;
+    cur_file_idx  = file_idx;
+    cnfg_mutex.unlock();
+
+    // Rotated files get an index suffix and the oldest is removed past max_files
+    if(rotate)
+    {
+        old_name = name;
+        name    += "." + boost::lexical_cast<std::string>(cur_file_idx);
+        if(0             != cur_max_files &&
+           cur_max_files <= cur_file_idx)
+        {
+            old_name += "." + boost::lexical_cast<std::string>(cur_file_idx - cur_max_files);
+            unlink(old_name.c_str());
+        }
+    }
+
+    fd = open(name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if(0 <= fd)
+    {
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        file_format   = cur_format;
+        file_bytes    = 0;
+        file_open_ns  = (uint64)now.tv_sec*1000000000 + now.tv_nsec;
+        last_flush_ns = file_open_ns;
+        stats.N_files++;
+        batch.clear();
+        encode_file_header(&batch, file_format);
+    }else{
+        // Stop capturing rather than retrying the open for every message,
+        // through the configuration so enable_pcap reads back as off
+        cnfg_db->set_param(LTE_FDD_ENB_PARAM_ENABLE_PCAP, (int64)0);
+        stats.N_write_errors++;
+        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                                  LTE_FDD_ENB_DEBUG_LEVEL_IFACE,
+                                  __FILE__,
+                                  __LINE__,
+                                  "Unable to open %s, disabling PCAP capture",
+                                  name.c_str());
+    }
+}
+void LTE_fdd_enb_pcap::close_file(void)
+{
+    if(0 <= fd)
+    {
+        flush_batch();
+        close(fd);
+        fd = -1;
+    }
+}
+void LTE_fdd_enb_pcap::flush_batch(void)
+{
+    struct timespec now;
+    size_t          offset = 0;
+    ssize_t         N_written;
+    bool            error  = false;
+
+    if(0 <= fd)
+    {
+        while(offset < batch.size() && !error)
+        {
+            N_written = write(fd, batch.c_str() + offset, batch.size() - offset);
+            if(0 < N_written)
+            {
+                offset += N_written;
+            }else if(0 > N_written && EINTR == errno){
+                // Retry interrupted writes
+            }else{
+                stats.N_write_errors++;
+                error = true;
+            }
+        }
+        file_bytes    += offset;
+        stats.N_bytes += offset;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        last_flush_ns  = (uint64)now.tv_sec*1000000000 + now.tv_nsec;
+    }
+    batch.clear();
+}
+void LTE_fdd_enb_pcap::check_rotation(void)
+{
+    struct timespec now;
+    struct timespec wall;
+    uint64          now_ns;
+    uint32          cur_max_file_size;
+    uint32          cur_max_file_secs;
+    uint32          cur_ring_secs;
+    bool            cur_reopen;
+
+    cnfg_mutex.lock();
+    cur_max_file_size = max_file_size;
+    cur_max_file_secs = max_file_secs;
+    cur_ring_secs     = ring_secs;
+    cur_reopen        = reopen;
+    reopen            = false;
+    cnfg_mutex.unlock();
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    now_ns = (uint64)now.tv_sec*1000000000 + now.tv_nsec;
+
+    if(cur_reopen || !enabled)
+    {
+        close_file();
+    }else if(0 <= fd){
+        if((0 != cur_max_file_size && (uint64)cur_max_file_size*1024*1024 <= file_bytes + batch.size()) ||
+           (0 != cur_max_file_secs && (uint64)cur_max_file_secs*1000000000 <= now_ns - file_open_ns))
+        {
+            close_file();
+            cnfg_mutex.lock();
+            file_idx++;
+            cnfg_mutex.unlock();
+            open_file();
+        }else if(0                                 != batch.size() &&
+                 LTE_FDD_ENB_PCAP_FLUSH_PERIOD_NS <= now_ns - last_flush_ns){
+            flush_batch();
+        }
+    }
+
+    clock_gettime(CLOCK_REALTIME, &wall);
+    trim_ring((uint64)wall.tv_sec*1000000000 + wall.tv_nsec, cur_ring_secs);
+}
+void LTE_fdd_enb_pcap::trim_ring(uint64 now_ns,
+                                 uint32 window_secs)
+{
+    boost::mutex::scoped_lock lock(ring_mutex);
+    uint64                    window_ns = (uint64)window_secs*1000000000;
+
+    while(!ring.empty() &&
+          ring.front().time_ns + window_ns < now_ns)
+    {
+        ring.pop_front();
+    }
+}
@@ -29,6 +29,11 @@
     01/18/2014    Ben Wojtowicz    Added level to debug prints.
     05/04/2014    Ben Wojtowicz    Added communication to RLC and RRC.
     06/15/2014    Ben Wojtowicz    Added simple header parsing.
+    10/19/2026    agent            Added SRB/DRB data plane procedures with SN
+                                   windowing, a batched security callback, and
+                                   per bearer throughput counting.
+    10/19/2026    agent            Only copying the system information when
+                                   its version changes.
 
 *******************************************************************************/
 
@@ -61,6 +66,22 @@ boost::mutex      pdcp_instance_mutex;
                               CLASS IMPLEMENTATIONS
 *******************************************************************************/
 
+/******************/
+/*    Callback    */
+/******************/
+LTE_fdd_enb_pdcp_sec_cb::LTE_fdd_enb_pdcp_sec_cb()
+{
+}
+LTE_fdd_enb_pdcp_sec_cb::LTE_fdd_enb_pdcp_sec_cb(FuncType f, void* o)
+{
+    func = f;
+    obj  = o;
+}
+void LTE_fdd_enb_pdcp_sec_cb::operator()(LTE_FDD_ENB_PDCP_SEC_BATCH_STRUCT *batch)
+{
+    return (*func)(obj, batch);
+}
+
 /*******************/
 /*    Singleton    */
 /*******************/
@@ -91,7 +112,11 @@ void LTE_fdd_enb_pdcp::cleanup(void)
 /********************************/
 LTE_fdd_enb_pdcp::LTE_fdd_enb_pdcp()
 {
-    started = false;
+    LTE_fdd_enb_pdcp_sec_cb null_sec_cb(&LTE_fdd_enb_pdcp_sec_cb_wrapper<LTE_fdd_enb_pdcp, &LTE_fdd_enb_pdcp::handle_null_security>, this);
+
+    started          = false;
+    sys_info_version = 0;
+    sec_cb           = null_sec_cb;
 }
 LTE_fdd_enb_pdcp::~LTE_fdd_enb_pdcp()
 {
@@ -160,7 +185,7 @@ void LTE_fdd_enb_pdcp::handle_rlc_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg)
         }
     }else{
         // Forward message to RRC
-        pdcp_rrc_mq->send(&msg, sizeof(msg), 0);
+        LTE_fdd_enb_msgq::forward(pdcp_rrc_mq, msg);
     }
 }
 void LTE_fdd_enb_pdcp::handle_rrc_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg)
@@ -188,7 +213,7 @@ void LTE_fdd_enb_pdcp::handle_rrc_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg)
         }
     }else{
         // Forward message to RLC
-        pdcp_rlc_mq->send(&msg, sizeof(msg), 0);
+        LTE_fdd_enb_msgq::forward(pdcp_rlc_mq, msg);
     }
 }
 
@@ -199,9 +224,61 @@ void LTE_fdd_enb_pdcp::update_sys_info(void)
 {
     LTE_fdd_enb_cnfg_db *cnfg_db = LTE_fdd_enb_cnfg_db::get_instance();
 
-    sys_info_mutex.lock();
-    cnfg_db->get_sys_info(sys_info);
-    sys_info_mutex.unlock();
+    if(sys_info_version != cnfg_db->get_sys_info_version())
+    {
+        sys_info_mutex.lock();
+        sys_info_version = cnfg_db->get_sys_info(sys_info);
+        sys_info_mutex.unlock();
+    }
+}
+void LTE_fdd_enb_pdcp::set_security_cb(LTE_fdd_enb_pdcp_sec_cb cb)
+{
+    boost::mutex::scoped_lock lock(sec_mutex);
+
+    sec_cb = cb;
+}
+void LTE_fdd_enb_pdcp::handle_t_reordering_expiry(LTE_fdd_enb_user *user,
+                                                  LTE_fdd_enb_rb   *rb,
+                                                  uint32            timer_id)
+{
+    boost::mutex::scoped_lock  lock(rx_mutex);
+    LTE_fdd_enb_interface     *interface = LTE_fdd_enb_interface::get_instance();
+    uint32                     modulus   = rb->get_pdcp_max_sn() + 1;
+    uint16                     sn;
+
+    if(rb->pdcp_t_reordering_expired(timer_id))
+    {
+        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                                  LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
+                                  __FILE__,
+                                  __LINE__,
+                                  "t-Reordering expired for RNTI=%u, RB=%s, and Reordering_PDCP_RX_SN=%u",
+                                  user->get_c_rnti(),
+                                  LTE_fdd_enb_rb_text[rb->get_rb_id()],
+                                  rb->get_pdcp_reordering_rx_sn());
+
+        // 36.323 v12.0.0 Section 5.1.2.1.4, give up on the gaps and deliver
+        // everything stored below Reordering_PDCP_RX_SN followed by all
+        // consecutive SDUs from there
+        sn = (rb->get_pdcp_last_submitted_rx_sn() + 1) % modulus;
+        while(sn != rb->get_pdcp_reordering_rx_sn())
+        {
+            if(LTE_FDD_ENB_ERROR_NONE == rb->pdcp_get_from_reordering_buffer(sn, &rx_sdu))
+            {
+                rx_deliver(&rx_sdu, user, rb);
+                rb->set_pdcp_last_submitted_rx_sn(sn);
+            }
+            sn = (sn + 1) % modulus;
+        }
+        rx_deliver_consecutive(sn, user, rb);
+
+        // Wait for the next gap
+        if(0 != rb->get_pdcp_n_reordering_sdus())
+        {
+            rb->set_pdcp_reordering_rx_sn(rb->get_pdcp_next_rx_sn());
+            rb->pdcp_start_t_reordering();
+        }
+    }
 }
 
 /******************************/
@@ -209,11 +286,63 @@ void LTE_fdd_enb_pdcp::update_sys_info(void)
 /******************************/
 void LTE_fdd_enb_pdcp::handle_pdu_ready(LTE_FDD_ENB_PDCP_PDU_READY_MSG_STRUCT *pdu_ready)
 {
-    LTE_fdd_enb_interface                *interface = LTE_fdd_enb_interface::get_instance();
-    LTE_FDD_ENB_RRC_PDU_READY_MSG_STRUCT  rrc_pdu_ready;
-    LIBLTE_BIT_MSG_STRUCT                *pdu;
+    LTE_fdd_enb_interface *interface = LTE_fdd_enb_interface::get_instance();
+    LIBLTE_BIT_MSG_STRUCT *pdu;
 
-    if(LTE_FDD_ENB_ERROR_NONE == pdu_ready->rb->get_next_pdcp_pdu(&pdu))
+    if(LTE_FDD_ENB_PDCP_CONFIG_N_A == pdu_ready->rb->get_pdcp_config())
+    {
+        if(LTE_FDD_ENB_ERROR_NONE == pdu_ready->rb->get_next_pdcp_pdu(&pdu))
+        {
+            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                                      LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
+                                      __FILE__,
+                                      __LINE__,
+                                      pdu,
+                                      "Received PDU for RNTI=%u and RB=%s",
+                                      pdu_ready->user->get_c_rnti(),
+                                      LTE_fdd_enb_rb_text[pdu_ready->rb->get_rb_id()]);
+
+            if(LTE_FDD_ENB_RB_SRB0 == pdu_ready->rb->get_rb_id())
+            {
+                rx_deliver(pdu, pdu_ready->user, pdu_ready->rb);
+            }else{
+                interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                                          LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
+                                          __FILE__,
+                                          __LINE__,
+                                          pdu,
+                                          "Received PDU for RNTI=%u with invalid RB=%s",
+                                          pdu_ready->user->get_c_rnti(),
+                                          LTE_fdd_enb_rb_text[pdu_ready->rb->get_rb_id()]);
+            }
+
+            // Delete the PDU
+            pdu_ready->rb->delete_next_pdcp_pdu();
+        }
+    }else{
+        handle_pdu_batch(pdu_ready->user, pdu_ready->rb);
+    }
+}
+void LTE_fdd_enb_pdcp::handle_pdu_batch(LTE_fdd_enb_user *user,
+                                        LTE_fdd_enb_rb   *rb)
+{
+    boost::mutex::scoped_lock        lock(rx_mutex);
+    LTE_fdd_enb_interface           *interface = LTE_fdd_enb_interface::get_instance();
+    LTE_FDD_ENB_PDCP_SEC_PDU_STRUCT *sec_pdu;
+    LIBLTE_BIT_MSG_STRUCT           *pdu;
+    LIBLTE_ERROR_ENUM                err;
+    uint32                           i;
+    bool                             srb;
+    bool                             am;
+
+    srb = (LTE_FDD_ENB_PDCP_CONFIG_SRB == rb->get_pdcp_config());
+    am  = (!srb && LTE_FDD_ENB_RLC_CONFIG_AM == rb->get_rlc_config());
+
+    // Drain the queue into a batch, each PDU signalled by RLC after the
+    // first one finds its PDU already handled and the queue empty
+    rx_batch.N_pdus = 0;
+    while(LTE_FDD_ENB_PDCP_MAX_BATCH_SIZE >  rx_batch.N_pdus &&
+          LTE_FDD_ENB_ERROR_NONE          == rb->get_next_pdcp_pdu(&pdu))
     {
         interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
                                   LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
@@ -221,51 +350,88 @@ void LTE_fdd_enb_pdcp::handle_pdu_ready(LTE_FDD_ENB_PDCP_PDU_READY_MSG_STRUCT *p
                                   __LINE__,
                                   pdu,
                                   "Received PDU for RNTI=%u and RB=%s",
-                                  pdu_ready->user->get_c_rnti(),
-                                  LTE_fdd_enb_rb_text[pdu_ready->rb->get_rb_id()]);
+                                  user->get_c_rnti(),
+                                  LTE_fdd_enb_rb_text[rb->get_rb_id()]);
 
-        if(LTE_FDD_ENB_RB_SRB0 == pdu_ready->rb->get_rb_id())
+        sec_pdu = &rx_batch.pdu[rx_batch.N_pdus];
+        if(srb)
         {
-            // Queue the SDU for RRC
-            pdu_ready->rb->queue_rrc_pdu(pdu);
-
-            // Signal RRC
-            rrc_pdu_ready.user = pdu_ready->user;
-            rrc_pdu_ready.rb   = pdu_ready->rb;
-            LTE_fdd_enb_msgq::send(pdcp_rrc_mq,
-                                   LTE_FDD_ENB_MESSAGE_TYPE_RRC_PDU_READY,
-                                   LTE_FDD_ENB_DEST_LAYER_RRC,
-                                   (LTE_FDD_ENB_MESSAGE_UNION *)&rrc_pdu_ready,
-                                   sizeof(LTE_FDD_ENB_RRC_PDU_READY_MSG_STRUCT));
+            err = liblte_pdcp_unpack_control_pdu(pdu, &rx_control_pdu);
+            if(LIBLTE_SUCCESS == err)
+            {
+                memcpy(sec_pdu->data.msg, rx_control_pdu.data.msg, rx_control_pdu.data.N_bits);
+                sec_pdu->data.N_bits = rx_control_pdu.data.N_bits;
+                sec_pdu->mac_i       = rx_control_pdu.mac_i;
+                sec_pdu->sn          = rx_control_pdu.sn;
+            }
+        }else{
+            err = liblte_pdcp_unpack_user_plane_pdu(pdu, rb->get_pdcp_sn_size(), &rx_user_plane_pdu);
+            if(LIBLTE_SUCCESS == err)
+            {
+                memcpy(sec_pdu->data.msg, rx_user_plane_pdu.data.msg, rx_user_plane_pdu.data.N_bits);
+                sec_pdu->data.N_bits = rx_user_plane_pdu.data.N_bits;
+                sec_pdu->mac_i       = 0;
+                sec_pdu->sn          = rx_user_plane_pdu.sn;
+            }
+        }
 
-            // Delete the PDU
-            pdu_ready->rb->delete_next_pdcp_pdu();
-        }else if(LTE_FDD_ENB_RB_SRB1 == pdu_ready->rb->get_rb_id()){
-            // Parse the header
-            // FIXME
-            memmove(&pdu->msg[0], &pdu->msg[8], pdu->N_bits-8);
-            pdu->N_bits -= 8;
-
-            // Queue the SDU for RRC
-            pdu_ready->rb->queue_rrc_pdu(pdu);
-
-            // Signal RRC
-            rrc_pdu_ready.user = pdu_ready->user;
-            rrc_pdu_ready.rb   = pdu_ready->rb;
-            LTE_fdd_enb_msgq::send(pdcp_rrc_mq,
-                                   LTE_FDD_ENB_MESSAGE_TYPE_RRC_PDU_READY,
-                                   LTE_FDD_ENB_DEST_LAYER_RRC,
-                                   (LTE_FDD_ENB_MESSAGE_UNION *)&rrc_pdu_ready,
-                                   sizeof(LTE_FDD_ENB_RRC_PDU_READY_MSG_STRUCT));
+        if(LIBLTE_SUCCESS == err)
+        {
+            // State variables are advanced here, ahead of verification,
+            // so that the whole batch can be unprotected in one call
+            if(am)
+            {
+                sec_pdu->count = rx_am_count(rb, sec_pdu->sn);
+            }else{
+                sec_pdu->count = rx_count(rb, sec_pdu->sn);
+            }
+            sec_pdu->valid = true;
+            rx_batch.N_pdus++;
         }else{
             interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
                                       LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
                                       __FILE__,
                                       __LINE__,
                                       pdu,
-                                      "Received PDU for RNTI=%u with invalid RB=%s",
-                                      pdu_ready->user->get_c_rnti(),
-                                      LTE_fdd_enb_rb_text[pdu_ready->rb->get_rb_id()]);
+                                      "Discarding malformed PDU for RNTI=%u and RB=%s",
+                                      user->get_c_rnti(),
+                                      LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+            rb->pdcp_count_discarded_pdu();
+        }
+
+        // Delete the PDU
+        rb->delete_next_pdcp_pdu();
+    }
+
+    if(0 != rx_batch.N_pdus)
+    {
+        // Decipher and verify
+        rx_batch.user      = user;
+        rx_batch.rb        = rb;
+        rx_batch.op        = LTE_FDD_ENB_PDCP_SEC_OP_UNPROTECT;
+        rx_batch.integrity = srb;
+        run_security(&rx_batch);
+
+        // Deliver
+        for(i=0; i<rx_batch.N_pdus; i++)
+        {
+            sec_pdu = &rx_batch.pdu[i];
+            if(!sec_pdu->valid)
+            {
+                interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_WARNING,
+                                          LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
+                                          __FILE__,
+                                          __LINE__,
+                                          "Integrity verification failed for RNTI=%u, RB=%s, and SN=%u",
+                                          user->get_c_rnti(),
+                                          LTE_fdd_enb_rb_text[rb->get_rb_id()],
+                                          sec_pdu->sn);
+                rb->pdcp_count_discarded_pdu();
+            }else if(am){
+                rx_am_reorder(&sec_pdu->data, sec_pdu->sn, user, rb);
+            }else{
+                rx_deliver(&sec_pdu->data, user, rb);
+            }
         }
     }
 }
@@ -275,12 +441,62 @@ void LTE_fdd_enb_pdcp::handle_pdu_ready(LTE_FDD_ENB_PDCP_PDU_READY_MSG_STRUCT *p
 /******************************/
 void LTE_fdd_enb_pdcp::handle_sdu_ready(LTE_FDD_ENB_PDCP_SDU_READY_MSG_STRUCT *sdu_ready)
 {
-    LTE_fdd_enb_interface                *interface = LTE_fdd_enb_interface::get_instance();
-    LTE_FDD_ENB_RLC_SDU_READY_MSG_STRUCT  rlc_sdu_ready;
-    LIBLTE_BIT_MSG_STRUCT                *sdu;
-    uint32                                i;
+    LTE_fdd_enb_interface *interface = LTE_fdd_enb_interface::get_instance();
+    LIBLTE_BIT_MSG_STRUCT *sdu;
 
-    if(LTE_FDD_ENB_ERROR_NONE == sdu_ready->rb->get_next_pdcp_sdu(&sdu))
+    if(LTE_FDD_ENB_PDCP_CONFIG_N_A == sdu_ready->rb->get_pdcp_config())
+    {
+        if(LTE_FDD_ENB_ERROR_NONE == sdu_ready->rb->get_next_pdcp_sdu(&sdu))
+        {
+            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                                      LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
+                                      __FILE__,
+                                      __LINE__,
+                                      sdu,
+                                      "Received SDU for RNTI=%u and RB=%s",
+                                      sdu_ready->user->get_c_rnti(),
+                                      LTE_fdd_enb_rb_text[sdu_ready->rb->get_rb_id()]);
+
+            if(LTE_FDD_ENB_RB_SRB0 == sdu_ready->rb->get_rb_id())
+            {
+                byte_align(sdu);
+                sdu_ready->rb->pdcp_count_dl_sdu(sdu->N_bits / 8);
+                send_rlc_sdu(sdu, sdu_ready->user, sdu_ready->rb);
+            }else{
+                interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                                          LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
+                                          __FILE__,
+                                          __LINE__,
+                                          sdu,
+                                          "Received SDU for RNTI=%u with invalid RB=%s",
+                                          sdu_ready->user->get_c_rnti(),
+                                          LTE_fdd_enb_rb_text[sdu_ready->rb->get_rb_id()]);
+            }
+
+            // Delete the SDU
+            sdu_ready->rb->delete_next_pdcp_sdu();
+        }
+    }else{
+        handle_sdu_batch(sdu_ready->user, sdu_ready->rb);
+    }
+}
+void LTE_fdd_enb_pdcp::handle_sdu_batch(LTE_fdd_enb_user *user,
+                                        LTE_fdd_enb_rb   *rb)
+{
+    LTE_fdd_enb_interface           *interface = LTE_fdd_enb_interface::get_instance();
+    LTE_FDD_ENB_PDCP_SEC_PDU_STRUCT *sec_pdu;
+    LIBLTE_BIT_MSG_STRUCT           *sdu;
+    LIBLTE_ERROR_ENUM                err;
+    uint32                           i;
+    uint16                           sn;
+    bool                             srb;
+
+    srb = (LTE_FDD_ENB_PDCP_CONFIG_SRB == rb->get_pdcp_config());
+
+    // Drain the queue into a batch, assigning SN and COUNT to each SDU
+    tx_batch.N_pdus = 0;
+    while(LTE_FDD_ENB_PDCP_MAX_BATCH_SIZE >  tx_batch.N_pdus &&
+          LTE_FDD_ENB_ERROR_NONE          == rb->get_next_pdcp_sdu(&sdu))
     {
         interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
                                   LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
@@ -288,44 +504,307 @@ void LTE_fdd_enb_pdcp::handle_sdu_ready(LTE_FDD_ENB_PDCP_SDU_READY_MSG_STRUCT *s
                                   __LINE__,
                                   sdu,
                                   "Received SDU for RNTI=%u and RB=%s",
-                                  sdu_ready->user->get_c_rnti(),
-                                  LTE_fdd_enb_rb_text[sdu_ready->rb->get_rb_id()]);
+                                  user->get_c_rnti(),
+                                  LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+
+        sec_pdu = &tx_batch.pdu[tx_batch.N_pdus];
+        memcpy(sec_pdu->data.msg, sdu->msg, sdu->N_bits);
+        sec_pdu->data.N_bits = sdu->N_bits;
+        byte_align(&sec_pdu->data);
+        sec_pdu->mac_i = 0;
+        sec_pdu->valid = true;
+
+        // 36.323 v10.1.0 Section 5.1.1
+        sn             = rb->get_pdcp_next_tx_sn();
+        sec_pdu->sn    = sn;
+        sec_pdu->count = (rb->get_pdcp_tx_hfn() << rb->get_pdcp_sn_n_bits()) | sn;
+        if(rb->get_pdcp_max_sn() == sn)
+        {
+            rb->set_pdcp_next_tx_sn(0);
+            rb->set_pdcp_tx_hfn(rb->get_pdcp_tx_hfn() + 1);
+        }else{
+            rb->set_pdcp_next_tx_sn(sn + 1);
+        }
+
+        rb->pdcp_count_dl_sdu(sec_pdu->data.N_bits / 8);
+        tx_batch.N_pdus++;
+
+        // Delete the SDU
+        rb->delete_next_pdcp_sdu();
+    }
 
-        if(LTE_FDD_ENB_RB_SRB0 == sdu_ready->rb->get_rb_id())
+    if(0 != tx_batch.N_pdus)
+    {
+        // Integrity protect and cipher
+        tx_batch.user      = user;
+        tx_batch.rb        = rb;
+        tx_batch.op        = LTE_FDD_ENB_PDCP_SEC_OP_PROTECT;
+        tx_batch.integrity = srb;
+        run_security(&tx_batch);
+
+        // Pack and send to RLC
+        for(i=0; i<tx_batch.N_pdus; i++)
         {
-            // Make sure the SDU is byte aligned
-            if((sdu->N_bits % 8) != 0)
+            sec_pdu = &tx_batch.pdu[i];
+            if(srb)
             {
-                for(i=0; i<8-(sdu->N_bits % 8); i++)
-                {
-                    sdu->msg[sdu->N_bits + i] = 0;
-                }
-                sdu->N_bits += 8 - (sdu->N_bits % 8);
+                memcpy(tx_control_pdu.data.msg, sec_pdu->data.msg, sec_pdu->data.N_bits);
+                tx_control_pdu.data.N_bits = sec_pdu->data.N_bits;
+                tx_control_pdu.mac_i       = sec_pdu->mac_i;
+                tx_control_pdu.sn          = sec_pdu->sn;
+                err                        = liblte_pdcp_pack_control_pdu(&tx_control_pdu, &tx_pdu);
+            }else{
+                memcpy(tx_user_plane_pdu.data.msg, sec_pdu->data.msg, sec_pdu->data.N_bits);
+                tx_user_plane_pdu.data.N_bits = sec_pdu->data.N_bits;
+                tx_user_plane_pdu.sn_size     = rb->get_pdcp_sn_size();
+                tx_user_plane_pdu.sn          = sec_pdu->sn;
+                err                           = liblte_pdcp_pack_user_plane_pdu(&tx_user_plane_pdu, &tx_pdu);
             }
 
-            // Queue the PDU for RLC
-            sdu_ready->rb->queue_rlc_sdu(sdu);
+            if(LIBLTE_SUCCESS == err)
+            {
+                send_rlc_sdu(&tx_pdu, user, rb);
+            }else{
+                interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                                          LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
+                                          __FILE__,
+                                          __LINE__,
+                                          "Unable to pack PDU for RNTI=%u, RB=%s, and SN=%u",
+                                          user->get_c_rnti(),
+                                          LTE_fdd_enb_rb_text[rb->get_rb_id()],
+                                          sec_pdu->sn);
+            }
+        }
+    }
+}
 
-            // Signal RLC
-            rlc_sdu_ready.user = sdu_ready->user;
-            rlc_sdu_ready.rb   = sdu_ready->rb;
-            LTE_fdd_enb_msgq::send(pdcp_rlc_mq,
-                                   LTE_FDD_ENB_MESSAGE_TYPE_RLC_SDU_READY,
-                                   LTE_FDD_ENB_DEST_LAYER_RLC,
-                                   (LTE_FDD_ENB_MESSAGE_UNION *)&rlc_sdu_ready,
-                                   sizeof(LTE_FDD_ENB_RLC_SDU_READY_MSG_STRUCT));
+/***********************/
+/*    RX Procedures    */
+/***********************/
+uint32 LTE_fdd_enb_pdcp::rx_count(LTE_fdd_enb_rb *rb,
+                                  uint16          sn)
+{
+    uint32 hfn     = rb->get_pdcp_rx_hfn();
+    uint16 next_sn = rb->get_pdcp_next_rx_sn();
 
-            // Delete the SDU
-            sdu_ready->rb->delete_next_pdcp_sdu();
+    // 36.323 v10.1.0 Sections 5.1.2.1.3 & 5.1.2.2
+    if(sn < next_sn)
+    {
+        hfn++;
+    }
+    next_sn = sn + 1;
+    if(next_sn > rb->get_pdcp_max_sn())
+    {
+        next_sn = 0;
+        rb->set_pdcp_rx_hfn(hfn + 1);
+    }else{
+        rb->set_pdcp_rx_hfn(hfn);
+    }
+    rb->set_pdcp_next_rx_sn(next_sn);
+
+    return((hfn << rb->get_pdcp_sn_n_bits()) | sn);
+}
+uint32 LTE_fdd_enb_pdcp::rx_am_count(LTE_fdd_enb_rb *rb,
+                                     uint16          sn)
+{
+    int32  next_sn = rb->get_pdcp_next_rx_sn();
+    int32  window  = rb->get_pdcp_reordering_window();
+    uint32 hfn     = rb->get_pdcp_rx_hfn();
+
+    // 36.323 v10.1.0 Section 5.1.2.1.2
+    if(rx_am_outside_window(rb, sn))
+    {
+        // Deciphered and then discarded
+        if(sn > next_sn)
+        {
+            hfn--;
+        }
+    }else if((next_sn - sn) > window){
+        hfn++;
+        rb->set_pdcp_rx_hfn(hfn);
+        rb->set_pdcp_next_rx_sn(sn + 1);
+    }else if((sn - next_sn) >= window){
+        hfn--;
+    }else if(sn >= next_sn){
+        if(rb->get_pdcp_max_sn() == sn)
+        {
+            rb->set_pdcp_next_rx_sn(0);
+            rb->set_pdcp_rx_hfn(hfn + 1);
         }else{
-            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                                      LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
-                                      __FILE__,
-                                      __LINE__,
-                                      sdu,
-                                      "Received SDU for RNTI=%u with invalid RB=%s",
-                                      sdu_ready->user->get_c_rnti(),
-                                      LTE_fdd_enb_rb_text[sdu_ready->rb->get_rb_id()]);
+            rb->set_pdcp_next_rx_sn(sn + 1);
         }
     }
+
+    return((hfn << rb->get_pdcp_sn_n_bits()) | sn);
+}
+bool LTE_fdd_enb_pdcp::rx_am_outside_window(LTE_fdd_enb_rb *rb,
+                                            uint16          sn)
+{
+    int32 last_sn = rb->get_pdcp_last_submitted_rx_sn();
+    int32 window  = rb->get_pdcp_reordering_window();
+
+    return((sn - last_sn)  > window ||
+           ((last_sn - sn) >= 0     &&
+            (last_sn - sn) <  window));
+}
+void LTE_fdd_enb_pdcp::rx_am_reorder(LIBLTE_BIT_MSG_STRUCT *sdu,
+                                     uint16                 sn,
+                                     LTE_fdd_enb_user      *user,
+                                     LTE_fdd_enb_rb        *rb)
+{
+    LTE_fdd_enb_interface *interface = LTE_fdd_enb_interface::get_instance();
+    uint32                 modulus   = rb->get_pdcp_max_sn() + 1;
+    uint32                 offset;
+
+    // Last_Submitted_PDCP_RX_SN may have moved since COUNT was determined,
+    // so the window is checked again before storing
+    if(!rx_am_outside_window(rb, sn) &&
+       LTE_FDD_ENB_ERROR_NONE == rb->pdcp_add_to_reordering_buffer(sn, sdu))
+    {
+        // Deliver all consecutive SDUs following the last submitted one
+        rx_deliver_consecutive((rb->get_pdcp_last_submitted_rx_sn() + 1) % modulus, user, rb);
+
+        // 36.323 v12.0.0 Section 5.1.2.1.4, stop t-Reordering once the SDU
+        // before Reordering_PDCP_RX_SN is delivered and start it while SDUs
+        // are held behind a gap
+        if(rb->pdcp_is_t_reordering_running())
+        {
+            offset = (rb->get_pdcp_reordering_rx_sn() + modulus - rb->get_pdcp_last_submitted_rx_sn() - 1) % modulus;
+            if(0                                == offset ||
+               rb->get_pdcp_reordering_window() <  offset)
+            {
+                rb->pdcp_stop_t_reordering();
+            }
+        }
+        if(!rb->pdcp_is_t_reordering_running() &&
+           0 != rb->get_pdcp_n_reordering_sdus())
+        {
+            rb->set_pdcp_reordering_rx_sn(rb->get_pdcp_next_rx_sn());
+            rb->pdcp_start_t_reordering();
+        }
+    }else{
+        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                                  LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
+                                  __FILE__,
+                                  __LINE__,
+                                  "Discarding duplicate or out of window PDU for RNTI=%u, RB=%s, and SN=%u",
+                                  user->get_c_rnti(),
+                                  LTE_fdd_enb_rb_text[rb->get_rb_id()],
+                                  sn);
+        rb->pdcp_count_discarded_pdu();
+    }
+}
+void LTE_fdd_enb_pdcp::rx_deliver_consecutive(uint16            sn,
+                                              LTE_fdd_enb_user *user,
+                                              LTE_fdd_enb_rb   *rb)
+{
+    uint32 modulus = rb->get_pdcp_max_sn() + 1;
+
+    while(LTE_FDD_ENB_ERROR_NONE == rb->pdcp_get_from_reordering_buffer(sn, &rx_sdu))
+    {
+        rx_deliver(&rx_sdu, user, rb);
+        rb->set_pdcp_last_submitted_rx_sn(sn);
+        sn = (sn + 1) % modulus;
+    }
+}
+void LTE_fdd_enb_pdcp::rx_deliver(LIBLTE_BIT_MSG_STRUCT *sdu,
+                                  LTE_fdd_enb_user      *user,
+                                  LTE_fdd_enb_rb        *rb)
+{
+    LTE_fdd_enb_interface *interface = LTE_fdd_enb_interface::get_instance();
+
+    rb->pdcp_count_ul_sdu(sdu->N_bits / 8);
+
+    if(LTE_FDD_ENB_PDCP_CONFIG_DRB_LONG_SN  == rb->get_pdcp_config() ||
+       LTE_FDD_ENB_PDCP_CONFIG_DRB_SHORT_SN == rb->get_pdcp_config())
+    {
+        // FIXME: No user plane to forward DRB SDUs to
+        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                                  LTE_FDD_ENB_DEBUG_LEVEL_PDCP,
+                                  __FILE__,
+                                  __LINE__,
+                                  sdu,
+                                  "Received DRB SDU for RNTI=%u and RB=%s",
+                                  user->get_c_rnti(),
+                                  LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+    }else{
+        send_rrc_pdu(sdu, user, rb);
+    }
+}
+
+/******************/
+/*    Security    */
+/******************/
+void LTE_fdd_enb_pdcp::handle_null_security(LTE_FDD_ENB_PDCP_SEC_BATCH_STRUCT *batch)
+{
+    uint32 i;
+
+    // EEA0 and EIA0, data is untouched and MAC-I is all zeros
+    for(i=0; i<batch->N_pdus; i++)
+    {
+        if(LTE_FDD_ENB_PDCP_SEC_OP_PROTECT == batch->op)
+        {
+            batch->pdu[i].mac_i = 0;
+        }
+        batch->pdu[i].valid = true;
+    }
+}
+void LTE_fdd_enb_pdcp::run_security(LTE_FDD_ENB_PDCP_SEC_BATCH_STRUCT *batch)
+{
+    boost::mutex::scoped_lock lock(sec_mutex);
+
+    sec_cb(batch);
+}
+
+/*****************/
+/*    Helpers    */
+/*****************/
+void LTE_fdd_enb_pdcp::byte_align(LIBLTE_BIT_MSG_STRUCT *msg)
+{
+    uint32 i;
+
+    if((msg->N_bits % 8) != 0)
+    {
+        for(i=0; i<8-(msg->N_bits % 8); i++)
+        {
+            msg->msg[msg->N_bits + i] = 0;
+        }
+        msg->N_bits += 8 - (msg->N_bits % 8);
+    }
+}
+void LTE_fdd_enb_pdcp::send_rrc_pdu(LIBLTE_BIT_MSG_STRUCT *pdu,
+                                    LTE_fdd_enb_user      *user,
+                                    LTE_fdd_enb_rb        *rb)
+{
+    LTE_FDD_ENB_RRC_PDU_READY_MSG_STRUCT rrc_pdu_ready;
+
+    // Queue the PDU for RRC
+    rb->queue_rrc_pdu(pdu);
+
+    // Signal RRC
+    rrc_pdu_ready.user = user;
+    rrc_pdu_ready.rb   = rb;
+    LTE_fdd_enb_msgq::send(pdcp_rrc_mq,
+                           LTE_FDD_ENB_MESSAGE_TYPE_RRC_PDU_READY,
+                           LTE_FDD_ENB_DEST_LAYER_RRC,
+                           (LTE_FDD_ENB_MESSAGE_UNION *)&rrc_pdu_ready,
+                           sizeof(LTE_FDD_ENB_RRC_PDU_READY_MSG_STRUCT));
+}
+void LTE_fdd_enb_pdcp::send_rlc_sdu(LIBLTE_BIT_MSG_STRUCT *sdu,
+                                    LTE_fdd_enb_user      *user,
+                                    LTE_fdd_enb_rb        *rb)
+{
+    LTE_FDD_ENB_RLC_SDU_READY_MSG_STRUCT rlc_sdu_ready;
+
+    // Queue the SDU for RLC
+    rb->queue_rlc_sdu(sdu);
+
+    // Signal RLC
+    rlc_sdu_ready.user = user;
+    rlc_sdu_ready.rb   = rb;
+    LTE_fdd_enb_msgq::send(pdcp_rlc_mq,
+                           LTE_FDD_ENB_MESSAGE_TYPE_RLC_SDU_READY,
+                           LTE_FDD_ENB_DEST_LAYER_RLC,
+                           (LTE_FDD_ENB_MESSAGE_UNION *)&rlc_sdu_ready,
+                           sizeof(LTE_FDD_ENB_RLC_SDU_READY_MSG_STRUCT));
 }
@@ -37,6 +37,14 @@
     05/04/2014    Ben Wojtowicz    Added PCAP support, PHICH support, and timer
                                    support.
     06/15/2014    Ben Wojtowicz    Changed fn_combo to current_tti.
+    10/19/2026    agent            Added processing time statistics and
+                                   helpers for the no_rf loopback radio.
+    10/19/2026    agent            Using the PRB placement from the MAC for
+                                   user data.
+    10/19/2026    agent            Only copying the system information when
+                                   its version changes.
+    10/19/2026    agent            Mapping PBCH and system information from a
+                                   cache of pre-encoded resource elements.
 
 *******************************************************************************/
 
@@ -98,8 +106,16 @@ void LTE_fdd_enb_phy::cleanup(void)
 /********************************/
 LTE_fdd_enb_phy::LTE_fdd_enb_phy()
 {
-    interface = NULL;
-    started   = false;
+    interface              = NULL;
+    started                = false;
+    sys_info_version       = 0;
+    bcast_phy_struct       = NULL;
+    bcast_subframe         = NULL;
+    bcast                  = NULL;
+    bcast_pending          = NULL;
+    bcast_retired          = NULL;
+    LTE_fdd_enb_interface::reset_proc_time(&ul_proc_time);
+    LTE_fdd_enb_interface::reset_proc_time(&dl_proc_time);
 }
 LTE_fdd_enb_phy::~LTE_fdd_enb_phy()
 {
@@ -192,6 +208,23 @@ void LTE_fdd_enb_phy::start(LTE_fdd_enb_interface *iface)
         last_rts_current_tti = 0;
         late_subfr           = false;
 
+        // Broadcast cache, encoded with its own phy so that rebuilding it
+        // never touches the phy used by the TTI
+        bcast_mutex.lock();
+        liblte_phy_init(&bcast_phy_struct,
+                        fs,
+                        sys_info.N_id_cell,
+                        sys_info.N_ant,
+                        sys_info.N_rb_dl,
+                        sys_info.N_sc_rb_dl,
+                        liblte_rrc_phich_resource_num[sys_info.mib.phich_config.res]);
+        bcast_subframe = new LIBLTE_PHY_SUBFRAME_STRUCT;
+        bcast          = new LTE_FDD_ENB_PHY_BCAST_CACHE_STRUCT;
+        memcpy(&bcast->sys_info, &sys_info, sizeof(LTE_FDD_ENB_SYS_INFO_STRUCT));
+        bcast->sys_info_version = sys_info_version;
+        build_bcast_cache(bcast);
+        bcast_mutex.unlock();
+
         // Uplink
         ul_current_tti = (LTE_FDD_ENB_CURRENT_TTI_MAX + 1) - 2;
         prach_cnfg_idx = sys_info.sib2.rr_config_common_sib.prach_cnfg.prach_cnfg_info.prach_config_index;
@@ -280,6 +313,10 @@ void LTE_fdd_enb_phy::start(LTE_fdd_enb_interface *iface)
             break;
         }
 
+        // Processing time
+        LTE_fdd_enb_interface::reset_proc_time(&ul_proc_time);
+        LTE_fdd_enb_interface::reset_proc_time(&dl_proc_time);
+
         // Communication
         mac_comm_msgq = new LTE_fdd_enb_msgq("mac_phy_mq",
                                              cb);
@@ -296,23 +333,74 @@ void LTE_fdd_enb_phy::stop(void)
     {
         started = false;
 
+        bcast_mutex.lock();
+        free_bcast_cache(bcast);
+        free_bcast_cache(bcast_pending);
+        free_bcast_cache(bcast_retired);
+        bcast         = NULL;
+        bcast_pending = NULL;
+        bcast_retired = NULL;
+        delete bcast_subframe;
+        bcast_subframe = NULL;
+        liblte_phy_cleanup(bcast_phy_struct);
+        bcast_phy_struct = NULL;
+        bcast_mutex.unlock();
+
         liblte_phy_ul_cleanup(phy_struct);
         liblte_phy_cleanup(phy_struct);
 
         delete mac_comm_msgq;
     }
 }
+bool LTE_fdd_enb_phy::is_started(void)
+{
+    return(started);
+}
 
 /****************************/
 /*    External Interface    */
 /****************************/
 void LTE_fdd_enb_phy::update_sys_info(void)
 {
-    LTE_fdd_enb_cnfg_db *cnfg_db = LTE_fdd_enb_cnfg_db::get_instance();
+    LTE_fdd_enb_cnfg_db                *cnfg_db = LTE_fdd_enb_cnfg_db::get_instance();
+    boost::mutex::scoped_lock           lock(bcast_mutex);
+    LTE_FDD_ENB_PHY_BCAST_CACHE_STRUCT *new_bcast;
+    LTE_FDD_ENB_PHY_BCAST_CACHE_STRUCT *old_pending;
+    LTE_FDD_ENB_PHY_BCAST_CACHE_STRUCT *old_retired;
 
-    sys_info_mutex.lock();
-    cnfg_db->get_sys_info(sys_info);
-    sys_info_mutex.unlock();
+    if(sys_info_version != cnfg_db->get_sys_info_version())
+    {
+        // Encode the new broadcast cache here instead of in the TTI,
+        // process_dl only swaps it in
+        new_bcast                   = new LTE_FDD_ENB_PHY_BCAST_CACHE_STRUCT;
+        new_bcast->sys_info_version = cnfg_db->get_sys_info(new_bcast->sys_info);
+        if(NULL != bcast_phy_struct)
+        {
+            build_bcast_cache(new_bcast);
+        }
+
+        sys_info_mutex.lock();
+        memcpy(&sys_info, &new_bcast->sys_info, sizeof(LTE_FDD_ENB_SYS_INFO_STRUCT));
+        sys_info_version = new_bcast->sys_info_version;
+        old_pending      = bcast_pending;
+        old_retired      = bcast_retired;
+        bcast_pending    = NULL;
+        bcast_retired    = NULL;
+        if(NULL != bcast_phy_struct)
+        {
+            bcast_pending = new_bcast;
+        }
+        sys_info_mutex.unlock();
+
+        // Free a cache that was never swapped in and the one process_dl
+        // swapped out
+        free_bcast_cache(old_pending);
+        free_bcast_cache(old_retired);
+        if(NULL == bcast_phy_struct)
+        {
+            delete new_bcast;
+        }
+    }
 }
 uint32 LTE_fdd_enb_phy::get_n_cce(void)
 {
@@ -327,6 +415,14 @@ uint32 LTE_fdd_enb_phy::get_n_cce(void)
 
     return(N_cce);
 }
+LTE_FDD_ENB_PROC_TIME_STRUCT LTE_fdd_enb_phy::get_ul_proc_time(void)
+{
+    return(ul_proc_time);
+}
+LTE_FDD_ENB_PROC_TIME_STRUCT LTE_fdd_enb_phy::get_dl_proc_time(void)
+{
+    return(dl_proc_time);
+}
 
 /***********************/
 /*    Communication    */
@@ -373,13 +469,19 @@ void LTE_fdd_enb_phy::handle_mac_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg)
 void LTE_fdd_enb_phy::radio_interface(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *tx_buf,
                                       LTE_FDD_ENB_RADIO_RX_BUF_STRUCT *rx_buf)
 {
+    struct timespec start_time;
+
     if(started)
     {
         // Once started, this routine gets called every millisecond to:
         //     1) process the new uplink subframe
         //     2) generate the next downlink subframe
+        clock_gettime(CLOCK_MONOTONIC, &start_time);
         process_ul(rx_buf);
+        LTE_fdd_enb_interface::update_proc_time(&ul_proc_time, &start_time);
+        clock_gettime(CLOCK_MONOTONIC, &start_time);
         process_dl(tx_buf);
+        LTE_fdd_enb_interface::update_proc_time(&dl_proc_time, &start_time);
     }
 }
 void LTE_fdd_enb_phy::radio_interface(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *tx_buf)
@@ -388,6 +490,59 @@ void LTE_fdd_enb_phy::radio_interface(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *tx_buf)
     process_dl(tx_buf);
 }
 
+/****************************/
+/*    Loopback Interface    */
+/****************************/
+bool LTE_fdd_enb_phy::is_prach_subframe(uint32 current_tti)
+{
+    uint32 sfn   = current_tti/10;
+    uint32 subfn = current_tti%10;
+    bool   ret   = false;
+
+    // Mirrors the PRACH opportunity check in process_ul
+    if(started &&
+       (sfn % prach_sfn_mod) == 0)
+    {
+        if((subfn % prach_subfn_mod) == prach_subfn_check)
+        {
+            if(subfn != 0 ||
+               true  == prach_subfn_zero_allowed)
+            {
+                ret = true;
+            }
+        }
+    }
+
+    return(ret);
+}
+bool LTE_fdd_enb_phy::is_dl_schedule_ready(void)
+{
+    boost::mutex::scoped_lock lock(dl_sched_mutex);
+
+    return(dl_schedule[dl_current_tti%10].current_tti == dl_current_tti);
+}
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_phy::generate_prach(uint32  preamble_idx,
+                                                       float  *i_buf,
+                                                       float  *q_buf)
+{
+    boost::mutex::scoped_lock lock(sys_info_mutex);
+    LTE_FDD_ENB_ERROR_ENUM    err = LTE_FDD_ENB_ERROR_CANT_SCHEDULE;
+
+    // Only valid from the radio thread, the PRACH scratch buffers are shared
+    // with process_ul
+    if(started &&
+       LIBLTE_SUCCESS == liblte_phy_generate_prach(phy_struct,
+                                                   preamble_idx,
+                                                   sys_info.sib2.rr_config_common_sib.prach_cnfg.prach_cnfg_info.prach_freq_offset,
+                                                   i_buf,
+                                                   q_buf))
+    {
+        err = LTE_FDD_ENB_ERROR_NONE;
+    }
+
+    return(err);
+}
+
 /******************/
 /*    Downlink    */
 /******************/
@@ -463,9 +618,21 @@ void LTE_fdd_enb_phy::process_dl(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *tx_buf)
     uint32                                i;
     uint32                                j;
     uint32                                last_prb = 0;
+    uint32                                N_sys_alloc;
+    uint32                                N_ant_re;
     uint32                                act_noutput_items;
     uint32                                sfn   = dl_current_tti/10;
     uint32                                subfn = dl_current_tti%10;
+    bool                                  prb_overlap;
+
+    // Swap in a broadcast cache built by update_sys_info, the old one is
+    // freed there as well
+    if(NULL != bcast_pending)
+    {
+        bcast_retired = bcast;
+        bcast         = bcast_pending;
+        bcast_pending = NULL;
+    }
 
     // Initialize the output to all zeros
     for(p=0; p<sys_info.N_ant; p++)
@@ -505,92 +672,36 @@ void LTE_fdd_enb_phy::process_dl(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *tx_buf)
     // Handle PBCH
     if(0 == dl_subframe.num)
     {
-        sys_info.mib.sfn_div_4 = sfn/4;
-        liblte_rrc_pack_bcch_bch_msg(&sys_info.mib,
-                                     &dl_rrc_msg);
         interface->send_pcap_msg(LTE_FDD_ENB_PCAP_DIRECTION_DL,
                                  0xFFFFFFFF,
                                  dl_current_tti,
-                                 dl_rrc_msg.msg,
-                                 dl_rrc_msg.N_bits);
-        liblte_phy_bch_channel_encode(phy_struct,
-                                      dl_rrc_msg.msg,
-                                      dl_rrc_msg.N_bits,
-                                      sys_info.N_id_cell,
-                                      sys_info.N_ant,
-                                      &dl_subframe,
-                                      sfn);
+                                 bcast->mib[sfn/4],
+                                 bcast->mib_N_bits);
+        N_ant_re = sys_info.N_ant*LTE_FDD_ENB_PHY_BCAST_N_PBCH_RE;
+        map_bcast_res(bcast->pbch_idx,
+                      LTE_FDD_ENB_PHY_BCAST_N_PBCH_RE,
+                      &bcast->pbch_re[sfn*N_ant_re],
+                      &bcast->pbch_im[sfn*N_ant_re]);
     }
 
     // Handle SIB data
-    pdcch.N_alloc = 0;
-    if(5 == dl_subframe.num &&
-       0 == (sfn % 2))
+    pdcch.N_alloc = select_bcast_pdsch(sfn, subfn, dl_bcast);
+    for(i=0; i<pdcch.N_alloc; i++)
     {
-        // SIB1
         interface->send_pcap_msg(LTE_FDD_ENB_PCAP_DIRECTION_DL,
                                  LIBLTE_MAC_SI_RNTI,
                                  dl_current_tti,
-                                 sys_info.sib1_alloc.msg.msg,
-                                 sys_info.sib1_alloc.msg.N_bits);
-        memcpy(&pdcch.alloc[pdcch.N_alloc], &sys_info.sib1_alloc, sizeof(LIBLTE_PHY_ALLOCATION_STRUCT));
-        liblte_phy_get_tbs_mcs_and_n_prb_for_dl(pdcch.alloc[pdcch.N_alloc].msg.N_bits,
-                                                dl_subframe.num,
-                                                sys_info.N_rb_dl,
-                                                pdcch.alloc[pdcch.N_alloc].rnti,
-                                                &pdcch.alloc[pdcch.N_alloc].tbs,
-                                                &pdcch.alloc[pdcch.N_alloc].mcs,
-                                                &pdcch.alloc[pdcch.N_alloc].N_prb);
-        pdcch.alloc[pdcch.N_alloc].rv_idx = (uint32)ceilf(1.5 * ((sfn / 2) % 4)) % 4; //36.321 section 5.3.1
-        pdcch.N_alloc++;
-    }
-    if((0 * sys_info.si_win_len)%10   <= dl_subframe.num &&
-       (1 * sys_info.si_win_len)%10   >  dl_subframe.num &&
-       ((0 * sys_info.si_win_len)/10) == (sfn % sys_info.si_periodicity_T))
-    {
-        // SIs in 1st scheduling info list entry
-        interface->send_pcap_msg(LTE_FDD_ENB_PCAP_DIRECTION_DL,
-                                 LIBLTE_MAC_SI_RNTI,
-                                 dl_current_tti,
-                                 sys_info.sib_alloc[0].msg.msg,
-                                 sys_info.sib_alloc[0].msg.N_bits);
-        memcpy(&pdcch.alloc[pdcch.N_alloc], &sys_info.sib_alloc[0], sizeof(LIBLTE_PHY_ALLOCATION_STRUCT));
-        // FIXME: This was a hack to allow SIB2 decoding with 1.4MHz BW due to overlap with MIB
-        if(LIBLTE_SUCCESS == liblte_phy_get_tbs_mcs_and_n_prb_for_dl(pdcch.alloc[pdcch.N_alloc].msg.N_bits,
-                                                                     dl_subframe.num,
-                                                                     sys_info.N_rb_dl,
-                                                                     pdcch.alloc[pdcch.N_alloc].rnti,
-                                                                     &pdcch.alloc[pdcch.N_alloc].tbs,
-                                                                     &pdcch.alloc[pdcch.N_alloc].mcs,
-                                                                     &pdcch.alloc[pdcch.N_alloc].N_prb))
-        {
-            pdcch.N_alloc++;
-        }
-    }
-    for(i=1; i<sys_info.sib1.N_sched_info; i++)
-    {
-        if(0                              != sys_info.sib_alloc[i].msg.N_bits &&
-           (i * sys_info.si_win_len)%10   == dl_subframe.num                  &&
-           ((i * sys_info.si_win_len)/10) == (sfn % sys_info.si_periodicity_T))
-        {
-            interface->send_pcap_msg(LTE_FDD_ENB_PCAP_DIRECTION_DL,
-                                     LIBLTE_MAC_SI_RNTI,
-                                     dl_current_tti,
-                                     sys_info.sib_alloc[i].msg.msg,
-                                     sys_info.sib_alloc[i].msg.N_bits);
-            memcpy(&pdcch.alloc[pdcch.N_alloc], &sys_info.sib_alloc[i], sizeof(LIBLTE_PHY_ALLOCATION_STRUCT));
-            liblte_phy_get_tbs_mcs_and_n_prb_for_dl(pdcch.alloc[pdcch.N_alloc].msg.N_bits,
-                                                    dl_subframe.num,
-                                                    sys_info.N_rb_dl,
-                                                    pdcch.alloc[pdcch.N_alloc].rnti,
-                                                    &pdcch.alloc[pdcch.N_alloc].tbs,
-                                                    &pdcch.alloc[pdcch.N_alloc].mcs,
-                                                    &pdcch.alloc[pdcch.N_alloc].N_prb);
-            pdcch.N_alloc++;
-        }
+                                 dl_bcast[i]->alloc->msg.msg,
+                                 dl_bcast[i]->alloc->msg.N_bits);
+        memcpy(&pdcch.alloc[i], dl_bcast[i]->alloc, sizeof(LIBLTE_PHY_ALLOCATION_STRUCT));
+        pdcch.alloc[i].tbs    = dl_bcast[i]->tbs;
+        pdcch.alloc[i].mcs    = dl_bcast[i]->mcs;
+        pdcch.alloc[i].N_prb  = dl_bcast[i]->N_prb;
+        pdcch.alloc[i].rv_idx = dl_bcast[i]->rv_idx;
     }
 
     // Handle user data
+    N_sys_alloc = pdcch.N_alloc;
     dl_sched_mutex.lock();
     if(dl_schedule[dl_current_tti%10].current_tti == dl_current_tti)
     {
@@ -615,8 +726,9 @@ void LTE_fdd_enb_phy::process_dl(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *tx_buf)
     }
     dl_sched_mutex.unlock();
 
-    // Handle PDCCH and PDSCH
-    for(i=0; i<pdcch.N_alloc; i++)
+    // Handle PDCCH and PDSCH, system information is placed from PRB 0 and
+    // the MAC has already placed user data around it
+    for(i=0; i<N_sys_alloc; i++)
     {
         for(j=0; j<pdcch.alloc[i].N_prb; j++)
         {
@@ -624,6 +736,17 @@ void LTE_fdd_enb_phy::process_dl(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *tx_buf)
             pdcch.alloc[i].prb[1][j] = last_prb++;
         }
     }
+    prb_overlap = false;
+    for(i=N_sys_alloc; i<pdcch.N_alloc; i++)
+    {
+        if(LIBLTE_PHY_CHAN_TYPE_DLSCH == pdcch.alloc[i].chan_type &&
+           0                          != pdcch.alloc[i].N_prb     &&
+           (last_prb            > pdcch.alloc[i].prb[0][0] ||
+            phy_struct->N_rb_dl < (pdcch.alloc[i].prb[0][0] + pdcch.alloc[i].N_prb)))
+        {
+            prb_overlap = true;
+        }
+    }
     if(last_prb > phy_struct->N_rb_dl)
     {
         interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
@@ -631,6 +754,12 @@ void LTE_fdd_enb_phy::process_dl(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *tx_buf)
                                   __FILE__,
                                   __LINE__,
                                   "More PRBs allocated than are available");
+    }else if(prb_overlap){
+        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                                  LTE_FDD_ENB_DEBUG_LEVEL_PHY,
+                                  __FILE__,
+                                  __LINE__,
+                                  "MAC PRB allocation overlaps system information");
     }else{
         liblte_phy_pdcch_channel_encode(phy_struct,
                                         &pcfich,
@@ -641,13 +770,24 @@ void LTE_fdd_enb_phy::process_dl(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *tx_buf)
                                         liblte_rrc_phich_resource_num[sys_info.mib.phich_config.res],
                                         sys_info.mib.phich_config.dur,
                                         &dl_subframe);
-        if(0 != pdcch.N_alloc)
+        for(i=0; i<pdcch.N_alloc; i++)
         {
-            liblte_phy_pdsch_channel_encode(phy_struct,
-                                            &pdcch,
-                                            sys_info.N_id_cell,
-                                            sys_info.N_ant,
-                                            &dl_subframe);
+            if(i             <  N_sys_alloc   &&
+               bcast->N_symbs == pdcch.N_symbs &&
+               dl_bcast[i]->encoded)
+            {
+                map_bcast_res(dl_bcast[i]->idx,
+                              dl_bcast[i]->N_re,
+                              dl_bcast[i]->re,
+                              dl_bcast[i]->im);
+            }else{
+                liblte_phy_pdsch_channel_encode_alloc(phy_struct,
+                                                      &pdcch.alloc[i],
+                                                      pdcch.N_symbs,
+                                                      sys_info.N_id_cell,
+                                                      sys_info.N_ant,
+                                                      &dl_subframe);
+            }
         }
         // Clear PHICH
         for(i=0; i<25; i++)
@@ -689,6 +829,310 @@ void LTE_fdd_enb_phy::process_dl(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *tx_buf)
     radio->send(tx_buf);
 }
 
+/*************************/
+/*    Broadcast Cache    */
+/*************************/
+void LTE_fdd_enb_phy::build_bcast_cache(LTE_FDD_ENB_PHY_BCAST_CACHE_STRUCT *cache)
+{
+    LTE_FDD_ENB_SI_ALLOC_STRUCT si_alloc[LTE_FDD_ENB_CNFG_DB_MAX_SI_ALLOCS];
+    LIBLTE_RRC_MIB_STRUCT       mib;
+    LIBLTE_BIT_MSG_STRUCT       mib_msg;
+    uint32                      i;
+    uint32                      j;
+    uint32                      k;
+    uint32                      N_ant_re;
+    uint32                      N_frames;
+    uint32                      N_bcast;
+
+    N_ant_re         = cache->sys_info.N_ant*LTE_FDD_ENB_PHY_BCAST_N_PBCH_RE;
+    cache->pbch_re   = new float[LTE_FDD_ENB_PHY_BCAST_N_PBCH*N_ant_re];
+    cache->pbch_im   = new float[LTE_FDD_ENB_PHY_BCAST_N_PBCH*N_ant_re];
+    cache->pdsch     = NULL;
+    cache->N_pdsch   = 0;
+    cache->max_pdsch = 0;
+    cache->N_symbs   = pcfich.cfi;
+    if(cache->sys_info.N_rb_dl <= 10)
+    {
+        cache->N_symbs++;
+    }
+
+    // PBCH, one entry per SFN since the MIB carries SFN/4 and each of the
+    // 4 frames in between sends a different redundancy version
+    mib                          = cache->sys_info.mib;
+    bcast_phy_struct->bch_N_bits = 0;
+    clear_bcast_res(cache, 7, 10);
+    for(i=0; i<LTE_FDD_ENB_PHY_BCAST_N_PBCH; i++)
+    {
+        if(0 == (i % 4))
+        {
+            mib.sfn_div_4 = i/4;
+            liblte_rrc_pack_bcch_bch_msg(&mib,
+                                         &mib_msg);
+            memcpy(cache->mib[i/4], mib_msg.msg, mib_msg.N_bits);
+            cache->mib_N_bits = mib_msg.N_bits;
+        }
+        liblte_phy_bch_channel_encode(bcast_phy_struct,
+                                      cache->mib[i/4],
+                                      cache->mib_N_bits,
+                                      cache->sys_info.N_id_cell,
+                                      cache->sys_info.N_ant,
+                                      bcast_subframe,
+                                      i);
+        if(0 == i)
+        {
+            find_bcast_res(cache, 7, 10, cache->pbch_idx);
+        }
+        copy_bcast_res(cache,
+                       cache->pbch_idx,
+                       LTE_FDD_ENB_PHY_BCAST_N_PBCH_RE,
+                       &cache->pbch_re[i*N_ant_re],
+                       &cache->pbch_im[i*N_ant_re]);
+    }
+
+    // System information, walk a full scheduling period once to size the
+    // cache and again to encode every subframe position and redundancy
+    // version up front
+    N_frames = cache->sys_info.si_periodicity_T;
+    if(N_frames < LTE_FDD_ENB_PHY_BCAST_MIN_N_FRAMES)
+    {
+        N_frames = LTE_FDD_ENB_PHY_BCAST_MIN_N_FRAMES;
+    }
+    for(i=0; i<N_frames; i++)
+    {
+        for(j=0; j<10; j++)
+        {
+            cache->max_pdsch += LTE_fdd_enb_cnfg_db::get_sys_info_allocs(&cache->sys_info, i, j, si_alloc);
+        }
+    }
+    cache->pdsch = new LTE_FDD_ENB_PHY_BCAST_PDSCH_STRUCT[cache->max_pdsch];
+    for(i=0; i<N_frames; i++)
+    {
+        for(j=0; j<10; j++)
+        {
+            N_bcast = LTE_fdd_enb_cnfg_db::get_sys_info_allocs(&cache->sys_info, i, j, si_alloc);
+            for(k=0; k<N_bcast; k++)
+            {
+                add_bcast_pdsch(cache, &si_alloc[k], j);
+            }
+        }
+    }
+}
+void LTE_fdd_enb_phy::free_bcast_cache(LTE_FDD_ENB_PHY_BCAST_CACHE_STRUCT *cache)
+{
+    uint32 i;
+
+    if(NULL != cache)
+    {
+        for(i=0; i<cache->N_pdsch; i++)
+        {
+            delete [] cache->pdsch[i].idx;
+            delete [] cache->pdsch[i].re;
+            delete [] cache->pdsch[i].im;
+        }
+        delete [] cache->pdsch;
+        delete [] cache->pbch_re;
+        delete [] cache->pbch_im;
+        delete cache;
+    }
+}
+void LTE_fdd_enb_phy::add_bcast_pdsch(LTE_FDD_ENB_PHY_BCAST_CACHE_STRUCT *cache,
+                                      LTE_FDD_ENB_SI_ALLOC_STRUCT        *si_alloc,
+                                      uint32                              subfn)
+{
+    LTE_FDD_ENB_PHY_BCAST_PDSCH_STRUCT *pdsch;
+    uint32                              i;
+
+    if(NULL                 == find_bcast_pdsch(cache, si_alloc, subfn) &&
+       cache->max_pdsch     >  cache->N_pdsch)
+    {
+        pdsch            = &cache->pdsch[cache->N_pdsch++];
+        pdsch->alloc     = si_alloc->alloc;
+        pdsch->idx       = NULL;
+        pdsch->re        = NULL;
+        pdsch->im        = NULL;
+        pdsch->subfn     = subfn;
+        pdsch->first_prb = si_alloc->first_prb;
+        pdsch->rv_idx    = si_alloc->rv_idx;
+        pdsch->tbs       = si_alloc->tbs;
+        pdsch->N_prb     = si_alloc->N_prb;
+        pdsch->N_re      = 0;
+        pdsch->mcs       = si_alloc->mcs;
+        pdsch->encoded   = false;
+
+        // Allocations that do not fit are left to the per subframe
+        // encode so the PRB checks in process_dl still catch them
+        if((pdsch->first_prb + pdsch->N_prb) <= cache->sys_info.N_rb_dl)
+        {
+            memcpy(&bcast_alloc, pdsch->alloc, sizeof(LIBLTE_PHY_ALLOCATION_STRUCT));
+            bcast_alloc.tbs    = pdsch->tbs;
+            bcast_alloc.mcs    = pdsch->mcs;
+            bcast_alloc.N_prb  = pdsch->N_prb;
+            bcast_alloc.rv_idx = pdsch->rv_idx;
+            for(i=0; i<pdsch->N_prb; i++)
+            {
+                bcast_alloc.prb[0][i] = pdsch->first_prb + i;
+                bcast_alloc.prb[1][i] = pdsch->first_prb + i;
+            }
+            clear_bcast_res(cache, cache->N_symbs, 13);
+            bcast_subframe->num = subfn;
+            liblte_phy_pdsch_channel_encode_alloc(bcast_phy_struct,
+                                                  &bcast_alloc,
+                                                  cache->N_symbs,
+                                                  cache->sys_info.N_id_cell,
+                                                  cache->sys_info.N_ant,
+                                                  bcast_subframe);
+            pdsch->N_re    = find_bcast_res(cache, cache->N_symbs, 13, NULL);
+            pdsch->idx     = new uint16[pdsch->N_re];
+            pdsch->re      = new float[cache->sys_info.N_ant*pdsch->N_re];
+            pdsch->im      = new float[cache->sys_info.N_ant*pdsch->N_re];
+            find_bcast_res(cache, cache->N_symbs, 13, pdsch->idx);
+            copy_bcast_res(cache, pdsch->idx, pdsch->N_re, pdsch->re, pdsch->im);
+            pdsch->encoded = true;
+        }
+    }
+}
+LTE_FDD_ENB_PHY_BCAST_PDSCH_STRUCT* LTE_fdd_enb_phy::find_bcast_pdsch(LTE_FDD_ENB_PHY_BCAST_CACHE_STRUCT *cache,
+                                                                      LTE_FDD_ENB_SI_ALLOC_STRUCT        *si_alloc,
+                                                                      uint32                              subfn)
+{
+    LTE_FDD_ENB_PHY_BCAST_PDSCH_STRUCT *pdsch = NULL;
+    uint32                              i;
+
+    for(i=0; i<cache->N_pdsch && NULL == pdsch; i++)
+    {
+        if(si_alloc->alloc     == cache->pdsch[i].alloc     &&
+           subfn               == cache->pdsch[i].subfn     &&
+           si_alloc->first_prb == cache->pdsch[i].first_prb &&
+           si_alloc->rv_idx    == cache->pdsch[i].rv_idx)
+        {
+            pdsch = &cache->pdsch[i];
+        }
+    }
+
+    return(pdsch);
+}
+uint32 LTE_fdd_enb_phy::select_bcast_pdsch(uint32                               sfn,
+                                           uint32                               subfn,
+                                           LTE_FDD_ENB_PHY_BCAST_PDSCH_STRUCT **pdsch)
+{
+    LTE_FDD_ENB_SI_ALLOC_STRUCT si_alloc[LTE_FDD_ENB_CNFG_DB_MAX_SI_ALLOCS];
+    uint32                      i;
+    uint32                      N_bcast;
+
+    // The cache holds a whole scheduling period, nothing is encoded here
+    N_bcast = LTE_fdd_enb_cnfg_db::get_sys_info_allocs(&bcast->sys_info, sfn, subfn, si_alloc);
+    for(i=0; i<N_bcast; i++)
+    {
+        pdsch[i] = find_bcast_pdsch(bcast, &si_alloc[i], subfn);
+        if(NULL == pdsch[i])
+        {
+            // Not cached, leave it to the per subframe encode
+            pdsch[i]            = &bcast_miss[i];
+            pdsch[i]->alloc     = si_alloc[i].alloc;
+            pdsch[i]->subfn     = subfn;
+            pdsch[i]->first_prb = si_alloc[i].first_prb;
+            pdsch[i]->rv_idx    = si_alloc[i].rv_idx;
+            pdsch[i]->tbs       = si_alloc[i].tbs;
+            pdsch[i]->N_prb     = si_alloc[i].N_prb;
+            pdsch[i]->mcs       = si_alloc[i].mcs;
+            pdsch[i]->encoded   = false;
+        }
+    }
+
+    return(N_bcast);
+}
+void LTE_fdd_enb_phy::clear_bcast_res(LTE_FDD_ENB_PHY_BCAST_CACHE_STRUCT *cache,
+                                      uint32                              first_symb,
+                                      uint32                              last_symb)
+{
+    uint32 p;
+    uint32 i;
+    uint32 j;
+
+    for(p=0; p<cache->sys_info.N_ant; p++)
+    {
+        for(i=first_symb; i<=last_symb; i++)
+        {
+            for(j=0; j<LTE_FDD_ENB_PHY_BCAST_SYMB_STRIDE; j++)
+            {
+                bcast_subframe->tx_symb_re[p][i][j] = LTE_FDD_ENB_PHY_BCAST_UNUSED_RE;
+                bcast_subframe->tx_symb_im[p][i][j] = LTE_FDD_ENB_PHY_BCAST_UNUSED_RE;
+            }
+        }
+    }
+}
+uint32 LTE_fdd_enb_phy::find_bcast_res(LTE_FDD_ENB_PHY_BCAST_CACHE_STRUCT *cache,
+                                       uint32                              first_symb,
+                                       uint32                              last_symb,
+                                       uint16                             *idx)
+{
+    uint32 i;
+    uint32 j;
+    uint32 N_re = 0;
+
+    // Every antenna port is written at the same resource elements, so
+    // only port 0 needs to be checked for entries the encoder touched
+    for(i=first_symb; i<=last_symb; i++)
+    {
+        for(j=0; j<cache->sys_info.N_rb_dl*cache->sys_info.N_sc_rb_dl; j++)
+        {
+            if(LTE_FDD_ENB_PHY_BCAST_UNUSED_RE != bcast_subframe->tx_symb_re[0][i][j])
+            {
+                if(NULL != idx)
+                {
+                    idx[N_re] = i*LTE_FDD_ENB_PHY_BCAST_SYMB_STRIDE + j;
+                }
+                N_re++;
+            }
+        }
+    }
+
+    return(N_re);
+}
+void LTE_fdd_enb_phy::copy_bcast_res(LTE_FDD_ENB_PHY_BCAST_CACHE_STRUCT *cache,
+                                     uint16                             *idx,
+                                     uint32                              N_re,
+                                     float                              *re,
+                                     float                              *im)
+{
+    float  *symb_re;
+    float  *symb_im;
+    uint32  p;
+    uint32  i;
+
+    for(p=0; p<cache->sys_info.N_ant; p++)
+    {
+        symb_re = &bcast_subframe->tx_symb_re[p][0][0];
+        symb_im = &bcast_subframe->tx_symb_im[p][0][0];
+        for(i=0; i<N_re; i++)
+        {
+            re[p*N_re + i] = symb_re[idx[i]];
+            im[p*N_re + i] = symb_im[idx[i]];
+        }
+    }
+}
+void LTE_fdd_enb_phy::map_bcast_res(uint16 *idx,
+                                    uint32  N_re,
+                                    float  *re,
+                                    float  *im)
+{
+    float  *symb_re;
+    float  *symb_im;
+    uint32  p;
+    uint32  i;
+
+    for(p=0; p<sys_info.N_ant; p++)
+    {
+        symb_re = &dl_subframe.tx_symb_re[p][0][0];
+        symb_im = &dl_subframe.tx_symb_im[p][0][0];
+        for(i=0; i<N_re; i++)
+        {
+            symb_re[idx[i]] = re[p*N_re + i];
+            symb_im[idx[i]] = im[p*N_re + i];
+        }
+    }
+}
+
 /****************/
 /*    Uplink    */
 /****************/
@@ -774,6 +1218,13 @@ void LTE_fdd_enb_phy::process_ul(LTE_FDD_ENB_RADIO_RX_BUF_STRUCT *rx_buf)
                 {
                     pusch_decode.current_tti = ul_current_tti;
                     pusch_decode.rnti        = ul_schedule[ul_subframe.num].decodes.alloc[i].rnti;
+                    if(LIBLTE_SUCCESS != liblte_phy_pusch_estimate_sinr(phy_struct,
+                                                                        &ul_subframe,
+                                                                        &ul_schedule[ul_subframe.num].decodes.alloc[i],
+                                                                        &pusch_decode.sinr_db))
+                    {
+                        pusch_decode.sinr_db = LIBLTE_PHY_PUSCH_SINR_MIN_DB;
+                    }
 
                     LTE_fdd_enb_msgq::send(phy_mac_mq,
                                            LTE_FDD_ENB_MESSAGE_TYPE_PUSCH_DECODE,
@@ -35,6 +35,17 @@
     04/12/2014    Ben Wojtowicz    Pulled in a patch from Max Suraev for more
                                    descriptive start failures.
     06/15/2014    Ben Wojtowicz    Changed fn_combo to current_tti.
+    10/19/2026    agent            Replaced the on-stack ping-pong buffers with
+                                   a preallocated, hugepage backed RX/TX
+                                   buffer pair, added overrun and underrun
+                                   counters, and flattened the sample
+                                   conversion loops.
+    10/19/2026    agent            Added a no_rf loopback mode that can run
+                                   unpaced or sped up, inject UL samples from
+                                   a file or generated PRACHs, and report
+                                   processing statistics.
+    10/19/2026    agent            Using libtools_samp_conv for the sample
+                                   conversions.
 
 *******************************************************************************/
 
@@ -44,11 +55,14 @@
 
 #include "LTE_fdd_enb_radio.h"
 #include "LTE_fdd_enb_phy.h"
+#include "LTE_fdd_enb_mac.h"
 #include "liblte_interface.h"
+#include "libtools_samp_conv.h"
 #include <uhd/device.hpp>
 #include <uhd/types/device_addr.hpp>
 #include <uhd/property_tree.hpp>
 #include <uhd/utils/thread_priority.hpp>
+#include <sys/mman.h>
 
 /*******************************************************************************
                               DEFINES
@@ -57,6 +71,11 @@
 // Change this to 1 to turn on RADIO DEBUG
 #define EXTRA_RADIO_DEBUG 0
 
+#define LTE_FDD_ENB_RADIO_HUGEPAGE_SIZE (2*1024*1024)
+
+// Longest time an unpaced no_rf radio waits for the MAC to deliver a schedule
+#define LTE_FDD_ENB_RADIO_NO_RF_SCHED_TIMEOUT_NS 1000000
+
 /*******************************************************************************
                               TYPEDEFS
 *******************************************************************************/
@@ -114,12 +133,27 @@ LTE_fdd_enb_radio::LTE_fdd_enb_radio()
     tx_gain    = 0;
     rx_gain    = 0;
 
+    // Setup subframe buffers
+    subfr_buf = NULL;
+    alloc_subfr_buf();
+
+    // Setup no_rf loopback
+    no_rf_ul_file_name     = "none";
+    no_rf_ul_file          = NULL;
+    no_rf_speedup          = 1;
+    no_rf_prach_period     = 0;
+    no_rf_N_subfrs         = 0;
+    no_rf_next_prach_subfr = 0;
+    no_rf_N_prachs         = 0;
+    LTE_fdd_enb_interface::reset_proc_time(&no_rf_subfr_proc_time);
+
     // Start/Stop
     started = false;
 }
 LTE_fdd_enb_radio::~LTE_fdd_enb_radio()
 {
     stop();
+    free_subfr_buf();
 }
 
 /********************/
@@ -142,7 +176,8 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_radio::start(void)
     int64                      dl_earfcn;
     int64                      ul_earfcn;
 
-    if(false == started)
+    if(false == started &&
+       NULL  != subfr_buf)
     {
         if(0 != selected_radio_idx)
         {
@@ -208,9 +243,10 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_radio::start(void)
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_radio::stop(void)
 {
-    boost::mutex::scoped_lock lock(start_mutex);
-    uhd::stream_cmd_t         cmd = uhd::stream_cmd_t::STREAM_MODE_STOP_CONTINUOUS;
-    LTE_FDD_ENB_ERROR_ENUM    err = LTE_FDD_ENB_ERROR_CANT_STOP;
+    boost::mutex::scoped_lock  lock(start_mutex);
+    LTE_fdd_enb_interface     *interface = LTE_fdd_enb_interface::get_instance();
+    uhd::stream_cmd_t          cmd       = uhd::stream_cmd_t::STREAM_MODE_STOP_CONTINUOUS;
+    LTE_FDD_ENB_ERROR_ENUM     err       = LTE_FDD_ENB_ERROR_CANT_STOP;
 
     if(started)
     {
@@ -222,6 +258,23 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_radio::stop(void)
         sleep(1);
         pthread_cancel(radio_thread);
         pthread_join(radio_thread, NULL);
+        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                                  LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
+                                  __FILE__,
+                                  __LINE__,
+                                  "Radio stopped, rx_overruns=%u tx_underruns=%u",
+                                  buf_stats.N_rx_overruns,
+                                  buf_stats.N_tx_underruns);
+        if(0 == selected_radio_idx)
+        {
+            interface->send_ctrl_info_msg("no_rf_stats %s",
+                                          get_no_rf_stats().c_str());
+            if(NULL != no_rf_ul_file)
+            {
+                fclose(no_rf_ul_file);
+                no_rf_ul_file = NULL;
+            }
+        }
         err = LTE_FDD_ENB_ERROR_NONE;
     }
 
@@ -426,8 +479,6 @@ void LTE_fdd_enb_radio::send(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *buf)
     uhd::tx_metadata_t     metadata;
     uint32                 samps_to_send = N_samps_per_subfr;
     uint32                 idx           = 0;
-    uint32                 i;
-    uint32                 p;
     uint16                 N_skipped_subfrs;
 
     if(0 != selected_radio_idx)
@@ -447,8 +498,9 @@ void LTE_fdd_enb_radio::send(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *buf)
                 N_skipped_subfrs = (buf->current_tti + LTE_FDD_ENB_CURRENT_TTI_MAX + 1) - next_tx_current_tti;
             }
 
-            next_tx_ts          += uhd::time_spec_t::from_ticks(N_skipped_subfrs*N_samps_per_subfr, fs);
-            next_tx_current_tti  = (buf->current_tti + 1) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1);
+            buf_stats.N_tx_underruns += N_skipped_subfrs;
+            next_tx_ts               += uhd::time_spec_t::from_ticks(N_skipped_subfrs*N_samps_per_subfr, fs);
+            next_tx_current_tti       = (buf->current_tti + 1) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1);
         }else{
             next_tx_current_tti = (next_tx_current_tti + 1) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1);
         }
@@ -456,15 +508,7 @@ void LTE_fdd_enb_radio::send(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *buf)
         while(samps_to_send > N_tx_samps)
         {
             metadata.time_spec = next_tx_ts;
-            for(i=0; i<N_tx_samps; i++)
-            {
-                tx_buf[i] = gr_complex(buf->i_buf[0][idx+i]/50.0, buf->q_buf[0][idx+i]/50.0);
-                for(p=1; p<N_ant; p++)
-                {
-                    tx_buf[i] += gr_complex(buf->i_buf[p][idx+i]/50.0, buf->q_buf[p][idx+i]/50.0);
-                }
-                tx_buf[i] /= N_ant;
-            }
+            convert_tx_samps(buf, idx, N_tx_samps);
 #if EXTRA_RADIO_DEBUG
             interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
                                       LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
@@ -482,15 +526,7 @@ void LTE_fdd_enb_radio::send(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *buf)
         if(0 != samps_to_send)
         {
             metadata.time_spec = next_tx_ts;
-            for(i=0; i<samps_to_send; i++)
-            {
-                tx_buf[i] = gr_complex(buf->i_buf[0][idx+i]/50.0, buf->q_buf[0][idx+i]/50.0);
-                for(p=1; p<N_ant; p++)
-                {
-                    tx_buf[i] += gr_complex(buf->i_buf[p][idx+i]/50.0, buf->q_buf[p][idx+i]/50.0);
-                }
-                tx_buf[i] /= N_ant;
-            }
+            convert_tx_samps(buf, idx, samps_to_send);
 #if EXTRA_RADIO_DEBUG
             interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
                                       LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
@@ -505,6 +541,106 @@ void LTE_fdd_enb_radio::send(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *buf)
         }
     }
 }
+LTE_FDD_ENB_RADIO_BUF_STATS_STRUCT LTE_fdd_enb_radio::get_buf_stats(void)
+{
+    return(buf_stats);
+}
+uint32 LTE_fdd_enb_radio::get_no_rf_speedup(void)
+{
+    return(no_rf_speedup);
+}
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_radio::set_no_rf_speedup(uint32 speedup)
+{
+    boost::mutex::scoped_lock lock(start_mutex);
+    LTE_FDD_ENB_ERROR_ENUM    err = LTE_FDD_ENB_ERROR_ALREADY_STARTED;
+
+    if(!started)
+    {
+        no_rf_speedup = speedup;
+        err           = LTE_FDD_ENB_ERROR_NONE;
+    }
+
+    return(err);
+}
+std::string LTE_fdd_enb_radio::get_no_rf_ul_file(void)
+{
+    return(no_rf_ul_file_name);
+}
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_radio::set_no_rf_ul_file(std::string file_name)
+{
+    boost::mutex::scoped_lock lock(start_mutex);
+    LTE_FDD_ENB_ERROR_ENUM    err = LTE_FDD_ENB_ERROR_ALREADY_STARTED;
+
+    if(!started)
+    {
+        no_rf_ul_file_name = file_name;
+        err                = LTE_FDD_ENB_ERROR_NONE;
+    }
+
+    return(err);
+}
+uint32 LTE_fdd_enb_radio::get_no_rf_prach_period(void)
+{
+    return(no_rf_prach_period);
+}
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_radio::set_no_rf_prach_period(uint32 period)
+{
+    boost::mutex::scoped_lock lock(start_mutex);
+    LTE_FDD_ENB_ERROR_ENUM    err = LTE_FDD_ENB_ERROR_ALREADY_STARTED;
+
+    if(!started)
+    {
+        no_rf_prach_period = period;
+        err                = LTE_FDD_ENB_ERROR_NONE;
+    }
+
+    return(err);
+}
+std::string LTE_fdd_enb_radio::get_no_rf_stats(void)
+{
+    LTE_fdd_enb_phy              *phy = LTE_fdd_enb_phy::get_instance();
+    LTE_fdd_enb_mac              *mac = LTE_fdd_enb_mac::get_instance();
+    LTE_FDD_ENB_PROC_TIME_STRUCT  ul_time    = phy->get_ul_proc_time();
+    LTE_FDD_ENB_PROC_TIME_STRUCT  dl_time    = phy->get_dl_proc_time();
+    LTE_FDD_ENB_PROC_TIME_STRUCT  sched_time = mac->get_sched_proc_time();
+    LTE_FDD_ENB_PROC_TIME_STRUCT  subfr_time = no_rf_subfr_proc_time;
+    struct timespec               now;
+    char                          stats[1024];
+    double                        secs = 0;
+
+    if(0 != no_rf_N_subfrs)
+    {
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        secs  = (double)(now.tv_sec - no_rf_start_time.tv_sec);
+        secs += (double)(now.tv_nsec - no_rf_start_time.tv_nsec)/1000000000.0;
+    }
+
+    // Avoid divides by zero before anything has run
+    ul_time.N_runs    = (0 == ul_time.N_runs)    ? 1 : ul_time.N_runs;
+    dl_time.N_runs    = (0 == dl_time.N_runs)    ? 1 : dl_time.N_runs;
+    sched_time.N_runs = (0 == sched_time.N_runs) ? 1 : sched_time.N_runs;
+    subfr_time.N_runs = (0 == subfr_time.N_runs) ? 1 : subfr_time.N_runs;
+
+    snprintf(stats,
+             sizeof(stats),
+             "subfrs=%llu secs=%.3f subfrs_per_sec=%.1f subfr_avg_us=%.1f subfr_max_us=%.1f phy_ul_avg_us=%.1f phy_ul_max_us=%.1f phy_dl_avg_us=%.1f phy_dl_max_us=%.1f mac_sched_avg_us=%.1f mac_sched_max_us=%.1f prachs=%u rx_overruns=%u tx_underruns=%u",
+             no_rf_N_subfrs,
+             secs,
+             (0 != secs) ? no_rf_N_subfrs/secs : 0,
+             subfr_time.total_ns/subfr_time.N_runs/1000.0,
+             subfr_time.max_ns/1000.0,
+             ul_time.total_ns/ul_time.N_runs/1000.0,
+             ul_time.max_ns/1000.0,
+             dl_time.total_ns/dl_time.N_runs/1000.0,
+             dl_time.max_ns/1000.0,
+             sched_time.total_ns/sched_time.N_runs/1000.0,
+             sched_time.max_ns/1000.0,
+             no_rf_N_prachs,
+             buf_stats.N_rx_overruns,
+             buf_stats.N_tx_underruns);
+
+    return(std::string(stats));
+}
 
 /**********************/
 /*    Radio Thread    */
@@ -512,12 +648,10 @@ void LTE_fdd_enb_radio::send(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *buf)
 void* LTE_fdd_enb_radio::radio_thread_func(void *inputs)
 {
     LTE_fdd_enb_interface           *interface = LTE_fdd_enb_interface::get_instance();
-    LTE_fdd_enb_phy                 *phy       = LTE_fdd_enb_phy::get_instance();
     LTE_fdd_enb_radio               *radio     = LTE_fdd_enb_radio::get_instance();
-    LTE_FDD_ENB_RADIO_TX_BUF_STRUCT  tx_radio_buf[2];
-    LTE_FDD_ENB_RADIO_RX_BUF_STRUCT  rx_radio_buf[2];
-    struct timespec                  sleep_time;
-    struct timespec                  time_rem;
+    LTE_fdd_enb_phy                 *phy       = LTE_fdd_enb_phy::get_instance();
+    LTE_FDD_ENB_RADIO_BUF_STRUCT    *buf       = radio->subfr_buf;
+    struct timespec                  subfr_start_time;
     struct sched_param               priority;
     uhd::rx_metadata_t               metadata;
     uhd::time_spec_t                 next_rx_ts;
@@ -526,11 +660,9 @@ void* LTE_fdd_enb_radio::radio_thread_func(void *inputs)
     uhd::stream_cmd_t                cmd = uhd::stream_cmd_t::STREAM_MODE_START_CONTINUOUS;
     int64                            next_rx_ts_ticks;
     int64                            metadata_ts_ticks;
-    uint32                           i;
     uint32                           N_subfrs_dropped;
     uint32                           recv_size      = radio->N_rx_samps;
     uint32                           samp_rate      = radio->fs;
-    uint32                           buf_idx        = 0;
     uint32                           recv_idx       = 0;
     uint32                           samp_idx       = 0;
     uint32                           num_samps      = 0;
@@ -544,9 +676,18 @@ void* LTE_fdd_enb_radio::radio_thread_func(void *inputs)
     priority.sched_priority = 99;
     pthread_setschedparam(radio->radio_thread, SCHED_FIFO, &priority);
 
-    // Setup sleep time for no_rf device
-    sleep_time.tv_sec  = 0;
-    sleep_time.tv_nsec = 1000000;
+    // The PHY runs each subframe to completion inside radio_interface and
+    // sends the DL before returning, so one RX/TX buffer pair is reused for
+    // every subframe
+    memset(buf, 0, sizeof(LTE_FDD_ENB_RADIO_BUF_STRUCT));
+    radio->buf_stats.N_rx_overruns  = 0;
+    radio->buf_stats.N_tx_underruns = 0;
+    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                              LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
+                              __FILE__,
+                              __LINE__,
+                              "Radio subframe buffers using %s",
+                              radio->subfr_buf_hugepages ? "hugepages" : "regular pages");
 
     while(not_done &&
           radio->is_started())
@@ -555,15 +696,25 @@ void* LTE_fdd_enb_radio::radio_thread_func(void *inputs)
         {
             if(init_needed)
             {
+                radio->no_rf_setup();
+
                 // Signal PHY to generate first subframe
-                phy->radio_interface(&tx_radio_buf[1]);
+                phy->radio_interface(&buf->tx_buf);
                 init_needed = false;
             }
-            rx_radio_buf[buf_idx].current_tti = rx_current_tti;
-            phy->radio_interface(&tx_radio_buf[buf_idx], &rx_radio_buf[buf_idx]);
-            buf_idx        = (buf_idx + 1) % 2;
+
+            // Build the simulated uplink subframe
+            buf->rx_buf.current_tti = rx_current_tti;
+            radio->no_rf_fill_rx_buf(buf);
+
+            // Pace the subframe and hand it to the PHY
+            radio->no_rf_wait();
+            clock_gettime(CLOCK_MONOTONIC, &subfr_start_time);
+            phy->radio_interface(&buf->tx_buf, &buf->rx_buf);
+            LTE_fdd_enb_interface::update_proc_time(&radio->no_rf_subfr_proc_time, &subfr_start_time);
+            radio->no_rf_N_subfrs++;
+
             rx_current_tti = (rx_current_tti + 1) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1);
-            nanosleep(&sleep_time, &time_rem);
         }else{
             if(init_needed)
             {
@@ -577,7 +728,7 @@ void* LTE_fdd_enb_radio::radio_thread_func(void *inputs)
                 radio->usrp->set_time_now(uhd::time_spec_t::from_ticks(0, samp_rate));
 
                 // Signal PHY to generate first subframe
-                phy->radio_interface(&tx_radio_buf[1]);
+                phy->radio_interface(&buf->tx_buf);
 
                 // Start streaming
                 cmd.stream_now = true;
@@ -654,7 +805,8 @@ void* LTE_fdd_enb_radio::radio_thread_func(void *inputs)
                                                   next_rx_ts_ticks);
 
                         // Determine how many subframes we are going to drop
-                        N_subfrs_dropped = ((metadata_ts_ticks - next_rx_ts_ticks)/radio->N_samps_per_subfr) + 2;
+                        N_subfrs_dropped                = ((metadata_ts_ticks - next_rx_ts_ticks)/radio->N_samps_per_subfr) + 2;
+                        radio->buf_stats.N_rx_overruns += N_subfrs_dropped;
 
                         // Jump the rx_current_tti
                         rx_current_tti = (rx_current_tti + N_subfrs_dropped) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1);
@@ -681,11 +833,10 @@ void* LTE_fdd_enb_radio::radio_thread_func(void *inputs)
                         {
                             if((samp_idx + num_samps) <= radio->N_samps_per_subfr)
                             {
-                                for(i=0; i<num_samps; i++)
-                                {
-                                    rx_radio_buf[buf_idx].i_buf[samp_idx+i] = radio->rx_buf[recv_idx+i].real();
-                                    rx_radio_buf[buf_idx].q_buf[samp_idx+i] = radio->rx_buf[recv_idx+i].imag();
-                                }
+                                radio->convert_rx_samps(&radio->rx_buf[recv_idx],
+                                                        &buf->rx_buf.i_buf[samp_idx],
+                                                        &buf->rx_buf.q_buf[samp_idx],
+                                                        num_samps);
                                 samp_idx += num_samps;
 
                                 if(samp_idx == radio->N_samps_per_subfr)
@@ -699,20 +850,18 @@ void* LTE_fdd_enb_radio::radio_thread_func(void *inputs)
                                                               next_rx_subfr_ts.to_ticks(samp_rate),
                                                               rx_current_tti);
 #endif
-                                    rx_radio_buf[buf_idx].current_tti = rx_current_tti;
-                                    phy->radio_interface(&tx_radio_buf[buf_idx], &rx_radio_buf[buf_idx]);
-                                    buf_idx           = (buf_idx + 1) % 2;
+                                    buf->rx_buf.current_tti = rx_current_tti;
+                                    phy->radio_interface(&buf->tx_buf, &buf->rx_buf);
                                     rx_current_tti    = (rx_current_tti + 1) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1);
                                     samp_idx          = 0;
                                     next_rx_subfr_ts += uhd::time_spec_t::from_ticks(radio->N_samps_per_subfr, samp_rate);
                                 }
                                 num_samps = 0;
                             }else{
-                                for(i=0; i<(radio->N_samps_per_subfr - samp_idx); i++)
-                                {
-                                    rx_radio_buf[buf_idx].i_buf[samp_idx+i] = radio->rx_buf[recv_idx+i].real();
-                                    rx_radio_buf[buf_idx].q_buf[samp_idx+i] = radio->rx_buf[recv_idx+i].imag();
-                                }
+                                radio->convert_rx_samps(&radio->rx_buf[recv_idx],
+                                                        &buf->rx_buf.i_buf[samp_idx],
+                                                        &buf->rx_buf.q_buf[samp_idx],
+                                                        radio->N_samps_per_subfr - samp_idx);
 
 #if EXTRA_RADIO_DEBUG
                                 interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
@@ -723,9 +872,8 @@ void* LTE_fdd_enb_radio::radio_thread_func(void *inputs)
                                                           next_rx_subfr_ts.to_ticks(samp_rate),
                                                           rx_current_tti);
 #endif
-                                rx_radio_buf[buf_idx].current_tti = rx_current_tti;
-                                phy->radio_interface(&tx_radio_buf[buf_idx], &rx_radio_buf[buf_idx]);
-                                buf_idx           = (buf_idx + 1) % 2;
+                                buf->rx_buf.current_tti = rx_current_tti;
+                                phy->radio_interface(&buf->tx_buf, &buf->rx_buf);
                                 rx_current_tti    = (rx_current_tti + 1) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1);
                                 num_samps        -= (radio->N_samps_per_subfr - samp_idx);
                                 recv_idx          = (radio->N_samps_per_subfr - samp_idx);
@@ -746,3 +894,200 @@ void* LTE_fdd_enb_radio::radio_thread_func(void *inputs)
         }
     }
 }
+
+/**************************/
+/*    Subframe Buffers    */
+/**************************/
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_radio::alloc_subfr_buf(void)
+{
+    LTE_FDD_ENB_ERROR_ENUM  err = LTE_FDD_ENB_ERROR_BAD_ALLOC;
+    void                   *mem = MAP_FAILED;
+
+    // Round the buffer pair up to a whole number of hugepages
+    subfr_buf_size  = sizeof(LTE_FDD_ENB_RADIO_BUF_STRUCT);
+    subfr_buf_size  = (subfr_buf_size + LTE_FDD_ENB_RADIO_HUGEPAGE_SIZE - 1) / LTE_FDD_ENB_RADIO_HUGEPAGE_SIZE;
+    subfr_buf_size *= LTE_FDD_ENB_RADIO_HUGEPAGE_SIZE;
+
+    // Try hugepages first, falling back to regular pages
+#ifdef MAP_HUGETLB
+    mem                 = mmap(NULL,
+                               subfr_buf_size,
+                               PROT_READ | PROT_WRITE,
+                               MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+                               -1,
+                               0);
+#endif
+    subfr_buf_hugepages = (MAP_FAILED != mem);
+    if(MAP_FAILED == mem)
+    {
+        mem = mmap(NULL,
+                   subfr_buf_size,
+                   PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS,
+                   -1,
+                   0);
+    }
+
+    if(MAP_FAILED != mem)
+    {
+        // Keep the buffers resident so the radio thread never takes a page fault
+        mlock(mem, subfr_buf_size);
+        memset(mem, 0, subfr_buf_size);
+
+        subfr_buf                = (LTE_FDD_ENB_RADIO_BUF_STRUCT *)mem;
+        buf_stats.N_rx_overruns  = 0;
+        buf_stats.N_tx_underruns = 0;
+        err                      = LTE_FDD_ENB_ERROR_NONE;
+    }else{
+        subfr_buf = NULL;
+    }
+
+    return(err);
+}
+void LTE_fdd_enb_radio::free_subfr_buf(void)
+{
+    if(NULL != subfr_buf)
+    {
+        munlock(subfr_buf, subfr_buf_size);
+        munmap(subfr_buf, subfr_buf_size);
+        subfr_buf = NULL;
+    }
+}
+void LTE_fdd_enb_radio::convert_rx_samps(const gr_complex *in,
+                                         float            *i_buf,
+                                         float            *q_buf,
+                                         uint32            N_samps)
+{
+    libtools_samp_conv_to_split(LIBTOOLS_SAMP_CONV_FORMAT_CF32,
+                                in,
+                                1.0,
+                                i_buf,
+                                q_buf,
+                                N_samps);
+}
+void LTE_fdd_enb_radio::convert_tx_samps(LTE_FDD_ENB_RADIO_TX_BUF_STRUCT *buf,
+                                         uint32                           idx,
+                                         uint32                           N_samps)
+{
+    const float *i_bufs[LIBTOOLS_SAMP_CONV_N_BUFS_MAX];
+    const float *q_bufs[LIBTOOLS_SAMP_CONV_N_BUFS_MAX];
+    uint32       p;
+
+    // Combine the antennas and scale in a single pass
+    for(p=0; p<N_ant; p++)
+    {
+        i_bufs[p] = &buf->i_buf[p][idx];
+        q_bufs[p] = &buf->q_buf[p][idx];
+    }
+    libtools_samp_conv_from_split(i_bufs,
+                                  q_bufs,
+                                  N_ant,
+                                  1.0 / (50.0 * N_ant),
+                                  LIBTOOLS_SAMP_CONV_FORMAT_CF32,
+                                  tx_buf,
+                                  N_samps);
+}
+
+/************************/
+/*    No RF Loopback    */
+/************************/
+void LTE_fdd_enb_radio::no_rf_setup(void)
+{
+    LTE_fdd_enb_interface *interface = LTE_fdd_enb_interface::get_instance();
+
+    no_rf_N_subfrs         = 0;
+    no_rf_next_prach_subfr = 0;
+    no_rf_N_prachs         = 0;
+    LTE_fdd_enb_interface::reset_proc_time(&no_rf_subfr_proc_time);
+
+    // Open the UL sample file, samples are interleaved 32 bit floats
+    if(NULL != no_rf_ul_file)
+    {
+        fclose(no_rf_ul_file);
+        no_rf_ul_file = NULL;
+    }
+    if(no_rf_ul_file_name != "none")
+    {
+        no_rf_ul_file = fopen(no_rf_ul_file_name.c_str(), "rb");
+        if(NULL == no_rf_ul_file)
+        {
+            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                                      LTE_FDD_ENB_DEBUG_LEVEL_RADIO,
+                                      __FILE__,
+                                      __LINE__,
+                                      "Unable to open %s, looping back DL instead",
+                                      no_rf_ul_file_name.c_str());
+        }
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &no_rf_start_time);
+    no_rf_next_subfr_time = no_rf_start_time;
+}
+void LTE_fdd_enb_radio::no_rf_fill_rx_buf(LTE_FDD_ENB_RADIO_BUF_STRUCT *buf)
+{
+    LTE_fdd_enb_phy *phy = LTE_fdd_enb_phy::get_instance();
+    size_t           N_read;
+
+    if(NULL != no_rf_ul_file)
+    {
+        // Play back the file, wrapping at the end
+        N_read = fread(rx_buf, sizeof(gr_complex), N_samps_per_subfr, no_rf_ul_file);
+        if(N_read < N_samps_per_subfr)
+        {
+            rewind(no_rf_ul_file);
+            N_read += fread(&rx_buf[N_read], sizeof(gr_complex), N_samps_per_subfr - N_read, no_rf_ul_file);
+        }
+        convert_rx_samps(rx_buf, buf->rx_buf.i_buf, buf->rx_buf.q_buf, N_read);
+        memset(&buf->rx_buf.i_buf[N_read], 0, sizeof(float)*(N_samps_per_subfr - N_read));
+        memset(&buf->rx_buf.q_buf[N_read], 0, sizeof(float)*(N_samps_per_subfr - N_read));
+    }else{
+        // Loop the last DL subframe back as UL
+        memcpy(buf->rx_buf.i_buf, buf->tx_buf.i_buf[0], sizeof(float)*N_samps_per_subfr);
+        memcpy(buf->rx_buf.q_buf, buf->tx_buf.q_buf[0], sizeof(float)*N_samps_per_subfr);
+    }
+
+    // Inject a PRACH, cycling through the preambles
+    if(0                      != no_rf_prach_period     &&
+       no_rf_next_prach_subfr <= no_rf_N_subfrs         &&
+       phy->is_prach_subframe(buf->rx_buf.current_tti))
+    {
+        memset(buf->rx_buf.i_buf, 0, sizeof(float)*N_samps_per_subfr);
+        memset(buf->rx_buf.q_buf, 0, sizeof(float)*N_samps_per_subfr);
+        if(LTE_FDD_ENB_ERROR_NONE == phy->generate_prach(no_rf_N_prachs % 64,
+                                                         buf->rx_buf.i_buf,
+                                                         buf->rx_buf.q_buf))
+        {
+            no_rf_N_prachs++;
+        }
+        no_rf_next_prach_subfr = no_rf_N_subfrs + no_rf_prach_period;
+    }
+}
+void LTE_fdd_enb_radio::no_rf_wait(void)
+{
+    LTE_fdd_enb_phy *phy = LTE_fdd_enb_phy::get_instance();
+    struct timespec  poll_time;
+    uint32           waited_ns;
+
+    if(0 != no_rf_speedup)
+    {
+        // Sleep to an absolute deadline so pacing errors do not accumulate
+        no_rf_next_subfr_time.tv_nsec += 1000000 / no_rf_speedup;
+        while(no_rf_next_subfr_time.tv_nsec >= 1000000000)
+        {
+            no_rf_next_subfr_time.tv_sec++;
+            no_rf_next_subfr_time.tv_nsec -= 1000000000;
+        }
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &no_rf_next_subfr_time, NULL);
+    }else{
+        // Unpaced, only wait as long as the MAC needs to deliver a schedule
+        poll_time.tv_sec  = 0;
+        poll_time.tv_nsec = 10000;
+        waited_ns         = 0;
+        while(!phy->is_dl_schedule_ready() &&
+              waited_ns < LTE_FDD_ENB_RADIO_NO_RF_SCHED_TIMEOUT_NS)
+        {
+            nanosleep(&poll_time, NULL);
+            waited_ns += poll_time.tv_nsec;
+        }
+    }
+}
@@ -28,6 +28,17 @@
     05/04/2014    Ben Wojtowicz    Created file
     06/15/2014    Ben Wojtowicz    Added more states and procedures, QoS, MME,
                                    RLC, and uplink scheduling functionality.
+    10/19/2026    agent            Removed the UL scheduling timer, QoS now
+                                   sets up UL polling in the MAC.
+    10/19/2026    agent            Replaced the RLC reception buffer map with
+                                   array based AM transmit/receive windows
+                                   backed by a buffer pool and added the RLC
+                                   AM state variables and timers.
+    10/19/2026    agent            Added the RLC UM state variables, reordering
+                                   window, segmentation/concatenation, and
+                                   per bearer UM counters.
+    10/19/2026    agent            Added PDCP configurations, state variables,
+                                   reordering buffer, and throughput counters.
 
 *******************************************************************************/
 
@@ -36,9 +47,11 @@
 *******************************************************************************/
 
 #include "LTE_fdd_enb_rb.h"
-#include "LTE_fdd_enb_timer_mgr.h"
 #include "LTE_fdd_enb_user.h"
 #include "LTE_fdd_enb_mac.h"
+#include "LTE_fdd_enb_rlc.h"
+#include "LTE_fdd_enb_pdcp.h"
+#include "LTE_fdd_enb_timer_mgr.h"
 
 /*******************************************************************************
                               DEFINES
@@ -65,13 +78,11 @@
 LTE_fdd_enb_rb::LTE_fdd_enb_rb(LTE_FDD_ENB_RB_ENUM  _rb,
                                LTE_fdd_enb_user    *_user)
 {
-    LTE_fdd_enb_timer_mgr *timer_mgr = LTE_fdd_enb_timer_mgr::get_instance();
+    uint32 i;
 
     rb   = _rb;
     user = _user;
 
-    timer_mgr->stop_timer(ul_sched_timer_id);
-
     if(LTE_FDD_ENB_RB_SRB0 == rb)
     {
         rrc_procedure = LTE_FDD_ENB_RRC_PROC_IDLE;
@@ -82,18 +93,58 @@ LTE_fdd_enb_rb::LTE_fdd_enb_rb(LTE_FDD_ENB_RB_ENUM  _rb,
     }else if(LTE_FDD_ENB_RB_SRB1 == rb){
         rrc_procedure = LTE_FDD_ENB_RRC_PROC_IDLE;
         rrc_state     = LTE_FDD_ENB_RRC_STATE_IDLE;
-        pdcp_config   = LTE_FDD_ENB_PDCP_CONFIG_N_A;
+        pdcp_config   = LTE_FDD_ENB_PDCP_CONFIG_SRB;
         rlc_config    = LTE_FDD_ENB_RLC_CONFIG_AM;
         mac_config    = LTE_FDD_ENB_MAC_CONFIG_TM;
     }
 
+    // PDCP
+    for(i=0; i<LTE_FDD_ENB_PDCP_MAX_REORDERING_WINDOW; i++)
+    {
+        pdcp_reordering_buffer[i] = NULL;
+    }
+    pdcp_t_reordering_id = LTE_FDD_ENB_RLC_INVALID_TIMER_ID;
+    memset(&pdcp_stats, 0, sizeof(pdcp_stats));
+    set_pdcp_config(pdcp_config);
+
     // RLC
-    rlc_reception_buffer.clear();
-    rlc_vrr              = 0;
-    rlc_vrmr             = rlc_vrr + LIBLTE_RLC_AM_WINDOW_SIZE;
-    rlc_vrh              = 0;
-    rlc_first_segment_sn = 0xFFFF;
-    rlc_last_segment_sn  = 0xFFFF;
+    for(i=0; i<LIBLTE_RLC_AM_WINDOW_SIZE; i++)
+    {
+        rlc_reception_buffer[i].data    = NULL;
+        rlc_transmission_buffer[i].data = NULL;
+    }
+    for(i=0; i<LIBLTE_RLC_UM_WINDOW_SIZE_SN_10_BITS; i++)
+    {
+        rlc_um_reception_buffer[i].pdu = NULL;
+    }
+    for(i=0; i<LTE_FDD_ENB_RLC_TIMER_N_ITEMS; i++)
+    {
+        rlc_timer_id[i] = LTE_FDD_ENB_RLC_INVALID_TIMER_ID;
+    }
+    rlc_timer_m_seconds[LTE_FDD_ENB_RLC_TIMER_T_POLL_RETRANSMIT] = LTE_FDD_ENB_RLC_AM_T_POLL_RETRANSMIT;
+    rlc_timer_m_seconds[LTE_FDD_ENB_RLC_TIMER_T_REORDERING]      = LTE_FDD_ENB_RLC_AM_T_REORDERING;
+    rlc_timer_m_seconds[LTE_FDD_ENB_RLC_TIMER_T_STATUS_PROHIBIT] = LTE_FDD_ENB_RLC_AM_T_STATUS_PROHIBIT;
+    rlc_poll_pdu                                                 = LTE_FDD_ENB_RLC_AM_POLL_PDU;
+    rlc_poll_byte                                                = LTE_FDD_ENB_RLC_AM_POLL_BYTE;
+    rlc_max_retx_threshold                                       = LTE_FDD_ENB_RLC_AM_MAX_RETX_THRESHOLD;
+    rlc_reassembly_sdu.N_bits                                    = 0;
+    rlc_pdu_without_poll                                         = 0;
+    rlc_byte_without_poll                                        = 0;
+    set_rlc_vrr(0);
+    rlc_vrx                                                      = 0;
+    rlc_vrms                                                     = 0;
+    rlc_vrh                                                      = 0;
+    set_rlc_vta(0);
+    rlc_vts                                                      = 0;
+    rlc_poll_sn                                                  = 0;
+    rlc_poll_delayed_sn                                          = 0;
+    rlc_poll_delayed                                             = false;
+    rlc_status_pending                                           = false;
+    rlc_um_stats.N_pdus_dropped                                  = 0;
+    rlc_um_stats.N_pdus_lost                                     = 0;
+    rlc_um_stats.max_reordering_depth                            = 0;
+    rlc_um_tx_sdu_offset                                         = 0;
+    set_rlc_um_sn_size(LIBLTE_RLC_UMD_SN_SIZE_10_BITS);
 
     // Setup the QoS
     avail_qos[0] = (LTE_FDD_ENB_QOS_STRUCT){ 0,   0};
@@ -102,6 +153,46 @@ LTE_fdd_enb_rb::LTE_fdd_enb_rb(LTE_FDD_ENB_RB_ENUM  _rb,
 }
 LTE_fdd_enb_rb::~LTE_fdd_enb_rb()
 {
+    uint32 i;
+
+    // Stop UL polling
+    if(LTE_FDD_ENB_QOS_NONE != qos)
+    {
+        user->set_ul_poll(0, 0);
+    }
+
+    // Stop the RLC timers
+    for(i=0; i<LTE_FDD_ENB_RLC_TIMER_N_ITEMS; i++)
+    {
+        rlc_stop_timer((LTE_FDD_ENB_RLC_TIMER_ENUM)i);
+    }
+
+    // Free the PDCP reordering buffer
+    pdcp_stop_t_reordering();
+    for(i=0; i<LTE_FDD_ENB_PDCP_MAX_REORDERING_WINDOW; i++)
+    {
+        delete pdcp_reordering_buffer[i];
+    }
+
+    // Free the RLC buffers
+    for(i=0; i<LIBLTE_RLC_AM_WINDOW_SIZE; i++)
+    {
+        delete rlc_reception_buffer[i].data;
+        delete rlc_transmission_buffer[i].data;
+    }
+    for(i=0; i<LIBLTE_RLC_UM_WINDOW_SIZE_SN_10_BITS; i++)
+    {
+        delete rlc_um_reception_buffer[i].pdu;
+    }
+    while(0 != rlc_tx_sdu_queue.size())
+    {
+        delete rlc_tx_sdu_queue.front();
+        rlc_tx_sdu_queue.pop_front();
+    }
+    for(i=0; i<rlc_buf_pool.size(); i++)
+    {
+        delete rlc_buf_pool[i];
+    }
 }
 
 /******************/
@@ -213,6 +304,208 @@ LTE_FDD_ENB_PDCP_CONFIG_ENUM LTE_fdd_enb_rb::get_pdcp_config(void)
 {
     return(pdcp_config);
 }
+void LTE_fdd_enb_rb::set_pdcp_config(LTE_FDD_ENB_PDCP_CONFIG_ENUM config)
+{
+    uint32 i;
+
+    pdcp_config = config;
+
+    // A new configuration (re)establishes the PDCP entity
+    pdcp_stop_t_reordering();
+    for(i=0; i<LTE_FDD_ENB_PDCP_MAX_REORDERING_WINDOW; i++)
+    {
+        delete pdcp_reordering_buffer[i];
+        pdcp_reordering_buffer[i] = NULL;
+    }
+    pdcp_N_reordering_sdus    = 0;
+    pdcp_reordering_rx_sn     = 0;
+    pdcp_tx_hfn               = 0;
+    pdcp_rx_hfn               = 0;
+    pdcp_next_tx_sn           = 0;
+    pdcp_next_rx_sn           = 0;
+    pdcp_last_submitted_rx_sn = get_pdcp_max_sn();
+}
+LIBLTE_PDCP_SN_SIZE_ENUM LTE_fdd_enb_rb::get_pdcp_sn_size(void)
+{
+    LIBLTE_PDCP_SN_SIZE_ENUM sn_size = LIBLTE_PDCP_SN_SIZE_5_BITS;
+
+    if(LTE_FDD_ENB_PDCP_CONFIG_DRB_LONG_SN == pdcp_config)
+    {
+        sn_size = LIBLTE_PDCP_SN_SIZE_12_BITS;
+    }else if(LTE_FDD_ENB_PDCP_CONFIG_DRB_SHORT_SN == pdcp_config){
+        sn_size = LIBLTE_PDCP_SN_SIZE_7_BITS;
+    }
+
+    return(sn_size);
+}
+uint32 LTE_fdd_enb_rb::get_pdcp_sn_n_bits(void)
+{
+    uint32 N_bits = 5;
+
+    if(LIBLTE_PDCP_SN_SIZE_12_BITS == get_pdcp_sn_size())
+    {
+        N_bits = 12;
+    }else if(LIBLTE_PDCP_SN_SIZE_7_BITS == get_pdcp_sn_size()){
+        N_bits = 7;
+    }
+
+    return(N_bits);
+}
+uint16 LTE_fdd_enb_rb::get_pdcp_max_sn(void)
+{
+    return((1 << get_pdcp_sn_n_bits()) - 1);
+}
+uint16 LTE_fdd_enb_rb::get_pdcp_reordering_window(void)
+{
+    return((get_pdcp_max_sn() + 1) / 2);
+}
+uint16 LTE_fdd_enb_rb::get_pdcp_next_tx_sn(void)
+{
+    return(pdcp_next_tx_sn);
+}
+void LTE_fdd_enb_rb::set_pdcp_next_tx_sn(uint16 next_tx_sn)
+{
+    pdcp_next_tx_sn = next_tx_sn;
+}
+uint32 LTE_fdd_enb_rb::get_pdcp_tx_hfn(void)
+{
+    return(pdcp_tx_hfn);
+}
+void LTE_fdd_enb_rb::set_pdcp_tx_hfn(uint32 tx_hfn)
+{
+    pdcp_tx_hfn = tx_hfn;
+}
+uint16 LTE_fdd_enb_rb::get_pdcp_next_rx_sn(void)
+{
+    return(pdcp_next_rx_sn);
+}
+void LTE_fdd_enb_rb::set_pdcp_next_rx_sn(uint16 next_rx_sn)
+{
+    pdcp_next_rx_sn = next_rx_sn;
+}
+uint32 LTE_fdd_enb_rb::get_pdcp_rx_hfn(void)
+{
+    return(pdcp_rx_hfn);
+}
+void LTE_fdd_enb_rb::set_pdcp_rx_hfn(uint32 rx_hfn)
+{
+    pdcp_rx_hfn = rx_hfn;
+}
+uint16 LTE_fdd_enb_rb::get_pdcp_last_submitted_rx_sn(void)
+{
+    return(pdcp_last_submitted_rx_sn);
+}
+void LTE_fdd_enb_rb::set_pdcp_last_submitted_rx_sn(uint16 last_submitted_rx_sn)
+{
+    pdcp_last_submitted_rx_sn = last_submitted_rx_sn;
+}
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::pdcp_add_to_reordering_buffer(uint16                 sn,
+                                                                     LIBLTE_BIT_MSG_STRUCT *sdu)
+{
+    LTE_FDD_ENB_ERROR_ENUM err = LTE_FDD_ENB_ERROR_DUPLICATE_PDCP_PDU;
+    uint32                 idx = sn % get_pdcp_reordering_window();
+
+    // Only SNs inside the reordering window are stored
+    if(NULL == pdcp_reordering_buffer[idx])
+    {
+        pdcp_reordering_buffer[idx]         = new LIBLTE_BIT_MSG_STRUCT;
+        pdcp_reordering_buffer[idx]->N_bits = sdu->N_bits;
+        memcpy(pdcp_reordering_buffer[idx]->msg, sdu->msg, sdu->N_bits);
+        pdcp_N_reordering_sdus++;
+        err = LTE_FDD_ENB_ERROR_NONE;
+    }
+
+    return(err);
+}
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::pdcp_get_from_reordering_buffer(uint16                 sn,
+                                                                       LIBLTE_BIT_MSG_STRUCT *sdu)
+{
+    LTE_FDD_ENB_ERROR_ENUM err = LTE_FDD_ENB_ERROR_NO_MSG_IN_QUEUE;
+    uint32                 idx = sn % get_pdcp_reordering_window();
+
+    if(NULL != pdcp_reordering_buffer[idx])
+    {
+        sdu->N_bits = pdcp_reordering_buffer[idx]->N_bits;
+        memcpy(sdu->msg, pdcp_reordering_buffer[idx]->msg, sdu->N_bits);
+        delete pdcp_reordering_buffer[idx];
+        pdcp_reordering_buffer[idx] = NULL;
+        pdcp_N_reordering_sdus--;
+        err                         = LTE_FDD_ENB_ERROR_NONE;
+    }
+
+    return(err);
+}
+uint32 LTE_fdd_enb_rb::get_pdcp_n_reordering_sdus(void)
+{
+    return(pdcp_N_reordering_sdus);
+}
+uint16 LTE_fdd_enb_rb::get_pdcp_reordering_rx_sn(void)
+{
+    return(pdcp_reordering_rx_sn);
+}
+void LTE_fdd_enb_rb::set_pdcp_reordering_rx_sn(uint16 reordering_rx_sn)
+{
+    pdcp_reordering_rx_sn = reordering_rx_sn;
+}
+void LTE_fdd_enb_rb::pdcp_start_t_reordering(void)
+{
+    LTE_fdd_enb_timer_mgr *timer_mgr = LTE_fdd_enb_timer_mgr::get_instance();
+    LTE_fdd_enb_timer_cb   t_reordering_cb(&LTE_fdd_enb_timer_cb_wrapper<LTE_fdd_enb_rb, &LTE_fdd_enb_rb::handle_pdcp_t_reordering_expiry>, this);
+
+    pdcp_stop_t_reordering();
+    timer_mgr->start_timer(LTE_FDD_ENB_PDCP_T_REORDERING, t_reordering_cb, &pdcp_t_reordering_id);
+}
+void LTE_fdd_enb_rb::pdcp_stop_t_reordering(void)
+{
+    LTE_fdd_enb_timer_mgr *timer_mgr = LTE_fdd_enb_timer_mgr::get_instance();
+
+    if(LTE_FDD_ENB_RLC_INVALID_TIMER_ID != pdcp_t_reordering_id)
+    {
+        timer_mgr->stop_timer(pdcp_t_reordering_id);
+        pdcp_t_reordering_id = LTE_FDD_ENB_RLC_INVALID_TIMER_ID;
+    }
+}
+bool LTE_fdd_enb_rb::pdcp_is_t_reordering_running(void)
+{
+    return(LTE_FDD_ENB_RLC_INVALID_TIMER_ID != pdcp_t_reordering_id);
+}
+bool LTE_fdd_enb_rb::pdcp_t_reordering_expired(uint32 timer_id)
+{
+    bool expired = false;
+
+    // Expiries of timers that have since been stopped or restarted are stale
+    if(timer_id == pdcp_t_reordering_id)
+    {
+        pdcp_t_reordering_id = LTE_FDD_ENB_RLC_INVALID_TIMER_ID;
+        expired              = true;
+    }
+
+    return(expired);
+}
+void LTE_fdd_enb_rb::handle_pdcp_t_reordering_expiry(uint32 timer_id)
+{
+    LTE_fdd_enb_pdcp *pdcp = LTE_fdd_enb_pdcp::get_instance();
+
+    pdcp->handle_t_reordering_expiry(user, this, timer_id);
+}
+LTE_FDD_ENB_PDCP_STATS_STRUCT LTE_fdd_enb_rb::get_pdcp_stats(void)
+{
+    return(pdcp_stats);
+}
+void LTE_fdd_enb_rb::pdcp_count_ul_sdu(uint32 N_bytes)
+{
+    pdcp_stats.N_ul_sdus++;
+    pdcp_stats.N_ul_bytes += N_bytes;
+}
+void LTE_fdd_enb_rb::pdcp_count_dl_sdu(uint32 N_bytes)
+{
+    pdcp_stats.N_dl_sdus++;
+    pdcp_stats.N_dl_bytes += N_bytes;
+}
+void LTE_fdd_enb_rb::pdcp_count_discarded_pdu(void)
+{
+    pdcp_stats.N_discarded_pdus++;
+}
 
 /*************/
 /*    RLC    */
@@ -251,72 +544,887 @@ uint16 LTE_fdd_enb_rb::get_rlc_vrr(void)
 }
 void LTE_fdd_enb_rb::set_rlc_vrr(uint16 vrr)
 {
-    rlc_vrr  = vrr;
-    rlc_vrmr = rlc_vrr + LIBLTE_RLC_AM_WINDOW_SIZE;
+    rlc_vrr  = vrr % LIBLTE_RLC_AM_MODULUS;
+    rlc_vrmr = (rlc_vrr + LIBLTE_RLC_AM_WINDOW_SIZE) % LIBLTE_RLC_AM_MODULUS;
 }
 uint16 LTE_fdd_enb_rb::get_rlc_vrmr(void)
 {
     return(rlc_vrmr);
 }
+uint16 LTE_fdd_enb_rb::get_rlc_vrx(void)
+{
+    return(rlc_vrx);
+}
+void LTE_fdd_enb_rb::set_rlc_vrx(uint16 vrx)
+{
+    rlc_vrx = vrx % LIBLTE_RLC_AM_MODULUS;
+}
+uint16 LTE_fdd_enb_rb::get_rlc_vrms(void)
+{
+    return(rlc_vrms);
+}
+void LTE_fdd_enb_rb::set_rlc_vrms(uint16 vrms)
+{
+    rlc_vrms = vrms % LIBLTE_RLC_AM_MODULUS;
+}
 uint16 LTE_fdd_enb_rb::get_rlc_vrh(void)
 {
     return(rlc_vrh);
 }
 void LTE_fdd_enb_rb::set_rlc_vrh(uint16 vrh)
 {
-    rlc_vrh = vrh;
+    rlc_vrh = vrh % LIBLTE_RLC_AM_MODULUS;
+}
+uint16 LTE_fdd_enb_rb::get_rlc_vta(void)
+{
+    return(rlc_vta);
+}
+void LTE_fdd_enb_rb::set_rlc_vta(uint16 vta)
+{
+    rlc_vta  = vta % LIBLTE_RLC_AM_MODULUS;
+    rlc_vtms = (rlc_vta + LIBLTE_RLC_AM_WINDOW_SIZE) % LIBLTE_RLC_AM_MODULUS;
+}
+uint16 LTE_fdd_enb_rb::get_rlc_vtms(void)
+{
+    return(rlc_vtms);
+}
+uint16 LTE_fdd_enb_rb::get_rlc_vts(void)
+{
+    return(rlc_vts);
+}
+void LTE_fdd_enb_rb::set_rlc_vts(uint16 vts)
+{
+    rlc_vts = vts % LIBLTE_RLC_AM_MODULUS;
+}
+uint16 LTE_fdd_enb_rb::get_rlc_poll_sn(void)
+{
+    return(rlc_poll_sn);
+}
+void LTE_fdd_enb_rb::set_rlc_poll_sn(uint16 poll_sn)
+{
+    rlc_poll_sn = poll_sn % LIBLTE_RLC_AM_MODULUS;
+}
+uint32 LTE_fdd_enb_rb::get_rlc_pdu_without_poll(void)
+{
+    return(rlc_pdu_without_poll);
+}
+void LTE_fdd_enb_rb::set_rlc_pdu_without_poll(uint32 pdu_without_poll)
+{
+    rlc_pdu_without_poll = pdu_without_poll;
+}
+uint32 LTE_fdd_enb_rb::get_rlc_byte_without_poll(void)
+{
+    return(rlc_byte_without_poll);
+}
+void LTE_fdd_enb_rb::set_rlc_byte_without_poll(uint32 byte_without_poll)
+{
+    rlc_byte_without_poll = byte_without_poll;
+}
+uint32 LTE_fdd_enb_rb::get_rlc_poll_pdu(void)
+{
+    return(rlc_poll_pdu);
 }
-void LTE_fdd_enb_rb::rlc_add_to_reception_buffer(LIBLTE_RLC_AMD_PDU_STRUCT *amd_pdu)
+uint32 LTE_fdd_enb_rb::get_rlc_poll_byte(void)
 {
-    LIBLTE_BIT_MSG_STRUCT *new_pdu = NULL;
+    return(rlc_poll_byte);
+}
+uint32 LTE_fdd_enb_rb::get_rlc_max_retx_threshold(void)
+{
+    return(rlc_max_retx_threshold);
+}
+bool LTE_fdd_enb_rb::get_rlc_status_pending(void)
+{
+    return(rlc_status_pending);
+}
+void LTE_fdd_enb_rb::set_rlc_status_pending(bool status_pending)
+{
+    rlc_status_pending = status_pending;
+}
+bool LTE_fdd_enb_rb::get_rlc_poll_delayed(void)
+{
+    return(rlc_poll_delayed);
+}
+uint16 LTE_fdd_enb_rb::get_rlc_poll_delayed_sn(void)
+{
+    return(rlc_poll_delayed_sn);
+}
+void LTE_fdd_enb_rb::set_rlc_poll_delayed(bool   poll_delayed,
+                                          uint16 poll_delayed_sn)
+{
+    rlc_poll_delayed    = poll_delayed;
+    rlc_poll_delayed_sn = poll_delayed_sn % LIBLTE_RLC_AM_MODULUS;
+}
+void LTE_fdd_enb_rb::rlc_start_timer(LTE_FDD_ENB_RLC_TIMER_ENUM timer)
+{
+    LTE_fdd_enb_timer_mgr *timer_mgr = LTE_fdd_enb_timer_mgr::get_instance();
+    LTE_fdd_enb_timer_cb   t_poll_retransmit_cb(&LTE_fdd_enb_timer_cb_wrapper<LTE_fdd_enb_rb, &LTE_fdd_enb_rb::handle_rlc_t_poll_retransmit_expiry>, this);
+    LTE_fdd_enb_timer_cb   t_reordering_cb(&LTE_fdd_enb_timer_cb_wrapper<LTE_fdd_enb_rb, &LTE_fdd_enb_rb::handle_rlc_t_reordering_expiry>, this);
+    LTE_fdd_enb_timer_cb   t_status_prohibit_cb(&LTE_fdd_enb_timer_cb_wrapper<LTE_fdd_enb_rb, &LTE_fdd_enb_rb::handle_rlc_t_status_prohibit_expiry>, this);
 
-    new_pdu = new LIBLTE_BIT_MSG_STRUCT;
+    rlc_stop_timer(timer);
 
-    if(NULL != new_pdu)
+    // A timer value of 0 means the timer never runs
+    if(0 != rlc_timer_m_seconds[timer])
     {
-        memcpy(new_pdu, &amd_pdu->data, sizeof(LIBLTE_BIT_MSG_STRUCT));
-        rlc_reception_buffer[amd_pdu->hdr.sn] = new_pdu;
+        switch(timer)
+        {
+        case LTE_FDD_ENB_RLC_TIMER_T_POLL_RETRANSMIT:
+            timer_mgr->start_timer(rlc_timer_m_seconds[timer], t_poll_retransmit_cb, &rlc_timer_id[timer]);
+            break;
+        case LTE_FDD_ENB_RLC_TIMER_T_REORDERING:
+            timer_mgr->start_timer(rlc_timer_m_seconds[timer], t_reordering_cb, &rlc_timer_id[timer]);
+            break;
+        case LTE_FDD_ENB_RLC_TIMER_T_STATUS_PROHIBIT:
+            timer_mgr->start_timer(rlc_timer_m_seconds[timer], t_status_prohibit_cb, &rlc_timer_id[timer]);
+            break;
+        default:
+            break;
+        }
+    }
+}
+void LTE_fdd_enb_rb::rlc_stop_timer(LTE_FDD_ENB_RLC_TIMER_ENUM timer)
+{
+    LTE_fdd_enb_timer_mgr *timer_mgr = LTE_fdd_enb_timer_mgr::get_instance();
+
+    if(LTE_FDD_ENB_RLC_INVALID_TIMER_ID != rlc_timer_id[timer])
+    {
+        timer_mgr->stop_timer(rlc_timer_id[timer]);
+        rlc_timer_id[timer] = LTE_FDD_ENB_RLC_INVALID_TIMER_ID;
+    }
+}
+bool LTE_fdd_enb_rb::rlc_is_timer_running(LTE_FDD_ENB_RLC_TIMER_ENUM timer)
+{
+    return(LTE_FDD_ENB_RLC_INVALID_TIMER_ID != rlc_timer_id[timer]);
+}
+bool LTE_fdd_enb_rb::rlc_timer_expired(LTE_FDD_ENB_RLC_TIMER_ENUM timer,
+                                       uint32                     timer_id)
+{
+    bool expired = false;
+
+    // Expiries of timers that have since been stopped or restarted are stale
+    if(timer_id == rlc_timer_id[timer])
+    {
+        rlc_timer_id[timer] = LTE_FDD_ENB_RLC_INVALID_TIMER_ID;
+        expired             = true;
+    }
+
+    return(expired);
+}
+void LTE_fdd_enb_rb::handle_rlc_t_poll_retransmit_expiry(uint32 timer_id)
+{
+    LTE_fdd_enb_rlc *rlc = LTE_fdd_enb_rlc::get_instance();
+
+    rlc->handle_timer_expiry(user, this, LTE_FDD_ENB_RLC_TIMER_T_POLL_RETRANSMIT, timer_id);
+}
+void LTE_fdd_enb_rb::handle_rlc_t_reordering_expiry(uint32 timer_id)
+{
+    LTE_fdd_enb_rlc *rlc = LTE_fdd_enb_rlc::get_instance();
+
+    rlc->handle_timer_expiry(user, this, LTE_FDD_ENB_RLC_TIMER_T_REORDERING, timer_id);
+}
+void LTE_fdd_enb_rb::handle_rlc_t_status_prohibit_expiry(uint32 timer_id)
+{
+    LTE_fdd_enb_rlc *rlc = LTE_fdd_enb_rlc::get_instance();
+
+    rlc->handle_timer_expiry(user, this, LTE_FDD_ENB_RLC_TIMER_T_STATUS_PROHIBIT, timer_id);
+}
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::rlc_add_to_reception_buffer(LIBLTE_RLC_AMD_PDU_STRUCT *amd_pdu)
+{
+    LTE_FDD_ENB_RLC_AM_RX_PDU_STRUCT *rx_pdu = rlc_get_rx_pdu(amd_pdu->hdr.sn);
+    LTE_FDD_ENB_ERROR_ENUM            err    = LTE_FDD_ENB_ERROR_NONE;
+    uint32                            start  = amd_pdu->hdr.so;
+    uint32                            end    = amd_pdu->hdr.so + amd_pdu->data.N_bits/8;
+    uint32                            pos;
+    uint32                            i;
+    uint32                            j;
+    uint32                            k;
+
+    if(NULL == rx_pdu->data)
+    {
+        rx_pdu->data       = rlc_alloc_buf();
+        rx_pdu->fi         = LIBLTE_RLC_FI_FIELD_FULL_SDU;
+        rx_pdu->N_bytes    = 0;
+        rx_pdu->N_segs     = 0;
+        rx_pdu->N_sdu_ends = 0;
+        rx_pdu->next_sdu   = 0;
+        rx_pdu->last_rcvd  = false;
+    }
+
+    // Find the received byte ranges that this one touches
+    i = 0;
+    while(i                  < rx_pdu->N_segs &&
+          rx_pdu->seg_end[i] < start)
+    {
+        i++;
+    }
+    j = i;
+    while(j                    <  rx_pdu->N_segs &&
+          rx_pdu->seg_start[j] <= end)
+    {
+        j++;
+    }
 
-        if(LIBLTE_RLC_FI_FIELD_FULL_SDU == amd_pdu->hdr.fi)
+    if(start                   == end ||
+       (LIBLTE_MAX_MSG_SIZE/8) <  end)
+    {
+        err = LTE_FDD_ENB_ERROR_OUT_OF_BOUNDS;
+    }else if(i                    <  rx_pdu->N_segs &&
+             rx_pdu->seg_start[i] <= start          &&
+             rx_pdu->seg_end[i]   >= end){
+        err = LTE_FDD_ENB_ERROR_DUPLICATE_RLC_PDU;
+    }else if((j                         == i &&
+              LTE_FDD_ENB_RLC_AM_N_SEGS == rx_pdu->N_segs) ||
+             (rx_pdu->N_sdu_ends + amd_pdu->N_slices - 1) > LTE_FDD_ENB_RLC_AM_N_SDU_ENDS){
+        err = LTE_FDD_ENB_ERROR_OUT_OF_BOUNDS;
+    }else{
+        memcpy(&rx_pdu->data->msg[start*8], amd_pdu->data.msg, amd_pdu->data.N_bits);
+
+        if(j == i)
+        {
+            // No overlap, make room for the new range
+            memmove(&rx_pdu->seg_start[i+1], &rx_pdu->seg_start[i], (rx_pdu->N_segs - i)*sizeof(uint16));
+            memmove(&rx_pdu->seg_end[i+1], &rx_pdu->seg_end[i], (rx_pdu->N_segs - i)*sizeof(uint16));
+            rx_pdu->N_segs++;
+        }else{
+            // Collapse the touched ranges and the new range into one
+            if(rx_pdu->seg_start[i] < start)
+            {
+                start = rx_pdu->seg_start[i];
+            }
+            if(rx_pdu->seg_end[j-1] > end)
+            {
+                end = rx_pdu->seg_end[j-1];
+            }
+            memmove(&rx_pdu->seg_start[i+1], &rx_pdu->seg_start[j], (rx_pdu->N_segs - j)*sizeof(uint16));
+            memmove(&rx_pdu->seg_end[i+1], &rx_pdu->seg_end[j], (rx_pdu->N_segs - j)*sizeof(uint16));
+            rx_pdu->N_segs -= j - i - 1;
+        }
+        rx_pdu->seg_start[i] = start;
+        rx_pdu->seg_end[i]   = end;
+
+        // Every LI ends an SDU, keep the boundaries sorted by their offset
+        // in the PDU since segments can arrive in any order
+        pos = amd_pdu->hdr.so;
+        for(k=0; k<(amd_pdu->N_slices - 1); k++)
+        {
+            pos += amd_pdu->slice[k].N_bits/8;
+            i    = 0;
+            while(i                   < rx_pdu->N_sdu_ends &&
+                  rx_pdu->sdu_end[i] < pos)
+            {
+                i++;
+            }
+            if(i                   == rx_pdu->N_sdu_ends ||
+               rx_pdu->sdu_end[i] != pos)
+            {
+                memmove(&rx_pdu->sdu_end[i+1], &rx_pdu->sdu_end[i], (rx_pdu->N_sdu_ends - i)*sizeof(uint16));
+                rx_pdu->sdu_end[i] = pos;
+                rx_pdu->N_sdu_ends++;
+            }
+        }
+
+        // The first segment carries the start of the FI and the last segment
+        // carries the end of it
+        if(0 == amd_pdu->hdr.so)
+        {
+            rx_pdu->fi = (LIBLTE_RLC_FI_FIELD_ENUM)((rx_pdu->fi & 0x1) | (amd_pdu->hdr.fi & 0x2));
+        }
+        if(LIBLTE_RLC_LSF_FIELD_LAST_SEGMENT == amd_pdu->hdr.lsf)
+        {
+            rx_pdu->last_rcvd = true;
+            rx_pdu->N_bytes   = amd_pdu->hdr.so + amd_pdu->data.N_bits/8;
+            rx_pdu->fi        = (LIBLTE_RLC_FI_FIELD_ENUM)((rx_pdu->fi & 0x2) | (amd_pdu->hdr.fi & 0x1));
+        }
+    }
+
+    return(err);
+}
+bool LTE_fdd_enb_rb::rlc_is_pdu_received(uint16 sn)
+{
+    LTE_FDD_ENB_RLC_AM_RX_PDU_STRUCT *rx_pdu   = rlc_get_rx_pdu(sn);
+    bool                              received = false;
+
+    // All bytes are received when one byte range spans the whole PDU
+    if(NULL            != rx_pdu->data         &&
+       true            == rx_pdu->last_rcvd    &&
+       1               == rx_pdu->N_segs       &&
+       0               == rx_pdu->seg_start[0] &&
+       rx_pdu->N_bytes == rx_pdu->seg_end[0])
+    {
+        received = true;
+    }
+
+    return(received);
+}
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::rlc_add_nacks(uint16                        sn,
+                                                     LIBLTE_RLC_STATUS_PDU_STRUCT *status)
+{
+    LTE_FDD_ENB_RLC_AM_RX_PDU_STRUCT *rx_pdu = rlc_get_rx_pdu(sn);
+    LIBLTE_RLC_NACK_STRUCT            nack[LTE_FDD_ENB_RLC_AM_N_SEGS + 1];
+    LTE_FDD_ENB_ERROR_ENUM            err    = LTE_FDD_ENB_ERROR_NONE;
+    uint32                            N_nack = 0;
+    uint32                            start  = 0;
+    uint32                            i;
+
+    if(NULL == rx_pdu->data)
+    {
+        // Nothing received, NACK the whole PDU
+        nack[N_nack].nack_sn    = sn;
+        nack[N_nack].so_present = false;
+        N_nack++;
+    }else if(!rlc_is_pdu_received(sn)){
+        // NACK each missing byte range
+        for(i=0; i<rx_pdu->N_segs; i++)
+        {
+            if(rx_pdu->seg_start[i] > start)
+            {
+                nack[N_nack].nack_sn    = sn;
+                nack[N_nack].so_present = true;
+                nack[N_nack].so_start   = start;
+                nack[N_nack].so_end     = rx_pdu->seg_start[i] - 1;
+                N_nack++;
+            }
+            start = rx_pdu->seg_end[i];
+        }
+        if(!rx_pdu->last_rcvd)
+        {
+            nack[N_nack].nack_sn    = sn;
+            nack[N_nack].so_present = true;
+            nack[N_nack].so_start   = start;
+            nack[N_nack].so_end     = LIBLTE_RLC_SO_END_OF_PDU;
+            N_nack++;
+        }else if(rx_pdu->N_bytes > start){
+            nack[N_nack].nack_sn    = sn;
+            nack[N_nack].so_present = true;
+            nack[N_nack].so_start   = start;
+            nack[N_nack].so_end     = rx_pdu->N_bytes - 1;
+            N_nack++;
+        }
+    }
+
+    if((status->N_nack + N_nack) <= LIBLTE_RLC_STATUS_PDU_MAX_N_NACK)
+    {
+        memcpy(&status->nack[status->N_nack], nack, N_nack*sizeof(LIBLTE_RLC_NACK_STRUCT));
+        status->N_nack += N_nack;
+    }else{
+        err = LTE_FDD_ENB_ERROR_OUT_OF_BOUNDS;
+    }
+
+    return(err);
+}
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::rlc_reassemble(uint16                 sn,
+                                                      LIBLTE_BIT_MSG_STRUCT *sdu)
+{
+    LTE_FDD_ENB_RLC_AM_RX_PDU_STRUCT *rx_pdu = rlc_get_rx_pdu(sn);
+    LTE_FDD_ENB_ERROR_ENUM            err    = LTE_FDD_ENB_ERROR_CANT_REASSEMBLE_SDU;
+    uint32                            N_sdus;
+    uint32                            start;
+    uint32                            N_bits;
+    uint32                            i;
+    bool                              discard;
+
+    if(NULL != rx_pdu->data)
+    {
+        // A PDU that starts an SDU discards any partial SDU
+        N_sdus = rx_pdu->N_sdu_ends + 1;
+        if(0 == rx_pdu->next_sdu &&
+           0 == (rx_pdu->fi & 0x2))
+        {
+            rlc_reassembly_sdu.N_bits = 0;
+        }
+
+        while(rx_pdu->next_sdu < N_sdus &&
+              LTE_FDD_ENB_ERROR_NONE != err)
+        {
+            i = rx_pdu->next_sdu++;
+
+            // The SDU boundaries split the PDU into one part per SDU
+            start = 0;
+            if(0 != i)
+            {
+                start = rx_pdu->sdu_end[i-1];
+            }
+            if(i != (N_sdus - 1))
+            {
+                N_bits = (rx_pdu->sdu_end[i] - start)*8;
+            }else{
+                N_bits = (rx_pdu->N_bytes - start)*8;
+            }
+
+            // The first part continues an SDU, discard it if the start of
+            // that SDU was lost
+            discard = false;
+            if(0 == i                        &&
+               0 != (rx_pdu->fi & 0x2)       &&
+               0 == rlc_reassembly_sdu.N_bits)
+            {
+                discard = true;
+            }
+            if((rlc_reassembly_sdu.N_bits + N_bits) > LIBLTE_MAX_MSG_SIZE)
+            {
+                rlc_reassembly_sdu.N_bits = 0;
+                discard                   = true;
+            }
+
+            if(!discard)
+            {
+                memcpy(&rlc_reassembly_sdu.msg[rlc_reassembly_sdu.N_bits], &rx_pdu->data->msg[start*8], N_bits);
+                rlc_reassembly_sdu.N_bits += N_bits;
+
+                // Every part but the last ends an SDU, the last one ends an
+                // SDU unless FI says otherwise
+                if(i != (N_sdus - 1) ||
+                   0 == (rx_pdu->fi & 0x1))
+                {
+                    sdu->N_bits = rlc_reassembly_sdu.N_bits;
+                    memcpy(sdu->msg, rlc_reassembly_sdu.msg, rlc_reassembly_sdu.N_bits);
+                    rlc_reassembly_sdu.N_bits = 0;
+                    err                       = LTE_FDD_ENB_ERROR_NONE;
+                }
+            }
+        }
+
+        // Return the PDU to the pool once all of its SDUs are consumed
+        if(rx_pdu->next_sdu == N_sdus)
+        {
+            rlc_free_buf(rx_pdu->data);
+            rx_pdu->data = NULL;
+        }
+    }
+
+    return(err);
+}
+void LTE_fdd_enb_rb::rlc_add_to_transmission_buffer(uint16                 sn,
+                                                    LIBLTE_BIT_MSG_STRUCT *sdu)
+{
+    LTE_FDD_ENB_RLC_AM_TX_PDU_STRUCT *tx_pdu = rlc_get_tx_pdu(sn);
+
+    // Take the SDU popped from the TX SDU queue instead of copying it
+    if(NULL != tx_pdu->data)
+    {
+        rlc_free_buf(tx_pdu->data);
+    }
+    tx_pdu->data       = sdu;
+    tx_pdu->fi         = LIBLTE_RLC_FI_FIELD_FULL_SDU;
+    tx_pdu->retx_count = 0;
+}
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::rlc_get_transmission_buffer_pdu(uint16                     sn,
+                                                                       LIBLTE_BIT_MSG_STRUCT    **data,
+                                                                       LIBLTE_RLC_FI_FIELD_ENUM  *fi)
+{
+    LTE_FDD_ENB_RLC_AM_TX_PDU_STRUCT *tx_pdu = rlc_get_tx_pdu(sn);
+    LTE_FDD_ENB_ERROR_ENUM            err    = LTE_FDD_ENB_ERROR_NO_MSG_IN_QUEUE;
+
+    if(NULL != tx_pdu->data)
+    {
+        *data = tx_pdu->data;
+        *fi   = tx_pdu->fi;
+        err   = LTE_FDD_ENB_ERROR_NONE;
+    }
+
+    return(err);
+}
+uint32 LTE_fdd_enb_rb::rlc_increment_retx_count(uint16 sn)
+{
+    LTE_FDD_ENB_RLC_AM_TX_PDU_STRUCT *tx_pdu = rlc_get_tx_pdu(sn);
+
+    tx_pdu->retx_count++;
+
+    return(tx_pdu->retx_count);
+}
+void LTE_fdd_enb_rb::rlc_remove_from_transmission_buffer(uint16 sn)
+{
+    LTE_FDD_ENB_RLC_AM_TX_PDU_STRUCT *tx_pdu = rlc_get_tx_pdu(sn);
+
+    if(NULL != tx_pdu->data)
+    {
+        rlc_free_buf(tx_pdu->data);
+        tx_pdu->data = NULL;
+    }
+}
+void LTE_fdd_enb_rb::rlc_queue_tx_sdu(LIBLTE_BIT_MSG_STRUCT *sdu)
+{
+    LIBLTE_BIT_MSG_STRUCT *loc_sdu = rlc_alloc_buf();
+
+    loc_sdu->N_bits = sdu->N_bits;
+    memcpy(loc_sdu->msg, sdu->msg, sdu->N_bits);
+
+    rlc_tx_sdu_queue.push_back(loc_sdu);
+}
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::rlc_get_next_tx_sdu(LIBLTE_BIT_MSG_STRUCT **sdu)
+{
+    LTE_FDD_ENB_ERROR_ENUM err = LTE_FDD_ENB_ERROR_NO_MSG_IN_QUEUE;
+
+    if(0 != rlc_tx_sdu_queue.size())
+    {
+        *sdu = rlc_tx_sdu_queue.front();
+        err  = LTE_FDD_ENB_ERROR_NONE;
+    }
+
+    return(err);
+}
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::rlc_pop_next_tx_sdu(LIBLTE_BIT_MSG_STRUCT **sdu)
+{
+    LTE_FDD_ENB_ERROR_ENUM err = LTE_FDD_ENB_ERROR_NO_MSG_IN_QUEUE;
+
+    // The caller owns the SDU buffer afterwards
+    if(0 != rlc_tx_sdu_queue.size())
+    {
+        *sdu = rlc_tx_sdu_queue.front();
+        rlc_tx_sdu_queue.pop_front();
+        err  = LTE_FDD_ENB_ERROR_NONE;
+    }
+
+    return(err);
+}
+uint32 LTE_fdd_enb_rb::get_n_rlc_sdus(void)
+{
+    boost::mutex::scoped_lock lock(rlc_sdu_queue_mutex);
+
+    return(rlc_sdu_queue.size());
+}
+LIBLTE_RLC_UMD_SN_SIZE_ENUM LTE_fdd_enb_rb::get_rlc_um_sn_size(void)
+{
+    return(rlc_um_sn_size);
+}
+void LTE_fdd_enb_rb::set_rlc_um_sn_size(LIBLTE_RLC_UMD_SN_SIZE_ENUM sn_size)
+{
+    uint32 i;
+
+    rlc_um_sn_size = sn_size;
+    if(LIBLTE_RLC_UMD_SN_SIZE_5_BITS == rlc_um_sn_size)
+    {
+        rlc_um_modulus     = LIBLTE_RLC_UM_MODULUS_SN_5_BITS;
+        rlc_um_window_size = LIBLTE_RLC_UM_WINDOW_SIZE_SN_5_BITS;
+    }else{
+        rlc_um_modulus     = LIBLTE_RLC_UM_MODULUS_SN_10_BITS;
+        rlc_um_window_size = LIBLTE_RLC_UM_WINDOW_SIZE_SN_10_BITS;
+    }
+
+    // Changing the SN size (re)establishes the UM entity
+    rlc_stop_timer(LTE_FDD_ENB_RLC_TIMER_T_REORDERING);
+    for(i=0; i<LIBLTE_RLC_UM_WINDOW_SIZE_SN_10_BITS; i++)
+    {
+        delete rlc_um_reception_buffer[i].pdu;
+        rlc_um_reception_buffer[i].pdu = NULL;
+    }
+    rlc_um_last_reassembled_sn = rlc_um_modulus - 1;
+    rlc_reassembly_sdu.N_bits  = 0;
+    rlc_vtus                   = 0;
+    rlc_vrur                   = 0;
+    rlc_vrux                   = 0;
+    rlc_vruh                   = 0;
+    rlc_um_update_reordering_depth();
+}
+uint16 LTE_fdd_enb_rb::get_rlc_um_modulus(void)
+{
+    return(rlc_um_modulus);
+}
+uint16 LTE_fdd_enb_rb::get_rlc_um_window_size(void)
+{
+    return(rlc_um_window_size);
+}
+uint16 LTE_fdd_enb_rb::get_rlc_vtus(void)
+{
+    return(rlc_vtus);
+}
+void LTE_fdd_enb_rb::set_rlc_vtus(uint16 vtus)
+{
+    rlc_vtus = vtus % rlc_um_modulus;
+}
+uint16 LTE_fdd_enb_rb::get_rlc_vrur(void)
+{
+    return(rlc_vrur);
+}
+void LTE_fdd_enb_rb::set_rlc_vrur(uint16 vrur)
+{
+    rlc_vrur = vrur % rlc_um_modulus;
+    rlc_um_update_reordering_depth();
+}
+uint16 LTE_fdd_enb_rb::get_rlc_vrux(void)
+{
+    return(rlc_vrux);
+}
+void LTE_fdd_enb_rb::set_rlc_vrux(uint16 vrux)
+{
+    rlc_vrux = vrux % rlc_um_modulus;
+}
+uint16 LTE_fdd_enb_rb::get_rlc_vruh(void)
+{
+    return(rlc_vruh);
+}
+void LTE_fdd_enb_rb::set_rlc_vruh(uint16 vruh)
+{
+    // VR(UR) is always updated after VR(UH), so the reordering depth is
+    // only updated with VR(UR)
+    rlc_vruh = vruh % rlc_um_modulus;
+}
+LTE_FDD_ENB_RLC_UM_STATS_STRUCT LTE_fdd_enb_rb::get_rlc_um_stats(void)
+{
+    return(rlc_um_stats);
+}
+void LTE_fdd_enb_rb::rlc_um_count_dropped_pdu(void)
+{
+    rlc_um_stats.N_pdus_dropped++;
+}
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::rlc_um_add_to_reception_buffer(LIBLTE_BIT_MSG_STRUCT     *pdu,
+                                                                      LIBLTE_RLC_UMD_PDU_STRUCT *umd)
+{
+    boost::mutex::scoped_lock         lock(rlc_pdu_queue_mutex);
+    LTE_FDD_ENB_RLC_UM_RX_PDU_STRUCT *rx_pdu = rlc_um_get_rx_pdu(umd->hdr.sn);
+    LTE_FDD_ENB_ERROR_ENUM            err    = LTE_FDD_ENB_ERROR_DUPLICATE_RLC_PDU;
+    uint32                            i;
+
+    if(NULL == rx_pdu->pdu)
+    {
+        err = LTE_FDD_ENB_ERROR_NO_MSG_IN_QUEUE;
+        if(0   != rlc_pdu_queue.size() &&
+           pdu == rlc_pdu_queue.front())
         {
-            rlc_first_segment_sn = amd_pdu->hdr.sn;
-            rlc_last_segment_sn  = amd_pdu->hdr.sn;
-        }else if(LIBLTE_RLC_FI_FIELD_FIRST_SDU_SEGMENT == amd_pdu->hdr.fi){
-            rlc_first_segment_sn = amd_pdu->hdr.sn;
-        }else if(LIBLTE_RLC_FI_FIELD_LAST_SDU_SEGMENT == amd_pdu->hdr.fi){
-            rlc_last_segment_sn = amd_pdu->hdr.sn;
+            // Keep the PDU itself, the slices already point into it
+            rlc_pdu_queue.pop_front();
+            rx_pdu->pdu = pdu;
+            for(i=0; i<umd->N_slices; i++)
+            {
+                rx_pdu->slice[i]      = umd->slice[i].msg;
+                rx_pdu->slice_bits[i] = umd->slice[i].N_bits;
+            }
+            rx_pdu->N_slices   = umd->N_slices;
+            rx_pdu->next_slice = 0;
+            rx_pdu->fi         = umd->hdr.fi;
+            err                = LTE_FDD_ENB_ERROR_NONE;
         }
     }
+
+    return(err);
+}
+bool LTE_fdd_enb_rb::rlc_um_is_pdu_received(uint16 sn)
+{
+    return(NULL != rlc_um_get_rx_pdu(sn)->pdu);
 }
-LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::rlc_reassemble(LIBLTE_BIT_MSG_STRUCT *sdu)
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::rlc_um_reassemble(uint16                 sn,
+                                                         LIBLTE_BIT_MSG_STRUCT *sdu)
 {
-    std::map<uint16, LIBLTE_BIT_MSG_STRUCT *>::iterator iter;
-    LTE_FDD_ENB_ERROR_ENUM                              err = LTE_FDD_ENB_ERROR_CANT_REASSEMBLE_SDU;
-    uint32                                              i;
+    LTE_FDD_ENB_RLC_UM_RX_PDU_STRUCT *rx_pdu   = rlc_um_get_rx_pdu(sn);
+    LTE_FDD_ENB_ERROR_ENUM            err      = LTE_FDD_ENB_ERROR_CANT_REASSEMBLE_SDU;
+    uint32                            i;
+    bool                              discard;
 
-    if(0xFFFF != rlc_first_segment_sn &&
-       0xFFFF != rlc_last_segment_sn)
+    if(NULL != rx_pdu->pdu)
     {
-        // Reorder and reassemble the SDU
-        for(i=rlc_first_segment_sn; i<=rlc_last_segment_sn; i++)
+        if(0 == rx_pdu->next_slice)
+        {
+            // A gap in the SNs means the partial SDU can not be completed
+            if(sn != ((rlc_um_last_reassembled_sn + 1) % rlc_um_modulus))
+            {
+                rlc_um_stats.N_pdus_lost  += (sn + rlc_um_modulus - rlc_um_last_reassembled_sn - 1) % rlc_um_modulus;
+                rlc_reassembly_sdu.N_bits  = 0;
+            }
+            rlc_um_last_reassembled_sn = sn;
+
+            // A PDU that starts an SDU discards any partial SDU
+            if(0 == (rx_pdu->fi & 0x2))
+            {
+                rlc_reassembly_sdu.N_bits = 0;
+            }
+        }
+
+        while(rx_pdu->next_slice < rx_pdu->N_slices &&
+              LTE_FDD_ENB_ERROR_NONE != err)
         {
-            // FIXME: Error handling
-            iter = rlc_reception_buffer.find(i);
-            memcpy(&sdu->msg[sdu->N_bits], (*iter).second->msg, (*iter).second->N_bits);
-            sdu->N_bits += (*iter).second->N_bits;
-            delete (*iter).second;
-            rlc_reception_buffer.erase(iter);
+            i = rx_pdu->next_slice++;
+
+            // The first slice continues an SDU, discard it if the start of
+            // that SDU was lost
+            discard = false;
+            if(0 == i                        &&
+               0 != (rx_pdu->fi & 0x2)       &&
+               0 == rlc_reassembly_sdu.N_bits)
+            {
+                discard = true;
+            }
+            if((rlc_reassembly_sdu.N_bits + rx_pdu->slice_bits[i]) > LIBLTE_MAX_MSG_SIZE)
+            {
+                rlc_reassembly_sdu.N_bits = 0;
+                discard                   = true;
+            }
+
+            if(!discard)
+            {
+                memcpy(&rlc_reassembly_sdu.msg[rlc_reassembly_sdu.N_bits], rx_pdu->slice[i], rx_pdu->slice_bits[i]);
+                rlc_reassembly_sdu.N_bits += rx_pdu->slice_bits[i];
+
+                // Every slice but the last ends an SDU, the last one ends an
+                // SDU unless FI says otherwise
+                if(i != (rx_pdu->N_slices - 1) ||
+                   0 == (rx_pdu->fi & 0x1))
+                {
+                    sdu->N_bits = rlc_reassembly_sdu.N_bits;
+                    memcpy(sdu->msg, rlc_reassembly_sdu.msg, rlc_reassembly_sdu.N_bits);
+                    rlc_reassembly_sdu.N_bits = 0;
+                    err                       = LTE_FDD_ENB_ERROR_NONE;
+                }
+            }
         }
 
-        // Clear the first/last segment SNs
-        rlc_first_segment_sn = 0xFFFF;
-        rlc_last_segment_sn  = 0xFFFF;
+        // Release the PDU once all of its slices are consumed
+        if(rx_pdu->next_slice == rx_pdu->N_slices)
+        {
+            delete rx_pdu->pdu;
+            rx_pdu->pdu = NULL;
+        }
+    }
+
+    return(err);
+}
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::rlc_um_queue_tx_sdu(LIBLTE_BIT_MSG_STRUCT *sdu)
+{
+    boost::mutex::scoped_lock lock(rlc_sdu_queue_mutex);
+    LTE_FDD_ENB_ERROR_ENUM    err = LTE_FDD_ENB_ERROR_NO_MSG_IN_QUEUE;
 
+    // Take the SDU from the RLC SDU queue instead of copying it, it is
+    // referenced by the UMD PDU slices until packed
+    if(0   != rlc_sdu_queue.size() &&
+       sdu == rlc_sdu_queue.front())
+    {
+        rlc_sdu_queue.pop_front();
+        rlc_tx_sdu_queue.push_back(sdu);
         err = LTE_FDD_ENB_ERROR_NONE;
     }
 
     return(err);
 }
+LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::rlc_um_build_pdu(LIBLTE_RLC_UMD_PDU_STRUCT *umd,
+                                                        uint32                     max_N_bytes,
+                                                        LIBLTE_BIT_MSG_STRUCT     *pdu)
+{
+    std::list<LIBLTE_BIT_MSG_STRUCT *>::iterator  iter;
+    LTE_FDD_ENB_ERROR_ENUM                        err       = LTE_FDD_ENB_ERROR_NO_MSG_IN_QUEUE;
+    uint32                                        offset    = rlc_um_tx_sdu_offset;
+    uint32                                        N_bytes   = 0;
+    uint32                                        N_hdr     = 2;
+    uint32                                        N_sdus    = 0;
+    uint32                                        N_avail;
+    uint32                                        N_room;
+    uint32                                        N_take;
+    uint32                                        i;
+    bool                                          done      = false;
+
+    if(0 != rlc_tx_sdu_queue.size())
+    {
+        if(LIBLTE_RLC_UMD_SN_SIZE_5_BITS == rlc_um_sn_size)
+        {
+            N_hdr = 1;
+        }
+        umd->hdr.sn_size = rlc_um_sn_size;
+        umd->hdr.fi      = LIBLTE_RLC_FI_FIELD_FULL_SDU;
+        umd->N_slices    = 0;
+        if(0 != offset)
+        {
+            umd->hdr.fi = LIBLTE_RLC_FI_FIELD_LAST_SDU_SEGMENT;
+        }
+
+        // Concatenate queued SDUs, segmenting the last one that does not
+        // fit, each slice after the first costs an LI
+        iter = rlc_tx_sdu_queue.begin();
+        while(!done                                             &&
+              rlc_tx_sdu_queue.end()          != iter           &&
+              LIBLTE_RLC_UMD_PDU_MAX_N_SLICES >  umd->N_slices)
+        {
+            N_room = N_hdr + N_bytes + (umd->N_slices*12 + 7)/8;
+            if(max_N_bytes > N_room)
+            {
+                N_room  = max_N_bytes - N_room;
+                N_avail = (*iter)->N_bits/8 - offset;
+                N_take  = N_avail;
+                if(N_room < N_avail)
+                {
+                    N_take = N_room;
+                }
+
+                umd->slice[umd->N_slices].msg    = &(*iter)->msg[offset*8];
+                umd->slice[umd->N_slices].N_bits = N_take*8;
+                umd->N_slices++;
+                N_bytes += N_take;
+
+                if(N_take < N_avail)
+                {
+                    offset      += N_take;
+                    umd->hdr.fi  = (LIBLTE_RLC_FI_FIELD_ENUM)(umd->hdr.fi | LIBLTE_RLC_FI_FIELD_FIRST_SDU_SEGMENT);
+                    done         = true;
+                }else{
+                    offset = 0;
+                    N_sdus++;
+                    iter++;
+                }
+            }else{
+                done = true;
+            }
+        }
+
+        if(0              != umd->N_slices &&
+           LIBLTE_SUCCESS == liblte_rlc_pack_umd_pdu(umd, pdu))
+        {
+            // The PDU holds its own copy now, release the consumed SDUs
+            for(i=0; i<N_sdus; i++)
+            {
+                delete rlc_tx_sdu_queue.front();
+                rlc_tx_sdu_queue.pop_front();
+            }
+            rlc_um_tx_sdu_offset = offset;
+            err                  = LTE_FDD_ENB_ERROR_NONE;
+        }else{
+            // Drop an SDU that can never be sent
+            delete rlc_tx_sdu_queue.front();
+            rlc_tx_sdu_queue.pop_front();
+            rlc_um_tx_sdu_offset = 0;
+            err                  = LTE_FDD_ENB_ERROR_CANT_SCHEDULE;
+        }
+    }
+
+    return(err);
+}
+LIBLTE_BIT_MSG_STRUCT* LTE_fdd_enb_rb::rlc_alloc_buf(void)
+{
+    LIBLTE_BIT_MSG_STRUCT *buf;
+
+    if(0 != rlc_buf_pool.size())
+    {
+        buf = rlc_buf_pool.back();
+        rlc_buf_pool.pop_back();
+    }else{
+        buf = new LIBLTE_BIT_MSG_STRUCT;
+    }
+
+    return(buf);
+}
+void LTE_fdd_enb_rb::rlc_free_buf(LIBLTE_BIT_MSG_STRUCT *buf)
+{
+    rlc_buf_pool.push_back(buf);
+}
+LTE_FDD_ENB_RLC_AM_RX_PDU_STRUCT* LTE_fdd_enb_rb::rlc_get_rx_pdu(uint16 sn)
+{
+    // Only SNs inside the window are stored, so the window size is enough
+    // to index them uniquely
+    return(&rlc_reception_buffer[sn % LIBLTE_RLC_AM_WINDOW_SIZE]);
+}
+LTE_FDD_ENB_RLC_AM_TX_PDU_STRUCT* LTE_fdd_enb_rb::rlc_get_tx_pdu(uint16 sn)
+{
+    return(&rlc_transmission_buffer[sn % LIBLTE_RLC_AM_WINDOW_SIZE]);
+}
+LTE_FDD_ENB_RLC_UM_RX_PDU_STRUCT* LTE_fdd_enb_rb::rlc_um_get_rx_pdu(uint16 sn)
+{
+    // Only SNs inside the reordering window are stored
+    return(&rlc_um_reception_buffer[sn % rlc_um_window_size]);
+}
+void LTE_fdd_enb_rb::rlc_um_update_reordering_depth(void)
+{
+    rlc_um_stats.reordering_depth = (rlc_vruh + rlc_um_modulus - rlc_vrur) % rlc_um_modulus;
+    if(rlc_um_stats.reordering_depth > rlc_um_stats.max_reordering_depth)
+    {
+        rlc_um_stats.max_reordering_depth = rlc_um_stats.reordering_depth;
+    }
+}
 
 /*************/
 /*    MAC    */
@@ -337,25 +1445,6 @@ LTE_FDD_ENB_MAC_CONFIG_ENUM LTE_fdd_enb_rb::get_mac_config(void)
 {
     return(mac_config);
 }
-void LTE_fdd_enb_rb::start_ul_sched_timer(uint32 m_seconds)
-{
-    LTE_fdd_enb_timer_mgr *timer_mgr = LTE_fdd_enb_timer_mgr::get_instance();
-    LTE_fdd_enb_timer_cb   timer_expiry_cb(&LTE_fdd_enb_timer_cb_wrapper<LTE_fdd_enb_rb, &LTE_fdd_enb_rb::handle_ul_sched_timer_expiry>, this);
-
-    ul_sched_timer_m_seconds = m_seconds;
-    timer_mgr->start_timer(ul_sched_timer_m_seconds, timer_expiry_cb, &ul_sched_timer_id);
-}
-void LTE_fdd_enb_rb::handle_ul_sched_timer_expiry(uint32 timer_id)
-{
-    LTE_fdd_enb_mac *mac = LTE_fdd_enb_mac::get_instance();
-
-    mac->sched_ul(user, avail_qos[qos].bits_per_subfn);
-    if(LTE_FDD_ENB_RRC_PROC_IDLE  != rrc_procedure &&
-       LTE_FDD_ENB_RRC_STATE_IDLE != rrc_state)
-    {
-        start_ul_sched_timer(ul_sched_timer_m_seconds);
-    }
-}
 
 /*****************/
 /*    Generic    */
@@ -450,10 +1539,15 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_rb::delete_next_msg(boost::mutex
 }
 void LTE_fdd_enb_rb::set_qos(LTE_FDD_ENB_QOS_ENUM _qos)
 {
+    LTE_fdd_enb_mac *mac = LTE_fdd_enb_mac::get_instance();
+
     qos = _qos;
-    if(qos != LTE_FDD_ENB_QOS_NONE)
+
+    // Poll the UE for UL data until it reports its buffer status
+    user->set_ul_poll(avail_qos[qos].tti_frequency, avail_qos[qos].bits_per_subfn);
+    if(LTE_FDD_ENB_QOS_NONE != qos)
     {
-        start_ul_sched_timer(avail_qos[qos].tti_frequency-1);
+        mac->add_ul_sched_user(user->get_c_rnti());
     }
 }
 LTE_FDD_ENB_QOS_ENUM LTE_fdd_enb_rb::get_qos(void)
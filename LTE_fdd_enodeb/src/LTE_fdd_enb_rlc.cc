@@ -29,6 +29,15 @@
     01/18/2014    Ben Wojtowicz    Added level to debug prints.
     05/04/2014    Ben Wojtowicz    Added communication to MAC and PDCP.
     06/15/2014    Ben Wojtowicz    Added basic AM receive functionality.
+    10/19/2026    agent            Added full AM transmit and receive with
+                                   sliding windows, polling, t-Reordering,
+                                   t-StatusProhibit, t-PollRetransmit, NACKs,
+                                   and resegmentation.
+    10/19/2026    agent            Added UM transmit and receive with 5 and 10
+                                   bit SNs, a reordering window, t-Reordering,
+                                   and SDU concatenation.
+    10/19/2026    agent            Only copying the system information when
+                                   its version changes.
 
 *******************************************************************************/
 
@@ -91,7 +100,8 @@ void LTE_fdd_enb_rlc::cleanup(void)
 /********************************/
 LTE_fdd_enb_rlc::LTE_fdd_enb_rlc()
 {
-    started = false;
+    started          = false;
+    sys_info_version = 0;
 }
 LTE_fdd_enb_rlc::~LTE_fdd_enb_rlc()
 {
@@ -160,7 +170,7 @@ void LTE_fdd_enb_rlc::handle_mac_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg)
         }
     }else{
         // Forward message to PDCP
-        rlc_pdcp_mq->send(&msg, sizeof(msg), 0);
+        LTE_fdd_enb_msgq::forward(rlc_pdcp_mq, msg);
     }
 }
 void LTE_fdd_enb_rlc::handle_pdcp_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg)
@@ -188,7 +198,7 @@ void LTE_fdd_enb_rlc::handle_pdcp_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg)
         }
     }else{
         // Forward message to MAC
-        rlc_mac_mq->send(&msg, sizeof(msg), 0);
+        LTE_fdd_enb_msgq::forward(rlc_mac_mq, msg);
     }
 }
 
@@ -199,9 +209,87 @@ void LTE_fdd_enb_rlc::update_sys_info(void)
 {
     LTE_fdd_enb_cnfg_db *cnfg_db = LTE_fdd_enb_cnfg_db::get_instance();
 
-    sys_info_mutex.lock();
-    cnfg_db->get_sys_info(sys_info);
-    sys_info_mutex.unlock();
+    if(sys_info_version != cnfg_db->get_sys_info_version())
+    {
+        sys_info_mutex.lock();
+        sys_info_version = cnfg_db->get_sys_info(sys_info);
+        sys_info_mutex.unlock();
+    }
+}
+void LTE_fdd_enb_rlc::handle_timer_expiry(LTE_fdd_enb_user           *user,
+                                          LTE_fdd_enb_rb             *rb,
+                                          LTE_FDD_ENB_RLC_TIMER_ENUM  timer,
+                                          uint32                      timer_id)
+{
+    boost::mutex::scoped_lock  lock(entity_mutex);
+    LTE_fdd_enb_interface     *interface = LTE_fdd_enb_interface::get_instance();
+    uint16                     sn;
+
+    if(rb->rlc_timer_expired(timer, timer_id))
+    {
+        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                                  LTE_FDD_ENB_DEBUG_LEVEL_RLC,
+                                  __FILE__,
+                                  __LINE__,
+                                  "%s expired for RNTI=%u and RB=%s",
+                                  LTE_fdd_enb_rlc_timer_text[timer],
+                                  user->get_c_rnti(),
+                                  LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+
+        switch(timer)
+        {
+        case LTE_FDD_ENB_RLC_TIMER_T_POLL_RETRANSMIT:
+            // Retransmit the last PDU with a poll if anything is unacknowledged
+            if(rb->get_rlc_vts() != rb->get_rlc_vta())
+            {
+                sn = (rb->get_rlc_vts() + LIBLTE_RLC_AM_MODULUS - 1) % LIBLTE_RLC_AM_MODULUS;
+                am_check_retx_count(user, rb, sn);
+                am_send_amd_pdu(user, rb, sn, 0, LIBLTE_RLC_SO_END_OF_PDU, true);
+            }
+            break;
+        case LTE_FDD_ENB_RLC_TIMER_T_REORDERING:
+            if(LTE_FDD_ENB_RLC_CONFIG_UM == rb->get_rlc_config())
+            {
+                // Update VR(UR) to the first SN >= VR(UX) that is not received,
+                // reassembling everything below it
+                sn = rb->get_rlc_vrur();
+                while(sn != rb->get_rlc_vrux() ||
+                      rb->rlc_um_is_pdu_received(sn))
+                {
+                    um_reassemble(user, rb, sn);
+                    sn = (sn + 1) % rb->get_rlc_um_modulus();
+                }
+                rb->set_rlc_vrur(sn);
+                if(rb->get_rlc_um_window_size() > um_rx_offset(rb, rb->get_rlc_vrur()))
+                {
+                    rb->rlc_start_timer(LTE_FDD_ENB_RLC_TIMER_T_REORDERING);
+                    rb->set_rlc_vrux(rb->get_rlc_vruh());
+                }
+            }else{
+                // Update VR(MS) to the first SN >= VR(X) that is not fully received
+                sn = rb->get_rlc_vrx();
+                while(rb->rlc_is_pdu_received(sn))
+                {
+                    sn = (sn + 1) % LIBLTE_RLC_AM_MODULUS;
+                }
+                rb->set_rlc_vrms(sn);
+                am_check_delayed_poll(user, rb);
+                rb->set_rlc_status_pending(true);
+                if(am_rx_offset(rb, rb->get_rlc_vrh()) > am_rx_offset(rb, rb->get_rlc_vrms()))
+                {
+                    rb->rlc_start_timer(LTE_FDD_ENB_RLC_TIMER_T_REORDERING);
+                    rb->set_rlc_vrx(rb->get_rlc_vrh());
+                }
+                am_check_status(user, rb);
+            }
+            break;
+        case LTE_FDD_ENB_RLC_TIMER_T_STATUS_PROHIBIT:
+            am_check_status(user, rb);
+            break;
+        default:
+            break;
+        }
+    }
 }
 
 /******************************/
@@ -247,8 +335,11 @@ void LTE_fdd_enb_rlc::handle_pdu_ready(LTE_FDD_ENB_RLC_PDU_READY_MSG_STRUCT *pdu
             break;
         }
 
-        // Delete the PDU
-        pdu_ready->rb->delete_next_rlc_pdu();
+        // Delete the PDU, UM keeps its PDUs in the reordering window
+        if(LTE_FDD_ENB_RLC_CONFIG_UM != pdu_ready->rb->get_rlc_config())
+        {
+            pdu_ready->rb->delete_next_rlc_pdu();
+        }
     }else{
         interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
                                   LTE_FDD_ENB_DEBUG_LEVEL_RLC,
@@ -261,129 +352,339 @@ void LTE_fdd_enb_rlc::handle_tm_pdu(LIBLTE_BIT_MSG_STRUCT *pdu,
                                     LTE_fdd_enb_user      *user,
                                     LTE_fdd_enb_rb        *rb)
 {
-    LTE_FDD_ENB_PDCP_PDU_READY_MSG_STRUCT pdcp_pdu_ready;
-
-    // Queue the PDU for PDCP
-    rb->queue_pdcp_pdu(pdu);
-
-    // Signal PDCP
-    pdcp_pdu_ready.user = user;
-    pdcp_pdu_ready.rb   = rb;
-    LTE_fdd_enb_msgq::send(rlc_pdcp_mq,
-                           LTE_FDD_ENB_MESSAGE_TYPE_PDCP_PDU_READY,
-                           LTE_FDD_ENB_DEST_LAYER_PDCP,
-                           (LTE_FDD_ENB_MESSAGE_UNION *)&pdcp_pdu_ready,
-                           sizeof(LTE_FDD_ENB_PDCP_PDU_READY_MSG_STRUCT));
+    send_pdcp_pdu(pdu, user, rb);
 }
 void LTE_fdd_enb_rlc::handle_um_pdu(LIBLTE_BIT_MSG_STRUCT *pdu,
                                     LTE_fdd_enb_user      *user,
                                     LTE_fdd_enb_rb        *rb)
 {
-    LTE_fdd_enb_interface *interface = LTE_fdd_enb_interface::get_instance();
+    boost::mutex::scoped_lock        lock(entity_mutex);
+    LTE_fdd_enb_interface           *interface   = LTE_fdd_enb_interface::get_instance();
+    LIBLTE_RLC_UMD_PDU_STRUCT        umd;
+    LTE_FDD_ENB_RLC_UM_STATS_STRUCT  stats;
+    LTE_FDD_ENB_ERROR_ENUM           err         = LTE_FDD_ENB_ERROR_OUT_OF_BOUNDS;
+    uint16                           window_size = rb->get_rlc_um_window_size();
+    uint16                           sn;
+    uint16                           vrux_offset;
 
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                              LTE_FDD_ENB_DEBUG_LEVEL_RLC,
-                              __FILE__,
-                              __LINE__,
-                              "Not handling PDUs for RLC UM config");
+    if(LIBLTE_SUCCESS == liblte_rlc_unpack_umd_pdu(pdu, rb->get_rlc_um_sn_size(), &umd))
+    {
+        // PDUs below VR(UR) were already reassembled or given up on
+        if(um_rx_offset(rb, umd.hdr.sn) >= um_rx_offset(rb, rb->get_rlc_vrur()))
+        {
+            // A PDU beyond VR(UH) moves the window, reassemble whatever falls
+            // out of it first so that its slot in the buffer is free
+            if(window_size <= um_rx_offset(rb, umd.hdr.sn))
+            {
+                rb->set_rlc_vruh(umd.hdr.sn + 1);
+                sn = rb->get_rlc_vrur();
+                while(window_size <= um_rx_offset(rb, sn))
+                {
+                    um_reassemble(user, rb, sn);
+                    sn = (sn + 1) % rb->get_rlc_um_modulus();
+                }
+                rb->set_rlc_vrur(sn);
+            }
+            err = rb->rlc_um_add_to_reception_buffer(pdu, &umd);
+        }
+    }
+
+    if(LTE_FDD_ENB_ERROR_NONE == err)
+    {
+        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                                  LTE_FDD_ENB_DEBUG_LEVEL_RLC,
+                                  __FILE__,
+                                  __LINE__,
+                                  "Received UMD PDU for RNTI=%u, RB=%s, VR(UR)=%u, SN=%u, VR(UH)=%u, FI=%s, N_slices=%u",
+                                  user->get_c_rnti(),
+                                  LTE_fdd_enb_rb_text[rb->get_rb_id()],
+                                  rb->get_rlc_vrur(),
+                                  umd.hdr.sn,
+                                  rb->get_rlc_vruh(),
+                                  liblte_rlc_fi_field_text[umd.hdr.fi],
+                                  umd.N_slices);
+
+        // Update VR(UR) and reassemble
+        sn = rb->get_rlc_vrur();
+        while(rb->rlc_um_is_pdu_received(sn))
+        {
+            um_reassemble(user, rb, sn);
+            sn = (sn + 1) % rb->get_rlc_um_modulus();
+        }
+        rb->set_rlc_vrur(sn);
+
+        // Update t-Reordering
+        if(rb->rlc_is_timer_running(LTE_FDD_ENB_RLC_TIMER_T_REORDERING))
+        {
+            vrux_offset = um_rx_offset(rb, rb->get_rlc_vrux());
+            if(vrux_offset <= um_rx_offset(rb, rb->get_rlc_vrur()) ||
+               vrux_offset >  window_size)
+            {
+                rb->rlc_stop_timer(LTE_FDD_ENB_RLC_TIMER_T_REORDERING);
+            }
+        }
+        if(!rb->rlc_is_timer_running(LTE_FDD_ENB_RLC_TIMER_T_REORDERING) &&
+           window_size > um_rx_offset(rb, rb->get_rlc_vrur()))
+        {
+            rb->rlc_start_timer(LTE_FDD_ENB_RLC_TIMER_T_REORDERING);
+            rb->set_rlc_vrux(rb->get_rlc_vruh());
+        }
+    }else{
+        rb->rlc_um_count_dropped_pdu();
+        stats = rb->get_rlc_um_stats();
+        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                                  LTE_FDD_ENB_DEBUG_LEVEL_RLC,
+                                  __FILE__,
+                                  __LINE__,
+                                  pdu,
+                                  "Discarding UMD PDU for RNTI=%u, RB=%s, VR(UR)=%u, VR(UH)=%u, N_pdus_dropped=%u (%s)",
+                                  user->get_c_rnti(),
+                                  LTE_fdd_enb_rb_text[rb->get_rb_id()],
+                                  rb->get_rlc_vrur(),
+                                  rb->get_rlc_vruh(),
+                                  stats.N_pdus_dropped,
+                                  LTE_fdd_enb_error_text[err]);
+
+        // Kept PDUs are deleted once reassembled, discarded ones right away
+        rb->delete_next_rlc_pdu();
+    }
 }
 void LTE_fdd_enb_rlc::handle_am_pdu(LIBLTE_BIT_MSG_STRUCT *pdu,
                                     LTE_fdd_enb_user      *user,
                                     LTE_fdd_enb_rb        *rb)
 {
-    LTE_fdd_enb_interface                 *interface = LTE_fdd_enb_interface::get_instance();
-    LTE_FDD_ENB_PDCP_PDU_READY_MSG_STRUCT  pdcp_pdu_ready;
-    LTE_FDD_ENB_MAC_SDU_READY_MSG_STRUCT   mac_sdu_ready;
-    LIBLTE_BIT_MSG_STRUCT                  pdcp_pdu;
-    LIBLTE_BIT_MSG_STRUCT                  mac_sdu;
-    LIBLTE_RLC_AMD_PDU_STRUCT              amd;
-    LIBLTE_RLC_STATUS_PDU_STRUCT           status;
-    uint16                                 vrr  = rb->get_rlc_vrr();
-    uint16                                 vrmr = rb->get_rlc_vrmr();
-    uint16                                 vrh  = rb->get_rlc_vrh();
-
-    liblte_rlc_unpack_amd_pdu(pdu, &amd);
-
-    if(vrr        <= amd.hdr.sn &&
-       amd.hdr.sn <  vrmr)
+    boost::mutex::scoped_lock lock(entity_mutex);
+
+    if(LIBLTE_RLC_DC_FIELD_DATA_PDU == pdu->msg[0])
+    {
+        handle_amd_pdu(pdu, user, rb);
+    }else{
+        handle_status_pdu(pdu, user, rb);
+    }
+}
+void LTE_fdd_enb_rlc::handle_amd_pdu(LIBLTE_BIT_MSG_STRUCT *pdu,
+                                     LTE_fdd_enb_user      *user,
+                                     LTE_fdd_enb_rb        *rb)
+{
+    LTE_fdd_enb_interface     *interface = LTE_fdd_enb_interface::get_instance();
+    LIBLTE_BIT_MSG_STRUCT      pdcp_pdu;
+    LIBLTE_RLC_AMD_PDU_STRUCT  amd;
+    LTE_FDD_ENB_ERROR_ENUM     err;
+    uint16                     sn;
+    uint16                     vrx_offset;
+
+    if(LIBLTE_SUCCESS != liblte_rlc_unpack_amd_pdu(pdu, &amd))
+    {
+        // Bad length indicators, only the header is usable
+        amd.data.N_bits = 0;
+        err             = LTE_FDD_ENB_ERROR_CANT_REASSEMBLE_SDU;
+    }else if(LIBLTE_RLC_AM_WINDOW_SIZE > am_rx_offset(rb, amd.hdr.sn)){
+        err = rb->rlc_add_to_reception_buffer(&amd);
+    }else{
+        err = LTE_FDD_ENB_ERROR_OUT_OF_BOUNDS;
+    }
+
+    if(LTE_FDD_ENB_ERROR_NONE == err)
     {
         interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
                                   LTE_FDD_ENB_DEBUG_LEVEL_RLC,
                                   __FILE__,
                                   __LINE__,
                                   &amd.data,
-                                  "Received AMD PDU for RNTI=%u, RB=%s, VR(R)=%u, SN=%u, VR(MR)=%u, VR(H)=%u, RF=%s, P=%s, FI=%s",
+                                  "Received AMD PDU for RNTI=%u, RB=%s, VR(R)=%u, SN=%u, SO=%u, VR(MS)=%u, VR(H)=%u, RF=%s, P=%s, FI=%s",
                                   user->get_c_rnti(),
                                   LTE_fdd_enb_rb_text[rb->get_rb_id()],
-                                  vrr,
+                                  rb->get_rlc_vrr(),
                                   amd.hdr.sn,
-                                  vrmr,
-                                  vrh,
+                                  amd.hdr.so,
+                                  rb->get_rlc_vrms(),
+                                  rb->get_rlc_vrh(),
                                   liblte_rlc_rf_field_text[amd.hdr.rf],
                                   liblte_rlc_p_field_text[amd.hdr.p],
                                   liblte_rlc_fi_field_text[amd.hdr.fi]);
 
-        // Place RLC data PDU in reception buffer
-        rb->rlc_add_to_reception_buffer(&amd);
-
         // Update VR(H)
-        if(amd.hdr.sn >= vrh)
+        if(am_rx_offset(rb, amd.hdr.sn) >= am_rx_offset(rb, rb->get_rlc_vrh()))
         {
             rb->set_rlc_vrh(amd.hdr.sn + 1);
         }
 
         // Update VR(MS)
-        // FIXME
+        sn = rb->get_rlc_vrms();
+        while(rb->rlc_is_pdu_received(sn))
+        {
+            sn = (sn + 1) % LIBLTE_RLC_AM_MODULUS;
+        }
+        rb->set_rlc_vrms(sn);
 
         // Update VR(R)/VR(MR) and reassemble
-        if(amd.hdr.sn == vrr)
+        if(amd.hdr.sn == rb->get_rlc_vrr())
         {
-            // FIXME: Handle AMD PDU Segments
-            rb->set_rlc_vrr(amd.hdr.sn + 1);
-
-            if(LTE_FDD_ENB_ERROR_NONE == rb->rlc_reassemble(&pdcp_pdu))
+            sn = rb->get_rlc_vrr();
+            while(rb->rlc_is_pdu_received(sn))
             {
-                // Queue the SDU for PDCP
-                rb->queue_pdcp_pdu(&pdcp_pdu);
-
-                // Signal PDCP
-                pdcp_pdu_ready.user = user;
-                pdcp_pdu_ready.rb   = rb;
-                LTE_fdd_enb_msgq::send(rlc_pdcp_mq,
-                                       LTE_FDD_ENB_MESSAGE_TYPE_PDCP_PDU_READY,
-                                       LTE_FDD_ENB_DEST_LAYER_PDCP,
-                                       (LTE_FDD_ENB_MESSAGE_UNION *)&pdcp_pdu_ready,
-                                       sizeof(LTE_FDD_ENB_PDCP_PDU_READY_MSG_STRUCT));
+                while(LTE_FDD_ENB_ERROR_NONE == rb->rlc_reassemble(sn, &pdcp_pdu))
+                {
+                    send_pdcp_pdu(&pdcp_pdu, user, rb);
+                }
+                sn = (sn + 1) % LIBLTE_RLC_AM_MODULUS;
             }
+            rb->set_rlc_vrr(sn);
         }
 
-        // Send a STATUS PDU to acknowledge the PDU
-        status.ack_sn = amd.hdr.sn + 1;
-        liblte_rlc_pack_status_pdu(&status, &mac_sdu);
-
-        // Queue the PDU for MAC
-        rb->queue_mac_sdu(&mac_sdu);
-
-        // Signal MAC
-        mac_sdu_ready.user = user;
-        mac_sdu_ready.rb   = rb;
-        LTE_fdd_enb_msgq::send(rlc_mac_mq,
-                               LTE_FDD_ENB_MESSAGE_TYPE_MAC_SDU_READY,
-                               LTE_FDD_ENB_DEST_LAYER_MAC,
-                               (LTE_FDD_ENB_MESSAGE_UNION *)&mac_sdu_ready,
-                               sizeof(LTE_FDD_ENB_MAC_SDU_READY_MSG_STRUCT));
+        // Update t-Reordering
+        if(rb->rlc_is_timer_running(LTE_FDD_ENB_RLC_TIMER_T_REORDERING))
+        {
+            vrx_offset = am_rx_offset(rb, rb->get_rlc_vrx());
+            if(0                         == vrx_offset ||
+               LIBLTE_RLC_AM_WINDOW_SIZE <  vrx_offset)
+            {
+                rb->rlc_stop_timer(LTE_FDD_ENB_RLC_TIMER_T_REORDERING);
+            }
+        }
+        if(!rb->rlc_is_timer_running(LTE_FDD_ENB_RLC_TIMER_T_REORDERING) &&
+           0 != am_rx_offset(rb, rb->get_rlc_vrh()))
+        {
+            rb->rlc_start_timer(LTE_FDD_ENB_RLC_TIMER_T_REORDERING);
+            rb->set_rlc_vrx(rb->get_rlc_vrh());
+        }
     }else{
         interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
                                   LTE_FDD_ENB_DEBUG_LEVEL_RLC,
                                   __FILE__,
                                   __LINE__,
                                   &amd.data,
-                                  "Received AMD PDU for RNTI=%u, RB=%s, that is outside of the receiving window (%u <= %u < %u)",
+                                  "Discarding AMD PDU for RNTI=%u, RB=%s, VR(R)=%u, SN=%u, SO=%u, VR(MR)=%u (%s)",
                                   user->get_c_rnti(),
                                   LTE_fdd_enb_rb_text[rb->get_rb_id()],
-                                  vrr,
+                                  rb->get_rlc_vrr(),
                                   amd.hdr.sn,
-                                  vrmr);
+                                  amd.hdr.so,
+                                  rb->get_rlc_vrmr(),
+                                  LTE_fdd_enb_error_text[err]);
+    }
+
+    // Polls for PDUs that are still being reordered are answered once VR(MS)
+    // moves past them
+    am_check_delayed_poll(user, rb);
+    if(LIBLTE_RLC_P_FIELD_STATUS_REPORT_REQUESTED == amd.hdr.p)
+    {
+        if(LTE_FDD_ENB_ERROR_NONE       != err                                    ||
+           am_rx_offset(rb, amd.hdr.sn) <  am_rx_offset(rb, rb->get_rlc_vrms()) ||
+           LIBLTE_RLC_AM_WINDOW_SIZE    <= am_rx_offset(rb, amd.hdr.sn))
+        {
+            rb->set_rlc_status_pending(true);
+        }else{
+            rb->set_rlc_poll_delayed(true, amd.hdr.sn);
+        }
+    }
+    am_check_status(user, rb);
+}
+void LTE_fdd_enb_rlc::handle_status_pdu(LIBLTE_BIT_MSG_STRUCT *pdu,
+                                        LTE_fdd_enb_user      *user,
+                                        LTE_fdd_enb_rb        *rb)
+{
+    LTE_fdd_enb_interface        *interface = LTE_fdd_enb_interface::get_instance();
+    LIBLTE_RLC_STATUS_PDU_STRUCT  status;
+    LIBLTE_BIT_MSG_STRUCT        *sdu;
+    uint32                        N_nack;
+    uint32                        i;
+    uint16                        ack_offset;
+    uint16                        sn;
+    uint16                        vta;
+    bool                          poll;
+
+    if(LIBLTE_SUCCESS == liblte_rlc_unpack_status_pdu(pdu, &status))
+    {
+        ack_offset = am_tx_offset(rb, status.ack_sn);
+
+        if(ack_offset <= am_tx_offset(rb, rb->get_rlc_vts()))
+        {
+            // Only NACKs below ACK_SN are valid
+            N_nack = 0;
+            while(N_nack                                        < status.N_nack &&
+                  am_tx_offset(rb, status.nack[N_nack].nack_sn) < ack_offset)
+            {
+                N_nack++;
+            }
+
+            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                                      LTE_FDD_ENB_DEBUG_LEVEL_RLC,
+                                      __FILE__,
+                                      __LINE__,
+                                      "Received STATUS PDU for RNTI=%u, RB=%s, VT(A)=%u, ACK_SN=%u, VT(S)=%u, N_NACK=%u",
+                                      user->get_c_rnti(),
+                                      LTE_fdd_enb_rb_text[rb->get_rb_id()],
+                                      rb->get_rlc_vta(),
+                                      status.ack_sn,
+                                      rb->get_rlc_vts(),
+                                      N_nack);
+
+            // Stop t-PollRetransmit if the STATUS PDU covers POLL_SN
+            if(rb->rlc_is_timer_running(LTE_FDD_ENB_RLC_TIMER_T_POLL_RETRANSMIT) &&
+               am_tx_offset(rb, rb->get_rlc_poll_sn()) < ack_offset)
+            {
+                rb->rlc_stop_timer(LTE_FDD_ENB_RLC_TIMER_T_POLL_RETRANSMIT);
+            }
+
+            // Free positively acknowledged PDUs and retransmit NACKed PDUs
+            // or the NACKed portions of them, polling on the last one if
+            // there is nothing else to send
+            vta = status.ack_sn;
+            sn  = rb->get_rlc_vta();
+            i   = 0;
+            while(sn != status.ack_sn)
+            {
+                if(i                      <  N_nack &&
+                   status.nack[i].nack_sn == sn)
+                {
+                    if(vta == status.ack_sn)
+                    {
+                        vta = sn;
+                    }
+                    am_check_retx_count(user, rb, sn);
+                    while(i                      <  N_nack &&
+                          status.nack[i].nack_sn == sn)
+                    {
+                        poll = false;
+                        if((N_nack - 1)                   == i &&
+                           LTE_FDD_ENB_ERROR_NO_MSG_IN_QUEUE == rb->rlc_get_next_tx_sdu(&sdu))
+                        {
+                            poll = true;
+                        }
+                        am_send_amd_pdu(user, rb, sn, status.nack[i].so_start, status.nack[i].so_end, poll);
+                        i++;
+                    }
+                }else{
+                    rb->rlc_remove_from_transmission_buffer(sn);
+                }
+                sn = (sn + 1) % LIBLTE_RLC_AM_MODULUS;
+            }
+
+            // Update VT(A)/VT(MS) and send anything the window was holding
+            rb->set_rlc_vta(vta);
+            am_send_tx_sdus(user, rb);
+        }else{
+            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                                      LTE_FDD_ENB_DEBUG_LEVEL_RLC,
+                                      __FILE__,
+                                      __LINE__,
+                                      "Received STATUS PDU for RNTI=%u, RB=%s, with invalid ACK_SN (%u <= %u <= %u)",
+                                      user->get_c_rnti(),
+                                      LTE_fdd_enb_rb_text[rb->get_rb_id()],
+                                      rb->get_rlc_vta(),
+                                      status.ack_sn,
+                                      rb->get_rlc_vts());
+        }
+    }else{
+        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                                  LTE_FDD_ENB_DEBUG_LEVEL_RLC,
+                                  __FILE__,
+                                  __LINE__,
+                                  pdu,
+                                  "Received invalid control PDU for RNTI=%u and RB=%s",
+                                  user->get_c_rnti(),
+                                  LTE_fdd_enb_rb_text[rb->get_rb_id()]);
     }
 }
 
@@ -429,8 +730,11 @@ void LTE_fdd_enb_rlc::handle_sdu_ready(LTE_FDD_ENB_RLC_SDU_READY_MSG_STRUCT *sdu
             break;
         }
 
-        // Delete the SDU
-        sdu_ready->rb->delete_next_rlc_sdu();
+        // Delete the SDU, UM keeps its SDUs until they are packed
+        if(LTE_FDD_ENB_RLC_CONFIG_UM != sdu_ready->rb->get_rlc_config())
+        {
+            sdu_ready->rb->delete_next_rlc_sdu();
+        }
     }else{
         interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
                                   LTE_FDD_ENB_DEBUG_LEVEL_RLC,
@@ -443,41 +747,364 @@ void LTE_fdd_enb_rlc::handle_tm_sdu(LIBLTE_BIT_MSG_STRUCT *sdu,
                                     LTE_fdd_enb_user      *user,
                                     LTE_fdd_enb_rb        *rb)
 {
-    LTE_FDD_ENB_MAC_SDU_READY_MSG_STRUCT mac_sdu_ready;
-
-    // Queue the SDU for MAC
-    rb->queue_mac_sdu(sdu);
-
-    // Signal MAC
-    mac_sdu_ready.user = user;
-    mac_sdu_ready.rb   = rb;
-    LTE_fdd_enb_msgq::send(rlc_mac_mq,
-                           LTE_FDD_ENB_MESSAGE_TYPE_MAC_SDU_READY,
-                           LTE_FDD_ENB_DEST_LAYER_MAC,
-                           (LTE_FDD_ENB_MESSAGE_UNION *)&mac_sdu_ready,
-                           sizeof(LTE_FDD_ENB_MAC_SDU_READY_MSG_STRUCT));
+    send_mac_sdu(sdu, user, rb);
 }
 void LTE_fdd_enb_rlc::handle_um_sdu(LIBLTE_BIT_MSG_STRUCT *sdu,
                                     LTE_fdd_enb_user      *user,
                                     LTE_fdd_enb_rb        *rb)
 {
-    LTE_fdd_enb_interface *interface = LTE_fdd_enb_interface::get_instance();
+    boost::mutex::scoped_lock lock(entity_mutex);
 
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
-                              LTE_FDD_ENB_DEBUG_LEVEL_RLC,
-                              __FILE__,
-                              __LINE__,
-                              "Not handling SDUs for RLC UM config");
+    // Hold off while more SDUs are waiting so that they can be concatenated
+    // into the same UMD PDU
+    rb->rlc_um_queue_tx_sdu(sdu);
+    if(0 == rb->get_n_rlc_sdus())
+    {
+        um_send_tx_sdus(user, rb);
+    }
 }
 void LTE_fdd_enb_rlc::handle_am_sdu(LIBLTE_BIT_MSG_STRUCT *sdu,
                                     LTE_fdd_enb_user      *user,
                                     LTE_fdd_enb_rb        *rb)
+{
+    boost::mutex::scoped_lock lock(entity_mutex);
+
+    // Queue the SDU and send as much as the transmitting window allows
+    rb->rlc_queue_tx_sdu(sdu);
+    am_send_tx_sdus(user, rb);
+}
+
+/***********************/
+/*    AM Procedures    */
+/***********************/
+void LTE_fdd_enb_rlc::am_send_tx_sdus(LTE_fdd_enb_user *user,
+                                      LTE_fdd_enb_rb   *rb)
+{
+    LIBLTE_BIT_MSG_STRUCT *sdu;
+    uint32                 N_bytes;
+    uint16                 sn;
+    bool                   poll;
+
+    while(LIBLTE_RLC_AM_WINDOW_SIZE > am_tx_offset(rb, rb->get_rlc_vts()) &&
+          LTE_FDD_ENB_ERROR_NONE    == rb->rlc_pop_next_tx_sdu(&sdu))
+    {
+        // Each SDU is sent as one AMD PDU, MAC sizes the grant to fit it,
+        // the SDU buffer moves into the transmission buffer
+        sn      = rb->get_rlc_vts();
+        N_bytes = sdu->N_bits/8;
+        rb->rlc_add_to_transmission_buffer(sn, sdu);
+        rb->set_rlc_vts(sn + 1);
+
+        // Poll when enough has been sent without one, when there is nothing
+        // left to send, or when the window is stalled
+        rb->set_rlc_pdu_without_poll(rb->get_rlc_pdu_without_poll() + 1);
+        rb->set_rlc_byte_without_poll(rb->get_rlc_byte_without_poll() + N_bytes);
+        poll = false;
+        if(rb->get_rlc_pdu_without_poll()  >= rb->get_rlc_poll_pdu()        ||
+           rb->get_rlc_byte_without_poll() >= rb->get_rlc_poll_byte()       ||
+           LTE_FDD_ENB_ERROR_NO_MSG_IN_QUEUE == rb->rlc_get_next_tx_sdu(&sdu) ||
+           LIBLTE_RLC_AM_WINDOW_SIZE       <= am_tx_offset(rb, rb->get_rlc_vts()))
+        {
+            poll = true;
+        }
+
+        am_send_amd_pdu(user, rb, sn, 0, LIBLTE_RLC_SO_END_OF_PDU, poll);
+    }
+}
+void LTE_fdd_enb_rlc::am_send_amd_pdu(LTE_fdd_enb_user *user,
+                                      LTE_fdd_enb_rb   *rb,
+                                      uint16            sn,
+                                      uint16            so_start,
+                                      uint16            so_end,
+                                      bool              poll)
+{
+    LTE_fdd_enb_interface     *interface = LTE_fdd_enb_interface::get_instance();
+    LIBLTE_BIT_MSG_STRUCT     *data;
+    LIBLTE_BIT_MSG_STRUCT      mac_sdu;
+    LIBLTE_RLC_AMD_PDU_STRUCT  amd;
+    LIBLTE_RLC_FI_FIELD_ENUM   fi;
+    uint32                     N_bytes;
+    uint32                     end;
+
+    if(LTE_FDD_ENB_ERROR_NONE == rb->rlc_get_transmission_buffer_pdu(sn, &data, &fi))
+    {
+        N_bytes = data->N_bits/8;
+        end     = so_end + 1;
+        if(LIBLTE_RLC_SO_END_OF_PDU == so_end ||
+           N_bytes                  <  end)
+        {
+            end = N_bytes;
+        }
+
+        if(so_start < end)
+        {
+            if(0       == so_start &&
+               N_bytes == end)
+            {
+                amd.hdr.rf = LIBLTE_RLC_RF_FIELD_AMD_PDU;
+                amd.hdr.fi = fi;
+            }else{
+                // Resegment, the FI of each end comes from the PDU only if
+                // the segment includes that end
+                amd.hdr.rf = LIBLTE_RLC_RF_FIELD_AMD_PDU_SEGMENT;
+                amd.hdr.fi = (LIBLTE_RLC_FI_FIELD_ENUM)(((0 == so_start) ? (fi & 0x2) : 0x2) |
+                                                        ((N_bytes == end) ? (fi & 0x1) : 0x1));
+            }
+            if(N_bytes == end)
+            {
+                amd.hdr.lsf = LIBLTE_RLC_LSF_FIELD_LAST_SEGMENT;
+            }else{
+                amd.hdr.lsf = LIBLTE_RLC_LSF_FIELD_NOT_LAST_SEGMENT;
+            }
+            if(poll)
+            {
+                amd.hdr.p = LIBLTE_RLC_P_FIELD_STATUS_REPORT_REQUESTED;
+            }else{
+                amd.hdr.p = LIBLTE_RLC_P_FIELD_STATUS_REPORT_NOT_REQUESTED;
+            }
+            amd.hdr.sn      = sn;
+            amd.hdr.so      = so_start;
+            amd.data.N_bits = (end - so_start)*8;
+            memcpy(amd.data.msg, &data->msg[so_start*8], amd.data.N_bits);
+            liblte_rlc_pack_amd_pdu(&amd, &mac_sdu);
+
+            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                                      LTE_FDD_ENB_DEBUG_LEVEL_RLC,
+                                      __FILE__,
+                                      __LINE__,
+                                      &amd.data,
+                                      "Sending AMD PDU for RNTI=%u, RB=%s, VT(A)=%u, SN=%u, SO=%u, VT(S)=%u, RF=%s, P=%s, FI=%s",
+                                      user->get_c_rnti(),
+                                      LTE_fdd_enb_rb_text[rb->get_rb_id()],
+                                      rb->get_rlc_vta(),
+                                      sn,
+                                      so_start,
+                                      rb->get_rlc_vts(),
+                                      liblte_rlc_rf_field_text[amd.hdr.rf],
+                                      liblte_rlc_p_field_text[amd.hdr.p],
+                                      liblte_rlc_fi_field_text[amd.hdr.fi]);
+
+            send_mac_sdu(&mac_sdu, user, rb);
+
+            if(poll)
+            {
+                rb->set_rlc_pdu_without_poll(0);
+                rb->set_rlc_byte_without_poll(0);
+                rb->set_rlc_poll_sn(rb->get_rlc_vts() + LIBLTE_RLC_AM_MODULUS - 1);
+                rb->rlc_start_timer(LTE_FDD_ENB_RLC_TIMER_T_POLL_RETRANSMIT);
+            }
+        }
+    }
+}
+void LTE_fdd_enb_rlc::am_check_retx_count(LTE_fdd_enb_user *user,
+                                          LTE_fdd_enb_rb   *rb,
+                                          uint16            sn)
 {
     LTE_fdd_enb_interface *interface = LTE_fdd_enb_interface::get_instance();
 
-    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+    // Indicate radio link failure to RRC once, when the threshold is reached
+    if(rb->rlc_increment_retx_count(sn) == rb->get_rlc_max_retx_threshold())
+    {
+        interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                                  LTE_FDD_ENB_DEBUG_LEVEL_RLC,
+                                  __FILE__,
+                                  __LINE__,
+                                  "Maximum retransmissions reached for RNTI=%u, RB=%s, SN=%u",
+                                  user->get_c_rnti(),
+                                  LTE_fdd_enb_rb_text[rb->get_rb_id()],
+                                  sn);
+        send_radio_link_failure(user, rb);
+    }
+}
+void LTE_fdd_enb_rlc::am_check_delayed_poll(LTE_fdd_enb_user *user,
+                                            LTE_fdd_enb_rb   *rb)
+{
+    uint16 offset = am_rx_offset(rb, rb->get_rlc_poll_delayed_sn());
+
+    if(rb->get_rlc_poll_delayed()                           &&
+       (offset                    <  am_rx_offset(rb, rb->get_rlc_vrms()) ||
+        LIBLTE_RLC_AM_WINDOW_SIZE <= offset))
+    {
+        rb->set_rlc_poll_delayed(false, 0);
+        rb->set_rlc_status_pending(true);
+    }
+}
+void LTE_fdd_enb_rlc::am_check_status(LTE_fdd_enb_user *user,
+                                      LTE_fdd_enb_rb   *rb)
+{
+    // All triggers from one event are answered by a single STATUS PDU, which
+    // waits for t-StatusProhibit if it is running
+    if(rb->get_rlc_status_pending() &&
+       !rb->rlc_is_timer_running(LTE_FDD_ENB_RLC_TIMER_T_STATUS_PROHIBIT))
+    {
+        am_send_status(user, rb);
+    }
+}
+void LTE_fdd_enb_rlc::am_send_status(LTE_fdd_enb_user *user,
+                                     LTE_fdd_enb_rb   *rb)
+{
+    LTE_fdd_enb_interface        *interface = LTE_fdd_enb_interface::get_instance();
+    LIBLTE_BIT_MSG_STRUCT         mac_sdu;
+    LIBLTE_RLC_STATUS_PDU_STRUCT  status;
+    uint16                        sn;
+
+    // ACK everything below VR(MS) and NACK the holes, stopping early if the
+    // NACKs do not fit
+    status.ack_sn = rb->get_rlc_vrms();
+    status.N_nack = 0;
+    sn            = rb->get_rlc_vrr();
+    while(sn != status.ack_sn)
+    {
+        if(LTE_FDD_ENB_ERROR_NONE == rb->rlc_add_nacks(sn, &status))
+        {
+            sn = (sn + 1) % LIBLTE_RLC_AM_MODULUS;
+        }else{
+            status.ack_sn = sn;
+        }
+    }
+    liblte_rlc_pack_status_pdu(&status, &mac_sdu);
+
+    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
                               LTE_FDD_ENB_DEBUG_LEVEL_RLC,
                               __FILE__,
                               __LINE__,
-                              "Not handling SDUs for RLC AM config");
+                              "Sending STATUS PDU for RNTI=%u, RB=%s, ACK_SN=%u, N_NACK=%u",
+                              user->get_c_rnti(),
+                              LTE_fdd_enb_rb_text[rb->get_rb_id()],
+                              status.ack_sn,
+                              status.N_nack);
+
+    send_mac_sdu(&mac_sdu, user, rb);
+
+    rb->set_rlc_status_pending(false);
+    rb->rlc_start_timer(LTE_FDD_ENB_RLC_TIMER_T_STATUS_PROHIBIT);
+}
+uint16 LTE_fdd_enb_rlc::am_rx_offset(LTE_fdd_enb_rb *rb,
+                                     uint16          sn)
+{
+    // Receiving side SNs are compared relative to VR(R)
+    return((sn + LIBLTE_RLC_AM_MODULUS - rb->get_rlc_vrr()) % LIBLTE_RLC_AM_MODULUS);
+}
+uint16 LTE_fdd_enb_rlc::am_tx_offset(LTE_fdd_enb_rb *rb,
+                                     uint16          sn)
+{
+    // Transmitting side SNs are compared relative to VT(A)
+    return((sn + LIBLTE_RLC_AM_MODULUS - rb->get_rlc_vta()) % LIBLTE_RLC_AM_MODULUS);
+}
+
+/***********************/
+/*    UM Procedures    */
+/***********************/
+void LTE_fdd_enb_rlc::um_send_tx_sdus(LTE_fdd_enb_user *user,
+                                      LTE_fdd_enb_rb   *rb)
+{
+    LTE_fdd_enb_interface     *interface = LTE_fdd_enb_interface::get_instance();
+    LIBLTE_RLC_UMD_PDU_STRUCT  umd;
+    LIBLTE_BIT_MSG_STRUCT      mac_sdu;
+    LTE_FDD_ENB_ERROR_ENUM     err       = LTE_FDD_ENB_ERROR_NONE;
+
+    while(LTE_FDD_ENB_ERROR_NO_MSG_IN_QUEUE != err)
+    {
+        umd.hdr.sn = rb->get_rlc_vtus();
+        err        = rb->rlc_um_build_pdu(&umd, LTE_FDD_ENB_RLC_UM_MAX_PDU_BYTES, &mac_sdu);
+
+        if(LTE_FDD_ENB_ERROR_NONE == err)
+        {
+            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_INFO,
+                                      LTE_FDD_ENB_DEBUG_LEVEL_RLC,
+                                      __FILE__,
+                                      __LINE__,
+                                      &mac_sdu,
+                                      "Sending UMD PDU for RNTI=%u, RB=%s, SN=%u, FI=%s, N_slices=%u",
+                                      user->get_c_rnti(),
+                                      LTE_fdd_enb_rb_text[rb->get_rb_id()],
+                                      umd.hdr.sn,
+                                      liblte_rlc_fi_field_text[umd.hdr.fi],
+                                      umd.N_slices);
+
+            rb->set_rlc_vtus(umd.hdr.sn + 1);
+            send_mac_sdu(&mac_sdu, user, rb);
+        }else if(LTE_FDD_ENB_ERROR_CANT_SCHEDULE == err){
+            interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                                      LTE_FDD_ENB_DEBUG_LEVEL_RLC,
+                                      __FILE__,
+                                      __LINE__,
+                                      "Dropped SDU that does not fit in an UMD PDU for RNTI=%u and RB=%s",
+                                      user->get_c_rnti(),
+                                      LTE_fdd_enb_rb_text[rb->get_rb_id()]);
+        }
+    }
+}
+void LTE_fdd_enb_rlc::um_reassemble(LTE_fdd_enb_user *user,
+                                    LTE_fdd_enb_rb   *rb,
+                                    uint16            sn)
+{
+    LIBLTE_BIT_MSG_STRUCT pdcp_pdu;
+
+    // One UMD PDU can complete several SDUs
+    while(LTE_FDD_ENB_ERROR_NONE == rb->rlc_um_reassemble(sn, &pdcp_pdu))
+    {
+        send_pdcp_pdu(&pdcp_pdu, user, rb);
+    }
+}
+uint16 LTE_fdd_enb_rlc::um_rx_offset(LTE_fdd_enb_rb *rb,
+                                     uint16          sn)
+{
+    // Receiving side SNs are compared relative to VR(UH) - UM_Window_Size, so
+    // offsets below the window size are inside the reordering window
+    return((sn + rb->get_rlc_um_modulus() + rb->get_rlc_um_window_size() - rb->get_rlc_vruh()) % rb->get_rlc_um_modulus());
+}
+
+/*****************/
+/*    Helpers    */
+/*****************/
+void LTE_fdd_enb_rlc::send_pdcp_pdu(LIBLTE_BIT_MSG_STRUCT *pdu,
+                                    LTE_fdd_enb_user      *user,
+                                    LTE_fdd_enb_rb        *rb)
+{
+    LTE_FDD_ENB_PDCP_PDU_READY_MSG_STRUCT pdcp_pdu_ready;
+
+    // Queue the PDU for PDCP
+    rb->queue_pdcp_pdu(pdu);
+
+    // Signal PDCP
+    pdcp_pdu_ready.user = user;
+    pdcp_pdu_ready.rb   = rb;
+    LTE_fdd_enb_msgq::send(rlc_pdcp_mq,
+                           LTE_FDD_ENB_MESSAGE_TYPE_PDCP_PDU_READY,
+                           LTE_FDD_ENB_DEST_LAYER_PDCP,
+                           (LTE_FDD_ENB_MESSAGE_UNION *)&pdcp_pdu_ready,
+                           sizeof(LTE_FDD_ENB_PDCP_PDU_READY_MSG_STRUCT));
+}
+void LTE_fdd_enb_rlc::send_mac_sdu(LIBLTE_BIT_MSG_STRUCT *sdu,
+                                   LTE_fdd_enb_user      *user,
+                                   LTE_fdd_enb_rb        *rb)
+{
+    LTE_FDD_ENB_MAC_SDU_READY_MSG_STRUCT mac_sdu_ready;
+
+    // Queue the SDU for MAC
+    rb->queue_mac_sdu(sdu);
+
+    // Signal MAC
+    mac_sdu_ready.user = user;
+    mac_sdu_ready.rb   = rb;
+    LTE_fdd_enb_msgq::send(rlc_mac_mq,
+                           LTE_FDD_ENB_MESSAGE_TYPE_MAC_SDU_READY,
+                           LTE_FDD_ENB_DEST_LAYER_MAC,
+                           (LTE_FDD_ENB_MESSAGE_UNION *)&mac_sdu_ready,
+                           sizeof(LTE_FDD_ENB_MAC_SDU_READY_MSG_STRUCT));
+}
+void LTE_fdd_enb_rlc::send_radio_link_failure(LTE_fdd_enb_user *user,
+                                              LTE_fdd_enb_rb   *rb)
+{
+    LTE_FDD_ENB_RRC_RADIO_LINK_FAILURE_MSG_STRUCT rrc_radio_link_failure;
+
+    // Signal RRC, PDCP forwards it
+    rrc_radio_link_failure.user = user;
+    rrc_radio_link_failure.rb   = rb;
+    LTE_fdd_enb_msgq::send(rlc_pdcp_mq,
+                           LTE_FDD_ENB_MESSAGE_TYPE_RRC_RADIO_LINK_FAILURE,
+                           LTE_FDD_ENB_DEST_LAYER_RRC,
+                           (LTE_FDD_ENB_MESSAGE_UNION *)&rrc_radio_link_failure,
+                           sizeof(LTE_FDD_ENB_RRC_RADIO_LINK_FAILURE_MSG_STRUCT));
 }
@@ -31,6 +31,8 @@
                                    machine.
     06/15/2014    Ben Wojtowicz    Added UL DCCH message handling and MME NAS
                                    message handling.
+    10/19/2026    agent            Only copying the system information when
+                                   its version changes.
 
 *******************************************************************************/
 
@@ -40,6 +42,7 @@
 
 #include "LTE_fdd_enb_rrc.h"
 #include "LTE_fdd_enb_pdcp.h"
+#include "LTE_fdd_enb_user_mgr.h"
 #include "LTE_fdd_enb_interface.h"
 
 /*******************************************************************************
@@ -93,7 +96,8 @@ void LTE_fdd_enb_rrc::cleanup(void)
 /********************************/
 LTE_fdd_enb_rrc::LTE_fdd_enb_rrc()
 {
-    started = false;
+    started          = false;
+    sys_info_version = 0;
 }
 LTE_fdd_enb_rrc::~LTE_fdd_enb_rrc()
 {
@@ -150,6 +154,10 @@ void LTE_fdd_enb_rrc::handle_pdcp_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg)
             handle_pdu_ready(&msg->msg.rrc_pdu_ready);
             delete msg;
             break;
+        case LTE_FDD_ENB_MESSAGE_TYPE_RRC_RADIO_LINK_FAILURE:
+            handle_radio_link_failure(&msg->msg.rrc_radio_link_failure);
+            delete msg;
+            break;
         default:
             interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
                                       LTE_FDD_ENB_DEBUG_LEVEL_RRC,
@@ -162,7 +170,7 @@ void LTE_fdd_enb_rrc::handle_pdcp_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg)
         }
     }else{
         // Forward message to MME
-        rrc_mme_mq->send(&msg, sizeof(msg), 0);
+        LTE_fdd_enb_msgq::forward(rrc_mme_mq, msg);
     }
 }
 void LTE_fdd_enb_rrc::handle_mme_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg)
@@ -190,7 +198,7 @@ void LTE_fdd_enb_rrc::handle_mme_msg(LTE_FDD_ENB_MESSAGE_STRUCT *msg)
         }
     }else{
         // Forward message to PDCP
-        rrc_pdcp_mq->send(&msg, sizeof(msg), 0);
+        LTE_fdd_enb_msgq::forward(rrc_pdcp_mq, msg);
     }
 }
 
@@ -201,9 +209,12 @@ void LTE_fdd_enb_rrc::update_sys_info(void)
 {
     LTE_fdd_enb_cnfg_db *cnfg_db = LTE_fdd_enb_cnfg_db::get_instance();
 
-    sys_info_mutex.lock();
-    cnfg_db->get_sys_info(sys_info);
-    sys_info_mutex.unlock();
+    if(sys_info_version != cnfg_db->get_sys_info_version())
+    {
+        sys_info_mutex.lock();
+        sys_info_version = cnfg_db->get_sys_info(sys_info);
+        sys_info_mutex.unlock();
+    }
 }
 
 /*******************************/
@@ -257,6 +268,23 @@ void LTE_fdd_enb_rrc::handle_pdu_ready(LTE_FDD_ENB_RRC_PDU_READY_MSG_STRUCT *pdu
                                   "Received pdu_ready message with no PDU queued");
     }
 }
+void LTE_fdd_enb_rrc::handle_radio_link_failure(LTE_FDD_ENB_RRC_RADIO_LINK_FAILURE_MSG_STRUCT *rlf)
+{
+    LTE_fdd_enb_interface *interface = LTE_fdd_enb_interface::get_instance();
+    LTE_fdd_enb_user_mgr  *user_mgr  = LTE_fdd_enb_user_mgr::get_instance();
+
+    interface->send_debug_msg(LTE_FDD_ENB_DEBUG_TYPE_ERROR,
+                              LTE_FDD_ENB_DEBUG_LEVEL_RRC,
+                              __FILE__,
+                              __LINE__,
+                              "Radio link failure for RNTI=%u and RB=%s, releasing user",
+                              rlf->user->get_c_rnti(),
+                              LTE_fdd_enb_rb_text[rlf->rb->get_rb_id()]);
+
+    // There is no RRC connection re-establishment, so release the user and
+    // let it start over with random access
+    user_mgr->del_user(rlf->user->get_imsi());
+}
 
 /******************************/
 /*    MME Message Handlers    */
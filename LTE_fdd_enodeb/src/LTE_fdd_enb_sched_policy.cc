@@ -0,0 +1,165 @@
+#line 2 "LTE_fdd_enb_sched_policy.cc" // Make __FILE__ omit the path
+/*******************************************************************************
+
+    Copyright 2026 agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: LTE_fdd_enb_sched_policy.cc
+
+    Description: Contains all the implementations for the LTE FDD eNodeB
+                 DL scheduling policies.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    agent            Created file
+
+*******************************************************************************/
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "LTE_fdd_enb_sched_policy.h"
+#include "LTE_fdd_enb_phy.h"
+#include <math.h>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              GLOBAL VARIABLES
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              CLASS IMPLEMENTATIONS
+*******************************************************************************/
+
+/*****************/
+/*    Factory    */
+/*****************/
+LTE_fdd_enb_dl_sched_policy* LTE_fdd_enb_dl_sched_policy::create(LTE_FDD_ENB_DL_SCHED_POLICY_ENUM type)
+{
+    LTE_fdd_enb_dl_sched_policy *policy;
+
+    switch(type)
+    {
+    case LTE_FDD_ENB_DL_SCHED_POLICY_ROUND_ROBIN:
+        policy = new LTE_fdd_enb_dl_sched_policy_round_robin();
+        break;
+    case LTE_FDD_ENB_DL_SCHED_POLICY_MAX_CI:
+        policy = new LTE_fdd_enb_dl_sched_policy_max_ci();
+        break;
+    case LTE_FDD_ENB_DL_SCHED_POLICY_PROPORTIONAL_FAIR:
+    default:
+        policy = new LTE_fdd_enb_dl_sched_policy_proportional_fair();
+        break;
+    }
+
+    return(policy);
+}
+
+/********************************/
+/*    Constructor/Destructor    */
+/********************************/
+LTE_fdd_enb_dl_sched_policy::LTE_fdd_enb_dl_sched_policy()
+{
+}
+LTE_fdd_enb_dl_sched_policy::~LTE_fdd_enb_dl_sched_policy()
+{
+}
+
+/****************/
+/*    Policy    */
+/****************/
+void LTE_fdd_enb_dl_sched_policy::scheduled(LTE_fdd_enb_user *user,
+                                            uint32            current_tti,
+                                            uint32            N_bits)
+{
+    float avg_thru = get_avg_thru(user, current_tti);
+
+    user->set_dl_avg_thru(avg_thru + (float)N_bits / LTE_FDD_ENB_SCHED_POLICY_DL_THRU_WINDOW, current_tti);
+    user->set_dl_last_sched_tti(current_tti);
+}
+float LTE_fdd_enb_dl_sched_policy_round_robin::get_metric(LTE_fdd_enb_user *user,
+                                                          uint32            current_tti,
+                                                          uint32            N_re)
+{
+    return((float)get_n_ttis_since(user->get_dl_last_sched_tti(), current_tti));
+}
+float LTE_fdd_enb_dl_sched_policy_max_ci::get_metric(LTE_fdd_enb_user *user,
+                                                     uint32            current_tti,
+                                                     uint32            N_re)
+{
+    return(get_cqi_efficiency(user));
+}
+float LTE_fdd_enb_dl_sched_policy_proportional_fair::get_metric(LTE_fdd_enb_user *user,
+                                                                uint32            current_tti,
+                                                                uint32            N_re)
+{
+    float avg_thru = get_avg_thru(user, current_tti);
+
+    if(1 > avg_thru)
+    {
+        avg_thru = 1;
+    }
+
+    return((get_cqi_efficiency(user) * N_re) / avg_thru);
+}
+
+/*****************/
+/*    Helpers    */
+/*****************/
+uint32 LTE_fdd_enb_dl_sched_policy::get_n_ttis_since(uint32 tti,
+                                                     uint32 current_tti)
+{
+    return((current_tti + (LTE_FDD_ENB_CURRENT_TTI_MAX + 1) - tti) % (LTE_FDD_ENB_CURRENT_TTI_MAX + 1));
+}
+float LTE_fdd_enb_dl_sched_policy::get_cqi_efficiency(LTE_fdd_enb_user *user)
+{
+    uint32 cqi = user->get_dl_cqi();
+
+    if(15 < cqi)
+    {
+        cqi = 15;
+    }
+
+    return(LTE_fdd_enb_sched_policy_cqi_efficiency[cqi]);
+}
+float LTE_fdd_enb_dl_sched_policy::get_avg_thru(LTE_fdd_enb_user *user,
+                                                uint32            current_tti)
+{
+    float  avg_thru = user->get_dl_avg_thru();
+    uint32 N_ttis   = get_n_ttis_since(user->get_dl_avg_thru_tti(), current_tti);
+
+    // Exponential moving average in bits per TTI, only decayed when the
+    // scheduler looks at this user instead of every TTI
+    if(0 != N_ttis)
+    {
+        avg_thru *= powf(1.0 - 1.0/LTE_FDD_ENB_SCHED_POLICY_DL_THRU_WINDOW, N_ttis);
+        user->set_dl_avg_thru(avg_thru, current_tti);
+    }
+
+    return(avg_thru);
+}
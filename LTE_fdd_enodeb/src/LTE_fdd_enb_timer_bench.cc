@@ -0,0 +1,158 @@
+/*******************************************************************************
+
+    Copyright 2026 agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: LTE_fdd_enb_timer_bench.cc
+
+    Description: Contains all the implementations for the LTE FDD eNodeB
+                 timer manager benchmark.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    agent            Created file
+
+*******************************************************************************/
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "LTE_fdd_enb_timer_mgr.h"
+#include <stdio.h>
+#include <time.h>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+// Number of ticks in each phase of the benchmark
+#define N_TICKS 5000
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              GLOBAL VARIABLES
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              CLASS DECLARATIONS
+*******************************************************************************/
+
+// Restarts every timer as it expires
+class timer_bench
+{
+public:
+    void handle_timer_expiry(uint32 timer_id);
+};
+
+/*******************************************************************************
+                              FUNCTIONS
+*******************************************************************************/
+
+int64 get_time_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return((int64)ts.tv_sec*1000000000LL + ts.tv_nsec);
+}
+
+// Times each tick on its own so the worst tick can be reported
+int64 run_ticks(LTE_fdd_enb_timer_mgr *timer_mgr,
+                int64                 *max_tick_ns)
+{
+    int64  start;
+    int64  tick_ns;
+    int64  total_ns = 0;
+    uint32 i;
+
+    *max_tick_ns = 0;
+    for(i=0; i<N_TICKS; i++)
+    {
+        start     = get_time_ns();
+        timer_mgr->handle_tick();
+        tick_ns   = get_time_ns() - start;
+        total_ns += tick_ns;
+        if(tick_ns > *max_tick_ns)
+        {
+            *max_tick_ns = tick_ns;
+        }
+    }
+
+    return(total_ns);
+}
+
+void timer_bench::handle_timer_expiry(uint32 timer_id)
+{
+    LTE_fdd_enb_timer_mgr *timer_mgr = LTE_fdd_enb_timer_mgr::get_instance();
+    LTE_fdd_enb_timer_cb   timer_expiry_cb(&LTE_fdd_enb_timer_cb_wrapper<timer_bench, &timer_bench::handle_timer_expiry>, this);
+    uint32                 new_timer_id;
+
+    timer_mgr->start_timer(N_TICKS, timer_expiry_cb, &new_timer_id);
+}
+
+int main(int argc, char *argv[])
+{
+    LTE_fdd_enb_timer_mgr *timer_mgr;
+    timer_bench            bench;
+    LTE_fdd_enb_timer_cb   timer_expiry_cb(&LTE_fdd_enb_timer_cb_wrapper<timer_bench, &timer_bench::handle_timer_expiry>, &bench);
+    int64                  idle_ns;
+    int64                  idle_max_ns;
+    int64                  busy_ns;
+    int64                  busy_max_ns;
+    uint32                 N_timers;
+    uint32                 timer_id;
+    uint32                 i;
+
+    // Run a fresh timer manager at each load, first with timers that don't
+    // expire during the run to show the bookkeeping cost and then restarting
+    // every timer as it expires to show the expiry cost.  The bookkeeping
+    // cost grows with the number of timers, each timer is cascaded down from
+    // the upper levels up to N_LEVELS-1 times and a whole upper level slot
+    // is cascaded in one tick, so the worst tick is reported as well
+    for(N_timers=10; N_timers<=100000; N_timers*=10)
+    {
+        timer_mgr = LTE_fdd_enb_timer_mgr::get_instance();
+        for(i=0; i<N_timers; i++)
+        {
+            timer_mgr->start_timer(N_TICKS + ((i * 7919) % N_TICKS),
+                                   timer_expiry_cb,
+                                   &timer_id);
+        }
+
+        idle_ns = run_ticks(timer_mgr, &idle_max_ns);
+        busy_ns = run_ticks(timer_mgr, &busy_max_ns);
+
+        printf("N_timers=%u idle_ns_per_tick=%.1f idle_max_ns=%lld busy_ns_per_tick=%.1f busy_max_ns=%lld ns_per_expiry=%.1f\n",
+               timer_mgr->get_n_timers(),
+               (double)idle_ns / N_TICKS,
+               (long long)idle_max_ns,
+               (double)busy_ns / N_TICKS,
+               (long long)busy_max_ns,
+               (double)(busy_ns - idle_ns) / N_timers);
+
+        LTE_fdd_enb_timer_mgr::cleanup();
+    }
+
+    return(0);
+}
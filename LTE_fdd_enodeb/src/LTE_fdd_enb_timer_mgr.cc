@@ -27,6 +27,10 @@
     ----------    -------------    --------------------------------------------
     05/04/2014    Ben Wojtowicz    Created file
     06/15/2014    Ben Wojtowicz    Added millisecond resolution.
+    10/19/2026    agent            Replaced the timer map with a hierarchical
+                                   timing wheel of pooled timer nodes with
+                                   generation tagged IDs and added a
+                                   benchmark.
 
 *******************************************************************************/
 
@@ -35,7 +39,6 @@
 *******************************************************************************/
 
 #include "LTE_fdd_enb_timer_mgr.h"
-#include <list>
 
 /*******************************************************************************
                               DEFINES
@@ -88,10 +91,32 @@ void LTE_fdd_enb_timer_mgr::cleanup(void)
 /********************************/
 LTE_fdd_enb_timer_mgr::LTE_fdd_enb_timer_mgr()
 {
-    next_timer_id = 0;
+    uint32 i;
+    uint32 j;
+
+    // Timer Storage
+    free_list = NULL;
+    N_nodes   = 0;
+    N_timers  = 0;
+
+    // Timing Wheel
+    for(i=0; i<LTE_FDD_ENB_TIMER_MGR_N_LEVELS; i++)
+    {
+        for(j=0; j<LTE_FDD_ENB_TIMER_MGR_N_SLOTS; j++)
+        {
+            wheel[i][j] = NULL;
+        }
+    }
+    current_tick = 0;
 }
 LTE_fdd_enb_timer_mgr::~LTE_fdd_enb_timer_mgr()
 {
+    uint32 i;
+
+    for(i=0; i<node_chunks.size(); i++)
+    {
+        delete [] node_chunks[i];
+    }
 }
 
 /****************************/
@@ -101,69 +126,264 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_timer_mgr::start_timer(uint32
                                                           LTE_fdd_enb_timer_cb  cb,
                                                           uint32               *timer_id)
 {
-    boost::mutex::scoped_lock                        lock(timer_mutex);
-    std::map<uint32, LTE_fdd_enb_timer *>::iterator  iter      = timer_map.find(next_timer_id);
-    LTE_fdd_enb_timer                               *new_timer = NULL;
-    LTE_FDD_ENB_ERROR_ENUM                           err       = LTE_FDD_ENB_ERROR_BAD_ALLOC;
+    boost::mutex::scoped_lock      lock(timer_mutex);
+    LTE_FDD_ENB_TIMER_NODE_STRUCT *node = alloc_node();
+    LTE_FDD_ENB_ERROR_ENUM         err  = LTE_FDD_ENB_ERROR_BAD_ALLOC;
 
-    while(timer_map.end() != iter)
+    if(NULL != node)
     {
-        next_timer_id++;
-        iter = timer_map.find(next_timer_id);
-    }
-    new_timer = new LTE_fdd_enb_timer(m_seconds, next_timer_id, cb);
-
-    if(NULL != new_timer)
-    {
-        *timer_id                  = next_timer_id;
-        timer_map[next_timer_id++] = new_timer;
-        err                        = LTE_FDD_ENB_ERROR_NONE;
+        // Timers expire on the (m_seconds+1)th tick after being started
+        if(LTE_FDD_ENB_TIMER_MGR_MAX_TICKS < m_seconds)
+        {
+            m_seconds = LTE_FDD_ENB_TIMER_MGR_MAX_TICKS;
+        }
+        node->cb          = cb;
+        node->expiry_tick = current_tick + m_seconds;
+        node->state       = LTE_FDD_ENB_TIMER_STATE_ACTIVE;
+        insert_node(node);
+        N_timers++;
+
+        *timer_id = node->id;
+        err       = LTE_FDD_ENB_ERROR_NONE;
     }
 
     return(err);
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_timer_mgr::stop_timer(uint32 timer_id)
 {
-    boost::mutex::scoped_lock                       lock(timer_mutex);
-    std::map<uint32, LTE_fdd_enb_timer *>::iterator iter = timer_map.find(timer_id);
-    LTE_FDD_ENB_ERROR_ENUM                          err  = LTE_FDD_ENB_ERROR_TIMER_NOT_FOUND;
-
-    if(timer_map.end() != iter)
+    boost::mutex::scoped_lock      lock(timer_mutex);
+    LTE_FDD_ENB_TIMER_NODE_STRUCT *node = find_node(timer_id);
+    LTE_FDD_ENB_ERROR_ENUM         err  = LTE_FDD_ENB_ERROR_TIMER_NOT_FOUND;
+
+    // Stale IDs fail the generation check, timers that are already firing
+    // are freed by handle_tick and their callbacks are skipped if they have
+    // not been called yet
+    if(NULL                           != node &&
+       LTE_FDD_ENB_TIMER_STATE_ACTIVE == node->state)
     {
-        delete (*iter).second;
-        timer_map.erase(iter);
+        remove_node(node);
+        free_node(node);
+        N_timers--;
         err = LTE_FDD_ENB_ERROR_NONE;
+    }else if(NULL                           != node &&
+             LTE_FDD_ENB_TIMER_STATE_FIRING == node->state){
+        node->state = LTE_FDD_ENB_TIMER_STATE_STOPPED;
+        err         = LTE_FDD_ENB_ERROR_NONE;
     }
 
     return(err);
 }
 void LTE_fdd_enb_timer_mgr::handle_tick(void)
 {
-    std::map<uint32, LTE_fdd_enb_timer *>::iterator iter;
-    std::list<uint32>                               expired_list;
-
+    LTE_FDD_ENB_TIMER_NODE_STRUCT *expired_list;
+    LTE_FDD_ENB_TIMER_NODE_STRUCT *node;
+    LTE_FDD_ENB_TIMER_NODE_STRUCT *next;
+    LTE_fdd_enb_timer_cb           cb;
+    uint32                         id;
+    uint32                         idx;
+    uint32                         level;
+
+    // Held while callbacks run so objects that own timers can be freed from
+    // other threads, always taken before the timer mutex
+    callback_mutex.lock();
     timer_mutex.lock();
-    for(iter=timer_map.begin(); iter!=timer_map.end(); iter++)
+    // Move timers down from the upper levels each time a level wraps
+    idx = current_tick & LTE_FDD_ENB_TIMER_MGR_SLOT_MASK;
+    if(0 == idx)
+    {
+        for(level=1; level<LTE_FDD_ENB_TIMER_MGR_N_LEVELS; level++)
+        {
+            idx = (current_tick >> (level*LTE_FDD_ENB_TIMER_MGR_LEVEL_BITS)) & LTE_FDD_ENB_TIMER_MGR_SLOT_MASK;
+            cascade(level, idx);
+            if(0 != idx)
+            {
+                break;
+            }
+        }
+    }
+
+    // Detach the expired timers
+    idx           = current_tick & LTE_FDD_ENB_TIMER_MGR_SLOT_MASK;
+    expired_list  = wheel[0][idx];
+    wheel[0][idx] = NULL;
+    for(node=expired_list; NULL!=node; node=node->next)
     {
-        (*iter).second->increment();
+        node->state = LTE_FDD_ENB_TIMER_STATE_FIRING;
+        node->slot  = NULL;
+    }
+    current_tick++;
 
-        if((*iter).second->expired())
+    // Call the callbacks without the lock so they can start and stop timers,
+    // a callback can stop a timer later in the list (e.g. by freeing its
+    // owner) so the state is checked and the callback copied out under the
+    // lock right before each call
+    for(node=expired_list; NULL!=node; node=node->next)
+    {
+        if(LTE_FDD_ENB_TIMER_STATE_FIRING == node->state)
         {
-            expired_list.push_back((*iter).first);
+            cb = node->cb;
+            id = node->id;
+            timer_mutex.unlock();
+            cb(id);
+            timer_mutex.lock();
         }
     }
+
+    // Free expired timers
+    node = expired_list;
+    while(NULL != node)
+    {
+        next = node->next;
+        free_node(node);
+        N_timers--;
+        node = next;
+    }
     timer_mutex.unlock();
+    callback_mutex.unlock();
+}
+uint32 LTE_fdd_enb_timer_mgr::get_n_timers(void)
+{
+    boost::mutex::scoped_lock lock(timer_mutex);
+
+    return(N_timers);
+}
+void LTE_fdd_enb_timer_mgr::lock_callbacks(void)
+{
+    callback_mutex.lock();
+}
+void LTE_fdd_enb_timer_mgr::unlock_callbacks(void)
+{
+    callback_mutex.unlock();
+}
+
+/***********************/
+/*    Timer Storage    */
+/***********************/
+LTE_FDD_ENB_TIMER_NODE_STRUCT* LTE_fdd_enb_timer_mgr::find_node(uint32 timer_id)
+{
+    LTE_FDD_ENB_TIMER_NODE_STRUCT *node = NULL;
+    uint32                         idx  = timer_id & LTE_FDD_ENB_TIMER_MGR_IDX_MASK;
+
+    if(idx < N_nodes)
+    {
+        node = &node_chunks[idx >> LTE_FDD_ENB_TIMER_MGR_CHUNK_BITS][idx & (LTE_FDD_ENB_TIMER_MGR_CHUNK_SIZE - 1)];
+        if(node->id != timer_id)
+        {
+            node = NULL;
+        }
+    }
+
+    return(node);
+}
+LTE_FDD_ENB_TIMER_NODE_STRUCT* LTE_fdd_enb_timer_mgr::alloc_node(void)
+{
+    LTE_FDD_ENB_TIMER_NODE_STRUCT *chunk;
+    LTE_FDD_ENB_TIMER_NODE_STRUCT *node = NULL;
+    uint32                         i;
 
-    // Delete expired timers
-    while(0 != expired_list.size())
+    // Grow the pool a chunk at a time
+    if(NULL                             == free_list &&
+       LTE_FDD_ENB_TIMER_MGR_MAX_TIMERS >  N_nodes)
     {
-        iter = timer_map.find(expired_list.front());
-        if(timer_map.end() != iter)
+        chunk = new LTE_FDD_ENB_TIMER_NODE_STRUCT[LTE_FDD_ENB_TIMER_MGR_CHUNK_SIZE];
+        node_chunks.push_back(chunk);
+        for(i=LTE_FDD_ENB_TIMER_MGR_CHUNK_SIZE; i>0; i--)
         {
-            (*iter).second->call_callback();
-            delete (*iter).second;
-            timer_map.erase(iter);
+            chunk[i-1].id    = N_nodes + i - 1;
+            chunk[i-1].state = LTE_FDD_ENB_TIMER_STATE_FREE;
+            chunk[i-1].slot  = NULL;
+            chunk[i-1].prev  = NULL;
+            chunk[i-1].next  = free_list;
+            free_list        = &chunk[i-1];
         }
-        expired_list.pop_front();
+        N_nodes += LTE_FDD_ENB_TIMER_MGR_CHUNK_SIZE;
+    }
+
+    if(NULL != free_list)
+    {
+        node       = free_list;
+        free_list  = node->next;
+        node->next = NULL;
+    }
+
+    return(node);
+}
+void LTE_fdd_enb_timer_mgr::free_node(LTE_FDD_ENB_TIMER_NODE_STRUCT *node)
+{
+    // Bump the generation so stale IDs no longer match, wrapping the
+    // generation early for the node whose next ID would be the invalid ID
+    node->id = (node->id & LTE_FDD_ENB_TIMER_MGR_IDX_MASK) | ((node->id & ~LTE_FDD_ENB_TIMER_MGR_IDX_MASK) + (1 << LTE_FDD_ENB_TIMER_MGR_IDX_BITS));
+    if(LTE_FDD_ENB_TIMER_MGR_INVALID_TIMER_ID == node->id)
+    {
+        node->id &= LTE_FDD_ENB_TIMER_MGR_IDX_MASK;
+    }
+
+    // Return to the free list
+    node->state = LTE_FDD_ENB_TIMER_STATE_FREE;
+    node->slot  = NULL;
+    node->prev  = NULL;
+    node->next  = free_list;
+    free_list   = node;
+}
+
+/**********************/
+/*    Timing Wheel    */
+/**********************/
+void LTE_fdd_enb_timer_mgr::insert_node(LTE_FDD_ENB_TIMER_NODE_STRUCT *node)
+{
+    uint64 delta = 0;
+    uint32 level = 0;
+
+    if(node->expiry_tick > current_tick)
+    {
+        delta = node->expiry_tick - current_tick;
+    }else{
+        node->expiry_tick = current_tick;
+    }
+
+    // Pick the lowest level whose range covers the delay
+    while(level < (LTE_FDD_ENB_TIMER_MGR_N_LEVELS - 1) &&
+          delta >= (1ULL << ((level+1)*LTE_FDD_ENB_TIMER_MGR_LEVEL_BITS)))
+    {
+        level++;
+    }
+
+    node->slot = &wheel[level][(node->expiry_tick >> (level*LTE_FDD_ENB_TIMER_MGR_LEVEL_BITS)) & LTE_FDD_ENB_TIMER_MGR_SLOT_MASK];
+    node->prev = NULL;
+    node->next = *node->slot;
+    if(NULL != node->next)
+    {
+        node->next->prev = node;
+    }
+    *node->slot = node;
+}
+void LTE_fdd_enb_timer_mgr::remove_node(LTE_FDD_ENB_TIMER_NODE_STRUCT *node)
+{
+    if(NULL != node->prev)
+    {
+        node->prev->next = node->next;
+    }else{
+        *node->slot = node->next;
+    }
+    if(NULL != node->next)
+    {
+        node->next->prev = node->prev;
+    }
+    node->slot = NULL;
+    node->prev = NULL;
+    node->next = NULL;
+}
+void LTE_fdd_enb_timer_mgr::cascade(uint32 level,
+                                    uint32 slot)
+{
+    LTE_FDD_ENB_TIMER_NODE_STRUCT *node = wheel[level][slot];
+    LTE_FDD_ENB_TIMER_NODE_STRUCT *next;
+
+    wheel[level][slot] = NULL;
+    while(NULL != node)
+    {
+        next = node->next;
+        insert_node(node);
+        node = next;
     }
 }
@@ -28,6 +28,10 @@
     11/10/2013    Ben Wojtowicz    Created file
     05/04/2014    Ben Wojtowicz    Added radio bearer support.
     06/15/2014    Ben Wojtowicz    Added initialize routine.
+    10/19/2026    agent            Added DL channel quality and average
+                                   throughput tracking for the MAC scheduler.
+    10/19/2026    agent            Added per LCG UL buffer status and UL
+                                   polling for the MAC scheduler.
 
 *******************************************************************************/
 
@@ -75,6 +79,19 @@ LTE_fdd_enb_user::LTE_fdd_enb_user(std::string _imsi)
     {
         drb[i] = NULL;
     }
+
+    // MAC
+    dl_avg_thru       = 0;
+    dl_avg_thru_tti   = 0;
+    dl_last_sched_tti = 0;
+    dl_cqi            = LTE_FDD_ENB_USER_DEFAULT_DL_CQI;
+    for(i=0; i<LTE_FDD_ENB_USER_N_LCGS; i++)
+    {
+        ul_buffer_size[i] = 0;
+    }
+    ul_last_sched_tti = 0;
+    ul_poll_period    = 0;
+    ul_poll_bits      = 0;
 }
 LTE_fdd_enb_user::~LTE_fdd_enb_user()
 {
@@ -106,6 +123,16 @@ void LTE_fdd_enb_user::init(void)
     delete srb1;
     srb0->set_rrc_procedure(LTE_FDD_ENB_RRC_PROC_IDLE);
     srb0->set_rrc_state(LTE_FDD_ENB_RRC_STATE_IDLE);
+
+    // MAC
+    dl_avg_thru = 0;
+    dl_cqi      = LTE_FDD_ENB_USER_DEFAULT_DL_CQI;
+    for(i=0; i<LTE_FDD_ENB_USER_N_LCGS; i++)
+    {
+        ul_buffer_size[i] = 0;
+    }
+    ul_poll_period = 0;
+    ul_poll_bits   = 0;
 }
 
 /******************/
@@ -205,3 +232,95 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_user::get_srb2(LTE_fdd_enb_rb **rb)
 
     return(err);
 }
+
+/*************/
+/*    MAC    */
+/*************/
+void LTE_fdd_enb_user::set_dl_cqi(uint8 cqi)
+{
+    dl_cqi = cqi;
+}
+uint8 LTE_fdd_enb_user::get_dl_cqi(void)
+{
+    return(dl_cqi);
+}
+void LTE_fdd_enb_user::set_dl_avg_thru(float  avg_thru,
+                                       uint32 current_tti)
+{
+    dl_avg_thru     = avg_thru;
+    dl_avg_thru_tti = current_tti;
+}
+float LTE_fdd_enb_user::get_dl_avg_thru(void)
+{
+    return(dl_avg_thru);
+}
+uint32 LTE_fdd_enb_user::get_dl_avg_thru_tti(void)
+{
+    return(dl_avg_thru_tti);
+}
+void LTE_fdd_enb_user::set_dl_last_sched_tti(uint32 current_tti)
+{
+    dl_last_sched_tti = current_tti;
+}
+uint32 LTE_fdd_enb_user::get_dl_last_sched_tti(void)
+{
+    return(dl_last_sched_tti);
+}
+void LTE_fdd_enb_user::set_ul_buffer_size(uint8  lcg_id,
+                                          uint32 N_bytes)
+{
+    if(LTE_FDD_ENB_USER_N_LCGS > lcg_id)
+    {
+        ul_buffer_size[lcg_id] = N_bytes;
+    }
+}
+uint32 LTE_fdd_enb_user::get_ul_buffer_size(void)
+{
+    uint32 N_bytes = 0;
+    uint32 i;
+
+    for(i=0; i<LTE_FDD_ENB_USER_N_LCGS; i++)
+    {
+        N_bytes += ul_buffer_size[i];
+    }
+
+    return(N_bytes);
+}
+void LTE_fdd_enb_user::update_ul_buffer_size(uint32 current_tti,
+                                             uint32 N_granted_bytes)
+{
+    uint32 i;
+
+    // Assume the UE drains its buffers in LCG order until the next BSR
+    // corrects the estimate
+    for(i=0; i<LTE_FDD_ENB_USER_N_LCGS; i++)
+    {
+        if(N_granted_bytes >= ul_buffer_size[i])
+        {
+            N_granted_bytes   -= ul_buffer_size[i];
+            ul_buffer_size[i]  = 0;
+        }else{
+            ul_buffer_size[i] -= N_granted_bytes;
+            N_granted_bytes    = 0;
+        }
+    }
+    ul_last_sched_tti = current_tti;
+}
+uint32 LTE_fdd_enb_user::get_ul_last_sched_tti(void)
+{
+    return(ul_last_sched_tti);
+}
+void LTE_fdd_enb_user::set_ul_poll(uint32 period,
+                                   uint32 N_bits)
+{
+    ul_poll_period = period;
+    ul_poll_bits   = N_bits;
+}
+uint32 LTE_fdd_enb_user::get_ul_poll_period(void)
+{
+    return(ul_poll_period);
+}
+uint32 LTE_fdd_enb_user::get_ul_poll_bits(void)
+{
+    return(ul_poll_bits);
+}
@@ -29,6 +29,10 @@
     01/18/2014    Ben Wojtowicz    Added level to debug prints.
     05/04/2014    Ben Wojtowicz    Added C-RNTI timeout timers.
     06/15/2014    Ben Wojtowicz    Deleting user on C-RNTI expiration.
+    10/19/2026    agent            Resolving C-RNTIs through a lock free
+                                   direct indexed table, allocating C-RNTIs
+                                   from a bitmap, and deferring user deletion
+                                   until lock free readers are done.
 
 *******************************************************************************/
 
@@ -38,6 +42,7 @@
 
 #include "LTE_fdd_enb_user_mgr.h"
 #include "LTE_fdd_enb_timer_mgr.h"
+#include "LTE_fdd_enb_epoch_mgr.h"
 #include "liblte_mac.h"
 #include <boost/lexical_cast.hpp>
 
@@ -92,6 +97,19 @@ void LTE_fdd_enb_user_mgr::cleanup(void)
 /********************************/
 LTE_fdd_enb_user_mgr::LTE_fdd_enb_user_mgr()
 {
+    uint32 i;
+
+    // Mark C-RNTIs outside of the allocatable range as used
+    memset(c_rnti_bitmap, 0, sizeof(c_rnti_bitmap));
+    for(i=0; i<LTE_FDD_ENB_USER_MGR_N_C_RNTIS; i++)
+    {
+        c_rnti_table[i] = NULL;
+        if(LIBLTE_MAC_C_RNTI_START > i ||
+           LIBLTE_MAC_C_RNTI_END   < i)
+        {
+            c_rnti_bitmap[i/64] |= (uint64)1 << (i%64);
+        }
+    }
     next_c_rnti = LIBLTE_MAC_C_RNTI_START;
 }
 LTE_fdd_enb_user_mgr::~LTE_fdd_enb_user_mgr()
@@ -103,31 +121,32 @@ LTE_fdd_enb_user_mgr::~LTE_fdd_enb_user_mgr()
 /****************************/
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_user_mgr::get_free_c_rnti(uint16 *c_rnti)
 {
-    boost::mutex::scoped_lock                     lock(c_rnti_mutex);
-    std::map<uint16, LTE_fdd_enb_user*>::iterator iter;
-    LTE_FDD_ENB_ERROR_ENUM                        err          = LTE_FDD_ENB_ERROR_NO_FREE_C_RNTI;
-    uint16                                        start_c_rnti = next_c_rnti;
-
-    while(c_rnti_map.end() != iter)
+    boost::mutex::scoped_lock lock(c_rnti_mutex);
+    LTE_FDD_ENB_ERROR_ENUM    err  = LTE_FDD_ENB_ERROR_NO_FREE_C_RNTI;
+    uint64                    word;
+    uint32                    idx  = next_c_rnti / 64;
+    uint32                    i;
+
+    // Search from next_c_rnti, the starting word is visited twice so that
+    // the C-RNTIs below next_c_rnti in it are searched last
+    word = c_rnti_bitmap[idx] | (((uint64)1 << (next_c_rnti % 64)) - 1);
+    for(i=0; i<=LTE_FDD_ENB_USER_MGR_N_C_RNTI_WORDS && LTE_FDD_ENB_ERROR_NONE != err; i++)
     {
-        iter = c_rnti_map.find(next_c_rnti++);
-
-        if(LIBLTE_MAC_C_RNTI_END < next_c_rnti)
-        {
-            next_c_rnti = LIBLTE_MAC_C_RNTI_START;
-        }
-        if(next_c_rnti == start_c_rnti)
+        if(0xFFFFFFFFFFFFFFFFULL != word)
         {
-            break;
+            *c_rnti     = (idx * 64) + __builtin_ctzll(~word);
+            next_c_rnti = *c_rnti + 1;
+            if(LIBLTE_MAC_C_RNTI_END < next_c_rnti)
+            {
+                next_c_rnti = LIBLTE_MAC_C_RNTI_START;
+            }
+            err = LTE_FDD_ENB_ERROR_NONE;
+        }else{
+            idx  = (idx + 1) % LTE_FDD_ENB_USER_MGR_N_C_RNTI_WORDS;
+            word = c_rnti_bitmap[idx];
         }
     }
 
-    if(next_c_rnti != start_c_rnti)
-    {
-        *c_rnti = next_c_rnti-1;
-        err     = LTE_FDD_ENB_ERROR_NONE;
-    }
-
     return(err);
 }
 void LTE_fdd_enb_user_mgr::assign_c_rnti(uint16            c_rnti,
@@ -135,27 +154,38 @@ void LTE_fdd_enb_user_mgr::assign_c_rnti(uint16            c_rnti,
 {
     boost::mutex::scoped_lock lock(c_rnti_mutex);
 
-    c_rnti_map[c_rnti] = user;
+    c_rnti_bitmap[c_rnti/64] |= (uint64)1 << (c_rnti%64);
+
+    // Make sure the user is visible before publishing it to readers
+    __sync_synchronize();
+    c_rnti_table[c_rnti] = user;
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_user_mgr::free_c_rnti(uint16 c_rnti)
 {
-    boost::mutex::scoped_lock                     lock(c_rnti_mutex);
-    std::map<uint16, LTE_fdd_enb_user*>::iterator iter = c_rnti_map.find(c_rnti);
-    std::string                                   fake_imsi;
-    LTE_FDD_ENB_ERROR_ENUM                        err = LTE_FDD_ENB_ERROR_C_RNTI_NOT_FOUND;
-
-    if(c_rnti_map.end() != iter)
+    boost::mutex::scoped_lock  lock(c_rnti_mutex);
+    LTE_fdd_enb_user          *user;
+    std::string                fake_imsi;
+    LTE_FDD_ENB_ERROR_ENUM     err = LTE_FDD_ENB_ERROR_C_RNTI_NOT_FOUND;
+
+    if(LIBLTE_MAC_C_RNTI_START <= c_rnti                                &&
+       LIBLTE_MAC_C_RNTI_END   >= c_rnti                                &&
+       0                       != (c_rnti_bitmap[c_rnti/64] & ((uint64)1 << (c_rnti%64))))
     {
-        fake_imsi  = "F";
-        fake_imsi += boost::lexical_cast<std::string>(c_rnti);
-        if((*iter).second->get_imsi() == fake_imsi)
+        user                 = c_rnti_table[c_rnti];
+        c_rnti_table[c_rnti] = NULL;
+        if(NULL != user)
         {
-            del_user(c_rnti);
-        }else{
-            (*iter).second->init();
+            fake_imsi  = "F";
+            fake_imsi += boost::lexical_cast<std::string>(c_rnti);
+            if(user->get_imsi() == fake_imsi)
+            {
+                del_user(c_rnti);
+            }else{
+                user->init();
+            }
         }
-        c_rnti_map.erase(iter);
-        err = LTE_FDD_ENB_ERROR_NONE;
+        c_rnti_bitmap[c_rnti/64] &= ~((uint64)1 << (c_rnti%64));
+        err                       = LTE_FDD_ENB_ERROR_NONE;
     }
 
     return(err);
@@ -228,9 +258,9 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_user_mgr::add_user(uint16 c_rnti)
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_user_mgr::find_user(std::string        imsi,
                                                        LTE_fdd_enb_user **user)
 {
-    boost::mutex::scoped_lock                          lock(user_mutex);
-    std::map<std::string, LTE_fdd_enb_user*>::iterator iter = user_map.find(imsi);
-    LTE_FDD_ENB_ERROR_ENUM                             err  = LTE_FDD_ENB_ERROR_USER_NOT_FOUND;
+    boost::mutex::scoped_lock                                      lock(user_mutex);
+    boost::unordered_map<std::string, LTE_fdd_enb_user*>::iterator iter = user_map.find(imsi);
+    LTE_FDD_ENB_ERROR_ENUM                                         err  = LTE_FDD_ENB_ERROR_USER_NOT_FOUND;
 
     if(user_map.end() != iter)
     {
@@ -243,14 +273,14 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_user_mgr::find_user(std::string        imsi,
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_user_mgr::find_user(uint16             c_rnti,
                                                        LTE_fdd_enb_user **user)
 {
-    boost::mutex::scoped_lock                     lock(c_rnti_mutex);
-    std::map<uint16, LTE_fdd_enb_user*>::iterator iter = c_rnti_map.find(c_rnti);
-    LTE_FDD_ENB_ERROR_ENUM                        err  = LTE_FDD_ENB_ERROR_USER_NOT_FOUND;
+    LTE_fdd_enb_user       *found = c_rnti_table[c_rnti];
+    LTE_FDD_ENB_ERROR_ENUM  err   = LTE_FDD_ENB_ERROR_USER_NOT_FOUND;
 
-    if(c_rnti_map.end() != iter &&
-       NULL             != (*iter).second)
+    // No lock, users removed from the table are only deleted once every
+    // reader pinned before the removal has unpinned
+    if(NULL != found)
     {
-        *user = (*iter).second;
+        *user = found;
         err   = LTE_FDD_ENB_ERROR_NONE;
     }
 
@@ -258,14 +288,16 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_user_mgr::find_user(uint16             c_rnti
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_user_mgr::del_user(std::string imsi)
 {
-    boost::mutex::scoped_lock                          lock(user_mutex);
-    std::map<std::string, LTE_fdd_enb_user*>::iterator iter = user_map.find(imsi);
-    LTE_FDD_ENB_ERROR_ENUM                             err  = LTE_FDD_ENB_ERROR_USER_NOT_FOUND;
+    boost::mutex::scoped_lock                                      lock(user_mutex);
+    boost::unordered_map<std::string, LTE_fdd_enb_user*>::iterator iter = user_map.find(imsi);
+    LTE_fdd_enb_user                                              *user;
+    LTE_FDD_ENB_ERROR_ENUM                                         err  = LTE_FDD_ENB_ERROR_USER_NOT_FOUND;
 
     if(user_map.end() != iter)
     {
-        delete (*iter).second;
+        user = (*iter).second;
         user_map.erase(iter);
+        retire_user(user);
         err = LTE_FDD_ENB_ERROR_NONE;
     }
 
@@ -273,11 +305,12 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_user_mgr::del_user(std::string imsi)
 }
 LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_user_mgr::del_user(uint16 c_rnti)
 {
-    LTE_fdd_enb_interface                              *interface = LTE_fdd_enb_interface::get_instance();
-    boost::mutex::scoped_lock                           lock(user_mutex);
-    std::map<std::string, LTE_fdd_enb_user*>::iterator  iter;
-    std::string                                         fake_imsi;
-    LTE_FDD_ENB_ERROR_ENUM                              err = LTE_FDD_ENB_ERROR_USER_NOT_FOUND;
+    LTE_fdd_enb_interface                                          *interface = LTE_fdd_enb_interface::get_instance();
+    boost::mutex::scoped_lock                                       lock(user_mutex);
+    boost::unordered_map<std::string, LTE_fdd_enb_user*>::iterator  iter;
+    LTE_fdd_enb_user                                               *user;
+    std::string                                                     fake_imsi;
+    LTE_FDD_ENB_ERROR_ENUM                                          err = LTE_FDD_ENB_ERROR_USER_NOT_FOUND;
 
     try
     {
@@ -288,8 +321,9 @@ LTE_FDD_ENB_ERROR_ENUM LTE_fdd_enb_user_mgr::del_user(uint16 c_rnti)
 
         if(user_map.end() != iter)
         {
-            delete (*iter).second;
+            user = (*iter).second;
             user_map.erase(iter);
+            retire_user(user);
             err = LTE_FDD_ENB_ERROR_NONE;
         }
     }catch(...){
@@ -325,3 +359,16 @@ void LTE_fdd_enb_user_mgr::handle_c_rnti_timer_expiry(uint32 timer_id)
         timer_id_map.erase(iter);
     }
 }
+
+/*************************/
+/*    User Retirement    */
+/*************************/
+void LTE_fdd_enb_user_mgr::retire_user(LTE_fdd_enb_user *user)
+{
+    LTE_fdd_enb_epoch_mgr *epoch_mgr = LTE_fdd_enb_epoch_mgr::get_instance();
+
+    // Unpublish the user, readers pinned before this may still hold it so
+    // deletion is deferred until they have all unpinned
+    __sync_bool_compare_and_swap(&c_rnti_table[user->get_c_rnti()], user, NULL);
+    epoch_mgr->retire(&LTE_fdd_enb_epoch_delete<LTE_fdd_enb_user>, user);
+}
@@ -0,0 +1,203 @@
+/*******************************************************************************
+
+    Copyright 2026 agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: LTE_file_recorder_file_sink.h
+
+    Description: Contains all the definitions for the LTE file recorder
+                 gnuradio file sink block.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    agent            Created file
+    10/19/2026    agent            Added triggered capture from a pre-trigger
+                                   ring buffer.
+
+*******************************************************************************/
+
+#ifndef __LTE_FILE_RECORDER_FILE_SINK_H__
+#define __LTE_FILE_RECORDER_FILE_SINK_H__
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "LTE_file_recorder_file_sink_api.h"
+#include "libtools_samp_conv.h"
+#include "liblte_phy.h"
+#include <gnuradio/sync_block.h>
+#include <boost/thread/mutex.hpp>
+#include <pthread.h>
+#include <sys/time.h>
+#include <string>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+// The ring is written to disk in chunks sized and aligned for O_DIRECT,
+// 32 x 4MB of headroom holds about 1 second of sc16 samples at 30.72MHz
+#define LTE_FILE_RECORDER_FILE_SINK_CHUNK_SIZE    (4*1024*1024)
+#define LTE_FILE_RECORDER_FILE_SINK_N_CHUNKS      32
+#define LTE_FILE_RECORDER_FILE_SINK_ALIGN         4096
+#define LTE_FILE_RECORDER_FILE_SINK_IDLE_SLEEP_US 1000
+
+// Power trigger is evaluated over 1ms blocks
+#define LTE_FILE_RECORDER_FILE_SINK_POWER_BLOCKS_PER_SEC 1000
+
+// PSS trigger searches the same number of slots as the scanner and is
+// confirmed by decoding the BCH
+#define LTE_FILE_RECORDER_FILE_SINK_COARSE_TIMING_N_SLOTS 160
+
+/*******************************************************************************
+                              FORWARD DECLARATIONS
+*******************************************************************************/
+
+class LTE_file_recorder_file_sink;
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+typedef boost::shared_ptr<LTE_file_recorder_file_sink> LTE_file_recorder_file_sink_sptr;
+
+// Recording parameters written to the metadata file
+typedef struct{
+    double samp_rate;
+    double gain;
+    uint32 freq;
+    uint16 earfcn;
+    bool   agc;
+}LTE_FILE_RECORDER_FILE_SINK_META_STRUCT;
+
+// Off records continuously, all other modes only record around triggers,
+// the control socket can trigger in any of them
+typedef enum{
+    LTE_FILE_RECORDER_TRIGGER_MODE_OFF = 0,
+    LTE_FILE_RECORDER_TRIGGER_MODE_MANUAL,
+    LTE_FILE_RECORDER_TRIGGER_MODE_POWER,
+    LTE_FILE_RECORDER_TRIGGER_MODE_PSS,
+    LTE_FILE_RECORDER_TRIGGER_MODE_N_ITEMS,
+}LTE_FILE_RECORDER_TRIGGER_MODE_ENUM;
+static const char LTE_file_recorder_trigger_mode_text[LTE_FILE_RECORDER_TRIGGER_MODE_N_ITEMS][20] = {"off",
+                                                                                                     "manual",
+                                                                                                     "power",
+                                                                                                     "pss"};
+
+typedef struct{
+    LTE_FILE_RECORDER_TRIGGER_MODE_ENUM mode;
+    float                               pre_time;
+    float                               post_time;
+    float                               power_thresh;
+}LTE_FILE_RECORDER_FILE_SINK_TRIGGER_STRUCT;
+
+/*******************************************************************************
+                              CLASS DECLARATIONS
+*******************************************************************************/
+
+LTE_FILE_RECORDER_FILE_SINK_API LTE_file_recorder_file_sink_sptr LTE_file_recorder_make_file_sink(std::string file_name, LIBTOOLS_SAMP_CONV_FORMAT_ENUM format, LTE_FILE_RECORDER_FILE_SINK_META_STRUCT *meta, LTE_FILE_RECORDER_FILE_SINK_TRIGGER_STRUCT *trigger);
+class LTE_FILE_RECORDER_FILE_SINK_API LTE_file_recorder_file_sink : public gr::sync_block
+{
+public:
+    ~LTE_file_recorder_file_sink();
+
+    bool is_open(void);
+    bool trigger(void);
+    bool stop(void);
+
+    int32 work(int32                      ninput_items,
+               gr_vector_const_void_star &input_items,
+               gr_vector_void_star       &output_items);
+
+private:
+    friend LTE_FILE_RECORDER_FILE_SINK_API LTE_file_recorder_file_sink_sptr LTE_file_recorder_make_file_sink(std::string file_name, LIBTOOLS_SAMP_CONV_FORMAT_ENUM format, LTE_FILE_RECORDER_FILE_SINK_META_STRUCT *meta, LTE_FILE_RECORDER_FILE_SINK_TRIGGER_STRUCT *trigger);
+
+    LTE_file_recorder_file_sink(std::string file_name, LIBTOOLS_SAMP_CONV_FORMAT_ENUM format, LTE_FILE_RECORDER_FILE_SINK_META_STRUCT *meta, LTE_FILE_RECORDER_FILE_SINK_TRIGGER_STRUCT *trigger);
+
+    // File
+    bool open_file(void);
+    void close_file(void);
+    uint32 write_ring(uint64 start_samp, uint32 N_bytes);
+    void write_meta_file(void);
+    std::string                             file_name;
+    std::string                             event_file_name;
+    LTE_FILE_RECORDER_FILE_SINK_META_STRUCT meta;
+    LIBTOOLS_SAMP_CONV_FORMAT_ENUM          format;
+    struct timeval                          start_time;
+    uint64                                  N_bytes_written;
+    float                                   scale;
+    uint32                                  samp_size;
+    int32                                   fd;
+    bool                                    direct_io;
+    bool                                    got_start_time;
+
+    // Ring
+    static void* writer_thread_func(void *inputs);
+    boost::mutex  ring_mutex;
+    pthread_t     writer_thread;
+    uint8        *ring;
+    uint64        ring_size;
+    uint64        ring_N_samps;
+    uint64        N_samps_in;
+    uint64        write_samp;
+    uint32        chunk_N_samps;
+    bool          ring_hugetlb;
+    bool          writer_started;
+    bool          stopping;
+
+    // Trigger
+    void handle_trigger(uint64 samp, LTE_FILE_RECORDER_TRIGGER_MODE_ENUM src);
+    void start_event(uint64 samp, uint64 end, LTE_FILE_RECORDER_TRIGGER_MODE_ENUM src);
+    LTE_FILE_RECORDER_FILE_SINK_TRIGGER_STRUCT trig;
+    LTE_FILE_RECORDER_TRIGGER_MODE_ENUM        event_src;
+    LTE_FILE_RECORDER_TRIGGER_MODE_ENUM        pending_src;
+    uint64                                     pre_N_samps;
+    uint64                                     post_N_samps;
+    uint64                                     event_start;
+    uint64                                     event_end;
+    uint64                                     event_trigger_samp;
+    uint64                                     event_N_dropped_samps;
+    uint64                                     pending_samp;
+    uint64                                     pending_end;
+    uint32                                     event_idx;
+    uint32                                     event_N_overflows;
+    bool                                       event_active;
+    bool                                       event_closing;
+    bool                                       pending;
+
+    // Power trigger
+    float  power_thresh;
+    float  power_acc;
+    uint32 power_N_samps;
+    uint32 power_block_N_samps;
+
+    // PSS trigger
+    static void* detector_thread_func(void *inputs);
+    bool detect_lte(LIBLTE_PHY_STRUCT *phy_struct, LIBLTE_PHY_SUBFRAME_STRUCT *subframe, float *i_raw, float *q_raw, float *i_buf, float *q_buf, uint32 N_samps);
+    pthread_t          detector_thread;
+    LIBLTE_PHY_FS_ENUM detector_fs;
+    bool               detector_started;
+
+    // Counters
+    uint64 N_dropped_samps;
+    uint32 N_overflows;
+    uint32 N_write_errors;
+    bool   dropping;
+};
+
+#endif /* __LTE_FILE_RECORDER_FILE_SINK_H__ */
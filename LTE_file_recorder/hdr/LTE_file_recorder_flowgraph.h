@@ -27,6 +27,9 @@
     08/26/2013    Ben Wojtowicz    Created file
     11/13/2013    Ben Wojtowicz    Added support for USRP B2X0.
     11/30/2013    Ben Wojtowicz    Added support for bladeRF.
+    10/19/2026    agent            Using a file sink with a selectable format
+                                   and a metadata file.
+    10/19/2026    agent            Added triggered capture.
 
 *******************************************************************************/
 
@@ -38,10 +41,10 @@
 *******************************************************************************/
 
 #include "LTE_file_recorder_interface.h"
+#include "LTE_file_recorder_file_sink.h"
 #include <boost/thread/mutex.hpp>
 #include <gnuradio/top_block.h>
 #include <osmosdr/source.h>
-#include <gnuradio/blocks/file_sink.h>
 
 /*******************************************************************************
                               DEFINES
@@ -78,8 +81,9 @@ public:
 
     // Flowgraph
     bool is_started(void);
-    LTE_FILE_RECORDER_STATUS_ENUM start(uint16 earfcn, std::string file_name);
+    LTE_FILE_RECORDER_STATUS_ENUM start(uint16 earfcn, std::string file_name, LIBTOOLS_SAMP_CONV_FORMAT_ENUM format, LTE_FILE_RECORDER_FILE_SINK_TRIGGER_STRUCT *trigger);
     LTE_FILE_RECORDER_STATUS_ENUM stop(void);
+    LTE_FILE_RECORDER_STATUS_ENUM trigger(void);
 
 private:
     // Singleton
@@ -91,9 +95,9 @@ private:
     static void* run_thread(void *inputs);
 
     // Variables
-    gr::top_block_sptr          top_block;
-    osmosdr::source::sptr       samp_src;
-    gr::blocks::file_sink::sptr file_sink;
+    gr::top_block_sptr               top_block;
+    osmosdr::source::sptr            samp_src;
+    LTE_file_recorder_file_sink_sptr file_sink;
 
     pthread_t    start_thread;
     boost::mutex start_mutex;
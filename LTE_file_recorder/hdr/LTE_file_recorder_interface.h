@@ -25,6 +25,8 @@
     Revision History
     ----------    -------------    --------------------------------------------
     08/26/2013    Ben Wojtowicz    Created file
+    10/19/2026    agent            Added the output file format.
+    10/19/2026    agent            Added the trigger parameters and command.
 
 *******************************************************************************/
 
@@ -37,6 +39,8 @@
 
 #include "liblte_interface.h"
 #include "libtools_socket_wrap.h"
+#include "libtools_samp_conv.h"
+#include "LTE_file_recorder_file_sink.h"
 #include <boost/thread/mutex.hpp>
 #include <string>
 
@@ -101,6 +105,7 @@ private:
     void handle_write(std::string msg);
     void handle_start(void);
     void handle_stop(void);
+    void handle_trigger(void);
     void handle_help(void);
 
     // Reads/Writes
@@ -108,11 +113,25 @@ private:
     void write_earfcn(std::string earfcn_str);
     void read_file_name(void);
     void write_file_name(std::string file_name_str);
+    void read_format(void);
+    void write_format(std::string format_str);
+    void read_trigger_mode(void);
+    void write_trigger_mode(std::string trigger_mode_str);
+    void read_pre_trigger(void);
+    void write_pre_trigger(std::string pre_trigger_str);
+    void read_post_trigger(void);
+    void write_post_trigger(std::string post_trigger_str);
+    void read_trigger_power(void);
+    void write_trigger_power(std::string trigger_power_str);
+    void read_float(float value, std::string name);
+    bool write_float(float *value, std::string value_str, float llimit, float ulimit);
 
     // Variables
-    std::string file_name;
-    uint16      earfcn;
-    bool        shutdown;
+    LTE_FILE_RECORDER_FILE_SINK_TRIGGER_STRUCT trigger;
+    std::string                                file_name;
+    LIBTOOLS_SAMP_CONV_FORMAT_ENUM             format;
+    uint16                                     earfcn;
+    bool                                       shutdown;
 };
 
 #endif /* __LTE_FILE_RECORDER_INTERFACE_H__ */
@@ -0,0 +1,922 @@
+/*******************************************************************************
+
+    Copyright 2026 agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: LTE_file_recorder_file_sink.cc
+
+    Description: Contains all the implementations for the LTE file recorder
+                 gnuradio file sink block.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    agent            Created file
+    10/19/2026    agent            Added triggered capture from a pre-trigger
+                                   ring buffer.
+
+*******************************************************************************/
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "LTE_file_recorder_file_sink.h"
+#include "liblte_rrc.h"
+#include <gnuradio/io_signature.h>
+#include <boost/lexical_cast.hpp>
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              GLOBAL VARIABLES
+*******************************************************************************/
+
+// minimum and maximum number of input and output streams
+static const int32 MIN_IN  = 1;
+static const int32 MAX_IN  = 1;
+static const int32 MIN_OUT = 0;
+static const int32 MAX_OUT = 0;
+
+// Full scale value for each format, gr_complex samples are expected in +/-1
+static const float LTE_file_recorder_file_sink_scale[LIBTOOLS_SAMP_CONV_FORMAT_N_ITEMS] = {127.0, 32767.0, 1.0};
+
+/*******************************************************************************
+                              CLASS IMPLEMENTATIONS
+*******************************************************************************/
+
+LTE_file_recorder_file_sink_sptr LTE_file_recorder_make_file_sink(std::string                                 file_name,
+                                                                  LIBTOOLS_SAMP_CONV_FORMAT_ENUM              format,
+                                                                  LTE_FILE_RECORDER_FILE_SINK_META_STRUCT    *meta,
+                                                                  LTE_FILE_RECORDER_FILE_SINK_TRIGGER_STRUCT *trigger)
+{
+    return LTE_file_recorder_file_sink_sptr(new LTE_file_recorder_file_sink(file_name, format, meta, trigger));
+}
+
+LTE_file_recorder_file_sink::LTE_file_recorder_file_sink(std::string                                 _file_name,
+                                                         LIBTOOLS_SAMP_CONV_FORMAT_ENUM              _format,
+                                                         LTE_FILE_RECORDER_FILE_SINK_META_STRUCT    *_meta,
+                                                         LTE_FILE_RECORDER_FILE_SINK_TRIGGER_STRUCT *_trigger)
+    : gr::sync_block ("LTE_file_recorder_file_sink",
+                      gr::io_signature::make(MIN_IN,  MAX_IN,  sizeof(gr_complex)),
+                      gr::io_signature::make(MIN_OUT, MAX_OUT, sizeof(gr_complex)))
+{
+    bool err = false;
+
+    // File
+    file_name       = _file_name;
+    format          = _format;
+    meta            = *_meta;
+    N_bytes_written = 0;
+    scale           = LTE_file_recorder_file_sink_scale[format];
+    samp_size       = libtools_samp_conv_format_size[format];
+    fd              = -1;
+    direct_io       = true;
+    got_start_time  = false;
+
+    // Trigger
+    trig                  = *_trigger;
+    event_src             = LTE_FILE_RECORDER_TRIGGER_MODE_OFF;
+    pending_src           = LTE_FILE_RECORDER_TRIGGER_MODE_OFF;
+    pre_N_samps           = 0;
+    post_N_samps          = (uint64)(trig.post_time*meta.samp_rate);
+    event_start           = 0;
+    event_end             = 0;
+    event_trigger_samp    = 0;
+    event_N_dropped_samps = 0;
+    pending_samp          = 0;
+    pending_end           = 0;
+    event_idx             = 0;
+    event_N_overflows     = 0;
+    event_active          = false;
+    event_closing         = false;
+    pending               = false;
+    if(LTE_FILE_RECORDER_TRIGGER_MODE_OFF != trig.mode)
+    {
+        pre_N_samps = (uint64)(trig.pre_time*meta.samp_rate);
+    }
+
+    // Power trigger
+    power_thresh        = powf(10, trig.power_thresh/10);
+    power_acc           = 0;
+    power_N_samps       = 0;
+    power_block_N_samps = (uint32)(meta.samp_rate/LTE_FILE_RECORDER_FILE_SINK_POWER_BLOCKS_PER_SEC);
+    if(0 == power_block_N_samps)
+    {
+        power_block_N_samps = 1;
+    }
+
+    // PSS trigger
+    detector_fs      = LIBLTE_PHY_FS_15_36MHZ;
+    detector_started = false;
+
+    // Counters
+    N_dropped_samps = 0;
+    N_overflows     = 0;
+    N_write_errors  = 0;
+    dropping        = false;
+
+    // Ring, the pre-trigger samples plus headroom for the writer
+    chunk_N_samps  = LTE_FILE_RECORDER_FILE_SINK_CHUNK_SIZE/samp_size;
+    ring_size      = ((pre_N_samps*samp_size + LTE_FILE_RECORDER_FILE_SINK_CHUNK_SIZE - 1)/LTE_FILE_RECORDER_FILE_SINK_CHUNK_SIZE + LTE_FILE_RECORDER_FILE_SINK_N_CHUNKS)*LTE_FILE_RECORDER_FILE_SINK_CHUNK_SIZE;
+    ring_N_samps   = ring_size/samp_size;
+    N_samps_in     = 0;
+    write_samp     = 0;
+    writer_started = false;
+    stopping       = false;
+
+    // Use huge pages if any are reserved, otherwise ask for transparent ones
+    ring = (uint8 *)MAP_FAILED;
+#ifdef MAP_HUGETLB
+    ring = (uint8 *)mmap(NULL, ring_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_POPULATE, -1, 0);
+#endif
+    ring_hugetlb = ((uint8 *)MAP_FAILED != ring);
+    if(!ring_hugetlb)
+    {
+        ring = (uint8 *)mmap(NULL, ring_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if((uint8 *)MAP_FAILED != ring)
+        {
+#ifdef MADV_HUGEPAGE
+            madvise(ring, ring_size, MADV_HUGEPAGE);
+#endif
+            // Fault the pages in now instead of in work
+            memset(ring, 0, ring_size);
+        }
+    }
+    if((uint8 *)MAP_FAILED == ring)
+    {
+        printf("file_sink: unable to allocate %llu byte ring\n", ring_size);
+        ring = NULL;
+        err  = true;
+    }
+
+    if(!err &&
+       LTE_FILE_RECORDER_TRIGGER_MODE_PSS == trig.mode)
+    {
+        if(1 >= fabs(meta.samp_rate - 1920000))
+        {
+            detector_fs = LIBLTE_PHY_FS_1_92MHZ;
+        }else if(1 >= fabs(meta.samp_rate - 15360000)){
+            detector_fs = LIBLTE_PHY_FS_15_36MHZ;
+        }else{
+            printf("file_sink: pss trigger does not support %f Hz\n", meta.samp_rate);
+            err = true;
+        }
+    }
+
+    if(!err &&
+       LTE_FILE_RECORDER_TRIGGER_MODE_OFF == trig.mode)
+    {
+        // Record everything as a single event
+        event_active = true;
+        event_end    = ~0ULL;
+        err          = open_file();
+    }
+
+    if(!err)
+    {
+        if(0 == pthread_create(&writer_thread, NULL, &writer_thread_func, this))
+        {
+            writer_started = true;
+        }else{
+            close_file();
+        }
+    }
+    if(writer_started &&
+       LTE_FILE_RECORDER_TRIGGER_MODE_PSS == trig.mode)
+    {
+        if(0 == pthread_create(&detector_thread, NULL, &detector_thread_func, this))
+        {
+            detector_started = true;
+        }else{
+            stop();
+        }
+    }
+}
+LTE_file_recorder_file_sink::~LTE_file_recorder_file_sink()
+{
+    stop();
+
+    if(NULL != ring)
+    {
+        munmap(ring, ring_size);
+    }
+}
+bool LTE_file_recorder_file_sink::is_open(void)
+{
+    return(writer_started);
+}
+bool LTE_file_recorder_file_sink::trigger(void)
+{
+    uint64 samp;
+    bool   err = true;
+
+    if(writer_started &&
+       LTE_FILE_RECORDER_TRIGGER_MODE_OFF != trig.mode)
+    {
+        ring_mutex.lock();
+        samp = N_samps_in;
+        ring_mutex.unlock();
+
+        handle_trigger(samp, LTE_FILE_RECORDER_TRIGGER_MODE_MANUAL);
+        err = false;
+    }
+
+    return(err);
+}
+bool LTE_file_recorder_file_sink::stop(void)
+{
+    if(writer_started)
+    {
+        // Let the writer finish the current event
+        ring_mutex.lock();
+        stopping = true;
+        ring_mutex.unlock();
+        if(detector_started)
+        {
+            pthread_join(detector_thread, NULL);
+            detector_started = false;
+        }
+        pthread_join(writer_thread, NULL);
+        writer_started = false;
+
+        if(LTE_FILE_RECORDER_TRIGGER_MODE_OFF != trig.mode)
+        {
+            printf("file_sink: recorded %u events, dropped %llu samples in %u overflows, %u write errors\n",
+                   event_idx,
+                   N_dropped_samps,
+                   N_overflows,
+                   N_write_errors);
+        }
+    }
+
+    return(true);
+}
+int32 LTE_file_recorder_file_sink::work(int32                      ninput_items,
+                                        gr_vector_const_void_star &input_items,
+                                        gr_vector_void_star       &output_items)
+{
+    const gr_complex *in     = (const gr_complex *)input_items[0];
+    uint64            N_in;
+    uint64            N_space;
+    uint32            N_done = 0;
+    uint32            N_to_copy;
+    uint32            ring_idx;
+    uint32            i;
+
+    if(!got_start_time)
+    {
+        gettimeofday(&start_time, NULL);
+        got_start_time = true;
+        if(LTE_FILE_RECORDER_TRIGGER_MODE_OFF == trig.mode &&
+           writer_started)
+        {
+            write_meta_file();
+        }
+    }
+
+    while(writer_started &&
+          N_done < (uint32)ninput_items)
+    {
+        // Samples waiting for the writer can't be overwritten, otherwise
+        // the oldest samples are
+        ring_mutex.lock();
+        N_in    = N_samps_in;
+        N_space = ring_N_samps;
+        if(event_active)
+        {
+            N_space = write_samp + ring_N_samps - N_in;
+        }
+        ring_mutex.unlock();
+
+        if(0 == N_space)
+        {
+            // Writer is behind, drop the rest of the input
+            ring_mutex.lock();
+            if(!dropping)
+            {
+                printf("file_sink: overflow at sample %llu\n", N_in);
+                dropping = true;
+                N_overflows++;
+            }
+            N_dropped_samps += ninput_items - N_done;
+            ring_mutex.unlock();
+            N_done = ninput_items;
+        }else{
+            dropping  = false;
+            ring_idx  = N_in % ring_N_samps;
+            N_to_copy = ninput_items - N_done;
+            if(N_to_copy > N_space)
+            {
+                N_to_copy = N_space;
+            }
+            if(N_to_copy > (ring_N_samps - ring_idx))
+            {
+                N_to_copy = ring_N_samps - ring_idx;
+            }
+            if(N_to_copy > chunk_N_samps)
+            {
+                N_to_copy = chunk_N_samps;
+            }
+
+            if(LTE_FILE_RECORDER_TRIGGER_MODE_POWER == trig.mode)
+            {
+                for(i=0; i<N_to_copy; i++)
+                {
+                    power_acc += (in[N_done+i].real()*in[N_done+i].real() +
+                                  in[N_done+i].imag()*in[N_done+i].imag());
+                    power_N_samps++;
+                    if(power_block_N_samps == power_N_samps)
+                    {
+                        if(power_acc > power_thresh*power_block_N_samps)
+                        {
+                            handle_trigger(N_in + i + 1 - power_block_N_samps, LTE_FILE_RECORDER_TRIGGER_MODE_POWER);
+                        }
+                        power_acc     = 0;
+                        power_N_samps = 0;
+                    }
+                }
+            }
+
+            libtools_samp_conv_from_cf32((const float *)&in[N_done],
+                                         scale,
+                                         format,
+                                         &ring[ring_idx*samp_size],
+                                         N_to_copy);
+            N_done += N_to_copy;
+
+            ring_mutex.lock();
+            N_samps_in += N_to_copy;
+            ring_mutex.unlock();
+        }
+    }
+
+    // Tell runtime system how many input items we consumed
+    return(ninput_items);
+}
+
+// File
+bool LTE_file_recorder_file_sink::open_file(void)
+{
+    size_t dot_idx;
+    size_t slash_idx;
+
+    // Each event gets its own file, numbered ahead of the extension
+    event_file_name = file_name;
+    if(LTE_FILE_RECORDER_TRIGGER_MODE_OFF != trig.mode)
+    {
+        dot_idx   = file_name.find_last_of('.');
+        slash_idx = file_name.find_last_of('/');
+        if(std::string::npos != dot_idx &&
+           (std::string::npos == slash_idx ||
+            dot_idx > slash_idx))
+        {
+            event_file_name  = file_name.substr(0, dot_idx);
+            event_file_name += "_" + boost::lexical_cast<std::string>(event_idx);
+            event_file_name += file_name.substr(dot_idx, std::string::npos);
+        }else{
+            event_file_name += "_" + boost::lexical_cast<std::string>(event_idx);
+        }
+    }
+
+    // Bypass the page cache if the file system allows it
+    N_bytes_written = 0;
+    direct_io       = true;
+    fd              = open(event_file_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_DIRECT, 0644);
+    if(-1 == fd &&
+       EINVAL == errno)
+    {
+        direct_io = false;
+        fd        = open(event_file_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    }
+
+    if(-1 == fd)
+    {
+        printf("file_sink: unable to open %s\n", event_file_name.c_str());
+    }else if(LTE_FILE_RECORDER_TRIGGER_MODE_OFF != trig.mode){
+        printf("file_sink: %s trigger at sample %llu, recording %s\n",
+               LTE_file_recorder_trigger_mode_text[event_src],
+               event_trigger_samp,
+               event_file_name.c_str());
+    }
+
+    return(-1 == fd);
+}
+void LTE_file_recorder_file_sink::close_file(void)
+{
+    if(-1 != fd)
+    {
+        // Remove any padding from the last write
+        if(0 != ftruncate(fd, N_bytes_written))
+        {
+            N_write_errors++;
+        }
+        close(fd);
+        fd = -1;
+
+        write_meta_file();
+        printf("file_sink: wrote %llu samples to %s, dropped %llu samples in %u overflows, %u write errors\n",
+               N_bytes_written/samp_size,
+               event_file_name.c_str(),
+               N_dropped_samps - event_N_dropped_samps,
+               N_overflows - event_N_overflows,
+               N_write_errors);
+    }
+}
+uint32 LTE_file_recorder_file_sink::write_ring(uint64 start_samp,
+                                               uint32 N_bytes)
+{
+    uint8   *buf       = &ring[(start_samp % ring_N_samps)*samp_size];
+    ssize_t  ret;
+    uint32   N_written = 0;
+
+    while(N_written < N_bytes)
+    {
+        ret = write(fd, &buf[N_written], N_bytes - N_written);
+        if(0 < ret)
+        {
+            N_written += ret;
+        }else if(-1 == ret &&
+                 EINTR == errno){
+            continue;
+        }else if(-1 == ret      &&
+                 EINVAL == errno &&
+                 direct_io){
+            // File system refused the direct write, fall back to the page cache
+            fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) & ~O_DIRECT);
+            direct_io = false;
+        }else{
+            N_write_errors++;
+            break;
+        }
+    }
+
+    return(N_written);
+}
+void LTE_file_recorder_file_sink::write_meta_file(void)
+{
+    FILE      *meta_file;
+    struct tm  tm_utc;
+    time_t     start_sec;
+    double     start;
+    uint32     start_usec;
+    char       time_str[32];
+
+    meta_file = fopen((event_file_name + ".meta").c_str(), "w");
+    if(NULL != meta_file)
+    {
+        fprintf(meta_file, "file_name = %s\n", event_file_name.c_str());
+        fprintf(meta_file, "format = %s\n", libtools_samp_conv_format_text[format]);
+        fprintf(meta_file, "full_scale = %f\n", scale);
+        fprintf(meta_file, "samp_rate = %f\n", meta.samp_rate);
+        fprintf(meta_file, "earfcn = %u\n", meta.earfcn);
+        fprintf(meta_file, "freq = %u\n", meta.freq);
+        fprintf(meta_file, "gain = %f\n", meta.gain);
+        fprintf(meta_file, "agc = %s\n", meta.agc ? "on" : "off");
+        fprintf(meta_file, "trigger_mode = %s\n", LTE_file_recorder_trigger_mode_text[trig.mode]);
+        if(LTE_FILE_RECORDER_TRIGGER_MODE_OFF != trig.mode)
+        {
+            fprintf(meta_file, "trigger = %s\n", LTE_file_recorder_trigger_mode_text[event_src]);
+            fprintf(meta_file, "trigger_samp = %lld\n", (int64)(event_trigger_samp - event_start));
+            fprintf(meta_file, "pre_trigger = %f\n", trig.pre_time);
+            fprintf(meta_file, "post_trigger = %f\n", trig.post_time);
+            if(LTE_FILE_RECORDER_TRIGGER_MODE_POWER == trig.mode)
+            {
+                fprintf(meta_file, "trigger_power = %f\n", trig.power_thresh);
+            }
+        }
+        if(got_start_time)
+        {
+            // Time of the first sample in this file, dropped samples
+            // are not accounted for
+            start      = start_time.tv_sec + start_time.tv_usec/1000000.0 + event_start/meta.samp_rate;
+            start_sec  = (time_t)start;
+            start_usec = (uint32)((start - start_sec)*1000000);
+            gmtime_r(&start_sec, &tm_utc);
+            strftime(time_str, sizeof(time_str), "%Y-%m-%dT%H:%M:%S", &tm_utc);
+            fprintf(meta_file, "start_time = %s.%06uZ\n", time_str, start_usec);
+            fprintf(meta_file, "start_time_epoch = %lu.%06u\n", (unsigned long)start_sec, start_usec);
+        }
+        fprintf(meta_file, "N_samps = %llu\n", N_bytes_written/samp_size);
+        fprintf(meta_file, "N_dropped_samps = %llu\n", N_dropped_samps - event_N_dropped_samps);
+        fprintf(meta_file, "N_overflows = %u\n", N_overflows - event_N_overflows);
+        fclose(meta_file);
+    }else{
+        printf("file_sink: unable to open %s.meta\n", event_file_name.c_str());
+    }
+}
+
+// Ring
+void* LTE_file_recorder_file_sink::writer_thread_func(void *inputs)
+{
+    LTE_file_recorder_file_sink *sink = (LTE_file_recorder_file_sink *)inputs;
+    uint64                       N_in;
+    uint64                       write_samp;
+    uint64                       chunk_end;
+    uint64                       end;
+    uint32                       N_bytes;
+    uint32                       N_pad_bytes;
+    uint32                       N_written;
+    bool                         active;
+    bool                         closing;
+    bool                         stopping;
+
+    while(1)
+    {
+        sink->ring_mutex.lock();
+        if(sink->stopping     &&
+           sink->event_active &&
+           sink->event_end > sink->N_samps_in)
+        {
+            // Cut the current event short
+            sink->event_end = sink->N_samps_in;
+        }
+        N_in       = sink->N_samps_in;
+        write_samp = sink->write_samp;
+        end        = sink->event_end;
+        active     = sink->event_active;
+        stopping   = sink->stopping;
+        sink->ring_mutex.unlock();
+
+        if(!active)
+        {
+            if(stopping)
+            {
+                break;
+            }
+            usleep(LTE_FILE_RECORDER_FILE_SINK_IDLE_SLEEP_US);
+        }else if(-1 == sink->fd &&
+                 sink->open_file()){
+            // Give up on this event
+            sink->ring_mutex.lock();
+            sink->event_active = false;
+            sink->event_idx++;
+            sink->ring_mutex.unlock();
+        }else{
+            // Full chunks are written until the end of the event, so the
+            // file offset stays aligned
+            chunk_end = (write_samp/sink->chunk_N_samps + 1)*sink->chunk_N_samps;
+            if(chunk_end <= end &&
+               chunk_end <= N_in)
+            {
+                sink->N_bytes_written += sink->write_ring(write_samp, (chunk_end - write_samp)*sink->samp_size);
+
+                sink->ring_mutex.lock();
+                sink->write_samp = chunk_end;
+                sink->ring_mutex.unlock();
+            }else if(end <= N_in){
+                // Triggers that arrive from here on start a new event
+                sink->ring_mutex.lock();
+                closing = (end == sink->event_end);
+                if(closing)
+                {
+                    sink->event_closing = true;
+                }
+                sink->ring_mutex.unlock();
+
+                if(closing)
+                {
+                    // Pad the last write to the O_DIRECT alignment, the
+                    // padding is truncated when the file is closed
+                    N_bytes = (end - write_samp)*sink->samp_size;
+                    if(0 != N_bytes)
+                    {
+                        N_pad_bytes = ((N_bytes + LTE_FILE_RECORDER_FILE_SINK_ALIGN - 1) & ~(LTE_FILE_RECORDER_FILE_SINK_ALIGN - 1)) - N_bytes;
+                        N_written   = sink->write_ring(write_samp, N_bytes + N_pad_bytes);
+                        if(N_written > N_bytes)
+                        {
+                            N_written = N_bytes;
+                        }
+                        sink->N_bytes_written += N_written;
+                    }
+                    sink->close_file();
+
+                    sink->ring_mutex.lock();
+                    sink->write_samp    = end;
+                    sink->event_active  = false;
+                    sink->event_closing = false;
+                    sink->event_idx++;
+                    if(sink->pending)
+                    {
+                        sink->start_event(sink->pending_samp, sink->pending_end, sink->pending_src);
+                    }
+                    sink->pending = false;
+                    sink->ring_mutex.unlock();
+                }
+            }else{
+                usleep(LTE_FILE_RECORDER_FILE_SINK_IDLE_SLEEP_US);
+            }
+        }
+    }
+
+    return(NULL);
+}
+
+// Trigger
+void LTE_file_recorder_file_sink::handle_trigger(uint64                              samp,
+                                                 LTE_FILE_RECORDER_TRIGGER_MODE_ENUM src)
+{
+    boost::mutex::scoped_lock lock(ring_mutex);
+
+    if(!stopping)
+    {
+        if(event_active   &&
+           !event_closing &&
+           samp <= (event_end + pre_N_samps))
+        {
+            // Windows overlap, extend the current event
+            if((samp + post_N_samps) > event_end)
+            {
+                event_end = samp + post_N_samps;
+            }
+        }else if(event_active){
+            // Start a new event once the current one is written, any
+            // further triggers extend it so nothing is lost
+            if(!pending)
+            {
+                pending      = true;
+                pending_samp = samp;
+                pending_end  = samp + post_N_samps;
+                pending_src  = src;
+            }else if((samp + post_N_samps) > pending_end){
+                pending_end = samp + post_N_samps;
+            }
+        }else{
+            start_event(samp, samp + post_N_samps, src);
+        }
+    }
+}
+void LTE_file_recorder_file_sink::start_event(uint64                              samp,
+                                              uint64                              end,
+                                              LTE_FILE_RECORDER_TRIGGER_MODE_ENUM src)
+{
+    uint64 oldest_samp = 0;
+    uint32 align_N_samps;
+
+    // Start from the oldest pre-trigger sample still in the ring, work()
+    // may be overwriting up to one chunk past N_samps_in, aligned for
+    // O_DIRECT, ring_mutex must be held
+    align_N_samps = LTE_FILE_RECORDER_FILE_SINK_ALIGN/samp_size;
+    if((N_samps_in + chunk_N_samps) > ring_N_samps)
+    {
+        oldest_samp  = N_samps_in + chunk_N_samps - ring_N_samps;
+        oldest_samp += (align_N_samps - (oldest_samp % align_N_samps)) % align_N_samps;
+    }
+    event_start = oldest_samp;
+    if(samp > pre_N_samps)
+    {
+        event_start = samp - pre_N_samps;
+        event_start -= event_start % align_N_samps;
+        if(event_start < oldest_samp)
+        {
+            event_start = oldest_samp;
+        }
+    }
+
+    // The whole window may already be gone if the trigger is late
+    event_end = end;
+    if(event_end < event_start)
+    {
+        event_end = event_start;
+    }
+    event_trigger_samp    = samp;
+    event_src             = src;
+    event_N_dropped_samps = N_dropped_samps;
+    event_N_overflows     = N_overflows;
+    write_samp            = event_start;
+    event_active          = true;
+}
+
+// PSS trigger
+void* LTE_file_recorder_file_sink::detector_thread_func(void *inputs)
+{
+    LTE_file_recorder_file_sink *sink     = (LTE_file_recorder_file_sink *)inputs;
+    LIBLTE_PHY_SUBFRAME_STRUCT  *subframe = new LIBLTE_PHY_SUBFRAME_STRUCT;
+    LIBLTE_PHY_STRUCT           *phy_struct;
+    float                       *i_raw;
+    float                       *q_raw;
+    float                       *i_buf;
+    float                       *q_buf;
+    uint64                       N_in;
+    uint64                       next_samp = 0;
+    uint64                       start_samp;
+    uint32                       N_samps;
+    uint32                       N_first;
+    uint32                       ring_idx;
+    bool                         stopping;
+
+    if(LIBLTE_PHY_FS_1_92MHZ == sink->detector_fs)
+    {
+        liblte_phy_init(&phy_struct,
+                        LIBLTE_PHY_FS_1_92MHZ,
+                        LIBLTE_PHY_INIT_N_ID_CELL_UNKNOWN,
+                        4,
+                        LIBLTE_PHY_N_RB_DL_1_4MHZ,
+                        LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP,
+                        liblte_rrc_phich_resource_num[LIBLTE_RRC_PHICH_RESOURCE_1]);
+        N_samps = ((LTE_FILE_RECORDER_FILE_SINK_COARSE_TIMING_N_SLOTS/2)+2)*LIBLTE_PHY_N_SAMPS_PER_SUBFR_1_92MHZ;
+    }else{
+        liblte_phy_init(&phy_struct,
+                        LIBLTE_PHY_FS_15_36MHZ,
+                        LIBLTE_PHY_INIT_N_ID_CELL_UNKNOWN,
+                        4,
+                        LIBLTE_PHY_N_RB_DL_10MHZ,
+                        LIBLTE_PHY_N_SC_RB_DL_NORMAL_CP,
+                        liblte_rrc_phich_resource_num[LIBLTE_RRC_PHICH_RESOURCE_1]);
+        N_samps = ((LTE_FILE_RECORDER_FILE_SINK_COARSE_TIMING_N_SLOTS/2)+2)*LIBLTE_PHY_N_SAMPS_PER_SUBFR_15_36MHZ;
+    }
+    i_raw = (float *)malloc(N_samps*sizeof(float));
+    q_raw = (float *)malloc(N_samps*sizeof(float));
+    i_buf = (float *)malloc(N_samps*sizeof(float));
+    q_buf = (float *)malloc(N_samps*sizeof(float));
+
+    while(1)
+    {
+        sink->ring_mutex.lock();
+        N_in     = sink->N_samps_in;
+        stopping = sink->stopping;
+        sink->ring_mutex.unlock();
+
+        if(stopping)
+        {
+            break;
+        }else if(N_in < (next_samp + N_samps)){
+            usleep(LTE_FILE_RECORDER_FILE_SINK_IDLE_SLEEP_US);
+        }else{
+            // Search the newest samples, skipping any that went by while
+            // the last search was running
+            start_samp = next_samp;
+            if((N_in - N_samps) > start_samp)
+            {
+                start_samp = N_in - N_samps;
+            }
+            next_samp = start_samp + N_samps;
+
+            ring_idx = start_samp % sink->ring_N_samps;
+            N_first  = N_samps;
+            if(N_first > (sink->ring_N_samps - ring_idx))
+            {
+                N_first = sink->ring_N_samps - ring_idx;
+            }
+            libtools_samp_conv_to_split(sink->format,
+                                        &sink->ring[ring_idx*sink->samp_size],
+                                        1/sink->scale,
+                                        i_raw,
+                                        q_raw,
+                                        N_first);
+            if(N_first < N_samps)
+            {
+                libtools_samp_conv_to_split(sink->format,
+                                            sink->ring,
+                                            1/sink->scale,
+                                            &i_raw[N_first],
+                                            &q_raw[N_first],
+                                            N_samps - N_first);
+            }
+
+            // Skip the search if work wrapped the ring while copying
+            sink->ring_mutex.lock();
+            N_in = sink->N_samps_in;
+            sink->ring_mutex.unlock();
+            if((start_samp + sink->ring_N_samps) >= (N_in + sink->chunk_N_samps) &&
+               sink->detect_lte(phy_struct, subframe, i_raw, q_raw, i_buf, q_buf, N_samps))
+            {
+                sink->handle_trigger(start_samp, LTE_FILE_RECORDER_TRIGGER_MODE_PSS);
+            }
+        }
+    }
+
+    free(i_raw);
+    free(q_raw);
+    free(i_buf);
+    free(q_buf);
+    delete subframe;
+    liblte_phy_cleanup(phy_struct);
+
+    return(NULL);
+}
+bool LTE_file_recorder_file_sink::detect_lte(LIBLTE_PHY_STRUCT          *phy_struct,
+                                             LIBLTE_PHY_SUBFRAME_STRUCT *subframe,
+                                             float                      *i_raw,
+                                             float                      *q_raw,
+                                             float                      *i_buf,
+                                             float                      *q_buf,
+                                             uint32                      N_samps)
+{
+    LIBLTE_PHY_COARSE_TIMING_STRUCT timing_struct;
+    LIBLTE_PHY_NCO_STRUCT           nco;
+    LIBLTE_BIT_MSG_STRUCT           bch_msg;
+    float                           pss_thresh;
+    float                           freq_offset;
+    uint32                          symb_starts[7];
+    uint32                          N_id_1;
+    uint32                          N_id_2;
+    uint32                          N_id_cell;
+    uint32                          pss_symb;
+    uint32                          frame_start_idx;
+    uint32                          i;
+    uint8                           N_ant;
+    uint8                           sfn_offset;
+    bool                            found = false;
+
+    // Same search as the scanner, a PSS only counts if the SSS is found
+    // and the BCH decodes
+    if(LIBLTE_SUCCESS == liblte_phy_dl_find_coarse_timing_and_freq_offset(phy_struct,
+                                                                          i_raw,
+                                                                          q_raw,
+                                                                          LTE_FILE_RECORDER_FILE_SINK_COARSE_TIMING_N_SLOTS,
+                                                                          &timing_struct))
+    {
+        for(i=0; i<timing_struct.n_corr_peaks && !found; i++)
+        {
+            memcpy(i_buf, i_raw, N_samps*sizeof(float));
+            memcpy(q_buf, q_raw, N_samps*sizeof(float));
+            liblte_phy_nco_init(&nco, phy_struct->fs, timing_struct.freq_offset[i]);
+            liblte_phy_nco_rotate(&nco, i_buf, q_buf, N_samps);
+            memcpy(symb_starts, timing_struct.symb_starts[i], sizeof(symb_starts));
+
+            if(LIBLTE_SUCCESS == liblte_phy_find_pss_and_fine_timing(phy_struct,
+                                                                     i_buf,
+                                                                     q_buf,
+                                                                     symb_starts,
+                                                                     &N_id_2,
+                                                                     &pss_symb,
+                                                                     &pss_thresh,
+                                                                     &freq_offset))
+            {
+                if(fabs(freq_offset) > 100)
+                {
+                    liblte_phy_nco_init(&nco, phy_struct->fs, freq_offset);
+                    liblte_phy_nco_rotate(&nco, i_buf, q_buf, N_samps);
+                }
+                if(LIBLTE_SUCCESS == liblte_phy_find_sss(phy_struct,
+                                                         i_buf,
+                                                         q_buf,
+                                                         N_id_2,
+                                                         symb_starts,
+                                                         pss_thresh,
+                                                         &N_id_1,
+                                                         &frame_start_idx))
+                {
+                    N_id_cell = 3*N_id_1 + N_id_2;
+                    while((frame_start_idx + phy_struct->N_samps_per_frame) > N_samps &&
+                          frame_start_idx >= phy_struct->N_samps_per_frame)
+                    {
+                        frame_start_idx -= phy_struct->N_samps_per_frame;
+                    }
+                    if(LIBLTE_SUCCESS == liblte_phy_get_dl_subframe_and_ce(phy_struct,
+                                                                           i_buf,
+                                                                           q_buf,
+                                                                           frame_start_idx,
+                                                                           0,
+                                                                           N_id_cell,
+                                                                           4,
+                                                                           subframe) &&
+                       LIBLTE_SUCCESS == liblte_phy_bch_channel_decode(phy_struct,
+                                                                       subframe,
+                                                                       N_id_cell,
+                                                                       &N_ant,
+                                                                       bch_msg.msg,
+                                                                       &bch_msg.N_bits,
+                                                                       &sfn_offset))
+                    {
+                        printf("file_sink: found N_id_cell %u\n", N_id_cell);
+                        found = true;
+                    }
+                }
+            }
+        }
+    }
+
+    return(found);
+}
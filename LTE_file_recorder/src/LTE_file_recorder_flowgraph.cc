@@ -27,6 +27,9 @@
     08/26/2013    Ben Wojtowicz    Created file
     11/13/2013    Ben Wojtowicz    Added support for USRP B2X0.
     11/30/2013    Ben Wojtowicz    Added support for bladeRF.
+    10/19/2026    agent            Using a file sink with a selectable format
+                                   and a metadata file.
+    10/19/2026    agent            Added triggered capture.
 
 *******************************************************************************/
 
@@ -104,16 +107,19 @@ bool LTE_file_recorder_flowgraph::is_started(void)
 
     return(started);
 }
-LTE_FILE_RECORDER_STATUS_ENUM LTE_file_recorder_flowgraph::start(uint16      earfcn,
-                                                                 std::string file_name)
+LTE_FILE_RECORDER_STATUS_ENUM LTE_file_recorder_flowgraph::start(uint16                                      earfcn,
+                                                                 std::string                                 file_name,
+                                                                 LIBTOOLS_SAMP_CONV_FORMAT_ENUM              format,
+                                                                 LTE_FILE_RECORDER_FILE_SINK_TRIGGER_STRUCT *trigger)
 {
-    boost::mutex::scoped_lock       lock(start_mutex);
-    LTE_file_recorder_interface    *interface = LTE_file_recorder_interface::get_instance();
-    uhd::device_addr_t              hint;
-    LTE_FILE_RECORDER_STATUS_ENUM   err           = LTE_FILE_RECORDER_STATUS_FAIL;
-    LTE_FILE_RECORDER_HW_TYPE_ENUM  hardware_type = LTE_FILE_RECORDER_HW_TYPE_UNKNOWN;
-    double                          mcr;
-    uint32                          freq;
+    boost::mutex::scoped_lock                lock(start_mutex);
+    LTE_file_recorder_interface             *interface = LTE_file_recorder_interface::get_instance();
+    uhd::device_addr_t                       hint;
+    LTE_FILE_RECORDER_FILE_SINK_META_STRUCT  meta;
+    LTE_FILE_RECORDER_STATUS_ENUM            err           = LTE_FILE_RECORDER_STATUS_FAIL;
+    LTE_FILE_RECORDER_HW_TYPE_ENUM           hardware_type = LTE_FILE_RECORDER_HW_TYPE_UNKNOWN;
+    double                                   mcr;
+    uint32                                   freq;
 
     if(!started)
     {
@@ -159,14 +165,9 @@ LTE_FILE_RECORDER_STATUS_ENUM LTE_file_recorder_flowgraph::start(uint16      ear
                 }
             }
         }
-        if(NULL == file_sink.get())
-        {
-            file_sink = gr::blocks::file_sink::make(sizeof(gr_complex), file_name.c_str());
-        }
 
         if(NULL != top_block.get() &&
-           NULL != samp_src.get()  &&
-           NULL != file_sink.get())
+           NULL != samp_src.get())
         {
             if(0 != samp_src->get_num_channels())
             {
@@ -207,13 +208,27 @@ LTE_FILE_RECORDER_STATUS_ENUM LTE_file_recorder_flowgraph::start(uint16      ear
                     freq = liblte_interface_ul_earfcn_to_frequency(earfcn);
                 }
                 samp_src->set_center_freq(freq);
-                top_block->connect(samp_src, 0, file_sink, 0);
-                if(0 == pthread_create(&start_thread, NULL, &run_thread, this))
+
+                // Create the file sink once the hardware settings are known
+                meta.samp_rate = samp_src->get_sample_rate();
+                meta.gain      = samp_src->get_gain();
+                meta.freq      = freq;
+                meta.earfcn    = earfcn;
+                meta.agc       = samp_src->get_gain_mode();
+                file_sink      = LTE_file_recorder_make_file_sink(file_name, format, &meta, trigger);
+                if(file_sink->is_open())
                 {
-                    err     = LTE_FILE_RECORDER_STATUS_OK;
-                    started = true;
+                    top_block->connect(samp_src, 0, file_sink, 0);
+                    if(0 == pthread_create(&start_thread, NULL, &run_thread, this))
+                    {
+                        err     = LTE_FILE_RECORDER_STATUS_OK;
+                        started = true;
+                    }else{
+                        top_block->disconnect_all();
+                        file_sink.reset();
+                    }
                 }else{
-                    top_block->disconnect_all();
+                    file_sink.reset();
                 }
             }else{
                 samp_src.reset();
@@ -233,8 +248,8 @@ LTE_FILE_RECORDER_STATUS_ENUM LTE_file_recorder_flowgraph::stop(void)
         started = false;
         start_mutex.unlock();
         top_block->stop();
-        sleep(1); // Wait for state_machine to exit
-        pthread_cancel(start_thread);
+        // The run thread closes the file sink once the flowgraph returns,
+        // cancelling it could interrupt the join on the writer thread
         pthread_join(start_thread, NULL);
         top_block.reset();
         err = LTE_FILE_RECORDER_STATUS_OK;
@@ -242,12 +257,28 @@ LTE_FILE_RECORDER_STATUS_ENUM LTE_file_recorder_flowgraph::stop(void)
 
     return(err);
 }
+LTE_FILE_RECORDER_STATUS_ENUM LTE_file_recorder_flowgraph::trigger(void)
+{
+    boost::mutex::scoped_lock        lock(start_mutex);
+    LTE_file_recorder_file_sink_sptr sink = file_sink;
+    LTE_FILE_RECORDER_STATUS_ENUM    err  = LTE_FILE_RECORDER_STATUS_FAIL;
+
+    if(started                &&
+       NULL != sink.get()     &&
+       !sink->trigger())
+    {
+        err = LTE_FILE_RECORDER_STATUS_OK;
+    }
+
+    return(err);
+}
 
 // Run
 void* LTE_file_recorder_flowgraph::run_thread(void *inputs)
 {
-    LTE_file_recorder_interface *interface = LTE_file_recorder_interface::get_instance();
-    LTE_file_recorder_flowgraph *flowgraph = (LTE_file_recorder_flowgraph *)inputs;
+    LTE_file_recorder_interface      *interface = LTE_file_recorder_interface::get_instance();
+    LTE_file_recorder_flowgraph      *flowgraph = (LTE_file_recorder_flowgraph *)inputs;
+    LTE_file_recorder_file_sink_sptr  sink;
 
     // Disable cancellation while running, state machine block will respond to the stop
     if(0 == pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, NULL))
@@ -266,7 +297,18 @@ void* LTE_file_recorder_flowgraph::run_thread(void *inputs)
     flowgraph->top_block->stop();
     flowgraph->top_block->disconnect_all();
     flowgraph->samp_src.reset();
+    flowgraph->start_mutex.lock();
+    sink = flowgraph->file_sink;
     flowgraph->file_sink.reset();
+    flowgraph->start_mutex.unlock();
+
+    // Flush and close the file outside of start_mutex so trigger is not
+    // held up by the writer thread
+    if(NULL != sink.get())
+    {
+        sink->stop();
+    }
+    sink.reset();
 
     // Wait for flowgraph to be stopped
     if(flowgraph->is_started())
@@ -25,6 +25,8 @@
     Revision History
     ----------    -------------    --------------------------------------------
     08/26/2013    Ben Wojtowicz    Created file
+    10/19/2026    agent            Added the output file format.
+    10/19/2026    agent            Added the trigger parameters and command.
 
 *******************************************************************************/
 
@@ -40,8 +42,19 @@
                               DEFINES
 *******************************************************************************/
 
-#define EARFCN_PARAM    "earfcn"
-#define FILE_NAME_PARAM "file_name"
+#define EARFCN_PARAM        "earfcn"
+#define FILE_NAME_PARAM     "file_name"
+#define FORMAT_PARAM        "format"
+#define TRIGGER_MODE_PARAM  "trigger_mode"
+#define PRE_TRIGGER_PARAM   "pre_trigger"
+#define POST_TRIGGER_PARAM  "post_trigger"
+#define TRIGGER_POWER_PARAM "trigger_power"
+
+// The whole pre-trigger window is kept in memory
+#define PRE_TRIGGER_MAX   10.0
+#define POST_TRIGGER_MAX  3600.0
+#define TRIGGER_POWER_MIN -100.0
+#define TRIGGER_POWER_MAX 0.0
 
 /*******************************************************************************
                               TYPEDEFS
@@ -97,7 +110,14 @@ LTE_file_recorder_interface::LTE_file_recorder_interface()
     // Variables
     earfcn    = liblte_interface_first_dl_earfcn[0];
     file_name = "/tmp/lte_iq_file.bin";
+    format    = LIBTOOLS_SAMP_CONV_FORMAT_CF32;
     shutdown  = false;
+
+    // Trigger
+    trigger.mode         = LTE_FILE_RECORDER_TRIGGER_MODE_OFF;
+    trigger.pre_time     = 1.0;
+    trigger.post_time    = 1.0;
+    trigger.power_thresh = -30.0;
 }
 LTE_file_recorder_interface::~LTE_file_recorder_interface()
 {
@@ -204,6 +224,8 @@ void LTE_file_recorder_interface::handle_ctrl_msg(std::string msg)
         interface->handle_start();
     }else if(std::string::npos != msg.find("stop")){
         interface->handle_stop();
+    }else if(std::string::npos != msg.find("trigger")){
+        interface->handle_trigger();
     }else if(std::string::npos != msg.find("shutdown")){
         interface->shutdown = true;
         interface->send_ctrl_status_msg(LTE_FILE_RECORDER_STATUS_OK, "");
@@ -244,6 +266,16 @@ void LTE_file_recorder_interface::handle_read(std::string msg)
         read_earfcn();
     }else if(std::string::npos != msg.find(FILE_NAME_PARAM)){
         read_file_name();
+    }else if(std::string::npos != msg.find(FORMAT_PARAM)){
+        read_format();
+    }else if(std::string::npos != msg.find(TRIGGER_MODE_PARAM)){
+        read_trigger_mode();
+    }else if(std::string::npos != msg.find(PRE_TRIGGER_PARAM)){
+        read_pre_trigger();
+    }else if(std::string::npos != msg.find(POST_TRIGGER_PARAM)){
+        read_post_trigger();
+    }else if(std::string::npos != msg.find(TRIGGER_POWER_PARAM)){
+        read_trigger_power();
     }else{
         send_ctrl_status_msg(LTE_FILE_RECORDER_STATUS_FAIL, "Invalid read");
     }
@@ -255,6 +287,16 @@ void LTE_file_recorder_interface::handle_write(std::string msg)
         write_earfcn(msg.substr(msg.find(EARFCN_PARAM)+sizeof(EARFCN_PARAM), std::string::npos).c_str());
     }else if(std::string::npos != msg.find(FILE_NAME_PARAM)){
         write_file_name(msg.substr(msg.find(FILE_NAME_PARAM)+sizeof(FILE_NAME_PARAM), std::string::npos).c_str());
+    }else if(std::string::npos != msg.find(FORMAT_PARAM)){
+        write_format(msg.substr(msg.find(FORMAT_PARAM)+sizeof(FORMAT_PARAM), std::string::npos).c_str());
+    }else if(std::string::npos != msg.find(TRIGGER_MODE_PARAM)){
+        write_trigger_mode(msg.substr(msg.find(TRIGGER_MODE_PARAM)+sizeof(TRIGGER_MODE_PARAM), std::string::npos).c_str());
+    }else if(std::string::npos != msg.find(PRE_TRIGGER_PARAM)){
+        write_pre_trigger(msg.substr(msg.find(PRE_TRIGGER_PARAM)+sizeof(PRE_TRIGGER_PARAM), std::string::npos).c_str());
+    }else if(std::string::npos != msg.find(POST_TRIGGER_PARAM)){
+        write_post_trigger(msg.substr(msg.find(POST_TRIGGER_PARAM)+sizeof(POST_TRIGGER_PARAM), std::string::npos).c_str());
+    }else if(std::string::npos != msg.find(TRIGGER_POWER_PARAM)){
+        write_trigger_power(msg.substr(msg.find(TRIGGER_POWER_PARAM)+sizeof(TRIGGER_POWER_PARAM), std::string::npos).c_str());
     }else{
         send_ctrl_status_msg(LTE_FILE_RECORDER_STATUS_FAIL, "Invalid write");
     }
@@ -265,7 +307,7 @@ void LTE_file_recorder_interface::handle_start(void)
 
     if(!flowgraph->is_started())
     {
-        if(LTE_FILE_RECORDER_STATUS_OK == flowgraph->start(earfcn, file_name))
+        if(LTE_FILE_RECORDER_STATUS_OK == flowgraph->start(earfcn, file_name, format, &trigger))
         {
             send_ctrl_status_msg(LTE_FILE_RECORDER_STATUS_OK, "");
         }else{
@@ -291,9 +333,21 @@ void LTE_file_recorder_interface::handle_stop(void)
         send_ctrl_status_msg(LTE_FILE_RECORDER_STATUS_FAIL, "Flowgraph not started");
     }
 }
+void LTE_file_recorder_interface::handle_trigger(void)
+{
+    LTE_file_recorder_flowgraph *flowgraph = LTE_file_recorder_flowgraph::get_instance();
+
+    if(LTE_FILE_RECORDER_STATUS_OK == flowgraph->trigger())
+    {
+        send_ctrl_status_msg(LTE_FILE_RECORDER_STATUS_OK, "");
+    }else{
+        send_ctrl_status_msg(LTE_FILE_RECORDER_STATUS_FAIL, "Not started or not in trigger mode");
+    }
+}
 void LTE_file_recorder_interface::handle_help(void)
 {
     std::string tmp_str;
+    uint32      i;
 
     send_ctrl_msg("***System Configuration Parameters***");
     send_ctrl_msg("\tRead parameters using read <param> format");
@@ -301,6 +355,7 @@ void LTE_file_recorder_interface::handle_help(void)
     send_ctrl_msg("\tCommands:");
     send_ctrl_msg("\t\tstart    - Starts recording the specified earfcn");
     send_ctrl_msg("\t\tstop     - Stops the recording");
+    send_ctrl_msg("\t\ttrigger  - Records an event when trigger_mode is not off");
     send_ctrl_msg("\t\tshutdown - Stops the recording and exits");
     send_ctrl_msg("\t\thelp     - Prints this screen");
     send_ctrl_msg("\tParameters:");
@@ -322,6 +377,65 @@ void LTE_file_recorder_interface::handle_help(void)
     tmp_str += FILE_NAME_PARAM;
     tmp_str += " = " + file_name;
     send_ctrl_msg(tmp_str);
+
+    // FORMAT
+    tmp_str  = "\t\t";
+    tmp_str += FORMAT_PARAM;
+    tmp_str += " = ";
+    tmp_str += libtools_samp_conv_format_text[format];
+    tmp_str += ", options = [";
+    for(i=0; i<LIBTOOLS_SAMP_CONV_FORMAT_N_ITEMS; i++)
+    {
+        if(0 != i)
+        {
+            tmp_str += ", ";
+        }
+        tmp_str += libtools_samp_conv_format_text[i];
+    }
+    tmp_str += "]";
+    send_ctrl_msg(tmp_str);
+
+    // TRIGGER_MODE
+    tmp_str  = "\t\t";
+    tmp_str += TRIGGER_MODE_PARAM;
+    tmp_str += " = ";
+    tmp_str += LTE_file_recorder_trigger_mode_text[trigger.mode];
+    tmp_str += ", options = [";
+    for(i=0; i<LTE_FILE_RECORDER_TRIGGER_MODE_N_ITEMS; i++)
+    {
+        if(0 != i)
+        {
+            tmp_str += ", ";
+        }
+        tmp_str += LTE_file_recorder_trigger_mode_text[i];
+    }
+    tmp_str += "]";
+    send_ctrl_msg(tmp_str);
+
+    // PRE_TRIGGER, POST_TRIGGER, and TRIGGER_POWER
+    try
+    {
+        tmp_str  = "\t\t";
+        tmp_str += PRE_TRIGGER_PARAM;
+        tmp_str += " = ";
+        tmp_str += boost::lexical_cast<std::string>(trigger.pre_time);
+        tmp_str += " seconds";
+        send_ctrl_msg(tmp_str);
+        tmp_str  = "\t\t";
+        tmp_str += POST_TRIGGER_PARAM;
+        tmp_str += " = ";
+        tmp_str += boost::lexical_cast<std::string>(trigger.post_time);
+        tmp_str += " seconds";
+        send_ctrl_msg(tmp_str);
+        tmp_str  = "\t\t";
+        tmp_str += TRIGGER_POWER_PARAM;
+        tmp_str += " = ";
+        tmp_str += boost::lexical_cast<std::string>(trigger.power_thresh);
+        tmp_str += " dBFS";
+        send_ctrl_msg(tmp_str);
+    }catch(boost::bad_lexical_cast &){
+        // Intentionally do nothing
+    }
 }
 
 // Gets/Sets
@@ -369,3 +483,118 @@ void LTE_file_recorder_interface::write_file_name(std::string file_name_str)
     file_name = file_name_str;
     send_ctrl_status_msg(LTE_FILE_RECORDER_STATUS_OK, "\"File name not checked\"");
 }
+void LTE_file_recorder_interface::read_format(void)
+{
+    send_ctrl_status_msg(LTE_FILE_RECORDER_STATUS_OK, libtools_samp_conv_format_text[format]);
+}
+void LTE_file_recorder_interface::write_format(std::string format_str)
+{
+    uint32 i;
+
+    for(i=0; i<LIBTOOLS_SAMP_CONV_FORMAT_N_ITEMS; i++)
+    {
+        if(format_str == libtools_samp_conv_format_text[i])
+        {
+            break;
+        }
+    }
+
+    if(LIBTOOLS_SAMP_CONV_FORMAT_N_ITEMS != i)
+    {
+        format = (LIBTOOLS_SAMP_CONV_FORMAT_ENUM)i;
+        send_ctrl_status_msg(LTE_FILE_RECORDER_STATUS_OK, "");
+    }else{
+        send_ctrl_status_msg(LTE_FILE_RECORDER_STATUS_FAIL, "Invalid format");
+    }
+}
+void LTE_file_recorder_interface::read_trigger_mode(void)
+{
+    send_ctrl_status_msg(LTE_FILE_RECORDER_STATUS_OK, LTE_file_recorder_trigger_mode_text[trigger.mode]);
+}
+void LTE_file_recorder_interface::write_trigger_mode(std::string trigger_mode_str)
+{
+    uint32 i;
+
+    for(i=0; i<LTE_FILE_RECORDER_TRIGGER_MODE_N_ITEMS; i++)
+    {
+        if(trigger_mode_str == LTE_file_recorder_trigger_mode_text[i])
+        {
+            break;
+        }
+    }
+
+    if(LTE_FILE_RECORDER_TRIGGER_MODE_N_ITEMS != i)
+    {
+        trigger.mode = (LTE_FILE_RECORDER_TRIGGER_MODE_ENUM)i;
+        send_ctrl_status_msg(LTE_FILE_RECORDER_STATUS_OK, "");
+    }else{
+        send_ctrl_status_msg(LTE_FILE_RECORDER_STATUS_FAIL, "Invalid trigger_mode");
+    }
+}
+void LTE_file_recorder_interface::read_pre_trigger(void)
+{
+    read_float(trigger.pre_time, PRE_TRIGGER_PARAM);
+}
+void LTE_file_recorder_interface::write_pre_trigger(std::string pre_trigger_str)
+{
+    if(write_float(&trigger.pre_time, pre_trigger_str, 0, PRE_TRIGGER_MAX))
+    {
+        send_ctrl_status_msg(LTE_FILE_RECORDER_STATUS_FAIL, "Invalid pre_trigger");
+    }
+}
+void LTE_file_recorder_interface::read_post_trigger(void)
+{
+    read_float(trigger.post_time, POST_TRIGGER_PARAM);
+}
+void LTE_file_recorder_interface::write_post_trigger(std::string post_trigger_str)
+{
+    if(write_float(&trigger.post_time, post_trigger_str, 0, POST_TRIGGER_MAX))
+    {
+        send_ctrl_status_msg(LTE_FILE_RECORDER_STATUS_FAIL, "Invalid post_trigger");
+    }
+}
+void LTE_file_recorder_interface::read_trigger_power(void)
+{
+    read_float(trigger.power_thresh, TRIGGER_POWER_PARAM);
+}
+void LTE_file_recorder_interface::write_trigger_power(std::string trigger_power_str)
+{
+    if(write_float(&trigger.power_thresh, trigger_power_str, TRIGGER_POWER_MIN, TRIGGER_POWER_MAX))
+    {
+        send_ctrl_status_msg(LTE_FILE_RECORDER_STATUS_FAIL, "Invalid trigger_power");
+    }
+}
+void LTE_file_recorder_interface::read_float(float       value,
+                                             std::string name)
+{
+    try
+    {
+        send_ctrl_status_msg(LTE_FILE_RECORDER_STATUS_OK, boost::lexical_cast<std::string>(value).c_str());
+    }catch(boost::bad_lexical_cast &){
+        send_ctrl_status_msg(LTE_FILE_RECORDER_STATUS_FAIL, "bad " + name);
+    }
+}
+bool LTE_file_recorder_interface::write_float(float       *value,
+                                              std::string  value_str,
+                                              float        llimit,
+                                              float        ulimit)
+{
+    float tmp_value;
+    bool  err = true;
+
+    try
+    {
+        tmp_value = boost::lexical_cast<float>(value_str);
+        if(llimit <= tmp_value &&
+           ulimit >= tmp_value)
+        {
+            *value = tmp_value;
+            send_ctrl_status_msg(LTE_FILE_RECORDER_STATUS_OK, "");
+            err = false;
+        }
+    }catch(boost::bad_lexical_cast &){
+        // Intentionally do nothing
+    }
+
+    return(err);
+}
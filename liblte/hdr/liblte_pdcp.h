@@ -0,0 +1,145 @@
+/*******************************************************************************
+
+    Copyright 2026 agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: liblte_pdcp.h
+
+    Description: Contains all the definitions for the LTE Packet Data
+                 Convergence Protocol Layer library.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    agent            Created file.
+
+*******************************************************************************/
+
+#ifndef __LIBLTE_PDCP_H__
+#define __LIBLTE_PDCP_H__
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "liblte_common.h"
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              PARAMETER DECLARATIONS
+*******************************************************************************/
+
+/*********************************************************************
+    Parameter: PDCP SN
+
+    Description: Length of the PDCP SN.
+
+    Document Reference: 36.323 v10.1.0 Section 6.3.2
+*********************************************************************/
+// Defines
+#define LIBLTE_PDCP_SN_5_BITS_MAX_SN  31
+#define LIBLTE_PDCP_SN_7_BITS_MAX_SN  127
+#define LIBLTE_PDCP_SN_12_BITS_MAX_SN 4095
+// Enums
+typedef enum{
+    LIBLTE_PDCP_SN_SIZE_5_BITS = 0,
+    LIBLTE_PDCP_SN_SIZE_7_BITS,
+    LIBLTE_PDCP_SN_SIZE_12_BITS,
+    LIBLTE_PDCP_SN_SIZE_N_ITEMS,
+}LIBLTE_PDCP_SN_SIZE_ENUM;
+static const char liblte_pdcp_sn_size_text[LIBLTE_PDCP_SN_SIZE_N_ITEMS][20] = {"5 bits",
+                                                                               "7 bits",
+                                                                               "12 bits"};
+// Structs
+// Functions
+
+/*********************************************************************
+    Parameter: D/C
+
+    Description: Indicates whether the PDCP PDU is a control or a
+                 data PDU.
+
+    Document Reference: 36.323 v10.1.0 Section 6.3.7
+*********************************************************************/
+// Defines
+// Enums
+typedef enum{
+    LIBLTE_PDCP_DC_FIELD_CONTROL_PDU = 0,
+    LIBLTE_PDCP_DC_FIELD_DATA_PDU,
+    LIBLTE_PDCP_DC_FIELD_N_ITEMS,
+}LIBLTE_PDCP_DC_FIELD_ENUM;
+static const char liblte_pdcp_dc_field_text[LIBLTE_PDCP_DC_FIELD_N_ITEMS][20] = {"Control PDU",
+                                                                                 "Data PDU"};
+// Structs
+// Functions
+
+/*******************************************************************************
+                              PDU DECLARATIONS
+*******************************************************************************/
+
+/*********************************************************************
+    PDU Type: Control Plane PDCP Data PDU
+
+    Document Reference: 36.323 v10.1.0 Section 6.2.2
+*********************************************************************/
+// Defines
+#define LIBLTE_PDCP_CONTROL_PLANE_HEADER_N_BITS 8
+#define LIBLTE_PDCP_MAC_I_N_BITS                32
+// Enums
+// Structs
+typedef struct{
+    LIBLTE_BIT_MSG_STRUCT data;
+    uint32                mac_i;
+    uint8                 sn;
+}LIBLTE_PDCP_CONTROL_PDU_STRUCT;
+// Functions
+LIBLTE_ERROR_ENUM liblte_pdcp_pack_control_pdu(LIBLTE_PDCP_CONTROL_PDU_STRUCT *contents,
+                                               LIBLTE_BIT_MSG_STRUCT          *pdu);
+LIBLTE_ERROR_ENUM liblte_pdcp_unpack_control_pdu(LIBLTE_BIT_MSG_STRUCT          *pdu,
+                                                 LIBLTE_PDCP_CONTROL_PDU_STRUCT *contents);
+
+/*********************************************************************
+    PDU Type: User Plane PDCP Data PDU with long or short SN
+
+    Document Reference: 36.323 v10.1.0 Sections 6.2.3 & 6.2.4
+*********************************************************************/
+// Defines
+#define LIBLTE_PDCP_USER_PLANE_LONG_SN_HEADER_N_BITS  16
+#define LIBLTE_PDCP_USER_PLANE_SHORT_SN_HEADER_N_BITS 8
+// Enums
+// Structs
+typedef struct{
+    LIBLTE_BIT_MSG_STRUCT    data;
+    LIBLTE_PDCP_SN_SIZE_ENUM sn_size;
+    uint16                   sn;
+}LIBLTE_PDCP_USER_PLANE_PDU_STRUCT;
+// Functions
+LIBLTE_ERROR_ENUM liblte_pdcp_pack_user_plane_pdu(LIBLTE_PDCP_USER_PLANE_PDU_STRUCT *contents,
+                                                  LIBLTE_BIT_MSG_STRUCT             *pdu);
+LIBLTE_ERROR_ENUM liblte_pdcp_unpack_user_plane_pdu(LIBLTE_BIT_MSG_STRUCT             *pdu,
+                                                    LIBLTE_PDCP_SN_SIZE_ENUM           sn_size,
+                                                    LIBLTE_PDCP_USER_PLANE_PDU_STRUCT *contents);
+
+#endif /* __LIBLTE_PDCP_H__ */
@@ -60,6 +60,10 @@
                                    in each slot.
     05/04/2014    Ben Wojtowicz    Added PHICH and TPC support.
     06/15/2014    Ben Wojtowicz    Added TPC values for DCI 0, 3, and 4.
+    10/19/2026    agent            Added PDSCH encoding of a single allocation.
+    10/19/2026    agent            Added a numerically controlled oscillator
+                                   for frequency offset correction.
+    10/19/2026    agent            Added a polyphase rational resampler.
 
 *******************************************************************************/
 
@@ -663,6 +667,25 @@ LIBLTE_ERROR_ENUM liblte_phy_pusch_channel_decode(LIBLTE_PHY_STRUCT            *
                                                   uint8                        *out_bits,
                                                   uint32                       *N_out_bits);
 
+/*********************************************************************
+    Name: liblte_phy_pusch_estimate_sinr
+
+    Description: Estimates the SINR of a Physical Uplink Shared
+                 Channel from its demodulation reference signals
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.5.2.1
+*********************************************************************/
+// Defines
+#define LIBLTE_PHY_PUSCH_SINR_MIN_DB -20.0
+#define LIBLTE_PHY_PUSCH_SINR_MAX_DB 40.0
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_phy_pusch_estimate_sinr(LIBLTE_PHY_STRUCT            *phy_struct,
+                                                 LIBLTE_PHY_SUBFRAME_STRUCT   *subframe,
+                                                 LIBLTE_PHY_ALLOCATION_STRUCT *alloc,
+                                                 float                        *sinr_db);
+
 /*********************************************************************
     Name: liblte_phy_generate_prach
 
@@ -723,6 +746,25 @@ LIBLTE_ERROR_ENUM liblte_phy_pdsch_channel_encode(LIBLTE_PHY_STRUCT          *ph
                                                   uint8                       N_ant,
                                                   LIBLTE_PHY_SUBFRAME_STRUCT *subframe);
 
+/*********************************************************************
+    Name: liblte_phy_pdsch_channel_encode_alloc
+
+    Description: Encodes and modulates a single allocation of the
+                 Physical Downlink Shared Channel
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 sections 6.3 and 6.4
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_phy_pdsch_channel_encode_alloc(LIBLTE_PHY_STRUCT            *phy_struct,
+                                                        LIBLTE_PHY_ALLOCATION_STRUCT *alloc,
+                                                        uint32                        N_pdcch_symbs,
+                                                        uint32                        N_id_cell,
+                                                        uint8                         N_ant,
+                                                        LIBLTE_PHY_SUBFRAME_STRUCT   *subframe);
+
 /*********************************************************************
     Name: liblte_phy_pdsch_channel_decode
 
@@ -1106,4 +1148,220 @@ LIBLTE_ERROR_ENUM liblte_phy_get_n_cce(LIBLTE_PHY_STRUCT *phy_struct,
                                        uint8              N_ant,
                                        uint32            *N_cce);
 
+/*********************************************************************
+    Name: liblte_phy_nco_init
+
+    Description: Initializes a numerically controlled oscillator that
+                 removes a frequency offset from I/Q samples.
+
+    Document Reference: N/A
+
+    Notes: The phase is kept for LIBLTE_PHY_NCO_N_LANES consecutive
+           samples so that the rotation can be done in SIMD lanes,
+           lanes are renormalized every LIBLTE_PHY_NCO_RENORM_N_BLOCKS
+*********************************************************************/
+// Defines
+#define LIBLTE_PHY_NCO_N_LANES         4
+#define LIBLTE_PHY_NCO_RENORM_N_BLOCKS 256
+// Enums
+// Structs
+typedef struct{
+    float  phase_re[LIBLTE_PHY_NCO_N_LANES];
+    float  phase_im[LIBLTE_PHY_NCO_N_LANES];
+    float  step_re;
+    float  step_im;
+    float  freq_offset;
+    uint32 fs;
+    uint32 N_blocks;
+}LIBLTE_PHY_NCO_STRUCT;
+// Functions
+LIBLTE_ERROR_ENUM liblte_phy_nco_init(LIBLTE_PHY_NCO_STRUCT *nco,
+                                      uint32                 fs,
+                                      float                  freq_offset);
+
+/*********************************************************************
+    Name: liblte_phy_nco_set_freq_offset
+
+    Description: Changes the frequency offset removed by an NCO
+                 without disturbing its phase.
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_phy_nco_set_freq_offset(LIBLTE_PHY_NCO_STRUCT *nco,
+                                                 float                  freq_offset);
+
+/*********************************************************************
+    Name: liblte_phy_nco_seek
+
+    Description: Moves the phase of an NCO forward, or backward for a
+                 negative number of samples, without rotating any
+                 samples.
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_phy_nco_seek(LIBLTE_PHY_NCO_STRUCT *nco,
+                                      int32                  N_samps);
+
+/*********************************************************************
+    Name: liblte_phy_nco_rotate
+
+    Description: Removes the frequency offset of an NCO from I/Q
+                 samples in place and advances its phase.
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_phy_nco_rotate(LIBLTE_PHY_NCO_STRUCT *nco,
+                                        float                 *i_buf,
+                                        float                 *q_buf,
+                                        uint32                 N_samps);
+
+/*********************************************************************
+    Name: liblte_phy_resamp_init
+
+    Description: Initializes a polyphase rational resampler that
+                 changes the sample rate of I/Q samples by
+                 interp/decim.
+
+    Document Reference: N/A
+
+    Notes: The taps are designed for the interpolated rate, as for
+           GNU Radio's rational_resampler_base, and are split into
+           one bank per phase with each bank padded to a multiple of
+           LIBLTE_PHY_RESAMP_N_LANES taps.  If taps is NULL a
+           Blackman windowed low pass filter with
+           LIBLTE_PHY_RESAMP_N_TAPS_PER_SAMP taps per sample at the
+           slower of the two rates is designed.  interp and decim
+           must be reduced to lowest terms and not be more than
+           LIBLTE_PHY_RESAMP_MAX_FACTOR.
+*********************************************************************/
+// Defines
+#define LIBLTE_PHY_RESAMP_N_LANES         4
+#define LIBLTE_PHY_RESAMP_N_TAPS_PER_SAMP 16
+#define LIBLTE_PHY_RESAMP_MAX_FACTOR      65536
+// Enums
+// Structs
+typedef struct{
+    float  *taps;
+    float  *hist_i_buf;
+    float  *hist_q_buf;
+    uint32  interp;
+    uint32  decim;
+    uint32  N_taps_per_phase;
+    uint32  phase;
+    uint32  next_in_idx;
+    bool    taps_shared;
+}LIBLTE_PHY_RESAMP_STRUCT;
+// Functions
+LIBLTE_ERROR_ENUM liblte_phy_resamp_init(LIBLTE_PHY_RESAMP_STRUCT **resamp,
+                                         uint32                     interp,
+                                         uint32                     decim,
+                                         float                     *taps,
+                                         uint32                     N_taps);
+
+/*********************************************************************
+    Name: liblte_phy_resamp_init_shared
+
+    Description: Initializes a polyphase rational resampler that uses
+                 the taps of an existing one and keeps its own history
+                 and phase.
+
+    Document Reference: N/A
+
+    Notes: proto must not be cleaned up before the new resampler.
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_phy_resamp_init_shared(LIBLTE_PHY_RESAMP_STRUCT **resamp,
+                                                LIBLTE_PHY_RESAMP_STRUCT  *proto);
+
+/*********************************************************************
+    Name: liblte_phy_resamp_cleanup
+
+    Description: Frees a polyphase rational resampler.
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_phy_resamp_cleanup(LIBLTE_PHY_RESAMP_STRUCT *resamp);
+
+/*********************************************************************
+    Name: liblte_phy_resamp_reset
+
+    Description: Clears the history of a polyphase rational resampler
+                 and positions it so that the next output sample is
+                 out_idx samples into the output stream.
+
+    Document Reference: N/A
+
+    Notes: in_idx is the index of the first input sample that must
+           be passed to liblte_phy_resamp_run, the samples before
+           the first output fill the history.
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_phy_resamp_reset(LIBLTE_PHY_RESAMP_STRUCT *resamp,
+                                          uint64                    out_idx,
+                                          uint64                   *in_idx);
+
+/*********************************************************************
+    Name: liblte_phy_resamp_get_n_in
+
+    Description: Determines the number of input samples needed for a
+                 polyphase rational resampler to produce N_out output
+                 samples.
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_phy_resamp_get_n_in(LIBLTE_PHY_RESAMP_STRUCT *resamp,
+                                             uint32                    N_out,
+                                             uint32                   *N_in);
+
+/*********************************************************************
+    Name: liblte_phy_resamp_run
+
+    Description: Resamples a block of I/Q samples, the history is kept
+                 so that consecutive blocks form one stream.
+
+    Document Reference: N/A
+
+    Notes: All input samples are consumed and at most N_out_max
+           output samples are produced, N_in must not be more than
+           liblte_phy_resamp_get_n_in gives for N_out_max.
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+LIBLTE_ERROR_ENUM liblte_phy_resamp_run(LIBLTE_PHY_RESAMP_STRUCT *resamp,
+                                        float                    *i_in,
+                                        float                    *q_in,
+                                        uint32                    N_in,
+                                        float                    *i_out,
+                                        float                    *q_out,
+                                        uint32                    N_out_max,
+                                        uint32                   *N_out);
+
 #endif /* __LIBLTE_PHY_H__ */
@@ -25,6 +25,10 @@
     Revision History
     ----------    -------------    --------------------------------------------
     06/15/2014    Ben Wojtowicz    Created file.
+    10/19/2026    agent            Added AMD PDU segments and NACKs in STATUS
+                                   PDUs.
+    10/19/2026    agent            Added UMD PDUs with 5 and 10 bit sequence
+                                   numbers and length indicators.
 
 *******************************************************************************/
 
@@ -42,6 +46,12 @@
 *******************************************************************************/
 
 #define LIBLTE_RLC_AM_WINDOW_SIZE 512
+#define LIBLTE_RLC_AM_MODULUS     1024
+
+#define LIBLTE_RLC_UM_WINDOW_SIZE_SN_5_BITS  16
+#define LIBLTE_RLC_UM_MODULUS_SN_5_BITS      32
+#define LIBLTE_RLC_UM_WINDOW_SIZE_SN_10_BITS 512
+#define LIBLTE_RLC_UM_MODULUS_SN_10_BITS     1024
 
 /*******************************************************************************
                               TYPEDEFS
@@ -97,6 +107,22 @@ static const char liblte_rlc_fi_field_text[LIBLTE_RLC_FI_FIELD_N_ITEMS][20] = {"
 // Structs
 // Functions
 
+/*********************************************************************
+    Parameter: Length Indicator (LI)
+
+    Description: The LI field indicates the length in bytes of the
+                 corresponding Data field element present in the
+                 RLC data PDU delivered/received by an UM or an AM
+                 RLC entity.
+
+    Document Reference: 36.322 v10.0.0 Section 6.2.2.5
+*********************************************************************/
+// Defines
+#define LIBLTE_RLC_LI_FIELD_MAX_VALUE 2047
+// Enums
+// Structs
+// Functions
+
 /*********************************************************************
     Parameter: Last Segment Flag (LSF)
 
@@ -243,10 +269,40 @@ static const char liblte_rlc_e2_field_text[LIBLTE_RLC_E2_FIELD_N_ITEMS][20] = {"
     Document Reference: 36.322 v10.0.0 Section 6.2.1.3
 *********************************************************************/
 // Defines
+#define LIBLTE_RLC_UMD_PDU_MAX_N_SLICES 16
 // Enums
+typedef enum{
+    LIBLTE_RLC_UMD_SN_SIZE_5_BITS = 0,
+    LIBLTE_RLC_UMD_SN_SIZE_10_BITS,
+    LIBLTE_RLC_UMD_SN_SIZE_N_ITEMS,
+}LIBLTE_RLC_UMD_SN_SIZE_ENUM;
+static const char liblte_rlc_umd_sn_size_text[LIBLTE_RLC_UMD_SN_SIZE_N_ITEMS][20] = {"5 bits",
+                                                                                     "10 bits"};
 // Structs
+typedef struct{
+    LIBLTE_RLC_FI_FIELD_ENUM    fi;
+    LIBLTE_RLC_UMD_SN_SIZE_ENUM sn_size;
+    uint16                      sn;
+}LIBLTE_RLC_UMD_PDU_HEADER_STRUCT;
+// The data field is described as a list of slices, one per (part of an)
+// RLC SDU, which point into buffers owned by the caller.  Packing copies the
+// slices directly into the PDU and unpacking points the slices into the PDU,
+// so no intermediate copies of the data are made.
+typedef struct{
+    uint8  *msg;
+    uint32  N_bits;
+}LIBLTE_RLC_SLICE_STRUCT;
+typedef struct{
+    LIBLTE_RLC_UMD_PDU_HEADER_STRUCT hdr;
+    LIBLTE_RLC_SLICE_STRUCT          slice[LIBLTE_RLC_UMD_PDU_MAX_N_SLICES];
+    uint32                           N_slices;
+}LIBLTE_RLC_UMD_PDU_STRUCT;
 // Functions
-// FIXME
+LIBLTE_ERROR_ENUM liblte_rlc_pack_umd_pdu(LIBLTE_RLC_UMD_PDU_STRUCT *umd,
+                                          LIBLTE_BIT_MSG_STRUCT     *pdu);
+LIBLTE_ERROR_ENUM liblte_rlc_unpack_umd_pdu(LIBLTE_BIT_MSG_STRUCT       *pdu,
+                                            LIBLTE_RLC_UMD_SN_SIZE_ENUM  sn_size,
+                                            LIBLTE_RLC_UMD_PDU_STRUCT   *umd);
 
 /*********************************************************************
     PDU Type: Acknowledged Mode Data PDU
@@ -254,17 +310,24 @@ static const char liblte_rlc_e2_field_text[LIBLTE_RLC_E2_FIELD_N_ITEMS][20] = {"
     Document Reference: 36.322 v10.0.0 Sections 6.2.1.4 & 6.2.1.5
 *********************************************************************/
 // Defines
+#define LIBLTE_RLC_AMD_PDU_MAX_N_SLICES LIBLTE_RLC_UMD_PDU_MAX_N_SLICES
 // Enums
 // Structs
 typedef struct{
-    LIBLTE_RLC_RF_FIELD_ENUM rf;
-    LIBLTE_RLC_P_FIELD_ENUM  p;
-    LIBLTE_RLC_FI_FIELD_ENUM fi;
-    uint16                   sn;
+    LIBLTE_RLC_RF_FIELD_ENUM  rf;
+    LIBLTE_RLC_P_FIELD_ENUM   p;
+    LIBLTE_RLC_FI_FIELD_ENUM  fi;
+    LIBLTE_RLC_LSF_FIELD_ENUM lsf;
+    uint16                    sn;
+    uint16                    so;
 }LIBLTE_RLC_AMD_PDU_HEADER_STRUCT;
+// Unpacking also points one slice per (part of an) RLC SDU into the PDU,
+// packing only uses data
 typedef struct{
     LIBLTE_RLC_AMD_PDU_HEADER_STRUCT hdr;
     LIBLTE_BIT_MSG_STRUCT            data;
+    LIBLTE_RLC_SLICE_STRUCT          slice[LIBLTE_RLC_AMD_PDU_MAX_N_SLICES];
+    uint32                           N_slices;
 }LIBLTE_RLC_AMD_PDU_STRUCT;
 // Functions
 LIBLTE_ERROR_ENUM liblte_rlc_pack_amd_pdu(LIBLTE_RLC_AMD_PDU_STRUCT *amd,
@@ -278,10 +341,20 @@ LIBLTE_ERROR_ENUM liblte_rlc_unpack_amd_pdu(LIBLTE_BIT_MSG_STRUCT     *pdu,
     Document Reference: 36.322 v10.0.0 Section 6.2.1.6
 *********************************************************************/
 // Defines
+#define LIBLTE_RLC_STATUS_PDU_MAX_N_NACK 64
+#define LIBLTE_RLC_SO_END_OF_PDU         0x7FFF
 // Enums
 // Structs
 typedef struct{
-    uint16 ack_sn;
+    uint16 nack_sn;
+    uint16 so_start;
+    uint16 so_end;
+    bool   so_present;
+}LIBLTE_RLC_NACK_STRUCT;
+typedef struct{
+    LIBLTE_RLC_NACK_STRUCT nack[LIBLTE_RLC_STATUS_PDU_MAX_N_NACK];
+    uint32                 N_nack;
+    uint16                 ack_sn;
 }LIBLTE_RLC_STATUS_PDU_STRUCT;
 // Functions
 LIBLTE_ERROR_ENUM liblte_rlc_pack_status_pdu(LIBLTE_RLC_STATUS_PDU_STRUCT *status,
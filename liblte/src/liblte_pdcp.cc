@@ -0,0 +1,257 @@
+/*******************************************************************************
+
+    Copyright 2026 agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: liblte_pdcp.cc
+
+    Description: Contains all the implementations for the LTE Packet Data
+                 Convergence Protocol Layer library.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    agent            Created file.
+
+*******************************************************************************/
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "liblte_pdcp.h"
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              GLOBAL VARIABLES
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              LOCAL FUNCTION PROTOTYPES
+*******************************************************************************/
+
+/*********************************************************************
+    Name: pdcp_value_2_bits
+
+    Description: Converts a value to a bit string
+*********************************************************************/
+void pdcp_value_2_bits(uint32   value,
+                       uint8  **bits,
+                       uint32   N_bits);
+
+/*********************************************************************
+    Name: pdcp_bits_2_value
+
+    Description: Converts a bit string to a value
+*********************************************************************/
+uint32 pdcp_bits_2_value(uint8  **bits,
+                         uint32   N_bits);
+
+/*******************************************************************************
+                              PDU FUNCTIONS
+*******************************************************************************/
+
+/*********************************************************************
+    PDU Type: Control Plane PDCP Data PDU
+
+    Document Reference: 36.323 v10.1.0 Section 6.2.2
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_pdcp_pack_control_pdu(LIBLTE_PDCP_CONTROL_PDU_STRUCT *contents,
+                                               LIBLTE_BIT_MSG_STRUCT          *pdu)
+{
+    LIBLTE_ERROR_ENUM  err     = LIBLTE_ERROR_INVALID_INPUTS;
+    uint8             *pdu_ptr = pdu->msg;
+
+    if(contents != NULL &&
+       pdu      != NULL &&
+       (contents->data.N_bits + LIBLTE_PDCP_CONTROL_PLANE_HEADER_N_BITS + LIBLTE_PDCP_MAC_I_N_BITS) <= LIBLTE_MAX_MSG_SIZE)
+    {
+        // Header
+        pdcp_value_2_bits(0, &pdu_ptr, 3);
+        pdcp_value_2_bits(contents->sn, &pdu_ptr, 5);
+
+        // Data
+        memcpy(pdu_ptr, contents->data.msg, contents->data.N_bits);
+        pdu_ptr += contents->data.N_bits;
+
+        // MAC-I
+        pdcp_value_2_bits(contents->mac_i, &pdu_ptr, 32);
+
+        pdu->N_bits = pdu_ptr - pdu->msg;
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+LIBLTE_ERROR_ENUM liblte_pdcp_unpack_control_pdu(LIBLTE_BIT_MSG_STRUCT          *pdu,
+                                                 LIBLTE_PDCP_CONTROL_PDU_STRUCT *contents)
+{
+    LIBLTE_ERROR_ENUM  err     = LIBLTE_ERROR_INVALID_INPUTS;
+    uint8             *pdu_ptr = pdu->msg;
+
+    if(pdu         != NULL                                                                &&
+       contents    != NULL                                                                &&
+       pdu->N_bits >= (LIBLTE_PDCP_CONTROL_PLANE_HEADER_N_BITS + LIBLTE_PDCP_MAC_I_N_BITS))
+    {
+        // Header
+        pdcp_bits_2_value(&pdu_ptr, 3);
+        contents->sn = pdcp_bits_2_value(&pdu_ptr, 5);
+
+        // Data
+        contents->data.N_bits = pdu->N_bits - LIBLTE_PDCP_CONTROL_PLANE_HEADER_N_BITS - LIBLTE_PDCP_MAC_I_N_BITS;
+        memcpy(contents->data.msg, pdu_ptr, contents->data.N_bits);
+        pdu_ptr += contents->data.N_bits;
+
+        // MAC-I
+        contents->mac_i = pdcp_bits_2_value(&pdu_ptr, 32);
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    PDU Type: User Plane PDCP Data PDU with long or short SN
+
+    Document Reference: 36.323 v10.1.0 Sections 6.2.3 & 6.2.4
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_pdcp_pack_user_plane_pdu(LIBLTE_PDCP_USER_PLANE_PDU_STRUCT *contents,
+                                                  LIBLTE_BIT_MSG_STRUCT             *pdu)
+{
+    LIBLTE_ERROR_ENUM  err     = LIBLTE_ERROR_INVALID_INPUTS;
+    uint8             *pdu_ptr = pdu->msg;
+
+    if(contents != NULL &&
+       pdu      != NULL &&
+       (contents->data.N_bits + LIBLTE_PDCP_USER_PLANE_LONG_SN_HEADER_N_BITS) <= LIBLTE_MAX_MSG_SIZE)
+    {
+        // Header
+        pdcp_value_2_bits(LIBLTE_PDCP_DC_FIELD_DATA_PDU, &pdu_ptr, 1);
+        if(LIBLTE_PDCP_SN_SIZE_7_BITS == contents->sn_size)
+        {
+            pdcp_value_2_bits(contents->sn, &pdu_ptr, 7);
+        }else{
+            pdcp_value_2_bits(0, &pdu_ptr, 3);
+            pdcp_value_2_bits(contents->sn, &pdu_ptr, 12);
+        }
+
+        // Data
+        memcpy(pdu_ptr, contents->data.msg, contents->data.N_bits);
+        pdu_ptr += contents->data.N_bits;
+
+        pdu->N_bits = pdu_ptr - pdu->msg;
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+LIBLTE_ERROR_ENUM liblte_pdcp_unpack_user_plane_pdu(LIBLTE_BIT_MSG_STRUCT             *pdu,
+                                                    LIBLTE_PDCP_SN_SIZE_ENUM           sn_size,
+                                                    LIBLTE_PDCP_USER_PLANE_PDU_STRUCT *contents)
+{
+    LIBLTE_ERROR_ENUM          err     = LIBLTE_ERROR_INVALID_INPUTS;
+    uint8                     *pdu_ptr = pdu->msg;
+    LIBLTE_PDCP_DC_FIELD_ENUM  dc;
+    uint32                     N_hdr   = LIBLTE_PDCP_USER_PLANE_LONG_SN_HEADER_N_BITS;
+
+    if(LIBLTE_PDCP_SN_SIZE_7_BITS == sn_size)
+    {
+        N_hdr = LIBLTE_PDCP_USER_PLANE_SHORT_SN_HEADER_N_BITS;
+    }
+
+    if(pdu         != NULL &&
+       contents    != NULL &&
+       pdu->N_bits >= N_hdr)
+    {
+        // Header
+        dc = (LIBLTE_PDCP_DC_FIELD_ENUM)pdcp_bits_2_value(&pdu_ptr, 1);
+
+        if(LIBLTE_PDCP_DC_FIELD_DATA_PDU == dc)
+        {
+            contents->sn_size = sn_size;
+            if(LIBLTE_PDCP_SN_SIZE_7_BITS == sn_size)
+            {
+                contents->sn = pdcp_bits_2_value(&pdu_ptr, 7);
+            }else{
+                pdcp_bits_2_value(&pdu_ptr, 3);
+                contents->sn = pdcp_bits_2_value(&pdu_ptr, 12);
+            }
+
+            // Data
+            contents->data.N_bits = pdu->N_bits - N_hdr;
+            memcpy(contents->data.msg, pdu_ptr, contents->data.N_bits);
+
+            err = LIBLTE_SUCCESS;
+        }
+    }
+
+    return(err);
+}
+
+/*******************************************************************************
+                              LOCAL FUNCTIONS
+*******************************************************************************/
+
+/*********************************************************************
+    Name: pdcp_value_2_bits
+
+    Description: Converts a value to a bit string
+*********************************************************************/
+void pdcp_value_2_bits(uint32   value,
+                       uint8  **bits,
+                       uint32   N_bits)
+{
+    uint32 i;
+
+    for(i=0; i<N_bits; i++)
+    {
+        (*bits)[i] = (value >> (N_bits-i-1)) & 0x1;
+    }
+    *bits += N_bits;
+}
+
+/*********************************************************************
+    Name: pdcp_bits_2_value
+
+    Description: Converts a bit string to a value
+*********************************************************************/
+uint32 pdcp_bits_2_value(uint8  **bits,
+                         uint32   N_bits)
+{
+    uint32 value = 0;
+    uint32 i;
+
+    for(i=0; i<N_bits; i++)
+    {
+        value |= (*bits)[i] << (N_bits-i-1);
+    }
+    *bits += N_bits;
+
+    return(value);
+}
@@ -95,6 +95,14 @@
                                    PDCCH encode/decode.
     06/15/2014    Ben Wojtowicz    Added DCI 0 packing and proper support for
                                    transmission of more than one CCE in PDCCH.
+    10/19/2026    agent            Split PDSCH encoding into a per allocation
+                                   routine.
+    10/19/2026    agent            Added a SIMD NCO for frequency offset
+                                   correction.
+    10/19/2026    agent            Fixed PHICH mapping for more than one
+                                   antenna.
+    10/19/2026    agent            Added a polyphase rational resampler with a
+                                   SIMD filter kernel.
 
 *******************************************************************************/
 
@@ -105,6 +113,9 @@
 #include "liblte_phy.h"
 #include "liblte_mac.h"
 #include <math.h>
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif
 
 /*******************************************************************************
                               DEFINES
@@ -2215,6 +2226,41 @@ uint32 phy_bits_2_value(uint8  **bits,
 void wrap_phase(float *phase_1,
                 float  phase_2);
 
+/*********************************************************************
+    Name: nco_set_lanes
+
+    Description: Sets the NCO lane phases and step from the phase of
+                 the next sample.
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void nco_set_lanes(LIBLTE_PHY_NCO_STRUCT *nco,
+                   double                 phase_re,
+                   double                 phase_im);
+
+/*********************************************************************
+    Name: resamp_filter
+
+    Description: Filters I/Q samples with one phase of a polyphase
+                 rational resampler to produce one output sample.
+
+    Document Reference: N/A
+*********************************************************************/
+// Defines
+// Enums
+// Structs
+// Functions
+void resamp_filter(float  *taps,
+                   float  *i_buf,
+                   float  *q_buf,
+                   uint32  N_taps,
+                   float  *i_out,
+                   float  *q_out);
+
 /*******************************************************************************
                               LIBRARY FUNCTIONS
 *******************************************************************************/
@@ -2928,6 +2974,92 @@ LIBLTE_ERROR_ENUM liblte_phy_pusch_channel_decode(LIBLTE_PHY_STRUCT            *
     return(err);
 }
 
+/*********************************************************************
+    Name: liblte_phy_pusch_estimate_sinr
+
+    Description: Estimates the SINR of a Physical Uplink Shared
+                 Channel from its demodulation reference signals
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 section 5.5.2.1
+
+    Notes: Uses the difference between the channel estimates of the
+           two DMRS symbols as the noise estimate, so channel variation
+           within the subframe reads as noise
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_pusch_estimate_sinr(LIBLTE_PHY_STRUCT            *phy_struct,
+                                                 LIBLTE_PHY_SUBFRAME_STRUCT   *subframe,
+                                                 LIBLTE_PHY_ALLOCATION_STRUCT *alloc,
+                                                 float                        *sinr_db)
+{
+    LIBLTE_ERROR_ENUM  err = LIBLTE_ERROR_INVALID_INPUTS;
+    float             *dmrs_0_re;
+    float             *dmrs_0_im;
+    float             *dmrs_1_re;
+    float             *dmrs_1_im;
+    float              h_0_re;
+    float              h_0_im;
+    float              h_1_re;
+    float              h_1_im;
+    float              pwr;
+    float              sig_pwr;
+    float              noise_pwr;
+    uint32             prb_idx;
+    uint32             i;
+    uint32             j;
+    uint32             k;
+    uint32             M_pusch_sc;
+
+    if(phy_struct   != NULL &&
+       subframe     != NULL &&
+       alloc        != NULL &&
+       sinr_db      != NULL &&
+       alloc->N_prb != 0    &&
+       phy_struct->ul_init)
+    {
+        dmrs_0_re  = phy_struct->dmrs_0_re[subframe->num][alloc->N_prb];
+        dmrs_0_im  = phy_struct->dmrs_0_im[subframe->num][alloc->N_prb];
+        dmrs_1_re  = phy_struct->dmrs_1_re[subframe->num][alloc->N_prb];
+        dmrs_1_im  = phy_struct->dmrs_1_im[subframe->num][alloc->N_prb];
+        M_pusch_sc = alloc->N_prb * phy_struct->N_sc_rb_ul;
+        pwr        = 0;
+        noise_pwr  = 0;
+        k          = 0;
+        for(prb_idx=0; prb_idx<alloc->N_prb; prb_idx++)
+        {
+            for(j=0; j<phy_struct->N_sc_rb_ul; j++)
+            {
+                // Remove the DMRS from both slots
+                i      = alloc->prb[0][prb_idx]*phy_struct->N_sc_rb_ul + j;
+                h_0_re = subframe->rx_symb_re[3][i]*dmrs_0_re[k] + subframe->rx_symb_im[3][i]*dmrs_0_im[k];
+                h_0_im = subframe->rx_symb_im[3][i]*dmrs_0_re[k] - subframe->rx_symb_re[3][i]*dmrs_0_im[k];
+                i      = alloc->prb[1][prb_idx]*phy_struct->N_sc_rb_ul + j;
+                h_1_re = subframe->rx_symb_re[10][i]*dmrs_1_re[k] + subframe->rx_symb_im[10][i]*dmrs_1_im[k];
+                h_1_im = subframe->rx_symb_im[10][i]*dmrs_1_re[k] - subframe->rx_symb_re[10][i]*dmrs_1_im[k];
+                k++;
+
+                pwr       += (h_0_re*h_0_re + h_0_im*h_0_im + h_1_re*h_1_re + h_1_im*h_1_im)/2;
+                noise_pwr += ((h_1_re - h_0_re)*(h_1_re - h_0_re) + (h_1_im - h_0_im)*(h_1_im - h_0_im))/2;
+            }
+        }
+        pwr       /= M_pusch_sc;
+        noise_pwr /= M_pusch_sc;
+        sig_pwr    = pwr - noise_pwr;
+
+        if(sig_pwr <= noise_pwr*powf(10, LIBLTE_PHY_PUSCH_SINR_MIN_DB/10))
+        {
+            *sinr_db = LIBLTE_PHY_PUSCH_SINR_MIN_DB;
+        }else if(noise_pwr <= sig_pwr*powf(10, -LIBLTE_PHY_PUSCH_SINR_MAX_DB/10)){
+            *sinr_db = LIBLTE_PHY_PUSCH_SINR_MAX_DB;
+        }else{
+            *sinr_db = 10*log10f(sig_pwr/noise_pwr);
+        }
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
 /*********************************************************************
     Name: liblte_phy_generate_prach
 
@@ -3192,18 +3324,19 @@ LIBLTE_ERROR_ENUM liblte_phy_detect_prach(LIBLTE_PHY_STRUCT *phy_struct,
 }
 
 /*********************************************************************
-    Name: liblte_phy_pdsch_channel_encode
+    Name: liblte_phy_pdsch_channel_encode_alloc
 
-    Description: Encodes and modulates the Physical Downlink Shared
-                 Channel
+    Description: Encodes and modulates a single allocation of the
+                 Physical Downlink Shared Channel
 
     Document Reference: 3GPP TS 36.211 v10.1.0 sections 6.3 and 6.4
 *********************************************************************/
-LIBLTE_ERROR_ENUM liblte_phy_pdsch_channel_encode(LIBLTE_PHY_STRUCT          *phy_struct,
-                                                  LIBLTE_PHY_PDCCH_STRUCT    *pdcch,
-                                                  uint32                      N_id_cell,
-                                                  uint8                       N_ant,
-                                                  LIBLTE_PHY_SUBFRAME_STRUCT *subframe)
+LIBLTE_ERROR_ENUM liblte_phy_pdsch_channel_encode_alloc(LIBLTE_PHY_STRUCT            *phy_struct,
+                                                        LIBLTE_PHY_ALLOCATION_STRUCT *alloc,
+                                                        uint32                        N_pdcch_symbs,
+                                                        uint32                        N_id_cell,
+                                                        uint8                         N_ant,
+                                                        LIBLTE_PHY_SUBFRAME_STRUCT   *subframe)
 {
     LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
     uint32            i;
@@ -3211,7 +3344,6 @@ LIBLTE_ERROR_ENUM liblte_phy_pdsch_channel_encode(LIBLTE_PHY_STRUCT          *ph
     uint32            p;
     uint32            L;
     uint32            idx;
-    uint32            alloc_idx;
     uint32            prb_idx;
     uint32            c_init;
     uint32            N_bits_tot;
@@ -3223,7 +3355,7 @@ LIBLTE_ERROR_ENUM liblte_phy_pdsch_channel_encode(LIBLTE_PHY_STRUCT          *ph
     uint32            last_sc;
 
     if(phy_struct != NULL &&
-       pdcch      != NULL &&
+       alloc      != NULL &&
        N_id_cell  >= 0    &&
        N_id_cell  <= 503  &&
        subframe   != NULL)
@@ -3250,120 +3382,117 @@ LIBLTE_ERROR_ENUM liblte_phy_pdsch_channel_encode(LIBLTE_PHY_STRUCT          *ph
             last_sc  = (53*phy_struct->N_sc_rb_dl)-1;
         }
 
-        for(alloc_idx=0; alloc_idx<pdcch->N_alloc; alloc_idx++)
+        if(alloc->chan_type == LIBLTE_PHY_CHAN_TYPE_DLSCH)
         {
-            if(pdcch->alloc[alloc_idx].chan_type == LIBLTE_PHY_CHAN_TYPE_DLSCH)
+            // Determine the number of bits available for transmission
+            N_bits_tot = 0;
+            for(i=0; i<alloc->N_prb; i++)
             {
-                // Determine the number of bits available for transmission
-                N_bits_tot = 0;
-                for(i=0; i<pdcch->alloc[alloc_idx].N_prb; i++)
-                {
-                    N_bits_tot += get_num_bits_in_prb(subframe->num,
-                                                      pdcch->N_symbs,
-                                                      pdcch->alloc[alloc_idx].prb[0][i],
-                                                      phy_struct->N_rb_dl,
-                                                      N_ant,
-                                                      pdcch->alloc[alloc_idx].mod_type);
-                }
-                // Encode the PDSCH
-                dlsch_channel_encode(phy_struct,
-                                     pdcch->alloc[alloc_idx].msg.msg,
-                                     pdcch->alloc[alloc_idx].msg.N_bits,
-                                     pdcch->alloc[alloc_idx].tbs,
-                                     pdcch->alloc[alloc_idx].tx_mode,
-                                     pdcch->alloc[alloc_idx].rv_idx,
-                                     N_bits_tot,
-                                     2,
-                                     2,
-                                     8,
-                                     250368,
-                                     phy_struct->pdsch_encode_bits,
-                                     &N_bits);
-                // FIXME: Only handling 1 codeword
-                c_init = (pdcch->alloc[alloc_idx].rnti << 14) | (0 << 13) | (subframe->num << 9) | N_id_cell;
-                generate_prs_c(c_init, N_bits, phy_struct->pdsch_c);
-                for(i=0; i<N_bits; i++)
-                {
-                    phy_struct->pdsch_scramb_bits[i] = phy_struct->pdsch_encode_bits[i] ^ phy_struct->pdsch_c[i];
-                }
-                modulation_mapper(phy_struct->pdsch_scramb_bits,
-                                  N_bits,
-                                  pdcch->alloc[alloc_idx].mod_type,
-                                  phy_struct->pdsch_d_re,
-                                  phy_struct->pdsch_d_im,
-                                  &M_symb);
-                layer_mapper_dl(phy_struct->pdsch_d_re,
-                                phy_struct->pdsch_d_im,
-                                M_symb,
-                                N_ant,
-                                1,
-                                pdcch->alloc[alloc_idx].pre_coder_type,
-                                phy_struct->pdsch_x_re,
-                                phy_struct->pdsch_x_im,
-                                &M_layer_symb);
-                pre_coder_dl(phy_struct->pdsch_x_re,
-                             phy_struct->pdsch_x_im,
-                             M_layer_symb,
-                             N_ant,
-                             pdcch->alloc[alloc_idx].pre_coder_type,
-                             phy_struct->pdsch_y_re[0],
-                             phy_struct->pdsch_y_im[0],
-                             5000,
-                             &M_ap_symb);
-
-                // Map the symbols to resource elements 3GPP TS 36.211 v10.1.0 section 6.3.5
-                for(p=0; p<N_ant; p++)
+                N_bits_tot += get_num_bits_in_prb(subframe->num,
+                                                  N_pdcch_symbs,
+                                                  alloc->prb[0][i],
+                                                  phy_struct->N_rb_dl,
+                                                  N_ant,
+                                                  alloc->mod_type);
+            }
+            // Encode the PDSCH
+            dlsch_channel_encode(phy_struct,
+                                 alloc->msg.msg,
+                                 alloc->msg.N_bits,
+                                 alloc->tbs,
+                                 alloc->tx_mode,
+                                 alloc->rv_idx,
+                                 N_bits_tot,
+                                 2,
+                                 2,
+                                 8,
+                                 250368,
+                                 phy_struct->pdsch_encode_bits,
+                                 &N_bits);
+            // FIXME: Only handling 1 codeword
+            c_init = (alloc->rnti << 14) | (0 << 13) | (subframe->num << 9) | N_id_cell;
+            generate_prs_c(c_init, N_bits, phy_struct->pdsch_c);
+            for(i=0; i<N_bits; i++)
+            {
+                phy_struct->pdsch_scramb_bits[i] = phy_struct->pdsch_encode_bits[i] ^ phy_struct->pdsch_c[i];
+            }
+            modulation_mapper(phy_struct->pdsch_scramb_bits,
+                              N_bits,
+                              alloc->mod_type,
+                              phy_struct->pdsch_d_re,
+                              phy_struct->pdsch_d_im,
+                              &M_symb);
+            layer_mapper_dl(phy_struct->pdsch_d_re,
+                            phy_struct->pdsch_d_im,
+                            M_symb,
+                            N_ant,
+                            1,
+                            alloc->pre_coder_type,
+                            phy_struct->pdsch_x_re,
+                            phy_struct->pdsch_x_im,
+                            &M_layer_symb);
+            pre_coder_dl(phy_struct->pdsch_x_re,
+                         phy_struct->pdsch_x_im,
+                         M_layer_symb,
+                         N_ant,
+                         alloc->pre_coder_type,
+                         phy_struct->pdsch_y_re[0],
+                         phy_struct->pdsch_y_im[0],
+                         5000,
+                         &M_ap_symb);
+
+            // Map the symbols to resource elements 3GPP TS 36.211 v10.1.0 section 6.3.5
+            for(p=0; p<N_ant; p++)
+            {
+                idx = 0;
+                for(L=N_pdcch_symbs; L<14; L++)
                 {
-                    idx = 0;
-                    for(L=pdcch->N_symbs; L<14; L++)
+                    for(prb_idx=0; prb_idx<alloc->N_prb; prb_idx++)
                     {
-                        for(prb_idx=0; prb_idx<pdcch->alloc[alloc_idx].N_prb; prb_idx++)
+                        i = alloc->prb[L/7][prb_idx];
+                        for(j=0; j<phy_struct->N_sc_rb_dl; j++)
                         {
-                            i = pdcch->alloc[alloc_idx].prb[L/7][prb_idx];
-                            for(j=0; j<phy_struct->N_sc_rb_dl; j++)
+                            if(N_ant           == 1 &&
+                               (L % 7)         == 0 &&
+                               (N_id_cell % 6) == (j % 6))
                             {
-                                if(N_ant           == 1 &&
-                                   (L % 7)         == 0 &&
-                                   (N_id_cell % 6) == (j % 6))
-                                {
-                                    // Skip CRS
-                                }else if(N_ant               == 1 &&
-                                         (L % 7)             == 4 &&
-                                         ((N_id_cell+3) % 6) == (j % 6)){
-                                    // Skip CRS
-                                }else if((N_ant          == 2  ||
-                                          N_ant          == 4) &&
-                                         ((L % 7)        == 0  ||
-                                          (L % 7)        == 4) &&
-                                         (N_id_cell % 3) == (j % 3)){
-                                    // Skip CRS
-                                }else if(N_ant           == 4 &&
-                                         (L % 7)         == 1 &&
-                                         (N_id_cell % 3) == (j % 3)){
-                                    // Skip CRS
-                                }else if(subframe->num                == 0        &&
-                                         (i*phy_struct->N_sc_rb_dl+j) >= first_sc &&
-                                         (i*phy_struct->N_sc_rb_dl+j) <= last_sc  &&
-                                         L                            >= 7        &&
-                                         L                            <= 10){
-                                    // Skip PBCH
-                                }else if((subframe->num               == 0        ||
-                                          subframe->num               == 5)       &&
-                                         (i*phy_struct->N_sc_rb_dl+j) >= first_sc &&
-                                         (i*phy_struct->N_sc_rb_dl+j) <= last_sc  &&
-                                         L                            == 6){
-                                    // Skip PSS
-                                }else if((subframe->num               == 0        ||
-                                          subframe->num               == 5)       &&
-                                         (i*phy_struct->N_sc_rb_dl+j) >= first_sc &&
-                                         (i*phy_struct->N_sc_rb_dl+j) <= last_sc  &&
-                                         L                            == 5){
-                                    // Skip SSS
-                                }else{
-                                    subframe->tx_symb_re[p][L][i*phy_struct->N_sc_rb_dl+j] = phy_struct->pdsch_y_re[p][idx];
-                                    subframe->tx_symb_im[p][L][i*phy_struct->N_sc_rb_dl+j] = phy_struct->pdsch_y_im[p][idx];
-                                    idx++;
-                                }
+                                // Skip CRS
+                            }else if(N_ant               == 1 &&
+                                     (L % 7)             == 4 &&
+                                     ((N_id_cell+3) % 6) == (j % 6)){
+                                // Skip CRS
+                            }else if((N_ant          == 2  ||
+                                      N_ant          == 4) &&
+                                     ((L % 7)        == 0  ||
+                                      (L % 7)        == 4) &&
+                                     (N_id_cell % 3) == (j % 3)){
+                                // Skip CRS
+                            }else if(N_ant           == 4 &&
+                                     (L % 7)         == 1 &&
+                                     (N_id_cell % 3) == (j % 3)){
+                                // Skip CRS
+                            }else if(subframe->num                == 0        &&
+                                     (i*phy_struct->N_sc_rb_dl+j) >= first_sc &&
+                                     (i*phy_struct->N_sc_rb_dl+j) <= last_sc  &&
+                                     L                            >= 7        &&
+                                     L                            <= 10){
+                                // Skip PBCH
+                            }else if((subframe->num               == 0        ||
+                                      subframe->num               == 5)       &&
+                                     (i*phy_struct->N_sc_rb_dl+j) >= first_sc &&
+                                     (i*phy_struct->N_sc_rb_dl+j) <= last_sc  &&
+                                     L                            == 6){
+                                // Skip PSS
+                            }else if((subframe->num               == 0        ||
+                                      subframe->num               == 5)       &&
+                                     (i*phy_struct->N_sc_rb_dl+j) >= first_sc &&
+                                     (i*phy_struct->N_sc_rb_dl+j) <= last_sc  &&
+                                     L                            == 5){
+                                // Skip SSS
+                            }else{
+                                subframe->tx_symb_re[p][L][i*phy_struct->N_sc_rb_dl+j] = phy_struct->pdsch_y_re[p][idx];
+                                subframe->tx_symb_im[p][L][i*phy_struct->N_sc_rb_dl+j] = phy_struct->pdsch_y_im[p][idx];
+                                idx++;
                             }
                         }
                     }
@@ -3376,6 +3505,44 @@ LIBLTE_ERROR_ENUM liblte_phy_pdsch_channel_encode(LIBLTE_PHY_STRUCT          *ph
     return(err);
 }
 
+/*********************************************************************
+    Name: liblte_phy_pdsch_channel_encode
+
+    Description: Encodes and modulates the Physical Downlink Shared
+                 Channel
+
+    Document Reference: 3GPP TS 36.211 v10.1.0 sections 6.3 and 6.4
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_pdsch_channel_encode(LIBLTE_PHY_STRUCT          *phy_struct,
+                                                  LIBLTE_PHY_PDCCH_STRUCT    *pdcch,
+                                                  uint32                      N_id_cell,
+                                                  uint8                       N_ant,
+                                                  LIBLTE_PHY_SUBFRAME_STRUCT *subframe)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            alloc_idx;
+
+    if(phy_struct != NULL &&
+       pdcch      != NULL &&
+       N_id_cell  >= 0    &&
+       N_id_cell  <= 503  &&
+       subframe   != NULL)
+    {
+        for(alloc_idx=0; alloc_idx<pdcch->N_alloc; alloc_idx++)
+        {
+            liblte_phy_pdsch_channel_encode_alloc(phy_struct,
+                                                  &pdcch->alloc[alloc_idx],
+                                                  pdcch->N_symbs,
+                                                  N_id_cell,
+                                                  N_ant,
+                                                  subframe);
+        }
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
 /*********************************************************************
     Name: liblte_phy_pdsch_channel_decode
 
@@ -6150,6 +6317,598 @@ LIBLTE_ERROR_ENUM liblte_phy_get_n_cce(LIBLTE_PHY_STRUCT *phy_struct,
     *N_cce = N_reg_pdcch/N_reg_cce;
 }
 
+/*********************************************************************
+    Name: liblte_phy_nco_init
+
+    Description: Initializes a numerically controlled oscillator that
+                 removes a frequency offset from I/Q samples.
+
+    Document Reference: N/A
+
+    Notes: The phase is kept for LIBLTE_PHY_NCO_N_LANES consecutive
+           samples so that the rotation can be done in SIMD lanes,
+           lanes are renormalized every LIBLTE_PHY_NCO_RENORM_N_BLOCKS
+           blocks to stop the magnitude from drifting.
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_nco_init(LIBLTE_PHY_NCO_STRUCT *nco,
+                                      uint32                 fs,
+                                      float                  freq_offset)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+
+    if(nco != NULL &&
+       fs  != 0)
+    {
+        nco->fs          = fs;
+        nco->freq_offset = freq_offset;
+        nco->N_blocks    = 0;
+        nco_set_lanes(nco, 1, 0);
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_nco_set_freq_offset
+
+    Description: Changes the frequency offset removed by an NCO
+                 without disturbing its phase.
+
+    Document Reference: N/A
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_nco_set_freq_offset(LIBLTE_PHY_NCO_STRUCT *nco,
+                                                 float                  freq_offset)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+
+    if(nco != NULL)
+    {
+        nco->freq_offset = freq_offset;
+        nco_set_lanes(nco, nco->phase_re[0], nco->phase_im[0]);
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_nco_seek
+
+    Description: Moves the phase of an NCO forward, or backward for a
+                 negative number of samples, without rotating any
+                 samples.
+
+    Document Reference: N/A
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_nco_seek(LIBLTE_PHY_NCO_STRUCT *nco,
+                                      int32                  N_samps)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    double            theta;
+
+    if(nco != NULL)
+    {
+        theta = -2*M_PI*(double)nco->freq_offset*(double)N_samps/(double)nco->fs;
+        nco_set_lanes(nco,
+                      nco->phase_re[0]*cos(theta) - nco->phase_im[0]*sin(theta),
+                      nco->phase_re[0]*sin(theta) + nco->phase_im[0]*cos(theta));
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_nco_rotate
+
+    Description: Removes the frequency offset of an NCO from I/Q
+                 samples in place and advances its phase.
+
+    Document Reference: N/A
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_nco_rotate(LIBLTE_PHY_NCO_STRUCT *nco,
+                                        float                 *i_buf,
+                                        float                 *q_buf,
+                                        uint32                 N_samps)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    float             tmp_re[LIBLTE_PHY_NCO_N_LANES];
+    float             tmp_im[LIBLTE_PHY_NCO_N_LANES];
+    float             x_re;
+    float             x_im;
+    float             mag;
+    uint32            i;
+    uint32            j;
+    uint32            k;
+    uint32            N_blocks;
+    uint32            N_run;
+    uint32            N_tail;
+#ifdef __SSE__
+    __m128            p_re;
+    __m128            p_im;
+    __m128            s_re;
+    __m128            s_im;
+    __m128            v_re;
+    __m128            v_im;
+    __m128            tmp;
+#endif
+
+    if(nco   != NULL &&
+       i_buf != NULL &&
+       q_buf != NULL)
+    {
+        N_blocks = N_samps/LIBLTE_PHY_NCO_N_LANES;
+        N_tail   = N_samps%LIBLTE_PHY_NCO_N_LANES;
+        i        = 0;
+        while(i < N_blocks)
+        {
+            // Rotate up to the next renormalization
+            N_run = LIBLTE_PHY_NCO_RENORM_N_BLOCKS - nco->N_blocks;
+            if(N_run > (N_blocks - i))
+            {
+                N_run = N_blocks - i;
+            }
+#ifdef __SSE__
+            p_re = _mm_loadu_ps(nco->phase_re);
+            p_im = _mm_loadu_ps(nco->phase_im);
+            s_re = _mm_set1_ps(nco->step_re);
+            s_im = _mm_set1_ps(nco->step_im);
+            for(j=i; j<(i+N_run); j++)
+            {
+                v_re = _mm_loadu_ps(&i_buf[j*LIBLTE_PHY_NCO_N_LANES]);
+                v_im = _mm_loadu_ps(&q_buf[j*LIBLTE_PHY_NCO_N_LANES]);
+                _mm_storeu_ps(&i_buf[j*LIBLTE_PHY_NCO_N_LANES],
+                              _mm_sub_ps(_mm_mul_ps(v_re, p_re), _mm_mul_ps(v_im, p_im)));
+                _mm_storeu_ps(&q_buf[j*LIBLTE_PHY_NCO_N_LANES],
+                              _mm_add_ps(_mm_mul_ps(v_im, p_re), _mm_mul_ps(v_re, p_im)));
+                tmp  = _mm_sub_ps(_mm_mul_ps(p_re, s_re), _mm_mul_ps(p_im, s_im));
+                p_im = _mm_add_ps(_mm_mul_ps(p_re, s_im), _mm_mul_ps(p_im, s_re));
+                p_re = tmp;
+            }
+            _mm_storeu_ps(nco->phase_re, p_re);
+            _mm_storeu_ps(nco->phase_im, p_im);
+#else
+            for(j=i; j<(i+N_run); j++)
+            {
+                for(k=0; k<LIBLTE_PHY_NCO_N_LANES; k++)
+                {
+                    x_re                              = i_buf[j*LIBLTE_PHY_NCO_N_LANES+k];
+                    x_im                              = q_buf[j*LIBLTE_PHY_NCO_N_LANES+k];
+                    i_buf[j*LIBLTE_PHY_NCO_N_LANES+k] = x_re*nco->phase_re[k] - x_im*nco->phase_im[k];
+                    q_buf[j*LIBLTE_PHY_NCO_N_LANES+k] = x_im*nco->phase_re[k] + x_re*nco->phase_im[k];
+                    tmp_re[k]                         = nco->phase_re[k]*nco->step_re - nco->phase_im[k]*nco->step_im;
+                    nco->phase_im[k]                  = nco->phase_re[k]*nco->step_im + nco->phase_im[k]*nco->step_re;
+                    nco->phase_re[k]                  = tmp_re[k];
+                }
+            }
+#endif
+            i             += N_run;
+            nco->N_blocks += N_run;
+            if(LIBLTE_PHY_NCO_RENORM_N_BLOCKS == nco->N_blocks)
+            {
+                for(k=0; k<LIBLTE_PHY_NCO_N_LANES; k++)
+                {
+                    mag               = sqrtf(nco->phase_re[k]*nco->phase_re[k] + nco->phase_im[k]*nco->phase_im[k]);
+                    nco->phase_re[k] /= mag;
+                    nco->phase_im[k] /= mag;
+                }
+                nco->N_blocks = 0;
+            }
+        }
+
+        // Remaining samples use the first lanes, the lanes are then moved
+        // along so that lane 0 holds the phase of the next sample
+        if(0 != N_tail)
+        {
+            for(k=0; k<N_tail; k++)
+            {
+                x_re                                     = i_buf[N_blocks*LIBLTE_PHY_NCO_N_LANES+k];
+                x_im                                     = q_buf[N_blocks*LIBLTE_PHY_NCO_N_LANES+k];
+                i_buf[N_blocks*LIBLTE_PHY_NCO_N_LANES+k] = x_re*nco->phase_re[k] - x_im*nco->phase_im[k];
+                q_buf[N_blocks*LIBLTE_PHY_NCO_N_LANES+k] = x_im*nco->phase_re[k] + x_re*nco->phase_im[k];
+            }
+            for(k=0; k<LIBLTE_PHY_NCO_N_LANES; k++)
+            {
+                if((k + N_tail) < LIBLTE_PHY_NCO_N_LANES)
+                {
+                    tmp_re[k] = nco->phase_re[k+N_tail];
+                    tmp_im[k] = nco->phase_im[k+N_tail];
+                }else{
+                    j         = k + N_tail - LIBLTE_PHY_NCO_N_LANES;
+                    tmp_re[k] = nco->phase_re[j]*nco->step_re - nco->phase_im[j]*nco->step_im;
+                    tmp_im[k] = nco->phase_re[j]*nco->step_im + nco->phase_im[j]*nco->step_re;
+                }
+            }
+            for(k=0; k<LIBLTE_PHY_NCO_N_LANES; k++)
+            {
+                nco->phase_re[k] = tmp_re[k];
+                nco->phase_im[k] = tmp_im[k];
+            }
+        }
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_resamp_init
+
+    Description: Initializes a polyphase rational resampler that
+                 changes the sample rate of I/Q samples by
+                 interp/decim.
+
+    Document Reference: N/A
+
+    Notes: The taps are designed for the interpolated rate, as for
+           GNU Radio's rational_resampler_base, and are split into
+           one bank per phase with each bank padded to a multiple of
+           LIBLTE_PHY_RESAMP_N_LANES taps.  If taps is NULL a
+           Blackman windowed low pass filter with
+           LIBLTE_PHY_RESAMP_N_TAPS_PER_SAMP taps per sample at the
+           slower of the two rates is designed.  interp and decim
+           must be reduced to lowest terms and not be more than
+           LIBLTE_PHY_RESAMP_MAX_FACTOR.
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_resamp_init(LIBLTE_PHY_RESAMP_STRUCT **resamp,
+                                         uint32                     interp,
+                                         uint32                     decim,
+                                         float                     *taps,
+                                         uint32                     N_taps)
+{
+    LIBLTE_ERROR_ENUM  err = LIBLTE_ERROR_INVALID_INPUTS;
+    float             *proto_taps;
+    double             fc;
+    double             x;
+    double             sum;
+    uint32             N_proto_taps;
+    uint32             N_taps_per_phase;
+    uint32             i;
+    uint32             p;
+    uint32             k;
+
+    if(resamp != NULL                         &&
+       interp != 0                            &&
+       decim  != 0                            &&
+       interp <= LIBLTE_PHY_RESAMP_MAX_FACTOR &&
+       decim  <= LIBLTE_PHY_RESAMP_MAX_FACTOR &&
+       (taps  == NULL ||
+        N_taps != 0))
+    {
+        // Design the prototype filter, cutting off at half of the slower
+        // of the input and output rates with unity gain after decimation
+        if(taps == NULL)
+        {
+            if(interp > decim)
+            {
+                N_proto_taps = LIBLTE_PHY_RESAMP_N_TAPS_PER_SAMP*interp + 1;
+                fc           = 0.5/(double)interp;
+            }else{
+                N_proto_taps = LIBLTE_PHY_RESAMP_N_TAPS_PER_SAMP*decim + 1;
+                fc           = 0.5/(double)decim;
+            }
+            proto_taps = (float *)malloc(N_proto_taps*sizeof(float));
+            sum        = 0;
+            for(i=0; i<N_proto_taps; i++)
+            {
+                x = (double)i - (double)(N_proto_taps - 1)/2;
+                if(x == 0)
+                {
+                    proto_taps[i] = 2*fc;
+                }else{
+                    proto_taps[i] = sin(2*M_PI*fc*x)/(M_PI*x);
+                }
+                proto_taps[i] *= (0.42 -
+                                  0.5*cos(2*M_PI*i/(N_proto_taps - 1)) +
+                                  0.08*cos(4*M_PI*i/(N_proto_taps - 1)));
+                sum           += proto_taps[i];
+            }
+            for(i=0; i<N_proto_taps; i++)
+            {
+                proto_taps[i] *= interp/sum;
+            }
+        }else{
+            proto_taps   = taps;
+            N_proto_taps = N_taps;
+        }
+
+        // Split the prototype filter into one bank per phase, each bank is
+        // reversed so that it lines up with the oldest sample first and any
+        // padding falls on the samples that are too old to be used
+        N_taps_per_phase  = (N_proto_taps + interp - 1)/interp;
+        N_taps_per_phase += (LIBLTE_PHY_RESAMP_N_LANES - (N_taps_per_phase % LIBLTE_PHY_RESAMP_N_LANES)) % LIBLTE_PHY_RESAMP_N_LANES;
+        *resamp                     = (LIBLTE_PHY_RESAMP_STRUCT *)malloc(sizeof(LIBLTE_PHY_RESAMP_STRUCT));
+        (*resamp)->taps             = (float *)calloc(interp*N_taps_per_phase, sizeof(float));
+        (*resamp)->hist_i_buf       = (float *)calloc(2*N_taps_per_phase - 1, sizeof(float));
+        (*resamp)->hist_q_buf       = (float *)calloc(2*N_taps_per_phase - 1, sizeof(float));
+        (*resamp)->interp           = interp;
+        (*resamp)->decim            = decim;
+        (*resamp)->N_taps_per_phase = N_taps_per_phase;
+        (*resamp)->phase            = 0;
+        (*resamp)->next_in_idx      = N_taps_per_phase;
+        (*resamp)->taps_shared      = false;
+        for(p=0; p<interp; p++)
+        {
+            for(k=0; (p + k*interp)<N_proto_taps; k++)
+            {
+                (*resamp)->taps[p*N_taps_per_phase + N_taps_per_phase - 1 - k] = proto_taps[p + k*interp];
+            }
+        }
+
+        if(taps == NULL)
+        {
+            free(proto_taps);
+        }
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_resamp_init_shared
+
+    Description: Initializes a polyphase rational resampler that uses
+                 the taps of an existing one and keeps its own history
+                 and phase.
+
+    Document Reference: N/A
+
+    Notes: proto must not be cleaned up before the new resampler.
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_resamp_init_shared(LIBLTE_PHY_RESAMP_STRUCT **resamp,
+                                                LIBLTE_PHY_RESAMP_STRUCT  *proto)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            N_taps_per_phase;
+
+    if(resamp != NULL &&
+       proto  != NULL)
+    {
+        N_taps_per_phase            = proto->N_taps_per_phase;
+        *resamp                     = (LIBLTE_PHY_RESAMP_STRUCT *)malloc(sizeof(LIBLTE_PHY_RESAMP_STRUCT));
+        (*resamp)->taps             = proto->taps;
+        (*resamp)->hist_i_buf       = (float *)calloc(2*N_taps_per_phase - 1, sizeof(float));
+        (*resamp)->hist_q_buf       = (float *)calloc(2*N_taps_per_phase - 1, sizeof(float));
+        (*resamp)->interp           = proto->interp;
+        (*resamp)->decim            = proto->decim;
+        (*resamp)->N_taps_per_phase = N_taps_per_phase;
+        (*resamp)->phase            = 0;
+        (*resamp)->next_in_idx      = N_taps_per_phase;
+        (*resamp)->taps_shared      = true;
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_resamp_cleanup
+
+    Description: Frees a polyphase rational resampler.
+
+    Document Reference: N/A
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_resamp_cleanup(LIBLTE_PHY_RESAMP_STRUCT *resamp)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+
+    if(resamp != NULL)
+    {
+        if(!resamp->taps_shared)
+        {
+            free(resamp->taps);
+        }
+        free(resamp->hist_i_buf);
+        free(resamp->hist_q_buf);
+        free(resamp);
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_resamp_reset
+
+    Description: Clears the history of a polyphase rational resampler
+                 and positions it so that the next output sample is
+                 out_idx samples into the output stream.
+
+    Document Reference: N/A
+
+    Notes: in_idx is the index of the first input sample that must
+           be passed to liblte_phy_resamp_run, the samples before
+           the first output fill the history.
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_resamp_reset(LIBLTE_PHY_RESAMP_STRUCT *resamp,
+                                          uint64                    out_idx,
+                                          uint64                   *in_idx)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint64            newest_in_idx;
+    uint32            N_taps;
+
+    if(resamp != NULL &&
+       in_idx != NULL)
+    {
+        N_taps = resamp->N_taps_per_phase;
+        memset(resamp->hist_i_buf, 0, (2*N_taps - 1)*sizeof(float));
+        memset(resamp->hist_q_buf, 0, (2*N_taps - 1)*sizeof(float));
+
+        // Output out_idx uses input samples up to newest_in_idx, the
+        // history starts empty at the beginning of the stream
+        newest_in_idx = (out_idx*resamp->decim)/resamp->interp;
+        resamp->phase = (out_idx*resamp->decim)%resamp->interp;
+        if(newest_in_idx >= (N_taps - 1))
+        {
+            *in_idx             = newest_in_idx - (N_taps - 1);
+            resamp->next_in_idx = 2*N_taps - 1;
+        }else{
+            *in_idx             = 0;
+            resamp->next_in_idx = N_taps + newest_in_idx;
+        }
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_resamp_get_n_in
+
+    Description: Determines the number of input samples needed for a
+                 polyphase rational resampler to produce N_out output
+                 samples.
+
+    Document Reference: N/A
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_resamp_get_n_in(LIBLTE_PHY_RESAMP_STRUCT *resamp,
+                                             uint32                    N_out,
+                                             uint32                   *N_in)
+{
+    LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
+    uint64            newest_in_idx;
+
+    if(resamp != NULL &&
+       N_in   != NULL)
+    {
+        *N_in = 0;
+        if(0 != N_out)
+        {
+            newest_in_idx = resamp->next_in_idx + (resamp->phase + (uint64)(N_out - 1)*resamp->decim)/resamp->interp;
+            if(newest_in_idx >= resamp->N_taps_per_phase)
+            {
+                *N_in = newest_in_idx - resamp->N_taps_per_phase + 1;
+            }
+        }
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
+/*********************************************************************
+    Name: liblte_phy_resamp_run
+
+    Description: Resamples a block of I/Q samples, the history is kept
+                 so that consecutive blocks form one stream.
+
+    Document Reference: N/A
+
+    Notes: All input samples are consumed and at most N_out_max
+           output samples are produced, N_in must not be more than
+           liblte_phy_resamp_get_n_in gives for N_out_max.
+*********************************************************************/
+LIBLTE_ERROR_ENUM liblte_phy_resamp_run(LIBLTE_PHY_RESAMP_STRUCT *resamp,
+                                        float                    *i_in,
+                                        float                    *q_in,
+                                        uint32                    N_in,
+                                        float                    *i_out,
+                                        float                    *q_out,
+                                        uint32                    N_out_max,
+                                        uint32                   *N_out)
+{
+    LIBLTE_ERROR_ENUM  err = LIBLTE_ERROR_INVALID_INPUTS;
+    float             *taps;
+    float             *i_buf;
+    float             *q_buf;
+    uint32             N_taps;
+    uint32             N_stage;
+    uint32             N;
+    uint32             in_idx;
+    uint32             interp;
+    uint32             phase;
+    uint32             decim_int;
+    uint32             decim_frac;
+    uint32             wrap;
+
+    if(resamp != NULL &&
+       i_in   != NULL &&
+       q_in   != NULL &&
+       i_out  != NULL &&
+       q_out  != NULL &&
+       N_out  != NULL)
+    {
+        // The history is followed by the start of the input so that the
+        // outputs that straddle the two can be filtered in one piece,
+        // in_idx is the newest sample of the next output counting from
+        // the start of the history
+        N_taps     = resamp->N_taps_per_phase;
+        decim_int  = resamp->decim/resamp->interp;
+        decim_frac = resamp->decim%resamp->interp;
+        N_stage    = N_in;
+        if(N_stage > (N_taps - 1))
+        {
+            N_stage = N_taps - 1;
+        }
+        memcpy(&resamp->hist_i_buf[N_taps], i_in, N_stage*sizeof(float));
+        memcpy(&resamp->hist_q_buf[N_taps], q_in, N_stage*sizeof(float));
+
+        // Work on local copies of the state so that it is not reloaded
+        // after every output sample is stored
+        taps   = resamp->taps;
+        interp = resamp->interp;
+        phase  = resamp->phase;
+        in_idx = resamp->next_in_idx;
+        N      = 0;
+        while(in_idx < (N_taps + N_in) &&
+              N      < N_out_max)
+        {
+            if(in_idx < (2*N_taps - 1))
+            {
+                i_buf = &resamp->hist_i_buf[in_idx - N_taps + 1];
+                q_buf = &resamp->hist_q_buf[in_idx - N_taps + 1];
+            }else{
+                i_buf = &i_in[in_idx - 2*N_taps + 1];
+                q_buf = &q_in[in_idx - 2*N_taps + 1];
+            }
+            resamp_filter(&taps[phase*N_taps],
+                          i_buf,
+                          q_buf,
+                          N_taps,
+                          &i_out[N],
+                          &q_out[N]);
+            N++;
+
+            // Step through the phases, moving to the next input sample
+            // each time the phase wraps
+            wrap    = (phase + decim_frac) >= interp;
+            in_idx += decim_int + wrap;
+            phase  += decim_frac - wrap*interp;
+        }
+        resamp->phase       = phase;
+        *N_out              = N;
+        resamp->next_in_idx = in_idx - N_in;
+
+        // Keep the newest samples for the next block, one more than the
+        // filter needs so that an output that has not been produced yet
+        // can still use the last input sample
+        if(N_in >= N_taps)
+        {
+            memcpy(resamp->hist_i_buf, &i_in[N_in - N_taps], N_taps*sizeof(float));
+            memcpy(resamp->hist_q_buf, &q_in[N_in - N_taps], N_taps*sizeof(float));
+        }else{
+            memmove(resamp->hist_i_buf, &resamp->hist_i_buf[N_in], N_taps*sizeof(float));
+            memmove(resamp->hist_q_buf, &resamp->hist_q_buf[N_in], N_taps*sizeof(float));
+        }
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
+
 /*******************************************************************************
                               LOCAL FUNCTIONS
 *******************************************************************************/
@@ -7692,12 +8451,12 @@ void phich_channel_map(LIBLTE_PHY_STRUCT              *phy_struct,
                 }
             }
             // Step 5
-            y_idx = 0;
             for(i=0; i<3; i++)
             {
                 phich->k[idx+i] = n_hat[i]*6;
                 for(p=0; p<N_ant; p++)
                 {
+                    y_idx = i*4;
                     for(j=0; j<6; j++)
                     {
                         if((N_id_cell % 3) != (j % 3))
@@ -13461,3 +14220,82 @@ inline void wrap_phase(float *phase_1,
         *phase_1 = *phase_1 + 2*M_PI;
     }
 }
+
+/*********************************************************************
+    Name: nco_set_lanes
+
+    Description: Sets the NCO lane phases and step from the phase of
+                 the next sample.
+
+    Document Reference: N/A
+*********************************************************************/
+void nco_set_lanes(LIBLTE_PHY_NCO_STRUCT *nco,
+                   double                 phase_re,
+                   double                 phase_im)
+{
+    double theta;
+    double mag;
+    uint32 k;
+
+    // Each lane is one sample further along than the previous one and
+    // every lane steps over LIBLTE_PHY_NCO_N_LANES samples at a time
+    theta = -2*M_PI*(double)nco->freq_offset/(double)nco->fs;
+    mag   = sqrt(phase_re*phase_re + phase_im*phase_im);
+    for(k=0; k<LIBLTE_PHY_NCO_N_LANES; k++)
+    {
+        nco->phase_re[k] = (phase_re*cos(k*theta) - phase_im*sin(k*theta))/mag;
+        nco->phase_im[k] = (phase_re*sin(k*theta) + phase_im*cos(k*theta))/mag;
+    }
+    nco->step_re = cos(LIBLTE_PHY_NCO_N_LANES*theta);
+    nco->step_im = sin(LIBLTE_PHY_NCO_N_LANES*theta);
+}
+
+/*********************************************************************
+    Name: resamp_filter
+
+    Description: Filters I/Q samples with one phase of a polyphase
+                 rational resampler to produce one output sample.
+
+    Document Reference: N/A
+*********************************************************************/
+void resamp_filter(float  *taps,
+                   float  *i_buf,
+                   float  *q_buf,
+                   uint32  N_taps,
+                   float  *i_out,
+                   float  *q_out)
+{
+    uint32 i;
+#ifdef __SSE__
+    __m128 t;
+    __m128 acc_i = _mm_setzero_ps();
+    __m128 acc_q = _mm_setzero_ps();
+    __m128 sum;
+
+    // Real taps applied to the I and Q lanes, N_taps is always a multiple
+    // of LIBLTE_PHY_RESAMP_N_LANES
+    for(i=0; i<N_taps; i+=LIBLTE_PHY_RESAMP_N_LANES)
+    {
+        t     = _mm_loadu_ps(&taps[i]);
+        acc_i = _mm_add_ps(acc_i, _mm_mul_ps(t, _mm_loadu_ps(&i_buf[i])));
+        acc_q = _mm_add_ps(acc_q, _mm_mul_ps(t, _mm_loadu_ps(&q_buf[i])));
+    }
+
+    // Sum the I and Q lanes together, leaving I in lane 0 and Q in lane 1
+    sum = _mm_add_ps(_mm_unpacklo_ps(acc_i, acc_q), _mm_unpackhi_ps(acc_i, acc_q));
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    _mm_store_ss(i_out, sum);
+    _mm_store_ss(q_out, _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(1, 1, 1, 1)));
+#else
+    float acc_i = 0;
+    float acc_q = 0;
+
+    for(i=0; i<N_taps; i++)
+    {
+        acc_i += taps[i]*i_buf[i];
+        acc_q += taps[i]*q_buf[i];
+    }
+    *i_out = acc_i;
+    *q_out = acc_q;
+#endif
+}
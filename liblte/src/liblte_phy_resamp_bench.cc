@@ -0,0 +1,297 @@
+/*******************************************************************************
+
+    Copyright 2026 agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: liblte_phy_resamp_bench.cc
+
+    Description: Contains all the implementations for the polyphase rational
+                 resampler throughput benchmark.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    agent            Created file
+
+*******************************************************************************/
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "liblte_phy.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+// One 20ms block at 25MHz, the USRP N series rate used by LTE_fdd_dl_scan
+#define N_SAMPS     (25000*20)
+#define N_LOOPS_MIN 16
+#define RUN_TIME_NS (500000000LL)
+#define N_CONFIGS   2
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+typedef struct{
+    const char *name;
+    uint32      interp;
+    uint32      decim;
+    uint32      N_taps;
+}RESAMP_BENCH_CONFIG_STRUCT;
+
+/*******************************************************************************
+                              GLOBAL VARIABLES
+*******************************************************************************/
+
+// The 25MHz to 15.36MHz tap count matches the firdes::low_pass design used
+// by LTE_fdd_dl_scan, the 30.72MHz one doubles it for the doubled interp
+RESAMP_BENCH_CONFIG_STRUCT configs[N_CONFIGS] = {{"25MHz to 15.36MHz", 384, 625, 1891},
+                                                 {"25MHz to 30.72MHz", 768, 625, 3781}};
+
+/*******************************************************************************
+                              FUNCTIONS
+*******************************************************************************/
+
+int64 get_time_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return((int64)ts.tv_sec*1000000000LL + ts.tv_nsec);
+}
+
+void print_result(const char *name,
+                  uint32      N_out,
+                  uint32      N_loops,
+                  int64       elapsed_ns)
+{
+    printf("\t\t%-10s %10.1f Msamps/s in %10.1f Msamps/s out\n",
+           name,
+           (double)N_SAMPS*N_loops*1000.0/(double)elapsed_ns,
+           (double)N_out*N_loops*1000.0/(double)elapsed_ns);
+}
+
+// Same structure as GNU Radio's rational_resampler_base_ccf, interleaved
+// samples with one dot product per output over the taps of its phase
+uint32 reference_run(float  *taps,
+                     uint32  interp,
+                     uint32  decim,
+                     uint32  N_taps_per_phase,
+                     float  *iq_in,
+                     uint32  N_in,
+                     float  *iq_out)
+{
+    float  *phase_taps;
+    float   acc_re;
+    float   acc_im;
+    uint32  ctr   = 0;
+    uint32  count = 0;
+    uint32  N_out = 0;
+    uint32  k;
+
+    while((count + N_taps_per_phase) <= N_in)
+    {
+        phase_taps = &taps[ctr*N_taps_per_phase];
+        acc_re     = 0;
+        acc_im     = 0;
+        for(k=0; k<N_taps_per_phase; k++)
+        {
+            acc_re += phase_taps[k]*iq_in[(count + k)*2];
+            acc_im += phase_taps[k]*iq_in[(count + k)*2 + 1];
+        }
+        iq_out[N_out*2]     = acc_re;
+        iq_out[N_out*2 + 1] = acc_im;
+        N_out++;
+
+        ctr += decim;
+        while(ctr >= interp)
+        {
+            ctr -= interp;
+            count++;
+        }
+    }
+
+    return(N_out);
+}
+
+int main(int argc, char *argv[])
+{
+    LIBLTE_PHY_RESAMP_STRUCT *resamp;
+    float                    *taps;
+    float                    *ref_taps;
+    float                    *i_in;
+    float                    *q_in;
+    float                    *i_out;
+    float                    *q_out;
+    float                    *iq_in;
+    float                    *iq_out;
+    double                    fc;
+    double                    x;
+    double                    err;
+    double                    max_err;
+    int64                     start_time;
+    int64                     elapsed_ns;
+    uint32                    N_ref_taps_per_phase;
+    uint32                    N_ref_hist;
+    uint32                    N_ref_out;
+    uint32                    N_out;
+    uint32                    N_out_max;
+    uint32                    N_loops;
+    uint32                    c;
+    uint32                    i;
+    uint32                    p;
+    uint32                    k;
+
+    i_in = (float *)malloc(N_SAMPS*sizeof(float));
+    q_in = (float *)malloc(N_SAMPS*sizeof(float));
+    for(i=0; i<N_SAMPS; i++)
+    {
+        i_in[i] = (float)((rand() % 2001) - 1000)/1000.0;
+        q_in[i] = (float)((rand() % 2001) - 1000)/1000.0;
+    }
+
+    printf("*** POLYPHASE RATIONAL RESAMPLER BENCHMARK ***\n");
+#ifdef __SSE__
+    printf("\tUsing SSE\n");
+#else
+    printf("\tUsing scalar\n");
+#endif
+    for(c=0; c<N_CONFIGS; c++)
+    {
+        // Blackman windowed low pass at the interpolated rate
+        taps = (float *)malloc(configs[c].N_taps*sizeof(float));
+        fc   = 0.5/(double)configs[c].decim;
+        for(i=0; i<configs[c].N_taps; i++)
+        {
+            x = (double)i - (double)(configs[c].N_taps - 1)/2;
+            if(x == 0)
+            {
+                taps[i] = 2*fc;
+            }else{
+                taps[i] = sin(2*M_PI*fc*x)/(M_PI*x);
+            }
+            taps[i] *= configs[c].interp*(0.42 -
+                                          0.5*cos(2*M_PI*i/(configs[c].N_taps - 1)) +
+                                          0.08*cos(4*M_PI*i/(configs[c].N_taps - 1)));
+        }
+        liblte_phy_resamp_init(&resamp, configs[c].interp, configs[c].decim, taps, configs[c].N_taps);
+
+        // Per phase taps for the reference, newest sample last
+        N_ref_taps_per_phase = (configs[c].N_taps + configs[c].interp - 1)/configs[c].interp;
+        ref_taps             = (float *)calloc(configs[c].interp*N_ref_taps_per_phase, sizeof(float));
+        for(p=0; p<configs[c].interp; p++)
+        {
+            for(k=0; (p + k*configs[c].interp)<configs[c].N_taps; k++)
+            {
+                ref_taps[p*N_ref_taps_per_phase + N_ref_taps_per_phase - 1 - k] = taps[p + k*configs[c].interp];
+            }
+        }
+
+        // Interleaved input for the reference, starting with an empty
+        // history as GNU Radio does
+        N_ref_hist = N_ref_taps_per_phase - 1;
+        iq_in      = (float *)calloc(2*(N_ref_hist + N_SAMPS), sizeof(float));
+        for(i=0; i<N_SAMPS; i++)
+        {
+            iq_in[(N_ref_hist + i)*2]     = i_in[i];
+            iq_in[(N_ref_hist + i)*2 + 1] = q_in[i];
+        }
+
+        N_out_max = ((uint64)N_SAMPS*configs[c].interp)/configs[c].decim + 1;
+        i_out     = (float *)malloc(N_out_max*sizeof(float));
+        q_out     = (float *)malloc(N_out_max*sizeof(float));
+        iq_out    = (float *)malloc(2*N_out_max*sizeof(float));
+
+        printf("\t%s, %u taps, %u and %u taps per phase\n",
+               configs[c].name,
+               configs[c].N_taps,
+               N_ref_taps_per_phase,
+               resamp->N_taps_per_phase);
+
+        // Reference
+        N_loops    = 0;
+        start_time = get_time_ns();
+        do
+        {
+            N_ref_out = reference_run(ref_taps,
+                                      configs[c].interp,
+                                      configs[c].decim,
+                                      N_ref_taps_per_phase,
+                                      iq_in,
+                                      N_ref_hist + N_SAMPS,
+                                      iq_out);
+            N_loops++;
+            elapsed_ns = get_time_ns() - start_time;
+        }while(N_loops    < N_LOOPS_MIN ||
+               elapsed_ns < RUN_TIME_NS);
+        print_result("reference", N_ref_out, N_loops, elapsed_ns);
+
+        // liblte, streaming the same block over and over
+        N_loops    = 0;
+        start_time = get_time_ns();
+        do
+        {
+            liblte_phy_resamp_run(resamp, i_in, q_in, N_SAMPS, i_out, q_out, N_out_max, &N_out);
+            N_loops++;
+            elapsed_ns = get_time_ns() - start_time;
+        }while(N_loops    < N_LOOPS_MIN ||
+               elapsed_ns < RUN_TIME_NS);
+        print_result("liblte", N_out, N_loops, elapsed_ns);
+
+        // Check the first block against the reference
+        liblte_phy_resamp_cleanup(resamp);
+        liblte_phy_resamp_init(&resamp, configs[c].interp, configs[c].decim, taps, configs[c].N_taps);
+        liblte_phy_resamp_run(resamp, i_in, q_in, N_SAMPS, i_out, q_out, N_out_max, &N_out);
+        N_ref_out = reference_run(ref_taps,
+                                  configs[c].interp,
+                                  configs[c].decim,
+                                  N_ref_taps_per_phase,
+                                  iq_in,
+                                  N_ref_hist + N_SAMPS,
+                                  iq_out);
+        max_err = 0;
+        for(i=0; i<N_out && i<N_ref_out; i++)
+        {
+            err = fabs(i_out[i] - iq_out[i*2]) + fabs(q_out[i] - iq_out[i*2 + 1]);
+            if(err > max_err)
+            {
+                max_err = err;
+            }
+        }
+        printf("\t\t%u and %u outputs, max difference %g\n", N_ref_out, N_out, max_err);
+
+        liblte_phy_resamp_cleanup(resamp);
+        free(taps);
+        free(ref_taps);
+        free(iq_in);
+        free(i_out);
+        free(q_out);
+        free(iq_out);
+    }
+
+    free(i_in);
+    free(q_in);
+
+    return(0);
+}
@@ -25,6 +25,9 @@
     Revision History
     ----------    -------------    --------------------------------------------
     06/15/2014    Ben Wojtowicz    Created file.
+    10/19/2026    agent            Implemented AMD PDU packing, AMD PDU
+                                   segments, and NACKs in STATUS PDUs.
+    10/19/2026    agent            Implemented UMD PDUs.
 
 *******************************************************************************/
 
@@ -70,6 +73,19 @@ void rlc_value_2_bits(uint32   value,
 uint32 rlc_bits_2_value(uint8  **bits,
                         uint32   N_bits);
 
+/*********************************************************************
+    Name: rlc_unpack_data_field
+
+    Description: Unpacks the length indicators of a UMD or AMD PDU and
+                 points one slice per (part of an) RLC SDU into the
+                 data field
+*********************************************************************/
+LIBLTE_ERROR_ENUM rlc_unpack_data_field(LIBLTE_BIT_MSG_STRUCT    *pdu,
+                                        uint8                   **pdu_ptr,
+                                        LIBLTE_RLC_E_FIELD_ENUM   e,
+                                        LIBLTE_RLC_SLICE_STRUCT  *slice,
+                                        uint32                   *N_slices);
+
 /*******************************************************************************
                               PDU FUNCTIONS
 *******************************************************************************/
@@ -79,7 +95,112 @@ uint32 rlc_bits_2_value(uint8  **bits,
 
     Document Reference: 36.322 v10.0.0 Section 6.2.1.3
 *********************************************************************/
-// FIXME
+LIBLTE_ERROR_ENUM liblte_rlc_pack_umd_pdu(LIBLTE_RLC_UMD_PDU_STRUCT *umd,
+                                          LIBLTE_BIT_MSG_STRUCT     *pdu)
+{
+    LIBLTE_ERROR_ENUM  err     = LIBLTE_ERROR_INVALID_INPUTS;
+    uint8             *pdu_ptr = pdu->msg;
+    uint32             N_bits  = 0;
+    uint32             i;
+
+    if(umd           != NULL                            &&
+       pdu           != NULL                            &&
+       umd->N_slices  > 0                               &&
+       umd->N_slices <= LIBLTE_RLC_UMD_PDU_MAX_N_SLICES)
+    {
+        // Check that the PDU fits and that every LI can be represented
+        err = LIBLTE_SUCCESS;
+        for(i=0; i<umd->N_slices; i++)
+        {
+            if(i                        != (umd->N_slices - 1) &&
+               (umd->slice[i].N_bits/8)  > LIBLTE_RLC_LI_FIELD_MAX_VALUE)
+            {
+                err = LIBLTE_ERROR_INVALID_INPUTS;
+            }
+            N_bits += umd->slice[i].N_bits;
+        }
+        if(LIBLTE_RLC_UMD_SN_SIZE_5_BITS == umd->hdr.sn_size)
+        {
+            N_bits += 8;
+        }else{
+            N_bits += 16;
+        }
+        N_bits += ((umd->N_slices - 1)*12) + (((umd->N_slices - 1) % 2)*4);
+        if(N_bits > LIBLTE_MAX_MSG_SIZE)
+        {
+            err = LIBLTE_ERROR_INVALID_INPUTS;
+        }
+
+        if(LIBLTE_SUCCESS == err)
+        {
+            // Header
+            if(LIBLTE_RLC_UMD_SN_SIZE_5_BITS == umd->hdr.sn_size)
+            {
+                rlc_value_2_bits(umd->hdr.fi, &pdu_ptr, 2);
+                rlc_value_2_bits((1 < umd->N_slices), &pdu_ptr, 1);
+                rlc_value_2_bits(umd->hdr.sn, &pdu_ptr, 5);
+            }else{
+                rlc_value_2_bits(0, &pdu_ptr, 3);
+                rlc_value_2_bits(umd->hdr.fi, &pdu_ptr, 2);
+                rlc_value_2_bits((1 < umd->N_slices), &pdu_ptr, 1);
+                rlc_value_2_bits(umd->hdr.sn, &pdu_ptr, 10);
+            }
+
+            // Length Indicators
+            for(i=0; i<(umd->N_slices - 1); i++)
+            {
+                rlc_value_2_bits(((i + 2) < umd->N_slices), &pdu_ptr, 1);
+                rlc_value_2_bits(umd->slice[i].N_bits/8, &pdu_ptr, 11);
+            }
+            if(0 != ((umd->N_slices - 1) % 2))
+            {
+                rlc_value_2_bits(0, &pdu_ptr, 4);
+            }
+
+            // Data
+            for(i=0; i<umd->N_slices; i++)
+            {
+                memcpy(pdu_ptr, umd->slice[i].msg, umd->slice[i].N_bits);
+                pdu_ptr += umd->slice[i].N_bits;
+            }
+
+            pdu->N_bits = pdu_ptr - pdu->msg;
+        }
+    }
+
+    return(err);
+}
+LIBLTE_ERROR_ENUM liblte_rlc_unpack_umd_pdu(LIBLTE_BIT_MSG_STRUCT       *pdu,
+                                            LIBLTE_RLC_UMD_SN_SIZE_ENUM  sn_size,
+                                            LIBLTE_RLC_UMD_PDU_STRUCT   *umd)
+{
+    LIBLTE_ERROR_ENUM        err     = LIBLTE_ERROR_INVALID_INPUTS;
+    uint8                   *pdu_ptr = pdu->msg;
+    LIBLTE_RLC_E_FIELD_ENUM  e;
+
+    if(pdu != NULL &&
+       umd != NULL)
+    {
+        // Header
+        umd->hdr.sn_size = sn_size;
+        if(LIBLTE_RLC_UMD_SN_SIZE_5_BITS == sn_size)
+        {
+            umd->hdr.fi = (LIBLTE_RLC_FI_FIELD_ENUM)rlc_bits_2_value(&pdu_ptr, 2);
+            e           = (LIBLTE_RLC_E_FIELD_ENUM)rlc_bits_2_value(&pdu_ptr, 1);
+            umd->hdr.sn = rlc_bits_2_value(&pdu_ptr, 5);
+        }else{
+            rlc_bits_2_value(&pdu_ptr, 3);
+            umd->hdr.fi = (LIBLTE_RLC_FI_FIELD_ENUM)rlc_bits_2_value(&pdu_ptr, 2);
+            e           = (LIBLTE_RLC_E_FIELD_ENUM)rlc_bits_2_value(&pdu_ptr, 1);
+            umd->hdr.sn = rlc_bits_2_value(&pdu_ptr, 10);
+        }
+
+        // Length Indicators and data
+        err = rlc_unpack_data_field(pdu, &pdu_ptr, e, umd->slice, &umd->N_slices);
+    }
+
+    return(err);
+}
 
 /*********************************************************************
     PDU Type: Acknowledged Mode Data PDU
@@ -89,7 +210,35 @@ uint32 rlc_bits_2_value(uint8  **bits,
 LIBLTE_ERROR_ENUM liblte_rlc_pack_amd_pdu(LIBLTE_RLC_AMD_PDU_STRUCT *amd,
                                           LIBLTE_BIT_MSG_STRUCT     *pdu)
 {
-    // FIXME
+    LIBLTE_ERROR_ENUM  err     = LIBLTE_ERROR_INVALID_INPUTS;
+    uint8             *pdu_ptr = pdu->msg;
+
+    if(amd != NULL &&
+       pdu != NULL)
+    {
+        // Header
+        rlc_value_2_bits(LIBLTE_RLC_DC_FIELD_DATA_PDU, &pdu_ptr, 1);
+        rlc_value_2_bits(amd->hdr.rf, &pdu_ptr, 1);
+        rlc_value_2_bits(amd->hdr.p, &pdu_ptr, 1);
+        rlc_value_2_bits(amd->hdr.fi, &pdu_ptr, 2);
+        rlc_value_2_bits(LIBLTE_RLC_E_FIELD_HEADER_NOT_EXTENDED, &pdu_ptr, 1);
+        rlc_value_2_bits(amd->hdr.sn, &pdu_ptr, 10);
+        if(LIBLTE_RLC_RF_FIELD_AMD_PDU_SEGMENT == amd->hdr.rf)
+        {
+            rlc_value_2_bits(amd->hdr.lsf, &pdu_ptr, 1);
+            rlc_value_2_bits(amd->hdr.so, &pdu_ptr, 15);
+        }
+
+        // Data
+        memcpy(pdu_ptr, amd->data.msg, amd->data.N_bits);
+        pdu_ptr += amd->data.N_bits;
+
+        pdu->N_bits = pdu_ptr - pdu->msg;
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
 }
 LIBLTE_ERROR_ENUM liblte_rlc_unpack_amd_pdu(LIBLTE_BIT_MSG_STRUCT     *pdu,
                                             LIBLTE_RLC_AMD_PDU_STRUCT *amd)
@@ -116,21 +265,21 @@ LIBLTE_ERROR_ENUM liblte_rlc_unpack_amd_pdu(LIBLTE_BIT_MSG_STRUCT     *pdu,
 
             if(LIBLTE_RLC_RF_FIELD_AMD_PDU_SEGMENT == amd->hdr.rf)
             {
-                // FIXME
-                printf("Not handling AMD PDU SEGMENTS\n");
+                amd->hdr.lsf = (LIBLTE_RLC_LSF_FIELD_ENUM)rlc_bits_2_value(&pdu_ptr, 1);
+                amd->hdr.so  = rlc_bits_2_value(&pdu_ptr, 15);
+            }else{
+                amd->hdr.lsf = LIBLTE_RLC_LSF_FIELD_LAST_SEGMENT;
+                amd->hdr.so  = 0;
             }
 
-            if(LIBLTE_RLC_E_FIELD_HEADER_EXTENDED == e)
+            // Length Indicators and data, the data field is also copied
+            // out whole for reassembly across AMD PDU segments
+            err = rlc_unpack_data_field(pdu, &pdu_ptr, e, amd->slice, &amd->N_slices);
+            if(LIBLTE_SUCCESS == err)
             {
-                // FIXME
-                printf("Not handling HEADER EXTENSION\n");
+                amd->data.N_bits = pdu->N_bits - (amd->slice[0].msg - pdu->msg);
+                memcpy(amd->data.msg, amd->slice[0].msg, amd->data.N_bits);
             }
-
-            // Data
-            amd->data.N_bits = pdu->N_bits - (pdu_ptr - pdu->msg);
-            memcpy(amd->data.msg, pdu_ptr, amd->data.N_bits);
-
-            err = LIBLTE_SUCCESS;
         }
     }
 
@@ -147,6 +296,7 @@ LIBLTE_ERROR_ENUM liblte_rlc_pack_status_pdu(LIBLTE_RLC_STATUS_PDU_STRUCT *statu
 {
     LIBLTE_ERROR_ENUM  err     = LIBLTE_ERROR_INVALID_INPUTS;
     uint8             *pdu_ptr = pdu->msg;
+    uint32             i;
 
     if(status != NULL &&
        pdu    != NULL)
@@ -161,10 +311,38 @@ LIBLTE_ERROR_ENUM liblte_rlc_pack_status_pdu(LIBLTE_RLC_STATUS_PDU_STRUCT *statu
         rlc_value_2_bits(status->ack_sn, &pdu_ptr, 10);
 
         // E1
-        rlc_value_2_bits(LIBLTE_RLC_E1_FIELD_NOT_EXTENDED, &pdu_ptr, 1);
+        if(0 == status->N_nack)
+        {
+            rlc_value_2_bits(LIBLTE_RLC_E1_FIELD_NOT_EXTENDED, &pdu_ptr, 1);
+        }else{
+            rlc_value_2_bits(LIBLTE_RLC_E1_FIELD_EXTENDED, &pdu_ptr, 1);
+        }
+
+        // NACKs
+        for(i=0; i<status->N_nack; i++)
+        {
+            rlc_value_2_bits(status->nack[i].nack_sn, &pdu_ptr, 10);
+            if(i == (status->N_nack - 1))
+            {
+                rlc_value_2_bits(LIBLTE_RLC_E1_FIELD_NOT_EXTENDED, &pdu_ptr, 1);
+            }else{
+                rlc_value_2_bits(LIBLTE_RLC_E1_FIELD_EXTENDED, &pdu_ptr, 1);
+            }
+            if(status->nack[i].so_present)
+            {
+                rlc_value_2_bits(LIBLTE_RLC_E2_FIELD_EXTENDED, &pdu_ptr, 1);
+                rlc_value_2_bits(status->nack[i].so_start, &pdu_ptr, 15);
+                rlc_value_2_bits(status->nack[i].so_end, &pdu_ptr, 15);
+            }else{
+                rlc_value_2_bits(LIBLTE_RLC_E2_FIELD_NOT_EXTENDED, &pdu_ptr, 1);
+            }
+        }
 
         // Padding
-        rlc_value_2_bits(0, &pdu_ptr, 1);
+        while(0 != ((pdu_ptr - pdu->msg) % 8))
+        {
+            rlc_value_2_bits(0, &pdu_ptr, 1);
+        }
 
         pdu->N_bits = pdu_ptr - pdu->msg;
 
@@ -176,7 +354,58 @@ LIBLTE_ERROR_ENUM liblte_rlc_pack_status_pdu(LIBLTE_RLC_STATUS_PDU_STRUCT *statu
 LIBLTE_ERROR_ENUM liblte_rlc_unpack_status_pdu(LIBLTE_BIT_MSG_STRUCT        *pdu,
                                                LIBLTE_RLC_STATUS_PDU_STRUCT *status)
 {
-    // FIXME
+    LIBLTE_ERROR_ENUM         err     = LIBLTE_ERROR_INVALID_INPUTS;
+    uint8                    *pdu_ptr = pdu->msg;
+    LIBLTE_RLC_DC_FIELD_ENUM  dc;
+    LIBLTE_RLC_E1_FIELD_ENUM  e1;
+    LIBLTE_RLC_E2_FIELD_ENUM  e2;
+    uint32                    cpt;
+
+    if(pdu    != NULL &&
+       status != NULL)
+    {
+        // D/C Field
+        dc = (LIBLTE_RLC_DC_FIELD_ENUM)rlc_bits_2_value(&pdu_ptr, 1);
+
+        // CPT Field
+        cpt = rlc_bits_2_value(&pdu_ptr, 3);
+
+        if(LIBLTE_RLC_DC_FIELD_CONTROL_PDU == dc &&
+           LIBLTE_RLC_CPT_FIELD_STATUS_PDU == cpt)
+        {
+            // ACK SN
+            status->ack_sn = rlc_bits_2_value(&pdu_ptr, 10);
+
+            // E1
+            e1 = (LIBLTE_RLC_E1_FIELD_ENUM)rlc_bits_2_value(&pdu_ptr, 1);
+
+            // NACKs
+            status->N_nack = 0;
+            while(LIBLTE_RLC_E1_FIELD_EXTENDED     == e1             &&
+                  LIBLTE_RLC_STATUS_PDU_MAX_N_NACK >  status->N_nack &&
+                  (pdu_ptr - pdu->msg + 12)        <= pdu->N_bits)
+            {
+                status->nack[status->N_nack].nack_sn = rlc_bits_2_value(&pdu_ptr, 10);
+                e1                                   = (LIBLTE_RLC_E1_FIELD_ENUM)rlc_bits_2_value(&pdu_ptr, 1);
+                e2                                   = (LIBLTE_RLC_E2_FIELD_ENUM)rlc_bits_2_value(&pdu_ptr, 1);
+                if(LIBLTE_RLC_E2_FIELD_EXTENDED == e2)
+                {
+                    status->nack[status->N_nack].so_present = true;
+                    status->nack[status->N_nack].so_start   = rlc_bits_2_value(&pdu_ptr, 15);
+                    status->nack[status->N_nack].so_end     = rlc_bits_2_value(&pdu_ptr, 15);
+                }else{
+                    status->nack[status->N_nack].so_present = false;
+                    status->nack[status->N_nack].so_start   = 0;
+                    status->nack[status->N_nack].so_end     = LIBLTE_RLC_SO_END_OF_PDU;
+                }
+                status->N_nack++;
+            }
+
+            err = LIBLTE_SUCCESS;
+        }
+    }
+
+    return(err);
 }
 
 /*******************************************************************************
@@ -220,3 +449,56 @@ uint32 rlc_bits_2_value(uint8  **bits,
 
     return(value);
 }
+
+/*********************************************************************
+    Name: rlc_unpack_data_field
+
+    Description: Unpacks the length indicators of a UMD or AMD PDU and
+                 points one slice per (part of an) RLC SDU into the
+                 data field
+*********************************************************************/
+LIBLTE_ERROR_ENUM rlc_unpack_data_field(LIBLTE_BIT_MSG_STRUCT    *pdu,
+                                        uint8                   **pdu_ptr,
+                                        LIBLTE_RLC_E_FIELD_ENUM   e,
+                                        LIBLTE_RLC_SLICE_STRUCT  *slice,
+                                        uint32                   *N_slices)
+{
+    LIBLTE_ERROR_ENUM err    = LIBLTE_ERROR_INVALID_INPUTS;
+    uint32            N_li   = 0;
+    uint32            N_bits = 0;
+    uint32            i;
+
+    // Length Indicators
+    while(LIBLTE_RLC_E_FIELD_HEADER_EXTENDED == e &&
+          N_li                                < (LIBLTE_RLC_UMD_PDU_MAX_N_SLICES - 1))
+    {
+        e                     = (LIBLTE_RLC_E_FIELD_ENUM)rlc_bits_2_value(pdu_ptr, 1);
+        slice[N_li++].N_bits  = rlc_bits_2_value(pdu_ptr, 11)*8;
+    }
+    if(0 != (N_li % 2))
+    {
+        rlc_bits_2_value(pdu_ptr, 4);
+    }
+
+    // Data, the slices point into the PDU
+    for(i=0; i<N_li; i++)
+    {
+        N_bits += slice[i].N_bits;
+    }
+    if(LIBLTE_RLC_E_FIELD_HEADER_NOT_EXTENDED == e &&
+       (*pdu_ptr - pdu->msg) + N_bits         < pdu->N_bits)
+    {
+        for(i=0; i<N_li; i++)
+        {
+            slice[i].msg  = *pdu_ptr;
+            *pdu_ptr     += slice[i].N_bits;
+        }
+        slice[N_li].msg    = *pdu_ptr;
+        slice[N_li].N_bits = pdu->N_bits - (*pdu_ptr - pdu->msg);
+        *N_slices          = N_li + 1;
+
+        err = LIBLTE_SUCCESS;
+    }
+
+    return(err);
+}
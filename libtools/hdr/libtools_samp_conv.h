@@ -0,0 +1,117 @@
+/*******************************************************************************
+
+    Copyright 2026 agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: libtools_samp_conv.h
+
+    Description: Contains all the definitions for the sample format conversion
+                 tool.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    agent            Created file
+    10/19/2026    agent            Added interleaved float to interleaved
+                                   integer conversion.
+
+*******************************************************************************/
+
+#ifndef __LIBTOOLS_SAMP_CONV_H__
+#define __LIBTOOLS_SAMP_CONV_H__
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "typedefs.h"
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+#define LIBTOOLS_SAMP_CONV_N_BUFS_MAX 4
+
+/*******************************************************************************
+                              FORWARD DECLARATIONS
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+// Interleaved I/Q sample formats
+typedef enum{
+    LIBTOOLS_SAMP_CONV_FORMAT_SC8 = 0,
+    LIBTOOLS_SAMP_CONV_FORMAT_SC16,
+    LIBTOOLS_SAMP_CONV_FORMAT_CF32,
+    LIBTOOLS_SAMP_CONV_FORMAT_N_ITEMS,
+}LIBTOOLS_SAMP_CONV_FORMAT_ENUM;
+static const char libtools_samp_conv_format_text[LIBTOOLS_SAMP_CONV_FORMAT_N_ITEMS][20] = {"sc8",
+                                                                                           "sc16",
+                                                                                           "cf32"};
+// Size of one complex sample in bytes
+static const uint32 libtools_samp_conv_format_size[LIBTOOLS_SAMP_CONV_FORMAT_N_ITEMS] = {2, 4, 8};
+
+/*******************************************************************************
+                              DECLARATIONS
+*******************************************************************************/
+
+/*********************************************************************
+    Name: libtools_samp_conv_to_split
+
+    Description: Converts interleaved I/Q samples to separate I and Q
+                 float buffers, multiplying each sample by scale.
+*********************************************************************/
+void libtools_samp_conv_to_split(LIBTOOLS_SAMP_CONV_FORMAT_ENUM  format,
+                                 const void                     *in,
+                                 float                           scale,
+                                 float                          *i_buf,
+                                 float                          *q_buf,
+                                 uint32                          N_samps);
+
+/*********************************************************************
+    Name: libtools_samp_conv_from_split
+
+    Description: Sums N_bufs pairs of I and Q float buffers, multiplies
+                 the sum by scale and converts it to interleaved I/Q
+                 samples.  Integer formats are rounded to the nearest
+                 value and saturated.
+*********************************************************************/
+void libtools_samp_conv_from_split(const float * const            *i_bufs,
+                                   const float * const            *q_bufs,
+                                   uint32                          N_bufs,
+                                   float                           scale,
+                                   LIBTOOLS_SAMP_CONV_FORMAT_ENUM  format,
+                                   void                           *out,
+                                   uint32                          N_samps);
+
+/*********************************************************************
+    Name: libtools_samp_conv_from_cf32
+
+    Description: Multiplies interleaved float I/Q samples by scale and
+                 converts them to interleaved I/Q samples.  Integer
+                 formats are rounded to the nearest value and
+                 saturated.
+*********************************************************************/
+void libtools_samp_conv_from_cf32(const float                    *in,
+                                  float                           scale,
+                                  LIBTOOLS_SAMP_CONV_FORMAT_ENUM  format,
+                                  void                           *out,
+                                  uint32                          N_samps);
+
+#endif /* __LIBTOOLS_SAMP_CONV_H__ */
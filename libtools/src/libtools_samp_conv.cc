@@ -0,0 +1,708 @@
+/*******************************************************************************
+
+    Copyright 2026 agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: libtools_samp_conv.cc
+
+    Description: Contains all the implementations for the sample format
+                 conversion tool.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    agent            Created file
+    10/19/2026    agent            Added interleaved float to interleaved
+                                   integer conversion.
+
+*******************************************************************************/
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "libtools_samp_conv.h"
+#include <math.h>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+#define SC8_MAX  (127.0f)
+#define SC8_MIN  (-128.0f)
+#define SC16_MAX (32767.0f)
+#define SC16_MIN (-32768.0f)
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              GLOBAL VARIABLES
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              LOCAL FUNCTION PROTOTYPES
+*******************************************************************************/
+
+void sc8_to_split(const int8 *in, float scale, float *i_buf, float *q_buf, uint32 N_samps);
+void sc16_to_split(const int16 *in, float scale, float *i_buf, float *q_buf, uint32 N_samps);
+void cf32_to_split(const float *in, float scale, float *i_buf, float *q_buf, uint32 N_samps);
+void split_to_sc8(const float * const *i_bufs, const float * const *q_bufs, uint32 N_bufs, float scale, int8 *out, uint32 N_samps);
+void split_to_sc16(const float * const *i_bufs, const float * const *q_bufs, uint32 N_bufs, float scale, int16 *out, uint32 N_samps);
+void split_to_cf32(const float * const *i_bufs, const float * const *q_bufs, uint32 N_bufs, float scale, float *out, uint32 N_samps);
+void cf32_to_sc8(const float *in, float scale, int8 *out, uint32 N_samps);
+void cf32_to_sc16(const float *in, float scale, int16 *out, uint32 N_samps);
+void cf32_to_cf32(const float *in, float scale, float *out, uint32 N_samps);
+float sum_split(const float * const *bufs, uint32 N_bufs, uint32 idx);
+int32 round_and_saturate(float samp, float min, float max);
+
+/*******************************************************************************
+                              LIBRARY FUNCTIONS
+*******************************************************************************/
+
+/*********************************************************************
+    Name: libtools_samp_conv_to_split
+
+    Description: Converts interleaved I/Q samples to separate I and Q
+                 float buffers, multiplying each sample by scale.
+*********************************************************************/
+void libtools_samp_conv_to_split(LIBTOOLS_SAMP_CONV_FORMAT_ENUM  format,
+                                 const void                     *in,
+                                 float                           scale,
+                                 float                          *i_buf,
+                                 float                          *q_buf,
+                                 uint32                          N_samps)
+{
+    switch(format)
+    {
+    case LIBTOOLS_SAMP_CONV_FORMAT_SC8:
+        sc8_to_split((const int8 *)in, scale, i_buf, q_buf, N_samps);
+        break;
+    case LIBTOOLS_SAMP_CONV_FORMAT_SC16:
+        sc16_to_split((const int16 *)in, scale, i_buf, q_buf, N_samps);
+        break;
+    case LIBTOOLS_SAMP_CONV_FORMAT_CF32:
+    default:
+        cf32_to_split((const float *)in, scale, i_buf, q_buf, N_samps);
+        break;
+    }
+}
+
+/*********************************************************************
+    Name: libtools_samp_conv_from_split
+
+    Description: Sums N_bufs pairs of I and Q float buffers, multiplies
+                 the sum by scale and converts it to interleaved I/Q
+                 samples.  Integer formats are rounded to the nearest
+                 value and saturated.
+*********************************************************************/
+void libtools_samp_conv_from_split(const float * const            *i_bufs,
+                                   const float * const            *q_bufs,
+                                   uint32                          N_bufs,
+                                   float                           scale,
+                                   LIBTOOLS_SAMP_CONV_FORMAT_ENUM  format,
+                                   void                           *out,
+                                   uint32                          N_samps)
+{
+    switch(format)
+    {
+    case LIBTOOLS_SAMP_CONV_FORMAT_SC8:
+        split_to_sc8(i_bufs, q_bufs, N_bufs, scale, (int8 *)out, N_samps);
+        break;
+    case LIBTOOLS_SAMP_CONV_FORMAT_SC16:
+        split_to_sc16(i_bufs, q_bufs, N_bufs, scale, (int16 *)out, N_samps);
+        break;
+    case LIBTOOLS_SAMP_CONV_FORMAT_CF32:
+    default:
+        split_to_cf32(i_bufs, q_bufs, N_bufs, scale, (float *)out, N_samps);
+        break;
+    }
+}
+
+/*********************************************************************
+    Name: libtools_samp_conv_from_cf32
+
+    Description: Multiplies interleaved float I/Q samples by scale and
+                 converts them to interleaved I/Q samples.  Integer
+                 formats are rounded to the nearest value and
+                 saturated.
+*********************************************************************/
+void libtools_samp_conv_from_cf32(const float                    *in,
+                                  float                           scale,
+                                  LIBTOOLS_SAMP_CONV_FORMAT_ENUM  format,
+                                  void                           *out,
+                                  uint32                          N_samps)
+{
+    switch(format)
+    {
+    case LIBTOOLS_SAMP_CONV_FORMAT_SC8:
+        cf32_to_sc8(in, scale, (int8 *)out, N_samps);
+        break;
+    case LIBTOOLS_SAMP_CONV_FORMAT_SC16:
+        cf32_to_sc16(in, scale, (int16 *)out, N_samps);
+        break;
+    case LIBTOOLS_SAMP_CONV_FORMAT_CF32:
+    default:
+        cf32_to_cf32(in, scale, (float *)out, N_samps);
+        break;
+    }
+}
+
+/*******************************************************************************
+                              LOCAL FUNCTIONS
+*******************************************************************************/
+
+/*********************************************************************
+    Name: sc8_to_split
+
+    Description: Converts interleaved 8 bit I/Q samples to float.
+*********************************************************************/
+void sc8_to_split(const int8 *in,
+                  float       scale,
+                  float      *i_buf,
+                  float      *q_buf,
+                  uint32      N_samps)
+{
+    uint32  i = 0;
+#if defined(__AVX2__)
+    __m256  v_scale = _mm256_set1_ps(scale);
+    __m256i v;
+
+    // Sign extend to 16 bits, each 32 bit lane then holds one I/Q pair
+    for(; (i+8)<=N_samps; i+=8)
+    {
+        v = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)&in[i*2]));
+        _mm256_storeu_ps(&i_buf[i], _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srai_epi32(_mm256_slli_epi32(v, 16), 16)), v_scale));
+        _mm256_storeu_ps(&q_buf[i], _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srai_epi32(v, 16)), v_scale));
+    }
+#elif defined(__SSE2__)
+    __m128  v_scale = _mm_set1_ps(scale);
+    __m128i v;
+
+    // Sign extend to 16 bits, each 32 bit lane then holds one I/Q pair
+    for(; (i+4)<=N_samps; i+=4)
+    {
+        v = _mm_loadl_epi64((const __m128i *)&in[i*2]);
+        v = _mm_srai_epi16(_mm_unpacklo_epi8(v, v), 8);
+        _mm_storeu_ps(&i_buf[i], _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_slli_epi32(v, 16), 16)), v_scale));
+        _mm_storeu_ps(&q_buf[i], _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(v, 16)), v_scale));
+    }
+#endif
+
+    for(; i<N_samps; i++)
+    {
+        i_buf[i] = (float)in[i*2]*scale;
+        q_buf[i] = (float)in[i*2+1]*scale;
+    }
+}
+
+/*********************************************************************
+    Name: sc16_to_split
+
+    Description: Converts interleaved 16 bit I/Q samples to float.
+*********************************************************************/
+void sc16_to_split(const int16 *in,
+                   float        scale,
+                   float       *i_buf,
+                   float       *q_buf,
+                   uint32       N_samps)
+{
+    uint32  i = 0;
+#if defined(__AVX2__)
+    __m256  v_scale = _mm256_set1_ps(scale);
+    __m256i v;
+
+    for(; (i+8)<=N_samps; i+=8)
+    {
+        v = _mm256_loadu_si256((const __m256i *)&in[i*2]);
+        _mm256_storeu_ps(&i_buf[i], _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srai_epi32(_mm256_slli_epi32(v, 16), 16)), v_scale));
+        _mm256_storeu_ps(&q_buf[i], _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srai_epi32(v, 16)), v_scale));
+    }
+#elif defined(__SSE2__)
+    __m128  v_scale = _mm_set1_ps(scale);
+    __m128i v;
+
+    for(; (i+4)<=N_samps; i+=4)
+    {
+        v = _mm_loadu_si128((const __m128i *)&in[i*2]);
+        _mm_storeu_ps(&i_buf[i], _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_slli_epi32(v, 16), 16)), v_scale));
+        _mm_storeu_ps(&q_buf[i], _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(v, 16)), v_scale));
+    }
+#endif
+
+    for(; i<N_samps; i++)
+    {
+        i_buf[i] = (float)in[i*2]*scale;
+        q_buf[i] = (float)in[i*2+1]*scale;
+    }
+}
+
+/*********************************************************************
+    Name: cf32_to_split
+
+    Description: De-interleaves float I/Q samples.
+*********************************************************************/
+void cf32_to_split(const float *in,
+                   float        scale,
+                   float       *i_buf,
+                   float       *q_buf,
+                   uint32       N_samps)
+{
+    uint32 i = 0;
+#if defined(__AVX2__)
+    __m256 v_scale = _mm256_set1_ps(scale);
+    __m256 v0;
+    __m256 v1;
+    __m256 v_i;
+    __m256 v_q;
+
+    // The shuffles work within 128 bit lanes, so the 64 bit pairs need to
+    // be put back in order
+    for(; (i+8)<=N_samps; i+=8)
+    {
+        v0  = _mm256_loadu_ps(&in[i*2]);
+        v1  = _mm256_loadu_ps(&in[i*2+8]);
+        v_i = _mm256_shuffle_ps(v0, v1, _MM_SHUFFLE(2,0,2,0));
+        v_q = _mm256_shuffle_ps(v0, v1, _MM_SHUFFLE(3,1,3,1));
+        v_i = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(v_i), _MM_SHUFFLE(3,1,2,0)));
+        v_q = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(v_q), _MM_SHUFFLE(3,1,2,0)));
+        _mm256_storeu_ps(&i_buf[i], _mm256_mul_ps(v_i, v_scale));
+        _mm256_storeu_ps(&q_buf[i], _mm256_mul_ps(v_q, v_scale));
+    }
+#elif defined(__SSE2__)
+    __m128 v_scale = _mm_set1_ps(scale);
+    __m128 v0;
+    __m128 v1;
+
+    for(; (i+4)<=N_samps; i+=4)
+    {
+        v0 = _mm_loadu_ps(&in[i*2]);
+        v1 = _mm_loadu_ps(&in[i*2+4]);
+        _mm_storeu_ps(&i_buf[i], _mm_mul_ps(_mm_shuffle_ps(v0, v1, _MM_SHUFFLE(2,0,2,0)), v_scale));
+        _mm_storeu_ps(&q_buf[i], _mm_mul_ps(_mm_shuffle_ps(v0, v1, _MM_SHUFFLE(3,1,3,1)), v_scale));
+    }
+#endif
+
+    for(; i<N_samps; i++)
+    {
+        i_buf[i] = in[i*2]*scale;
+        q_buf[i] = in[i*2+1]*scale;
+    }
+}
+
+/*********************************************************************
+    Name: split_to_sc8
+
+    Description: Converts float I/Q samples to interleaved 8 bit.
+*********************************************************************/
+void split_to_sc8(const float * const *i_bufs,
+                  const float * const *q_bufs,
+                  uint32               N_bufs,
+                  float                scale,
+                  int8                *out,
+                  uint32               N_samps)
+{
+    uint32  i = 0;
+#if defined(__AVX2__)
+    uint32  p;
+    __m256  v_scale = _mm256_set1_ps(scale);
+    __m256  v_max   = _mm256_set1_ps(SC8_MAX);
+    __m256  v_min   = _mm256_set1_ps(SC8_MIN);
+    __m256  v_i;
+    __m256  v_q;
+    __m256i v_iq_lo;
+    __m256i v_iq_hi;
+    __m256i v;
+
+    for(; (i+8)<=N_samps; i+=8)
+    {
+        v_i = _mm256_loadu_ps(&i_bufs[0][i]);
+        v_q = _mm256_loadu_ps(&q_bufs[0][i]);
+        for(p=1; p<N_bufs; p++)
+        {
+            v_i = _mm256_add_ps(v_i, _mm256_loadu_ps(&i_bufs[p][i]));
+            v_q = _mm256_add_ps(v_q, _mm256_loadu_ps(&q_bufs[p][i]));
+        }
+        v_i     = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(v_i, v_scale), v_min), v_max);
+        v_q     = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(v_q, v_scale), v_min), v_max);
+        v_iq_lo = _mm256_unpacklo_epi32(_mm256_cvtps_epi32(v_i), _mm256_cvtps_epi32(v_q));
+        v_iq_hi = _mm256_unpackhi_epi32(_mm256_cvtps_epi32(v_i), _mm256_cvtps_epi32(v_q));
+        v       = _mm256_packs_epi32(v_iq_lo, v_iq_hi);
+        _mm_storeu_si128((__m128i *)&out[i*2], _mm_packs_epi16(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1)));
+    }
+#elif defined(__SSE2__)
+    uint32  p;
+    __m128  v_scale = _mm_set1_ps(scale);
+    __m128  v_max   = _mm_set1_ps(SC8_MAX);
+    __m128  v_min   = _mm_set1_ps(SC8_MIN);
+    __m128  v_i;
+    __m128  v_q;
+    __m128i v_iq_lo;
+    __m128i v_iq_hi;
+
+    for(; (i+4)<=N_samps; i+=4)
+    {
+        v_i = _mm_loadu_ps(&i_bufs[0][i]);
+        v_q = _mm_loadu_ps(&q_bufs[0][i]);
+        for(p=1; p<N_bufs; p++)
+        {
+            v_i = _mm_add_ps(v_i, _mm_loadu_ps(&i_bufs[p][i]));
+            v_q = _mm_add_ps(v_q, _mm_loadu_ps(&q_bufs[p][i]));
+        }
+        v_i     = _mm_min_ps(_mm_max_ps(_mm_mul_ps(v_i, v_scale), v_min), v_max);
+        v_q     = _mm_min_ps(_mm_max_ps(_mm_mul_ps(v_q, v_scale), v_min), v_max);
+        v_iq_lo = _mm_unpacklo_epi32(_mm_cvtps_epi32(v_i), _mm_cvtps_epi32(v_q));
+        v_iq_hi = _mm_unpackhi_epi32(_mm_cvtps_epi32(v_i), _mm_cvtps_epi32(v_q));
+        v_iq_lo = _mm_packs_epi32(v_iq_lo, v_iq_hi);
+        _mm_storel_epi64((__m128i *)&out[i*2], _mm_packs_epi16(v_iq_lo, v_iq_lo));
+    }
+#endif
+
+    for(; i<N_samps; i++)
+    {
+        out[i*2]   = (int8)round_and_saturate(sum_split(i_bufs, N_bufs, i)*scale, SC8_MIN, SC8_MAX);
+        out[i*2+1] = (int8)round_and_saturate(sum_split(q_bufs, N_bufs, i)*scale, SC8_MIN, SC8_MAX);
+    }
+}
+
+/*********************************************************************
+    Name: split_to_sc16
+
+    Description: Converts float I/Q samples to interleaved 16 bit.
+*********************************************************************/
+void split_to_sc16(const float * const *i_bufs,
+                   const float * const *q_bufs,
+                   uint32               N_bufs,
+                   float                scale,
+                   int16               *out,
+                   uint32               N_samps)
+{
+    uint32  i = 0;
+#if defined(__AVX2__)
+    uint32  p;
+    __m256  v_scale = _mm256_set1_ps(scale);
+    __m256  v_max   = _mm256_set1_ps(SC16_MAX);
+    __m256  v_min   = _mm256_set1_ps(SC16_MIN);
+    __m256  v_i;
+    __m256  v_q;
+    __m256i v_iq_lo;
+    __m256i v_iq_hi;
+
+    // Unpacking and packing both work within 128 bit lanes, so the output
+    // comes out in order
+    for(; (i+8)<=N_samps; i+=8)
+    {
+        v_i = _mm256_loadu_ps(&i_bufs[0][i]);
+        v_q = _mm256_loadu_ps(&q_bufs[0][i]);
+        for(p=1; p<N_bufs; p++)
+        {
+            v_i = _mm256_add_ps(v_i, _mm256_loadu_ps(&i_bufs[p][i]));
+            v_q = _mm256_add_ps(v_q, _mm256_loadu_ps(&q_bufs[p][i]));
+        }
+        v_i     = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(v_i, v_scale), v_min), v_max);
+        v_q     = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(v_q, v_scale), v_min), v_max);
+        v_iq_lo = _mm256_unpacklo_epi32(_mm256_cvtps_epi32(v_i), _mm256_cvtps_epi32(v_q));
+        v_iq_hi = _mm256_unpackhi_epi32(_mm256_cvtps_epi32(v_i), _mm256_cvtps_epi32(v_q));
+        _mm256_storeu_si256((__m256i *)&out[i*2], _mm256_packs_epi32(v_iq_lo, v_iq_hi));
+    }
+#elif defined(__SSE2__)
+    uint32  p;
+    __m128  v_scale = _mm_set1_ps(scale);
+    __m128  v_max   = _mm_set1_ps(SC16_MAX);
+    __m128  v_min   = _mm_set1_ps(SC16_MIN);
+    __m128  v_i;
+    __m128  v_q;
+    __m128i v_iq_lo;
+    __m128i v_iq_hi;
+
+    for(; (i+4)<=N_samps; i+=4)
+    {
+        v_i = _mm_loadu_ps(&i_bufs[0][i]);
+        v_q = _mm_loadu_ps(&q_bufs[0][i]);
+        for(p=1; p<N_bufs; p++)
+        {
+            v_i = _mm_add_ps(v_i, _mm_loadu_ps(&i_bufs[p][i]));
+            v_q = _mm_add_ps(v_q, _mm_loadu_ps(&q_bufs[p][i]));
+        }
+        v_i     = _mm_min_ps(_mm_max_ps(_mm_mul_ps(v_i, v_scale), v_min), v_max);
+        v_q     = _mm_min_ps(_mm_max_ps(_mm_mul_ps(v_q, v_scale), v_min), v_max);
+        v_iq_lo = _mm_unpacklo_epi32(_mm_cvtps_epi32(v_i), _mm_cvtps_epi32(v_q));
+        v_iq_hi = _mm_unpackhi_epi32(_mm_cvtps_epi32(v_i), _mm_cvtps_epi32(v_q));
+        _mm_storeu_si128((__m128i *)&out[i*2], _mm_packs_epi32(v_iq_lo, v_iq_hi));
+    }
+#endif
+
+    for(; i<N_samps; i++)
+    {
+        out[i*2]   = (int16)round_and_saturate(sum_split(i_bufs, N_bufs, i)*scale, SC16_MIN, SC16_MAX);
+        out[i*2+1] = (int16)round_and_saturate(sum_split(q_bufs, N_bufs, i)*scale, SC16_MIN, SC16_MAX);
+    }
+}
+
+/*********************************************************************
+    Name: split_to_cf32
+
+    Description: Interleaves float I/Q samples.
+*********************************************************************/
+void split_to_cf32(const float * const *i_bufs,
+                   const float * const *q_bufs,
+                   uint32               N_bufs,
+                   float                scale,
+                   float               *out,
+                   uint32               N_samps)
+{
+    uint32 i = 0;
+#if defined(__AVX2__)
+    uint32 p;
+    __m256 v_scale = _mm256_set1_ps(scale);
+    __m256 v_i;
+    __m256 v_q;
+    __m256 v_iq_lo;
+    __m256 v_iq_hi;
+
+    // The unpacks work within 128 bit lanes, so the halves need to be put
+    // back in order
+    for(; (i+8)<=N_samps; i+=8)
+    {
+        v_i = _mm256_loadu_ps(&i_bufs[0][i]);
+        v_q = _mm256_loadu_ps(&q_bufs[0][i]);
+        for(p=1; p<N_bufs; p++)
+        {
+            v_i = _mm256_add_ps(v_i, _mm256_loadu_ps(&i_bufs[p][i]));
+            v_q = _mm256_add_ps(v_q, _mm256_loadu_ps(&q_bufs[p][i]));
+        }
+        v_i     = _mm256_mul_ps(v_i, v_scale);
+        v_q     = _mm256_mul_ps(v_q, v_scale);
+        v_iq_lo = _mm256_unpacklo_ps(v_i, v_q);
+        v_iq_hi = _mm256_unpackhi_ps(v_i, v_q);
+        _mm256_storeu_ps(&out[i*2],   _mm256_permute2f128_ps(v_iq_lo, v_iq_hi, 0x20));
+        _mm256_storeu_ps(&out[i*2+8], _mm256_permute2f128_ps(v_iq_lo, v_iq_hi, 0x31));
+    }
+#elif defined(__SSE2__)
+    uint32 p;
+    __m128 v_scale = _mm_set1_ps(scale);
+    __m128 v_i;
+    __m128 v_q;
+
+    for(; (i+4)<=N_samps; i+=4)
+    {
+        v_i = _mm_loadu_ps(&i_bufs[0][i]);
+        v_q = _mm_loadu_ps(&q_bufs[0][i]);
+        for(p=1; p<N_bufs; p++)
+        {
+            v_i = _mm_add_ps(v_i, _mm_loadu_ps(&i_bufs[p][i]));
+            v_q = _mm_add_ps(v_q, _mm_loadu_ps(&q_bufs[p][i]));
+        }
+        v_i = _mm_mul_ps(v_i, v_scale);
+        v_q = _mm_mul_ps(v_q, v_scale);
+        _mm_storeu_ps(&out[i*2],   _mm_unpacklo_ps(v_i, v_q));
+        _mm_storeu_ps(&out[i*2+4], _mm_unpackhi_ps(v_i, v_q));
+    }
+#endif
+
+    for(; i<N_samps; i++)
+    {
+        out[i*2]   = sum_split(i_bufs, N_bufs, i)*scale;
+        out[i*2+1] = sum_split(q_bufs, N_bufs, i)*scale;
+    }
+}
+
+/*********************************************************************
+    Name: cf32_to_sc8
+
+    Description: Converts interleaved float I/Q samples to interleaved
+                 8 bit.
+*********************************************************************/
+void cf32_to_sc8(const float *in,
+                 float        scale,
+                 int8        *out,
+                 uint32       N_samps)
+{
+    uint32  i = 0;
+#if defined(__AVX2__)
+    __m256  v_scale = _mm256_set1_ps(scale);
+    __m256  v_max   = _mm256_set1_ps(SC8_MAX);
+    __m256  v_min   = _mm256_set1_ps(SC8_MIN);
+    __m256i v_perm  = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    __m256i v[4];
+    uint32  j;
+
+    // Packing works within 128 bit lanes, leaving each group of two I/Q
+    // pairs in a 32 bit element that is then put back in order
+    for(; (i+16)<=N_samps; i+=16)
+    {
+        for(j=0; j<4; j++)
+        {
+            v[j] = _mm256_cvtps_epi32(_mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_loadu_ps(&in[i*2+j*8]), v_scale), v_min), v_max));
+        }
+        v[0] = _mm256_packs_epi16(_mm256_packs_epi32(v[0], v[1]), _mm256_packs_epi32(v[2], v[3]));
+        _mm256_storeu_si256((__m256i *)&out[i*2], _mm256_permutevar8x32_epi32(v[0], v_perm));
+    }
+#elif defined(__SSE2__)
+    __m128  v_scale = _mm_set1_ps(scale);
+    __m128  v_max   = _mm_set1_ps(SC8_MAX);
+    __m128  v_min   = _mm_set1_ps(SC8_MIN);
+    __m128i v[4];
+    uint32  j;
+
+    for(; (i+8)<=N_samps; i+=8)
+    {
+        for(j=0; j<4; j++)
+        {
+            v[j] = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(&in[i*2+j*4]), v_scale), v_min), v_max));
+        }
+        _mm_storeu_si128((__m128i *)&out[i*2], _mm_packs_epi16(_mm_packs_epi32(v[0], v[1]), _mm_packs_epi32(v[2], v[3])));
+    }
+#endif
+
+    for(; i<N_samps; i++)
+    {
+        out[i*2]   = (int8)round_and_saturate(in[i*2]*scale, SC8_MIN, SC8_MAX);
+        out[i*2+1] = (int8)round_and_saturate(in[i*2+1]*scale, SC8_MIN, SC8_MAX);
+    }
+}
+
+/*********************************************************************
+    Name: cf32_to_sc16
+
+    Description: Converts interleaved float I/Q samples to interleaved
+                 16 bit.
+*********************************************************************/
+void cf32_to_sc16(const float *in,
+                  float        scale,
+                  int16       *out,
+                  uint32       N_samps)
+{
+    uint32  i = 0;
+#if defined(__AVX2__)
+    __m256  v_scale = _mm256_set1_ps(scale);
+    __m256  v_max   = _mm256_set1_ps(SC16_MAX);
+    __m256  v_min   = _mm256_set1_ps(SC16_MIN);
+    __m256i v0;
+    __m256i v1;
+
+    // Packing works within 128 bit lanes, so the 64 bit halves need to be
+    // put back in order
+    for(; (i+8)<=N_samps; i+=8)
+    {
+        v0 = _mm256_cvtps_epi32(_mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_loadu_ps(&in[i*2]), v_scale), v_min), v_max));
+        v1 = _mm256_cvtps_epi32(_mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_loadu_ps(&in[i*2+8]), v_scale), v_min), v_max));
+        _mm256_storeu_si256((__m256i *)&out[i*2], _mm256_permute4x64_epi64(_mm256_packs_epi32(v0, v1), _MM_SHUFFLE(3,1,2,0)));
+    }
+#elif defined(__SSE2__)
+    __m128  v_scale = _mm_set1_ps(scale);
+    __m128  v_max   = _mm_set1_ps(SC16_MAX);
+    __m128  v_min   = _mm_set1_ps(SC16_MIN);
+    __m128i v0;
+    __m128i v1;
+
+    for(; (i+4)<=N_samps; i+=4)
+    {
+        v0 = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(&in[i*2]), v_scale), v_min), v_max));
+        v1 = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(&in[i*2+4]), v_scale), v_min), v_max));
+        _mm_storeu_si128((__m128i *)&out[i*2], _mm_packs_epi32(v0, v1));
+    }
+#endif
+
+    for(; i<N_samps; i++)
+    {
+        out[i*2]   = (int16)round_and_saturate(in[i*2]*scale, SC16_MIN, SC16_MAX);
+        out[i*2+1] = (int16)round_and_saturate(in[i*2+1]*scale, SC16_MIN, SC16_MAX);
+    }
+}
+
+/*********************************************************************
+    Name: cf32_to_cf32
+
+    Description: Scales interleaved float I/Q samples.
+*********************************************************************/
+void cf32_to_cf32(const float *in,
+                  float        scale,
+                  float       *out,
+                  uint32       N_samps)
+{
+    uint32 i = 0;
+#if defined(__AVX2__)
+    __m256 v_scale = _mm256_set1_ps(scale);
+
+    for(; (i+4)<=N_samps; i+=4)
+    {
+        _mm256_storeu_ps(&out[i*2], _mm256_mul_ps(_mm256_loadu_ps(&in[i*2]), v_scale));
+    }
+#elif defined(__SSE2__)
+    __m128 v_scale = _mm_set1_ps(scale);
+
+    for(; (i+2)<=N_samps; i+=2)
+    {
+        _mm_storeu_ps(&out[i*2], _mm_mul_ps(_mm_loadu_ps(&in[i*2]), v_scale));
+    }
+#endif
+
+    for(; i<N_samps; i++)
+    {
+        out[i*2]   = in[i*2]*scale;
+        out[i*2+1] = in[i*2+1]*scale;
+    }
+}
+
+/*********************************************************************
+    Name: sum_split
+
+    Description: Sums one sample across float buffers.
+*********************************************************************/
+float sum_split(const float * const *bufs,
+                uint32               N_bufs,
+                uint32               idx)
+{
+    float  sum = bufs[0][idx];
+    uint32 p;
+
+    for(p=1; p<N_bufs; p++)
+    {
+        sum += bufs[p][idx];
+    }
+
+    return(sum);
+}
+
+/*********************************************************************
+    Name: round_and_saturate
+
+    Description: Rounds a sample to the nearest integer, limited to
+                 the range of the output format.  Rounding matches
+                 the vector conversions.
+*********************************************************************/
+int32 round_and_saturate(float samp,
+                         float min,
+                         float max)
+{
+    if(samp > max)
+    {
+        samp = max;
+    }else if(samp < min){
+        samp = min;
+    }
+
+    return((int32)lrintf(samp));
+}
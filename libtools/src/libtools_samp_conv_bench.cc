@@ -0,0 +1,221 @@
+/*******************************************************************************
+
+    Copyright 2026 agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Affero General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Affero General Public License for more details.
+
+    You should have received a copy of the GNU Affero General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*******************************************************************************
+
+    File: libtools_samp_conv_bench.cc
+
+    Description: Contains all the implementations for the sample format
+                 conversion throughput benchmark.
+
+    Revision History
+    ----------    -------------    --------------------------------------------
+    10/19/2026    agent            Created file
+    10/19/2026    agent            Added interleaved float conversion.
+
+*******************************************************************************/
+
+/*******************************************************************************
+                              INCLUDES
+*******************************************************************************/
+
+#include "libtools_samp_conv.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/*******************************************************************************
+                              DEFINES
+*******************************************************************************/
+
+// One 20ms block at 30.72MHz keeps the buffers in cache
+#define N_SAMPS     (30720*20)
+#define N_ANT       2
+#define N_LOOPS_MIN 16
+#define RUN_TIME_NS (500000000LL)
+
+/*******************************************************************************
+                              TYPEDEFS
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              GLOBAL VARIABLES
+*******************************************************************************/
+
+
+/*******************************************************************************
+                              FUNCTIONS
+*******************************************************************************/
+
+int64 get_time_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return((int64)ts.tv_sec*1000000000LL + ts.tv_nsec);
+}
+
+void print_result(const char *name,
+                  uint32      format,
+                  uint32      N_loops,
+                  int64       elapsed_ns)
+{
+    double samps_per_sec = (double)N_SAMPS*N_loops*1000000000.0/(double)elapsed_ns;
+
+    printf("\t%-6s %-12s %10.1f Msamps/s %8.2f GB/s\n",
+           libtools_samp_conv_format_text[format],
+           name,
+           samps_per_sec/1000000.0,
+           samps_per_sec*libtools_samp_conv_format_size[format]/1000000000.0);
+}
+
+int main(int argc, char *argv[])
+{
+    const float *i_bufs[N_ANT];
+    const float *q_bufs[N_ANT];
+    float       *i_buf[N_ANT];
+    float       *q_buf[N_ANT];
+    float       *i_out;
+    float       *q_out;
+    float       *cf32_buf;
+    uint8       *iq_buf;
+    int64        start_time;
+    int64        elapsed_ns;
+    uint32       format;
+    uint32       N_loops;
+    uint32       i;
+    uint32       p;
+
+    iq_buf   = (uint8 *)malloc(N_SAMPS*libtools_samp_conv_format_size[LIBTOOLS_SAMP_CONV_FORMAT_CF32]);
+    cf32_buf = (float *)malloc(N_SAMPS*libtools_samp_conv_format_size[LIBTOOLS_SAMP_CONV_FORMAT_CF32]);
+    i_out    = (float *)malloc(N_SAMPS*sizeof(float));
+    q_out    = (float *)malloc(N_SAMPS*sizeof(float));
+    for(p=0; p<N_ANT; p++)
+    {
+        i_buf[p]  = (float *)malloc(N_SAMPS*sizeof(float));
+        q_buf[p]  = (float *)malloc(N_SAMPS*sizeof(float));
+        i_bufs[p] = i_buf[p];
+        q_bufs[p] = q_buf[p];
+        for(i=0; i<N_SAMPS; i++)
+        {
+            i_buf[p][i] = (float)((rand() % 2001) - 1000)/10.0;
+            q_buf[p][i] = (float)((rand() % 2001) - 1000)/10.0;
+        }
+    }
+    libtools_samp_conv_from_split(i_bufs,
+                                  q_bufs,
+                                  1,
+                                  1.0/1000.0,
+                                  LIBTOOLS_SAMP_CONV_FORMAT_CF32,
+                                  cf32_buf,
+                                  N_SAMPS);
+
+    printf("*** SAMPLE CONVERSION BENCHMARK ***\n");
+#if defined(__AVX2__)
+    printf("\tUsing AVX2\n");
+#elif defined(__SSE2__)
+    printf("\tUsing SSE2\n");
+#else
+    printf("\tUsing scalar\n");
+#endif
+    printf("\tGB/s counts the interleaved samples\n");
+    for(format=0; format<LIBTOOLS_SAMP_CONV_FORMAT_N_ITEMS; format++)
+    {
+        // Split to interleaved, single antenna
+        N_loops    = 0;
+        start_time = get_time_ns();
+        do
+        {
+            libtools_samp_conv_from_split(i_bufs,
+                                          q_bufs,
+                                          1,
+                                          1.0,
+                                          (LIBTOOLS_SAMP_CONV_FORMAT_ENUM)format,
+                                          iq_buf,
+                                          N_SAMPS);
+            N_loops++;
+            elapsed_ns = get_time_ns() - start_time;
+        }while(N_loops    < N_LOOPS_MIN ||
+               elapsed_ns < RUN_TIME_NS);
+        print_result("from_split", format, N_loops, elapsed_ns);
+
+        // Split to interleaved, combining antennas
+        N_loops    = 0;
+        start_time = get_time_ns();
+        do
+        {
+            libtools_samp_conv_from_split(i_bufs,
+                                          q_bufs,
+                                          N_ANT,
+                                          1.0/N_ANT,
+                                          (LIBTOOLS_SAMP_CONV_FORMAT_ENUM)format,
+                                          iq_buf,
+                                          N_SAMPS);
+            N_loops++;
+            elapsed_ns = get_time_ns() - start_time;
+        }while(N_loops    < N_LOOPS_MIN ||
+               elapsed_ns < RUN_TIME_NS);
+        print_result("from_split_2", format, N_loops, elapsed_ns);
+
+        // Interleaved to split, using the samples written above
+        N_loops    = 0;
+        start_time = get_time_ns();
+        do
+        {
+            libtools_samp_conv_to_split((LIBTOOLS_SAMP_CONV_FORMAT_ENUM)format,
+                                        iq_buf,
+                                        1.0,
+                                        i_out,
+                                        q_out,
+                                        N_SAMPS);
+            N_loops++;
+            elapsed_ns = get_time_ns() - start_time;
+        }while(N_loops    < N_LOOPS_MIN ||
+               elapsed_ns < RUN_TIME_NS);
+        print_result("to_split", format, N_loops, elapsed_ns);
+
+        // Interleaved float to interleaved
+        N_loops    = 0;
+        start_time = get_time_ns();
+        do
+        {
+            libtools_samp_conv_from_cf32(cf32_buf,
+                                         32767.0,
+                                         (LIBTOOLS_SAMP_CONV_FORMAT_ENUM)format,
+                                         iq_buf,
+                                         N_SAMPS);
+            N_loops++;
+            elapsed_ns = get_time_ns() - start_time;
+        }while(N_loops    < N_LOOPS_MIN ||
+               elapsed_ns < RUN_TIME_NS);
+        print_result("from_cf32", format, N_loops, elapsed_ns);
+    }
+
+    free(iq_buf);
+    free(cf32_buf);
+    free(i_out);
+    free(q_out);
+    for(p=0; p<N_ANT; p++)
+    {
+        free(i_buf[p]);
+        free(q_buf[p]);
+    }
+
+    return(0);
+}